@@ -29,7 +29,7 @@ TO MICROCHIP FOR THIS SOFTWARE.
  +------------------+------------------+------------------+------------------+
  +                         Callback Function Context                         +
  +------------------+------------------+------------------+------------------+
- + Num of Commands  + Max Num of Cmds  +  Num of Errors   +                  +
+ + Num of Commands  + Max Num of Cmds  +  Num of Errors   +  Num of Status   +
  +------------------+------------------+------------------+------------------+
  +                              Working Pointer                              +
  +------------------+------------------+------------------+------------------+
@@ -41,6 +41,10 @@ TO MICROCHIP FOR THIS SOFTWARE.
  +------------------+------------------+------------------+------------------+
  +                  Current Command Request Working Pointer                  +
  +------------------+------------------+------------------+------------------+
+ +                                Queue Time                                 +
+ +------------------+------------------+------------------+------------------+
+ +      Class       +                                                        +
+ +------------------+------------------+------------------+------------------+
  + Command 1                         Size                                    +
  +                                    or                                     +
  +           Response Status           +                                     +
@@ -118,7 +122,7 @@ typedef struct
     uint8_t                 numCmds;
     uint8_t                 maxNumCmds;
     uint8_t                 numErrors;
-    uint8_t                 reserved[1];
+    uint8_t                 numStatus;
 
     uint8_t                 *pPtr;
 
@@ -130,6 +134,10 @@ typedef struct
 
     WINC_COMMAND_REQUEST    *pCmdReq;
 
+    uint32_t                queueTime;
+    uint8_t                 cmdClass;
+    uint8_t                 reserved[3];
+
     union
     {
         uint32_t            size;
@@ -157,5 +165,6 @@ typedef struct
 
 WINC_CMD_REQ_HANDLE WINC_CmdReqInit(uint8_t* pBuffer, size_t lenBuffer, int numCommands, WINC_DEV_CMD_RSP_CB pfCmdRspCallback, uintptr_t cmdRspCallbackCtx);
 bool WINC_CmdReqDiscard(WINC_DEVICE_HANDLE devHandle, WINC_CMD_REQ_HANDLE cmdReqHandle);
+bool WINC_CmdReqClassSet(WINC_CMD_REQ_HANDLE cmdReqHandle, WINC_DEV_CMD_CLASS_TYPE cmdClass);
 
 #endif /* WINC_CMD_REQ_H */
@@ -138,6 +138,34 @@ typedef enum
 /* SDIO SPI send/receive function type definition. */
 typedef bool (*WINC_SDIO_SEND_RECEIVE_FP)(void* pTransmitData, void* pReceiveData, size_t size);
 
+/* SDIO SPI transfer list entry. */
+typedef struct
+{
+    /* Pointer to data to send, or NULL. */
+    void*   pTransmitData;
+
+    /* Pointer to buffer to receive into, or NULL. */
+    void*   pReceiveData;
+
+    /* Size of the transfer. */
+    size_t  size;
+} WINC_SDIO_XFER;
+
+/* SDIO SPI send/receive of a list of transfers as one transaction function type definition. */
+typedef bool (*WINC_SDIO_SEND_RECEIVE_LIST_FP)(const WINC_SDIO_XFER *pXferList, size_t numXfers);
+
+/* SDIO SPI transfer list completion callback type definition. */
+typedef void (*WINC_SDIO_XFER_CALLBACK)(bool success, uintptr_t context);
+
+/* SDIO SPI queue list of transfers function type definition. */
+typedef bool (*WINC_SDIO_XFER_QUEUE_FP)(const WINC_SDIO_XFER *pXferList, size_t numXfers, WINC_SDIO_XFER_CALLBACK pfCallback, uintptr_t context);
+
+/* SDIO SPI wait for queued transfers function type definition. */
+typedef bool (*WINC_SDIO_XFER_WAIT_FP)(void);
+
+/* SDIO SPI send with CRC16 (CCITT, zero seed) of transmitted data function type definition. */
+typedef bool (*WINC_SDIO_SEND_CRC16_FP)(void* pTransmitData, size_t size, uint16_t *pCRC16);
+
 /*****************************************************************************
                           WINC SDIO Module API
  *****************************************************************************/
@@ -149,6 +177,11 @@ uint8_t WINC_SDIOCmd52(uint32_t fnRegAddr, const uint8_t* const pWriteValue, uin
 uint8_t WINC_SDIOCmd59(void);
 uint16_t WINC_SDIOCmd53Write(uint32_t fnRegAddr, uint8_t *pWritePtr, size_t writeLength, bool incAddr);
 uint16_t WINC_SDIOCmd53Read(uint32_t fnRegAddr, uint8_t *pReadPtr, size_t readLength, bool incAddr);
+uint16_t WINC_SDIOCmd53ReadStart(uint32_t fnRegAddr, uint8_t *pReadPtr, size_t readLength, bool incAddr);
+uint16_t WINC_SDIOCmd53ReadComplete(void);
 WINC_SDIO_STATUS_TYPE WINC_SDIODeviceInit(WINC_SDIO_STATE_TYPE *pState, WINC_SDIO_SEND_RECEIVE_FP pfSendReceive);
+void WINC_SDIOSendCRC16Set(WINC_SDIO_SEND_CRC16_FP pfSendCRC16);
+void WINC_SDIOSendReceiveListSet(WINC_SDIO_SEND_RECEIVE_LIST_FP pfSendReceiveList);
+void WINC_SDIOTransferQueueSet(WINC_SDIO_XFER_QUEUE_FP pfXferQueue, WINC_SDIO_XFER_WAIT_FP pfXferWait);
 
 #endif /* WINC_SDIO_DRV_H */
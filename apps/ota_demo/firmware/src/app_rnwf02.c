@@ -223,7 +223,12 @@ static void SYS_RNWF_OTA_CallbackHandler
             SYS_CONSOLE_PRINT(TERM_CYAN"Total Size = %lu\r\n"TERM_RESET, *(uint32_t *)p_str); 
             SYS_CONSOLE_PRINT("Erasing the SPI Flash\r\n");
             
-            SYS_RNWF_OTA_FlashErase();
+            if(SYS_RNWF_OTA_FlashErase() == false)
+            {
+                SYS_CONSOLE_PRINT(TERM_RED"[APP ERROR] : SPI Flash erase failed\r\n"TERM_RESET);
+                g_appData.state = APP_STATE_ERROR;
+                break;
+            }
             SYS_CONSOLE_PRINT(TERM_GREEN"Erasing Complete!\r\n"TERM_RESET); 
             break;
         }
@@ -240,7 +245,12 @@ static void SYS_RNWF_OTA_CallbackHandler
         case SYS_RNWF_OTA_EVENT_FILE_CHUNK://15212
         {
             volatile SYS_RNWF_OTA_CHUNK_t *ota_chunk = (SYS_RNWF_OTA_CHUNK_t *)p_str;               
-            SYS_RNWF_OTA_FlashWrite(flash_addr,ota_chunk->chunk_size ,ota_chunk->chunk_ptr);
+            if(SYS_RNWF_OTA_FlashWrite(flash_addr,ota_chunk->chunk_size ,ota_chunk->chunk_ptr) == false)
+            {
+                SYS_CONSOLE_PRINT(TERM_RED"[APP ERROR] : SPI Flash write failed\r\n"TERM_RESET);
+                g_appData.state = APP_STATE_ERROR;
+                break;
+            }
             flash_addr += ota_chunk->chunk_size;
             break; 
         }    
@@ -363,7 +373,12 @@ void APP_RNWF02_Tasks
             {
                 /* Check if Flash has the New FW pre loaded in it */
                 SYS_RNWF_OTA_HDR_t otaHdr;
-                SYS_RNWF_OTA_FlashRead(SYS_RNWF_OTA_FLASH_IMAGE_START, sizeof(SYS_RNWF_OTA_HDR_t), (uint8_t *)&otaHdr.seq_num);
+                if(SYS_RNWF_OTA_FlashRead(SYS_RNWF_OTA_FLASH_IMAGE_START, sizeof(SYS_RNWF_OTA_HDR_t), (uint8_t *)&otaHdr.seq_num) == false)
+                {
+                    SYS_CONSOLE_PRINT(TERM_RED"[APP ERROR] : SPI Flash read failed\r\n"TERM_RESET);
+                    g_appData.state = APP_STATE_ERROR;
+                    break;
+                }
                 
                 SYS_CONSOLE_PRINT("Image details in the Flash\r\n");
                 SYS_CONSOLE_PRINT("Sequence Number 0x%X\r\n", (unsigned int)otaHdr.seq_num);
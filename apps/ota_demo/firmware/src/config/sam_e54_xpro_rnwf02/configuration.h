@@ -179,6 +179,7 @@ extern "C" {
 #define DRV_SST26_PAGE_SIZE             (256U)
 #define DRV_SST26_ERASE_BUFFER_SIZE     (4096U)
 #define DRV_SST26_CHIP_SELECT_PIN       SYS_PORT_PIN_PC06
+#define DRV_SST26_QUEUE_SIZE            (20U)
 
 
 
@@ -991,6 +991,157 @@ void DRV_SST26_EventHandlerSet(
 
 bool DRV_SST26_ReadStatus( const DRV_HANDLE handle, void *rx_data, uint32_t rx_data_length );
 
+// *****************************************************************************
+/* SST26 Driver Queued Request Types
+
+  Summary:
+    Identifies the operation of a queued request.
+
+  Description:
+    This enumeration identifies the flash operation performed by a request
+    added with DRV_SST26_RequestQueue().
+
+  Remarks:
+    None.
+*/
+
+typedef enum
+{
+    /* Read rx_data_length bytes starting at the address */
+    DRV_SST26_REQUEST_READ = 0,
+
+    /* Program one page starting at the address */
+    DRV_SST26_REQUEST_PAGE_WRITE,
+
+    /* Erase the 4 KByte sector starting at the address */
+    DRV_SST26_REQUEST_SECTOR_ERASE,
+
+    /* Erase the block starting at the address */
+    DRV_SST26_REQUEST_BULK_ERASE,
+
+    /* Erase the complete flash */
+    DRV_SST26_REQUEST_CHIP_ERASE
+
+} DRV_SST26_REQUEST_TYPE;
+
+// *****************************************************************************
+/* Function:
+    bool DRV_SST26_RequestQueue
+    (
+        const DRV_HANDLE handle,
+        DRV_SST26_REQUEST_TYPE type,
+        void *buffer,
+        uint32_t length,
+        uint32_t address,
+        const DRV_SST26_EVENT_HANDLER callback,
+        const uintptr_t context
+    );
+
+  Summary:
+    Adds a read, page program or erase request to the driver queue.
+
+  Description:
+    This function queues a flash operation and returns immediately. Queued
+    requests are executed in order from the SPI completion interrupt, the
+    next request starts as soon as the previous one completes without any
+    polling by the client. A read which continues both the flash address and
+    the buffer of a queued read that has not started yet is merged into it
+    and both are performed as a single transfer.
+
+    The callback of each request is called with its result when it
+    completes, including requests which were merged.
+
+  Preconditions:
+    The DRV_SST26_Open() routine must have been called for the
+    specified SST26 driver instance.
+
+  Parameters:
+    handle        - A valid open-instance handle, returned from the driver's
+                   open routine
+
+    type          - Operation to be performed
+
+    buffer        - Destination of a read, source page of a page write.
+                    Must remain valid until the request completes.
+
+    length        - Number of bytes to read, ignored for other operations
+
+    address       - Flash address of the operation
+
+    callback      - Completion callback, may be NULL
+
+    context       - Value passed back to the callback
+
+  Returns:
+    true
+        - if the request was queued
+
+    false
+        - if the handle or the parameters are invalid
+        - if the queue is full
+
+  Example:
+    <code>
+    void APP_PageWritten( DRV_SST26_TRANSFER_STATUS event, uintptr_t context )
+    {
+        
+    }
+
+    if (DRV_SST26_RequestQueue(handle, DRV_SST26_REQUEST_PAGE_WRITE, pageBuffer,
+            DRV_SST26_PAGE_SIZE, MEM_ADDRESS, APP_PageWritten, 0) == false)
+    {
+        
+    }
+    </code>
+
+  Remarks:
+    The callback executes in the driver's interrupt context.
+
+    The queue holds DRV_SST26_QUEUE_SIZE requests. Direct (non-queued)
+    requests fail while a queued request is in progress, and the handler
+    registered with DRV_SST26_EventHandlerSet() is not called for queued
+    requests.
+*/
+
+bool DRV_SST26_RequestQueue
+(
+    const DRV_HANDLE handle,
+    DRV_SST26_REQUEST_TYPE type,
+    void *buffer,
+    uint32_t length,
+    uint32_t address,
+    const DRV_SST26_EVENT_HANDLER callback,
+    const uintptr_t context
+);
+
+// *****************************************************************************
+/* Function:
+    uint32_t DRV_SST26_RequestQueueCount( const DRV_HANDLE handle );
+
+  Summary:
+    Returns the number of queued requests which have not completed.
+
+  Description:
+    This function returns the number of requests added with
+    DRV_SST26_RequestQueue() whose callback has not yet been called.
+
+  Preconditions:
+    The DRV_SST26_Open() routine must have been called for the
+    specified SST26 driver instance.
+
+  Parameters:
+    handle        - A valid open-instance handle, returned from the driver's
+                   open routine
+
+  Returns:
+    Number of outstanding queued requests.
+
+  Remarks:
+    None.
+*/
+
+uint32_t DRV_SST26_RequestQueueCount( const DRV_HANDLE handle );
+
 /* MISRAC 2012 deviation block end */
 
 #ifdef __cplusplus
@@ -257,6 +257,82 @@ static bool DRV_SST26_Erase( uint8_t command, uint32_t address )
     return status;
 }
 
+/* Pops the oldest queued request together with the reads merged into it and
+ * reports the result to their callbacks.
+ */
+static void lDRV_SST26_QueueComplete( DRV_SST26_TRANSFER_STATUS status )
+{
+    DRV_SST26_EVENT_HANDLER callback;
+    uintptr_t context;
+
+    do
+    {
+        callback = dObj->queue[dObj->queueHead].callback;
+        context  = dObj->queue[dObj->queueHead].context;
+
+        dObj->queueHead = (dObj->queueHead + 1U) % DRV_SST26_QUEUE_SIZE;
+        dObj->queueCount--;
+
+        if (callback != NULL)
+        {
+            callback(status, context);
+        }
+    } while ((dObj->queueCount > 0U) && (dObj->queue[dObj->queueHead].merged == true));
+}
+
+/* Starts the oldest queued request if the flash is idle. Requests which cannot
+ * be started are completed with an error.
+ */
+static void lDRV_SST26_QueueStart( void )
+{
+    DRV_SST26_QUEUE_OBJ *req = NULL;
+    bool status = false;
+
+    dObj->queueActive = true;
+
+    while ((dObj->queueCount > 0U) && (dObj->transferStatus != DRV_SST26_TRANSFER_BUSY))
+    {
+        req = &dObj->queue[dObj->queueHead];
+        req->started = true;
+
+        switch (req->type)
+        {
+            case DRV_SST26_REQUEST_READ:
+                status = DRV_SST26_Read(req->handle, req->buffer, req->length, req->address);
+                break;
+
+            case DRV_SST26_REQUEST_PAGE_WRITE:
+                status = DRV_SST26_PageWrite(req->handle, req->buffer, req->address);
+                break;
+
+            case DRV_SST26_REQUEST_SECTOR_ERASE:
+                status = DRV_SST26_SectorErase(req->handle, req->address);
+                break;
+
+            case DRV_SST26_REQUEST_BULK_ERASE:
+                status = DRV_SST26_BulkErase(req->handle, req->address);
+                break;
+
+            case DRV_SST26_REQUEST_CHIP_ERASE:
+                status = DRV_SST26_ChipErase(req->handle);
+                break;
+
+            default:
+                status = false;
+                break;
+        }
+
+        if (status == true)
+        {
+            return;
+        }
+
+        lDRV_SST26_QueueComplete(DRV_SST26_TRANSFER_ERROR_UNKNOWN);
+    }
+
+    dObj->queueActive = false;
+}
+
 void DRV_SST26_Handler( void )
 {
     switch(dObj->state)
@@ -426,10 +502,21 @@ void DRV_SST26_Handler( void )
     /* If transfer is complete, notify the application */
     if (dObj->transferStatus != DRV_SST26_TRANSFER_BUSY)
     {
-        if (dObj->eventHandler != NULL)
+        if (dObj->queueActive == true)
+        {
+            lDRV_SST26_QueueComplete(dObj->transferStatus);
+        }
+        else if (dObj->eventHandler != NULL)
         {
             dObj->eventHandler(dObj->transferStatus, dObj->context);
         }
+        else
+        {
+            /* Nothing to do */
+        }
+
+        /* Start the next queued request */
+        lDRV_SST26_QueueStart();
     }
 }
 
@@ -617,6 +704,100 @@ bool DRV_SST26_ChipErase( const DRV_HANDLE handle )
     return (DRV_SST26_Erase((uint8_t)SST26_CMD_CHIP_ERASE, 0));
 }
 
+bool DRV_SST26_RequestQueue
+(
+    const DRV_HANDLE handle,
+    DRV_SST26_REQUEST_TYPE type,
+    void *buffer,
+    uint32_t length,
+    uint32_t address,
+    const DRV_SST26_EVENT_HANDLER callback,
+    const uintptr_t context
+)
+{
+    DRV_SST26_QUEUE_OBJ *last = NULL;
+    DRV_SST26_QUEUE_OBJ *req = NULL;
+    bool interruptState;
+    bool merged = false;
+
+    if ((handle == DRV_HANDLE_INVALID) || (type > DRV_SST26_REQUEST_CHIP_ERASE))
+    {
+        return false;
+    }
+
+    if ((type == DRV_SST26_REQUEST_READ) && ((buffer == NULL) || (length == 0U)))
+    {
+        return false;
+    }
+
+    if ((type == DRV_SST26_REQUEST_PAGE_WRITE) && (buffer == NULL))
+    {
+        return false;
+    }
+
+    interruptState = SYS_INT_Disable();
+
+    if (dObj->queueCount >= DRV_SST26_QUEUE_SIZE)
+    {
+        SYS_INT_Restore(interruptState);
+        return false;
+    }
+
+    if ((dObj->queueCount > 0U) && (type == DRV_SST26_REQUEST_READ))
+    {
+        last = &dObj->queue[dObj->queueLast];
+
+        /* Extend a pending read which ends where this one begins, both in the
+         * flash and in memory.
+         */
+        if ((last->type == DRV_SST26_REQUEST_READ) && (last->started == false) &&
+            ((last->address + last->length) == address) &&
+            ((last->buffer + last->length) == (uint8_t*)buffer))
+        {
+            last->length += length;
+            merged = true;
+        }
+    }
+
+    req = &dObj->queue[(dObj->queueHead + dObj->queueCount) % DRV_SST26_QUEUE_SIZE];
+
+    req->handle     = handle;
+    req->type       = type;
+    req->buffer     = (uint8_t*)buffer;
+    req->length     = (type == DRV_SST26_REQUEST_PAGE_WRITE) ? DRV_SST26_PAGE_SIZE : length;
+    req->address    = address;
+    req->callback   = callback;
+    req->context    = context;
+    req->merged     = merged;
+    req->started    = false;
+
+    if (merged == false)
+    {
+        dObj->queueLast = (dObj->queueHead + dObj->queueCount) % DRV_SST26_QUEUE_SIZE;
+    }
+
+    dObj->queueCount++;
+
+    if (dObj->queueActive == false)
+    {
+        lDRV_SST26_QueueStart();
+    }
+
+    SYS_INT_Restore(interruptState);
+
+    return true;
+}
+
+uint32_t DRV_SST26_RequestQueueCount( const DRV_HANDLE handle )
+{
+    if (handle == DRV_HANDLE_INVALID)
+    {
+        return 0U;
+    }
+
+    return dObj->queueCount;
+}
+
 bool DRV_SST26_GeometryGet( const DRV_HANDLE handle, DRV_SST26_GEOMETRY *geometry )
 {
     uint32_t flash_size = 0;
@@ -767,6 +948,11 @@ SYS_MODULE_OBJ DRV_SST26_Initialize
 
     dObj->transferStatus = DRV_SST26_TRANSFER_COMPLETED;
 
+    dObj->queueHead     = 0;
+    dObj->queueCount    = 0;
+    dObj->queueLast     = 0;
+    dObj->queueActive   = false;
+
     dObj->status    = SYS_STATUS_READY;
 
     /* Return the driver index */
@@ -50,6 +50,7 @@
 #include <string.h>
 #include "configuration.h"
 #include "driver/sst26/drv_sst26.h"
+#include "system/int/sys_int.h"
 // *****************************************************************************
 // *****************************************************************************
 // Section: Local Data Type Definitions
@@ -134,6 +135,36 @@ typedef enum
     DRV_SST26_STATE_WAIT_JEDEC_ID_READ_COMPLETE
 } DRV_SST26_STATE;
 
+/* Queued request */
+typedef struct
+{
+    /* Handle of the requesting client */
+    DRV_HANDLE handle;
+
+    /* Requested operation */
+    DRV_SST26_REQUEST_TYPE type;
+
+    /* Read destination or page write source */
+    uint8_t* buffer;
+
+    /* Number of bytes to read, including merged reads */
+    uint32_t length;
+
+    /* Flash address */
+    uint32_t address;
+
+    /* Completion callback and context */
+    DRV_SST26_EVENT_HANDLER callback;
+    uintptr_t context;
+
+    /* Request was merged into the preceding read */
+    bool merged;
+
+    /* Transfer of the request has been started */
+    bool started;
+
+} DRV_SST26_QUEUE_OBJ;
+
 typedef struct
 {
     /* Pointer to the receive data */
@@ -199,6 +230,21 @@ typedef struct
 
     DRV_SST26_TRANSFER_OBJ          transferDataObj;
 
+    /* Request queue */
+    DRV_SST26_QUEUE_OBJ             queue[DRV_SST26_QUEUE_SIZE];
+
+    /* Index of the oldest queued request */
+    uint32_t                        queueHead;
+
+    /* Number of queued requests */
+    volatile uint32_t               queueCount;
+
+    /* Index of the last request which was not merged */
+    uint32_t                        queueLast;
+
+    /* The oldest queued request is in progress or being completed */
+    volatile bool                   queueActive;
+
 } DRV_SST26_OBJECT;
 
 
@@ -438,7 +438,7 @@ size_t SYS_RNWF_IF_Read(uint8_t *buffer, uint16_t len)
         //later make it timeout        
         if(SYS_RNWF_IF_IsRxReady())
         {      
-            read_cnt += SYS_RNWF_IF_CommandRespRead(&buffer[read_cnt],len);
+            read_cnt += SYS_RNWF_IF_CommandRespRead(&buffer[read_cnt], len - read_cnt);
             if(read_cnt != len)
             {
                 continue;
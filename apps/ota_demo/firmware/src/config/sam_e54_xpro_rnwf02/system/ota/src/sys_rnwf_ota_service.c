@@ -66,6 +66,7 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 #include "system/inf/sys_rnwf_interface.h"
 #include "system/sys_rnwf_system_service.h"
 #include "system/net/sys_rnwf_net_service.h"
+#include "system/http/sys_rnwf_http_client.h"
 #include "system/ota/sys_rnwf_ota_service.h"
 #include "system/time/sys_time_definitions.h"
 #include "peripheral/sercom/usart/plib_sercom0_usart.h"
@@ -100,6 +101,30 @@ static uint8_t g_otaBuffer[SYS_RNWF_OTA_BUF_LEN_MAX];
 
 static bool g_otaHttpTlsFileReqEnable = false;
 
+/* HTTP response parser of the image download */
+static SYS_RNWF_HTTP_PARSER_t g_otaHttpParser;
+
+/* Number of image bytes held in the Ota buffer */
+static uint32_t g_otaBufLen = 0;
+
+/* Variable to hold HTTP response complete status */
+static bool g_otaHttpDone = false;
+
+/* Variable to hold HTTP response failure status */
+static bool g_otaHttpFail = false;
+
+/* Number of image bytes downloaded */
+static uint32_t g_otaDwldBytes = 0;
+
+/* Timer counts accumulated per update phase */
+static uint64_t g_otaDwldCount = 0;
+static uint64_t g_otaStagingCount = 0;
+static uint64_t g_otaEraseCount = 0;
+static uint64_t g_otaProgramCount = 0;
+
+/* Timer count when the download was requested */
+static uint64_t g_otaDwldStart = 0;
+
 /* ************************************************************************** */
 /* ************************************************************************** */
 // Section: Local Functions                                                   */
@@ -175,6 +200,20 @@ static inline void SYS_RNWF_OTA_DelayUs(uint32_t us)
 }
 
 
+/* Accumulate the timer counts elapsed since start into a phase total */
+static inline void SYS_RNWF_OTA_StatsAdd(uint64_t *total, uint64_t start)
+{
+    *total += (SYS_TIME_Counter64Get() - start);
+}
+
+
+/* Convert accumulated timer counts to milliseconds */
+static inline uint32_t SYS_RNWF_OTA_StatsToMs(uint64_t count)
+{
+    return (uint32_t)((count * 1000U) / SYS_TIME_FrequencyGet());
+}
+
+
 /* To Configure PINs as GPIO Digital pins*/
 static inline void SYS_RNWF_OTA_ConfigureGpioPins ( void )
 {
@@ -194,6 +233,73 @@ static inline void SYS_RNWF_OTA_ConfigureGpioPins ( void )
 }
 
 
+/* HTTP parser callback, collects the image body into the OTA buffer */
+static void SYS_RNWF_OTA_HttpCallback
+(
+    SYS_RNWF_HTTP_EVENT_t event,
+    const SYS_RNWF_HTTP_RESPONSE_t *response,
+    const uint8_t *data,
+    uint32_t length,
+    void *context
+)
+{
+    switch(event)
+    {
+        case SYS_RNWF_HTTP_EVENT_HEADERS_DONE:
+        {
+            if((response->status != 200) && (response->status != 206))
+            {
+                SYS_RNWF_OTA_DBG_MSG("File Not Found! (HTTP %d)\r\n", response->status);
+                g_otaHttpFail = true;
+                break;
+            }
+
+            /* Chunked images report their size once the body is complete */
+            if(response->contentLength != SYS_RNWF_HTTP_LEN_UNKNOWN)
+            {
+                g_otaFileSize = response->contentLength;
+            }
+            else
+            {
+                g_otaFileSize = 0;
+            }
+            g_otaCallBackHandler(SYS_RNWF_OTA_EVENT_DWLD_START, (uint8_t *)&g_otaFileSize);
+            break;
+        }
+
+        case SYS_RNWF_HTTP_EVENT_BODY:
+        {
+            if(g_otaHttpFail == true)
+            {
+                break;
+            }
+
+            /* Body normally lands in place, only header and chunk framing
+             * bytes read into the same buffer shift it down */
+            if(data != &g_otaBuf[g_otaBufLen])
+            {
+                memmove(&g_otaBuf[g_otaBufLen], data, length);
+            }
+            g_otaBufLen += length;
+            break;
+        }
+
+        case SYS_RNWF_HTTP_EVENT_RESPONSE_DONE:
+        {
+            g_otaHttpDone = (g_otaHttpFail == false);
+            break;
+        }
+
+        case SYS_RNWF_HTTP_EVENT_ERROR:
+        default:
+        {
+            g_otaHttpFail = true;
+            break;
+        }
+    }
+}
+
+
 /* To Download data from server to SST26 Flash */
 static SYS_RNWF_RESULT_t SYS_RNWF_OTA_DownloadProcess
 (
@@ -203,65 +309,56 @@ static SYS_RNWF_RESULT_t SYS_RNWF_OTA_DownloadProcess
 {
     int16_t read_size = 0;
     SYS_RNWF_OTA_CHUNK_t ota_chunk = {.chunk_ptr = g_otaBuf};
-    static uint16_t result = 0;
-    static volatile uint32_t total_rx = 0;
-    char *tmpPtr = NULL;
     
-    if((total_rx > 0) && (total_rx == g_otaFileSize))
+    if(g_otaDwldDone == true)
     {
         return SYS_RNWF_PASS;
     }
     
     while(rx_len > 0)
     {
-        uint16_t readCnt = ((rx_len + result) > SYS_RNWF_OTA_BUF_LEN_MAX)?(SYS_RNWF_OTA_BUF_LEN_MAX-result):rx_len;  
+        uint32_t bufLen = g_otaBufLen;
+        uint16_t readCnt = ((rx_len + bufLen) > SYS_RNWF_OTA_BUF_LEN_MAX)?(SYS_RNWF_OTA_BUF_LEN_MAX-bufLen):rx_len;  
         
-        if((read_size = SYS_RNWF_NET_TcpSockRead(socket, readCnt, (uint8_t *)&g_otaBuf[result])) > 0 )
+        if((read_size = SYS_RNWF_NET_TcpSockRead(socket, readCnt, (uint8_t *)&g_otaBuf[bufLen])) > 0 )
         {
-            if(!g_otaFileSize)
+            rx_len -= read_size;
+
+            SYS_RNWF_HTTP_ParserFeed(&g_otaHttpParser, &g_otaBuf[bufLen], read_size);
+            
+            if(g_otaHttpFail == true)
             {
-                tmpPtr = (char *)strstr((const char *)g_otaBuf, (const char *)SYS_RNWF_OTA_HTTP_CONTENT_OK);
-                if(tmpPtr)
-                {
-                    SYS_RNWF_OTA_DBG_MSG("%s\r\n",g_otaBuf);
-                    tmpPtr = (char *)strstr((const char *)g_otaBuf, (const char *)SYS_RNWF_OTA_HTTP_CONTENT_LEN);
-                    if(tmpPtr == NULL)
-                    {
-                        break;
-                    }
-                    char *token = strtok(tmpPtr, "\r\n");
-                    g_otaFileSize = strtol((token+sizeof(SYS_RNWF_OTA_HTTP_CONTENT_LEN)), NULL, 10);
-                    g_otaCallBackHandler(SYS_RNWF_OTA_EVENT_DWLD_START, (uint8_t *)&g_otaFileSize);
-                    break;
-                } 
-                else
-                {
-                    SYS_RNWF_OTA_DBG_MSG("File Not Found!\r\n");
-                    SYS_RNWF_NET_SockSrvCtrl(SYS_RNWF_NET_SOCK_CLOSE, &socket);
-                    g_otaCallBackHandler(SYS_RNWF_OTA_EVENT_DWLD_FAIL, (uint8_t *)NULL);
-                }
+                SYS_RNWF_NET_SockSrvCtrl(SYS_RNWF_NET_SOCK_CLOSE, &socket);
+                g_otaCallBackHandler(SYS_RNWF_OTA_EVENT_DWLD_FAIL, (uint8_t *)NULL);
                 break;
             }
             
-            result += read_size;
-            total_rx = total_rx + read_size;
-            rx_len -= read_size;
+            g_otaDwldBytes = g_otaDwldBytes + (g_otaBufLen - bufLen);
 
             /* Buffer is full, Initiate Write to SST26 callback */
-            if(result == SYS_RNWF_OTA_BUF_LEN_MAX)
+            if(g_otaBufLen == SYS_RNWF_OTA_BUF_LEN_MAX)
             {
                 ota_chunk.chunk_size = SYS_RNWF_OTA_BUF_LEN_MAX;  
-                SYS_RNWF_OTA_DBG_MSG("Downloaded : %lu - %.2f %\r\n", total_rx,(((float)total_rx/g_otaFileSize)) * 100.00f);
+                if(g_otaFileSize != 0)
+                {
+                    SYS_RNWF_OTA_DBG_MSG("Downloaded : %lu - %.2f %\r\n", g_otaDwldBytes,(((float)g_otaDwldBytes/g_otaFileSize)) * 100.00f);
+                }
+                else
+                {
+                    SYS_RNWF_OTA_DBG_MSG("Downloaded : %lu\r\n", g_otaDwldBytes);
+                }
                 g_otaCallBackHandler(SYS_RNWF_OTA_EVENT_FILE_CHUNK, (uint8_t *)&ota_chunk);                
-                result = 0;
+                g_otaBufLen = 0;
             }
 
             /* Downloading of image is completed , initiate callback */
-            if(total_rx == g_otaFileSize)
+            if(g_otaHttpDone == true)
             {
-                ota_chunk.chunk_size = result; 
+                g_otaDwldCount = (SYS_TIME_Counter64Get() - g_otaDwldStart) - (g_otaStagingCount + g_otaEraseCount);
+                g_otaFileSize = g_otaDwldBytes;
+                ota_chunk.chunk_size = g_otaBufLen; 
                 g_otaCallBackHandler(SYS_RNWF_OTA_EVENT_FILE_CHUNK, (uint8_t *)&ota_chunk);
-                g_otaCallBackHandler(SYS_RNWF_OTA_EVENT_DWLD_DONE, (uint8_t *)&total_rx);
+                g_otaCallBackHandler(SYS_RNWF_OTA_EVENT_DWLD_DONE, (uint8_t *)&g_otaDwldBytes);
                 g_otaDwldDone = true;
                 
                 return SYS_RNWF_PASS;
@@ -723,6 +820,39 @@ void SYS_RNWF_OTA_FlashEventHandler
     }
 }
 
+/* SST26 queued page write callback */
+static void SYS_RNWF_OTA_FlashWriteCallback
+(
+    DRV_SST26_TRANSFER_STATUS event,
+    uintptr_t context
+)
+{
+    if(event != DRV_SST26_TRANSFER_COMPLETED)
+    {
+        g_flashData.writeError = true;
+    }
+}
+
+/* Waits for the queued page writes to complete */
+static bool SYS_RNWF_OTA_FlashWait
+(
+    void
+)
+{
+    bool result;
+    
+    while(DRV_SST26_RequestQueueCount(g_flashData.handle) != 0U);
+    
+    result = (g_flashData.writeError == false);
+    g_flashData.writeError = false;
+    
+    if(result == false)
+    {
+        SYS_RNWF_OTA_DBG_MSG("Error: SST26 page write failed\r\n");
+    }
+    return result;
+}
+
 /* To Initialize SST26 Flash */
 bool SYS_RNWF_OTA_FlashInitialize
 (
@@ -766,9 +896,27 @@ bool SYS_RNWF_OTA_FlashErase
     void
 )
 {
-    DRV_SST26_ChipErase( g_flashData.handle );
-    while(DRV_SST26_TRANSFER_COMPLETED != DRV_SST26_TransferStatusGet(g_flashData.handle) );
-    return true;
+    DRV_SST26_TRANSFER_STATUS transferStatus;
+    uint64_t start = SYS_TIME_Counter64Get();
+    
+    if(SYS_RNWF_OTA_FlashWait() == false)
+    {
+        return false;
+    }
+    
+    if(DRV_SST26_ChipErase( g_flashData.handle ) == false)
+    {
+        return false;
+    }
+    
+    do
+    {
+        transferStatus = DRV_SST26_TransferStatusGet(g_flashData.handle);
+    }
+    while (transferStatus == DRV_SST26_TRANSFER_BUSY);
+    
+    SYS_RNWF_OTA_StatsAdd(&g_otaEraseCount, start);
+    return (transferStatus == DRV_SST26_TRANSFER_COMPLETED);
 }
 
 /* To write to SST26 Flash */
@@ -779,29 +927,49 @@ bool SYS_RNWF_OTA_FlashWrite
     uint8_t *buf
 )
 {
-    DRV_SST26_TRANSFER_STATUS transferStatus = DRV_SST26_TRANSFER_ERROR_UNKNOWN;
+    uint32_t pageSize = g_flashData.geometry.write_blockSize;
     uint32_t write_index = 0;
-    g_flashData.isTransferDone = false;
+    uint64_t start = SYS_TIME_Counter64Get();
+    
+    /* The write buffer is still owned by the previous chunk, report its errors */
+    if(SYS_RNWF_OTA_FlashWait() == false)
+    {
+        return false;
+    }
+    
+    /* An empty final chunk leaves nothing to write */
+    if(size == 0U)
+    {
+        return true;
+    }
+    
+    if(size > SYS_RNWF_OTA_FLASH_BUFFER_SIZE)
+    {
+        return false;
+    }
+    
+    memcpy(g_flashData.writeBuffer, buf, size);
+    if(size % pageSize)
+    {
+        memset(&g_flashData.writeBuffer[size], 0xFF, pageSize - (size % pageSize));
+    }
      
-    while(size)
+    while(write_index < size)
     {
-        if (DRV_SST26_PageWrite(g_flashData.handle, &buf[write_index], (addr + write_index)) == true)
+        if(DRV_SST26_RequestQueue(g_flashData.handle, DRV_SST26_REQUEST_PAGE_WRITE, &g_flashData.writeBuffer[write_index],
+                pageSize, (addr + write_index), SYS_RNWF_OTA_FlashWriteCallback, (uintptr_t)NULL) == false)
         {
-            do
+            /* Queue is full, wait for it to drain */
+            if(SYS_RNWF_OTA_FlashWait() == false)
             {
-                transferStatus = DRV_SST26_TransferStatusGet(g_flashData.handle);
-            }while (transferStatus == DRV_SST26_TRANSFER_BUSY);
-            
-            write_index += g_flashData.geometry.write_blockSize;
-            size = size - g_flashData.geometry.write_blockSize;
-        }
-        else 
-        {
-            SYS_RNWF_OTA_DBG_MSG("\tError\r\n");
-            return false;
+                SYS_RNWF_OTA_DBG_MSG("\tError\r\n");
+                return false;
+            }
+            continue;
         }
-        
+        write_index += pageSize;
     }
+    SYS_RNWF_OTA_StatsAdd(&g_otaStagingCount, start);
     return true;
 }
 
@@ -815,6 +983,12 @@ bool SYS_RNWF_OTA_FlashRead
 )
 {
     DRV_SST26_TRANSFER_STATUS transferStatus = DRV_SST26_TRANSFER_ERROR_UNKNOWN;
+    
+    if(SYS_RNWF_OTA_FlashWait() == false)
+    {
+        return false;
+    }
+    
     if (DRV_SST26_Read(g_flashData.handle, buf, size, addr) == true)
     {
         do
@@ -822,7 +996,7 @@ bool SYS_RNWF_OTA_FlashRead
             transferStatus = DRV_SST26_TransferStatusGet(g_flashData.handle);
         }
         while (transferStatus == DRV_SST26_TRANSFER_BUSY);
-        return true;
+        return (transferStatus == DRV_SST26_TRANSFER_COMPLETED);
         
     }
     return false;
@@ -911,6 +1085,7 @@ void SYS_RNWF_OTA_ProgramDfu
     static SYS_RNWF_OTA_PROGRAM_EVENT_t program_event = SYS_RNWF_PROGRAM_INIT;
     static uint32_t flash_addr = SYS_RNWF_OTA_FLASH_IMAGE_START;
     static SYS_RNWF_OTA_CHUNK_t ota_chunk = { .chunk_addr = SYS_RNWF_OTA_FLASH_START_ADDRESS, .chunk_ptr = g_otaBuffer, .chunk_size = 0x84000};
+    uint64_t start = SYS_TIME_Counter64Get();
     
     switch(program_event)
     {
@@ -928,6 +1103,7 @@ void SYS_RNWF_OTA_ProgramDfu
             {
                 program_event = SYS_RNWF_PROGRAM_FLASH_READ;
             }
+            SYS_RNWF_OTA_StatsAdd(&g_otaEraseCount, start);
             break;
         }
         
@@ -941,6 +1117,7 @@ void SYS_RNWF_OTA_ProgramDfu
                 break;
             }
             program_event = SYS_RNWF_PROGRAM_DFU_WRITE;
+            SYS_RNWF_OTA_StatsAdd(&g_otaProgramCount, start);
             break;
         }
         
@@ -952,6 +1129,7 @@ void SYS_RNWF_OTA_ProgramDfu
             g_otaFileSize -= ota_chunk.chunk_size;
             ota_chunk.chunk_addr += ota_chunk.chunk_size;
             flash_addr += ota_chunk.chunk_size;
+            SYS_RNWF_OTA_StatsAdd(&g_otaProgramCount, start);
             SYS_RNWF_OTA_DBG_MSG("Remaining %lu bytes\r\n", g_otaFileSize);
             
             if(!g_otaFileSize)
@@ -972,6 +1150,9 @@ void SYS_RNWF_OTA_ProgramDfu
         
         case SYS_RNWF_PROGRAM_COMPLETE:
         {
+            SYS_RNWF_OTA_DBG_MSG("Update time (ms) : download %lu, staging %lu, erase %lu, programming %lu\r\n",
+                                 SYS_RNWF_OTA_StatsToMs(g_otaDwldCount), SYS_RNWF_OTA_StatsToMs(g_otaStagingCount),
+                                 SYS_RNWF_OTA_StatsToMs(g_otaEraseCount), SYS_RNWF_OTA_StatsToMs(g_otaProgramCount));
             g_otaDfuComplete = true;
             program_event = SYS_RNWF_PROGRAM_INIT;
             break;
@@ -1027,16 +1208,23 @@ SYS_RNWF_RESULT_t SYS_RNWF_OTA_SrvCtrl
         {
             SYS_RNWF_OTA_CFG_t *otaCfg = (SYS_RNWF_OTA_CFG_t *)input;
             
-            char temp_buff[100] = {'\0'};
-            char str1[] = "GET /";
-            
-            // TODO : Need to be changed based on GET request 
-            char str2[] = " HTTP/1.1\r\n Connection: Keep-Alive\r\n\r\n";
-            memcpy(temp_buff, str1,strlen(str1));
-            memcpy(&temp_buff[strlen(str1)], otaCfg->file,strlen(otaCfg->file) );
-            memcpy(&temp_buff[strlen(str1) + strlen(otaCfg->file)], str2, strlen(str2) );
+            if(SYS_RNWF_HTTP_RequestFormat((char *)g_otaBuf, SYS_RNWF_OTA_BUF_LEN_MAX, otaCfg->socket.sock_addr, otaCfg->file, 0, 0, false) == 0)
+            {
+                result = SYS_RNWF_FAIL;
+                break;
+            }
             
-            memcpy(g_otaBuf, temp_buff, sizeof(temp_buff));
+            SYS_RNWF_HTTP_ParserInit(&g_otaHttpParser, SYS_RNWF_OTA_HttpCallback, NULL);
+            /* Statistics cover the most recent update only */
+            g_otaDwldBytes    = 0;
+            g_otaDwldCount    = 0;
+            g_otaStagingCount = 0;
+            g_otaEraseCount   = 0;
+            g_otaProgramCount = 0;
+            g_otaDwldStart    = SYS_TIME_Counter64Get();
+            g_otaBufLen   = 0;
+            g_otaHttpDone = false;
+            g_otaHttpFail = false;
             
             #if SYS_RNWF_OTA_DFU_DEBUG
             SYS_RNWF_OTA_DBG_MSG("HTTP request : :%s\r\n",g_otaBuf);
@@ -1142,6 +1330,23 @@ SYS_RNWF_RESULT_t SYS_RNWF_OTA_SrvCtrl
             break;
         }
         
+        /* Get update timing statistics */
+        case SYS_RNWF_OTA_GET_STATS:
+        {
+            SYS_RNWF_OTA_STATS_t *stats = (SYS_RNWF_OTA_STATS_t *)input;
+            if(stats == NULL)
+            {
+                result = SYS_RNWF_FAIL;
+                break;
+            }
+            stats->dwld_bytes = g_otaDwldBytes;
+            stats->dwld_ms    = SYS_RNWF_OTA_StatsToMs(g_otaDwldCount);
+            stats->staging_ms = SYS_RNWF_OTA_StatsToMs(g_otaStagingCount);
+            stats->erase_ms   = SYS_RNWF_OTA_StatsToMs(g_otaEraseCount);
+            stats->program_ms = SYS_RNWF_OTA_StatsToMs(g_otaProgramCount);
+            break;
+        }
+        
         default:
         {
             break;
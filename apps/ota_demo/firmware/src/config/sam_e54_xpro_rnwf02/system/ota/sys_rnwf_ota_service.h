@@ -149,6 +149,9 @@ typedef struct
     /* Check if transfer is completed */
     bool isTransferDone;
     
+    /* A queued page write failed */
+    volatile bool writeError;
+    
     /* Write buffer of SST26 */
     uint8_t writeBuffer[SYS_RNWF_OTA_FLASH_BUFFER_SIZE];
     
@@ -291,6 +294,9 @@ typedef enum
     
     /**<OTA check, if DFU is completed */        
     SYS_RNWF_OTA_CHECK_DFU_DONE,
+            
+    /**<OTA Get update timing statistics */
+    SYS_RNWF_OTA_GET_STATS,
 
 }SYS_RNWF_OTA_SERVICE_t;
 
@@ -441,6 +447,36 @@ typedef struct
     
 }SYS_RNWF_OTA_HDR_t;
 
+// *****************************************************************************
+
+/* RNWF OTA update statistics structure
+
+  Summary:
+    OTA update timing statistics
+
+  Remarks:
+    Times are in milliseconds. Download time excludes the staging and
+    erase time spent while the image was being received.
+ */
+typedef struct
+{
+    /* Image bytes received from the server */
+    uint32_t dwld_bytes;
+    
+    /* Time spent receiving the image */
+    uint32_t dwld_ms;
+    
+    /* Time spent writing the image to SST26 flash */
+    uint32_t staging_ms;
+    
+    /* Time spent erasing SST26 and RNWF flash */
+    uint32_t erase_ms;
+    
+    /* Time spent reading back SST26 and programming RNWF flash */
+    uint32_t program_ms;
+    
+}SYS_RNWF_OTA_STATS_t;
+
 
 // *****************************************************************************
 /*  Function:
@@ -617,10 +653,16 @@ bool SYS_RNWF_OTA_FlashRead(uint32_t addr,uint32_t size,uint8_t *buf);
         SST26 flash Write
 
     Description:
-        This  function  Writes to the SST26 flash
+        This  function  copies the data into the flash write buffer and queues
+        the page writes to the SST26 flash. It returns without waiting for the
+        pages to be programmed, so the next chunk can be downloaded while the
+        flash is busy.
  
     Remarks:
-        None
+        The size must not exceed SYS_RNWF_OTA_FLASH_BUFFER_SIZE, a partial last
+        page is padded with 0xFF. A failed page write is reported by the next
+        call to SYS_RNWF_OTA_FlashWrite, SYS_RNWF_OTA_FlashRead or
+        SYS_RNWF_OTA_FlashErase.
  */
 bool SYS_RNWF_OTA_FlashWrite ( uint32_t addr, uint32_t size, uint8_t *buf ) ;
 
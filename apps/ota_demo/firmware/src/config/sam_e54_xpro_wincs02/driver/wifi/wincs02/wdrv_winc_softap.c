@@ -425,7 +425,7 @@ static void wapCmdRspCallbackHandler
 
         case WINC_DEV_CMDREQ_EVENT_STATUS_COMPLETE:
         {
-            OSAL_Free((WINC_COMMAND_REQUEST*)cmdReqHandle);
+            WDRV_WINC_DevDiscardCmdReq(cmdReqHandle);
             break;
         }
 
@@ -272,7 +272,7 @@ static void dnsCmdRspCallbackHandler
 
         case WINC_DEV_CMDREQ_EVENT_STATUS_COMPLETE:
         {
-            OSAL_Free((WINC_COMMAND_REQUEST*)cmdReqHandle);
+            WDRV_WINC_DevDiscardCmdReq(cmdReqHandle);
             break;
         }
 
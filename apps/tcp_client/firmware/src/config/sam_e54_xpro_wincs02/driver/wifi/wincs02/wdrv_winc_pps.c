@@ -299,7 +299,7 @@ static void ppsCmdRspCallbackHandler
 
         case WINC_DEV_CMDREQ_EVENT_STATUS_COMPLETE:
         {
-            OSAL_Free((WINC_COMMAND_REQUEST*)cmdReqHandle);
+            WDRV_WINC_DevDiscardCmdReq(cmdReqHandle);
             break;
         }
 
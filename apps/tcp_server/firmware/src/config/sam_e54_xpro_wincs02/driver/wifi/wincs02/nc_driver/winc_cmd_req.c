@@ -88,6 +88,7 @@ WINC_CMD_REQ_HANDLE WINC_CmdReqInit(uint8_t* pBuffer, size_t lenBuffer, int numC
     pSendReqState->pFirstHdrElem->pPtr = pBuffer;
     pSendReqState->pfCmdRspCallback    = pfCmdRspCallback;
     pSendReqState->cmdRspCallbackCtx   = cmdRspCallbackCtx;
+    pSendReqState->cmdClass            = (uint8_t)WINC_DEV_CMD_CLASS_AUTO;
 
     return (uintptr_t)pSendReqState;
 }
@@ -133,3 +134,40 @@ bool WINC_CmdReqDiscard(WINC_DEVICE_HANDLE devHandle, WINC_CMD_REQ_HANDLE cmdReq
 
     return true;
 }
+
+/*****************************************************************************
+  Description:
+    Set the scheduling class of a command request burst.
+
+  Parameters:
+    cmdReqHandle - Command request handle obtained from WINC_CmdReqInit
+    cmdClass     - Scheduling class
+
+  Returns:
+    true or false
+
+  Remarks:
+    Must be called before the command request is passed to
+    WINC_DevTransmitCmdReq. By default the class is selected from the first
+    command in the burst.
+
+ *****************************************************************************/
+
+bool WINC_CmdReqClassSet(WINC_CMD_REQ_HANDLE cmdReqHandle, WINC_DEV_CMD_CLASS_TYPE cmdClass)
+{
+    WINC_SEND_REQ_STATE *pSendReqState = (WINC_SEND_REQ_STATE*)cmdReqHandle;
+
+    if (NULL == pSendReqState)
+    {
+        return false;
+    }
+
+    if ((WINC_DEV_CMD_CLASS_AUTO != cmdClass) && ((unsigned)cmdClass >= WINC_DEV_NUM_CMD_CLASSES))
+    {
+        return false;
+    }
+
+    pSendReqState->cmdClass = (uint8_t)cmdClass;
+
+    return true;
+}
@@ -59,6 +59,49 @@ TO MICROCHIP FOR THIS SOFTWARE.
 #define WDRV_WINC_IMAGE_SEQ_LATENT  0xFFFFFFFFU
 #define WDRV_WINC_IMAGE_SEQ_MAX     0xFFFFFFE0U
 
+/* Command request buffer space allowed per command. */
+#ifndef WDRV_WINC_CMD_REQ_CMD_SZ
+#define WDRV_WINC_CMD_REQ_CMD_SZ            128U
+#endif
+
+/* Command request pool size classes, up to 32 buffers per class. */
+#ifndef WDRV_WINC_CMD_REQ_POOL_SMALL_SZ
+#define WDRV_WINC_CMD_REQ_POOL_SMALL_SZ     256U
+#endif
+#ifndef WDRV_WINC_CMD_REQ_POOL_SMALL_NUM
+#define WDRV_WINC_CMD_REQ_POOL_SMALL_NUM    8U
+#endif
+#ifndef WDRV_WINC_CMD_REQ_POOL_LARGE_SZ
+#define WDRV_WINC_CMD_REQ_POOL_LARGE_SZ     1024U
+#endif
+#ifndef WDRV_WINC_CMD_REQ_POOL_LARGE_NUM
+#define WDRV_WINC_CMD_REQ_POOL_LARGE_NUM    2U
+#endif
+/* Allocate from the heap when no pool buffer is available. */
+#ifndef WDRV_WINC_CMD_REQ_POOL_HEAP_FALLBACK
+#define WDRV_WINC_CMD_REQ_POOL_HEAP_FALLBACK    1
+#endif
+
+#if (WDRV_WINC_CMD_REQ_POOL_SMALL_NUM > 32U) || (WDRV_WINC_CMD_REQ_POOL_LARGE_NUM > 32U)
+#error "Command request pool classes are limited to 32 buffers"
+#endif
+
+#define WDRV_WINC_CMD_REQ_POOL_NUM_CLASSES  2U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: WINC Driver Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Command request pool size class. */
+typedef struct
+{
+    uint8_t                         *pMem;
+    uint32_t                        freeMask;
+    WDRV_WINC_CMD_REQ_POOL_STATS    stats;
+} WDRV_WINC_CMD_REQ_POOL;
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: WINC Driver Global Data
@@ -93,42 +136,71 @@ static WDRV_WINC_DCPT wincDescriptor[2] =
     }
 };
 
-/* AEC callback dispatch table. */
-static const WINC_DEV_AEC_RSP_CB wincAecCallbackTable[] =
+/* AEC callback dispatch table, indexed by module ID. */
+static const WINC_DEV_AEC_RSP_CB wincAecCallbackTable[WINC_DEV_AEC_NUM_MODULES] =
 {
-    WDRV_WINC_WSCNProcessAEC,
-    WDRV_WINC_WSTAProcessAEC,
+    [WINC_MOD_ID_WSCN]      = WDRV_WINC_WSCNProcessAEC,
+    [WINC_MOD_ID_WSTA]      = WDRV_WINC_WSTAProcessAEC,
 #ifndef WDRV_WINC_MOD_DISABLE_ICMP
-    WDRV_WINC_ICMPProcessAEC,
+    [WINC_MOD_ID_PING]      = WDRV_WINC_ICMPProcessAEC,
 #endif
-    WDRV_WINC_TIMEProcessAEC,
-    WDRV_WINC_WAPProcessAEC,
+    [WINC_MOD_ID_TIME]      = WDRV_WINC_TIMEProcessAEC,
+    [WINC_MOD_ID_WAP]       = WDRV_WINC_WAPProcessAEC,
 #ifndef WDRV_WINC_MOD_DISABLE_MQTT
-    WDRV_WINC_MQTTProcessAEC,
+    [WINC_MOD_ID_MQTT]      = WDRV_WINC_MQTTProcessAEC,
 #endif
-    WDRV_WINC_EXTCRYPTOProcessAEC,
+    [WINC_MOD_ID_EXTCRYPTO] = WDRV_WINC_EXTCRYPTOProcessAEC,
 #ifndef WDRV_WINC_MOD_DISABLE_DNS
-    WDRV_WINC_DNSProcessAEC,
+    [WINC_MOD_ID_DNS]       = WDRV_WINC_DNSProcessAEC,
 #endif
-    WDRV_WINC_NETIFProcessAEC,
+    [WINC_MOD_ID_NETIF]     = WDRV_WINC_NETIFProcessAEC,
 #ifndef WDRV_WINC_MOD_DISABLE_PROV
-    WDRV_WINC_ProvProcessAEC,
+    [WINC_MOD_ID_WPROV]     = WDRV_WINC_ProvProcessAEC,
 #endif
-    WDRV_WINC_AssocProcessAEC,
+    [WINC_MOD_ID_ASSOC]     = WDRV_WINC_AssocProcessAEC,
 #ifndef WDRV_WINC_MOD_DISABLE_OTA
-    WDRV_WINC_OTAProcessAEC,
+    [WINC_MOD_ID_OTA]       = WDRV_WINC_OTAProcessAEC,
 #endif
 #ifndef WDRV_WINC_MOD_DISABLE_NVM
-    WDRV_WINC_NVMProcessAEC,
+    [WINC_MOD_ID_NVM]       = WDRV_WINC_NVMProcessAEC,
 #endif
 #ifndef WDRV_WINC_MOD_DISABLE_PPS
-    WDRV_WINC_PPSProcessAEC,
+    [WINC_MOD_ID_PPS]       = WDRV_WINC_PPSProcessAEC,
 #endif
 #ifndef WDRV_WINC_MOD_DISABLE_SYSLOG
-    WDRV_WINC_SYSLOGProcessAEC,
+    [WINC_MOD_ID_SYSLOG]    = WDRV_WINC_SYSLOGProcessAEC,
 #endif
 };
 
+/* Command request pool memory, word aligned for WINC_COMMAND_REQUEST. */
+static uint32_t cmdReqPoolSmallMem[((WDRV_WINC_CMD_REQ_POOL_SMALL_SZ+3U)/4U) * WDRV_WINC_CMD_REQ_POOL_SMALL_NUM];
+static uint32_t cmdReqPoolLargeMem[((WDRV_WINC_CMD_REQ_POOL_LARGE_SZ+3U)/4U) * WDRV_WINC_CMD_REQ_POOL_LARGE_NUM];
+
+/* Command request pool size classes, smallest first. */
+static WDRV_WINC_CMD_REQ_POOL cmdReqPool[WDRV_WINC_CMD_REQ_POOL_NUM_CLASSES] =
+{
+    {
+        .pMem     = (uint8_t*)cmdReqPoolSmallMem,
+        .freeMask = (uint32_t)((1ULL << WDRV_WINC_CMD_REQ_POOL_SMALL_NUM) - 1U),
+        .stats    =
+        {
+            .blockSize = ((WDRV_WINC_CMD_REQ_POOL_SMALL_SZ+3U)/4U) * 4U,
+            .numBlocks = WDRV_WINC_CMD_REQ_POOL_SMALL_NUM,
+            .numFree   = WDRV_WINC_CMD_REQ_POOL_SMALL_NUM,
+        },
+    },
+    {
+        .pMem     = (uint8_t*)cmdReqPoolLargeMem,
+        .freeMask = (uint32_t)((1ULL << WDRV_WINC_CMD_REQ_POOL_LARGE_NUM) - 1U),
+        .stats    =
+        {
+            .blockSize = ((WDRV_WINC_CMD_REQ_POOL_LARGE_SZ+3U)/4U) * 4U,
+            .numBlocks = WDRV_WINC_CMD_REQ_POOL_LARGE_NUM,
+            .numFree   = WDRV_WINC_CMD_REQ_POOL_LARGE_NUM,
+        },
+    }
+};
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: WINC MAC Driver Global Data
@@ -155,6 +227,146 @@ static void wincRegDomainCallback
 {
 }
 
+//*******************************************************************************
+/*
+  Function:
+    static void* wincCmdReqPoolAlloc(size_t size)
+
+  Summary:
+    Allocate a command request buffer from the pool.
+
+  Description:
+    Takes a free buffer from the smallest size class which can hold the
+    request, trying larger classes if that class is exhausted.
+
+  Precondition:
+    None.
+
+  Parameters:
+    size - Size of buffer required.
+
+  Returns:
+    Pointer to buffer or NULL if none is available.
+
+  Remarks:
+    A free buffer is found from the class bitmap in constant time.
+
+*/
+
+static void* wincCmdReqPoolAlloc(size_t size)
+{
+    OSAL_CRITSECT_DATA_TYPE critSect;
+    WDRV_WINC_CMD_REQ_POOL *pPool;
+    void *pBuffer = NULL;
+    size_t i;
+    uint8_t blockIdx;
+    uint8_t curUsage;
+    bool fitted = false;
+
+    critSect = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_HIGH);
+
+    for (i=0; i<WDRV_WINC_CMD_REQ_POOL_NUM_CLASSES; i++)
+    {
+        pPool = &cmdReqPool[i];
+
+        if (size > pPool->stats.blockSize)
+        {
+            continue;
+        }
+
+        if (0U == pPool->freeMask)
+        {
+            if (false == fitted)
+            {
+                pPool->stats.numExhausted++;
+            }
+
+            fitted = true;
+            continue;
+        }
+
+        blockIdx = (uint8_t)__builtin_ctz(pPool->freeMask);
+
+        pPool->freeMask &= ~(1UL << blockIdx);
+
+        pPool->stats.numFree--;
+        pPool->stats.numAllocs++;
+
+        curUsage = pPool->stats.numBlocks - pPool->stats.numFree;
+
+        if (curUsage > pPool->stats.peakUsage)
+        {
+            pPool->stats.peakUsage = curUsage;
+        }
+
+        pBuffer = &pPool->pMem[(size_t)blockIdx * pPool->stats.blockSize];
+        break;
+    }
+
+    OSAL_CRIT_Leave(OSAL_CRIT_TYPE_HIGH, critSect);
+
+    return pBuffer;
+}
+
+//*******************************************************************************
+/*
+  Function:
+    static bool wincCmdReqPoolFree(void *pBuffer)
+
+  Summary:
+    Return a command request buffer to the pool.
+
+  Description:
+    Marks a buffer allocated by wincCmdReqPoolAlloc as free.
+
+  Precondition:
+    None.
+
+  Parameters:
+    pBuffer - Pointer to buffer.
+
+  Returns:
+    true if the buffer belonged to the pool, otherwise false.
+
+  Remarks:
+    None.
+
+*/
+
+static bool wincCmdReqPoolFree(void *pBuffer)
+{
+    OSAL_CRITSECT_DATA_TYPE critSect;
+    WDRV_WINC_CMD_REQ_POOL *pPool;
+    size_t i;
+    size_t blockIdx;
+
+    for (i=0; i<WDRV_WINC_CMD_REQ_POOL_NUM_CLASSES; i++)
+    {
+        pPool = &cmdReqPool[i];
+
+        if (((uint8_t*)pBuffer < pPool->pMem) || ((uint8_t*)pBuffer >= &pPool->pMem[(size_t)pPool->stats.numBlocks * pPool->stats.blockSize]))
+        {
+            continue;
+        }
+
+        blockIdx = ((size_t)((uint8_t*)pBuffer - pPool->pMem)) / pPool->stats.blockSize;
+
+        critSect = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_HIGH);
+
+        if (0U == (pPool->freeMask & (1UL << blockIdx)))
+        {
+            pPool->freeMask |= (1UL << blockIdx);
+            pPool->stats.numFree++;
+        }
+
+        OSAL_CRIT_Leave(OSAL_CRIT_TYPE_HIGH, critSect);
+
+        return true;
+    }
+
+    return false;
+}
+
 //*******************************************************************************
 /*
   Function:
@@ -941,7 +1153,7 @@ static void wincCmdRspCallbackHandler
 
         case WINC_DEV_CMDREQ_EVENT_STATUS_COMPLETE:
         {
-            OSAL_Free((WINC_COMMAND_REQUEST*)cmdReqHandle);
+            WDRV_WINC_DevDiscardCmdReq(cmdReqHandle);
             break;
         }
 
@@ -993,7 +1205,7 @@ static void wincCmdRspCallbackHandler
     Callback will be called to process any AEC messages received.
 
   Precondition:
-    WINC_DevAECCallbackRegister must be called to register the callback.
+    WINC_DevAECCallbackRegisterMask must be called to register the callback.
 
   Parameters:
     context   - Pointer to user context supplied when callback was registered.
@@ -1011,22 +1223,64 @@ static void wincCmdRspCallbackHandler
 static void wincProcessAEC(uintptr_t context, WINC_DEVICE_HANDLE devHandle, const WINC_DEV_EVENT_RSP_ELEMS *const pElems)
 {
     const WDRV_WINC_DCPT *pDcpt = (const WDRV_WINC_DCPT *)context;
-    unsigned int i;
+    unsigned int modIdx;
 
     if ((NULL == pDcpt) || (NULL == pDcpt->pCtrl) || (NULL == pElems))
     {
         return;
     }
 
-    for (i=0; i<(sizeof(wincAecCallbackTable)/sizeof(WINC_DEV_AEC_RSP_CB)); i++)
+    /* Dispatch directly to the module which raised the AEC. */
+
+    modIdx = (unsigned int)(pElems->rspId >> 8);
+
+    if ((modIdx >= WINC_DEV_AEC_NUM_MODULES) || (NULL == wincAecCallbackTable[modIdx]))
     {
-        if (NULL == wincAecCallbackTable[i])
+        return;
+    }
+
+    wincAecCallbackTable[modIdx](context, devHandle, pElems);
+}
+
+//*******************************************************************************
+/*
+  Function:
+    static uint64_t wincAECModMaskGet(void)
+
+  Summary:
+    Get the AEC subscription mask.
+
+  Description:
+    Builds the mask of modules handled by the AEC callback dispatch table.
+
+  Precondition:
+    None.
+
+  Parameters:
+    None.
+
+  Returns:
+    AEC subscription mask.
+
+  Remarks:
+    None.
+
+*/
+
+static uint64_t wincAECModMaskGet(void)
+{
+    uint64_t modMask = 0;
+    unsigned int i;
+
+    for (i=0; i<WINC_DEV_AEC_NUM_MODULES; i++)
+    {
+        if (NULL != wincAecCallbackTable[i])
         {
-            continue;
+            modMask |= WINC_DEV_AEC_MOD_MASK(i);
         }
-
-        wincAecCallbackTable[i](context, devHandle, pElems);
     }
+
+    return modMask;
 }
 
 // *****************************************************************************
@@ -1146,7 +1400,7 @@ SYS_MODULE_OBJ WDRV_WINC_Initialize
             return SYS_MODULE_OBJ_INVALID;
         }
 #endif
-        (void)WINC_DevAECCallbackRegister(wincCtrlDescriptor.wincDevHandle, wincProcessAEC, (uintptr_t)pDcpt);
+        (void)WINC_DevAECCallbackRegisterMask(wincCtrlDescriptor.wincDevHandle, wincProcessAEC, (uintptr_t)pDcpt, wincAECModMaskGet());
 
         wincCtrlDescriptor.delayTimer = SYS_TIME_HANDLE_INVALID;
         wincCtrlDescriptor.delayTimerRunning = false;
@@ -1480,6 +1734,13 @@ void WDRV_WINC_Tasks(SYS_MODULE_OBJ object)
             {
                 WINC_CMD_REQ_HANDLE cmdReqHandle;
 
+                WINC_SDIOSendReceiveListSet(WDRV_WINC_SPISendReceiveList);
+                WINC_SDIOTransferQueueSet(WDRV_WINC_SPITransferQueue, WDRV_WINC_SPITransferWait);
+
+#ifdef WDRV_WINC_SPI_SEND_CRC16
+                WINC_SDIOSendCRC16Set(WDRV_WINC_SPISendCRC16);
+#endif
+
                 WINC_DevBusStateSet(pDcpt->pCtrl->wincDevHandle, WINC_DEV_BUS_STATE_ACTIVE);
 
                 wincSystemEvent(pDcpt, WDRV_WINC_SYSTEM_EVENT_DEVICE_INIT_COMPLETE);
@@ -1664,6 +1925,10 @@ void WDRV_WINC_Tasks(SYS_MODULE_OBJ object)
 
                 wincSystemEvent(pDcpt, WDRV_WINC_SYSTEM_EVENT_DEVICE_INIT_BEGIN);
             }
+            else
+            {
+                (void)WINC_SockUpdate(pDcpt->pCtrl->wincDevHandle);
+            }
 
             break;
         }
@@ -2850,9 +3115,16 @@ WINC_CMD_REQ_HANDLE WDRV_WINC_CmdReqInit(unsigned int numCommands, size_t extraD
 {
     WINC_CMD_REQ_HANDLE cmdReqHandle;
     void *pCmdReqBuffer;
-    size_t bufferSize = (128U*numCommands) + extraDataLen;
+    size_t bufferSize = (WDRV_WINC_CMD_REQ_CMD_SZ*numCommands) + extraDataLen;
 
-    pCmdReqBuffer = OSAL_Malloc(bufferSize);
+    pCmdReqBuffer = wincCmdReqPoolAlloc(bufferSize);
+
+#if (1 == WDRV_WINC_CMD_REQ_POOL_HEAP_FALLBACK)
+    if (NULL == pCmdReqBuffer)
+    {
+        pCmdReqBuffer = OSAL_Malloc(bufferSize);
+    }
+#endif
 
     if (NULL == pCmdReqBuffer)
     {
@@ -2863,7 +3135,11 @@ WINC_CMD_REQ_HANDLE WDRV_WINC_CmdReqInit(unsigned int numCommands, size_t extraD
 
     if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
     {
-        OSAL_Free(pCmdReqBuffer);
+        if (false == wincCmdReqPoolFree(pCmdReqBuffer))
+        {
+            OSAL_Free(pCmdReqBuffer);
+        }
+
         return WINC_CMD_REQ_INVALID_HANDLE;
     }
 
@@ -2905,7 +3181,7 @@ bool WDRV_WINC_DevTransmitCmdReq(WDRV_WINC_CTRLDCPT *pCtrl, WINC_CMD_REQ_HANDLE
 
     if (false == WINC_DevTransmitCmdReq(pCtrl->wincDevHandle, cmdReqHandle))
     {
-        OSAL_Free((WINC_COMMAND_REQUEST*)cmdReqHandle);
+        WDRV_WINC_DevDiscardCmdReq(cmdReqHandle);
         return false;
     }
 
@@ -2935,7 +3211,112 @@ void WDRV_WINC_DevDiscardCmdReq(WINC_CMD_REQ_HANDLE cmdReqHandle)
         return;
     }
 
-    OSAL_Free((WINC_COMMAND_REQUEST*)cmdReqHandle);
+    if (false == wincCmdReqPoolFree((void*)cmdReqHandle))
+    {
+        OSAL_Free((WINC_COMMAND_REQUEST*)cmdReqHandle);
+    }
+}
+
+//*******************************************************************************
+/*
+  Function:
+    bool WDRV_WINC_CmdReqPoolAvailable
+    (
+        unsigned int numCommands,
+        size_t extraDataLen
+    )
+
+  Summary:
+    Checks if a command request buffer is available.
+
+  Description:
+    Determines if WDRV_WINC_CmdReqInit can currently allocate a command
+    request of the size given.
+
+  Remarks:
+    See wdrv_winc.h for usage information.
+
+*/
+
+bool WDRV_WINC_CmdReqPoolAvailable(unsigned int numCommands, size_t extraDataLen)
+{
+    size_t bufferSize = (WDRV_WINC_CMD_REQ_CMD_SZ*numCommands) + extraDataLen;
+    size_t i;
+    bool fitted = false;
+
+    for (i=0; i<WDRV_WINC_CMD_REQ_POOL_NUM_CLASSES; i++)
+    {
+        if (bufferSize > cmdReqPool[i].stats.blockSize)
+        {
+            continue;
+        }
+
+        if (0U != cmdReqPool[i].freeMask)
+        {
+            return true;
+        }
+
+        fitted = true;
+    }
+
+#if (1 == WDRV_WINC_CMD_REQ_POOL_HEAP_FALLBACK)
+    /* Requests larger than every size class are only ever served by the heap. */
+    if (false == fitted)
+    {
+        return true;
+    }
+#else
+    (void)fitted;
+#endif
+
+    return false;
+}
+
+//*******************************************************************************
+/*
+  Function:
+    int WDRV_WINC_CmdReqPoolStatsGet
+    (
+        WDRV_WINC_CMD_REQ_POOL_STATS *pStats,
+        int numStats
+    )
+
+  Summary:
+    Returns the command request pool statistics.
+
+  Description:
+    Copies the statistics of each size class of the command request pool.
+
+  Remarks:
+    See wdrv_winc.h for usage information.
+
+*/
+
+int WDRV_WINC_CmdReqPoolStatsGet(WDRV_WINC_CMD_REQ_POOL_STATS *pStats, int numStats)
+{
+    OSAL_CRITSECT_DATA_TYPE critSect;
+    int i;
+
+    if ((NULL == pStats) || (numStats <= 0))
+    {
+        return -1;
+    }
+
+    if (numStats > (int)WDRV_WINC_CMD_REQ_POOL_NUM_CLASSES)
+    {
+        numStats = (int)WDRV_WINC_CMD_REQ_POOL_NUM_CLASSES;
+    }
+
+    critSect = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_HIGH);
+
+    for (i=0; i<numStats; i++)
+    {
+        (void)memcpy(&pStats[i], &cmdReqPool[i].stats, sizeof(WDRV_WINC_CMD_REQ_POOL_STATS));
+    }
+
+    OSAL_CRIT_Leave(OSAL_CRIT_TYPE_HIGH, critSect);
+
+    return numStats;
 }
 
 //*******************************************************************************
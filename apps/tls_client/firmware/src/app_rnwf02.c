@@ -64,6 +64,7 @@
 #include "system/wifi/sys_rnwf_wifi_service.h"
 #include "system/inf/sys_rnwf_interface.h"
 #include "system/net/sys_rnwf_net_service.h"
+#include "system/http/sys_rnwf_http_client.h"
 #include "system/sys_rnwf_system_service.h"
 
 /* Variable to check the UART transfer */
@@ -71,13 +72,12 @@ static volatile bool isUARTTxComplete = true,isUART0TxComplete = true;
 
 /*TCP buffer maximum length*/
 #define TCP_BUF_LEN_MAX     6144
-#define HTTP_CONTENT_LEN    "Content-Length:"
 
 /*Stores TCP data*/
 uint8_t g_tcpData[TCP_BUF_LEN_MAX];
 
-/*variable to store the downloading file length*/
-static uint32_t g_fileLen = 0;
+/*HTTP client of the file download*/
+static SYS_RNWF_HTTP_CLIENT_t g_httpClient;
 
 /*Application buffer to store data*/
 static uint8_t g_appBuf[SYS_RNWF_IF_LEN_MAX];
@@ -111,7 +111,8 @@ static const char *g_tlsCfg_1[] =
                                 };
 
 /*AWS server file request configuration*/
-static uint8_t g_awsFileRequest[] = "GET /ref_doc.pdf HTTP/1.1\r\nHost: file-download-files.s3-us-west-2.amazonaws.com\r\nConnection: close\r\n\r\n";
+#define APP_HTTP_FILE_HOST  "file-download-files.s3-us-west-2.amazonaws.com"
+#define APP_HTTP_FILE_PATH  "/ref_doc.pdf"
 
 
 /* DMAC Channel Handler Function */
@@ -207,12 +208,47 @@ void SYS_RNWF_WIFI_CallbackHandler(SYS_RNWF_WIFI_EVENT_t event,SYS_RNWF_WIFI_HAN
 }
 
 
+/* Application HTTP client Callback Handler function */
+static void APP_RNWF_HttpCallback(SYS_RNWF_HTTP_EVENT_t event, const SYS_RNWF_HTTP_RESPONSE_t *response, const uint8_t *data, uint32_t length, void *context)
+{
+    switch(event)
+    {
+        case SYS_RNWF_HTTP_EVENT_HEADERS_DONE:
+        {
+            SYS_CONSOLE_PRINT("HTTP Status = %d\r\n", response->status);
+            if(response->contentLength != SYS_RNWF_HTTP_LEN_UNKNOWN)
+            {
+                SYS_CONSOLE_PRINT("File Size = %lu\r\n", response->contentLength);
+            }
+            break;
+        }
+
+        case SYS_RNWF_HTTP_EVENT_BODY:
+        {
+            SYS_CONSOLE_PRINT("Received %lu bytes\r\n", response->bodyRx);
+            break;
+        }
+
+        case SYS_RNWF_HTTP_EVENT_RESPONSE_DONE:
+        {
+            SYS_CONSOLE_PRINT("Receive Complete!\r\n");
+            break;
+        }
+
+        case SYS_RNWF_HTTP_EVENT_ERROR:
+        default:
+        {
+            SYS_CONSOLE_PRINT("HTTP Response Error!\r\n");
+            break;
+        }
+    }
+}
+
+
 /* Application NET socket Callback Handler function */
 void SYS_RNWF_NET_SockCallbackHandler(uint32_t socket, SYS_RNWF_NET_SOCK_EVENT_t event,SYS_RNWF_NET_HANDLE_t netHandler)
 {
      uint8_t *p_str = ( uint8_t *)netHandler;
-    uint8_t *tmpPtr;
-   volatile static uint32_t rcvd_bytes;
     switch(event)
     {
         /* Net socket connected event code*/
@@ -225,7 +261,8 @@ void SYS_RNWF_NET_SockCallbackHandler(uint32_t socket, SYS_RNWF_NET_SOCK_EVENT_t
         /* Net socket TLS done event code*/
         case SYS_RNWF_NET_SOCK_EVENT_TLS_DONE:
         {
-            SYS_RNWF_NET_TcpSockWrite(socket, strlen((char *)g_awsFileRequest), g_awsFileRequest); 
+            SYS_RNWF_HTTP_ClientInit(&g_httpClient, socket, APP_HTTP_FILE_HOST, APP_RNWF_HttpCallback, NULL);
+            SYS_RNWF_HTTP_ClientGet(&g_httpClient, APP_HTTP_FILE_PATH, 0, 0);
             break;
         }   
         
@@ -241,39 +278,10 @@ void SYS_RNWF_NET_SockCallbackHandler(uint32_t socket, SYS_RNWF_NET_SOCK_EVENT_t
         /* Net socket read event code*/
         case SYS_RNWF_NET_SOCK_EVENT_READ:
         {                     
-            volatile int ret_val;
             uint16_t rx_len = *(uint16_t *)p_str;              
-            while(rx_len)
+            if(SYS_RNWF_HTTP_ClientReceive(&g_httpClient, rx_len, g_tcpData, TCP_BUF_LEN_MAX) != SYS_RNWF_PASS)
             {
-                uint16_t read_len = (rx_len > TCP_BUF_LEN_MAX)?TCP_BUF_LEN_MAX:rx_len;                
-                if(((ret_val = SYS_RNWF_NET_TcpSockRead(socket, read_len, g_tcpData)) > 0))
-                {                              
-                    if(!g_fileLen)
-                    {
-                        
-                        SYS_CONSOLE_PRINT("%.*s\r\n", ret_val, g_tcpData);
-                        if((tmpPtr = (uint8_t *)strstr((const char *)g_tcpData,(const char *) HTTP_CONTENT_LEN)) != NULL)
-                        {
-                            volatile char *token = strtok((char *)tmpPtr, "\r\n");
-                            g_fileLen = strtol((const char *)(token+sizeof(HTTP_CONTENT_LEN)), NULL, 10);                                                        
-                            SYS_CONSOLE_PRINT("File Size = %lu\r\n", g_fileLen);
-                        }
-                        break;
-                    }
-                    rcvd_bytes += ret_val;
-                    rx_len -= ret_val;
-                    SYS_CONSOLE_PRINT("Received %lu bytes\r\n", rcvd_bytes);
-                    if(rcvd_bytes >= g_fileLen)
-                    {
-                        SYS_CONSOLE_PRINT("Receive Complete!\r\n");  
-//                        SYS_RNWF_NET_SockSrvCtrl(SYS_RNWF_NET_SOCK_CLOSE, (void *)&socket);
-                    }                    
-                }            
-                else
-                {
-                    SYS_CONSOLE_PRINT("Read Timeout!\r\n");
-                    break;
-                }
+                SYS_CONSOLE_PRINT("Read Timeout!\r\n");
             }
             break; 
         }
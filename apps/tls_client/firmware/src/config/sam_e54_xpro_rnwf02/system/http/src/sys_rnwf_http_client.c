@@ -0,0 +1,691 @@
+/*******************************************************************************
+  RNWF Host Assisted HTTP Client Implementation
+
+  File Name:
+    sys_rnwf_http_client.c
+
+  Summary:
+    Source code for the RNWF Host Assisted HTTP/1.1 client implementation.
+
+  Description:
+    This file contains the source code for the incremental HTTP/1.1 response
+    parser and the persistent connection client built on the RNWF NET socket
+    service.
+ *******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (C) 2020 released Microchip Technology Inc.  All rights reserved.
+
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED AS IS WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+ *******************************************************************************/
+//DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* This section lists the other files that are included in this file.
+ */
+
+#include "configuration.h"
+#include "system/inf/sys_rnwf_interface.h"
+#include "system/net/sys_rnwf_net_service.h"
+#include "system/http/sys_rnwf_http_client.h"
+
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+// Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+/* Lower case conversion of an ASCII character */
+static inline char SYS_RNWF_HTTP_ToLower(char c)
+{
+    return ((c >= 'A') && (c <= 'Z')) ? (char)(c - 'A' + 'a') : c;
+}
+
+
+/* Case insensitive compare of a header name, returns the value or NULL */
+static const char *SYS_RNWF_HTTP_HeaderValue(const char *line, const char *name)
+{
+    while (*name != '\0')
+    {
+        if (SYS_RNWF_HTTP_ToLower(*line++) != SYS_RNWF_HTTP_ToLower(*name++))
+        {
+            return NULL;
+        }
+    }
+
+    if (*line++ != ':')
+    {
+        return NULL;
+    }
+
+    while ((*line == ' ') || (*line == '\t'))
+    {
+        line++;
+    }
+
+    return line;
+}
+
+
+/* Case insensitive search for a token within a header value */
+static bool SYS_RNWF_HTTP_ValueHasToken(const char *value, const char *token)
+{
+    size_t tokenLen = strlen(token);
+
+    for (; *value != '\0'; value++)
+    {
+        size_t i;
+
+        for (i = 0; i < tokenLen; i++)
+        {
+            if (SYS_RNWF_HTTP_ToLower(value[i]) != token[i])
+            {
+                break;
+            }
+        }
+
+        if (i == tokenLen)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/* Complete the current response and prepare for a pipelined one */
+static void SYS_RNWF_HTTP_ResponseDone(SYS_RNWF_HTTP_PARSER_t *parser)
+{
+    parser->state = SYS_RNWF_HTTP_STATE_STATUS_LINE;
+    parser->callback(SYS_RNWF_HTTP_EVENT_RESPONSE_DONE, &parser->response, NULL, 0, parser->context);
+}
+
+
+/* Move the parser to the error state */
+static SYS_RNWF_RESULT_t SYS_RNWF_HTTP_ParseError(SYS_RNWF_HTTP_PARSER_t *parser)
+{
+    parser->state = SYS_RNWF_HTTP_STATE_ERROR;
+    parser->callback(SYS_RNWF_HTTP_EVENT_ERROR, &parser->response, NULL, 0, parser->context);
+
+    return SYS_RNWF_FAIL;
+}
+
+
+/* Parse the status line "HTTP/1.x SSS Reason" */
+static SYS_RNWF_RESULT_t SYS_RNWF_HTTP_StatusLine(SYS_RNWF_HTTP_PARSER_t *parser)
+{
+    SYS_RNWF_HTTP_RESPONSE_t *response = &parser->response;
+    const char *line = parser->line;
+
+    /* Tolerate empty lines between pipelined responses */
+    if (parser->lineLen == 0)
+    {
+        return SYS_RNWF_PASS;
+    }
+
+    if ((parser->lineOverflow == true) || (strncmp(line, "HTTP/1.", 7) != 0))
+    {
+        return SYS_RNWF_HTTP_ParseError(parser);
+    }
+
+    memset(response, 0, sizeof(SYS_RNWF_HTTP_RESPONSE_t));
+    response->keepAlive     = (line[7] != '0');
+    response->contentLength = SYS_RNWF_HTTP_LEN_UNKNOWN;
+    response->rangeTotal    = SYS_RNWF_HTTP_LEN_UNKNOWN;
+    response->status        = (uint16_t)strtoul(&line[8], NULL, 10);
+
+    if ((response->status < 100) || (response->status > 999))
+    {
+        return SYS_RNWF_HTTP_ParseError(parser);
+    }
+
+    parser->state = SYS_RNWF_HTTP_STATE_HEADER;
+
+    return SYS_RNWF_PASS;
+}
+
+
+/* End of the header section, select how the body is delimited */
+static void SYS_RNWF_HTTP_HeadersDone(SYS_RNWF_HTTP_PARSER_t *parser)
+{
+    SYS_RNWF_HTTP_RESPONSE_t *response = &parser->response;
+
+    /* Informational responses are followed by the final response */
+    if (response->status < 200)
+    {
+        parser->state = SYS_RNWF_HTTP_STATE_STATUS_LINE;
+        return;
+    }
+
+    parser->callback(SYS_RNWF_HTTP_EVENT_HEADERS_DONE, response, NULL, 0, parser->context);
+
+    if ((response->status == 204) || (response->status == 304))
+    {
+        SYS_RNWF_HTTP_ResponseDone(parser);
+    }
+    else if (response->chunked == true)
+    {
+        parser->state = SYS_RNWF_HTTP_STATE_CHUNK_SIZE;
+    }
+    else if (response->contentLength == 0)
+    {
+        SYS_RNWF_HTTP_ResponseDone(parser);
+    }
+    else if (response->contentLength != SYS_RNWF_HTTP_LEN_UNKNOWN)
+    {
+        parser->remaining = response->contentLength;
+        parser->state     = SYS_RNWF_HTTP_STATE_BODY;
+    }
+    else
+    {
+        response->keepAlive = false;
+        parser->state       = SYS_RNWF_HTTP_STATE_BODY_TO_CLOSE;
+    }
+}
+
+
+/* Parse a header line, only the headers needed by the client are kept */
+static void SYS_RNWF_HTTP_HeaderLine(SYS_RNWF_HTTP_PARSER_t *parser)
+{
+    SYS_RNWF_HTTP_RESPONSE_t *response = &parser->response;
+    const char *value;
+
+    if (parser->lineLen == 0)
+    {
+        SYS_RNWF_HTTP_HeadersDone(parser);
+        return;
+    }
+
+    if (parser->lineOverflow == true)
+    {
+        return;
+    }
+
+    if ((value = SYS_RNWF_HTTP_HeaderValue(parser->line, "Content-Length")) != NULL)
+    {
+        response->contentLength = strtoul(value, NULL, 10);
+    }
+    else if ((value = SYS_RNWF_HTTP_HeaderValue(parser->line, "Transfer-Encoding")) != NULL)
+    {
+        response->chunked = SYS_RNWF_HTTP_ValueHasToken(value, "chunked");
+    }
+    else if ((value = SYS_RNWF_HTTP_HeaderValue(parser->line, "Connection")) != NULL)
+    {
+        if (SYS_RNWF_HTTP_ValueHasToken(value, "close") == true)
+        {
+            response->keepAlive = false;
+        }
+        else if (SYS_RNWF_HTTP_ValueHasToken(value, "keep-alive") == true)
+        {
+            response->keepAlive = true;
+        }
+    }
+    else if ((value = SYS_RNWF_HTTP_HeaderValue(parser->line, "Content-Range")) != NULL)
+    {
+        char *end;
+
+        /* bytes <first>-<last>/<complete-length> */
+        if (strncmp(value, "bytes ", 6) == 0)
+        {
+            response->rangeStart = strtoul(&value[6], &end, 10);
+
+            if ((end = strchr(end, '/')) != NULL)
+            {
+                if (end[1] != '*')
+                {
+                    response->rangeTotal = strtoul(&end[1], NULL, 10);
+                }
+            }
+        }
+    }
+    else
+    {
+    }
+}
+
+
+/* Parse a chunk-size line, chunk extensions are ignored */
+static SYS_RNWF_RESULT_t SYS_RNWF_HTTP_ChunkSizeLine(SYS_RNWF_HTTP_PARSER_t *parser)
+{
+    char *end;
+    uint32_t chunkSize;
+
+    if ((parser->lineLen == 0) || (parser->lineOverflow == true))
+    {
+        return SYS_RNWF_HTTP_ParseError(parser);
+    }
+
+    chunkSize = strtoul(parser->line, &end, 16);
+
+    if (end == parser->line)
+    {
+        return SYS_RNWF_HTTP_ParseError(parser);
+    }
+
+    if (chunkSize == 0)
+    {
+        parser->state = SYS_RNWF_HTTP_STATE_CHUNK_TRAILER;
+    }
+    else
+    {
+        parser->remaining = chunkSize;
+        parser->state     = SYS_RNWF_HTTP_STATE_CHUNK_DATA;
+    }
+
+    return SYS_RNWF_PASS;
+}
+
+
+/* Process a complete line in one of the line oriented states */
+static SYS_RNWF_RESULT_t SYS_RNWF_HTTP_LineProcess(SYS_RNWF_HTTP_PARSER_t *parser)
+{
+    SYS_RNWF_RESULT_t result = SYS_RNWF_PASS;
+
+    switch (parser->state)
+    {
+        case SYS_RNWF_HTTP_STATE_STATUS_LINE:
+        {
+            result = SYS_RNWF_HTTP_StatusLine(parser);
+            break;
+        }
+
+        case SYS_RNWF_HTTP_STATE_HEADER:
+        {
+            SYS_RNWF_HTTP_HeaderLine(parser);
+            break;
+        }
+
+        case SYS_RNWF_HTTP_STATE_CHUNK_SIZE:
+        {
+            result = SYS_RNWF_HTTP_ChunkSizeLine(parser);
+            break;
+        }
+
+        case SYS_RNWF_HTTP_STATE_CHUNK_DATA_END:
+        {
+            if (parser->lineLen != 0)
+            {
+                result = SYS_RNWF_HTTP_ParseError(parser);
+                break;
+            }
+
+            parser->state = SYS_RNWF_HTTP_STATE_CHUNK_SIZE;
+            break;
+        }
+
+        case SYS_RNWF_HTTP_STATE_CHUNK_TRAILER:
+        {
+            if (parser->lineLen == 0)
+            {
+                SYS_RNWF_HTTP_ResponseDone(parser);
+            }
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+    parser->lineLen      = 0;
+    parser->lineOverflow = false;
+
+    return result;
+}
+
+
+/* Client parser callback, tracks the pipeline and forwards the event */
+static void SYS_RNWF_HTTP_ClientCallback
+(
+    SYS_RNWF_HTTP_EVENT_t event,
+    const SYS_RNWF_HTTP_RESPONSE_t *response,
+    const uint8_t *data,
+    uint32_t length,
+    void *context
+)
+{
+    SYS_RNWF_HTTP_CLIENT_t *client = (SYS_RNWF_HTTP_CLIENT_t *)context;
+
+    if (event == SYS_RNWF_HTTP_EVENT_RESPONSE_DONE)
+    {
+        if (client->outstanding > 0)
+        {
+            client->outstanding--;
+        }
+
+        if (response->keepAlive == false)
+        {
+            client->reusable = false;
+        }
+    }
+    else if (event == SYS_RNWF_HTTP_EVENT_ERROR)
+    {
+        client->reusable = false;
+    }
+    else
+    {
+    }
+
+    if (client->callback != NULL)
+    {
+        client->callback(event, response, data, length, client->context);
+    }
+}
+
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+// Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+/* Initialize an HTTP response parser */
+void SYS_RNWF_HTTP_ParserInit
+(
+    SYS_RNWF_HTTP_PARSER_t *parser,
+    SYS_RNWF_HTTP_CALLBACK_t callback,
+    void *context
+)
+{
+    memset(parser, 0, sizeof(SYS_RNWF_HTTP_PARSER_t));
+
+    parser->state    = SYS_RNWF_HTTP_STATE_STATUS_LINE;
+    parser->callback = callback;
+    parser->context  = context;
+}
+
+
+/* Feed received bytes into an HTTP response parser */
+SYS_RNWF_RESULT_t SYS_RNWF_HTTP_ParserFeed
+(
+    SYS_RNWF_HTTP_PARSER_t *parser,
+    const uint8_t *data,
+    uint32_t length
+)
+{
+    uint32_t idx = 0;
+
+    while (idx < length)
+    {
+        switch (parser->state)
+        {
+            case SYS_RNWF_HTTP_STATE_BODY:
+            case SYS_RNWF_HTTP_STATE_CHUNK_DATA:
+            {
+                uint32_t bodyLen = length - idx;
+
+                if (bodyLen > parser->remaining)
+                {
+                    bodyLen = parser->remaining;
+                }
+
+                parser->remaining         -= bodyLen;
+                parser->response.bodyRx   += bodyLen;
+                parser->callback(SYS_RNWF_HTTP_EVENT_BODY, &parser->response, &data[idx], bodyLen, parser->context);
+                idx += bodyLen;
+
+                if (parser->remaining == 0)
+                {
+                    if (parser->state == SYS_RNWF_HTTP_STATE_BODY)
+                    {
+                        SYS_RNWF_HTTP_ResponseDone(parser);
+                    }
+                    else
+                    {
+                        parser->state = SYS_RNWF_HTTP_STATE_CHUNK_DATA_END;
+                    }
+                }
+                break;
+            }
+
+            case SYS_RNWF_HTTP_STATE_BODY_TO_CLOSE:
+            {
+                parser->response.bodyRx += (length - idx);
+                parser->callback(SYS_RNWF_HTTP_EVENT_BODY, &parser->response, &data[idx], length - idx, parser->context);
+                idx = length;
+                break;
+            }
+
+            case SYS_RNWF_HTTP_STATE_ERROR:
+            {
+                return SYS_RNWF_FAIL;
+            }
+
+            default:
+            {
+                /* Line oriented states, lines may be split across buffers */
+                const uint8_t *eol = memchr(&data[idx], '\n', length - idx);
+                uint32_t lineLen = (eol != NULL) ? (uint32_t)(eol - &data[idx]) : (length - idx);
+
+                if ((parser->lineLen + lineLen) < SYS_RNWF_HTTP_LINE_LEN_MAX)
+                {
+                    memcpy(&parser->line[parser->lineLen], &data[idx], lineLen);
+                    parser->lineLen += lineLen;
+                }
+                else
+                {
+                    parser->lineOverflow = true;
+                }
+
+                idx += lineLen;
+
+                if (eol == NULL)
+                {
+                    break;
+                }
+
+                idx++;
+
+                if ((parser->lineLen > 0) && (parser->line[parser->lineLen - 1] == '\r'))
+                {
+                    parser->lineLen--;
+                }
+                parser->line[parser->lineLen] = '\0';
+
+                if (SYS_RNWF_HTTP_LineProcess(parser) != SYS_RNWF_PASS)
+                {
+                    return SYS_RNWF_FAIL;
+                }
+                break;
+            }
+        }
+    }
+
+    return SYS_RNWF_PASS;
+}
+
+
+/* Inform the parser that the connection was closed by the peer */
+SYS_RNWF_RESULT_t SYS_RNWF_HTTP_ParserClose
+(
+    SYS_RNWF_HTTP_PARSER_t *parser
+)
+{
+    if (parser->state == SYS_RNWF_HTTP_STATE_BODY_TO_CLOSE)
+    {
+        SYS_RNWF_HTTP_ResponseDone(parser);
+        return SYS_RNWF_PASS;
+    }
+
+    if ((parser->state == SYS_RNWF_HTTP_STATE_STATUS_LINE) && (parser->lineLen == 0))
+    {
+        return SYS_RNWF_PASS;
+    }
+
+    if (parser->state == SYS_RNWF_HTTP_STATE_ERROR)
+    {
+        return SYS_RNWF_FAIL;
+    }
+
+    return SYS_RNWF_HTTP_ParseError(parser);
+}
+
+
+/* Format an HTTP/1.1 GET request */
+size_t SYS_RNWF_HTTP_RequestFormat
+(
+    char *buffer,
+    size_t size,
+    const char *host,
+    const char *path,
+    uint32_t rangeStart,
+    uint32_t rangeEnd,
+    bool keepAlive
+)
+{
+    int len;
+    size_t reqLen;
+
+    len = snprintf(buffer, size, SYS_RNWF_HTTP_GET_REQ, (path[0] == '/') ? "" : "/", path, host);
+
+    if ((len < 0) || ((size_t)len >= size))
+    {
+        return 0;
+    }
+    reqLen = (size_t)len;
+
+    if (rangeEnd != 0)
+    {
+        len = snprintf(&buffer[reqLen], size - reqLen, SYS_RNWF_HTTP_RANGE_HDR, (unsigned long)rangeStart, (unsigned long)rangeEnd);
+
+        if ((len < 0) || ((size_t)len >= (size - reqLen)))
+        {
+            return 0;
+        }
+        reqLen += (size_t)len;
+    }
+
+    len = snprintf(&buffer[reqLen], size - reqLen, "%s", (keepAlive == true) ? SYS_RNWF_HTTP_CONN_KEEP_ALIVE : SYS_RNWF_HTTP_CONN_CLOSE);
+
+    if ((len < 0) || ((size_t)len >= (size - reqLen)))
+    {
+        return 0;
+    }
+
+    return reqLen + (size_t)len;
+}
+
+
+/* Initialize an HTTP client on a connected socket */
+void SYS_RNWF_HTTP_ClientInit
+(
+    SYS_RNWF_HTTP_CLIENT_t *client,
+    uint32_t socket,
+    const char *host,
+    SYS_RNWF_HTTP_CALLBACK_t callback,
+    void *context
+)
+{
+    SYS_RNWF_HTTP_ParserInit(&client->parser, SYS_RNWF_HTTP_ClientCallback, client);
+
+    client->socket      = socket;
+    client->host        = host;
+    client->outstanding = 0;
+    client->reusable    = true;
+    client->callback    = callback;
+    client->context     = context;
+}
+
+
+/* Send a GET request on the client connection */
+SYS_RNWF_RESULT_t SYS_RNWF_HTTP_ClientGet
+(
+    SYS_RNWF_HTTP_CLIENT_t *client,
+    const char *path,
+    uint32_t rangeStart,
+    uint32_t rangeEnd
+)
+{
+    size_t reqLen;
+
+    if ((client->reusable == false) || (client->outstanding >= SYS_RNWF_HTTP_PIPELINE_DEPTH_MAX))
+    {
+        return SYS_RNWF_FAIL;
+    }
+
+    reqLen = SYS_RNWF_HTTP_RequestFormat(client->request, sizeof(client->request), client->host, path, rangeStart, rangeEnd, true);
+
+    if (reqLen == 0)
+    {
+        return SYS_RNWF_FAIL;
+    }
+
+    if (SYS_RNWF_NET_TcpSockWrite(client->socket, (uint16_t)reqLen, (uint8_t *)client->request) != SYS_RNWF_PASS)
+    {
+        return SYS_RNWF_FAIL;
+    }
+
+    client->outstanding++;
+
+    return SYS_RNWF_PASS;
+}
+
+
+/* Read pending socket data and pass it through the client parser */
+SYS_RNWF_RESULT_t SYS_RNWF_HTTP_ClientReceive
+(
+    SYS_RNWF_HTTP_CLIENT_t *client,
+    uint16_t rxLen,
+    uint8_t *buffer,
+    uint16_t size
+)
+{
+    while (rxLen > 0)
+    {
+        uint16_t readLen = (rxLen > size) ? size : rxLen;
+        int16_t readSize = SYS_RNWF_NET_TcpSockRead(client->socket, readLen, buffer);
+
+        if (readSize <= 0)
+        {
+            return SYS_RNWF_FAIL;
+        }
+
+        rxLen -= (uint16_t)readSize;
+
+        if (SYS_RNWF_HTTP_ParserFeed(&client->parser, buffer, (uint32_t)readSize) != SYS_RNWF_PASS)
+        {
+            return SYS_RNWF_FAIL;
+        }
+    }
+
+    return SYS_RNWF_PASS;
+}
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,318 @@
+/*******************************************************************************
+  RNWF Host Assisted HTTP Client Header file
+
+  File Name:
+    sys_rnwf_http_client.h
+
+  Summary:
+    Header file for the RNWF Host Assisted HTTP/1.1 client implementation.
+
+  Description:
+    This file provides an incremental HTTP/1.1 response parser and a small
+    client on top of the RNWF NET socket service. Responses may be fed in
+    arbitrary fragments, chunked transfer-encoding is decoded and persistent
+    connections can carry several pipelined (range) requests.
+ *******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (C) 2020 released Microchip Technology Inc.  All rights reserved.
+
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef SYS_RNWF_HTTP_CLIENT_H
+#define	SYS_RNWF_HTTP_CLIENT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "system/inf/sys_rnwf_interface.h"
+
+/* Longest status, header or chunk-size line retained by the parser.
+ * Longer header lines are skipped, they are never needed by the client. */
+#define SYS_RNWF_HTTP_LINE_LEN_MAX          128
+
+/* Maximum number of requests pipelined on one connection */
+#define SYS_RNWF_HTTP_PIPELINE_DEPTH_MAX    4
+
+/* Size of the request formatting buffer of a client */
+#define SYS_RNWF_HTTP_REQ_LEN_MAX           256
+
+/* Content length value used when the response does not carry one */
+#define SYS_RNWF_HTTP_LEN_UNKNOWN           0xFFFFFFFFU
+
+/* HTTP request formats */
+#define SYS_RNWF_HTTP_GET_REQ               "GET %s%s HTTP/1.1\r\nHost: %s\r\n"
+#define SYS_RNWF_HTTP_RANGE_HDR             "Range: bytes=%lu-%lu\r\n"
+#define SYS_RNWF_HTTP_CONN_KEEP_ALIVE       "Connection: keep-alive\r\n\r\n"
+#define SYS_RNWF_HTTP_CONN_CLOSE            "Connection: close\r\n\r\n"
+
+/**
+ @brief HTTP parser states
+ */
+typedef enum
+{
+    /**<Waiting for the status line*/
+    SYS_RNWF_HTTP_STATE_STATUS_LINE,
+
+    /**<Receiving header lines*/
+    SYS_RNWF_HTTP_STATE_HEADER,
+
+    /**<Receiving a Content-Length delimited body*/
+    SYS_RNWF_HTTP_STATE_BODY,
+
+    /**<Receiving a body delimited by connection close*/
+    SYS_RNWF_HTTP_STATE_BODY_TO_CLOSE,
+
+    /**<Receiving a chunk-size line*/
+    SYS_RNWF_HTTP_STATE_CHUNK_SIZE,
+
+    /**<Receiving chunk data*/
+    SYS_RNWF_HTTP_STATE_CHUNK_DATA,
+
+    /**<Receiving the CRLF which follows chunk data*/
+    SYS_RNWF_HTTP_STATE_CHUNK_DATA_END,
+
+    /**<Receiving the trailer section of a chunked body*/
+    SYS_RNWF_HTTP_STATE_CHUNK_TRAILER,
+
+    /**<Unrecoverable protocol error*/
+    SYS_RNWF_HTTP_STATE_ERROR,
+
+}SYS_RNWF_HTTP_STATE_t;
+
+/**
+ @brief HTTP parser events
+ */
+typedef enum
+{
+    /**<Status line and headers parsed, response info is valid*/
+    SYS_RNWF_HTTP_EVENT_HEADERS_DONE,
+
+    /**<Body data, points into the buffer passed to the parser*/
+    SYS_RNWF_HTTP_EVENT_BODY,
+
+    /**<Response complete, the parser is ready for the next one*/
+    SYS_RNWF_HTTP_EVENT_RESPONSE_DONE,
+
+    /**<Malformed response, the connection must be closed*/
+    SYS_RNWF_HTTP_EVENT_ERROR,
+
+}SYS_RNWF_HTTP_EVENT_t;
+
+/**
+ @brief HTTP response information
+ */
+typedef struct
+{
+    /**<HTTP status code*/
+    uint16_t    status;
+
+    /**<Body uses chunked transfer-encoding*/
+    bool        chunked;
+
+    /**<Server keeps the connection open after this response*/
+    bool        keepAlive;
+
+    /**<Value of Content-Length or SYS_RNWF_HTTP_LEN_UNKNOWN*/
+    uint32_t    contentLength;
+
+    /**<First byte position of a 206 Content-Range*/
+    uint32_t    rangeStart;
+
+    /**<Complete length of a 206 Content-Range or SYS_RNWF_HTTP_LEN_UNKNOWN*/
+    uint32_t    rangeTotal;
+
+    /**<Body bytes delivered so far*/
+    uint32_t    bodyRx;
+
+}SYS_RNWF_HTTP_RESPONSE_t;
+
+/**
+ @brief HTTP parser callback function type
+
+ For ::SYS_RNWF_HTTP_EVENT_BODY the data pointer refers directly into the
+ buffer given to ::SYS_RNWF_HTTP_ParserFeed, the body is never copied by
+ the parser.
+ */
+typedef void (*SYS_RNWF_HTTP_CALLBACK_t)(SYS_RNWF_HTTP_EVENT_t event, const SYS_RNWF_HTTP_RESPONSE_t *response, const uint8_t *data, uint32_t length, void *context);
+
+/**
+ @brief HTTP incremental response parser
+ */
+typedef struct
+{
+    /**<Current parser state*/
+    SYS_RNWF_HTTP_STATE_t       state;
+
+    /**<Response being parsed*/
+    SYS_RNWF_HTTP_RESPONSE_t    response;
+
+    /**<Remaining bytes of the body or of the current chunk*/
+    uint32_t                    remaining;
+
+    /**<Application callback*/
+    SYS_RNWF_HTTP_CALLBACK_t    callback;
+
+    /**<Application callback context*/
+    void                        *context;
+
+    /**<Length of the partial line held in line*/
+    uint16_t                    lineLen;
+
+    /**<Partial line exceeded SYS_RNWF_HTTP_LINE_LEN_MAX*/
+    bool                        lineOverflow;
+
+    /**<Line accumulation buffer*/
+    char                        line[SYS_RNWF_HTTP_LINE_LEN_MAX];
+
+}SYS_RNWF_HTTP_PARSER_t;
+
+/**
+ @brief HTTP client on a persistent RNWF socket
+ */
+typedef struct
+{
+    /**<Response parser*/
+    SYS_RNWF_HTTP_PARSER_t      parser;
+
+    /**<Connected socket ID*/
+    uint32_t                    socket;
+
+    /**<Host name sent in each request*/
+    const char                  *host;
+
+    /**<Number of requests awaiting a response*/
+    uint8_t                     outstanding;
+
+    /**<Connection can carry further requests*/
+    bool                        reusable;
+
+    /**<Application callback*/
+    SYS_RNWF_HTTP_CALLBACK_t    callback;
+
+    /**<Application callback context*/
+    void                        *context;
+
+    /**<Request formatting buffer*/
+    char                        request[SYS_RNWF_HTTP_REQ_LEN_MAX];
+
+}SYS_RNWF_HTTP_CLIENT_t;
+
+/**
+ * @brief Initialize an HTTP response parser.
+ *
+ * @param[in] parser        Parser instance
+ * @param[in] callback      Event and body sink callback
+ * @param[in] context       Context passed back to the callback
+ */
+void SYS_RNWF_HTTP_ParserInit(SYS_RNWF_HTTP_PARSER_t *parser, SYS_RNWF_HTTP_CALLBACK_t callback, void *context);
+
+/**
+ * @brief Feed received bytes into an HTTP response parser.
+ *
+ * The data may split the response at any position. Several pipelined
+ * responses may be present in one buffer, each is completed with a
+ * ::SYS_RNWF_HTTP_EVENT_RESPONSE_DONE event before the next is parsed.
+ *
+ * @param[in] parser        Parser instance
+ * @param[in] data          Received bytes
+ * @param[in] length        Number of received bytes
+ *
+ * @return ::SYS_RNWF_PASS Data was consumed
+ * @return ::SYS_RNWF_FAIL The response is malformed
+ */
+SYS_RNWF_RESULT_t SYS_RNWF_HTTP_ParserFeed(SYS_RNWF_HTTP_PARSER_t *parser, const uint8_t *data, uint32_t length);
+
+/**
+ * @brief Inform the parser that the connection was closed by the peer.
+ *
+ * Completes a body which is delimited by the connection close.
+ *
+ * @param[in] parser        Parser instance
+ *
+ * @return ::SYS_RNWF_PASS The close ended a response cleanly
+ * @return ::SYS_RNWF_FAIL The close truncated a response
+ */
+SYS_RNWF_RESULT_t SYS_RNWF_HTTP_ParserClose(SYS_RNWF_HTTP_PARSER_t *parser);
+
+/**
+ * @brief Format an HTTP/1.1 GET request.
+ *
+ * @param[out] buffer       Output buffer
+ * @param[in] size          Size of the output buffer
+ * @param[in] host          Host header value
+ * @param[in] path          Request path, a leading '/' is added if missing
+ * @param[in] rangeStart    First byte of a range request
+ * @param[in] rangeEnd      Last byte of a range request, 0 for no range
+ * @param[in] keepAlive     Request a persistent connection
+ *
+ * @return Request length, 0 if the buffer is too small
+ */
+size_t SYS_RNWF_HTTP_RequestFormat(char *buffer, size_t size, const char *host, const char *path, uint32_t rangeStart, uint32_t rangeEnd, bool keepAlive);
+
+/**
+ * @brief Initialize an HTTP client on a connected socket.
+ *
+ * @param[in] client        Client instance
+ * @param[in] socket        Connected socket ID
+ * @param[in] host          Host header value, must stay valid
+ * @param[in] callback      Event and body sink callback
+ * @param[in] context       Context passed back to the callback
+ */
+void SYS_RNWF_HTTP_ClientInit(SYS_RNWF_HTTP_CLIENT_t *client, uint32_t socket, const char *host, SYS_RNWF_HTTP_CALLBACK_t callback, void *context);
+
+/**
+ * @brief Send a GET request on the client connection.
+ *
+ * Requests are pipelined, up to SYS_RNWF_HTTP_PIPELINE_DEPTH_MAX may be
+ * outstanding at once.
+ *
+ * @param[in] client        Client instance
+ * @param[in] path          Request path
+ * @param[in] rangeStart    First byte of a range request
+ * @param[in] rangeEnd      Last byte of a range request, 0 for no range
+ *
+ * @return ::SYS_RNWF_PASS Request was sent
+ * @return ::SYS_RNWF_FAIL Pipeline is full or the connection is not reusable
+ */
+SYS_RNWF_RESULT_t SYS_RNWF_HTTP_ClientGet(SYS_RNWF_HTTP_CLIENT_t *client, const char *path, uint32_t rangeStart, uint32_t rangeEnd);
+
+/**
+ * @brief Read pending socket data and pass it through the client parser.
+ *
+ * @param[in] client        Client instance
+ * @param[in] rxLen         Number of bytes available on the socket
+ * @param[in] buffer        Receive buffer, body events point into it
+ * @param[in] size          Size of the receive buffer
+ *
+ * @return ::SYS_RNWF_PASS Data was consumed
+ * @return ::SYS_RNWF_FAIL Read error or malformed response
+ */
+SYS_RNWF_RESULT_t SYS_RNWF_HTTP_ClientReceive(SYS_RNWF_HTTP_CLIENT_t *client, uint16_t rxLen, uint8_t *buffer, uint16_t size);
+
+#endif	/* SYS_RNWF_HTTP_CLIENT_H */
+
+/** @}*/
@@ -28,6 +28,96 @@ TO MICROCHIP FOR THIS SOFTWARE.
 #define WINC_DEV_NUM_AEC_CB_ENTRIES             5U
 #endif
 
+#if (WINC_DEV_NUM_AEC_CB_ENTRIES > 8U)
+#error "WINC_DEV_NUM_AEC_CB_ENTRIES must not exceed 8"
+#endif
+
+/* AEC dispatch table slot for modules outside of the subscription mask range. */
+#define WINC_DEV_AEC_DISPATCH_OTHER             WINC_DEV_AEC_NUM_MODULES
+
+/* Maximum number of commands from queued requests merged into one burst,
+   a value of 1 disables merging. */
+#ifndef WINC_DEV_COALESCE_MAX_CMDS
+#define WINC_DEV_COALESCE_MAX_CMDS              16U
+#endif
+
+/* Maximum size of a merged burst, one SDIO block. */
+#ifndef WINC_DEV_COALESCE_MAX_SIZE
+#define WINC_DEV_COALESCE_MAX_SIZE              512U
+#endif
+
+/* Number of WINC_DevUpdateEvent calls a request queued on an idle bus is
+   held for while more requests are merged, zero sends immediately. */
+#ifndef WINC_DEV_COALESCE_HOLD_CNT
+#define WINC_DEV_COALESCE_HOLD_CNT              0U
+#endif
+
+/* Number of entries in the response index, must be a power of 2. */
+#ifndef WINC_DEV_RSP_INDEX_SZ
+#define WINC_DEV_RSP_INDEX_SZ                   32U
+#endif
+
+#if (0U != (WINC_DEV_RSP_INDEX_SZ & (WINC_DEV_RSP_INDEX_SZ - 1U)))
+#error "WINC_DEV_RSP_INDEX_SZ must be a power of 2"
+#endif
+
+/* Scheduling weight of each command request class, the number of requests
+   sent from a class before lower priority classes are given a turn. */
+#ifndef WINC_DEV_CMD_CLASS_WEIGHT_CONTROL
+#define WINC_DEV_CMD_CLASS_WEIGHT_CONTROL       4U
+#endif
+
+#ifndef WINC_DEV_CMD_CLASS_WEIGHT_INTERACTIVE
+#define WINC_DEV_CMD_CLASS_WEIGHT_INTERACTIVE   2U
+#endif
+
+#ifndef WINC_DEV_CMD_CLASS_WEIGHT_BULK
+#define WINC_DEV_CMD_CLASS_WEIGHT_BULK          1U
+#endif
+
+/* Maximum number of command requests of each class awaiting responses. */
+#ifndef WINC_DEV_CMD_CLASS_WINDOW_CONTROL
+#define WINC_DEV_CMD_CLASS_WINDOW_CONTROL       8U
+#endif
+
+#ifndef WINC_DEV_CMD_CLASS_WINDOW_INTERACTIVE
+#define WINC_DEV_CMD_CLASS_WINDOW_INTERACTIVE   8U
+#endif
+
+#ifndef WINC_DEV_CMD_CLASS_WINDOW_BULK
+#define WINC_DEV_CMD_CLASS_WINDOW_BULK          8U
+#endif
+
+/* Maximum number of bytes captured from each message. */
+#ifndef WINC_DEV_CAPTURE_DATA_LEN
+#define WINC_DEV_CAPTURE_DATA_LEN               32U
+#endif
+
+#if (WINC_DEV_CAPTURE_DATA_LEN > 255U)
+#error "WINC_DEV_CAPTURE_DATA_LEN must not exceed 255"
+#endif
+
+/* Time source for capture timestamps, WINC_CONF_CAPTURE_TIME_FREQ_GET gives
+   the frequency of the timestamps in Hz. */
+#ifdef WINC_CONF_CAPTURE_TIME_GET
+#define WINC_DEV_CAPTURE_TIME_GET(pCtrlCtx)     WINC_CONF_CAPTURE_TIME_GET()
+#else
+#define WINC_DEV_CAPTURE_TIME_GET(pCtrlCtx)     ((pCtrlCtx)->updateCount)
+#endif
+
+#ifdef WINC_CONF_CAPTURE_TIME_FREQ_GET
+#define WINC_DEV_CAPTURE_TIME_FREQ_GET()        WINC_CONF_CAPTURE_TIME_FREQ_GET()
+#else
+#define WINC_DEV_CAPTURE_TIME_FREQ_GET()        0U
+#endif
+
+/* Time source for queueing delay statistics. */
+#ifdef WINC_CONF_TICK_GET
+#define WINC_DEV_TICK_GET(pCtrlCtx)             WINC_CONF_TICK_GET()
+#else
+#define WINC_DEV_TICK_GET(pCtrlCtx)             ((pCtrlCtx)->updateCount)
+#endif
+
 #define WINC_DEV_NUM_MOD_REQS_COUNTERS          WINC_NUM_MODULES
 
 typedef enum
@@ -55,6 +145,8 @@ typedef struct
         {
             uint32_t                *pMsgLengths;
             size_t                  receiveBufferOffset;
+            size_t                  msgOffset;
+            bool                    prefetched;
         } rxReq;
     };
 } WINC_DEV_EVENT_CTX;
@@ -63,8 +155,29 @@ typedef struct
 {
     WINC_DEV_AEC_RSP_CB             pfAecRspCallback;
     uintptr_t                       aecRspCallbackCtx;
+    uint64_t                        modMask;
 } WINC_DEV_AEC_CB_ENTRY;
 
+typedef struct
+{
+    WINC_SEND_REQ_STATE             *pSendReqState;
+    WINC_SEND_REQ_HDR_ELEM          *pReqHdr;
+    uint16_t                        seqNum;
+    uint8_t                         cmdIdx;
+} WINC_DEV_RSP_INDEX_ENTRY;
+
+typedef struct
+{
+    WINC_SEND_REQ_STATE             *pHead;
+    WINC_SEND_REQ_STATE             *pTail;
+    uint16_t                        numPending;
+    uint8_t                         numInFlight;
+    uint8_t                         credits;
+#ifdef WINC_DEV_CMD_CLASS_STATS_ENABLE
+    WINC_DEV_CMD_CLASS_STATS        stats;
+#endif
+} WINC_DEV_CMD_CLASS_QUEUE;
+
 typedef struct
 {
     bool                            isInit;
@@ -73,9 +186,29 @@ typedef struct
     uint8_t                         *pReceiveBuffer;
     size_t                          receiveBufferSize;
     WINC_CMD_REQ_HANDLE             cmdReqQueue;
+    WINC_SEND_REQ_STATE             *pCmdReqQueueTail;
     WINC_SEND_REQ_STATE             *pSendReqState;
+    WINC_SEND_REQ_STATE             *pBurstLastReqState;
+    WINC_DEV_CMD_CLASS_QUEUE        cmdClassQueue[WINC_DEV_NUM_CMD_CLASSES];
+    size_t                          pendNumCmds;
+    uint32_t                        updateCount;
+    uint8_t                         holdCount;
+#ifdef WINC_DEV_CAPTURE_ENABLE
+    struct
+    {
+        uint8_t                     *pBuffer;
+        size_t                      size;
+        size_t                      inIdx;
+        size_t                      outIdx;
+        size_t                      used;
+        uint32_t                    numDropped;
+    } capture;
+#endif
+    uint32_t                        burstCmdSizes[WINC_DEV_COALESCE_MAX_CMDS];
+    WINC_DEV_RSP_INDEX_ENTRY        rspIndex[WINC_DEV_RSP_INDEX_SZ];
     WINC_DEV_EVENT_CTX              eventCtx;
     WINC_DEV_AEC_CB_ENTRY           aecCallbackTable[WINC_DEV_NUM_AEC_CB_ENTRIES];
+    uint8_t                         aecDispatchTable[WINC_DEV_AEC_NUM_MODULES+1U];
     WINC_DEV_RX_INTERCEPT_CB        pfIinterceptCallback;
     uintptr_t                       interceptCallbackCtx;
     struct
@@ -89,6 +222,20 @@ typedef struct
 
 static WINC_DEV_CTRL_CTX wincDevCtrlCtx = {.isInit = false};
 
+static const uint8_t cmdClassWeights[WINC_DEV_NUM_CMD_CLASSES] =
+{
+    WINC_DEV_CMD_CLASS_WEIGHT_CONTROL,
+    WINC_DEV_CMD_CLASS_WEIGHT_INTERACTIVE,
+    WINC_DEV_CMD_CLASS_WEIGHT_BULK
+};
+
+static const uint8_t cmdClassWindows[WINC_DEV_NUM_CMD_CLASSES] =
+{
+    WINC_DEV_CMD_CLASS_WINDOW_CONTROL,
+    WINC_DEV_CMD_CLASS_WINDOW_INTERACTIVE,
+    WINC_DEV_CMD_CLASS_WINDOW_BULK
+};
+
 WINC_DEBUG_PRINTF_FP pfWINCDevDebugPrintf = NULL;
 
 /*****************************************************************************
@@ -185,6 +332,113 @@ static uint8_t devModReqCountUpdate(WINC_DEV_CTRL_CTX *pCtrlCtx, uint8_t modId,
     return pCtrlCtx->modReqCount[modIdx].count;
 }
 
+#ifdef WINC_DEV_CAPTURE_ENABLE
+/*****************************************************************************
+  Description:
+    Copy bytes into the capture ring.
+
+  Parameters:
+    pCtrlCtx - Pointer to the device control context
+    pData    - Pointer to bytes to copy
+    length   - Number of bytes to copy
+
+  Returns:
+    None
+
+  Remarks:
+    The caller must ensure there is space in the ring.
+
+ *****************************************************************************/
+
+static void devCaptureWrite(WINC_DEV_CTRL_CTX *pCtrlCtx, const uint8_t *pData, size_t length)
+{
+    size_t copyLen;
+
+    copyLen = pCtrlCtx->capture.size - pCtrlCtx->capture.inIdx;
+
+    if (copyLen > length)
+    {
+        copyLen = length;
+    }
+
+    (void)memcpy(&pCtrlCtx->capture.pBuffer[pCtrlCtx->capture.inIdx], pData, copyLen);
+    (void)memcpy(pCtrlCtx->capture.pBuffer, &pData[copyLen], length - copyLen);
+
+    pCtrlCtx->capture.inIdx = (pCtrlCtx->capture.inIdx + length) % pCtrlCtx->capture.size;
+    pCtrlCtx->capture.used += length;
+}
+
+/*****************************************************************************
+  Description:
+    Add a record to the capture ring.
+
+  Parameters:
+    pCtrlCtx - Pointer to the device control context
+    type     - Record type
+    pData    - Pointer to data to capture
+    length   - Length of data
+
+  Returns:
+    None
+
+  Remarks:
+    Data is truncated to WINC_DEV_CAPTURE_DATA_LEN bytes, the oldest records
+    are discarded to make space for new ones.
+
+ *****************************************************************************/
+
+static void devCaptureRecord(WINC_DEV_CTRL_CTX *pCtrlCtx, WINC_DEV_CAPTURE_TYPE type, const uint8_t *pData, size_t length)
+{
+    uint8_t hdr[WINC_DEV_CAPTURE_HDR_SIZE];
+    uint32_t timestamp;
+    size_t captureLen;
+
+    if (NULL == pCtrlCtx->capture.pBuffer)
+    {
+        return;
+    }
+
+    captureLen = (length > WINC_DEV_CAPTURE_DATA_LEN) ? WINC_DEV_CAPTURE_DATA_LEN : length;
+
+    if ((WINC_DEV_CAPTURE_HDR_SIZE + captureLen) > pCtrlCtx->capture.size)
+    {
+        return;
+    }
+
+    /* Discard the oldest records until the new record fits. */
+
+    while ((pCtrlCtx->capture.size - pCtrlCtx->capture.used) < (WINC_DEV_CAPTURE_HDR_SIZE + captureLen))
+    {
+        size_t oldLen = pCtrlCtx->capture.pBuffer[(pCtrlCtx->capture.outIdx + 1U) % pCtrlCtx->capture.size];
+
+        oldLen += WINC_DEV_CAPTURE_HDR_SIZE;
+
+        pCtrlCtx->capture.outIdx = (pCtrlCtx->capture.outIdx + oldLen) % pCtrlCtx->capture.size;
+        pCtrlCtx->capture.used  -= oldLen;
+        pCtrlCtx->capture.numDropped++;
+    }
+
+    timestamp = WINC_DEV_CAPTURE_TIME_GET(pCtrlCtx);
+
+    if (length > 0xffffU)
+    {
+        length = 0xffffU;
+    }
+
+    hdr[0] = (uint8_t)type;
+    hdr[1] = (uint8_t)captureLen;
+    hdr[2] = (uint8_t)length;
+    hdr[3] = (uint8_t)(length >> 8);
+    hdr[4] = (uint8_t)timestamp;
+    hdr[5] = (uint8_t)(timestamp >> 8);
+    hdr[6] = (uint8_t)(timestamp >> 16);
+    hdr[7] = (uint8_t)(timestamp >> 24);
+
+    devCaptureWrite(pCtrlCtx, hdr, WINC_DEV_CAPTURE_HDR_SIZE);
+    devCaptureWrite(pCtrlCtx, pData, captureLen);
+}
+#endif
+
 /*****************************************************************************
   Description:
     Unpack elements from command responses and AECs.
@@ -260,6 +514,7 @@ static bool devUnpackResponseElements(WINC_COMMAND_RESPONSE *pCmdRsp, WINC_DEV_E
 static bool devPreparePendingCmdReq(WINC_DEV_CTRL_CTX *pCtrlCtx, WINC_SEND_REQ_STATE *pSendReqState)
 {
     WINC_SEND_REQ_HDR_ELEM *pReqHdr;
+    WINC_DEV_RSP_INDEX_ENTRY *pRspIndex;
     uint8_t i;
 
     if ((NULL == pCtrlCtx) || (NULL == pSendReqState))
@@ -275,6 +530,7 @@ static bool devPreparePendingCmdReq(WINC_DEV_CTRL_CTX *pCtrlCtx, WINC_SEND_REQ_S
     pSendReqState->space     = 0;
     pSendReqState->pPtr      = pSendReqState->pFirstHdrElem->pPtr;
     pSendReqState->numErrors = 0;
+    pSendReqState->numStatus = 0;
 
     if (0U == pSendReqState->numCmds)
     {
@@ -303,6 +559,15 @@ static bool devPreparePendingCmdReq(WINC_DEV_CTRL_CTX *pCtrlCtx, WINC_SEND_REQ_S
 
         WINC_TRACE_PRINT("Assign SN=%04x to %08x\n", pCtrlCtx->nextSeqNum, pCmdReq);
 
+        /* Record the command in the response index. */
+
+        pRspIndex = &pCtrlCtx->rspIndex[pCtrlCtx->nextSeqNum & (WINC_DEV_RSP_INDEX_SZ - 1U)];
+
+        pRspIndex->pSendReqState = pSendReqState;
+        pRspIndex->pReqHdr       = pReqHdr;
+        pRspIndex->seqNum        = pCtrlCtx->nextSeqNum;
+        pRspIndex->cmdIdx        = i;
+
         pCtrlCtx->nextSeqNum++;
 
         (void)devModReqCountUpdate(pCtrlCtx, pCmdReq->id_h, true);
@@ -332,12 +597,42 @@ static void devFlushPendingCmdReqQueue(WINC_DEV_CTRL_CTX *pCtrlCtx)
 {
     WINC_CMD_REQ_HANDLE cmdReq;
     WINC_SEND_REQ_STATE *pSendReqState;
+    uint8_t cmdClass;
 
     if (NULL == pCtrlCtx)
     {
         return;
     }
 
+    /* Link the class queues onto the end of the command request queue so
+     all requests are flushed in the order they would have been sent. */
+
+    for (cmdClass=0; cmdClass<WINC_DEV_NUM_CMD_CLASSES; cmdClass++)
+    {
+        WINC_DEV_CMD_CLASS_QUEUE *pQueue = &pCtrlCtx->cmdClassQueue[cmdClass];
+
+        if (NULL != pQueue->pHead)
+        {
+            if (WINC_CMD_REQ_INVALID_HANDLE == pCtrlCtx->cmdReqQueue)
+            {
+                pCtrlCtx->cmdReqQueue = (WINC_CMD_REQ_HANDLE)pQueue->pHead;
+            }
+            else
+            {
+                pCtrlCtx->pCmdReqQueueTail->nextCmdReq = (WINC_CMD_REQ_HANDLE)pQueue->pHead;
+            }
+
+            pCtrlCtx->pCmdReqQueueTail = pQueue->pTail;
+        }
+
+        pQueue->pHead       = NULL;
+        pQueue->pTail       = NULL;
+        pQueue->numPending  = 0;
+        pQueue->numInFlight = 0;
+    }
+
+    pCtrlCtx->pendNumCmds = 0;
+
     cmdReq = pCtrlCtx->cmdReqQueue;
 
     while (WINC_CMD_REQ_INVALID_HANDLE != cmdReq)
@@ -367,8 +662,11 @@ static void devFlushPendingCmdReqQueue(WINC_DEV_CTRL_CTX *pCtrlCtx)
         cmdReq = nextCmdReq;
     }
 
-    pCtrlCtx->cmdReqQueue   = WINC_CMD_REQ_INVALID_HANDLE;
-    pCtrlCtx->pSendReqState = NULL;
+    pCtrlCtx->cmdReqQueue        = WINC_CMD_REQ_INVALID_HANDLE;
+    pCtrlCtx->pCmdReqQueueTail   = NULL;
+    pCtrlCtx->pSendReqState      = NULL;
+    pCtrlCtx->pBurstLastReqState = NULL;
+    pCtrlCtx->holdCount          = 0;
 }
 
 /*****************************************************************************
@@ -385,12 +683,20 @@ static void devFlushPendingCmdReqQueue(WINC_DEV_CTRL_CTX *pCtrlCtx)
   Remarks:
     The number and sizes of commands are sent to the device.
 
+    Requests queued behind the first are merged into the same burst while the
+    total number of commands and size remain within the coalescing limits.
+
  *****************************************************************************/
 
 static bool devProcessPendingCmdReqQueue(WINC_DEV_CTRL_CTX *pCtrlCtx, WINC_SEND_REQ_STATE *pSendReqState)
 {
     uint16_t cmd53Status;
     uint32_t message;
+    WINC_SEND_REQ_STATE *pLastSendReqState;
+    uint32_t *pCmdSizes;
+    size_t burstNumCmds;
+    size_t burstSize;
+    uint8_t i;
 
     if (NULL == pCtrlCtx)
     {
@@ -399,15 +705,64 @@ static bool devProcessPendingCmdReqQueue(WINC_DEV_CTRL_CTX *pCtrlCtx, WINC_SEND_
 
     if (NULL == pSendReqState)
     {
-        pCtrlCtx->pSendReqState = NULL;
+        pCtrlCtx->pSendReqState      = NULL;
+        pCtrlCtx->pBurstLastReqState = NULL;
         return true;
     }
 
+    /* Find the requests which can be merged into this burst. */
+
+    pLastSendReqState = pSendReqState;
+    pCmdSizes         = (uint32_t*)pSendReqState->cmds;
+    burstNumCmds      = pSendReqState->numCmds;
+    burstSize         = 0;
+
+    for (i=0; i<pSendReqState->numCmds; i++)
+    {
+        burstSize += ((size_t)pSendReqState->cmds[i].size) << 2;
+    }
+
+    while (WINC_CMD_REQ_INVALID_HANDLE != pLastSendReqState->nextCmdReq)
+    {
+        WINC_SEND_REQ_STATE *pNextSendReqState = (WINC_SEND_REQ_STATE*)pLastSendReqState->nextCmdReq;
+        size_t nextSize = 0;
+
+        for (i=0; i<pNextSendReqState->numCmds; i++)
+        {
+            nextSize += ((size_t)pNextSendReqState->cmds[i].size) << 2;
+        }
+
+        if (((burstNumCmds + pNextSendReqState->numCmds) > WINC_DEV_COALESCE_MAX_CMDS) || ((burstSize + nextSize) > WINC_DEV_COALESCE_MAX_SIZE))
+        {
+            break;
+        }
+
+        if (pLastSendReqState == pSendReqState)
+        {
+            (void)memcpy(pCtrlCtx->burstCmdSizes, pSendReqState->cmds, burstNumCmds * sizeof(uint32_t));
+            pCmdSizes = pCtrlCtx->burstCmdSizes;
+        }
+
+        (void)memcpy(&pCtrlCtx->burstCmdSizes[burstNumCmds], pNextSendReqState->cmds, ((size_t)pNextSendReqState->numCmds) * sizeof(uint32_t));
+
+        burstNumCmds += pNextSendReqState->numCmds;
+        burstSize    += nextSize;
+
+        pNextSendReqState->pCurHdrElem = pNextSendReqState->pFirstHdrElem;
+
+        pLastSendReqState = pNextSendReqState;
+    }
+
+    if (pLastSendReqState != pSendReqState)
+    {
+        WINC_TRACE_PRINT("CmdReq merge %08x to %08x, %d cmds\n", pSendReqState, pLastSendReqState, burstNumCmds);
+    }
+
     /* Construct message to device: | TX_REQ | No. of cmds | Size of first msg | */
 
-    message = ((uint32_t)WINC_DEV_EVENT_TX_REQ << 24) | (((uint32_t)pSendReqState->numCmds) << 16);
+    message = ((uint32_t)WINC_DEV_EVENT_TX_REQ << 24) | (((uint32_t)burstNumCmds) << 16);
 
-    if (pSendReqState->numCmds > 1U)
+    if (burstNumCmds > 1U)
     {
         uint32_t csaPtr = 0x00000000;
 
@@ -423,7 +778,7 @@ static bool devProcessPendingCmdReqQueue(WINC_DEV_CTRL_CTX *pCtrlCtx, WINC_SEND_
             return false;
         }
 
-        cmd53Status = WINC_SDIOCmd53Write(WINC_SDIOREG_FN0_FBR_FN1_CSA_DATA, (uint8_t*)pSendReqState->cmds, ((uint32_t)pSendReqState->numCmds) * sizeof(uint32_t), false);
+        cmd53Status = WINC_SDIOCmd53Write(WINC_SDIOREG_FN0_FBR_FN1_CSA_DATA, (uint8_t*)pCmdSizes, ((uint32_t)burstNumCmds) * sizeof(uint32_t), false);
         if (WINC_SDIO_R1RSP_OK != cmd53Status)
         {
             WINC_ERROR_PRINT("error, length CMD53 write failed, status=0x%04x\n", cmd53Status);
@@ -434,7 +789,7 @@ static bool devProcessPendingCmdReqQueue(WINC_DEV_CTRL_CTX *pCtrlCtx, WINC_SEND_
 
         /* Indicate the size of the list being sent via the CSA in the message. */
 
-        message |= pSendReqState->numCmds;
+        message |= burstNumCmds;
     }
     else
     {
@@ -443,6 +798,10 @@ static bool devProcessPendingCmdReqQueue(WINC_DEV_CTRL_CTX *pCtrlCtx, WINC_SEND_
         message |= pSendReqState->cmds[0].size;
     }
 
+#ifdef WINC_DEV_CAPTURE_ENABLE
+    devCaptureRecord(pCtrlCtx, WINC_DEV_CAPTURE_TYPE_TX_BURST, (uint8_t*)&message, 4);
+#endif
+
     cmd53Status = WINC_SDIOCmd53Write(WINC_SDIOREG_FN1_SD_HOST_GP, (uint8_t*)&message, 4, true);
     if (WINC_SDIO_R1RSP_OK != cmd53Status)
     {
@@ -454,115 +813,578 @@ static bool devProcessPendingCmdReqQueue(WINC_DEV_CTRL_CTX *pCtrlCtx, WINC_SEND_
 
     pSendReqState->pCurHdrElem = pSendReqState->pFirstHdrElem;
 
-    pCtrlCtx->pSendReqState = pSendReqState;
+    pCtrlCtx->pSendReqState      = pSendReqState;
+    pCtrlCtx->pBurstLastReqState = pLastSendReqState;
 
     return true;
 }
 
 /*****************************************************************************
   Description:
+    Select the scheduling class of a command request.
 
   Parameters:
-    pCtrlCtx  - Pointer to the device control context
+    pSendReqState - Pointer to the command request
 
   Returns:
-    None
+    Scheduling class of the command request.
 
   Remarks:
+    Unless set by WINC_CmdReqClassSet, the class is chosen from the first
+    command in the burst. Socket data transfers and bulk transfers to or from
+    the device are bulk, other socket commands are interactive and all other
+    commands are control.
 
  *****************************************************************************/
 
-WINC_SEND_REQ_STATE* devCompleteCmdStatusRsp(WINC_DEV_CTRL_CTX *pCtrlCtx, WINC_SEND_REQ_STATE *pSendReqState, uint16_t status, uint16_t cmdId, uint8_t cmdIdx, uint16_t cmdSeqNum, uint8_t numParams, uint8_t *pParams, uint8_t *pNumStatus)
+static uint8_t devCmdClassSelect(const WINC_SEND_REQ_STATE *pSendReqState)
 {
-    if ((NULL == pCtrlCtx) || (NULL == pSendReqState) || (NULL == pNumStatus))
+    const WINC_COMMAND_REQUEST *pCmdReq;
+
+    if (pSendReqState->cmdClass < WINC_DEV_NUM_CMD_CLASSES)
     {
-        return NULL;
+        return pSendReqState->cmdClass;
     }
 
-    pSendReqState->cmds[cmdIdx].rsp.status = status;
+    pCmdReq = (const WINC_COMMAND_REQUEST*)pSendReqState->pFirstHdrElem->pPtr;
 
-    if (WINC_STATUS_OK != pSendReqState->cmds[cmdIdx].rsp.status)
+    switch (WINC_FIELD_UNPACK_16(pCmdReq->id))
     {
-        pSendReqState->numErrors++;
-    }
-
-    (void)devModReqCountUpdate(pCtrlCtx, (uint8_t)(cmdId>>8), false);
+        case WINC_CMD_ID_SOCKWR:
+        case WINC_CMD_ID_SOCKWRTO:
+        case WINC_CMD_ID_NETIFTX:
+        case WINC_CMD_ID_FSTSFR:
+        case WINC_CMD_ID_NVMWR:
+        case WINC_CMD_ID_NVMRD:
+        case WINC_CMD_ID_DFUSEQ:
+        {
+            return (uint8_t)WINC_DEV_CMD_CLASS_BULK;
+        }
 
-    WINC_TRACE_PRINT("Status %04x %04x in CMD(%d), SN=%04x\n", pSendReqState->cmds[cmdIdx].rsp.status, cmdId, cmdIdx, cmdSeqNum);
+        default:
+        {
+            break;
+        }
+    }
 
-    if (NULL != pSendReqState->pfCmdRspCallback)
+    if (WINC_MOD_ID_SOCKET == pCmdReq->id_h)
     {
-        WINC_DEV_EVENT_STATUS_ARGS eventStatusArgs;
+        return (uint8_t)WINC_DEV_CMD_CLASS_INTERACTIVE;
+    }
 
-        /* Callback to the application layer that sent the command request
-         indicating the request is complete. */
+    return (uint8_t)WINC_DEV_CMD_CLASS_CONTROL;
+}
 
-        eventStatusArgs.rspCmdId         = cmdId;
-        eventStatusArgs.srcCmd.idx       = cmdIdx;
-        eventStatusArgs.seqNum           = cmdSeqNum;
-        eventStatusArgs.status           = pSendReqState->cmds[cmdIdx].rsp.status;
-        eventStatusArgs.srcCmd.numParams = numParams;
-        eventStatusArgs.srcCmd.pParams   = pParams;
+/*****************************************************************************
+  Description:
+    Add a command request to its class queue.
 
-        WINC_CONF_LOCK_LEAVE(&pCtrlCtx->accessMutex);
-        pSendReqState->pfCmdRspCallback(pSendReqState->cmdRspCallbackCtx, (WINC_DEVICE_HANDLE)pCtrlCtx, (WINC_CMD_REQ_HANDLE)pSendReqState, WINC_DEV_CMDREQ_EVENT_CMD_STATUS, (uintptr_t)&eventStatusArgs);
-        if (false == WINC_CONF_LOCK_ENTER(&pCtrlCtx->accessMutex))
-        {
-        }
-    }
+  Parameters:
+    pCtrlCtx      - Pointer to the device control context
+    pSendReqState - Pointer to the command request
 
-    /* Count the new status response in the burst total. */
+  Returns:
+    None
 
-    (*pNumStatus)++;
+  Remarks:
+    Requests for a module are kept in the order they were submitted, if a
+    request for the same module is already queued in another class the new
+    request joins that class instead.
 
-    WINC_VERBOSE_PRINT("Done with %d of %d\n", *pNumStatus, pSendReqState->numCmds);
+ *****************************************************************************/
 
-    if (*pNumStatus == pSendReqState->numCmds)
-    {
-        /* All command requests in this burst have been acknowledged
-         and are now complete. Callback to the application layer. Control
-         of the memory of the command request burst is now handed back
-         to the application layer. */
+static void devCmdClassQueueAdd(WINC_DEV_CTRL_CTX *pCtrlCtx, WINC_SEND_REQ_STATE *pSendReqState)
+{
+    WINC_DEV_CMD_CLASS_QUEUE *pQueue;
+    uint8_t modId;
+    uint8_t cmdClass;
+    uint8_t i;
 
-        WINC_CMD_REQ_HANDLE nextCmdReq;
+    cmdClass = devCmdClassSelect(pSendReqState);
+    modId    = ((const WINC_COMMAND_REQUEST*)pSendReqState->pFirstHdrElem->pPtr)->id_h;
 
-        nextCmdReq = pSendReqState->nextCmdReq;
+    for (i=0; i<WINC_DEV_NUM_CMD_CLASSES; i++)
+    {
+        const WINC_SEND_REQ_STATE *pQueuedSendReqState = pCtrlCtx->cmdClassQueue[i].pHead;
 
-        if (NULL != pSendReqState->pfCmdRspCallback)
+        if (i == cmdClass)
         {
-            WINC_DEV_EVENT_COMPLETE_ARGS eventCompleteArgs;
-
-            eventCompleteArgs.numCmds   = pSendReqState->numCmds;
-            eventCompleteArgs.numErrors = pSendReqState->numErrors;
+            continue;
+        }
 
-            WINC_CONF_LOCK_LEAVE(&pCtrlCtx->accessMutex);
-            pSendReqState->pfCmdRspCallback(pSendReqState->cmdRspCallbackCtx, (WINC_DEVICE_HANDLE)pCtrlCtx, (WINC_CMD_REQ_HANDLE)pSendReqState, WINC_DEV_CMDREQ_EVENT_STATUS_COMPLETE, (uintptr_t)&eventCompleteArgs);
-            if (false == WINC_CONF_LOCK_ENTER(&pCtrlCtx->accessMutex))
+        while (NULL != pQueuedSendReqState)
+        {
+            if (modId == ((const WINC_COMMAND_REQUEST*)pQueuedSendReqState->pFirstHdrElem->pPtr)->id_h)
             {
+                WINC_TRACE_PRINT("CmdReq %08x class %d -> %d\n", pSendReqState, cmdClass, i);
+
+                cmdClass = i;
+                break;
             }
+
+            pQueuedSendReqState = (const WINC_SEND_REQ_STATE*)pQueuedSendReqState->nextCmdReq;
         }
 
-        WINC_TRACE_PRINT("CmdReq %08x retired, moving to %08x\n", pSendReqState, nextCmdReq);
+        if (i == cmdClass)
+        {
+            break;
+        }
+    }
 
-        /* Detach the memory of the current complete burst, move on
-         to the next one in the queue. */
+    pQueue = &pCtrlCtx->cmdClassQueue[cmdClass];
 
-        pSendReqState = NULL;
+    pSendReqState->cmdClass   = cmdClass;
+    pSendReqState->queueTime  = WINC_DEV_TICK_GET(pCtrlCtx);
+    pSendReqState->nextCmdReq = WINC_CMD_REQ_INVALID_HANDLE;
 
-        pCtrlCtx->cmdReqQueue = nextCmdReq;
+    if (NULL == pQueue->pHead)
+    {
+        pQueue->pHead = pSendReqState;
+    }
+    else
+    {
+        pQueue->pTail->nextCmdReq = (WINC_CMD_REQ_HANDLE)pSendReqState;
     }
 
-    return pSendReqState;
+    pQueue->pTail = pSendReqState;
+    pQueue->numPending++;
+
+    pCtrlCtx->pendNumCmds += pSendReqState->numCmds;
+
+#ifdef WINC_DEV_CMD_CLASS_STATS_ENABLE
+    pQueue->stats.numQueued++;
+#endif
+
+    WINC_TRACE_PRINT("CmdReq add %08x to class %d\n", pSendReqState, cmdClass);
 }
 
 /*****************************************************************************
   Description:
-    Decode a command response or AEC message.
+    Select the next class to send a command request from.
 
   Parameters:
-    pCtrlCtx  - Pointer to the device control context
-    pMsg      - Pointer to response message
-    msgLength - Length of response message
+    pCtrlCtx - Pointer to the device control context
+
+  Returns:
+    Class to send from, or WINC_DEV_NUM_CMD_CLASSES if none can send.
+
+  Remarks:
+    The highest priority class with pending requests, an open window and
+    remaining credit is selected. Credits are refilled from the class
+    weights once no eligible class has credit left.
+
+ *****************************************************************************/
+
+static uint8_t devCmdClassNext(WINC_DEV_CTRL_CTX *pCtrlCtx)
+{
+    WINC_DEV_CMD_CLASS_QUEUE *pQueue;
+    bool refill = false;
+    uint8_t cmdClass;
+
+    for (cmdClass=0; cmdClass<WINC_DEV_NUM_CMD_CLASSES; cmdClass++)
+    {
+        pQueue = &pCtrlCtx->cmdClassQueue[cmdClass];
+
+        if ((NULL == pQueue->pHead) || (pQueue->numInFlight >= cmdClassWindows[cmdClass]))
+        {
+            continue;
+        }
+
+        if (0U != pQueue->credits)
+        {
+            return cmdClass;
+        }
+
+        refill = true;
+    }
+
+    if (false == refill)
+    {
+        return WINC_DEV_NUM_CMD_CLASSES;
+    }
+
+    for (cmdClass=0; cmdClass<WINC_DEV_NUM_CMD_CLASSES; cmdClass++)
+    {
+        pCtrlCtx->cmdClassQueue[cmdClass].credits = cmdClassWeights[cmdClass];
+    }
+
+    for (cmdClass=0; cmdClass<WINC_DEV_NUM_CMD_CLASSES; cmdClass++)
+    {
+        pQueue = &pCtrlCtx->cmdClassQueue[cmdClass];
+
+        if ((NULL != pQueue->pHead) && (pQueue->numInFlight < cmdClassWindows[cmdClass]) && (0U != pQueue->credits))
+        {
+            return cmdClass;
+        }
+    }
+
+    return WINC_DEV_NUM_CMD_CLASSES;
+}
+
+/*****************************************************************************
+  Description:
+    Schedule the next command request burst.
+
+  Parameters:
+    pCtrlCtx - Pointer to the device control context
+
+  Returns:
+    true or false indicating success or failure
+
+  Remarks:
+    Requests are moved from the class queues onto the command request queue
+    while they can be merged into one burst, which is then sent.
+
+ *****************************************************************************/
+
+static bool devScheduleCmdReq(WINC_DEV_CTRL_CTX *pCtrlCtx)
+{
+    WINC_SEND_REQ_STATE *pFirstSendReqState = NULL;
+    size_t burstNumCmds = 0;
+    size_t burstSize = 0;
+    uint8_t cmdClass;
+    uint8_t i;
+
+    pCtrlCtx->holdCount = 0;
+
+    cmdClass = devCmdClassNext(pCtrlCtx);
+
+    while (cmdClass < WINC_DEV_NUM_CMD_CLASSES)
+    {
+        WINC_DEV_CMD_CLASS_QUEUE *pQueue = &pCtrlCtx->cmdClassQueue[cmdClass];
+        WINC_SEND_REQ_STATE *pSendReqState = pQueue->pHead;
+        size_t size = 0;
+
+        for (i=0; i<pSendReqState->numCmds; i++)
+        {
+            size += ((size_t)pSendReqState->cmds[i].size) << 2;
+        }
+
+        if (NULL != pFirstSendReqState)
+        {
+            if (((burstNumCmds + pSendReqState->numCmds) > WINC_DEV_COALESCE_MAX_CMDS) || ((burstSize + size) > WINC_DEV_COALESCE_MAX_SIZE))
+            {
+                break;
+            }
+        }
+
+        /* Move the request from its class queue to the tail of the command
+         request queue. */
+
+        pQueue->pHead = (WINC_SEND_REQ_STATE*)pSendReqState->nextCmdReq;
+
+        if (NULL == pQueue->pHead)
+        {
+            pQueue->pTail = NULL;
+        }
+
+        pQueue->numPending--;
+        pQueue->numInFlight++;
+        pQueue->credits--;
+
+        pCtrlCtx->pendNumCmds -= pSendReqState->numCmds;
+
+#ifdef WINC_DEV_CMD_CLASS_STATS_ENABLE
+        {
+            uint32_t delay = WINC_DEV_TICK_GET(pCtrlCtx) - pSendReqState->queueTime;
+
+            pQueue->stats.numSent++;
+            pQueue->stats.totalDelay += delay;
+
+            if (delay > pQueue->stats.maxDelay)
+            {
+                pQueue->stats.maxDelay = delay;
+            }
+        }
+#endif
+
+        pSendReqState->nextCmdReq = WINC_CMD_REQ_INVALID_HANDLE;
+
+        (void)devPreparePendingCmdReq(pCtrlCtx, pSendReqState);
+
+        if (WINC_CMD_REQ_INVALID_HANDLE == pCtrlCtx->cmdReqQueue)
+        {
+            pCtrlCtx->cmdReqQueue = (WINC_CMD_REQ_HANDLE)pSendReqState;
+        }
+        else
+        {
+            pCtrlCtx->pCmdReqQueueTail->nextCmdReq = (WINC_CMD_REQ_HANDLE)pSendReqState;
+        }
+
+        pCtrlCtx->pCmdReqQueueTail = pSendReqState;
+
+        WINC_TRACE_PRINT("CmdReq schedule %08x from class %d\n", pSendReqState, cmdClass);
+
+        if (NULL == pFirstSendReqState)
+        {
+            pFirstSendReqState = pSendReqState;
+        }
+
+        burstNumCmds += pSendReqState->numCmds;
+        burstSize    += size;
+
+        cmdClass = devCmdClassNext(pCtrlCtx);
+    }
+
+    return devProcessPendingCmdReqQueue(pCtrlCtx, pFirstSendReqState);
+}
+
+/*****************************************************************************
+  Description:
+
+  Parameters:
+    pCtrlCtx  - Pointer to the device control context
+
+  Returns:
+    None
+
+  Remarks:
+
+ *****************************************************************************/
+
+WINC_SEND_REQ_STATE* devCompleteCmdStatusRsp(WINC_DEV_CTRL_CTX *pCtrlCtx, WINC_SEND_REQ_STATE *pSendReqState, uint16_t status, uint16_t cmdId, uint8_t cmdIdx, uint16_t cmdSeqNum, uint8_t numParams, uint8_t *pParams, uint8_t *pNumStatus)
+{
+    if ((NULL == pCtrlCtx) || (NULL == pSendReqState) || (NULL == pNumStatus))
+    {
+        return NULL;
+    }
+
+    pSendReqState->cmds[cmdIdx].rsp.status = status;
+
+    if (WINC_STATUS_OK != pSendReqState->cmds[cmdIdx].rsp.status)
+    {
+        pSendReqState->numErrors++;
+    }
+
+    (void)devModReqCountUpdate(pCtrlCtx, (uint8_t)(cmdId>>8), false);
+
+    WINC_TRACE_PRINT("Status %04x %04x in CMD(%d), SN=%04x\n", pSendReqState->cmds[cmdIdx].rsp.status, cmdId, cmdIdx, cmdSeqNum);
+
+    if (NULL != pSendReqState->pfCmdRspCallback)
+    {
+        WINC_DEV_EVENT_STATUS_ARGS eventStatusArgs;
+
+        /* Callback to the application layer that sent the command request
+         indicating the request is complete. */
+
+        eventStatusArgs.rspCmdId         = cmdId;
+        eventStatusArgs.srcCmd.idx       = cmdIdx;
+        eventStatusArgs.seqNum           = cmdSeqNum;
+        eventStatusArgs.status           = pSendReqState->cmds[cmdIdx].rsp.status;
+        eventStatusArgs.srcCmd.numParams = numParams;
+        eventStatusArgs.srcCmd.pParams   = pParams;
+
+        WINC_CONF_LOCK_LEAVE(&pCtrlCtx->accessMutex);
+        pSendReqState->pfCmdRspCallback(pSendReqState->cmdRspCallbackCtx, (WINC_DEVICE_HANDLE)pCtrlCtx, (WINC_CMD_REQ_HANDLE)pSendReqState, WINC_DEV_CMDREQ_EVENT_CMD_STATUS, (uintptr_t)&eventStatusArgs);
+        if (false == WINC_CONF_LOCK_ENTER(&pCtrlCtx->accessMutex))
+        {
+        }
+    }
+
+    /* Count the new status response in the burst total. */
+
+    (*pNumStatus)++;
+
+    pSendReqState->numStatus = *pNumStatus;
+
+    WINC_VERBOSE_PRINT("Done with %d of %d\n", *pNumStatus, pSendReqState->numCmds);
+
+    if (*pNumStatus == pSendReqState->numCmds)
+    {
+        /* All command requests in this burst have been acknowledged
+         and are now complete. Callback to the application layer. Control
+         of the memory of the command request burst is now handed back
+         to the application layer. */
+
+        WINC_CMD_REQ_HANDLE nextCmdReq;
+
+        nextCmdReq = pSendReqState->nextCmdReq;
+
+        /* Close the request's slot in its class window. */
+
+        if ((pSendReqState->cmdClass < WINC_DEV_NUM_CMD_CLASSES) && (pCtrlCtx->cmdClassQueue[pSendReqState->cmdClass].numInFlight > 0U))
+        {
+            pCtrlCtx->cmdClassQueue[pSendReqState->cmdClass].numInFlight--;
+        }
+
+        if (NULL != pSendReqState->pfCmdRspCallback)
+        {
+            WINC_DEV_EVENT_COMPLETE_ARGS eventCompleteArgs;
+
+            eventCompleteArgs.numCmds   = pSendReqState->numCmds;
+            eventCompleteArgs.numErrors = pSendReqState->numErrors;
+
+            WINC_CONF_LOCK_LEAVE(&pCtrlCtx->accessMutex);
+            pSendReqState->pfCmdRspCallback(pSendReqState->cmdRspCallbackCtx, (WINC_DEVICE_HANDLE)pCtrlCtx, (WINC_CMD_REQ_HANDLE)pSendReqState, WINC_DEV_CMDREQ_EVENT_STATUS_COMPLETE, (uintptr_t)&eventCompleteArgs);
+            if (false == WINC_CONF_LOCK_ENTER(&pCtrlCtx->accessMutex))
+            {
+            }
+        }
+
+        WINC_TRACE_PRINT("CmdReq %08x retired, moving to %08x\n", pSendReqState, nextCmdReq);
+
+        /* Detach the memory of the current complete burst, move on
+         to the next one in the queue. */
+
+        pSendReqState = NULL;
+
+        pCtrlCtx->cmdReqQueue = nextCmdReq;
+    }
+
+    return pSendReqState;
+}
+
+/*****************************************************************************
+  Description:
+    Process a response message matched to a command request.
+
+  Parameters:
+    pCtrlCtx      - Pointer to the device control context
+    pSendReqState - Pointer to command request burst
+    pReqHdr       - Pointer to request header of the matched command
+    pMsg          - Pointer to response message
+    cmdIdx        - Index of the matched command within the burst
+    pNumStatus    - Pointer to number of status responses received for burst
+
+  Returns:
+    Pointer to command request burst, or NULL if the burst is complete.
+
+  Remarks:
+    Status responses complete the command request, command responses are
+    passed to the application layer.
+
+ *****************************************************************************/
+
+static WINC_SEND_REQ_STATE* devProcessMatchedRsp(WINC_DEV_CTRL_CTX *pCtrlCtx, WINC_SEND_REQ_STATE *pSendReqState, WINC_SEND_REQ_HDR_ELEM *pReqHdr, uint8_t *pMsg, uint8_t cmdIdx, uint8_t *pNumStatus)
+{
+    WINC_COMMAND_REQUEST *pCmdReq;
+    WINC_COMMAND_RESPONSE *pCmdRsp;
+    uint16_t rspCmdId;
+
+    pCmdReq = (WINC_COMMAND_REQUEST*)pReqHdr->pPtr;
+    pCmdRsp = (WINC_COMMAND_RESPONSE*)pMsg;
+
+    rspCmdId = WINC_FIELD_UNPACK_16(pCmdRsp->id);
+
+    if (WINC_COMMAND_MSG_TYPE_STATUS == (WINC_COMMAND_MSG_TYPE)pCmdRsp->msgType)
+    {
+        /* The message is a status response, this completes a command request. */
+
+        uint8_t numParams;
+
+        /* Save the number of parameters in the original command request to be
+         used later in the callback. */
+
+        numParams = pCmdReq->numParams;
+
+        /* Copy the command response over the command request, this wipes out
+         the request header but leaves the parameters intact incase they are
+         needed in the callback. */
+
+        (void)memcpy(pReqHdr->pPtr, pMsg, WINC_CMD_RSP_STATUS_LEN);
+
+        /* Update the request header to reflect the new length and flag
+         that the status has been received. */
+
+        pReqHdr->length = WINC_CMD_RSP_STATUS_LEN;
+        pReqHdr->flags |= WINC_FLAG_STATUS_RCVD;
+
+        pSendReqState = devCompleteCmdStatusRsp(pCtrlCtx, pSendReqState, WINC_FIELD_UNPACK_16(pCmdRsp->payload.status.status), rspCmdId, cmdIdx, WINC_FIELD_UNPACK_16(pCmdRsp->seqNum), numParams, pCmdReq->params, pNumStatus);
+    }
+    else
+    {
+        /* Command responses are simply passed to the application layer
+         for processing. */
+
+        WINC_DEV_EVENT_RSP_ELEMS eventRspElems;
+
+        eventRspElems.rspCmdId          = rspCmdId;
+        eventRspElems.srcCmd.idx        = cmdIdx;
+        eventRspElems.srcCmd.numParams  = pCmdReq->numParams;
+        eventRspElems.srcCmd.pParams    = pCmdReq->params;
+
+        (void)devUnpackResponseElements(pCmdRsp, &eventRspElems);
+
+        if (NULL != pSendReqState->pfCmdRspCallback)
+        {
+            WINC_CONF_LOCK_LEAVE(&pCtrlCtx->accessMutex);
+            pSendReqState->pfCmdRspCallback(pSendReqState->cmdRspCallbackCtx, (WINC_DEVICE_HANDLE)pCtrlCtx, (WINC_CMD_REQ_HANDLE)pSendReqState, WINC_DEV_CMDREQ_EVENT_RSP_RECEIVED, (uintptr_t)&eventRspElems);
+            if (false == WINC_CONF_LOCK_ENTER(&pCtrlCtx->accessMutex))
+            {
+            }
+        }
+    }
+
+    return pSendReqState;
+}
+
+/*****************************************************************************
+  Description:
+    Look up the command request matching a response in the response index.
+
+  Parameters:
+    pCtrlCtx - Pointer to the device control context
+    pMsg     - Pointer to response message
+    seqNum   - Sequence number of the response
+
+  Returns:
+    Pointer to the response index entry, or NULL if no match is found.
+
+  Remarks:
+    Only the next outstanding command of the head command request burst is
+    matched, any other response must be resolved by walking the burst so
+    that skipped commands are detected.
+
+ *****************************************************************************/
+
+static WINC_DEV_RSP_INDEX_ENTRY* devLookupRspIndex(WINC_DEV_CTRL_CTX *pCtrlCtx, const uint8_t *pMsg, uint16_t seqNum)
+{
+    WINC_DEV_RSP_INDEX_ENTRY *pRspIndex;
+    WINC_SEND_REQ_STATE *pSendReqState;
+
+    pSendReqState = (WINC_SEND_REQ_STATE*)pCtrlCtx->cmdReqQueue;
+
+    if (NULL == pSendReqState)
+    {
+        return NULL;
+    }
+
+    pRspIndex = &pCtrlCtx->rspIndex[seqNum & (WINC_DEV_RSP_INDEX_SZ - 1U)];
+
+    if ((pRspIndex->pSendReqState != pSendReqState) || (pRspIndex->seqNum != seqNum) || (NULL == pRspIndex->pReqHdr))
+    {
+        return NULL;
+    }
+
+    if (pRspIndex->cmdIdx != pSendReqState->numStatus)
+    {
+        return NULL;
+    }
+
+    if ((NULL == pRspIndex->pReqHdr->pPtr) || (WINC_COMMAND_MSG_TYPE_REQ != (WINC_COMMAND_MSG_TYPE)pRspIndex->pReqHdr->pPtr[0]))
+    {
+        return NULL;
+    }
+
+    /* Command requests and responses share the same header format for
+     ID and sequence number, so a simple compare can be used to match them. */
+
+    if (0 != memcmp(&pRspIndex->pReqHdr->pPtr[1], &pMsg[1], WINC_CMD_RSP_HDR_SIZE-1U))
+    {
+        return NULL;
+    }
+
+    return pRspIndex;
+}
+
+/*****************************************************************************
+  Description:
+    Decode a command response or AEC message.
+
+  Parameters:
+    pCtrlCtx  - Pointer to the device control context
+    pMsg      - Pointer to response message
+    msgLength - Length of response message
 
   Returns:
     None
@@ -577,7 +1399,6 @@ static void devDecodeResponseMsg(WINC_DEV_CTRL_CTX *pCtrlCtx, uint8_t *pMsg, siz
 {
     WINC_COMMAND_REQUEST *pCmdReq;
     WINC_COMMAND_RESPONSE *pCmdRsp;
-    uint16_t rspCmdId;
     uint16_t seqNum;
     uint8_t i;
 
@@ -590,12 +1411,15 @@ static void devDecodeResponseMsg(WINC_DEV_CTRL_CTX *pCtrlCtx, uint8_t *pMsg, siz
 
     pCmdRsp = (WINC_COMMAND_RESPONSE*)pMsg;
 
-    /* Extract command ID and sequence number from the response header for later use. */
+    /* Extract sequence number from the response header for later use. */
 
-    rspCmdId = WINC_FIELD_UNPACK_16(pCmdRsp->id);
-    seqNum   = WINC_FIELD_UNPACK_16(pCmdRsp->seqNum);
+    seqNum = WINC_FIELD_UNPACK_16(pCmdRsp->seqNum);
+
+    WINC_TRACE_PRINT("Message type %d received, length=%d, ID=%04x, SN=%04x\n", pCmdRsp->msgType, msgLength, WINC_FIELD_UNPACK_16(pCmdRsp->id), seqNum);
 
-    WINC_TRACE_PRINT("Message type %d received, length=%d, ID=%04x, SN=%04x\n", pCmdRsp->msgType, msgLength, rspCmdId, seqNum);
+#ifdef WINC_DEV_CAPTURE_ENABLE
+    devCaptureRecord(pCtrlCtx, WINC_DEV_CAPTURE_TYPE_RX_MSG, pMsg, msgLength);
+#endif
 
     if (NULL != pCtrlCtx->pfIinterceptCallback)
     {
@@ -612,6 +1436,7 @@ static void devDecodeResponseMsg(WINC_DEV_CTRL_CTX *pCtrlCtx, uint8_t *pMsg, siz
     {
         WINC_SEND_REQ_STATE *pSendReqState;
         WINC_SEND_REQ_HDR_ELEM *pReqHdr;
+        WINC_DEV_RSP_INDEX_ENTRY *pRspIndex;
         uint8_t numStatus;
 
         /* Ensure a minimum length has been passed in to be able to process the header. */
@@ -631,6 +1456,22 @@ static void devDecodeResponseMsg(WINC_DEV_CTRL_CTX *pCtrlCtx, uint8_t *pMsg, siz
             }
         }
 
+        /* Try the response index first, in the common case the response is
+         for the next outstanding command of the head burst. */
+
+        pRspIndex = devLookupRspIndex(pCtrlCtx, pMsg, seqNum);
+
+        if (NULL != pRspIndex)
+        {
+            WINC_TRACE_PRINT("Index match found on command %d\n", pRspIndex->cmdIdx);
+
+            numStatus = pRspIndex->pSendReqState->numStatus;
+
+            (void)devProcessMatchedRsp(pCtrlCtx, pRspIndex->pSendReqState, pRspIndex->pReqHdr, pMsg, pRspIndex->cmdIdx, &numStatus);
+
+            return;
+        }
+
         while (NULL != pMsg)
         {
             numStatus = 0;
@@ -697,54 +1538,7 @@ static void devDecodeResponseMsg(WINC_DEV_CTRL_CTX *pCtrlCtx, uint8_t *pMsg, siz
                         {
                             WINC_TRACE_PRINT("Match found on command %d\n", i);
 
-                            if (WINC_COMMAND_MSG_TYPE_STATUS == (WINC_COMMAND_MSG_TYPE)pCmdRsp->msgType)
-                            {
-                                /* The message is a status response, this completes a command request. */
-
-                                uint8_t numParams;
-
-                                /* Save the number of parameters in the original command request to be
-                                 used later in the callback. */
-
-                                numParams = pCmdReq->numParams;
-
-                                /* Copy the command response over the command request, this wipes out
-                                 the request header but leaves the parameters intact incase they are
-                                 needed in the callback. */
-
-                                (void)memcpy(pReqHdr->pPtr, pMsg, WINC_CMD_RSP_STATUS_LEN);
-
-                                /* Update the request header to reflect the new length and flag
-                                 that the status has been received. */
-
-                                pReqHdr->length = WINC_CMD_RSP_STATUS_LEN;
-                                pReqHdr->flags |= WINC_FLAG_STATUS_RCVD;
-
-                                pSendReqState = devCompleteCmdStatusRsp(pCtrlCtx, pSendReqState, WINC_FIELD_UNPACK_16(pCmdRsp->payload.status.status), rspCmdId, i, seqNum, numParams, pCmdReq->params, &numStatus);
-                            }
-                            else
-                            {
-                                /* Command responses are simply passed to the application layer
-                                 for processing. */
-
-                                WINC_DEV_EVENT_RSP_ELEMS eventRspElems;
-
-                                eventRspElems.rspCmdId          = rspCmdId;
-                                eventRspElems.srcCmd.idx        = i;
-                                eventRspElems.srcCmd.numParams  = pCmdReq->numParams;
-                                eventRspElems.srcCmd.pParams    = pCmdReq->params;
-
-                                (void)devUnpackResponseElements(pCmdRsp, &eventRspElems);
-
-                                if (NULL != pSendReqState->pfCmdRspCallback)
-                                {
-                                    WINC_CONF_LOCK_LEAVE(&pCtrlCtx->accessMutex);
-                                    pSendReqState->pfCmdRspCallback(pSendReqState->cmdRspCallbackCtx, (WINC_DEVICE_HANDLE)pCtrlCtx, (WINC_CMD_REQ_HANDLE)pSendReqState, WINC_DEV_CMDREQ_EVENT_RSP_RECEIVED, (uintptr_t)&eventRspElems);
-                                    if (false == WINC_CONF_LOCK_ENTER(&pCtrlCtx->accessMutex))
-                                    {
-                                    }
-                                }
-                            }
+                            (void)devProcessMatchedRsp(pCtrlCtx, pSendReqState, pReqHdr, pMsg, i, &numStatus);
 
                             pMsg = NULL;
 
@@ -782,17 +1576,42 @@ static void devDecodeResponseMsg(WINC_DEV_CTRL_CTX *pCtrlCtx, uint8_t *pMsg, siz
     else if (WINC_COMMAND_MSG_TYPE_AEC == (WINC_COMMAND_MSG_TYPE)pCmdRsp->msgType)
     {
         /* AECs are passed to the application layer, the response elements are
-         passed to all registered AEC callback handlers. */
+         passed to the registered AEC callback handlers subscribed to the
+         module which raised the AEC. */
 
         WINC_DEV_EVENT_RSP_ELEMS eventRspElems;
+        uint8_t modIdx;
+        uint8_t cbEntries;
+
+        modIdx = pCmdRsp->payload.rsp.rspId_h;
+
+        if (modIdx >= WINC_DEV_AEC_NUM_MODULES)
+        {
+            modIdx = WINC_DEV_AEC_DISPATCH_OTHER;
+        }
+
+        cbEntries = pCtrlCtx->aecDispatchTable[modIdx];
+
+        if (0U == cbEntries)
+        {
+            WINC_VERBOSE_PRINT("AEC %04x has no subscribers\n", WINC_FIELD_UNPACK_16(pCmdRsp->payload.rsp.rspId));
+            return;
+        }
 
         (void)memset(&eventRspElems, 0, sizeof(eventRspElems));
 
         (void)devUnpackResponseElements(pCmdRsp, &eventRspElems);
 
-        for (i=0; i<WINC_DEV_NUM_AEC_CB_ENTRIES; i++)
+        while (0U != cbEntries)
         {
-            if (NULL != pCtrlCtx->aecCallbackTable[i].pfAecRspCallback)
+            i = (uint8_t)__builtin_ctz(cbEntries);
+
+            cbEntries &= (uint8_t)(cbEntries - 1U);
+
+            /* The lock is released during each callback, so check the
+             entry is still subscribed before calling it. */
+
+            if ((0U != (pCtrlCtx->aecDispatchTable[modIdx] & (1U << i))) && (NULL != pCtrlCtx->aecCallbackTable[i].pfAecRspCallback))
             {
                 WINC_CONF_LOCK_LEAVE(&pCtrlCtx->accessMutex);
 
@@ -852,6 +1671,10 @@ static bool devProcessTransmitReqEvent(WINC_DEV_CTRL_CTX *pCtrlCtx, WINC_DEV_EVE
     pEvent->txReq.pSendReqHdr->length = (uint16_t)((pEvent->txReq.pSendReqHdr->length + 3U) & ~0x0003U);
 
     WINC_TRACE_PRINT("R: %08x %08x %d %d\n", pEvent->txReq.pSendReqHdr, pEvent->txReq.pSendReqHdr->pPtr, pEvent->txReq.pSendReqHdr->length, pEvent->length);
+
+#ifdef WINC_DEV_CAPTURE_ENABLE
+    devCaptureRecord(pCtrlCtx, WINC_DEV_CAPTURE_TYPE_TX_DATA, pEvent->txReq.pSendReqHdr->pPtr, pEvent->txReq.pSendReqHdr->length);
+#endif
     cmd53Status = WINC_SDIOCmd53Write(WINC_SDIOREG_FN1_DATA, pEvent->txReq.pSendReqHdr->pPtr, pEvent->txReq.pSendReqHdr->length, false);
     if (WINC_SDIO_R1RSP_OK != cmd53Status)
     {
@@ -889,11 +1712,35 @@ static bool devProcessTransmitReqEvent(WINC_DEV_CTRL_CTX *pCtrlCtx, WINC_DEV_EVE
                 }
             }
 
-            (void)memset(pEvent, 0, sizeof(WINC_DEV_EVENT_CTX));
+            if (pSendReqState != pCtrlCtx->pBurstLastReqState)
+            {
+                /* The next request was merged into this burst, continue with
+                 its first request header. */
 
-            WINC_TRACE_PRINT("CmdReq %08x complete, moving to %08x\n", pSendReqState, pSendReqState->nextCmdReq);
+                WINC_SEND_REQ_STATE *pNextSendReqState = (WINC_SEND_REQ_STATE*)pSendReqState->nextCmdReq;
 
-            (void)devProcessPendingCmdReqQueue(pCtrlCtx, (WINC_SEND_REQ_STATE*)pSendReqState->nextCmdReq);
+                WINC_TRACE_PRINT("CmdReq %08x complete, continuing burst with %08x\n", pSendReqState, pNextSendReqState);
+
+                pCtrlCtx->pSendReqState = pNextSendReqState;
+
+                if (0U == pEvent->number)
+                {
+                    (void)memset(pEvent, 0, sizeof(WINC_DEV_EVENT_CTX));
+                }
+                else
+                {
+                    pEvent->txReq.pSendReqHdr  = pNextSendReqState->pFirstHdrElem;
+                    pEvent->txReq.cmdReqHandle = (WINC_CMD_REQ_HANDLE)pNextSendReqState;
+                }
+            }
+            else
+            {
+                (void)memset(pEvent, 0, sizeof(WINC_DEV_EVENT_CTX));
+
+                WINC_TRACE_PRINT("CmdReq %08x complete\n", pSendReqState);
+
+                (void)devScheduleCmdReq(pCtrlCtx);
+            }
         }
     }
     else if (0U == pEvent->number)
@@ -926,6 +1773,10 @@ static bool devProcessTransmitReqEvent(WINC_DEV_CTRL_CTX *pCtrlCtx, WINC_DEV_EVE
     true or false indicating success or failure
 
   Remarks:
+    When more messages follow, the read of the next message is started before
+    the current one is decoded, so the final data block is received while the
+    message is decoded. The next message is placed where it does not overlap
+    the current one.
 
  *****************************************************************************/
 
@@ -933,6 +1784,10 @@ static bool devProcessReceiveReqEvent(WINC_DEV_CTRL_CTX *pCtrlCtx, WINC_DEV_EVEN
 {
     uint16_t cmd53Status;
     size_t msgLength;
+    size_t nextLength;
+    size_t nextOffset;
+    uint8_t *pMsg;
+    bool nextReadFailed = false;
 
     (void)cmd53Status;
 
@@ -974,14 +1829,26 @@ static bool devProcessReceiveReqEvent(WINC_DEV_CTRL_CTX *pCtrlCtx, WINC_DEV_EVEN
 
     msgLength = *pEvent->rxReq.pMsgLengths << 2;
 
-    if (msgLength > (pCtrlCtx->receiveBufferSize - pEvent->rxReq.receiveBufferOffset))
+    if (true == pEvent->rxReq.prefetched)
     {
-        WINC_ERROR_PRINT("error, receive message exceeds buffer. %d %d %d\n", *pEvent->rxReq.pMsgLengths, pCtrlCtx->receiveBufferSize, pEvent->number);
-        (void)memset(pEvent, 0, sizeof(WINC_DEV_EVENT_CTX));
-        return false;
+        pEvent->rxReq.prefetched = false;
+
+        cmd53Status = WINC_SDIOCmd53ReadComplete();
+    }
+    else
+    {
+        pEvent->rxReq.msgOffset = pEvent->rxReq.receiveBufferOffset;
+
+        if (msgLength > (pCtrlCtx->receiveBufferSize - pEvent->rxReq.msgOffset))
+        {
+            WINC_ERROR_PRINT("error, receive message exceeds buffer. %d %d %d\n", *pEvent->rxReq.pMsgLengths, pCtrlCtx->receiveBufferSize, pEvent->number);
+            (void)memset(pEvent, 0, sizeof(WINC_DEV_EVENT_CTX));
+            return false;
+        }
+
+        cmd53Status = WINC_SDIOCmd53Read(WINC_SDIOREG_FN1_DATA, &pCtrlCtx->pReceiveBuffer[pEvent->rxReq.msgOffset], msgLength, false);
     }
 
-    cmd53Status = WINC_SDIOCmd53Read(WINC_SDIOREG_FN1_DATA, &pCtrlCtx->pReceiveBuffer[pEvent->rxReq.receiveBufferOffset], msgLength, false);
     if (WINC_SDIO_R1RSP_OK != cmd53Status)
     {
         WINC_ERROR_PRINT("error, msg(%d) CMD53 read failed, status=0x%04x\n", (pEvent->rxReq.pMsgLengths-(uint32_t*)(void*)pCtrlCtx->pReceiveBuffer), cmd53Status);
@@ -989,7 +1856,51 @@ static bool devProcessReceiveReqEvent(WINC_DEV_CTRL_CTX *pCtrlCtx, WINC_DEV_EVEN
         return false;
     }
 
-    devDecodeResponseMsg(pCtrlCtx, &pCtrlCtx->pReceiveBuffer[pEvent->rxReq.receiveBufferOffset], msgLength);
+    pMsg = &pCtrlCtx->pReceiveBuffer[pEvent->rxReq.msgOffset];
+
+    if (pEvent->number > 1U)
+    {
+        nextLength = pEvent->rxReq.pMsgLengths[1] << 2;
+
+        if (WINC_DEV_CACHE_GET_SIZE(nextLength) <= (pEvent->rxReq.msgOffset - pEvent->rxReq.receiveBufferOffset))
+        {
+            /* Next message fits in front of the current one. */
+            nextOffset = pEvent->rxReq.receiveBufferOffset;
+        }
+        else
+        {
+            /* Next message follows the current one, if there is space. */
+            nextOffset = pEvent->rxReq.msgOffset + WINC_DEV_CACHE_GET_SIZE(msgLength);
+
+            if ((nextOffset > pCtrlCtx->receiveBufferSize) || (nextLength > (pCtrlCtx->receiveBufferSize - nextOffset)))
+            {
+                nextOffset = 0;
+            }
+        }
+
+        if (0U != nextOffset)
+        {
+            cmd53Status = WINC_SDIOCmd53ReadStart(WINC_SDIOREG_FN1_DATA, &pCtrlCtx->pReceiveBuffer[nextOffset], nextLength, false);
+            if (WINC_SDIO_R1RSP_OK != cmd53Status)
+            {
+                WINC_ERROR_PRINT("error, msg(%d) CMD53 read failed, status=0x%04x\n", (&pEvent->rxReq.pMsgLengths[1]-(uint32_t*)(void*)pCtrlCtx->pReceiveBuffer), cmd53Status);
+                nextReadFailed = true;
+            }
+            else
+            {
+                pEvent->rxReq.msgOffset  = nextOffset;
+                pEvent->rxReq.prefetched = true;
+            }
+        }
+    }
+
+    devDecodeResponseMsg(pCtrlCtx, pMsg, msgLength);
+
+    if (true == nextReadFailed)
+    {
+        (void)memset(pEvent, 0, sizeof(WINC_DEV_EVENT_CTX));
+        return false;
+    }
 
     pEvent->rxReq.pMsgLengths++;
 
@@ -1068,6 +1979,7 @@ WINC_DEVICE_HANDLE WINC_DevInit(const WINC_DEV_INIT *pInitData)
 void WINC_DevDeinit(WINC_DEVICE_HANDLE devHandle)
 {
     WINC_DEV_CTRL_CTX *pCtrlCtx = (WINC_DEV_CTRL_CTX*)devHandle;
+    uint8_t cmdClass;
 
     if ((NULL == pCtrlCtx) || (false == pCtrlCtx->isInit))
     {
@@ -1085,6 +1997,11 @@ void WINC_DevDeinit(WINC_DEVICE_HANDLE devHandle)
 
     WINC_CmdReqDiscard((WINC_DEVICE_HANDLE)pCtrlCtx, pCtrlCtx->cmdReqQueue);
 
+    for (cmdClass=0; cmdClass<WINC_DEV_NUM_CMD_CLASSES; cmdClass++)
+    {
+        WINC_CmdReqDiscard((WINC_DEVICE_HANDLE)pCtrlCtx, (WINC_CMD_REQ_HANDLE)pCtrlCtx->cmdClassQueue[cmdClass].pHead);
+    }
+
     WINC_CONF_LOCK_DESTROY(&pCtrlCtx->accessMutex);
 }
 
@@ -1138,40 +2055,40 @@ bool WINC_DevTransmitCmdReq(WINC_DEVICE_HANDLE devHandle, WINC_CMD_REQ_HANDLE cm
         return false;
     }
 
-    if (false == devPreparePendingCmdReq(pCtrlCtx, pSendReqState))
+    if (0U == pSendReqState->numCmds)
     {
         WINC_CONF_LOCK_LEAVE(&pCtrlCtx->accessMutex);
         return false;
     }
 
-    if (WINC_CMD_REQ_INVALID_HANDLE != pCtrlCtx->cmdReqQueue)
-    {
-        /* If there is currently a request in the queue, walk the queue and
-         append the request to the end. */
-
-        WINC_SEND_REQ_STATE *pPendingSendReqState = (WINC_SEND_REQ_STATE*)pCtrlCtx->cmdReqQueue;
-
-        while (WINC_CMD_REQ_INVALID_HANDLE != pPendingSendReqState->nextCmdReq)
-        {
-            pPendingSendReqState = (WINC_SEND_REQ_STATE*)pPendingSendReqState->nextCmdReq;
-        }
-
-        WINC_TRACE_PRINT("CmdReq add %08x to %08x\n", pSendReqState, pPendingSendReqState);
-
-        pPendingSendReqState->nextCmdReq = cmdReqHandle;
-    }
-    else
-    {
-        /* No outstanding request, place on the queue and kick off processing. */
-
-        pCtrlCtx->cmdReqQueue = cmdReqHandle;
+    /* Add the request to its class queue, requests are moved from the class
+     queues onto the command request queue as they are sent, at which point
+     sequence numbers are assigned in transmission order. */
 
-        WINC_TRACE_PRINT("CmdReq add %08x\n", pSendReqState);
-    }
+    devCmdClassQueueAdd(pCtrlCtx, pSendReqState);
 
     if ((NULL == pCtrlCtx->pSendReqState) && (WINC_DEV_BUS_STATE_ACTIVE == wincDevCtrlCtx.busState))
     {
-        result = devProcessPendingCmdReqQueue(pCtrlCtx, pSendReqState);
+#if (WINC_DEV_COALESCE_HOLD_CNT > 0U)
+        /* Hold requests queued on an idle bus so later requests can be merged
+         with them, WINC_DevUpdateEvent sends them once the hold count expires. */
+
+        if (0U == pCtrlCtx->holdCount)
+        {
+            pCtrlCtx->holdCount = (uint8_t)WINC_DEV_COALESCE_HOLD_CNT;
+        }
+        else if (pCtrlCtx->pendNumCmds >= WINC_DEV_COALESCE_MAX_CMDS)
+        {
+            /* Send once no further requests could be merged. */
+
+            result = devScheduleCmdReq(pCtrlCtx);
+        }
+        else
+        {
+        }
+#else
+        result = devScheduleCmdReq(pCtrlCtx);
+#endif
     }
 
     WINC_CONF_LOCK_LEAVE(&pCtrlCtx->accessMutex);
@@ -1208,6 +2125,30 @@ bool WINC_DevUpdateEvent(WINC_DEVICE_HANDLE devHandle)
         return false;
     }
 
+    pCtrlCtx->updateCount++;
+
+    if ((0U != pCtrlCtx->pendNumCmds) && (NULL == pCtrlCtx->pSendReqState) && (WINC_DEV_BUS_STATE_ACTIVE == pCtrlCtx->busState))
+    {
+#if (WINC_DEV_COALESCE_HOLD_CNT > 0U)
+        if (pCtrlCtx->holdCount > 0U)
+        {
+            pCtrlCtx->holdCount--;
+        }
+
+        if (0U == pCtrlCtx->holdCount)
+#endif
+        {
+            /* Send pending requests once any hold has expired, or when a
+             class window has reopened. */
+
+            if (false == devScheduleCmdReq(pCtrlCtx))
+            {
+                WINC_CONF_LOCK_LEAVE(&pCtrlCtx->accessMutex);
+                return false;
+            }
+        }
+    }
+
     switch ((WINC_DEV_EVENT_TYPE)pCtrlCtx->eventCtx.type)
     {
         case WINC_DEV_EVENT_NONE:
@@ -1346,6 +2287,8 @@ bool WINC_DevHandleEvent(WINC_DEVICE_HANDLE devHandle, WINC_DEV_EVENT_CHECK_FP p
             {
                 pCtrlCtx->eventCtx.rxReq.pMsgLengths         = NULL;
                 pCtrlCtx->eventCtx.rxReq.receiveBufferOffset = 0;
+                pCtrlCtx->eventCtx.rxReq.msgOffset           = 0;
+                pCtrlCtx->eventCtx.rxReq.prefetched          = false;
                 break;
             }
 
@@ -1386,6 +2329,52 @@ bool WINC_DevHandleEvent(WINC_DEVICE_HANDLE devHandle, WINC_DEV_EVENT_CHECK_FP p
     return true;
 }
 
+/*****************************************************************************
+  Description:
+    Rebuild the AEC dispatch table.
+
+  Parameters:
+    pCtrlCtx - Pointer to the device control context
+
+  Returns:
+    None
+
+  Remarks:
+    Each dispatch table entry holds a bitmap of the AEC callback entries
+    subscribed to the module, the final entry covers all modules outside of
+    the subscription mask range.
+
+ *****************************************************************************/
+
+static void devAECDispatchTableUpdate(WINC_DEV_CTRL_CTX *pCtrlCtx)
+{
+    uint8_t i;
+    uint8_t modIdx;
+
+    (void)memset(pCtrlCtx->aecDispatchTable, 0, sizeof(pCtrlCtx->aecDispatchTable));
+
+    for (i=0; i<WINC_DEV_NUM_AEC_CB_ENTRIES; i++)
+    {
+        if (NULL == pCtrlCtx->aecCallbackTable[i].pfAecRspCallback)
+        {
+            continue;
+        }
+
+        for (modIdx=0; modIdx<WINC_DEV_AEC_NUM_MODULES; modIdx++)
+        {
+            if (0U != (pCtrlCtx->aecCallbackTable[i].modMask & WINC_DEV_AEC_MOD_MASK(modIdx)))
+            {
+                pCtrlCtx->aecDispatchTable[modIdx] |= (uint8_t)(1U << i);
+            }
+        }
+
+        if (WINC_DEV_AEC_MOD_MASK_ALL == pCtrlCtx->aecCallbackTable[i].modMask)
+        {
+            pCtrlCtx->aecDispatchTable[WINC_DEV_AEC_DISPATCH_OTHER] |= (uint8_t)(1U << i);
+        }
+    }
+}
+
 /*****************************************************************************
   Description:
     Register a callback to receive AEC notifications.
@@ -1399,16 +2388,40 @@ bool WINC_DevHandleEvent(WINC_DEVICE_HANDLE devHandle, WINC_DEV_EVENT_CHECK_FP p
     true or false indicating success or failure
 
   Remarks:
+    The callback is subscribed to AECs from all modules.
 
  *****************************************************************************/
 
 bool WINC_DevAECCallbackRegister(WINC_DEVICE_HANDLE devHandle, WINC_DEV_AEC_RSP_CB pfAecRspCallback, uintptr_t aecRspCallbackCtx)
+{
+    return WINC_DevAECCallbackRegisterMask(devHandle, pfAecRspCallback, aecRspCallbackCtx, WINC_DEV_AEC_MOD_MASK_ALL);
+}
+
+/*****************************************************************************
+  Description:
+    Register a callback to receive AEC notifications from a set of modules.
+
+  Parameters:
+    devHandle         - Device handle obtained from WINC_DevInit
+    pfAecRspCallback  - Pointer to callback function
+    aecRspCallbackCtx - Callback context, provided to callback when called
+    modMask           - Mask of modules, see WINC_DEV_AEC_MOD_MASK
+
+  Returns:
+    true or false indicating success or failure
+
+  Remarks:
+    The callback is only called for AECs raised by modules in modMask.
+
+ *****************************************************************************/
+
+bool WINC_DevAECCallbackRegisterMask(WINC_DEVICE_HANDLE devHandle, WINC_DEV_AEC_RSP_CB pfAecRspCallback, uintptr_t aecRspCallbackCtx, uint64_t modMask)
 {
     WINC_DEV_CTRL_CTX *pCtrlCtx = (WINC_DEV_CTRL_CTX*)devHandle;
     uint8_t i;
     bool result = false;
 
-    if ((NULL == pCtrlCtx) || (false == pCtrlCtx->isInit))
+    if ((NULL == pCtrlCtx) || (false == pCtrlCtx->isInit) || (0U == modMask))
     {
         return false;
     }
@@ -1424,6 +2437,9 @@ bool WINC_DevAECCallbackRegister(WINC_DEVICE_HANDLE devHandle, WINC_DEV_AEC_RSP_
         {
             pCtrlCtx->aecCallbackTable[i].pfAecRspCallback  = pfAecRspCallback;
             pCtrlCtx->aecCallbackTable[i].aecRspCallbackCtx = aecRspCallbackCtx;
+            pCtrlCtx->aecCallbackTable[i].modMask           = modMask;
+
+            devAECDispatchTableUpdate(pCtrlCtx);
 
             result = true;
             break;
@@ -1471,6 +2487,9 @@ bool WINC_DevAECCallbackDeregister(WINC_DEVICE_HANDLE devHandle, WINC_DEV_AEC_RS
         {
             pCtrlCtx->aecCallbackTable[i].pfAecRspCallback  = NULL;
             pCtrlCtx->aecCallbackTable[i].aecRspCallbackCtx = 0;
+            pCtrlCtx->aecCallbackTable[i].modMask           = 0;
+
+            devAECDispatchTableUpdate(pCtrlCtx);
 
             result = true;
             break;
@@ -1621,11 +2640,11 @@ bool WINC_DevBusStateSet(WINC_DEVICE_HANDLE devHandle, WINC_DEV_BUS_STATE_TYPE b
 
     if ((WINC_DEV_BUS_STATE_ACTIVE != pCtrlCtx->busState) && (WINC_DEV_BUS_STATE_ACTIVE == busState))
     {
-        if (WINC_CMD_REQ_INVALID_HANDLE != pCtrlCtx->cmdReqQueue)
+        if ((0U != pCtrlCtx->pendNumCmds) && (NULL == pCtrlCtx->pSendReqState))
         {
-            WINC_TRACE_PRINT("CmdReq restart with %08x\n", pCtrlCtx->cmdReqQueue);
+            WINC_TRACE_PRINT("CmdReq restart\n");
 
-            devProcessPendingCmdReqQueue(pCtrlCtx, (WINC_SEND_REQ_STATE*)pCtrlCtx->cmdReqQueue);
+            (void)devScheduleCmdReq(pCtrlCtx);
         }
     }
 
@@ -1637,3 +2656,258 @@ bool WINC_DevBusStateSet(WINC_DEVICE_HANDLE devHandle, WINC_DEV_BUS_STATE_TYPE b
 
     return true;
 }
+
+#ifdef WINC_DEV_CAPTURE_ENABLE
+/*****************************************************************************
+  Description:
+    Start capturing transmitted and received messages.
+
+  Parameters:
+    devHandle  - Device handle obtained from WINC_DevInit
+    pBuffer    - Pointer to buffer to hold the capture ring
+    bufferSize - Size of buffer
+
+  Returns:
+    true or false indicating success or failure
+
+  Remarks:
+    Any previous capture is discarded. The buffer must remain valid until
+    WINC_DevCaptureStop is called.
+
+ *****************************************************************************/
+
+bool WINC_DevCaptureStart(WINC_DEVICE_HANDLE devHandle, uint8_t *pBuffer, size_t bufferSize)
+{
+    WINC_DEV_CTRL_CTX *pCtrlCtx = (WINC_DEV_CTRL_CTX*)devHandle;
+
+    if ((NULL == pCtrlCtx) || (false == pCtrlCtx->isInit) || (NULL == pBuffer) || (bufferSize < (WINC_DEV_CAPTURE_HDR_SIZE + WINC_DEV_CAPTURE_DATA_LEN)))
+    {
+        return false;
+    }
+
+    if (false == WINC_CONF_LOCK_ENTER(&pCtrlCtx->accessMutex))
+    {
+        return false;
+    }
+
+    pCtrlCtx->capture.pBuffer    = pBuffer;
+    pCtrlCtx->capture.size       = bufferSize;
+    pCtrlCtx->capture.inIdx      = 0;
+    pCtrlCtx->capture.outIdx     = 0;
+    pCtrlCtx->capture.used       = 0;
+    pCtrlCtx->capture.numDropped = 0;
+
+    WINC_CONF_LOCK_LEAVE(&pCtrlCtx->accessMutex);
+
+    return true;
+}
+
+/*****************************************************************************
+  Description:
+    Stop capturing messages.
+
+  Parameters:
+    devHandle - Device handle obtained from WINC_DevInit
+
+  Returns:
+    true or false indicating success or failure
+
+  Remarks:
+    The capture buffer is released by the device.
+
+ *****************************************************************************/
+
+bool WINC_DevCaptureStop(WINC_DEVICE_HANDLE devHandle)
+{
+    WINC_DEV_CTRL_CTX *pCtrlCtx = (WINC_DEV_CTRL_CTX*)devHandle;
+
+    if ((NULL == pCtrlCtx) || (false == pCtrlCtx->isInit))
+    {
+        return false;
+    }
+
+    if (false == WINC_CONF_LOCK_ENTER(&pCtrlCtx->accessMutex))
+    {
+        return false;
+    }
+
+    pCtrlCtx->capture.pBuffer = NULL;
+    pCtrlCtx->capture.size    = 0;
+    pCtrlCtx->capture.used    = 0;
+
+    WINC_CONF_LOCK_LEAVE(&pCtrlCtx->accessMutex);
+
+    return true;
+}
+
+/*****************************************************************************
+  Description:
+    Read captured records.
+
+  Parameters:
+    devHandle - Device handle obtained from WINC_DevInit
+    pBuffer   - Pointer to buffer to receive records
+    length    - Length of buffer
+
+  Returns:
+    Number of bytes read.
+
+  Remarks:
+    Only whole records are read, records are removed from the capture ring.
+
+ *****************************************************************************/
+
+size_t WINC_DevCaptureRead(WINC_DEVICE_HANDLE devHandle, uint8_t *pBuffer, size_t length)
+{
+    WINC_DEV_CTRL_CTX *pCtrlCtx = (WINC_DEV_CTRL_CTX*)devHandle;
+    size_t readLen = 0;
+
+    if ((NULL == pCtrlCtx) || (false == pCtrlCtx->isInit) || (NULL == pBuffer))
+    {
+        return 0;
+    }
+
+    if (false == WINC_CONF_LOCK_ENTER(&pCtrlCtx->accessMutex))
+    {
+        return 0;
+    }
+
+    while (pCtrlCtx->capture.used > 0U)
+    {
+        size_t recLen;
+        size_t i;
+
+        recLen = WINC_DEV_CAPTURE_HDR_SIZE + pCtrlCtx->capture.pBuffer[(pCtrlCtx->capture.outIdx + 1U) % pCtrlCtx->capture.size];
+
+        if ((readLen + recLen) > length)
+        {
+            break;
+        }
+
+        for (i=0; i<recLen; i++)
+        {
+            pBuffer[readLen++] = pCtrlCtx->capture.pBuffer[pCtrlCtx->capture.outIdx];
+
+            pCtrlCtx->capture.outIdx = (pCtrlCtx->capture.outIdx + 1U) % pCtrlCtx->capture.size;
+        }
+
+        pCtrlCtx->capture.used -= recLen;
+    }
+
+    WINC_CONF_LOCK_LEAVE(&pCtrlCtx->accessMutex);
+
+    return readLen;
+}
+
+/*****************************************************************************
+  Description:
+    Dump captured records to a console.
+
+  Parameters:
+    devHandle - Device handle obtained from WINC_DevInit
+    pfPrintf  - Pointer to printf style function, or NULL to use the debug printf
+
+  Returns:
+    None.
+
+  Remarks:
+    Records are printed as hex between "WCAP START" and "WCAP END" lines and
+    removed from the capture ring. The start line reports the timestamp
+    frequency and the number of records dropped since the capture started.
+
+ *****************************************************************************/
+
+void WINC_DevCaptureDump(WINC_DEVICE_HANDLE devHandle, WINC_DEBUG_PRINTF_FP pfPrintf)
+{
+    WINC_DEV_CTRL_CTX *pCtrlCtx = (WINC_DEV_CTRL_CTX*)devHandle;
+    uint8_t recBuffer[WINC_DEV_CAPTURE_HDR_SIZE + WINC_DEV_CAPTURE_DATA_LEN];
+    size_t recLen;
+
+    if (NULL == pfPrintf)
+    {
+        pfPrintf = pfWINCDevDebugPrintf;
+    }
+
+    if ((NULL == pCtrlCtx) || (false == pCtrlCtx->isInit) || (NULL == pfPrintf))
+    {
+        return;
+    }
+
+    pfPrintf("WCAP START freq=%lu dropped=%lu\r\n", (unsigned long)WINC_DEV_CAPTURE_TIME_FREQ_GET(), (unsigned long)pCtrlCtx->capture.numDropped);
+
+    do
+    {
+        size_t i;
+
+        /* Records are read in blocks of at most one full size record. */
+
+        recLen = WINC_DevCaptureRead(devHandle, recBuffer, sizeof(recBuffer));
+
+        if (recLen > 0U)
+        {
+            pfPrintf("WCAP ");
+
+            for (i=0; i<recLen; i++)
+            {
+                pfPrintf("%02x", recBuffer[i]);
+            }
+
+            pfPrintf("\r\n");
+        }
+    }
+    while (recLen > 0U);
+
+    pfPrintf("WCAP END\r\n");
+}
+#endif /* WINC_DEV_CAPTURE_ENABLE */
+
+#ifdef WINC_DEV_CMD_CLASS_STATS_ENABLE
+/*****************************************************************************
+  Description:
+    Return a list of command request class statistics structures.
+
+  Parameters:
+    devHandle - Device handle obtained from WINC_DevInit
+    pStats    - Pointer to first structure in list, indexed by class.
+    numStats  - Length of list.
+
+  Returns:
+    Number of structures returned, or -1 on error.
+
+  Remarks:
+
+ *****************************************************************************/
+
+int WINC_DevCmdClassStatsGet(WINC_DEVICE_HANDLE devHandle, WINC_DEV_CMD_CLASS_STATS *pStats, int numStats)
+{
+    WINC_DEV_CTRL_CTX *pCtrlCtx = (WINC_DEV_CTRL_CTX*)devHandle;
+    int numStatsRet = 0;
+
+    if ((NULL == pCtrlCtx) || (false == pCtrlCtx->isInit) || (NULL == pStats) || (numStats <= 0))
+    {
+        return -1;
+    }
+
+    if (false == WINC_CONF_LOCK_ENTER(&pCtrlCtx->accessMutex))
+    {
+        return -1;
+    }
+
+    while ((numStatsRet < numStats) && (numStatsRet < (int)WINC_DEV_NUM_CMD_CLASSES))
+    {
+        const WINC_DEV_CMD_CLASS_QUEUE *pQueue = &pCtrlCtx->cmdClassQueue[numStatsRet];
+
+        (void)memcpy(pStats, &pQueue->stats, sizeof(WINC_DEV_CMD_CLASS_STATS));
+
+        pStats->numPending  = pQueue->numPending;
+        pStats->numInFlight = pQueue->numInFlight;
+
+        pStats++;
+        numStatsRet++;
+    }
+
+    WINC_CONF_LOCK_LEAVE(&pCtrlCtx->accessMutex);
+
+    return numStatsRet;
+}
+#endif /* WINC_DEV_CMD_CLASS_STATS_ENABLE */
@@ -52,6 +52,13 @@ typedef uintptr_t WINC_DEVICE_HANDLE;
 #endif
 #ifndef WINC_CONF_LOCK_ENTER
 #define WINC_CONF_LOCK_ENTER(NAME)          true
+#ifndef WINC_CONF_LOCK_TRY_ENTER
+#define WINC_CONF_LOCK_TRY_ENTER(NAME)      true
+#endif
+#endif
+/* Without a non-blocking lock, locking can never be attempted safely. */
+#ifndef WINC_CONF_LOCK_TRY_ENTER
+#define WINC_CONF_LOCK_TRY_ENTER(NAME)      false
 #endif
 #ifndef WINC_CONF_LOCK_LEAVE
 #define WINC_CONF_LOCK_LEAVE(NAME)
@@ -89,6 +96,72 @@ typedef enum
     WINC_DEV_BUS_STATE_ACTIVE,
 } WINC_DEV_BUS_STATE_TYPE;
 
+/*****************************************************************************
+  Description:
+    Command request scheduling class types.
+
+  Remarks:
+    Each class is queued separately, classes are listed in priority order.
+
+ *****************************************************************************/
+
+typedef enum
+{
+    WINC_DEV_CMD_CLASS_CONTROL,
+    WINC_DEV_CMD_CLASS_INTERACTIVE,
+    WINC_DEV_CMD_CLASS_BULK,
+    WINC_DEV_CMD_CLASS_AUTO = 0xff,
+} WINC_DEV_CMD_CLASS_TYPE;
+
+/* Number of command request scheduling classes. */
+#define WINC_DEV_NUM_CMD_CLASSES            3U
+
+#ifdef WINC_DEV_CMD_CLASS_STATS_ENABLE
+/*****************************************************************************
+  Description:
+    Command request class statistics structure.
+
+  Remarks:
+    Queueing delays are measured in WINC_CONF_TICK_GET ticks, or in calls to
+    WINC_DevUpdateEvent if that is not defined.
+
+ *****************************************************************************/
+
+typedef struct
+{
+    uint32_t numQueued;
+    uint32_t numSent;
+    uint32_t totalDelay;
+    uint32_t maxDelay;
+    uint16_t numPending;
+    uint8_t  numInFlight;
+} WINC_DEV_CMD_CLASS_STATS;
+#endif
+
+#ifdef WINC_DEV_CAPTURE_ENABLE
+/*****************************************************************************
+  Description:
+    Capture record types.
+
+  Remarks:
+    Each capture record starts with an 8 byte little endian header:
+      type (8 bits), captured length (8 bits), original length (16 bits),
+      timestamp (32 bits)
+    followed by the captured bytes.
+
+ *****************************************************************************/
+
+typedef enum
+{
+    WINC_DEV_CAPTURE_TYPE_TX_BURST = 1,     /* Burst request message written to the device */
+    WINC_DEV_CAPTURE_TYPE_TX_DATA,          /* Request header element written to the device */
+    WINC_DEV_CAPTURE_TYPE_RX_MSG,           /* Message received from the device */
+} WINC_DEV_CAPTURE_TYPE;
+
+/* Size of capture record header. */
+#define WINC_DEV_CAPTURE_HDR_SIZE           8U
+#endif
+
 /*****************************************************************************
   Description:
     WINC device initialisation structure.
@@ -177,6 +250,15 @@ typedef void (*WINC_DEV_RX_INTERCEPT_CB)(uintptr_t context, WINC_DEVICE_HANDLE d
 /* WINC IRQ event function check type definition. */
 typedef bool (*WINC_DEV_EVENT_CHECK_FP)(void);
 
+/* Number of modules which can be selected in an AEC subscription mask. */
+#define WINC_DEV_AEC_NUM_MODULES        64U
+
+/* AEC subscription mask for a module ID, see WINC_MOD_ID_xxx. */
+#define WINC_DEV_AEC_MOD_MASK(modId)    (((uint64_t)1U) << (modId))
+
+/* AEC subscription mask for all modules. */
+#define WINC_DEV_AEC_MOD_MASK_ALL       (~((uint64_t)0U))
+
 /* Helper macro to combine common structure 16-bit split bytes into one value. */
 #define WINC_FIELD_UNPACK_16(field)     (((uint16_t)(field##_h)) << 8) | (field##_l)
 
@@ -199,10 +281,20 @@ bool WINC_DevTransmitCmdReq(WINC_DEVICE_HANDLE devHandle, WINC_CMD_REQ_HANDLE cm
 bool WINC_DevUpdateEvent(WINC_DEVICE_HANDLE devHandle);
 bool WINC_DevHandleEvent(WINC_DEVICE_HANDLE devHandle, WINC_DEV_EVENT_CHECK_FP pfEventIntCheck);
 bool WINC_DevAECCallbackRegister(WINC_DEVICE_HANDLE devHandle, WINC_DEV_AEC_RSP_CB pfAecRspCallback, uintptr_t aecRspCallbackCtx);
+bool WINC_DevAECCallbackRegisterMask(WINC_DEVICE_HANDLE devHandle, WINC_DEV_AEC_RSP_CB pfAecRspCallback, uintptr_t aecRspCallbackCtx, uint64_t modMask);
 bool WINC_DevAECCallbackDeregister(WINC_DEVICE_HANDLE devHandle, WINC_DEV_AEC_RSP_CB pfAecRspCallback);
 bool WINC_DevUnpackElements(uint8_t numTlvs, const uint8_t *pTLVBytes, WINC_DEV_PARAM_ELEM *pElems);
 bool WINC_DevInterceptCallbackRegister(WINC_DEVICE_HANDLE devHandle, WINC_DEV_RX_INTERCEPT_CB pfInterceptCallback, uintptr_t interceptCallbackCtx);
 WINC_DEV_BUS_STATE_TYPE WINC_DevBusStateGet(WINC_DEVICE_HANDLE devHandle);
 bool WINC_DevBusStateSet(WINC_DEVICE_HANDLE devHandle, WINC_DEV_BUS_STATE_TYPE busState);
+#ifdef WINC_DEV_CAPTURE_ENABLE
+bool WINC_DevCaptureStart(WINC_DEVICE_HANDLE devHandle, uint8_t *pBuffer, size_t bufferSize);
+bool WINC_DevCaptureStop(WINC_DEVICE_HANDLE devHandle);
+size_t WINC_DevCaptureRead(WINC_DEVICE_HANDLE devHandle, uint8_t *pBuffer, size_t length);
+void WINC_DevCaptureDump(WINC_DEVICE_HANDLE devHandle, WINC_DEBUG_PRINTF_FP pfPrintf);
+#endif /* WINC_DEV_CAPTURE_ENABLE */
+#ifdef WINC_DEV_CMD_CLASS_STATS_ENABLE
+int WINC_DevCmdClassStatsGet(WINC_DEVICE_HANDLE devHandle, WINC_DEV_CMD_CLASS_STATS *pStats, int numStats);
+#endif /* WINC_DEV_CMD_CLASS_STATS_ENABLE */
 
 #endif /* WINC_DEV_H */
@@ -60,7 +60,8 @@ typedef struct
     Slab statistics structure.
 
   Remarks:
-    Slab statistics.
+    Slab statistics. Allocation counts and usage are in slabs, numFailedFrag
+    counts failures where enough slabs were free but not contiguous.
 
  *****************************************************************************/
 
@@ -70,6 +71,9 @@ typedef struct
     uint32_t numFrees;
     uint16_t numFailed;
     int8_t   peakUsage;
+    int8_t   largestFreeRun;
+    uint16_t numFailedFrag;
+    uint8_t  numFreeRuns;
 } WINC_SOCK_SLAB_STATS;
 #endif
 
@@ -132,6 +136,9 @@ typedef enum
 /* Socket event callback function type. */
 typedef void (*WINC_SOCKET_EVENT_CALLBACK)(uintptr_t context, int socket, WINC_SOCKET_EVENT event, WINC_SOCKET_STATUS status);
 
+/* Socket poll idle callback function type. */
+typedef void (*WINC_SOCKET_POLL_IDLE_CALLBACK)(uintptr_t context, int timeout);
+
 /*****************************************************************************
                             Socket Module API
  *****************************************************************************/
@@ -139,6 +146,8 @@ typedef void (*WINC_SOCKET_EVENT_CALLBACK)(uintptr_t context, int socket, WINC_S
 bool WINC_SockInit(WINC_DEVICE_HANDLE devHandle, WINC_SOCKET_INIT_TYPE *pInitData);
 bool WINC_SockDeinit(WINC_DEVICE_HANDLE devHandle);
 bool WINC_SockRegisterEventCallback(WINC_DEVICE_HANDLE devHandle, WINC_SOCKET_EVENT_CALLBACK pfSocketEventCB, uintptr_t context);
+bool WINC_SockRegisterPollIdleCallback(WINC_DEVICE_HANDLE devHandle, WINC_SOCKET_POLL_IDLE_CALLBACK pfPollIdleCB, uintptr_t context);
+bool WINC_SockUpdate(WINC_DEVICE_HANDLE devHandle);
 #ifdef WINC_SOCK_SLAB_STATS_ENABLE
 int WINC_SockSlabStatsGet(WINC_SOCK_SLAB_STATS *pStats, int numStats);
 #endif /* WINC_SOCK_SLAB_STATS_ENABLE */
@@ -242,12 +251,25 @@ struct ipv6_mreq
 /***************************** netinet/tcp.h *********************************/
 
 #define TCP_NODELAY     1
+#define TCP_CORK        3
 
 /***************************** arpa/inet.h ***********************************/
 
 int inet_pton(int af, const char *s, void *a0);
 const char *inet_ntop(int af, const void *a0, char *s, socklen_t l);
 
+/******************************* sys/uio.h ***********************************/
+
+#ifndef IOV_MAX
+#define IOV_MAX         16
+#endif
+
+struct iovec
+{
+    void *iov_base;
+    size_t iov_len;
+};
+
 /******************************* socket.h ************************************/
 
 #define SHUT_RD         0
@@ -277,6 +299,8 @@ const char *inet_ntop(int af, const void *a0, char *s, socklen_t l);
 
 #define MSG_PEEK        0x0002U
 #define MSG_TRUNC       0x0020U
+#define MSG_MORE        0x8000U
+#define MSG_WAITFORONE  0x10000U
 
 struct sockaddr
 {
@@ -284,6 +308,25 @@ struct sockaddr
     char sa_data[14];
 };
 
+struct msghdr
+{
+    void *msg_name;
+    socklen_t msg_namelen;
+    struct iovec *msg_iov;
+    int msg_iovlen;
+    void *msg_control;
+    socklen_t msg_controllen;
+    int msg_flags;
+};
+
+struct mmsghdr
+{
+    struct msghdr msg_hdr;
+    unsigned int msg_len;
+};
+
+struct timespec;
+
 /******************************** netdb.h ************************************/
 
 struct addrinfo
@@ -339,6 +382,12 @@ ssize_t WINC_SOCK_NS(recv)          (int fd, void *buf, size_t len, int flags);
 ssize_t WINC_SOCK_NS(recvfrom)      (int fd, void *buf, size_t len, int flags, struct sockaddr *addr, socklen_t *alen);
 ssize_t WINC_SOCK_NS(send)          (int fd, const void *buf, size_t len, int flags);
 ssize_t WINC_SOCK_NS(sendto)        (int fd, const void *buf, size_t len, int flags, const struct sockaddr *addr, socklen_t alen);
+ssize_t WINC_SOCK_NS(recvmsg)       (int fd, struct msghdr *msg, int flags);
+ssize_t WINC_SOCK_NS(sendmsg)       (int fd, const struct msghdr *msg, int flags);
+ssize_t WINC_SOCK_NS(readv)         (int fd, const struct iovec *iov, int iovcnt);
+ssize_t WINC_SOCK_NS(writev)        (int fd, const struct iovec *iov, int iovcnt);
+int     WINC_SOCK_NS(recvmmsg)      (int fd, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timespec *timeout);
+int     WINC_SOCK_NS(sendmmsg)      (int fd, struct mmsghdr *msgvec, unsigned int vlen, int flags);
 int     WINC_SOCK_NS(getaddrinfo)   (const char *host, const char *serv, const struct addrinfo *hint, struct addrinfo **res);
 void    WINC_SOCK_NS(freeaddrinfo)  (struct addrinfo *p);
 int     WINC_SOCK_NS(setsockopt)    (int fd, int level, int optname, const void *optval, socklen_t optlen);
@@ -366,4 +415,49 @@ typedef union sockaddr_union
     struct sockaddr_in6  in6;
 } SOCKADDR_UNION;
 
+/*****************************************************************************/
+/* readiness notification API */
+
+#define WINC_SOCK_EPOLLET           0x80000000U
+#define WINC_SOCK_EPOLLONESHOT      0x40000000U
+
+typedef enum
+{
+    WINC_SOCK_EPOLL_CTL_ADD,
+    WINC_SOCK_EPOLL_CTL_MOD,
+    WINC_SOCK_EPOLL_CTL_DEL
+} WINC_SOCK_EPOLL_CTL_OP;
+
+typedef struct
+{
+    uint32_t    events;     /* POLLIN/POLLOUT and WINC_SOCK_EPOLL* flags, returned poll events */
+    uintptr_t   data;       /* user data returned with events */
+} WINC_SOCK_EPOLL_EVENT;
+
+int WINC_SockEpollCreate(void);
+int WINC_SockEpollDestroy(int epfd);
+int WINC_SockEpollCtl(int epfd, WINC_SOCK_EPOLL_CTL_OP op, int fd, const WINC_SOCK_EPOLL_EVENT *pEvent);
+int WINC_SockEpollWait(int epfd, WINC_SOCK_EPOLL_EVENT *pEvents, int maxEvents, int timeout);
+
+/*****************************************************************************/
+/* borrowed receive API, reads the socket receive buffer in place */
+ssize_t WINC_SockRecvBorrow(int fd, const void **ppBuf, struct sockaddr *addr, socklen_t *alen);
+int     WINC_SockRecvRelease(int fd, size_t len);
+
+/*****************************************************************************/
+/* constant payload send API */
+
+/* Constant payload send completion callback, len is the length accepted by the device. */
+typedef void (*WINC_SOCK_SEND_CONST_CALLBACK)(uintptr_t context, int fd, const void *pData, size_t len, WINC_SOCKET_STATUS status);
+
+int WINC_SockSendConst(int fd, const void *pData, size_t len, WINC_SOCK_SEND_CONST_CALLBACK pfComplete, uintptr_t context);
+
+/*****************************************************************************/
+/* asynchronous name resolution API */
+
+/* Name resolution completion callback, the result is collected with getaddrinfo(). */
+typedef void (*WINC_SOCK_DNS_CALLBACK)(uintptr_t context, const char *host, WINC_SOCKET_STATUS status);
+
+int WINC_SockGetAddrInfoAsync(const char *host, const struct addrinfo *hint, WINC_SOCK_DNS_CALLBACK pfComplete, uintptr_t context);
+
 #endif /* WINC_SOCKET_H */
@@ -360,6 +360,41 @@ typedef struct
     } build;
 } WDRV_WINC_FIRMWARE_VERSION_INFO;
 
+// *****************************************************************************
+/*  Command Request Pool Statistics
+
+  Summary:
+    Defines the statistics of a command request pool size class.
+
+  Description:
+    This data type defines the usage statistics of one size class of the
+    command request buffer pool.
+
+  Remarks:
+    None.
+*/
+
+typedef struct
+{
+    /* Size of each buffer in the class. */
+    size_t blockSize;
+
+    /* Number of buffers in the class. */
+    uint8_t numBlocks;
+
+    /* Number of buffers currently free. */
+    uint8_t numFree;
+
+    /* Peak number of buffers in use. */
+    uint8_t peakUsage;
+
+    /* Number of allocations made from the class. */
+    uint32_t numAllocs;
+
+    /* Number of requests which fitted the class while it was empty. */
+    uint32_t numExhausted;
+} WDRV_WINC_CMD_REQ_POOL_STATS;
+
 // *****************************************************************************
 /*  Device Information
 
@@ -1697,6 +1732,82 @@ bool WDRV_WINC_DevTransmitCmdReq
 
 void WDRV_WINC_DevDiscardCmdReq(WINC_CMD_REQ_HANDLE cmdReqHandle);
 
+//*******************************************************************************
+/*
+  Function:
+    bool WDRV_WINC_CmdReqPoolAvailable
+    (
+        unsigned int numCommands,
+        size_t extraDataLen
+    )
+
+  Summary:
+    Checks if a command request buffer is available.
+
+  Description:
+    Determines if WDRV_WINC_CmdReqInit can currently allocate a command
+    request of the size given.
+
+  Precondition:
+    None.
+
+  Parameters:
+    numCommands  - Number of commands in request burst.
+    extraDataLen - Additional space required for data.
+
+  Returns:
+    true or false indicating if a buffer is available.
+
+  Remarks:
+    Allows callers to hold back requests while the pool is exhausted. Pool
+    occupancy is reported even if heap fallback is enabled, only requests
+    larger than every pool size class are then reported as available.
+
+*/
+
+bool WDRV_WINC_CmdReqPoolAvailable
+(
+    unsigned int numCommands,
+    size_t extraDataLen
+);
+
+//*******************************************************************************
+/*
+  Function:
+    int WDRV_WINC_CmdReqPoolStatsGet
+    (
+        WDRV_WINC_CMD_REQ_POOL_STATS *pStats,
+        int numStats
+    )
+
+  Summary:
+    Returns the command request pool statistics.
+
+  Description:
+    Copies the statistics of each size class of the command request pool,
+    smallest class first.
+
+  Precondition:
+    None.
+
+  Parameters:
+    pStats   - Pointer to first structure in list.
+    numStats - Length of list.
+
+  Returns:
+    Number of structures written or -1 for error.
+
+  Remarks:
+    None.
+
+*/
+
+int WDRV_WINC_CmdReqPoolStatsGet
+(
+    WDRV_WINC_CMD_REQ_POOL_STATS *pStats,
+    int numStats
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -52,20 +52,187 @@ TO MICROCHIP FOR THIS SOFTWARE.
 #define WINC_SOCK_BUF_TX_PKT_BUF_NUM        5
 #endif
 
+/* Maximum number of SOCKRD requests in flight for a stream socket. */
+#ifndef WINC_SOCK_RD_WINDOW_MAX
+#define WINC_SOCK_RD_WINDOW_MAX             4U
+#endif
+
 #ifndef WINC_SOCK_SLAB_ALLOC_MODE
 #define WINC_SOCK_SLAB_ALLOC_MODE           1
 #endif
 
+/* Adaptive stream socket buffer sizing. When WINC_SOCK_BUF_AUTOTUNE_ENABLE is
+   defined stream socket buffers start at WINC_SOCK_BUF_RX_SZ/WINC_SOCK_BUF_TX_SZ,
+   are grown towards the maximum size while the buffer limits throughput and
+   idle sockets are shrunk to the minimum size when memory is needed. */
+#ifdef WINC_SOCK_BUF_AUTOTUNE_ENABLE
+#if WINC_SOCK_SLAB_ALLOC_MODE != 1
+#error "WINC_SOCK_BUF_AUTOTUNE_ENABLE requires WINC_SOCK_SLAB_ALLOC_MODE 1"
+#endif
+
+#ifndef WINC_SOCK_BUF_RX_MIN_SZ
+#define WINC_SOCK_BUF_RX_MIN_SZ            MAX_SOCK_PAYLOAD_SZ
+#endif
+
+#ifndef WINC_SOCK_BUF_RX_MAX_SZ
+#define WINC_SOCK_BUF_RX_MAX_SZ            (WINC_SOCK_BUF_RX_SZ*4)
+#endif
+
+#ifndef WINC_SOCK_BUF_TX_MIN_SZ
+#define WINC_SOCK_BUF_TX_MIN_SZ            MAX_SOCK_PAYLOAD_SZ
+#endif
+
+#ifndef WINC_SOCK_BUF_TX_MAX_SZ
+#define WINC_SOCK_BUF_TX_MAX_SZ            (WINC_SOCK_BUF_TX_SZ*4)
+#endif
+
+/* Memory which must remain free in the slab allocator after a buffer is grown. */
+#ifndef WINC_SOCK_BUF_TUNE_RESERVE_SZ
+#define WINC_SOCK_BUF_TUNE_RESERVE_SZ      (WINC_SOCK_BUF_RX_SZ+WINC_SOCK_BUF_TX_SZ)
+#endif
+
+/* With WINC_CONF_TIME_MS_GET sizing uses measured drain rates. A buffer is only
+   grown again if its drain rate rose by at least 1/WINC_SOCK_BUF_TUNE_GAIN_DIV
+   since it was last grown, and is idle if it drained less than its minimum
+   size per WINC_SOCK_BUF_TUNE_IDLE_MS since the last search. */
+#ifndef WINC_SOCK_BUF_TUNE_GAIN_DIV
+#define WINC_SOCK_BUF_TUNE_GAIN_DIV        8U
+#endif
+
+#ifndef WINC_SOCK_BUF_TUNE_IDLE_MS
+#define WINC_SOCK_BUF_TUNE_IDLE_MS         1000U
+#endif
+
+#if (WINC_SOCK_BUF_RX_MAX_SZ > 65535) || (WINC_SOCK_BUF_TX_MAX_SZ > 65535)
+#error "Maximum socket buffer size must not exceed 65535"
+#endif
+#endif
+
 /* Byte alignment for slab memory */
 #ifndef WINC_SOCK_SLAB_MEM_ALIGNMENT
 #define WINC_SOCK_SLAB_MEM_ALIGNMENT        4
 #endif
 
+/* Time source used by poll() to implement timeouts, returns milliseconds.
+   Without a time source only zero and infinite poll() timeouts are supported. */
+#ifdef WINC_CONF_TIME_MS_GET
+#define WINC_SOCK_POLL_TIMEOUT_ENABLE
+#endif
+
+/* Semaphore used by poll() to wait for socket state changes. Mapping these
+   onto a counting semaphore allows poll() to block the calling thread, for
+   example with OSAL:
+
+     #define WINC_CONF_SEM_STORAGE(NAME)      OSAL_SEM_HANDLE_TYPE NAME
+     #define WINC_CONF_SEM_CREATE(NAME)       (void)OSAL_SEM_Create(NAME, OSAL_SEM_TYPE_COUNTING, 255, 0)
+     #define WINC_CONF_SEM_DESTROY(NAME)      (void)OSAL_SEM_Delete(NAME)
+     #define WINC_CONF_SEM_WAIT(NAME, MS)     (void)OSAL_SEM_Pend(NAME, MS)
+     #define WINC_CONF_SEM_POST(NAME)         (void)OSAL_SEM_Post(NAME)
+
+   Without a semaphore poll() calls the poll idle callback while waiting. */
+#ifdef WINC_CONF_SEM_WAIT
+#define WINC_SOCK_POLL_SEM_ENABLE
+#endif
+
+/* Wait time passed to WINC_CONF_SEM_WAIT to wait indefinitely. */
+#ifndef WINC_SOCK_POLL_WAIT_FOREVER
+#define WINC_SOCK_POLL_WAIT_FOREVER         UINT32_MAX
+#endif
+
+/* Maximum number of datagrams packed into a single SOCKWRTO command request. */
+#ifndef WINC_SOCK_WRTO_BATCH_MAX
+#define WINC_SOCK_WRTO_BATCH_MAX            4U
+#endif
+
+/* Amount of held stream data which causes a corked socket to be written. */
+#ifndef WINC_SOCK_CORK_FLUSH_SZ
+#define WINC_SOCK_CORK_FLUSH_SZ             MAX_TCP_IPV4_SOCK_PAYLOAD_SZ
+#endif
+
+/* Maximum time in milliseconds stream data is held by a corked socket, this
+   requires WINC_CONF_TIME_MS_GET. */
+#ifdef WINC_SOCK_POLL_TIMEOUT_ENABLE
+#define WINC_SOCK_CORK_TIMEOUT_ENABLE
+#ifndef WINC_SOCK_CORK_TIMEOUT_MS
+#define WINC_SOCK_CORK_TIMEOUT_MS           200U
+#endif
+#endif
+
+/* Maximum constant payload data in flight to the device, see WINC_SockSendConst. */
+#ifndef WINC_SOCK_SEND_CONST_WINDOW_SZ
+#define WINC_SOCK_SEND_CONST_WINDOW_SZ      WINC_SOCK_BUF_TX_SZ
+#endif
+
+/* Number of DNS requests, either in progress or held in the DNS cache. */
+#ifndef WINC_SOCK_DNS_NUM_REQS
+#define WINC_SOCK_DNS_NUM_REQS              4U
+#endif
+
+/* Lifetime in milliseconds of resolved and failed DNS cache entries, this
+   requires WINC_CONF_TIME_MS_GET. The device does not report record TTLs so
+   fixed lifetimes are used, without a time source results are not cached. */
+#ifdef WINC_SOCK_POLL_TIMEOUT_ENABLE
+#define WINC_SOCK_DNS_CACHE_ENABLE
+#ifndef WINC_SOCK_DNS_CACHE_TTL_MS
+#define WINC_SOCK_DNS_CACHE_TTL_MS          60000U
+#endif
+#ifndef WINC_SOCK_DNS_CACHE_NEG_TTL_MS
+#define WINC_SOCK_DNS_CACHE_NEG_TTL_MS      5000U
+#endif
+#endif
+
+/* Number of readiness notification interest sets. */
+#ifndef WINC_SOCK_EPOLL_NUM_SETS
+#define WINC_SOCK_EPOLL_NUM_SETS            2U
+#endif
+
+/* Internal flag marking a one-shot interest which has been reported. */
+#define WINC_SOCK_EPOLL_DISARMED            0x20000000U
+
+/* Socket indexes are stored in 7 bits. */
+#if WINC_SOCK_NUM_SOCKETS > 127U
+#error "WINC_SOCK_NUM_SOCKETS must not exceed 127"
+#endif
+
+/* Number of 32-bit words in a socket bitmap. */
+#define WINC_SOCK_MAP_WORDS                 ((WINC_SOCK_NUM_SOCKETS+31U)/32U)
+
+/* Size of the socket ID hash map, at least twice the number of sockets. */
+#if WINC_SOCK_NUM_SOCKETS <= 8U
+#define WINC_SOCK_ID_MAP_BITS               4U
+#elif WINC_SOCK_NUM_SOCKETS <= 16U
+#define WINC_SOCK_ID_MAP_BITS               5U
+#elif WINC_SOCK_NUM_SOCKETS <= 32U
+#define WINC_SOCK_ID_MAP_BITS               6U
+#elif WINC_SOCK_NUM_SOCKETS <= 64U
+#define WINC_SOCK_ID_MAP_BITS               7U
+#else
+#define WINC_SOCK_ID_MAP_BITS               8U
+#endif
+
+#define WINC_SOCK_ID_MAP_SZ                 (1U << WINC_SOCK_ID_MAP_BITS)
+
+/* Convert a socket context pointer into an index into the socket array. */
+#define WINC_SOCK_PTR_TO_IDX(PTR)           ((unsigned int)((PTR) - &wincSockets[0]))
+
+/* Maximum number of I/O vectors accepted by sendmsg/recvmsg/writev/readv. */
+#ifndef IOV_MAX
+#define IOV_MAX                             16
+#endif
+
+/* Number of 32-bit words in the slab free map, covers the maximum of 127 slabs. */
+#define WINC_SOCK_SLAB_MAP_WORDS            4U
+
+/* Command request buffer size, SZ is sized for 32-bit pointers. Wider
+   pointers, as on a 64-bit host build, enlarge the request state and the
+   header elements of each command. */
+#define WINC_SOCK_CMD_REQ_SZ(SZ, NUM_CMDS)  ((size_t)(SZ) + ((size_t)(NUM_CMDS) * (sizeof(void*) - 4U) * 16U))
+
 /* Convert a socket handle into pointer into the socket array. */
 #define WINC_SOCK_HANDLE_TO_PTR(HANDLE)     (void*)(((uintptr_t)wincSockets & ~INT_MAX) | (HANDLE))
 
 /* Convert a socket array pointer to a handle. */
-#define WINC_SOCK_PTR_TO_HANDLE(PTR)        (((int)(PTR)) & INT_MAX)
+#define WINC_SOCK_PTR_TO_HANDLE(PTR)        ((int)((uintptr_t)(PTR) & INT_MAX))
 
 static size_t sizeof_sockaddr(const struct sockaddr *addr);
 
@@ -76,6 +243,9 @@ static size_t sizeof_sockaddr(const struct sockaddr *addr);
   Remarks:
     Store the location, geometry and index of the slab allocator.
 
+    Free slabs are tracked in a bitmap (bit set = slab free), the index
+    array holds the number of slabs in each allocation at its first slab.
+
  *****************************************************************************/
 
 typedef struct
@@ -85,7 +255,9 @@ typedef struct
 #ifdef WINC_SOCK_SLAB_STATS_ENABLE
     WINC_SOCK_SLAB_STATS        stats;
 #endif
+    uint32_t                    freeMap[WINC_SOCK_SLAB_MAP_WORDS];
     int8_t                      numSlabs;
+    int8_t                      numFree;
     int8_t                      slabIdxs[];
 } WINC_SOCK_SLAB_CTX;
 
@@ -130,6 +302,14 @@ typedef struct
   Remarks:
     Stores data for a socket, with optional UDP packet buffer to track datagrams.
 
+    When buffer sizing is adaptive, tuneDrainLen counts the data drained since
+    the last sizing decision and tuneIdleLen the data drained since the last
+    search for idle buffers. tuneLimited records that the buffer space limited
+    the data in flight, tuneStarved that the application was waiting on the
+    buffer. With a time source tuneTime is the start of the current sizing
+    interval and tuneGrowRate the drain rate, in bytes per second, of the
+    interval which last grew the buffer.
+
  *****************************************************************************/
 
 typedef struct
@@ -141,6 +321,16 @@ typedef struct
     uint16_t                    outstandingDataLen;
     WINC_SOCK_UDP_PKT_BUFFER    *pUdpPktBuffers;
     uint8_t                     *pData;
+#ifdef WINC_SOCK_BUF_AUTOTUNE_ENABLE
+    uint16_t                    tuneDrainLen;
+    uint16_t                    tuneIdleLen;
+    bool                        tuneLimited;
+    bool                        tuneStarved;
+#ifdef WINC_SOCK_POLL_TIMEOUT_ENABLE
+    uint32_t                    tuneTime;
+    uint32_t                    tuneGrowRate;
+#endif
+#endif
 } WINC_SOCK_BUFFER;
 
 /*****************************************************************************
@@ -163,6 +353,9 @@ typedef struct
         bool                    newRecvData:1;
         unsigned int            readMode:2;
         bool                    seqNumUpdateSent:1;
+        bool                    seqNumUpdatePending:1;
+        bool                    corked:1;
+        bool                    sendMore:1;
         bool                    tlsPending;
     };
 
@@ -187,20 +380,107 @@ typedef struct
     size_t                      sendBufSz;
     uint8_t                     numRxPkts;
     uint8_t                     numTxPkts;
+    uint8_t                     numReadsOutstanding;
+    uint8_t                     readWindow;
+    uint16_t                    recvBorrowLen;
+    uint32_t                    corkTime;
+    const uint8_t               *pConstData;
+    size_t                      constLen;
+    size_t                      constSent;
+    size_t                      constAcked;
+    WINC_SOCK_SEND_CONST_CALLBACK pfConstComplete;
+    uintptr_t                   constCompleteCtx;
+    uint8_t                     listenNext;
+    uint8_t                     pendHead;
+    uint8_t                     pendTail;
+    uint8_t                     pendNext;
+    uint8_t                     pendListener;
 
     short                       events;
+    short                       epollPending;
+    uint8_t                     epollSet;
+    uint32_t                    epollEvents;
+    uintptr_t                   epollData;
 
     WINC_SOCK_SLAB_CTX          *pSlabAllocCtx;
 
     WINC_CONF_LOCK_STORAGE(accessMutex);
 } WINC_SOCK_CTX;
 
+/*****************************************************************************
+  Description:
+    Readiness notification interest set.
+
+  Remarks:
+    Sockets are registered by storing the set number in the socket context,
+    readyMap has a bit set for each registered socket which may be ready.
+
+ *****************************************************************************/
+
+typedef struct
+{
+    bool                        inUse;
+    uint8_t                     nextIdx;
+    uint32_t                    readyMap[WINC_SOCK_MAP_WORDS];
+
+    WINC_CONF_LOCK_STORAGE(accessMutex);
+} WINC_SOCK_EPOLL_SET;
+
+/*****************************************************************************
+  Description:
+    Socket wait scan function.
+
+  Parameters:
+    context - Scan arguments provided to sockWaitReady
+
+  Returns:
+    Number of ready items found, zero if none, or -1 on error.
+
+  Remarks:
+    Called by sockWaitReady each time sockets may have changed state.
+
+ *****************************************************************************/
+
+typedef int (*WINC_SOCK_WAIT_SCAN_FP)(uintptr_t context);
+
+/*****************************************************************************
+  Description:
+    poll() scan arguments.
+
+  Remarks:
+    Passed to sockPollScan by poll().
+
+ *****************************************************************************/
+
+typedef struct
+{
+    struct pollfd               *fds;
+    nfds_t                      nfds;
+} WINC_SOCK_POLL_SCAN;
+
+/*****************************************************************************
+  Description:
+    Readiness notification interest set scan arguments.
+
+  Remarks:
+    Passed to sockEpollScan by WINC_SockEpollWait.
+
+ *****************************************************************************/
+
+typedef struct
+{
+    unsigned int                setIdx;
+    WINC_SOCK_EPOLL_EVENT       *pEvents;
+    int                         maxEvents;
+} WINC_SOCK_EPOLL_SCAN;
+
 /*****************************************************************************
   Description:
     DNS request structure.
 
   Remarks:
-    Stores a DNS request.
+    Stores a DNS request, once complete the request remains as a cache
+    entry until it has been fetched and has expired.
 
  *****************************************************************************/
 
@@ -208,15 +488,20 @@ typedef struct
 {
     size_t                      hostNameLen;
     struct addrinfo             *pRes;
+    uint32_t                    expiryTime;
+    WINC_SOCK_DNS_CALLBACK      pfComplete;
+    uintptr_t                   completeCtx;
     uint16_t                    reqStatus;
     uint8_t                     recordType;
+    bool                        fetched;
     uint8_t                     hostName[];
 } WINC_DNS_REQ;
 
 /******************************************************************************/
 
-/* Forward declaration of command response callback handler. */
+/* Forward declaration of command response callback handlers. */
 static void sockCmdRspCallbackHandler(uintptr_t context, WINC_DEVICE_HANDLE devHandle, WINC_CMD_REQ_HANDLE cmdReqHandle, WINC_DEV_CMDREQ_EVENT_TYPE event, uintptr_t eventArg);
+static void sockCmdRspCallbackHandlerSeqUpdate(uintptr_t context, WINC_DEVICE_HANDLE devHandle, WINC_CMD_REQ_HANDLE cmdReqHandle, WINC_DEV_CMDREQ_EVENT_TYPE event, uintptr_t eventArg);
 
 /******************************************************************************/
 
@@ -226,14 +511,36 @@ static WINC_DEVICE_HANDLE           wincDevHandle;
 /* Socket context structure array. */
 static WINC_SOCK_CTX                wincSockets[WINC_SOCK_NUM_SOCKETS];
 
+/* Bitmap of socket contexts in use. */
+static uint32_t                     sockInUseMap[WINC_SOCK_MAP_WORDS];
+
+#ifdef WINC_SOCK_CORK_TIMEOUT_ENABLE
+/* Bitmap of corked socket contexts which may be holding data. */
+static uint32_t                     sockCorkMap[WINC_SOCK_MAP_WORDS];
+#endif
+
+/* Bitmap of socket contexts with a sequence number update still to be sent. */
+static uint32_t                     sockSeqNumMap[WINC_SOCK_MAP_WORDS];
+
+#if defined(WINC_SOCK_BUF_AUTOTUNE_ENABLE) && defined(WINC_SOCK_POLL_TIMEOUT_ENABLE)
+/* Time of the last search for idle socket buffers. */
+static uint32_t                     sockBufTuneIdleTime;
+#endif
+
+/* Socket ID hash map, each entry is a socket index plus one, or zero if empty. */
+static uint8_t                      sockIdMap[WINC_SOCK_ID_MAP_SZ];
+
+/* First listening socket, index plus one, or zero if none. */
+static uint8_t                      sockListenHead;
+
 /* Socket event callback function pointer. */
 static WINC_SOCKET_EVENT_CALLBACK   pfSocketEventCallback;
 
 /* Socket event callback function context to be passed back. */
 static uintptr_t                    socketEventCallbackContext;
 
-/* Current outstanding DNS request pointer. */
-static WINC_DNS_REQ                 *pCurrentDnsRequest;
+/* DNS request table, in progress requests and cache entries. */
+static WINC_DNS_REQ                 *dnsRequests[WINC_SOCK_DNS_NUM_REQS];
 
 /* Pointer to memory slab allocator context. */
 static WINC_SOCK_SLAB_CTX           *pGlobalSlabAllocCtx;
@@ -241,6 +548,26 @@ static WINC_SOCK_SLAB_CTX           *pGlobalSlabAllocCtx;
 /* Copy of socket initialisation data. */
 static WINC_SOCKET_INIT_TYPE        initData;
 
+/* Poll idle callback function pointer. */
+static WINC_SOCKET_POLL_IDLE_CALLBACK pfPollIdleCallback;
+
+/* Poll idle callback function context to be passed back. */
+static uintptr_t                    pollIdleCallbackContext;
+
+/* Readiness notification interest sets. */
+static WINC_SOCK_EPOLL_SET          epollSets[WINC_SOCK_EPOLL_NUM_SETS];
+
+/* Count of socket state changes, used by poll() to detect new events. */
+static volatile uint32_t            pollEventCount;
+
+#ifdef WINC_SOCK_POLL_SEM_ENABLE
+/* Number of threads waiting in poll(). */
+static volatile uint8_t             numPollWaiters;
+
+/* Semaphore signalled when a socket changes state. */
+static WINC_CONF_SEM_STORAGE(pollSemaphore);
+#endif
+
 /*****************************************************************************
   Description:
     Slab memory allocator initialisation.
@@ -260,6 +587,7 @@ static WINC_SOCK_SLAB_CTX* slabInit(size_t slabSize, int8_t numSlabs)
 {
     WINC_SOCK_SLAB_CTX *pSlabAllocCtx;
     size_t ctxIndiciesSize;
+    int8_t i;
 
     if (NULL == initData.pfMemAlloc)
     {
@@ -284,15 +612,19 @@ static WINC_SOCK_SLAB_CTX* slabInit(size_t slabSize, int8_t numSlabs)
         return NULL;
     }
 
-    (void)memset(pSlabAllocCtx, 0xff, ctxIndiciesSize);
+    (void)memset(pSlabAllocCtx, 0, sizeof(WINC_SOCK_SLAB_CTX));
+    (void)memset(pSlabAllocCtx->slabIdxs, 0, (size_t)numSlabs);
 
     pSlabAllocCtx->pRootAddr = &((uint8_t*)pSlabAllocCtx)[ctxIndiciesSize];
     pSlabAllocCtx->slabSize  = slabSize;
     pSlabAllocCtx->numSlabs  = numSlabs;
+    pSlabAllocCtx->numFree   = numSlabs;
 
-#ifdef WINC_SOCK_SLAB_STATS_ENABLE
-    memset(&pSlabAllocCtx->stats, 0, sizeof(WINC_SOCK_SLAB_STATS));
-#endif
+    /* Mark all slabs as free, bits beyond the last slab remain allocated. */
+    for (i=0; i<numSlabs; i++)
+    {
+        pSlabAllocCtx->freeMap[i >> 5] |= (1UL << (i & 31));
+    }
 
     return pSlabAllocCtx;
 }
@@ -319,3676 +651,6865 @@ static int8_t slabCalcNumSlabs(size_t slabSize, size_t size)
 
 /*****************************************************************************
   Description:
-    Allocate memory from the slab allocator.
+    Find the next slab in a given state searching upwards.
 
   Parameters:
     pSlabAllocCtx - Pointer to slab context.
-    size          - Size of memory to allocate
+    slabIdx       - Slab index to start searching from
+    free          - Slab state to search for
 
   Returns:
-    Pointer to allocated slab, or NULL or error.
+    Index of first slab at or above slabIdx in the state requested, or
+    numSlabs if none.
 
   Remarks:
+    Searches a word of the free map at a time.
 
  *****************************************************************************/
 
-static void* slabAlloc(WINC_SOCK_SLAB_CTX *pSlabAllocCtx, size_t size)
+static int8_t slabNextIdx(const WINC_SOCK_SLAB_CTX *pSlabAllocCtx, int8_t slabIdx, bool free)
 {
-    int8_t i;
-    int8_t consecFree;
-    int8_t slabIdx;
-    int8_t reqSlabs;
+    uint32_t word;
+    uint8_t wordIdx;
 
-    if ((NULL == pSlabAllocCtx) || (NULL == pSlabAllocCtx->pRootAddr))
+    if (slabIdx >= pSlabAllocCtx->numSlabs)
     {
-        /* Slab allocator isn't present, use the basic memory allocator. */
-        if (NULL != initData.pfMemAlloc)
-        {
-            return initData.pfMemAlloc(size);
-        }
-
-        return NULL;
+        return pSlabAllocCtx->numSlabs;
     }
 
-    /* Calculate the number of slabs required to hold the allocation. */
-    reqSlabs = slabCalcNumSlabs(pSlabAllocCtx->slabSize, size);
+    wordIdx = (uint8_t)slabIdx >> 5;
+    word    = pSlabAllocCtx->freeMap[wordIdx];
 
-    for (i=0; i<pSlabAllocCtx->numSlabs; i++)
+    if (false == free)
     {
-        /* Search the slab indexes for a free slab. */
-        if (-1 == pSlabAllocCtx->slabIdxs[i])
-        {
-            consecFree = 0;
-            slabIdx    = i;
-
-            /* Continue the search for a consecutive group of slabs. */
-            for (; i<pSlabAllocCtx->numSlabs; i++)
-            {
-                if (-1 == pSlabAllocCtx->slabIdxs[i])
-                {
-                    consecFree++;
-
-                    if (consecFree == reqSlabs)
-                    {
-                        void *p;
-                        int8_t j;
-#ifdef WINC_SOCK_SLAB_STATS_ENABLE
-                        int8_t curUsage;
-#endif
-
-                        /* Write a counting pattern into the slab indexes to reserve them. */
-                        for (j=0; j<consecFree; j++)
-                        {
-                            pSlabAllocCtx->slabIdxs[slabIdx+j] = consecFree-j;
-                        }
+        word = ~word;
+    }
 
-                        /* Calculate pointer to memory within the slabs. */
-                        p = &pSlabAllocCtx->pRootAddr[(size_t)slabIdx * pSlabAllocCtx->slabSize];
+    /* Ignore slabs below the starting index. */
+    word &= ~((1UL << ((uint8_t)slabIdx & 31U)) - 1UL);
 
-                        WINC_TRACE_PRINT("SLAB[+%08x %d (%d %d)]\n", p, slabIdx, size, reqSlabs);
+    while (0U == word)
+    {
+        wordIdx++;
 
-#ifdef WINC_SOCK_SLAB_STATS_ENABLE
-                        pSlabAllocCtx->stats.numAllocs += consecFree;
+        if (wordIdx >= WINC_SOCK_SLAB_MAP_WORDS)
+        {
+            return pSlabAllocCtx->numSlabs;
+        }
 
-                        curUsage = pSlabAllocCtx->stats.numAllocs - pSlabAllocCtx->stats.numFrees;
+        word = pSlabAllocCtx->freeMap[wordIdx];
 
-                        if (curUsage > pSlabAllocCtx->stats.peakUsage)
-                        {
-                            pSlabAllocCtx->stats.peakUsage = curUsage;
-                        }
-#endif
-                        return p;
-                    }
-                }
-                else
-                {
-                    break;
-                }
-            }
+        if (false == free)
+        {
+            word = ~word;
         }
     }
 
-#ifdef WINC_SOCK_SLAB_STATS_ENABLE
-    pSlabAllocCtx->stats.numFailed++;
-#endif
+    slabIdx = (int8_t)((wordIdx << 5) + (uint8_t)__builtin_ctz(word));
 
-    WINC_ERROR_PRINT("error, failed to allocate slab of %d bytes\n", size);
+    if (slabIdx > pSlabAllocCtx->numSlabs)
+    {
+        slabIdx = pSlabAllocCtx->numSlabs;
+    }
 
-    return NULL;
+    return slabIdx;
 }
 
 /*****************************************************************************
   Description:
-    De-allocate memory from the slab allocator.
+    Find the next slab in a given state searching downwards.
 
   Parameters:
     pSlabAllocCtx - Pointer to slab context.
-    p             - Pointer to memory to be freed.
+    slabIdx       - Slab index to start searching from
+    free          - Slab state to search for
 
   Returns:
-    None.
+    Index of first slab at or below slabIdx in the state requested, or -1
+    if none.
 
   Remarks:
+    Searches a word of the free map at a time.
 
  *****************************************************************************/
 
-static void slabFree(WINC_SOCK_SLAB_CTX *pSlabAllocCtx, void *p)
+static int8_t slabPrevIdx(const WINC_SOCK_SLAB_CTX *pSlabAllocCtx, int8_t slabIdx, bool free)
 {
-    int slabIdx;
+    uint32_t word;
+    int8_t wordIdx;
 
-    if (NULL == p)
+    if (slabIdx < 0)
     {
-        return;
+        return -1;
     }
 
-    if ((NULL == pSlabAllocCtx) || (NULL == pSlabAllocCtx->pRootAddr))
-    {
-        /* Slab allocator isn't present, use the basic memory free. */
-        if (NULL != initData.pfMemFree)
-        {
-            initData.pfMemFree(p);
-        }
+    wordIdx = slabIdx >> 5;
+    word    = pSlabAllocCtx->freeMap[wordIdx];
 
-        return;
+    if (false == free)
+    {
+        word = ~word;
     }
 
-    /* Ensure pointer is within the allocators region. */
-    if (((uint8_t*)p < pSlabAllocCtx->pRootAddr) || ((uint8_t*)p >= &pSlabAllocCtx->pRootAddr[(size_t)pSlabAllocCtx->numSlabs * pSlabAllocCtx->slabSize]))
+    /* Ignore slabs above the starting index. */
+    if (((uint8_t)slabIdx & 31U) != 31U)
     {
-        return;
+        word &= ((1UL << (((uint8_t)slabIdx & 31U) + 1U)) - 1UL);
     }
 
-    /* Calculate the slab index. */
-    slabIdx = (((uint8_t*)p - pSlabAllocCtx->pRootAddr) / pSlabAllocCtx->slabSize);
+    while (0U == word)
+    {
+        wordIdx--;
+
+        if (wordIdx < 0)
+        {
+            return -1;
+        }
 
-    WINC_TRACE_PRINT("SLAB[-%08x %d + %d]\n", p, slabIdx, pSlabAllocCtx->slabIdxs[slabIdx]);
+        word = pSlabAllocCtx->freeMap[wordIdx];
 
-#ifdef WINC_SOCK_SLAB_STATS_ENABLE
-    pSlabAllocCtx->stats.numFrees += pSlabAllocCtx->slabIdxs[slabIdx];
-#endif
+        if (false == free)
+        {
+            word = ~word;
+        }
+    }
 
-    /* Use the count in the indexes to determine the length of the original allocation. */
-    (void)memset(&pSlabAllocCtx->slabIdxs[slabIdx], 0xff, (size_t)pSlabAllocCtx->slabIdxs[slabIdx]);
+    return (int8_t)((wordIdx << 5) + (31 - __builtin_clz(word)));
 }
 
 /*****************************************************************************
   Description:
-    Allocator for DNS command requests.
+    Find free slabs for an allocation.
 
   Parameters:
-    size - Size of request to allocate.
+    pSlabAllocCtx - Pointer to slab context.
+    reqSlabs      - Number of slabs required
 
   Returns:
-    Pointer to allocation or NULL for error.
+    Index of the first slab of a free run of reqSlabs slabs, or -1 if none.
 
   Remarks:
+    Single slabs are taken from the bottom of the slab region and runs of
+    slabs from the top.
 
  *****************************************************************************/
 
-static void* dnsAllocRequest(size_t size)
+static int8_t slabFindFree(const WINC_SOCK_SLAB_CTX *pSlabAllocCtx, int8_t reqSlabs)
 {
-    WINC_DNS_REQ *pDnsRequest;
+    int8_t topIdx;
 
-    if (NULL == initData.pfMemAlloc)
+    if ((reqSlabs <= 0) || (reqSlabs > pSlabAllocCtx->numFree))
     {
-        return NULL;
+        return -1;
     }
 
-    /* Allocate memory of request structure in addition to size requested. */
-    pDnsRequest = initData.pfMemAlloc(sizeof(WINC_DNS_REQ) + size + 1U);
+    if (1 == reqSlabs)
+    {
+        topIdx = slabNextIdx(pSlabAllocCtx, 0, true);
 
-    if (NULL != pDnsRequest)
+        return (topIdx < pSlabAllocCtx->numSlabs) ? topIdx : -1;
+    }
+
+    topIdx = pSlabAllocCtx->numSlabs - 1;
+
+    /* Search free runs downwards for one large enough. */
+    while (topIdx >= 0)
     {
-        (void)memset(pDnsRequest, 0, sizeof(WINC_DNS_REQ));
+        int8_t baseIdx;
+
+        topIdx = slabPrevIdx(pSlabAllocCtx, topIdx, true);
 
-        pDnsRequest->reqStatus = 0xFFFFU;
+        if (topIdx < 0)
+        {
+            break;
+        }
+
+        baseIdx = slabPrevIdx(pSlabAllocCtx, topIdx, false) + 1;
+
+        if ((topIdx - baseIdx + 1) >= reqSlabs)
+        {
+            return topIdx - reqSlabs + 1;
+        }
+
+        topIdx = baseIdx - 1;
     }
 
-    return pDnsRequest;
+    return -1;
 }
 
 /*****************************************************************************
   Description:
-    Free DNS command request memory.
+    Allocate memory from the slab allocator.
 
   Parameters:
-    pDnsRequest - Pointer to DNS request.
+    pSlabAllocCtx - Pointer to slab context.
+    size          - Size of memory to allocate
 
   Returns:
-    None.
+    Pointer to allocated slab, or NULL or error.
 
   Remarks:
+    Single slab allocations are taken from the bottom of the slab region
+    and multi-slab allocations from the top, keeping short lived command
+    buffers from fragmenting the space needed by socket buffers.
 
  *****************************************************************************/
 
-static void dnsFreeRequest(WINC_DNS_REQ *pDnsRequest)
+static void* slabAlloc(WINC_SOCK_SLAB_CTX *pSlabAllocCtx, size_t size)
 {
-    struct addrinfo *pRes;
-    struct addrinfo *pNextRes;
-
-    if (NULL == pDnsRequest)
-    {
-        return;
-    }
+    int8_t slabIdx;
+    int8_t reqSlabs;
+    int8_t i;
+    void *p;
+#ifdef WINC_SOCK_SLAB_STATS_ENABLE
+    int8_t curUsage;
+#endif
 
-    /* Check if this is the current global request, remove that if it is. */
-    if (pCurrentDnsRequest == pDnsRequest)
+    if ((NULL == pSlabAllocCtx) || (NULL == pSlabAllocCtx->pRootAddr))
     {
-        pCurrentDnsRequest = NULL;
+        /* Slab allocator isn't present, use the basic memory allocator. */
+        if (NULL != initData.pfMemAlloc)
+        {
+            return initData.pfMemAlloc(size);
+        }
+
+        return NULL;
     }
 
-    if (NULL == initData.pfMemFree)
+    /* Calculate the number of slabs required to hold the allocation. */
+    reqSlabs = slabCalcNumSlabs(pSlabAllocCtx->slabSize, size);
+    slabIdx  = slabFindFree(pSlabAllocCtx, reqSlabs);
+
+    if (slabIdx < 0)
     {
-        return;
+#ifdef WINC_SOCK_SLAB_STATS_ENABLE
+        pSlabAllocCtx->stats.numFailed++;
+
+        if ((reqSlabs > 0) && (reqSlabs <= pSlabAllocCtx->numFree))
+        {
+            pSlabAllocCtx->stats.numFailedFrag++;
+        }
+#endif
+
+        WINC_ERROR_PRINT("error, failed to allocate slab of %u bytes\n", (unsigned int)size);
+
+        return NULL;
     }
 
-    pRes = pDnsRequest->pRes;
+    /* Reserve the slabs and record the allocation length. */
+    for (i=slabIdx; i<(slabIdx+reqSlabs); i++)
+    {
+        pSlabAllocCtx->freeMap[(uint8_t)i >> 5] &= ~(1UL << ((uint8_t)i & 31U));
+    }
 
-    /* Free all memory associated with this request. */
-    while (NULL != pRes)
+    pSlabAllocCtx->slabIdxs[slabIdx] = reqSlabs;
+    pSlabAllocCtx->numFree -= reqSlabs;
+
+    /* Calculate pointer to memory within the slabs. */
+    p = &pSlabAllocCtx->pRootAddr[(size_t)slabIdx * pSlabAllocCtx->slabSize];
+
+    WINC_TRACE_PRINT("SLAB[+%08x %d (%d %d)]\n", p, slabIdx, size, reqSlabs);
+
+#ifdef WINC_SOCK_SLAB_STATS_ENABLE
+    pSlabAllocCtx->stats.numAllocs += reqSlabs;
+
+    curUsage = pSlabAllocCtx->numSlabs - pSlabAllocCtx->numFree;
+
+    if (curUsage > pSlabAllocCtx->stats.peakUsage)
     {
-        pNextRes = pRes->ai_next;
-        initData.pfMemFree(pRes);
-        pRes = pNextRes;
+        pSlabAllocCtx->stats.peakUsage = curUsage;
     }
+#endif
 
-    initData.pfMemFree(pDnsRequest);
+    return p;
 }
 
 /*****************************************************************************
   Description:
-    Write data to socket buffer.
+    De-allocate memory from the slab allocator.
 
   Parameters:
-    pBuffer  - Pointer to socket buffer to write data into
-    pData    - Pointer to new data to write
-    dataLen  - Length of new data
-    pAddr    - Pointer to datagram end point address structure
-    fragment - Flag indicating if write can be fragment or should be contiguous
+    pSlabAllocCtx - Pointer to slab context.
+    p             - Pointer to memory to be freed.
 
   Returns:
-    true or false indicating success or failure.
+    None.
 
   Remarks:
-    In some cases, for UDP datagram it's required that the data is store contiguously.
-    If so a padding write of data is added to the buffer with a blank address to align
-    the write to the start of the buffer memory.
 
  *****************************************************************************/
 
-static bool sockBufferWrite(WINC_SOCK_BUFFER *pBuffer, const uint8_t *pData, size_t dataLen, const SOCKADDR_UNION *pAddr, bool fragment)
+static void slabFree(WINC_SOCK_SLAB_CTX *pSlabAllocCtx, void *p)
 {
-    size_t fragmentLen;
+    int slabIdx;
+    int8_t numSlabs;
+    int i;
 
-    if ((NULL == pBuffer) || (NULL == pData) || (0U == dataLen))
+    if (NULL == p)
     {
-        return false;
+        return;
     }
 
-    /* Determine if this write would fit into the available space. */
-    if (dataLen > (pBuffer->totalSize - pBuffer->length))
+    if ((NULL == pSlabAllocCtx) || (NULL == pSlabAllocCtx->pRootAddr))
     {
-        /* Not enough buffer space available. */
-        return false;
+        /* Slab allocator isn't present, use the basic memory free. */
+        if (NULL != initData.pfMemFree)
+        {
+            initData.pfMemFree(p);
+        }
+
+        return;
     }
 
-    if (NULL != pBuffer->pUdpPktBuffers)
+    /* Ensure pointer is within the allocators region. */
+    if (((uint8_t*)p < pSlabAllocCtx->pRootAddr) || ((uint8_t*)p >= &pSlabAllocCtx->pRootAddr[(size_t)pSlabAllocCtx->numSlabs * pSlabAllocCtx->slabSize]))
     {
-        /* Dealing with UDP datagrams, need to store the destination address with the data. */
+        return;
+    }
 
-        WINC_TRACE_PRINT("PB+ %d %d %d\n", pBuffer->pUdpPktBuffers->pktDepth, pBuffer->pUdpPktBuffers->inIdx, dataLen);
+    /* Calculate the slab index. */
+    slabIdx = (((uint8_t*)p - pSlabAllocCtx->pRootAddr) / pSlabAllocCtx->slabSize);
 
-        if (false == fragment)
-        {
-            /* If not allowed to fragment the data, check there is enough space in the buffer before the end or do we
-                need to wrap the buffer first and fit the data in the beginning, if there is space. */
+    numSlabs = pSlabAllocCtx->slabIdxs[slabIdx];
 
-            /* Only need to consider the case of out <= in, in the other case the space check above would verify if the
-                write can happen. */
-            if (pBuffer->outOffset <= pBuffer->inOffset)
-            {
-                fragmentLen = (pBuffer->totalSize - pBuffer->inOffset);
+    WINC_TRACE_PRINT("SLAB[-%08x %d + %d]\n", p, slabIdx, numSlabs);
 
-                if (dataLen > fragmentLen)
-                {
-                    /* There is not enough space at the end of the buffer to fit the datagram, check if there is space
-                        to wrap the buffer for both the data and the packet buffers. */
-                    if ((dataLen > pBuffer->outOffset) || ((pBuffer->pUdpPktBuffers->pktDepth+2U) >= pBuffer->pUdpPktBuffers->numPkts))
-                    {
-                        /* Not enough packet buffers available. */
-                        return false;
-                    }
+    /* Ignore pointers which are not the start of an allocation. */
+    if (numSlabs <= 0)
+    {
+        return;
+    }
 
-                    WINC_TRACE_PRINT("PB@ %d\n", fragmentLen);
+#ifdef WINC_SOCK_SLAB_STATS_ENABLE
+    pSlabAllocCtx->stats.numFrees += numSlabs;
+#endif
 
-                    /* Create a dummy entry for the fragment to bring the write point back to the buffer start. */
-                    (void)memset(&pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->inIdx].endPt, 0, sizeof(SOCKADDR_UNION));
-                    pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->inIdx].pktLength = (uint16_t)fragmentLen;
-                    pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->inIdx].pktOffset = pBuffer->inOffset;
+    /* Use the length recorded at the first slab to release the allocation. */
+    for (i=slabIdx; i<(slabIdx+numSlabs); i++)
+    {
+        pSlabAllocCtx->freeMap[(unsigned)i >> 5] |= (1UL << ((unsigned)i & 31U));
+    }
 
-                    pBuffer->pUdpPktBuffers->pktDepth++;
-                    pBuffer->pUdpPktBuffers->inIdx++;
+    pSlabAllocCtx->slabIdxs[slabIdx] = 0;
+    pSlabAllocCtx->numFree += numSlabs;
+}
 
-                    if (pBuffer->pUdpPktBuffers->inIdx == pBuffer->pUdpPktBuffers->numPkts)
-                    {
-                        pBuffer->pUdpPktBuffers->inIdx = 0;
-                    }
+#ifdef WINC_SOCK_SLAB_STATS_ENABLE
+/*****************************************************************************
+  Description:
+    Update the fragmentation statistics of a slab allocator.
 
-                    pBuffer->length  += (uint16_t)fragmentLen;
-                    pBuffer->inOffset = 0;
-                }
-            }
-        }
+  Parameters:
+    pSlabAllocCtx - Pointer to slab context.
 
-        /* Check space in packet buffers. */
-        if (pBuffer->pUdpPktBuffers->pktDepth == pBuffer->pUdpPktBuffers->numPkts)
-        {
-            return false;
-        }
+  Returns:
+    None.
 
-        /* Copy in the destination address, if provided, to a packet buffer to track destination and length of the datagram. */
-        if (NULL != pAddr)
-        {
-            (void)memcpy(&pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->inIdx].endPt, pAddr, sizeof(SOCKADDR_UNION));
-        }
-        else
-        {
-            (void)memset(&pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->inIdx].endPt, 0, sizeof(SOCKADDR_UNION));
-        }
-        pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->inIdx].pktLength = (uint16_t)dataLen;
-        pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->inIdx].pktOffset = pBuffer->inOffset;
+  Remarks:
+    Walks the free runs, only called when statistics are requested.
 
-        pBuffer->pUdpPktBuffers->pktDepth++;
-        pBuffer->pUdpPktBuffers->inIdx++;
+ *****************************************************************************/
 
-        if (pBuffer->pUdpPktBuffers->inIdx == pBuffer->pUdpPktBuffers->numPkts)
-        {
-            pBuffer->pUdpPktBuffers->inIdx = 0;
-        }
-    }
+static void slabUpdateFragStats(WINC_SOCK_SLAB_CTX *pSlabAllocCtx)
+{
+    int8_t slabIdx = 0;
 
-    while (dataLen > 0U)
+    pSlabAllocCtx->stats.numFreeRuns    = 0;
+    pSlabAllocCtx->stats.largestFreeRun = 0;
+
+    while (slabIdx < pSlabAllocCtx->numSlabs)
     {
-        /* Copy the data into the buffer, wrapping if need be. */
-        fragmentLen = dataLen;
+        int8_t endIdx;
 
-        if (fragmentLen > (pBuffer->totalSize - pBuffer->inOffset))
+        slabIdx = slabNextIdx(pSlabAllocCtx, slabIdx, true);
+
+        if (slabIdx >= pSlabAllocCtx->numSlabs)
         {
-            fragmentLen = (pBuffer->totalSize - pBuffer->inOffset);
+            break;
         }
 
-        (void)memcpy(&pBuffer->pData[pBuffer->inOffset], pData, fragmentLen);
-
-        pBuffer->length   += (uint16_t)fragmentLen;
-        pBuffer->inOffset += (uint16_t)fragmentLen;
-        dataLen           -= fragmentLen;
+        endIdx = slabNextIdx(pSlabAllocCtx, slabIdx, false);
 
-        pData = pData + fragmentLen;
+        pSlabAllocCtx->stats.numFreeRuns++;
 
-        if (pBuffer->totalSize == pBuffer->inOffset)
+        if ((endIdx - slabIdx) > pSlabAllocCtx->stats.largestFreeRun)
         {
-            pBuffer->inOffset = 0;
+            pSlabAllocCtx->stats.largestFreeRun = endIdx - slabIdx;
         }
-    }
 
-    return true;
+        slabIdx = endIdx;
+    }
 }
+#endif
 
 /*****************************************************************************
   Description:
-    Read data from a socket buffer.
+    Allocator for DNS command requests.
 
   Parameters:
-    pBuffer  - Pointer to socket buffer to read data from
-    pData    - Pointer to buffer to receive data
-    dataLen  - Length of data to read
-    pAddr    - Pointer to datagram end point address structure
-    addrLen  - Length of address structure
+    size - Size of request to allocate.
 
   Returns:
-    Number of bytes read, or -1 for error.
+    Pointer to allocation or NULL for error.
 
   Remarks:
 
  *****************************************************************************/
 
-static ssize_t sockBufferRead(WINC_SOCK_BUFFER *pBuffer, uint8_t *pData, size_t dataLen, void *pAddr, size_t addrLen, bool peek, size_t *pLenRemain)
+static void* dnsAllocRequest(size_t size)
 {
-    ssize_t readData = 0;
-    size_t discardLen = 0;
-    size_t fragmentLen;
-    uint16_t outOffset;
-    uint16_t length;
+    WINC_DNS_REQ *pDnsRequest;
 
-    if (NULL == pBuffer)
+    if (NULL == initData.pfMemAlloc)
     {
-        return -1;
+        return NULL;
     }
 
-    if (NULL == pBuffer->pUdpPktBuffers)
+    /* Allocate memory of request structure in addition to size requested. */
+    pDnsRequest = initData.pfMemAlloc(sizeof(WINC_DNS_REQ) + size + 1U);
+
+    if (NULL != pDnsRequest)
     {
-        /* For TCP sockets, limit the data read to what is available. */
-        if (dataLen > pBuffer->length)
-        {
-            dataLen = pBuffer->length;
-        }
+        (void)memset(pDnsRequest, 0, sizeof(WINC_DNS_REQ));
+
+        pDnsRequest->reqStatus      = 0xFFFFU;
+        pDnsRequest->hostName[size] = 0;
     }
-    else
-    {
-        /* For UDP sockets, find the packet buffer to get the next datagram length. */
-        if (0U == pBuffer->pUdpPktBuffers->pktDepth)
-        {
-            if (NULL != pLenRemain)
-            {
-                *pLenRemain = 0;
-            }
 
-            return 0;
-        }
+    return pDnsRequest;
+}
 
-        if (AF_UNSPEC == pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->outIdx].endPt.sin_family)
-        {
-            /* If the next packet buffer is blank, this is a padding datagram, it and the data length
-                specified by it need to be removed first. */
-            fragmentLen = pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->outIdx].pktLength;
+/*****************************************************************************
+  Description:
+    Free DNS command request memory.
 
-            WINC_TRACE_PRINT("PB# %d %d\n", fragmentLen, pBuffer->pUdpPktBuffers->outIdx);
+  Parameters:
+    pDnsRequest - Pointer to DNS request.
 
-            pBuffer->length    -= (uint16_t)fragmentLen;
-            pBuffer->outOffset  = 0;
+  Returns:
+    None.
 
-            pBuffer->pUdpPktBuffers->pktDepth--;
-            pBuffer->pUdpPktBuffers->outIdx++;
+  Remarks:
 
-            if (pBuffer->pUdpPktBuffers->outIdx == pBuffer->pUdpPktBuffers->numPkts)
-            {
-                pBuffer->pUdpPktBuffers->outIdx = 0;
-            }
+ *****************************************************************************/
 
-            if (0U == pBuffer->pUdpPktBuffers->pktDepth)
-            {
-                return 0;
-            }
-        }
+static void dnsFreeRequest(WINC_DNS_REQ *pDnsRequest)
+{
+    struct addrinfo *pRes;
+    struct addrinfo *pNextRes;
+    unsigned int i;
 
-        /* If an address pointer and length are provided, copy what we can from the packet buffer end point. */
-        if ((NULL != pAddr) && (addrLen > 0U))
-        {
-            (void)memcpy(pAddr, &pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->outIdx], addrLen);
-        }
-
-        if (dataLen > pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->outIdx].pktLength)
-        {
-            /* If the requested length is too much, limit it to the datagram length. */
-            dataLen = pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->outIdx].pktLength;
-        }
-        else
-        {
-            /* If the requested length is less than the datagrams length, the remaining data needs to be discarded. */
-            discardLen = pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->outIdx].pktLength - dataLen;
-        }
-
-        WINC_TRACE_PRINT("PB- %d %d %d\n", pBuffer->pUdpPktBuffers->pktDepth, pBuffer->pUdpPktBuffers->outIdx, pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->outIdx].pktLength);
+    if (NULL == pDnsRequest)
+    {
+        return;
+    }
 
-        if (false == peek)
+    /* Remove the request from the request table. */
+    for (i=0; i<WINC_SOCK_DNS_NUM_REQS; i++)
+    {
+        if (dnsRequests[i] == pDnsRequest)
         {
-            /* Discard the current packet buffer. */
-            pBuffer->pUdpPktBuffers->pktDepth--;
-            pBuffer->pUdpPktBuffers->outIdx++;
-
-            if (pBuffer->pUdpPktBuffers->outIdx == pBuffer->pUdpPktBuffers->numPkts)
-            {
-                pBuffer->pUdpPktBuffers->outIdx = 0;
-            }
+            dnsRequests[i] = NULL;
         }
     }
 
-    outOffset = pBuffer->outOffset;
-    length    = pBuffer->length;
-
-    while (dataLen > 0U)
+    if (NULL == initData.pfMemFree)
     {
-        /* Copy the data to the buffer provided. */
-        fragmentLen = dataLen;
+        return;
+    }
 
-        if (fragmentLen > (pBuffer->totalSize - outOffset))
-        {
-            fragmentLen = (pBuffer->totalSize - outOffset);
-        }
+    pRes = pDnsRequest->pRes;
 
-        if (NULL != pData)
-        {
-            (void)memcpy(pData, &pBuffer->pData[outOffset], fragmentLen);
-            pData = pData + fragmentLen;
-        }
+    /* Free all memory associated with this request. */
+    while (NULL != pRes)
+    {
+        pNextRes = pRes->ai_next;
+        initData.pfMemFree(pRes);
+        pRes = pNextRes;
+    }
 
-        length    -= (uint16_t)fragmentLen;
-        outOffset += (uint16_t)fragmentLen;
+    initData.pfMemFree(pDnsRequest);
+}
 
-        if (outOffset >= pBuffer->totalSize)
-        {
-            outOffset -= pBuffer->totalSize;
-        }
+/*****************************************************************************
+  Description:
+    Free all DNS requests.
 
-        readData += (ssize_t)fragmentLen;
-        dataLen  -= fragmentLen;
-    }
+  Parameters:
+    None.
 
-    /* Discard any data from the datagram that wasn't read. */
-    if (discardLen > 0U)
-    {
-        WINC_TRACE_PRINT("DL %d\n", discardLen);
+  Returns:
+    None.
 
-        outOffset += (uint16_t)discardLen;
-        length    -= (uint16_t)discardLen;
+  Remarks:
 
-        if (outOffset >= pBuffer->totalSize)
-        {
-            outOffset -= pBuffer->totalSize;
-        }
-    }
+ *****************************************************************************/
 
-    if (false == peek)
-    {
-        pBuffer->outOffset = outOffset;
-        pBuffer->length    = length;
-    }
+static void dnsFreeAllRequests(void)
+{
+    unsigned int i;
 
-    if (NULL != pLenRemain)
+    for (i=0; i<WINC_SOCK_DNS_NUM_REQS; i++)
     {
-        if (NULL == pBuffer->pUdpPktBuffers)
-        {
-            *pLenRemain = pBuffer->length;
-        }
-        else
-        {
-            *pLenRemain = discardLen;
-        }
+        dnsFreeRequest(dnsRequests[i]);
     }
-
-    return readData;
 }
 
 /*****************************************************************************
   Description:
-    Find a free socket context.
+    Find a DNS request by host name.
 
   Parameters:
-    None.
+    pHostName   - Pointer to host name.
+    hostNameLen - Length of host name.
+    recordType  - Record type to match, or -1 to match any record type.
 
   Returns:
-    Pointer to free socket context or NULL for error.
+    Pointer to request or NULL if not found.
 
   Remarks:
+    A request still in progress is returned in preference to a cache entry.
 
  *****************************************************************************/
 
-static WINC_SOCK_CTX* sockFindFreeSocket(void)
+static WINC_DNS_REQ* dnsFindRequest(const uint8_t *pHostName, size_t hostNameLen, int recordType)
 {
-    int i;
+    WINC_DNS_REQ *pFoundRequest = NULL;
+    unsigned int i;
 
-    for (i=0; i<WINC_SOCK_NUM_SOCKETS; i++)
+    for (i=0; i<WINC_SOCK_DNS_NUM_REQS; i++)
     {
-        if (false == wincSockets[i].inUse)
+        WINC_DNS_REQ *pDnsRequest = dnsRequests[i];
+
+        if (NULL == pDnsRequest)
+        {
+            continue;
+        }
+
+        if ((hostNameLen != pDnsRequest->hostNameLen) || (0 != memcmp(pHostName, pDnsRequest->hostName, hostNameLen)))
+        {
+            continue;
+        }
+
+        if ((recordType >= 0) && ((uint8_t)recordType != pDnsRequest->recordType))
+        {
+            continue;
+        }
+
+        if (0xFFFFU == pDnsRequest->reqStatus)
+        {
+            return pDnsRequest;
+        }
+
+        if (NULL == pFoundRequest)
         {
-            (void)memset(&wincSockets[i], 0, sizeof(WINC_SOCK_CTX));
-            return &wincSockets[i];
+            pFoundRequest = pDnsRequest;
         }
     }
 
-    return NULL;
+    return pFoundRequest;
 }
 
 /*****************************************************************************
   Description:
-    Creates a new socket context.
+    Check if a completed DNS request has expired.
 
   Parameters:
-    pSockCtx - Pointer to socket context to create.
-    type     - Type of socket.
-    sockId   - ID of socket, zero if not known yet.
+    pDnsRequest - Pointer to DNS request.
 
   Returns:
-    true or false.
+    true if expired, false if the request may be used as a cache entry.
 
   Remarks:
+    Without a DNS cache all requests are considered expired.
 
  *****************************************************************************/
 
-static bool sockCreateSocket(WINC_SOCK_CTX *pSockCtx, uint8_t type, uint16_t sockId)
+static bool dnsRequestExpired(const WINC_DNS_REQ *pDnsRequest)
 {
-#if WINC_SOCK_SLAB_ALLOC_MODE == 2
-    int8_t numSlabs;
+#ifdef WINC_SOCK_DNS_CACHE_ENABLE
+    return ((int32_t)(WINC_CONF_TIME_MS_GET() - pDnsRequest->expiryTime) >= 0) ? true : false;
+#else
+    (void)pDnsRequest;
+
+    return true;
 #endif
+}
 
-    if (NULL == pSockCtx)
-    {
-        return false;
-    }
+/*****************************************************************************
+  Description:
+    Check if a completed DNS request can still be returned.
 
-    WINC_CONF_LOCK_CREATE(&pSockCtx->accessMutex);
+  Parameters:
+    pDnsRequest - Pointer to DNS request.
 
-    pSockCtx->inUse     = true;
-    pSockCtx->type      = type;
-    pSockCtx->sockId    = sockId;
-    pSockCtx->recvBufSz = WINC_SOCK_BUF_RX_SZ;
-    pSockCtx->sendBufSz = WINC_SOCK_BUF_TX_SZ;
-    pSockCtx->numRxPkts = WINC_SOCK_BUF_RX_PKT_BUF_NUM;
-    pSockCtx->numTxPkts = WINC_SOCK_BUF_TX_PKT_BUF_NUM;
+  Returns:
+    true if the result can be returned by getaddrinfo(), otherwise false.
 
-#if WINC_SOCK_SLAB_ALLOC_MODE == 1
-    pSockCtx->pSlabAllocCtx = pGlobalSlabAllocCtx;
-#endif
-#if WINC_SOCK_SLAB_ALLOC_MODE == 2
-    numSlabs = slabCalcNumSlabs(initData.slabSize, pSockCtx->recvBufSz) +
-               slabCalcNumSlabs(initData.slabSize, pSockCtx->sendBufSz);
+  Remarks:
+    Results held as cache entries can be returned until they expire, whether
+    or not they have been fetched. Results which are not cached, such as
+    timeouts or any result without a DNS cache, are returned once.
 
-    if (SOCK_DGRAM == type)
+ *****************************************************************************/
+
+static bool dnsRequestValid(const WINC_DNS_REQ *pDnsRequest)
+{
+    if (false == dnsRequestExpired(pDnsRequest))
     {
-        numSlabs +=
-            slabCalcNumSlabs(initData.slabSize, sizeof(WINC_SOCK_UDP_PKT_BUFFER) + (sizeof(WINC_SOCK_UDP_PKT) * pSockCtx->numRxPkts)) +
-            slabCalcNumSlabs(initData.slabSize, sizeof(WINC_SOCK_UDP_PKT_BUFFER) + (sizeof(WINC_SOCK_UDP_PKT) * pSockCtx->numTxPkts));
+        return true;
     }
 
-    pSockCtx->pSlabAllocCtx = slabInit(initData.slabSize, numSlabs);
-#endif
-    if (NULL == pSockCtx->pSlabAllocCtx)
+#ifdef WINC_SOCK_DNS_CACHE_ENABLE
+    if ((WINC_STATUS_OK == pDnsRequest->reqStatus) || (WINC_STATUS_DNS_ERROR == pDnsRequest->reqStatus))
     {
         return false;
     }
+#endif
 
-    return true;
+    return (false == pDnsRequest->fetched) ? true : false;
 }
 
 /*****************************************************************************
   Description:
-    Free the use of a socket context.
+    Find a free entry in the DNS request table.
 
   Parameters:
-    pSockCtx - Pointer to socket context to release.
+    None.
 
   Returns:
-    None.
+    Pointer to free table entry or NULL if none available.
 
   Remarks:
+    If the table is full a completed request which can no longer be
+    returned is evicted, otherwise one already fetched with the earliest
+    expiry time. Requests in progress and results not yet fetched are never
+    evicted, the caller must try again later.
 
  *****************************************************************************/
 
-static void sockDestroySocket(WINC_SOCK_CTX *pSockCtx)
+static WINC_DNS_REQ** dnsFindFreeRequest(void)
 {
-    if (NULL == pSockCtx)
-    {
-        return;
-    }
+    WINC_DNS_REQ **ppEvictRequest = NULL;
+    unsigned int i;
 
-    if (false == pSockCtx->inUse)
+    for (i=0; i<WINC_SOCK_DNS_NUM_REQS; i++)
     {
-        return;
-    }
+        WINC_DNS_REQ *pDnsRequest = dnsRequests[i];
 
-    /* Release any allocated buffer. */
-    slabFree(pSockCtx->pSlabAllocCtx, pSockCtx->recvBuffer.pData);
-    slabFree(pSockCtx->pSlabAllocCtx, pSockCtx->sendBuffer.pData);
-    slabFree(pSockCtx->pSlabAllocCtx, pSockCtx->recvBuffer.pUdpPktBuffers);
-    slabFree(pSockCtx->pSlabAllocCtx, pSockCtx->sendBuffer.pUdpPktBuffers);
+        if (NULL == pDnsRequest)
+        {
+            return &dnsRequests[i];
+        }
 
-#if WINC_SOCK_SLAB_ALLOC_MODE == 2
-    if (NULL != initData.pfMemFree)
-    {
-        initData.pfMemFree(pSockCtx->pSlabAllocCtx);
+        if (0xFFFFU == pDnsRequest->reqStatus)
+        {
+            continue;
+        }
+
+        if (false == dnsRequestValid(pDnsRequest))
+        {
+            /* Entry is dead, use it without looking further. */
+            ppEvictRequest = &dnsRequests[i];
+            break;
+        }
+
+        if (false == pDnsRequest->fetched)
+        {
+            continue;
+        }
+
+        if ((NULL == ppEvictRequest) || ((int32_t)(pDnsRequest->expiryTime - (*ppEvictRequest)->expiryTime) < 0))
+        {
+            ppEvictRequest = &dnsRequests[i];
+        }
     }
-#endif
 
-    WINC_CONF_LOCK_DESTROY(&pSockCtx->accessMutex);
+    if (NULL != ppEvictRequest)
+    {
+        dnsFreeRequest(*ppEvictRequest);
+        *ppEvictRequest = NULL;
+    }
 
-    (void)memset(pSockCtx, 0, sizeof(WINC_SOCK_CTX));
+    return ppEvictRequest;
 }
 
 /*****************************************************************************
   Description:
-    Lock access to a socket context.
+    Complete a DNS request.
 
   Parameters:
-    pSockCtx - Pointer to socket context to lock.
+    pDnsRequest - Pointer to DNS request.
+    reqStatus   - Request status.
 
   Returns:
     None.
 
   Remarks:
+    Successful results are cached for WINC_SOCK_DNS_CACHE_TTL_MS, names
+    which do not resolve for WINC_SOCK_DNS_CACHE_NEG_TTL_MS. Other errors,
+    such as timeouts, are not cached.
 
  *****************************************************************************/
 
-static bool sockLockSocket(WINC_SOCK_CTX *pSockCtx)
+static void dnsRequestComplete(WINC_DNS_REQ *pDnsRequest, uint16_t reqStatus)
 {
-    if (NULL == pSockCtx)
+    WINC_SOCK_DNS_CALLBACK pfComplete = pDnsRequest->pfComplete;
+
+    pDnsRequest->reqStatus  = reqStatus;
+    pDnsRequest->pfComplete = NULL;
+
+#ifdef WINC_SOCK_DNS_CACHE_ENABLE
+    pDnsRequest->expiryTime = WINC_CONF_TIME_MS_GET();
+
+    if (WINC_STATUS_OK == reqStatus)
     {
-        return false;
+        pDnsRequest->expiryTime += WINC_SOCK_DNS_CACHE_TTL_MS;
     }
-
-    if (false == pSockCtx->inUse)
+    else if (WINC_STATUS_DNS_ERROR == reqStatus)
     {
-        return false;
+        pDnsRequest->expiryTime += WINC_SOCK_DNS_CACHE_NEG_TTL_MS;
     }
-
-    if (false == WINC_CONF_LOCK_ENTER(&pSockCtx->accessMutex))
+    else
     {
-        return false;
+        /* Do nothing. */
     }
+#endif
 
-    return true;
+    if (NULL != pfComplete)
+    {
+        pfComplete(pDnsRequest->completeCtx, (const char*)pDnsRequest->hostName, (WINC_STATUS_OK == reqStatus) ? WINC_SOCKET_STATUS_OK : WINC_SOCKET_STATUS_ERROR);
+    }
 }
 
 /*****************************************************************************
   Description:
-    Unlock access to a socket context.
+    Copy a DNS result list.
 
   Parameters:
-    pSockCtx - Pointer to socket context to lock.
+    pRes - Pointer to result list to copy.
 
   Returns:
-    None.
+    Pointer to copy of result list or NULL for error.
 
   Remarks:
 
  *****************************************************************************/
 
-static void sockUnlockSocket(WINC_SOCK_CTX *pSockCtx)
+static struct addrinfo* dnsCopyResult(const struct addrinfo *pRes)
 {
-    if (NULL == pSockCtx)
-    {
-        return;
-    }
+    struct addrinfo *pResCopy = NULL;
+    struct addrinfo **ppNext = &pResCopy;
 
-    if (false == pSockCtx->inUse)
+    while (NULL != pRes)
     {
-        return;
+        *ppNext = initData.pfMemAlloc(sizeof(struct addrinfo) + sizeof(SOCKADDR_UNION));
+
+        if (NULL == *ppNext)
+        {
+            WINC_SOCK_NS(freeaddrinfo)(pResCopy);
+            return NULL;
+        }
+
+        (void)memcpy(*ppNext, pRes, sizeof(struct addrinfo) + sizeof(SOCKADDR_UNION));
+
+        (*ppNext)->ai_addr = (struct sockaddr*)&(*ppNext)[1];
+        (*ppNext)->ai_next = NULL;
+
+        ppNext = &(*ppNext)->ai_next;
+        pRes   = pRes->ai_next;
     }
 
-    WINC_CONF_LOCK_LEAVE(&pSockCtx->accessMutex);
+    return pResCopy;
 }
 
 /*****************************************************************************
   Description:
-    Allocate (or re-allocate) send and receive socket buffers.
+    Copy data between a flat buffer and an I/O vector list.
 
   Parameters:
-    pSockCtx - Pointer to socket context
+    pIov       - Pointer to I/O vector list
+    pIovIdx    - Pointer to current I/O vector index, updated
+    pIovOffset - Pointer to offset within current I/O vector, updated
+    pData      - Pointer to flat buffer
+    dataLen    - Length of data to copy
+    toIov      - Flag indicating copy direction, true to copy into the I/O vectors
 
   Returns:
-    true or false indicating success or failure.
+    None.
 
   Remarks:
+    The caller must ensure the I/O vectors hold at least dataLen bytes.
 
  *****************************************************************************/
 
-static bool sockAllocSocketBuffers(WINC_SOCK_CTX *pSockCtx)
+static void sockIovCopy(const struct iovec *pIov, int *pIovIdx, size_t *pIovOffset, uint8_t *pData, size_t dataLen, bool toIov)
 {
-    if (NULL == pSockCtx)
-    {
-        return false;
-    }
-
-    /* Free receive data buffer if already allocated. */
-    if (NULL != pSockCtx->recvBuffer.pData)
-    {
-        slabFree(pSockCtx->pSlabAllocCtx, pSockCtx->recvBuffer.pData);
-    }
-
-    (void)memset(&pSockCtx->recvBuffer, 0, sizeof(WINC_SOCK_BUFFER));
-
-    /* Free send data buffer if already allocated. */
-    if (NULL != pSockCtx->sendBuffer.pData)
-    {
-        slabFree(pSockCtx->pSlabAllocCtx, pSockCtx->sendBuffer.pData);
-    }
-
-    (void)memset(&pSockCtx->sendBuffer, 0, sizeof(WINC_SOCK_BUFFER));
-
-    /* Allocate new receive buffer. */
-    if (pSockCtx->recvBufSz > 0U)
-    {
-        pSockCtx->recvBuffer.pData = slabAlloc(pSockCtx->pSlabAllocCtx, pSockCtx->recvBufSz);
-
-        if (NULL != pSockCtx->recvBuffer.pData)
-        {
-            pSockCtx->recvBuffer.totalSize = (uint16_t)pSockCtx->recvBufSz;
-        }
-        else
-        {
-            WINC_ERROR_PRINT("error: failed to allocate recv buffer\n");
-            return false;
-        }
-    }
-
-    /* Allocate new send buffer. */
-    if (pSockCtx->sendBufSz > 0U)
+    while (dataLen > 0U)
     {
-        pSockCtx->sendBuffer.pData = slabAlloc(pSockCtx->pSlabAllocCtx, pSockCtx->sendBufSz);
-
-        if (NULL != pSockCtx->sendBuffer.pData)
-        {
-            pSockCtx->sendBuffer.totalSize = (uint16_t)pSockCtx->sendBufSz;
-        }
-        else
-        {
-            WINC_ERROR_PRINT("error: failed to allocate send buffer\n");
-            return false;
-        }
-    }
+        const struct iovec *pCurIov = &pIov[*pIovIdx];
+        size_t fragmentLen;
 
-    if (SOCK_DGRAM == pSockCtx->type)
-    {
-        /* Free receive packet buffers is already allocated. */
-        if (NULL != pSockCtx->recvBuffer.pUdpPktBuffers)
-        {
-            slabFree(pSockCtx->pSlabAllocCtx, pSockCtx->recvBuffer.pUdpPktBuffers);
-            pSockCtx->recvBuffer.pUdpPktBuffers = NULL;
-        }
+        fragmentLen = pCurIov->iov_len - *pIovOffset;
 
-        /* Free send packet buffers is already allocated. */
-        if (NULL != pSockCtx->sendBuffer.pUdpPktBuffers)
+        if (fragmentLen > dataLen)
         {
-            slabFree(pSockCtx->pSlabAllocCtx, pSockCtx->sendBuffer.pUdpPktBuffers);
-            pSockCtx->sendBuffer.pUdpPktBuffers = NULL;
+            fragmentLen = dataLen;
         }
 
-        if (pSockCtx->numRxPkts > 0U)
+        if (fragmentLen > 0U)
         {
-            /* Allocate new receive packet buffers. */
-            pSockCtx->recvBuffer.pUdpPktBuffers = slabAlloc(pSockCtx->pSlabAllocCtx, sizeof(WINC_SOCK_UDP_PKT_BUFFER) + (sizeof(WINC_SOCK_UDP_PKT) * pSockCtx->numRxPkts));
-
-            if (NULL == pSockCtx->recvBuffer.pUdpPktBuffers)
+            if (true == toIov)
             {
-                WINC_ERROR_PRINT("error: failed to allocate recv packet buffer\n");
-                return false;
+                (void)memcpy(&((uint8_t*)pCurIov->iov_base)[*pIovOffset], pData, fragmentLen);
             }
-
-            (void)memset(pSockCtx->recvBuffer.pUdpPktBuffers, 0, sizeof(WINC_SOCK_UDP_PKT_BUFFER));
-
-            pSockCtx->recvBuffer.pUdpPktBuffers->numPkts = pSockCtx->numRxPkts;
-        }
-
-        if (pSockCtx->numTxPkts > 0U)
-        {
-            /* Allocate new send packet buffers. */
-            pSockCtx->sendBuffer.pUdpPktBuffers = slabAlloc(pSockCtx->pSlabAllocCtx, sizeof(WINC_SOCK_UDP_PKT_BUFFER) + (sizeof(WINC_SOCK_UDP_PKT) * pSockCtx->numTxPkts));
-
-            if (NULL == pSockCtx->sendBuffer.pUdpPktBuffers)
+            else
             {
-                WINC_ERROR_PRINT("error: failed to allocate send buffer\n");
-                return false;
+                (void)memcpy(pData, &((const uint8_t*)pCurIov->iov_base)[*pIovOffset], fragmentLen);
             }
+        }
 
-            (void)memset(pSockCtx->sendBuffer.pUdpPktBuffers, 0, sizeof(WINC_SOCK_UDP_PKT_BUFFER));
+        pData       += fragmentLen;
+        dataLen     -= fragmentLen;
+        *pIovOffset += fragmentLen;
 
-            pSockCtx->sendBuffer.pUdpPktBuffers->numPkts = pSockCtx->numTxPkts;
+        if (*pIovOffset == pCurIov->iov_len)
+        {
+            (*pIovIdx)++;
+            *pIovOffset = 0;
         }
-
-        return true;
     }
-
-    return true;
 }
 
 /*****************************************************************************
   Description:
-    Find socket context by it's ID.
+    Calculate the total length of an I/O vector list.
 
   Parameters:
-    sockId - Socket ID to find
+    pIov    - Pointer to I/O vector list
+    iovCnt  - Number of I/O vectors
+    pLength - Pointer to receive total length
 
   Returns:
-    Pointer to socket context or NULL for error/not found.
+    true or false indicating success or failure.
 
   Remarks:
+    Fails if the list is invalid or the total length overflows.
 
  *****************************************************************************/
 
-static WINC_SOCK_CTX* sockFindByID(uint16_t sockId)
+static bool sockIovLength(const struct iovec *pIov, int iovCnt, size_t *pLength)
 {
+    size_t totalLen = 0;
     int i;
 
-    for (i=0; i<WINC_SOCK_NUM_SOCKETS; i++)
+    if ((iovCnt < 0) || (iovCnt > IOV_MAX) || ((NULL == pIov) && (iovCnt > 0)))
+    {
+        return false;
+    }
+
+    for (i=0; i<iovCnt; i++)
     {
-        if ((true == wincSockets[i].inUse) && (sockId == wincSockets[i].sockId))
+        if ((NULL == pIov[i].iov_base) && (pIov[i].iov_len > 0U))
         {
-            return &wincSockets[i];
+            return false;
+        }
+
+        if ((totalLen + pIov[i].iov_len) < totalLen)
+        {
+            return false;
         }
+
+        totalLen += pIov[i].iov_len;
     }
 
-    return NULL;
+    *pLength = totalLen;
+
+    return true;
 }
 
 /*****************************************************************************
   Description:
-    Find the listening socket associated with the specified socket context.
+    Write data to socket buffer from an I/O vector list.
 
   Parameters:
-    pSockCtx - Pointer to socket context
+    pBuffer  - Pointer to socket buffer to write data into
+    pIov     - Pointer to I/O vector list holding the new data
+    dataLen  - Total length of new data
+    pAddr    - Pointer to datagram end point address structure
+    fragment - Flag indicating if write can be fragment or should be contiguous
 
   Returns:
-    Pointer to socket context or NULL for error/not found
+    true or false indicating success or failure.
 
   Remarks:
+    In some cases, for UDP datagram it's required that the data is store contiguously.
+    If so a padding write of data is added to the buffer with a blank address to align
+    the write to the start of the buffer memory.
 
  *****************************************************************************/
 
-static WINC_SOCK_CTX* sockFindListeningSocket(WINC_SOCK_CTX *pSockCtx)
+static bool sockBufferWritev(WINC_SOCK_BUFFER *pBuffer, const struct iovec *pIov, size_t dataLen, const SOCKADDR_UNION *pAddr, bool fragment)
 {
-    int i;
+    size_t fragmentLen;
+    int iovIdx = 0;
+    size_t iovOffset = 0;
 
-    if (NULL == pSockCtx)
+    if ((NULL == pBuffer) || (NULL == pIov) || (0U == dataLen))
     {
-        return NULL;
+        return false;
     }
 
-    /* The socket must be in use and be either stream or TLS based. */
-    if ((false == pSockCtx->inUse) || ((SOCK_STREAM != pSockCtx->type) && (IPPROTO_TLS != pSockCtx->protocol)))
+    /* Determine if this write would fit into the available space. */
+    if (dataLen > (pBuffer->totalSize - pBuffer->length))
     {
-        return NULL;
+        /* Not enough buffer space available. */
+        return false;
     }
 
-    for (i=0; i<WINC_SOCK_NUM_SOCKETS; i++)
+    if (NULL != pBuffer->pUdpPktBuffers)
     {
-        if (&wincSockets[i] == pSockCtx)
-        {
-            continue;
-        }
+        /* Dealing with UDP datagrams, need to store the destination address with the data. */
 
-        /* Match on a stream/TLS socket which is in use, listening sharing the same source port. */
-        if ((true == wincSockets[i].inUse) && (true == wincSockets[i].listening) && (pSockCtx->type == wincSockets[i].type) && (pSockCtx->localEndPt.sin_port == wincSockets[i].localEndPt.sin_port))
+        WINC_TRACE_PRINT("PB+ %d %d %d\n", pBuffer->pUdpPktBuffers->pktDepth, pBuffer->pUdpPktBuffers->inIdx, dataLen);
+
+        if (false == fragment)
         {
-            return &wincSockets[i];
-        }
-    }
+            if (0U == pBuffer->length)
+            {
+                /* The buffer is empty, restart at the buffer start to leave the most contiguous space. */
+                pBuffer->inOffset  = 0;
+                pBuffer->outOffset = 0;
+            }
 
-    return NULL;
-}
+            /* If not allowed to fragment the data, check there is enough space in the buffer before the end or do we
+                need to wrap the buffer first and fit the data in the beginning, if there is space. */
 
-/*****************************************************************************
-  Description:
-    Find a socket in the pending state.
+            /* Only need to consider the case of out <= in, in the other case the space check above would verify if the
+                write can happen. */
+            if (pBuffer->outOffset <= pBuffer->inOffset)
+            {
+                fragmentLen = (pBuffer->totalSize - pBuffer->inOffset);
 
-  Parameters:
-    pSockCtx - Pointer to socket context
+                if (dataLen > fragmentLen)
+                {
+                    /* There is not enough space at the end of the buffer to fit the datagram, check if there is space
+                        to wrap the buffer for both the data and the packet buffers. */
+                    if ((dataLen > pBuffer->outOffset) || ((pBuffer->pUdpPktBuffers->pktDepth+2U) >= pBuffer->pUdpPktBuffers->numPkts))
+                    {
+                        /* Not enough packet buffers available. */
+                        return false;
+                    }
 
-  Returns:
-    Pointer to socket context or NULL for error/not found.
+                    WINC_TRACE_PRINT("PB@ %d\n", fragmentLen);
 
-  Remarks:
+                    /* Create a dummy entry for the fragment to bring the write point back to the buffer start. */
+                    (void)memset(&pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->inIdx].endPt, 0, sizeof(SOCKADDR_UNION));
+                    pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->inIdx].pktLength = (uint16_t)fragmentLen;
+                    pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->inIdx].pktOffset = pBuffer->inOffset;
 
- *****************************************************************************/
+                    pBuffer->pUdpPktBuffers->pktDepth++;
+                    pBuffer->pUdpPktBuffers->inIdx++;
 
-static WINC_SOCK_CTX* sockFindPendingSocket(WINC_SOCK_CTX *pSockCtx)
-{
-    int i;
+                    if (pBuffer->pUdpPktBuffers->inIdx == pBuffer->pUdpPktBuffers->numPkts)
+                    {
+                        pBuffer->pUdpPktBuffers->inIdx = 0;
+                    }
 
-    if (NULL == pSockCtx)
-    {
-        return NULL;
-    }
+                    pBuffer->length  += (uint16_t)fragmentLen;
+                    pBuffer->inOffset = 0;
+                }
+            }
+        }
 
-    /* Socket must be either stream or TLS based, in use and listening. */
-    if ((false == pSockCtx->inUse) || ((SOCK_STREAM != pSockCtx->type) && (IPPROTO_TLS != pSockCtx->protocol)) || (false == pSockCtx->listening))
-    {
-        return NULL;
+        /* Check space in packet buffers. */
+        if (pBuffer->pUdpPktBuffers->pktDepth == pBuffer->pUdpPktBuffers->numPkts)
+        {
+            return false;
+        }
+
+        /* Copy in the destination address, if provided, to a packet buffer to track destination and length of the datagram. */
+        if (NULL != pAddr)
+        {
+            (void)memcpy(&pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->inIdx].endPt, pAddr, sizeof(SOCKADDR_UNION));
+        }
+        else
+        {
+            (void)memset(&pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->inIdx].endPt, 0, sizeof(SOCKADDR_UNION));
+        }
+        pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->inIdx].pktLength = (uint16_t)dataLen;
+        pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->inIdx].pktOffset = pBuffer->inOffset;
+
+        pBuffer->pUdpPktBuffers->pktDepth++;
+        pBuffer->pUdpPktBuffers->inIdx++;
+
+        if (pBuffer->pUdpPktBuffers->inIdx == pBuffer->pUdpPktBuffers->numPkts)
+        {
+            pBuffer->pUdpPktBuffers->inIdx = 0;
+        }
     }
 
-    for (i=0; i<WINC_SOCK_NUM_SOCKETS; i++)
+    while (dataLen > 0U)
     {
-        if (&wincSockets[i] == pSockCtx)
+        /* Copy the data into the buffer, wrapping if need be. */
+        fragmentLen = dataLen;
+
+        if (fragmentLen > (pBuffer->totalSize - pBuffer->inOffset))
         {
-            continue;
+            fragmentLen = (pBuffer->totalSize - pBuffer->inOffset);
         }
 
-        /* Match on stream/TLS socket, in use sharing the same source port but hasn't yet accepted the connection. */
-        if ((true == wincSockets[i].inUse) && (false == wincSockets[i].accepted) && (pSockCtx->type == wincSockets[i].type) && (pSockCtx->localEndPt.sin_port == wincSockets[i].localEndPt.sin_port))
+        sockIovCopy(pIov, &iovIdx, &iovOffset, &pBuffer->pData[pBuffer->inOffset], fragmentLen, false);
+
+        pBuffer->length   += (uint16_t)fragmentLen;
+        pBuffer->inOffset += (uint16_t)fragmentLen;
+        dataLen           -= fragmentLen;
+
+        if (pBuffer->totalSize == pBuffer->inOffset)
         {
-            return &wincSockets[i];
+            pBuffer->inOffset = 0;
         }
     }
 
-    return NULL;
+    return true;
 }
 
 /*****************************************************************************
   Description:
-    Add async mode SOCKC commands to command request.
+    Determine the contiguous space available in a socket buffer.
 
   Parameters:
-    cmdReqHandle - Command request handle
-    pSockCtx     - Pointer to socket context
+    pBuffer - Pointer to socket buffer
 
   Returns:
-    true or false indicating success or failure.
+    Length of the largest contiguous write which can be made to the buffer.
 
   Remarks:
+    This is the largest datagram sockBufferWritev can store without fragmenting.
 
  *****************************************************************************/
 
-static bool sockAsyncModeConf(WINC_CMD_REQ_HANDLE cmdReqHandle, const WINC_SOCK_CTX *pSockCtx)
+static size_t sockBufferContiguousSpace(const WINC_SOCK_BUFFER *pBuffer)
 {
-    uint16_t asyncWinSize  = 0;
-    uint16_t asyncMaxFrmSz = 0;
+    size_t endSpace;
 
-    if ((WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle) || (NULL == pSockCtx))
+    if (0U == pBuffer->length)
     {
-        return false;
+        return pBuffer->totalSize;
     }
 
-    if (WINC_SOCKET_ASYNC_MODE_OFF != (WINC_SOCKET_ASYNC_MODE_TYPE)pSockCtx->readMode)
+    if (pBuffer->inOffset < pBuffer->outOffset)
     {
-        if (WINC_SOCKET_ASYNC_MODE_ACKED == (WINC_SOCKET_ASYNC_MODE_TYPE)pSockCtx->readMode)
-        {
-            asyncWinSize = pSockCtx->recvBufSz;
-        }
+        return (size_t)(pBuffer->outOffset - pBuffer->inOffset);
+    }
 
-        if (SOCK_STREAM == pSockCtx->type)
-        {
-            asyncMaxFrmSz = (3*512)-38;
-        }
-        else
-        {
-            if (AF_INET == pSockCtx->domain)
-            {
-                asyncMaxFrmSz = (3*512)-46;
-            }
-            else if (AF_INET6 == pSockCtx->domain)
-            {
-                asyncMaxFrmSz = (3*512)-58;
-            }
-            else
-            {
-                /* Do nothing. */
-            }
-        }
+    if (pBuffer->inOffset == pBuffer->outOffset)
+    {
+        /* Buffer is full. */
+        return 0;
     }
 
-    (void)WINC_CmdSOCKC(cmdReqHandle, pSockCtx->sockId, WINC_CFG_PARAM_ID_SOCK_ASYNC_WIN_SZ, WINC_TYPE_INTEGER_UNSIGNED, asyncWinSize, 0);
-    (void)WINC_CmdSOCKC(cmdReqHandle, pSockCtx->sockId, WINC_CFG_PARAM_ID_SOCK_ASYNC_MAX_FRM_SZ, WINC_TYPE_INTEGER_UNSIGNED, asyncMaxFrmSz, 0);
+    /* Free space is split between the end and the start of the buffer. */
+    endSpace = (size_t)(pBuffer->totalSize - pBuffer->inOffset);
 
-    return true;
+    if (endSpace < pBuffer->outOffset)
+    {
+        return pBuffer->outOffset;
+    }
+
+    return endSpace;
 }
 
 /*****************************************************************************
   Description:
-    Listen for connections on a socket.
+    Write data to socket buffer.
 
   Parameters:
-    fd      - Socket file descriptor.
-    type    - Socket type.
-    backlog - Maximum number of pending connections.
+    pBuffer  - Pointer to socket buffer to write data into
+    pData    - Pointer to new data to write
+    dataLen  - Length of new data
+    pAddr    - Pointer to datagram end point address structure
+    fragment - Flag indicating if write can be fragment or should be contiguous
 
   Returns:
-    0  - Success.
-    -1 - Error, errno set.
+    true or false indicating success or failure.
 
   Remarks:
-    errno:
-        EADDRINUSE
-            The referred to by fd is not bound to a local port.
-        EBADF
-            The argument fd is not a valid file descriptor.
-        ENOTSOCK
-            The file descriptor fd does not refer to a socket.
-        EOPNOTSUPP
-            The socket is not of a type that supports the listen() operation.
-        EAGAIN
-            The socket is nonblocking, and the listening cannot be
-            completed immediately.
+    See sockBufferWritev.
 
  *****************************************************************************/
 
-static int sockListen(int fd, int type, int backlog)
+static bool sockBufferWrite(WINC_SOCK_BUFFER *pBuffer, const uint8_t *pData, size_t dataLen, const SOCKADDR_UNION *pAddr, bool fragment)
 {
-    WINC_CMD_REQ_HANDLE cmdReqHandle;
-    void *pCmdReqBuffer;
-    WINC_SOCK_CTX *pSockCtx = WINC_SOCK_HANDLE_TO_PTR(fd);
-
-    if (NULL == pSockCtx)
-    {
-        errno = EBADF;
-        return -1;
-    }
-
-    if ((unsigned)backlog > SOMAXCONN)
-    {
-        backlog = SOMAXCONN;
-    }
-
-    if (false == sockLockSocket(pSockCtx))
-    {
-        errno = EFAULT;
-        return -1;
-    }
-
-    if ((type != pSockCtx->type) || ((SOCK_STREAM != pSockCtx->type) && (IPPROTO_TLS != pSockCtx->protocol)))
-    {
-        sockUnlockSocket(pSockCtx);
-        errno = EOPNOTSUPP;
-        return -1;
-    }
-
-    if (0U == pSockCtx->localEndPt.sin_port)
-    {
-        sockUnlockSocket(pSockCtx);
-        errno = EADDRINUSE;
-        return -1;
-    }
-
-    if (0U == pSockCtx->sockId)
-    {
-        if (true == pSockCtx->inUse)
-        {
-            errno = EAGAIN;
-        }
-        else
-        {
-            errno = ENOTSOCK;
-        }
-
-        sockUnlockSocket(pSockCtx);
-        return -1;
-    }
-
-    /* Perform bind of stream/TLS sockets to allow setting backlog. */
-
-    pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, 128);
-
-    if (NULL == pCmdReqBuffer)
-    {
-        sockUnlockSocket(pSockCtx);
-        errno = ENOMEM;
-        return -1;
-    }
-
-    cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, 128, 1, sockCmdRspCallbackHandler, (uintptr_t)pSockCtx);
-
-    if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
-    {
-        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
-        sockUnlockSocket(pSockCtx);
-        errno = EBADMSG;
-        return -1;
-    }
-
-    (void)WINC_CmdSOCKBL(cmdReqHandle, pSockCtx->sockId, ntohs(pSockCtx->localEndPt.sin_port), (uint8_t)backlog);
+    struct iovec iov;
 
-    if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
+    if (NULL == pData)
     {
-        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
-        sockUnlockSocket(pSockCtx);
-        errno = EBADMSG;
-        return -1;
+        return false;
     }
 
-    pSockCtx->listening = true;
+    iov.iov_base = (void*)pData;
+    iov.iov_len  = dataLen;
 
-    sockUnlockSocket(pSockCtx);
-    return 0;
+    return sockBufferWritev(pBuffer, &iov, dataLen, pAddr, fragment);
 }
 
 /*****************************************************************************
   Description:
-    Accept a connection on a socket.
+    Read data from a socket buffer into an I/O vector list.
 
   Parameters:
-    fd   - Socket file descriptor.
-    type - Socket type.
-    addr - Pointer to a structure to filled in with the address of the peer socket.
-    len  - Length of address structure.
+    pBuffer  - Pointer to socket buffer to read data from
+    pIov     - Pointer to I/O vector list to receive data, or NULL to discard
+    dataLen  - Length of data to read, must not exceed the I/O vectors length
+    pAddr    - Pointer to datagram end point address structure
+    addrLen  - Length of address structure
 
   Returns:
-    0  - Success.
-    -1 - Error, errno set.
+    Number of bytes read, or -1 for error.
 
   Remarks:
-    errno:
-        EBADF
-            The argument fd is not a valid file descriptor.
-        ENOMEM
-            Insufficient memory is available.
-        EWOULDBLOCK
-            The socket is marked nonblocking and no connections are
-            present to be accepted.
-        EOPNOTSUPP
-            The socket is not of a type that supports the accept() operation.
 
  *****************************************************************************/
 
-static int sockAccept(int fd, int type, struct sockaddr *addr, socklen_t *len)
+static ssize_t sockBufferReadv(WINC_SOCK_BUFFER *pBuffer, const struct iovec *pIov, size_t dataLen, void *pAddr, size_t addrLen, bool peek, size_t *pLenRemain)
 {
-    WINC_SOCK_CTX *pSockCtx = WINC_SOCK_HANDLE_TO_PTR(fd);
-    WINC_SOCK_CTX *pNewSockCtx;
-
-    if (NULL == pSockCtx)
-    {
-        errno = EBADF;
-        return -1;
-    }
-
-    if (type != pSockCtx->type)
-    {
-        errno = EOPNOTSUPP;
-        return -1;
-    }
-
-    pNewSockCtx = sockFindPendingSocket(pSockCtx);
-
-    if (NULL == pNewSockCtx)
-    {
-        errno = EWOULDBLOCK;
-        return -1;
-    }
+    int iovIdx = 0;
+    size_t iovOffset = 0;
+    ssize_t readData = 0;
+    size_t discardLen = 0;
+    size_t fragmentLen;
+    uint16_t outOffset;
+    uint16_t length;
 
-    if (false == sockLockSocket(pNewSockCtx))
+    if (NULL == pBuffer)
     {
-        errno = EFAULT;
         return -1;
     }
 
-    if ((NULL != addr) && (NULL != len))
+    if (NULL == pBuffer->pUdpPktBuffers)
     {
-        socklen_t addrLen = (AF_INET == pNewSockCtx->remoteEndPt.sin_family) ? sizeof(struct sockaddr_in) : sizeof(struct sockaddr_in6);
-
-        if (*len > addrLen)
+        /* For TCP sockets, limit the data read to what is available. */
+        if (dataLen > pBuffer->length)
         {
-            *len = addrLen;
+            dataLen = pBuffer->length;
         }
-
-        (void)memcpy(addr, &pNewSockCtx->remoteEndPt, *len);
-
-        *len = addrLen;
     }
-
-    if (SOCK_STREAM == pNewSockCtx->type)
+    else
     {
-        if (false == sockAllocSocketBuffers(pNewSockCtx))
+        /* For UDP sockets, find the packet buffer to get the next datagram length. */
+        if (0U == pBuffer->pUdpPktBuffers->pktDepth)
         {
-            sockUnlockSocket(pNewSockCtx);
-            errno = ENOMEM;
-            return -1;
+            if (NULL != pLenRemain)
+            {
+                *pLenRemain = 0;
+            }
+
+            return 0;
         }
-    }
 
-    pNewSockCtx->accepted = true;
+        if (AF_UNSPEC == pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->outIdx].endPt.sin_family)
+        {
+            /* If the next packet buffer is blank, this is a padding datagram, it and the data length
+                specified by it need to be removed first. */
+            fragmentLen = pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->outIdx].pktLength;
 
-    sockUnlockSocket(pNewSockCtx);
-    return WINC_SOCK_PTR_TO_HANDLE(pNewSockCtx);
-}
+            WINC_TRACE_PRINT("PB# %d %d\n", fragmentLen, pBuffer->pUdpPktBuffers->outIdx);
 
-/*****************************************************************************
-  Description:
-    Read data from the socket on the device.
+            pBuffer->length    -= (uint16_t)fragmentLen;
+            pBuffer->outOffset  = 0;
 
-  Parameters:
-    pSockCtx - Pointer to socket context
+            pBuffer->pUdpPktBuffers->pktDepth--;
+            pBuffer->pUdpPktBuffers->outIdx++;
 
-  Returns:
-    true or false indicating success or failure.
+            if (pBuffer->pUdpPktBuffers->outIdx == pBuffer->pUdpPktBuffers->numPkts)
+            {
+                pBuffer->pUdpPktBuffers->outIdx = 0;
+            }
 
-  Remarks:
+            if (0U == pBuffer->pUdpPktBuffers->pktDepth)
+            {
+                return 0;
+            }
+        }
 
- *****************************************************************************/
+        /* If an address pointer and length are provided, copy what we can from the packet buffer end point. */
+        if ((NULL != pAddr) && (addrLen > 0U))
+        {
+            (void)memcpy(pAddr, &pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->outIdx], addrLen);
+        }
 
-static bool sockRead(WINC_SOCK_CTX *pSockCtx)
-{
-    ssize_t dataLenToRead;
+        if (dataLen > pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->outIdx].pktLength)
+        {
+            /* If the requested length is too much, limit it to the datagram length. */
+            dataLen = pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->outIdx].pktLength;
+        }
+        else
+        {
+            /* If the requested length is less than the datagrams length, the remaining data needs to be discarded. */
+            discardLen = pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->outIdx].pktLength - dataLen;
+        }
 
-    if (NULL == pSockCtx)
-    {
-        return false;
-    }
+        WINC_TRACE_PRINT("PB- %d %d %d\n", pBuffer->pUdpPktBuffers->pktDepth, pBuffer->pUdpPktBuffers->outIdx, pBuffer->pUdpPktBuffers->pkts[pBuffer->pUdpPktBuffers->outIdx].pktLength);
 
-    /* Clear received data flag, ready for new possible data. */
-    pSockCtx->newRecvData = false;
+        if (false == peek)
+        {
+            /* Discard the current packet buffer. */
+            pBuffer->pUdpPktBuffers->pktDepth--;
+            pBuffer->pUdpPktBuffers->outIdx++;
 
-    /* If no outstanding data to read, stop now. */
-    if (0U == pSockCtx->pendingRecvDataLen)
-    {
-        return true;
+            if (pBuffer->pUdpPktBuffers->outIdx == pBuffer->pUdpPktBuffers->numPkts)
+            {
+                pBuffer->pUdpPktBuffers->outIdx = 0;
+            }
+        }
     }
 
-    WINC_TRACE_PRINT("SR %d %d %d\n", pSockCtx->pendingRecvDataLen, pSockCtx->recvBuffer.outstandingDataLen, pSockCtx->recvBuffer.length);
-
-    /* Length of data to read, start based on pending minus outstanding, i.e. what we know is left. */
-    dataLenToRead = (pSockCtx->pendingRecvDataLen - pSockCtx->recvBuffer.outstandingDataLen);
-
-    /* Limit based on the space in the receive socket buffer. */
-    if ((uint16_t)dataLenToRead > (pSockCtx->recvBuffer.totalSize - pSockCtx->recvBuffer.length - pSockCtx->recvBuffer.outstandingDataLen))
-    {
-        dataLenToRead = (pSockCtx->recvBuffer.totalSize - pSockCtx->recvBuffer.length - pSockCtx->recvBuffer.outstandingDataLen);
-    }
+    outOffset = pBuffer->outOffset;
+    length    = pBuffer->length;
 
-    if (dataLenToRead > 0)
+    while (dataLen > 0U)
     {
-        WINC_CMD_REQ_HANDLE cmdReqHandle;
-        void *pCmdReqBuffer;
-        ssize_t maxDataLenToRead;
+        /* Copy the data to the buffer provided. */
+        fragmentLen = dataLen;
 
-        if (SOCK_DGRAM == pSockCtx->type)
-        {
-            maxDataLenToRead = MAX_UDP_SOCK_PAYLOAD_SZ;
-        }
-        else
+        if (fragmentLen > (pBuffer->totalSize - outOffset))
         {
-            maxDataLenToRead = MAX_TCP_SOCK_PAYLOAD_SZ;
+            fragmentLen = (pBuffer->totalSize - outOffset);
         }
 
-        if (dataLenToRead > maxDataLenToRead)
+        if (NULL != pIov)
         {
-            dataLenToRead = maxDataLenToRead;
+            sockIovCopy(pIov, &iovIdx, &iovOffset, &pBuffer->pData[outOffset], fragmentLen, true);
         }
 
-        WINC_TRACE_PRINT("SRreq %d\n", dataLenToRead);
-
-        /* Allocate command request. */
-        pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, 128);
+        length    -= (uint16_t)fragmentLen;
+        outOffset += (uint16_t)fragmentLen;
 
-        if (NULL == pCmdReqBuffer)
+        if (outOffset >= pBuffer->totalSize)
         {
-            return false;
+            outOffset -= pBuffer->totalSize;
         }
 
-        /* Initialise command request for a single command. */
-        cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, 128, 1, sockCmdRspCallbackHandler, (uintptr_t)pSockCtx);
+        readData += (ssize_t)fragmentLen;
+        dataLen  -= fragmentLen;
+    }
 
-        if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
-        {
-            slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
-            return false;
-        }
+    /* Discard any data from the datagram that wasn't read. */
+    if (discardLen > 0U)
+    {
+        WINC_TRACE_PRINT("DL %d\n", discardLen);
 
-        /* Perform a SOCKRD command, request extended output information to update pending counts. */
-        (void)WINC_CmdSOCKRD(cmdReqHandle, pSockCtx->sockId, WINC_CONST_SOCKET_OUTPUT_MODE_ASCII_EXT, dataLenToRead);
+        outOffset += (uint16_t)discardLen;
+        length    -= (uint16_t)discardLen;
 
-        if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
+        if (outOffset >= pBuffer->totalSize)
         {
-            slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
-            return false;
+            outOffset -= pBuffer->totalSize;
         }
+    }
 
-        WINC_TRACE_PRINT("SR+ %d + %d\n", pSockCtx->recvBuffer.outstandingDataLen, dataLenToRead);
-
-        /* Update the outstanding length to reflect this request. */
-        pSockCtx->recvBuffer.outstandingDataLen += (uint16_t)dataLenToRead;
+    if (false == peek)
+    {
+        pBuffer->outOffset = outOffset;
+        pBuffer->length    = length;
+    }
 
-        if (SOCK_DGRAM == pSockCtx->type)
+    if (NULL != pLenRemain)
+    {
+        if (NULL == pBuffer->pUdpPktBuffers)
         {
-            /* Discard the rest of the pending datagram */
-            pSockCtx->pendingRecvDataLen = (uint16_t)dataLenToRead;
+            *pLenRemain = pBuffer->length;
+        }
+        else
+        {
+            *pLenRemain = discardLen;
         }
     }
 
-    return true;
+    return readData;
 }
 
 /*****************************************************************************
   Description:
-    Update socket in response to WR/WRTO status.
+    Read data from a socket buffer.
 
   Parameters:
-    pSockCtx   - Pointer to socket context
-    seqNum     - Packet sequence number
-    dataLength - Length of data acknowledged
-    statusCode - Status result of write operation
+    pBuffer  - Pointer to socket buffer to read data from
+    pData    - Pointer to buffer to receive data, or NULL to discard
+    dataLen  - Length of data to read
+    pAddr    - Pointer to datagram end point address structure
+    addrLen  - Length of address structure
 
   Returns:
-    None
+    Number of bytes read, or -1 for error.
 
   Remarks:
+    See sockBufferReadv.
 
  *****************************************************************************/
 
-static void sockProcessStatusWR(WINC_SOCK_CTX *pSockCtx, uint16_t seqNum, uint16_t dataLength, uint16_t statusCode)
+static ssize_t sockBufferRead(WINC_SOCK_BUFFER *pBuffer, uint8_t *pData, size_t dataLen, void *pAddr, size_t addrLen, bool peek, size_t *pLenRemain)
 {
-    WINC_TRACE_PRINT("SW- [%d] %04x %d %d\n", seqNum, statusCode, dataLength, pSockCtx->sendBuffer.outstandingDataLen);
+    struct iovec iov;
 
-    if (WINC_STATUS_OK == statusCode)
+    if (NULL == pData)
     {
-        uint8_t pktDepth = 0;
+        return sockBufferReadv(pBuffer, NULL, dataLen, pAddr, addrLen, peek, pLenRemain);
+    }
 
-        if ((SOCK_DGRAM == pSockCtx->type) && (NULL != pSockCtx->sendBuffer.pUdpPktBuffers))
-        {
-            pktDepth = pSockCtx->sendBuffer.pUdpPktBuffers->pktDepth;
-        }
+    iov.iov_base = pData;
+    iov.iov_len  = dataLen;
 
-        /* Dummy socket buffer read to remove the data this write has completed. */
-        (void)sockBufferRead(&pSockCtx->sendBuffer, NULL, dataLength, NULL, 0, false, NULL);
+    return sockBufferReadv(pBuffer, &iov, dataLen, pAddr, addrLen, peek, pLenRemain);
+}
 
-        /* Update outstanding data length to reflect completed write. */
-        pSockCtx->sendBuffer.outstandingDataLen -= dataLength;
+/*****************************************************************************
+  Description:
+    Signal a socket state change to poll().
 
-        if ((SOCK_DGRAM == pSockCtx->type) && (NULL != pSockCtx->sendBuffer.pUdpPktBuffers))
-        {
-            /* Update the outstanding packet buffer count with the number of buffers freed
-                by the dummy socket buffer read. */
-            pSockCtx->udpUnackedPktBufs -= (pktDepth - pSockCtx->sendBuffer.pUdpPktBuffers->pktDepth);
-        }
+  Parameters:
+    None.
 
-        /* Update the expected sequence number for the next write operation. */
-        pSockCtx->unAckedSeqNum = seqNum + dataLength;
-    }
-    else if (pSockCtx->unAckedSeqNum == seqNum)
-    {
-        /* On write failure, reset the outstanding counts to cause resend. */
-        pSockCtx->sendBuffer.outstandingDataLen = 0;
-        pSockCtx->udpUnackedPktBufs             = 0;
-    }
-    else
+  Returns:
+    None.
+
+  Remarks:
+    Called whenever a socket may have changed state, any waiting poll() will
+    re-evaluate its sockets.
+
+ *****************************************************************************/
+
+static void sockPollSignal(void)
+{
+    pollEventCount++;
+
+#ifdef WINC_SOCK_POLL_SEM_ENABLE
+    if (numPollWaiters > 0U)
     {
-        /* Do nothing. */
+        WINC_CONF_SEM_POST(&pollSemaphore);
     }
+#endif
 }
 
 /*****************************************************************************
   Description:
-    Write data to a socket on the device.
+    Find the next set bit in a socket bitmap.
 
   Parameters:
-    pSockCtx - Pointer to socket context
+    pMap - Pointer to socket bitmap
+    idx  - Socket index to start search from
 
   Returns:
-    true or false indicating success or failure.
+    Index of next set bit at or after idx, or -1 if none.
 
   Remarks:
 
  *****************************************************************************/
 
-static bool sockWrite(WINC_SOCK_CTX *pSockCtx)
+static int sockMapNext(const uint32_t *pMap, unsigned int idx)
 {
-    WINC_CMD_REQ_HANDLE cmdReqHandle;
-    void *pCmdReqBuffer;
-    uint16_t dataLenToWrite;
-    uint16_t outOffset;
-    uint16_t seqNum;
-    uint8_t pkkBufIdx = 0;
+    unsigned int wordIdx;
+    uint32_t bits;
 
-    if (NULL == pSockCtx)
+    if (idx >= WINC_SOCK_NUM_SOCKETS)
     {
-        return false;
+        return -1;
     }
 
-    if (SOCK_DGRAM == pSockCtx->type)
-    {
-        int numRemainingPkts;
+    wordIdx = idx / 32U;
+    bits    = pMap[wordIdx] & ~(((uint32_t)1U << (idx % 32U)) - 1U);
 
-        numRemainingPkts = (pSockCtx->sendBuffer.pUdpPktBuffers->pktDepth - pSockCtx->udpUnackedPktBufs);
+    while (0U == bits)
+    {
+        wordIdx++;
 
-        /* For datagrams check the remaining number of packet buffers. */
-        if ((0U == pSockCtx->sendBuffer.pUdpPktBuffers->pktDepth) || (0 == numRemainingPkts))
+        if (wordIdx >= WINC_SOCK_MAP_WORDS)
         {
-            return false;
+            return -1;
         }
 
-        dataLenToWrite = 0;
+        bits = pMap[wordIdx];
+    }
 
-        /* Search through the packet buffers looking for a valid one to use. */
-        do
-        {
-            pkkBufIdx = pSockCtx->sendBuffer.pUdpPktBuffers->outIdx + pSockCtx->udpUnackedPktBufs;
+    return (int)((wordIdx * 32U) + (unsigned int)__builtin_ctz(bits));
+}
 
-            if (pkkBufIdx >= pSockCtx->sendBuffer.pUdpPktBuffers->numPkts)
-            {
-                pkkBufIdx -= pSockCtx->sendBuffer.pUdpPktBuffers->numPkts;
-            }
+/*****************************************************************************
+  Description:
+    Calculate the socket ID hash map position of a socket ID.
 
-            /* If the address is specified, use this packet buffer. */
-            if (AF_UNSPEC != pSockCtx->sendBuffer.pUdpPktBuffers->pkts[pkkBufIdx].endPt.sin_family)
-            {
-                dataLenToWrite = pSockCtx->sendBuffer.pUdpPktBuffers->pkts[pkkBufIdx].pktLength;
-                outOffset      = pSockCtx->sendBuffer.pUdpPktBuffers->pkts[pkkBufIdx].pktOffset;
-                break;
-            }
+  Parameters:
+    sockId - Socket ID
 
-            WINC_TRACE_PRINT("SW#\n");
+  Returns:
+    Hash map index.
 
-            pSockCtx->udpUnackedPktBufs++;
-        }
-        while (0U != (unsigned)(numRemainingPkts--));
-    }
-    else
-    {
-        uint16_t length;
+  Remarks:
 
-        /* For TCP sockets, start with the largest write size depending on IP version. */
-        if (AF_INET == pSockCtx->remoteEndPt.sin_family)
-        {
-            dataLenToWrite = MAX_TCP_IPV4_SOCK_PAYLOAD_SZ;
-        }
-        else if (AF_INET6 == pSockCtx->remoteEndPt.sin_family)
-        {
-            dataLenToWrite = MAX_TCP_IPV6_SOCK_PAYLOAD_SZ;
-        }
-        else
-        {
-            return false;
-        }
+ *****************************************************************************/
 
-        /* Calculate offset and length of suitable data block which can be written. */
-        outOffset = pSockCtx->sendBuffer.outOffset + pSockCtx->sendBuffer.outstandingDataLen;
-        length    = pSockCtx->sendBuffer.length - pSockCtx->sendBuffer.outstandingDataLen;
+static unsigned int sockIdHash(uint16_t sockId)
+{
+    return (unsigned int)(((uint32_t)sockId * 2654435761U) >> (32U - WINC_SOCK_ID_MAP_BITS));
+}
 
-        if (outOffset >= pSockCtx->sendBuffer.totalSize)
-        {
-            outOffset -= pSockCtx->sendBuffer.totalSize;
-        }
+/*****************************************************************************
+  Description:
+    Add a socket to the socket ID hash map.
 
-        if (dataLenToWrite > length)
-        {
-            dataLenToWrite = length;
-        }
+  Parameters:
+    pSockCtx - Pointer to socket context, sockId must be set
 
-        if (dataLenToWrite > (pSockCtx->sendBuffer.totalSize - outOffset))
-        {
-            dataLenToWrite = (pSockCtx->sendBuffer.totalSize - outOffset);
-        }
-    }
+  Returns:
+    None.
 
-    if (0U == dataLenToWrite)
-    {
-        return true;
-    }
+  Remarks:
+    The map is at least twice the number of sockets, so a free entry is
+    always found.
 
-    WINC_TRACE_PRINT("SW+ [%d] +%d %d\n", pSockCtx->unAckedSeqNum, pSockCtx->sendBuffer.outstandingDataLen, dataLenToWrite);
+ *****************************************************************************/
 
-    /* Allocate a command request structure. */
-    pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, (160U+dataLenToWrite));
+static void sockIdMapAdd(const WINC_SOCK_CTX *pSockCtx)
+{
+    unsigned int mapIdx = sockIdHash(pSockCtx->sockId);
 
-    if (NULL == pCmdReqBuffer)
+    while (0U != sockIdMap[mapIdx])
     {
-        //WINC_ERROR_PRINT("error: unable to allocate socket write command request\n");
-        return false;
+        mapIdx = (mapIdx + 1U) & (WINC_SOCK_ID_MAP_SZ - 1U);
     }
 
-    /* Initialise the command request for a single command. */
-    cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, (160U+dataLenToWrite), 1, sockCmdRspCallbackHandler, (uintptr_t)pSockCtx);
+    sockIdMap[mapIdx] = (uint8_t)(WINC_SOCK_PTR_TO_IDX(pSockCtx) + 1U);
+}
 
-    if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
-    {
-        WINC_ERROR_PRINT("error: socket write command request initialisation failed\n");
-        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
-        return false;
-    }
+/*****************************************************************************
+  Description:
+    Remove a socket from the socket ID hash map.
 
-    /* Calculate the pseudo-sequence number of the data being written. */
-    seqNum = pSockCtx->unAckedSeqNum + pSockCtx->sendBuffer.outstandingDataLen;
+  Parameters:
+    pSockCtx - Pointer to socket context
 
-    if (SOCK_DGRAM == pSockCtx->type)
-    {
-        WINC_TYPE typeRmtAddr;
-        size_t lenRmtAddr;
-        uintptr_t rmtAddr;
+  Returns:
+    None.
 
-        /* For UDP datagrams locate the destination address from the packet buffer. */
-        if (AF_INET == pSockCtx->sendBuffer.pUdpPktBuffers->pkts[pkkBufIdx].endPt.sin_family)
-        {
-            typeRmtAddr = WINC_TYPE_IPV4ADDR;
-            lenRmtAddr  = 4;
-            rmtAddr     = (uintptr_t)&pSockCtx->sendBuffer.pUdpPktBuffers->pkts[pkkBufIdx].endPt.in4.sin_addr;
-        }
-        else
+  Remarks:
+    Entries following the removed entry are moved back so that lookups
+    never need to skip deleted entries.
+
+ *****************************************************************************/
+
+static void sockIdMapRemove(const WINC_SOCK_CTX *pSockCtx)
+{
+    uint8_t entry = (uint8_t)(WINC_SOCK_PTR_TO_IDX(pSockCtx) + 1U);
+    unsigned int mapIdx = sockIdHash(pSockCtx->sockId);
+    unsigned int nextIdx;
+
+    while (entry != sockIdMap[mapIdx])
+    {
+        if (0U == sockIdMap[mapIdx])
         {
-            typeRmtAddr = WINC_TYPE_IPV6ADDR;
-            lenRmtAddr  = 16;
-            rmtAddr     = (uintptr_t)&pSockCtx->sendBuffer.pUdpPktBuffers->pkts[pkkBufIdx].endPt.in6.sin6_addr;
+            return;
         }
 
-        /* Issue a SOCKWRTO command. */
-        (void)WINC_CmdSOCKWRTO(cmdReqHandle, pSockCtx->sockId, typeRmtAddr, rmtAddr, lenRmtAddr, ntohs(pSockCtx->sendBuffer.pUdpPktBuffers->pkts[pkkBufIdx].endPt.sin_port), dataLenToWrite, (int32_t)seqNum, &pSockCtx->sendBuffer.pData[outOffset], dataLenToWrite);
-    }
-    else
-    {
-        /* For TCP sockets issue a SOCKWR command. */
-        (void)WINC_CmdSOCKWR(cmdReqHandle, pSockCtx->sockId, dataLenToWrite, (int32_t)seqNum, &pSockCtx->sendBuffer.pData[outOffset], dataLenToWrite);
+        mapIdx = (mapIdx + 1U) & (WINC_SOCK_ID_MAP_SZ - 1U);
     }
 
-    if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
+    sockIdMap[mapIdx] = 0;
+
+    nextIdx = (mapIdx + 1U) & (WINC_SOCK_ID_MAP_SZ - 1U);
+
+    while (0U != sockIdMap[nextIdx])
     {
-        WINC_ERROR_PRINT("error: socket write command request tranmission failed\n");
-        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
-        return false;
-    }
+        unsigned int homeIdx = sockIdHash(wincSockets[sockIdMap[nextIdx]-1U].sockId);
 
-    pSockCtx->sendBuffer.outstandingDataLen += dataLenToWrite;
-    pSockCtx->udpUnackedPktBufs++;
+        /* Move the entry into the gap unless its home position lies cyclically
+           after the gap and at or before its current position. */
+        if (((nextIdx - homeIdx) & (WINC_SOCK_ID_MAP_SZ - 1U)) >= ((nextIdx - mapIdx) & (WINC_SOCK_ID_MAP_SZ - 1U)))
+        {
+            sockIdMap[mapIdx]  = sockIdMap[nextIdx];
+            sockIdMap[nextIdx] = 0;
+            mapIdx             = nextIdx;
+        }
 
-    return true;
+        nextIdx = (nextIdx + 1U) & (WINC_SOCK_ID_MAP_SZ - 1U);
+    }
 }
 
 /*****************************************************************************
   Description:
-    Returns either the local or remote address.
+    Set the ID of a socket.
 
   Parameters:
-    fd          - Socket file descriptor.
-    addr        - Pointer to address structure.
-    addrlen     - Length of address structure.
-    localEndPtr - Flag indicating if local or remote address required.
+    pSockCtx - Pointer to socket context
+    sockId   - Socket ID
 
   Returns:
-    On success, zero is returned.  On error, -1 is returned, and errno is set
-    to indicate the error.
+    None.
 
   Remarks:
-        EFAULT
-            System fault.
-        EINVAL
-            addrlen is invalid (e.g., is negative).
-        ENOTSOCK
-            The file descriptor fd does not refer to a socket.
-        ENOTCONN
-            The socket is not connected, and no target has been given.
 
  *****************************************************************************/
 
-static int sockGetEndPtName(int fd, struct sockaddr *addr, socklen_t *addrlen, bool localEndPtr)
+static void sockSetID(WINC_SOCK_CTX *pSockCtx, uint16_t sockId)
 {
-    WINC_SOCK_CTX *pSockCtx = WINC_SOCK_HANDLE_TO_PTR(fd);
-    size_t endPtAddrLen;
-    SOCKADDR_UNION *pEndPt;
-
-    if ((NULL == pSockCtx) || (NULL == addr) || (NULL == addrlen))
+    if (0U != pSockCtx->sockId)
     {
-        errno = EFAULT;
-        return -1;
+        sockIdMapRemove(pSockCtx);
     }
 
-    if (*addrlen < 0)
-    {
-        errno = EINVAL;
-        return -1;
-    }
+    pSockCtx->sockId = sockId;
 
-    if (false == sockLockSocket(pSockCtx))
+    if (0U != sockId)
     {
-        errno = EFAULT;
-        return -1;
+        sockIdMapAdd(pSockCtx);
     }
+}
 
-    if (0U == pSockCtx->sockId)
-    {
-        sockUnlockSocket(pSockCtx);
-        errno = ENOTSOCK;
-        return -1;
-    }
+/*****************************************************************************
+  Description:
+    Add a socket to the list of listening sockets.
 
-    if (true == localEndPtr)
-    {
-        pEndPt = &pSockCtx->localEndPt;
-    }
-    else
-    {
-        pEndPt = &pSockCtx->remoteEndPt;
-    }
+  Parameters:
+    pSockCtx - Pointer to socket context
 
-    if (AF_UNSPEC == pEndPt->sin_family)
-    {
-        sockUnlockSocket(pSockCtx);
-        errno = ENOTCONN;
-        return -1;
-    }
+  Returns:
+    None.
 
-    endPtAddrLen = sizeof_sockaddr(&pEndPt->sa);
+  Remarks:
 
-    if (*addrlen > endPtAddrLen)
+ *****************************************************************************/
+
+static void sockListenAdd(WINC_SOCK_CTX *pSockCtx)
+{
+    if (true == pSockCtx->listening)
     {
-        *addrlen = endPtAddrLen;
+        return;
     }
 
-    memcpy(addr, pEndPt, *addrlen);
-
-    *addrlen = endPtAddrLen;
-
-    sockUnlockSocket(pSockCtx);
-    return 0;
+    pSockCtx->listenNext = sockListenHead;
+    sockListenHead       = (uint8_t)(WINC_SOCK_PTR_TO_IDX(pSockCtx) + 1U);
+    pSockCtx->listening  = true;
 }
 
 /*****************************************************************************
   Description:
-    Send a socket event via the callback.
+    Queue a new connection on a listening socket.
 
   Parameters:
-    pSockCtx - Pointer to socket context
-    event    - Socket event.
-    status   - Socket status.
+    pListenSockCtx - Pointer to listening socket context
+    pSockCtx       - Pointer to new connection socket context
 
   Returns:
-    true or false indicating success or failure.
+    None.
 
   Remarks:
 
  *****************************************************************************/
 
-static void sockEventCallback(WINC_SOCK_CTX *pSockCtx, WINC_SOCKET_EVENT event, WINC_SOCKET_STATUS status)
+static void sockPendingAdd(WINC_SOCK_CTX *pListenSockCtx, WINC_SOCK_CTX *pSockCtx)
 {
-    if (NULL == pSockCtx)
+    uint8_t entry = (uint8_t)(WINC_SOCK_PTR_TO_IDX(pSockCtx) + 1U);
+
+    pSockCtx->pendNext     = 0;
+    pSockCtx->pendListener = (uint8_t)(WINC_SOCK_PTR_TO_IDX(pListenSockCtx) + 1U);
+
+    if (0U == pListenSockCtx->pendTail)
     {
-        return;
+        pListenSockCtx->pendHead = entry;
     }
-
-    if (NULL != pfSocketEventCallback)
+    else
     {
-        sockUnlockSocket(pSockCtx);
-
-        pfSocketEventCallback(socketEventCallbackContext, WINC_SOCK_PTR_TO_HANDLE(pSockCtx), event, status);
-
-        if (false == sockLockSocket(pSockCtx))
-        {
-        }
+        wincSockets[pListenSockCtx->pendTail-1U].pendNext = entry;
     }
+
+    pListenSockCtx->pendTail = entry;
 }
 
-//*******************************************************************************
-/*
+/*****************************************************************************
   Description:
-    Processes command status responses received via WINC_DEV_CMDREQ_EVENT_CMD_STATUS events.
+    Remove a socket from the listening socket structures.
 
   Parameters:
-    pSockCtx     - Pointer to socket context.
-    cmdID        - Command ID.
-    cmdReqHandle - Command request handle.
-    pSrcCmd      - Pointer to source command.
-    statusCode   - Status code.
+    pSockCtx - Pointer to socket context
 
   Returns:
     None.
 
   Remarks:
-    None.
+    A pending connection is removed from its listening socket's queue. A
+    listening socket is removed from the list of listening sockets and its
+    queued connections are detached.
 
-*/
+ *****************************************************************************/
 
-static void sockProcessStatus
-(
-    WINC_SOCK_CTX *pSockCtx,
-    uint16_t cmdID,
-    WINC_CMD_REQ_HANDLE cmdReqHandle,
-    const WINC_DEV_EVENT_SRC_CMD *const pSrcCmd,
-    uint16_t statusCode
-)
+static void sockListenRemove(WINC_SOCK_CTX *pSockCtx)
 {
-    WINC_SOCKET_STATUS status = WINC_SOCKET_STATUS_OK;
+    uint8_t entry = (uint8_t)(WINC_SOCK_PTR_TO_IDX(pSockCtx) + 1U);
+    uint8_t *pLink;
+    uint8_t prevEntry = 0;
 
-    if ((NULL == pSockCtx) || (NULL == pSrcCmd))
+    if (0U != pSockCtx->pendListener)
     {
-        return;
-    }
+        WINC_SOCK_CTX *pListenSockCtx = &wincSockets[pSockCtx->pendListener-1U];
 
-    /* Set status based on success/failure of command. */
-    if (WINC_STATUS_OK != statusCode)
-    {
-//        WINC_ERROR_PRINT("error: command %04x error %04x\n", cmdID, statusCode);
-        status = WINC_SOCKET_STATUS_ERROR;
-    }
+        pLink = &pListenSockCtx->pendHead;
 
-    switch (cmdID)
-    {
-        case WINC_CMD_ID_SOCKO:
+        while (0U != *pLink)
         {
-            if (WINC_SOCKET_ASYNC_MODE_OFF != (WINC_SOCKET_ASYNC_MODE_TYPE)pSockCtx->readMode)
+            if (entry == *pLink)
             {
-                WINC_CMD_REQ_HANDLE sockCmdReqHandle;
-                void *pCmdReqBuffer;
+                *pLink = pSockCtx->pendNext;
 
-                pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, 256);
-
-                if (NULL == pCmdReqBuffer)
+                if (entry == pListenSockCtx->pendTail)
                 {
-                    break;
+                    pListenSockCtx->pendTail = prevEntry;
                 }
 
-                sockCmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, 256, 2, sockCmdRspCallbackHandler, (uintptr_t)pSockCtx);
+                break;
+            }
 
-                if (WINC_CMD_REQ_INVALID_HANDLE == sockCmdReqHandle)
-                {
-                    slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
-                    break;
-                }
+            prevEntry = *pLink;
+            pLink     = &wincSockets[*pLink-1U].pendNext;
+        }
 
-                (void)sockAsyncModeConf(sockCmdReqHandle, pSockCtx);
+        pSockCtx->pendNext     = 0;
+        pSockCtx->pendListener = 0;
+    }
 
-                if (false == WINC_DevTransmitCmdReq(wincDevHandle, sockCmdReqHandle))
-                {
-                    slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
-                    break;
-                }
+    if (true == pSockCtx->listening)
+    {
+        uint8_t pendEntry = pSockCtx->pendHead;
 
-                pSockCtx->nextSeqNum = 0;
-            }
+        while (0U != pendEntry)
+        {
+            WINC_SOCK_CTX *pPendSockCtx = &wincSockets[pendEntry-1U];
 
-            sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_OPEN, status);
-            break;
+            pendEntry                  = pPendSockCtx->pendNext;
+            pPendSockCtx->pendNext     = 0;
+            pPendSockCtx->pendListener = 0;
         }
 
-        case WINC_CMD_ID_SOCKBL:
+        pSockCtx->pendHead = 0;
+        pSockCtx->pendTail = 0;
+
+        pLink = &sockListenHead;
+
+        while (0U != *pLink)
         {
-            if ((SOCK_DGRAM == pSockCtx->type) && (IPPROTO_TLS != pSockCtx->protocol))
+            if (entry == *pLink)
             {
-                /* SOCKBL success indicates a connected socket. */
-                pSockCtx->connected = true;
+                *pLink = pSockCtx->listenNext;
+                break;
             }
 
-            sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_LISTEN, status);
-            break;
+            pLink = &wincSockets[*pLink-1U].listenNext;
         }
 
-        case WINC_CMD_ID_SOCKBR:
-        case WINC_CMD_ID_SOCKBM:
+        pSockCtx->listenNext = 0;
+        pSockCtx->listening  = false;
+    }
+}
+
+/*****************************************************************************
+  Description:
+    Find a free socket context.
+
+  Parameters:
+    None.
+
+  Returns:
+    Pointer to free socket context or NULL for error.
+
+  Remarks:
+
+ *****************************************************************************/
+
+static WINC_SOCK_CTX* sockFindFreeSocket(void)
+{
+    unsigned int i;
+
+    for (i=0; i<WINC_SOCK_MAP_WORDS; i++)
+    {
+        if (0xffffffffU != sockInUseMap[i])
         {
-            if ((SOCK_DGRAM == pSockCtx->type) && (IPPROTO_TLS != pSockCtx->protocol))
-            {
-                /* SOCKBR success indicates a connected socket. */
-                pSockCtx->connected = true;
+            unsigned int idx = (i * 32U) + (unsigned int)__builtin_ctz(~sockInUseMap[i]);
 
-                sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_CONNECT, status);
+            if (idx >= WINC_SOCK_NUM_SOCKETS)
+            {
+                break;
             }
 
-            break;
+            (void)memset(&wincSockets[idx], 0, sizeof(WINC_SOCK_CTX));
+            return &wincSockets[idx];
         }
+    }
 
-        case WINC_CMD_ID_SOCKCL:
-        {
-            sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_CLOSE, status);
+    return NULL;
+}
 
-            /* SOCKCL complete, close socket. */
-            sockDestroySocket(pSockCtx);
-            pSockCtx = NULL;
-            break;
-        }
+/*****************************************************************************
+  Description:
+    Creates a new socket context.
 
-        case WINC_CMD_ID_SOCKWR:
-        case WINC_CMD_ID_SOCKWRTO:
-        {
-            WINC_DEV_PARAM_ELEM elems[10];
-            uint16_t seqNum;
+  Parameters:
+    pSockCtx - Pointer to socket context to create.
+    type     - Type of socket.
+    sockId   - ID of socket, zero if not known yet.
 
-            if (pSrcCmd->numParams < 3U)
-            {
-                break;
-            }
+  Returns:
+    true or false.
 
-            /* Unpack the SOCKWR/SOCKWRTO command. */
-            if (true == WINC_DevUnpackElements(pSrcCmd->numParams, pSrcCmd->pParams, elems))
-            {
-                uint16_t dataLength;
+  Remarks:
 
-                /* Read the length and sequence number of the socket write command. */
-                (void)WINC_CmdReadParamElem(&elems[pSrcCmd->numParams-3U], WINC_TYPE_INTEGER, &dataLength, sizeof(dataLength));
-                (void)WINC_CmdReadParamElem(&elems[pSrcCmd->numParams-2U], WINC_TYPE_INTEGER, &seqNum, sizeof(seqNum));
+ *****************************************************************************/
 
-                sockProcessStatusWR(pSockCtx, seqNum, dataLength, statusCode);
-            }
+static bool sockCreateSocket(WINC_SOCK_CTX *pSockCtx, uint8_t type, uint16_t sockId)
+{
+#if WINC_SOCK_SLAB_ALLOC_MODE == 2
+    int8_t numSlabs;
+#endif
 
-            if (WINC_STATUS_OK == statusCode)
-            {
-                sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_SEND, status);
+    if (NULL == pSockCtx)
+    {
+        return false;
+    }
 
-                /* Perform a new device write, on success. */
-                (void)sockWrite(pSockCtx);
-            }
-            else if ((WINC_STATUS_SOCKET_NOT_READY == statusCode) || (WINC_STATUS_SOCKET_SEQUENCE_ERROR == statusCode))
-            {
-                /* Perform a new device write, non-fatal error. */
-                (void)sockWrite(pSockCtx);
-            }
-            else
-            {
-                sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_SEND, status);
-            }
+    WINC_CONF_LOCK_CREATE(&pSockCtx->accessMutex);
 
-            break;
-        }
+    pSockCtx->inUse     = true;
+    pSockCtx->type      = type;
+    pSockCtx->recvBufSz = WINC_SOCK_BUF_RX_SZ;
+    pSockCtx->sendBufSz = WINC_SOCK_BUF_TX_SZ;
+    pSockCtx->numRxPkts = WINC_SOCK_BUF_RX_PKT_BUF_NUM;
+    pSockCtx->numTxPkts = WINC_SOCK_BUF_TX_PKT_BUF_NUM;
+    pSockCtx->readWindow = 1;
 
-        case WINC_CMD_ID_SOCKRD:
-        {
-            if (true == pSockCtx->newRecvData)
-            {
-                sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_RECV, status);
-            }
+    sockInUseMap[WINC_SOCK_PTR_TO_IDX(pSockCtx) / 32U] |= ((uint32_t)1U << (WINC_SOCK_PTR_TO_IDX(pSockCtx) % 32U));
 
-            if (WINC_STATUS_OK == statusCode)
-            {
-                if ((true == pSockCtx->connected) || (true == pSockCtx->newRecvData))
-                {
-                    /* Perform another device read, only if connected or data waiting. */
-                    (void)sockRead(pSockCtx);
-                }
-            }
+    sockSetID(pSockCtx, sockId);
 
-            break;
-        }
+#if WINC_SOCK_SLAB_ALLOC_MODE == 1
+    pSockCtx->pSlabAllocCtx = pGlobalSlabAllocCtx;
+#endif
+#if WINC_SOCK_SLAB_ALLOC_MODE == 2
+    numSlabs = slabCalcNumSlabs(initData.slabSize, pSockCtx->recvBufSz) +
+               slabCalcNumSlabs(initData.slabSize, pSockCtx->sendBufSz);
 
-        default:
-        {
-            /* Do nothing. */
-            break;
-        }
+    if (SOCK_DGRAM == type)
+    {
+        numSlabs +=
+            slabCalcNumSlabs(initData.slabSize, sizeof(WINC_SOCK_UDP_PKT_BUFFER) + (sizeof(WINC_SOCK_UDP_PKT) * pSockCtx->numRxPkts)) +
+            slabCalcNumSlabs(initData.slabSize, sizeof(WINC_SOCK_UDP_PKT_BUFFER) + (sizeof(WINC_SOCK_UDP_PKT) * pSockCtx->numTxPkts));
+    }
+
+    pSockCtx->pSlabAllocCtx = slabInit(initData.slabSize, numSlabs);
+#endif
+    if (NULL == pSockCtx->pSlabAllocCtx)
+    {
+        return false;
     }
+
+    return true;
 }
 
-//*******************************************************************************
-/*
+/*****************************************************************************
   Description:
-    Processes command responses received via WINC_DEV_CMDREQ_EVENT_RSP_RECEIVED events.
+    Complete a constant payload send.
 
   Parameters:
-    pSockCtx     - Pointer to socket context.
-    rspId        - Response command ID.
-    cmdReqHandle - Command request handle.
-    pSrcCmd      - Pointer to source command.
-    numElems     - Number of elements in response.
-    pElems       - Pointer to response elements.
+    pSockCtx - Pointer to socket context
+    status   - Completion status
 
   Returns:
     None.
 
   Remarks:
-    None.
+    The payload is no longer referenced once this is called, the callback
+    receives the length of data acknowledged by the device.
 
-*/
+ *****************************************************************************/
 
-static void sockProcessCmdRsp
-(
-    WINC_SOCK_CTX *pSockCtx,
-    uint16_t rspId,
-    WINC_CMD_REQ_HANDLE cmdReqHandle,
-    const WINC_DEV_EVENT_SRC_CMD *const pSrcCmd,
-    int numElems,
-    const WINC_DEV_PARAM_ELEM *const pElems
-)
+static void sockSendConstComplete(WINC_SOCK_CTX *pSockCtx, WINC_SOCKET_STATUS status)
 {
-    if ((NULL == pSockCtx) || (NULL == pElems) || (NULL == pSrcCmd))
+    WINC_SOCK_SEND_CONST_CALLBACK pfConstComplete = pSockCtx->pfConstComplete;
+    const uint8_t *pConstData = pSockCtx->pConstData;
+    size_t constAcked = pSockCtx->constAcked;
+
+    pSockCtx->pConstData      = NULL;
+    pSockCtx->constLen        = 0;
+    pSockCtx->constSent       = 0;
+    pSockCtx->constAcked      = 0;
+    pSockCtx->pfConstComplete = NULL;
+
+    if (NULL != pfConstComplete)
     {
-        return;
+        pfConstComplete(pSockCtx->constCompleteCtx, WINC_SOCK_PTR_TO_HANDLE(pSockCtx), pConstData, constAcked, status);
     }
+}
 
-    switch (rspId)
-    {
-        case WINC_CMD_ID_SOCKO:
-        {
-            if (1U != numElems)
-            {
-                break;
-            }
+/*****************************************************************************
+  Description:
+    Free the use of a socket context.
 
-            /* Read the socket ID from the SOCKO response. */
-            if (0U == pSockCtx->sockId)
-            {
-                (void)WINC_CmdReadParamElem(&pElems[0], WINC_TYPE_INTEGER, &pSockCtx->sockId, sizeof(pSockCtx->sockId));
+  Parameters:
+    pSockCtx - Pointer to socket context to release.
 
-                WINC_TRACE_PRINT("Socket ID is %d (%04x)\n", pSockCtx->sockId, pSockCtx->sockId);
-            }
+  Returns:
+    None.
 
-            break;
-        }
+  Remarks:
 
-        case WINC_CMD_ID_SOCKRD:
-        {
-            uint16_t sockId;
-            uint16_t length;
-            uint16_t reqLength;
-            WINC_DEV_PARAM_ELEM elems[10];
+ *****************************************************************************/
 
-            /* Read the socket ID and verify it matches this socket. */
-            (void)WINC_CmdReadParamElem(&pElems[0], WINC_TYPE_INTEGER, &sockId, sizeof(sockId));
+static void sockDestroySocket(WINC_SOCK_CTX *pSockCtx)
+{
+    if (NULL == pSockCtx)
+    {
+        return;
+    }
 
-            /* Unpack original command parameters. */
-            if (false == WINC_DevUnpackElements(pSrcCmd->numParams, pSrcCmd->pParams, elems))
-            {
-                break;
-            }
+    if (false == pSockCtx->inUse)
+    {
+        return;
+    }
 
-            (void)WINC_CmdReadParamElem(&elems[2], WINC_TYPE_INTEGER, &reqLength, sizeof(reqLength));
+    /* Release any allocated buffer. */
+    slabFree(pSockCtx->pSlabAllocCtx, pSockCtx->recvBuffer.pData);
+    slabFree(pSockCtx->pSlabAllocCtx, pSockCtx->sendBuffer.pData);
+    slabFree(pSockCtx->pSlabAllocCtx, pSockCtx->recvBuffer.pUdpPktBuffers);
+    slabFree(pSockCtx->pSlabAllocCtx, pSockCtx->sendBuffer.pUdpPktBuffers);
 
-            if (sockId == pSockCtx->sockId)
-            {
-                SOCKADDR_UNION *pSourceAddr = NULL;
-                SOCKADDR_UNION sourceAddr;
+#if WINC_SOCK_SLAB_ALLOC_MODE == 2
+    if (NULL != initData.pfMemFree)
+    {
+        initData.pfMemFree(pSockCtx->pSlabAllocCtx);
+    }
+#endif
 
-                /* Read the data length of the SOCKRD response. */
-                (void)WINC_CmdReadParamElem(&pElems[1], WINC_TYPE_INTEGER, &length, sizeof(length));
+    if (NULL != pSockCtx->pConstData)
+    {
+        sockSendConstComplete(pSockCtx, WINC_SOCKET_STATUS_ERROR);
+    }
 
-                if (length != reqLength)
-                {
-                    WINC_ERROR_PRINT("Error, length mismatch %d vs %d\n", length, reqLength);
-                }
+    WINC_CONF_LOCK_DESTROY(&pSockCtx->accessMutex);
 
-                if (numElems >= 4U)
-                {
-                    /* For extended SOCKRD response, read the pending data count and update the socket context. */
-                    (void)WINC_CmdReadParamElem(&pElems[2], WINC_TYPE_INTEGER, &pSockCtx->pendingRecvDataLen, sizeof(pSockCtx->pendingRecvDataLen));
+    sockListenRemove(pSockCtx);
+    sockSetID(pSockCtx, 0);
 
-                    WINC_TRACE_PRINT("SP %d\n", pSockCtx->pendingRecvDataLen);
+    sockInUseMap[WINC_SOCK_PTR_TO_IDX(pSockCtx) / 32U] &= ~((uint32_t)1U << (WINC_SOCK_PTR_TO_IDX(pSockCtx) % 32U));
+    sockSeqNumMap[WINC_SOCK_PTR_TO_IDX(pSockCtx) / 32U] &= ~((uint32_t)1U << (WINC_SOCK_PTR_TO_IDX(pSockCtx) % 32U));
+#ifdef WINC_SOCK_CORK_TIMEOUT_ENABLE
+    sockCorkMap[WINC_SOCK_PTR_TO_IDX(pSockCtx) / 32U] &= ~((uint32_t)1U << (WINC_SOCK_PTR_TO_IDX(pSockCtx) % 32U));
+#endif
 
-                    if (7U == numElems)
-                    {
-                        /* For UDP datagram reads read out the address information received. */
-                        if (NULL == pSockCtx->recvBuffer.pUdpPktBuffers)
-                        {
-                            WINC_ERROR_PRINT("error: no allocated packet buffers\n");
-                            break;
-                        }
+    (void)memset(pSockCtx, 0, sizeof(WINC_SOCK_CTX));
 
-                        /* Check we have packet buffers to store the datagram into. */
-                        if (pSockCtx->recvBuffer.pUdpPktBuffers->pktDepth == pSockCtx->recvBuffer.pUdpPktBuffers->numPkts)
-                        {
-                            WINC_ERROR_PRINT("error: packet buffers full\n");
-                            break;
-                        }
+    sockPollSignal();
+}
 
-                        pSourceAddr = &sourceAddr;
+/*****************************************************************************
+  Description:
+    Lock access to a socket context.
 
-                        /* Read the source address. */
-                        if (WINC_TYPE_IPV4ADDR == pElems[4].type)
-                        {
-                            pSourceAddr->in4.sin_family = AF_INET;
+  Parameters:
+    pSockCtx - Pointer to socket context to lock.
 
-                            (void)WINC_CmdReadParamElem(&pElems[4], WINC_TYPE_IPV4ADDR, &pSourceAddr->in4.sin_addr, sizeof(struct in_addr));
-                            (void)WINC_CmdReadParamElem(&pElems[5], WINC_TYPE_INTEGER, &pSourceAddr->in4.sin_port, sizeof(in_port_t));
+  Returns:
+    None.
 
-                            pSourceAddr->in4.sin_port = htons(pSourceAddr->in4.sin_port);
-                        }
-                        else if (WINC_TYPE_IPV6ADDR == pElems[4].type)
-                        {
-                            pSourceAddr->in6.sin6_family = AF_INET6;
+  Remarks:
 
-                            (void)WINC_CmdReadParamElem(&pElems[4], WINC_TYPE_IPV6ADDR, &pSourceAddr->in6.sin6_addr, sizeof(struct in6_addr));
-                            (void)WINC_CmdReadParamElem(&pElems[5], WINC_TYPE_INTEGER, &pSourceAddr->in6.sin6_port, sizeof(in_port_t));
+ *****************************************************************************/
 
-                            pSourceAddr->in6.sin6_port = htons(pSourceAddr->in6.sin6_port);
-                        }
-                        else
-                        {
-                            WINC_ERROR_PRINT("error: unknown address type (%d)\n", pElems[4].type);
-                            break;
-                        }
-                    }
-                }
-                else
-                {
-                    pSockCtx->pendingRecvDataLen -= length;
-                    WINC_TRACE_PRINT("SP %d (-%d)\n", pSockCtx->pendingRecvDataLen, length);
-                }
+static bool sockLockSocket(WINC_SOCK_CTX *pSockCtx)
+{
+    if (NULL == pSockCtx)
+    {
+        return false;
+    }
 
-                /* Write the received data into the socket buffer for the application to pull. */
-                if (true == sockBufferWrite(&pSockCtx->recvBuffer, pElems[numElems-1U].pData, length, pSourceAddr, true))
-                {
-                    WINC_TRACE_PRINT("SR-: %d - %d\n", pSockCtx->recvBuffer.outstandingDataLen, length);
-                    pSockCtx->recvBuffer.outstandingDataLen -= length;
-                    pSockCtx->newRecvData = true;
-                }
-                else
-                {
-                    WINC_ERROR_PRINT("error: failed to write to receive buffer\n");
-                }
-            }
+    if (false == pSockCtx->inUse)
+    {
+        return false;
+    }
 
-            break;
-        }
+    if (false == WINC_CONF_LOCK_ENTER(&pSockCtx->accessMutex))
+    {
+        return false;
+    }
 
-        case WINC_CMD_ID_SOCKC:
-        {
-            uint8_t id;
-            int32_t value;
+    return true;
+}
 
-            if (2U != numElems)
-            {
-                break;
-            }
+#ifdef WINC_SOCK_BUF_AUTOTUNE_ENABLE
+/*****************************************************************************
+  Description:
+    Try to lock access to a socket context without blocking.
 
-            (void)WINC_CmdReadParamElem(&pElems[0], WINC_TYPE_INTEGER, &id, sizeof(id));
-            (void)WINC_CmdReadParamElem(&pElems[1], WINC_TYPE_INTEGER, &value, sizeof(value));
+  Parameters:
+    pSockCtx - Pointer to socket context to lock.
 
-            WINC_TRACE_PRINT("Sock ID %04x CFG: %2d = %d\n", pSockCtx->sockId, id, value);
-            break;
-        }
+  Returns:
+    true if the socket was locked, false if it is not in use or busy.
 
-        default:
-        {
-            /* Do nothing. */
-            break;
-        }
+  Remarks:
+    Used when another socket is already locked, blocking here could deadlock
+    with a thread holding this socket and waiting for the other. Without
+    WINC_CONF_LOCK_TRY_ENTER this always fails when real locks are in use.
+
+ *****************************************************************************/
+
+static bool sockTryLockSocket(WINC_SOCK_CTX *pSockCtx)
+{
+    if (NULL == pSockCtx)
+    {
+        return false;
+    }
+
+    if (false == pSockCtx->inUse)
+    {
+        return false;
+    }
+
+    if (false == WINC_CONF_LOCK_TRY_ENTER(&pSockCtx->accessMutex))
+    {
+        return false;
     }
+
+    return true;
 }
+#endif
 
-//*******************************************************************************
-/*
+/*****************************************************************************
   Description:
-    Processes AECs for sockets.
+    Unlock access to a socket context.
 
   Parameters:
-    sockId   - Socket ID.
-    pSockCtx - Pointer to socket context.
-    aecId    - AEC ID.
-    numElems - Number of elements.
-    pElems   - Pointer to elements.
+    pSockCtx - Pointer to socket context to lock.
 
   Returns:
     None.
 
   Remarks:
-    None.
 
-*/
+ *****************************************************************************/
 
-static void sockProcessAEC
-(
-    uint16_t sockId,
-    WINC_SOCK_CTX *pSockCtx,
-    uint16_t aecId,
-    int numElems,
-    const WINC_DEV_PARAM_ELEM *const pElems
-)
+static void sockUnlockSocket(WINC_SOCK_CTX *pSockCtx)
 {
-    if (NULL == pElems)
+    if (NULL == pSockCtx)
     {
         return;
     }
 
-    switch (aecId)
+    if (false == pSockCtx->inUse)
     {
-        case WINC_AEC_ID_SOCKIND:
-        {
-            WINC_SOCK_CTX *pListeningSockCtx;
-            bool newSocket = false;
+        return;
+    }
 
-            if (5U != numElems)
-            {
-                break;
-            }
+    WINC_CONF_LOCK_LEAVE(&pSockCtx->accessMutex);
+}
 
-            if (NULL == pSockCtx)
-            {
-                /* Socket ID not recognised, need to add for TCP server. */
-                pSockCtx = sockFindFreeSocket();
+#ifdef WINC_SOCK_BUF_AUTOTUNE_ENABLE
+/*****************************************************************************
+  Description:
+    Check if memory is available to allocate a socket buffer.
 
-                if (NULL == pSockCtx)
-                {
-                    WINC_ERROR_PRINT("error: no free sockets\n");
-                    break;
-                }
+  Parameters:
+    pSlabAllocCtx - Pointer to slab context
+    size          - Size of buffer to allocate
+    reserve       - Memory which must remain free after the allocation
 
-                if (false == sockCreateSocket(pSockCtx, SOCK_STREAM, sockId))
-                {
-                    WINC_ERROR_PRINT("error: failed to create new receive socket\n");
-                    return;
-                }
+  Returns:
+    true or false.
 
-                if (false == sockLockSocket(pSockCtx))
-                {
-                    return;
-                }
+  Remarks:
 
-                newSocket = true;
-            }
+ *****************************************************************************/
 
-            /* Check socket address types match. */
-            if (pElems[1].type != pElems[3].type)
-            {
-                WINC_ERROR_PRINT("error: address type mismatch (%d != %d)\n", pElems[1].type, pElems[3].type);
-            }
+static bool sockBufTuneAvailable(const WINC_SOCK_SLAB_CTX *pSlabAllocCtx, size_t size, size_t reserve)
+{
+    size_t reqSlabs;
 
-            if (WINC_TYPE_IPV4ADDR == pElems[1].type)
-            {
-                /* Extract and store local and remote IPv4 addresses. */
-                pSockCtx->localEndPt.in4.sin_family = AF_INET;
+    reqSlabs = (size + (pSlabAllocCtx->slabSize-1U)) / pSlabAllocCtx->slabSize;
 
-                (void)WINC_CmdReadParamElem(&pElems[1], WINC_TYPE_IPV4ADDR, &pSockCtx->localEndPt.in4.sin_addr, sizeof(struct in_addr));
-                (void)WINC_CmdReadParamElem(&pElems[2], WINC_TYPE_INTEGER, &pSockCtx->localEndPt.in4.sin_port, sizeof(in_port_t));
+    if ((pSlabAllocCtx->numFree < 0) || (reqSlabs > (size_t)pSlabAllocCtx->numFree))
+    {
+        return false;
+    }
 
-                pSockCtx->localEndPt.in4.sin_port = htons(pSockCtx->localEndPt.in4.sin_port);
+    return ((((size_t)pSlabAllocCtx->numFree - reqSlabs) * pSlabAllocCtx->slabSize) >= reserve);
+}
 
-                pSockCtx->remoteEndPt.in4.sin_family = AF_INET;
+/*****************************************************************************
+  Description:
+    Resize a stream socket buffer.
 
-                (void)WINC_CmdReadParamElem(&pElems[3], WINC_TYPE_IPV4ADDR, &pSockCtx->remoteEndPt.in4.sin_addr, sizeof(struct in_addr));
-                (void)WINC_CmdReadParamElem(&pElems[4], WINC_TYPE_INTEGER, &pSockCtx->remoteEndPt.in4.sin_port, sizeof(in_port_t));
+  Parameters:
+    pSockCtx - Pointer to socket context
+    pBuffer  - Pointer to socket buffer
+    newSize  - New size of buffer
 
-                pSockCtx->remoteEndPt.in4.sin_port = htons(pSockCtx->remoteEndPt.in4.sin_port);
-            }
-            else if (WINC_TYPE_IPV6ADDR == pElems[1].type)
-            {
-                /* Extract and store local and remote IPv6 addresses. */
-                pSockCtx->localEndPt.in6.sin6_family = AF_INET6;
+  Returns:
+    true or false indicating success or failure.
 
-                (void)WINC_CmdReadParamElem(&pElems[1], WINC_TYPE_IPV6ADDR, &pSockCtx->localEndPt.in6.sin6_addr, sizeof(struct in6_addr));
-                (void)WINC_CmdReadParamElem(&pElems[2], WINC_TYPE_INTEGER, &pSockCtx->localEndPt.in6.sin6_port, sizeof(in_port_t));
+  Remarks:
+    Data held is moved to the start of the new buffer, the caller must ensure
+    the new size can hold it and any outstanding reads. On failure the buffer
+    is unchanged.
 
-                pSockCtx->localEndPt.in6.sin6_port = htons(pSockCtx->localEndPt.in6.sin6_port);
+ *****************************************************************************/
 
-                pSockCtx->remoteEndPt.in6.sin6_family = AF_INET6;
+static bool sockBufferResize(WINC_SOCK_CTX *pSockCtx, WINC_SOCK_BUFFER *pBuffer, size_t newSize)
+{
+    uint8_t *pData;
 
-                (void)WINC_CmdReadParamElem(&pElems[3], WINC_TYPE_IPV6ADDR, &pSockCtx->remoteEndPt.in6.sin6_addr, sizeof(struct in6_addr));
-                (void)WINC_CmdReadParamElem(&pElems[4], WINC_TYPE_INTEGER, &pSockCtx->remoteEndPt.in6.sin6_port, sizeof(in_port_t));
+    pData = slabAlloc(pSockCtx->pSlabAllocCtx, newSize);
 
-                pSockCtx->remoteEndPt.in6.sin6_port = htons(pSockCtx->remoteEndPt.in6.sin6_port);
-            }
-            else
-            {
-                WINC_ERROR_PRINT("error: unknown address type (%d)\n", pElems[1].type);
-                break;
-            }
+    if (NULL == pData)
+    {
+        return false;
+    }
 
-            if (false == pSockCtx->tlsPending)
-            {
-                pSockCtx->connected = true;
-            }
+    if (pBuffer->length > 0U)
+    {
+        (void)sockBufferRead(pBuffer, pData, pBuffer->length, NULL, 0, true, NULL);
+    }
 
-            if (true == newSocket)
-            {
-                /* A new socket was created, find the listening socket it goes with. */
-                pListeningSockCtx = sockFindListeningSocket(pSockCtx);
+    slabFree(pSockCtx->pSlabAllocCtx, pBuffer->pData);
 
-                if (NULL == pListeningSockCtx)
-                {
-                    WINC_ERROR_PRINT("error: unable to find listening socket\n");
-                    sockDestroySocket(pSockCtx);
-                    pSockCtx = NULL;
-                    break;
-                }
+    WINC_TRACE_PRINT("SB %d -> %d\n", pBuffer->totalSize, newSize);
 
-                if (false == sockLockSocket(pListeningSockCtx))
-                {
-                    sockDestroySocket(pSockCtx);
-                    pSockCtx = NULL;
-                    break;
-                }
+    pBuffer->pData     = pData;
+    pBuffer->totalSize = (uint16_t)newSize;
+    pBuffer->outOffset = 0;
+    pBuffer->inOffset  = (pBuffer->length < newSize) ? pBuffer->length : 0U;
 
-                /* Send connect request event. */
-                sockEventCallback(pListeningSockCtx, WINC_SOCKET_EVENT_CONNECT_REQ, WINC_SOCKET_STATUS_OK);
+    return true;
+}
 
-                /* Copy configuration from listening socket. */
-                pSockCtx->readMode  = pListeningSockCtx->readMode;
-                pSockCtx->domain    = pListeningSockCtx->domain;
-                pSockCtx->protocol  = pListeningSockCtx->protocol;
-                pSockCtx->recvBufSz = pListeningSockCtx->recvBufSz;
-                pSockCtx->sendBufSz = pListeningSockCtx->sendBufSz;
-                pSockCtx->numRxPkts = pListeningSockCtx->numRxPkts;
-                pSockCtx->numTxPkts = pListeningSockCtx->numTxPkts;
+/*****************************************************************************
+  Description:
+    Check if a stream socket buffer is idle.
 
-                sockUnlockSocket(pListeningSockCtx);
-                sockUnlockSocket(pSockCtx);
-            }
-            else if (true == pSockCtx->connected)
-            {
-                /* Send connect event. */
-                sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_CONNECT, WINC_SOCKET_STATUS_OK);
-            }
-            else
-            {
-                /* Do nothing. */
-            }
+  Parameters:
+    pBuffer     - Pointer to socket buffer
+    minSize     - Minimum size of buffer
+    elapsedTime - Time in milliseconds since the last search
 
-            WINC_TRACE_PRINT("Socket ID is %d (%04x)\n", pSockCtx->sockId, pSockCtx->sockId);
+  Returns:
+    true or false.
 
-            break;
-        }
+  Remarks:
+    A buffer is idle if it is larger than the minimum size, empty and less
+    than the minimum size has been drained from it since the last search,
+    or with a time source, less than the minimum size per
+    WINC_SOCK_BUF_TUNE_IDLE_MS.
 
-        case WINC_AEC_ID_SOCKRXT:
-        {
-            if (NULL == pSockCtx)
-            {
-                break;
-            }
+ *****************************************************************************/
 
-            if (WINC_SOCKET_ASYNC_MODE_OFF == (WINC_SOCKET_ASYNC_MODE_TYPE)pSockCtx->readMode)
-            {
-                if (2U != numElems)
-                {
-                    break;
-                }
+static bool sockBufTuneIdle(const WINC_SOCK_BUFFER *pBuffer, size_t minSize, uint32_t elapsedTime)
+{
+    if ((NULL == pBuffer->pData) || (pBuffer->totalSize <= minSize))
+    {
+        return false;
+    }
 
-                /* Read the new pending data length values. */
-                (void)WINC_CmdReadParamElem(&pElems[1], WINC_TYPE_INTEGER, &pSockCtx->pendingRecvDataLen, sizeof(uint16_t));
+    if ((0U != pBuffer->length) || (0U != pBuffer->outstandingDataLen))
+    {
+        return false;
+    }
 
-                WINC_TRACE_PRINT("RXT %d\n", pSockCtx->pendingRecvDataLen);
+#ifdef WINC_SOCK_POLL_TIMEOUT_ENABLE
+    if (elapsedTime < WINC_SOCK_BUF_TUNE_IDLE_MS)
+    {
+        elapsedTime = WINC_SOCK_BUF_TUNE_IDLE_MS;
+    }
 
-                /* Trigger a socket read from device. */
-                (void)sockRead(pSockCtx);
-            }
-            else
-            {
-                if ((4U == numElems) || (3U == numElems))
-                {
-                    uint16_t length;
-                    uint16_t seqNum;
+    return (((uint64_t)pBuffer->tuneIdleLen * WINC_SOCK_BUF_TUNE_IDLE_MS) < ((uint64_t)minSize * elapsedTime));
+#else
+    (void)elapsedTime;
 
-                    (void)WINC_CmdReadParamElem(&pElems[1], WINC_TYPE_INTEGER_UNSIGNED, &length, sizeof(length));
+    return (pBuffer->tuneIdleLen < minSize);
+#endif
+}
 
-                    if (4U == numElems)
-                    {
-                        (void)WINC_CmdReadParamElem(&pElems[2], WINC_TYPE_INTEGER_UNSIGNED, &seqNum, sizeof(seqNum));
+/*****************************************************************************
+  Description:
+    Shrink the buffers of idle stream sockets.
 
-                        WINC_TRACE_PRINT("RXT %d %d\n", seqNum, length);
-                    }
-                    else
-                    {
-                        WINC_TRACE_PRINT("RXT %d\n", length);
-                    }
+  Parameters:
+    pReqSockCtx - Pointer to socket context requiring memory, must be locked
+    pReqBuffer  - Pointer to buffer requiring memory, or NULL
 
-                    /* Write the received data into the socket buffer for the application to pull. */
-                    if (true == sockBufferWrite(&pSockCtx->recvBuffer, pElems[numElems-1U].pData, length, NULL, true))
-                    {
-                        pSockCtx->newRecvData = true;
+  Returns:
+    None.
 
-                        sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_RECV, WINC_SOCKET_STATUS_OK);
-                    }
-                    else
-                    {
-                        WINC_ERROR_PRINT("error: failed to write to receive buffer\n");
-                    }
-                }
-            }
+  Remarks:
+    Idle buffers are shrunk to their minimum size. The drained counts of all
+    buffers are reset so the next search measures a new interval. Other
+    sockets are only try-locked, as the requesting socket is already locked,
+    busy sockets are skipped.
 
-            break;
-        }
+ *****************************************************************************/
 
-        case WINC_AEC_ID_SOCKRXU:
+static void sockBufTuneReclaim(WINC_SOCK_CTX *pReqSockCtx, const WINC_SOCK_BUFFER *pReqBuffer)
+{
+    uint32_t elapsedTime = 0;
+    int idx;
+
+#ifdef WINC_SOCK_POLL_TIMEOUT_ENABLE
+    uint32_t timeNow = WINC_CONF_TIME_MS_GET();
+
+    elapsedTime         = timeNow - sockBufTuneIdleTime;
+    sockBufTuneIdleTime = timeNow;
+#endif
+
+    idx = sockMapNext(sockInUseMap, 0);
+
+    while (idx >= 0)
+    {
+        WINC_SOCK_CTX *pSockCtx = &wincSockets[idx];
+
+        if ((pSockCtx == pReqSockCtx) || (true == sockTryLockSocket(pSockCtx)))
         {
-            if (NULL == pSockCtx)
+            if ((SOCK_STREAM == pSockCtx->type) && (pSockCtx->pSlabAllocCtx == pReqSockCtx->pSlabAllocCtx))
             {
-                break;
+                if ((&pSockCtx->recvBuffer != pReqBuffer) && (WINC_SOCKET_ASYNC_MODE_OFF == (WINC_SOCKET_ASYNC_MODE_TYPE)pSockCtx->readMode) &&
+                    (0U == pSockCtx->numReadsOutstanding) && (0U == pSockCtx->recvBorrowLen) && (true == sockBufTuneIdle(&pSockCtx->recvBuffer, WINC_SOCK_BUF_RX_MIN_SZ, elapsedTime)))
+                {
+                    (void)sockBufferResize(pSockCtx, &pSockCtx->recvBuffer, WINC_SOCK_BUF_RX_MIN_SZ);
+#ifdef WINC_SOCK_POLL_TIMEOUT_ENABLE
+                    pSockCtx->recvBuffer.tuneGrowRate = 0;
+#endif
+                }
+
+                if ((&pSockCtx->sendBuffer != pReqBuffer) && (true == sockBufTuneIdle(&pSockCtx->sendBuffer, WINC_SOCK_BUF_TX_MIN_SZ, elapsedTime)))
+                {
+                    (void)sockBufferResize(pSockCtx, &pSockCtx->sendBuffer, WINC_SOCK_BUF_TX_MIN_SZ);
+#ifdef WINC_SOCK_POLL_TIMEOUT_ENABLE
+                    pSockCtx->sendBuffer.tuneGrowRate = 0;
+#endif
+                }
+
+                pSockCtx->recvBuffer.tuneIdleLen = 0;
+                pSockCtx->sendBuffer.tuneIdleLen = 0;
             }
 
-            if (WINC_SOCKET_ASYNC_MODE_OFF == (WINC_SOCKET_ASYNC_MODE_TYPE)pSockCtx->readMode)
+            if (pSockCtx != pReqSockCtx)
             {
-                /* Read the new pending data length values. */
-                (void)WINC_CmdReadParamElem(&pElems[3], WINC_TYPE_INTEGER, &pSockCtx->pendingRecvDataLen, sizeof(uint16_t));
+                sockUnlockSocket(pSockCtx);
+            }
+        }
 
-                WINC_TRACE_PRINT("RXU %d\n", pSockCtx->pendingRecvDataLen);
+        idx = sockMapNext(sockInUseMap, (unsigned int)idx + 1U);
+    }
+}
 
-                /* Trigger a socket read from device. */
-                (void)sockRead(pSockCtx);
-            }
-            else
-            {
-                if ((6U == numElems) || (5U == numElems))
-                {
-                    SOCKADDR_UNION *pSourceAddr = NULL;
-                    SOCKADDR_UNION sourceAddr;
-                    uint16_t length;
-                    uint16_t seqNum;
+/*****************************************************************************
+  Description:
+    Calculate the slab memory of the write command requests for a send buffer.
 
-                    if (NULL == pSockCtx->recvBuffer.pUdpPktBuffers)
-                    {
-                        WINC_ERROR_PRINT("error: no allocated packet buffers\n");
-                        break;
-                    }
+  Parameters:
+    pSlabAllocCtx - Pointer to slab context
+    size          - Size of send buffer
 
-                    /* Check we have packet buffers to store the datagram into. */
-                    if (pSockCtx->recvBuffer.pUdpPktBuffers->pktDepth == pSockCtx->recvBuffer.pUdpPktBuffers->numPkts)
-                    {
-                        WINC_ERROR_PRINT("error: packet buffers full\n");
-                        break;
-                    }
+  Returns:
+    Memory used by the write command requests when the whole buffer is in
+    flight.
 
-                    pSourceAddr = &sourceAddr;
+  Remarks:
+    Each write carries at most MAX_TCP_SOCK_PAYLOAD_SZ bytes, its command
+    request is rounded up to whole slabs.
 
-                    /* Read the source address. */
-                    if (WINC_TYPE_IPV4ADDR == pElems[1].type)
-                    {
-                        pSourceAddr->in4.sin_family = AF_INET;
+ *****************************************************************************/
 
-                        (void)WINC_CmdReadParamElem(&pElems[1], WINC_TYPE_IPV4ADDR, &pSourceAddr->in4.sin_addr, sizeof(struct in_addr));
-                        (void)WINC_CmdReadParamElem(&pElems[2], WINC_TYPE_INTEGER, &pSourceAddr->in4.sin_port, sizeof(in_port_t));
+static size_t sockBufTuneWriteMem(const WINC_SOCK_SLAB_CTX *pSlabAllocCtx, size_t size)
+{
+    size_t numWrites = (size + (MAX_TCP_SOCK_PAYLOAD_SZ-1U)) / MAX_TCP_SOCK_PAYLOAD_SZ;
 
-                        pSourceAddr->in4.sin_port = htons(pSourceAddr->in4.sin_port);
-                    }
-                    else if (WINC_TYPE_IPV6ADDR == pElems[1].type)
-                    {
-                        pSourceAddr->in6.sin6_family = AF_INET6;
+    return numWrites * (size_t)slabCalcNumSlabs(pSlabAllocCtx->slabSize, WINC_SOCK_CMD_REQ_SZ(160U+MAX_TCP_SOCK_PAYLOAD_SZ, 1)) * pSlabAllocCtx->slabSize;
+}
 
-                        (void)WINC_CmdReadParamElem(&pElems[1], WINC_TYPE_IPV6ADDR, &pSourceAddr->in6.sin6_addr, sizeof(struct in6_addr));
-                        (void)WINC_CmdReadParamElem(&pElems[2], WINC_TYPE_INTEGER, &pSourceAddr->in6.sin6_port, sizeof(in_port_t));
+/*****************************************************************************
+  Description:
+    Grow a stream socket buffer.
 
-                        pSourceAddr->in6.sin6_port = htons(pSourceAddr->in6.sin6_port);
-                    }
-                    else
-                    {
-                        WINC_ERROR_PRINT("error: unknown address type (%d)\n", pElems[1].type);
-                        break;
-                    }
+  Parameters:
+    pSockCtx - Pointer to socket context, must be locked
+    pBuffer  - Pointer to socket buffer
+    reqSize  - Minimum size required
+    maxSize  - Maximum size of buffer
 
-                    (void)WINC_CmdReadParamElem(&pElems[3], WINC_TYPE_INTEGER_UNSIGNED, &length, sizeof(length));
+  Returns:
+    true if the buffer was grown.
 
-                    if (6U == numElems)
-                    {
-                        (void)WINC_CmdReadParamElem(&pElems[4], WINC_TYPE_INTEGER_UNSIGNED, &seqNum, sizeof(seqNum));
+  Remarks:
+    The size is at least doubled, rounded up to whole slabs and limited to
+    maxSize. Idle buffers are shrunk if growing would leave less than
+    WINC_SOCK_BUF_TUNE_RESERVE_SZ free, or if there is no free run of slabs
+    for the new buffer alongside the current one. Send buffers also need
+    room for the write command requests carrying the extra data.
 
-                        WINC_TRACE_PRINT("RXU %d %d\n", seqNum, length);
-                    }
-                    else
-                    {
-                        WINC_TRACE_PRINT("RXU %d\n", length);
-                    }
+ *****************************************************************************/
 
-                    /* Write the received data into the socket buffer for the application to pull. */
-                    if (true == sockBufferWrite(&pSockCtx->recvBuffer, pElems[numElems-1U].pData, length, pSourceAddr, true))
-                    {
-                        pSockCtx->newRecvData = true;
+static bool sockBufTuneGrow(WINC_SOCK_CTX *pSockCtx, WINC_SOCK_BUFFER *pBuffer, size_t reqSize, size_t maxSize)
+{
+    const WINC_SOCK_SLAB_CTX *pSlabAllocCtx = pSockCtx->pSlabAllocCtx;
+    size_t newSize;
+    size_t reqMem;
 
-                        sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_RECV, WINC_SOCKET_STATUS_OK);
-                    }
-                    else
-                    {
-                        WINC_ERROR_PRINT("error: failed to write to receive buffer\n");
-                    }
-                }
-            }
+    if (NULL == pBuffer->pData)
+    {
+        return false;
+    }
 
-            break;
-        }
+    newSize = (size_t)pBuffer->totalSize * 2U;
 
-        case WINC_AEC_ID_SOCKCL:
+    if (newSize < reqSize)
+    {
+        newSize = reqSize;
+    }
+
+    /* Use all of the memory in the slabs allocated. */
+    newSize = ((newSize + (pSlabAllocCtx->slabSize-1U)) / pSlabAllocCtx->slabSize) * pSlabAllocCtx->slabSize;
+
+    if (newSize > maxSize)
+    {
+        newSize = maxSize;
+    }
+
+    if (newSize <= pBuffer->totalSize)
+    {
+        return false;
+    }
+
+    /* The current buffer is freed once its data has been moved. */
+    reqMem = newSize - pBuffer->totalSize;
+
+    /* Data in flight from a send buffer is copied into write command
+       requests, which are allocated from the same slabs. Those carrying
+       the current buffer's data may already be allocated. */
+    if (&pSockCtx->sendBuffer == pBuffer)
+    {
+        reqMem += sockBufTuneWriteMem(pSlabAllocCtx, newSize) - sockBufTuneWriteMem(pSlabAllocCtx, pBuffer->totalSize);
+    }
+
+    if ((false == sockBufTuneAvailable(pSlabAllocCtx, reqMem, WINC_SOCK_BUF_TUNE_RESERVE_SZ)) ||
+        (slabFindFree(pSlabAllocCtx, slabCalcNumSlabs(pSlabAllocCtx->slabSize, newSize)) < 0))
+    {
+        sockBufTuneReclaim(pSockCtx, pBuffer);
+
+        if ((false == sockBufTuneAvailable(pSlabAllocCtx, reqMem, WINC_SOCK_BUF_TUNE_RESERVE_SZ)) ||
+            (slabFindFree(pSlabAllocCtx, slabCalcNumSlabs(pSlabAllocCtx->slabSize, newSize)) < 0))
         {
-            if (1U != numElems)
-            {
-                break;
-            }
+            return false;
+        }
+    }
 
-            if (NULL != pSockCtx)
-            {
-                /* Disconnect the socket. */
-                pSockCtx->connected = false;
-                pSockCtx->events   |= POLLHUP;
-            }
-            break;
+    return sockBufferResize(pSockCtx, pBuffer, newSize);
+}
+
+/*****************************************************************************
+  Description:
+    Account for data drained from a stream socket buffer.
+
+  Parameters:
+    pSockCtx - Pointer to socket context, must be locked
+    pBuffer  - Pointer to socket buffer
+    length   - Length of data drained
+    maxSize  - Maximum size of buffer
+
+  Returns:
+    None.
+
+  Remarks:
+    Each time a buffer's worth of data has been drained the buffer is grown
+    if, during that interval, its space limited the data in flight while the
+    application was waiting on it. A buffer which is not drained quickly
+    enough is never grown, nor is one whose application keeps it full. With
+    a time source the drain rate of the interval must also have risen since
+    the buffer was last grown, growing stops once a larger buffer no longer
+    moves data faster.
+
+ *****************************************************************************/
+
+static void sockBufTuneDrained(WINC_SOCK_CTX *pSockCtx, WINC_SOCK_BUFFER *pBuffer, size_t length, size_t maxSize)
+{
+#ifdef WINC_SOCK_POLL_TIMEOUT_ENABLE
+    uint32_t timeNow;
+    uint32_t elapsedTime;
+    uint32_t drainRate;
+#endif
+
+    if (length > (UINT16_MAX - pBuffer->tuneDrainLen))
+    {
+        pBuffer->tuneDrainLen = UINT16_MAX;
+    }
+    else
+    {
+        pBuffer->tuneDrainLen += (uint16_t)length;
+    }
+
+    if (length > (UINT16_MAX - pBuffer->tuneIdleLen))
+    {
+        pBuffer->tuneIdleLen = UINT16_MAX;
+    }
+    else
+    {
+        pBuffer->tuneIdleLen += (uint16_t)length;
+    }
+
+    if (pBuffer->tuneDrainLen < pBuffer->totalSize)
+    {
+        return;
+    }
+
+#ifdef WINC_SOCK_POLL_TIMEOUT_ENABLE
+    timeNow     = WINC_CONF_TIME_MS_GET();
+    elapsedTime = timeNow - pBuffer->tuneTime;
+
+    if (0U == elapsedTime)
+    {
+        elapsedTime = 1;
+    }
+
+    drainRate = (uint32_t)(((uint64_t)pBuffer->tuneDrainLen * 1000U) / elapsedTime);
+
+    pBuffer->tuneTime = timeNow;
+
+    if ((true == pBuffer->tuneLimited) && (true == pBuffer->tuneStarved) &&
+        (drainRate > (pBuffer->tuneGrowRate + (pBuffer->tuneGrowRate / WINC_SOCK_BUF_TUNE_GAIN_DIV))))
+    {
+        if (true == sockBufTuneGrow(pSockCtx, pBuffer, 0, maxSize))
+        {
+            pBuffer->tuneGrowRate = drainRate;
         }
+    }
+#else
+    if ((true == pBuffer->tuneLimited) && (true == pBuffer->tuneStarved))
+    {
+        (void)sockBufTuneGrow(pSockCtx, pBuffer, 0, maxSize);
+    }
+#endif
+
+    pBuffer->tuneDrainLen = 0;
+    pBuffer->tuneLimited  = false;
+    pBuffer->tuneStarved  = false;
+}
+#endif
+
+/*****************************************************************************
+  Description:
+    Allocate (or re-allocate) send and receive socket buffers.
+
+  Parameters:
+    pSockCtx - Pointer to socket context
+
+  Returns:
+    true or false indicating success or failure.
+
+  Remarks:
+
+ *****************************************************************************/
+
+static bool sockAllocSocketBuffers(WINC_SOCK_CTX *pSockCtx)
+{
+    if (NULL == pSockCtx)
+    {
+        return false;
+    }
+
+    /* Free receive data buffer if already allocated. */
+    if (NULL != pSockCtx->recvBuffer.pData)
+    {
+        slabFree(pSockCtx->pSlabAllocCtx, pSockCtx->recvBuffer.pData);
+    }
+
+    (void)memset(&pSockCtx->recvBuffer, 0, sizeof(WINC_SOCK_BUFFER));
+
+    /* Free send data buffer if already allocated. */
+    if (NULL != pSockCtx->sendBuffer.pData)
+    {
+        slabFree(pSockCtx->pSlabAllocCtx, pSockCtx->sendBuffer.pData);
+    }
+
+    (void)memset(&pSockCtx->sendBuffer, 0, sizeof(WINC_SOCK_BUFFER));
+
+#ifdef WINC_SOCK_BUF_AUTOTUNE_ENABLE
+    /* Make room for the new buffers by shrinking idle buffers. */
+    if ((SOCK_STREAM == pSockCtx->type) && (false == sockBufTuneAvailable(pSockCtx->pSlabAllocCtx, pSockCtx->recvBufSz + pSockCtx->sendBufSz + pSockCtx->pSlabAllocCtx->slabSize, 0)))
+    {
+        sockBufTuneReclaim(pSockCtx, NULL);
+    }
+#endif
+
+    /* Allocate new receive buffer. */
+    if (pSockCtx->recvBufSz > 0U)
+    {
+        pSockCtx->recvBuffer.pData = slabAlloc(pSockCtx->pSlabAllocCtx, pSockCtx->recvBufSz);
+
+        if (NULL != pSockCtx->recvBuffer.pData)
+        {
+            pSockCtx->recvBuffer.totalSize = (uint16_t)pSockCtx->recvBufSz;
+        }
+        else
+        {
+            WINC_ERROR_PRINT("error: failed to allocate recv buffer\n");
+            return false;
+        }
+    }
+
+    /* Allocate new send buffer. */
+    if (pSockCtx->sendBufSz > 0U)
+    {
+        pSockCtx->sendBuffer.pData = slabAlloc(pSockCtx->pSlabAllocCtx, pSockCtx->sendBufSz);
+
+        if (NULL != pSockCtx->sendBuffer.pData)
+        {
+            pSockCtx->sendBuffer.totalSize = (uint16_t)pSockCtx->sendBufSz;
+        }
+        else
+        {
+            WINC_ERROR_PRINT("error: failed to allocate send buffer\n");
+            return false;
+        }
+    }
+
+#if defined(WINC_SOCK_BUF_AUTOTUNE_ENABLE) && defined(WINC_SOCK_POLL_TIMEOUT_ENABLE)
+    /* Start the first sizing interval. */
+    pSockCtx->recvBuffer.tuneTime = WINC_CONF_TIME_MS_GET();
+    pSockCtx->sendBuffer.tuneTime = pSockCtx->recvBuffer.tuneTime;
+#endif
+
+    if (SOCK_DGRAM == pSockCtx->type)
+    {
+        /* Free receive packet buffers is already allocated. */
+        if (NULL != pSockCtx->recvBuffer.pUdpPktBuffers)
+        {
+            slabFree(pSockCtx->pSlabAllocCtx, pSockCtx->recvBuffer.pUdpPktBuffers);
+            pSockCtx->recvBuffer.pUdpPktBuffers = NULL;
+        }
+
+        /* Free send packet buffers is already allocated. */
+        if (NULL != pSockCtx->sendBuffer.pUdpPktBuffers)
+        {
+            slabFree(pSockCtx->pSlabAllocCtx, pSockCtx->sendBuffer.pUdpPktBuffers);
+            pSockCtx->sendBuffer.pUdpPktBuffers = NULL;
+        }
+
+        if (pSockCtx->numRxPkts > 0U)
+        {
+            /* Allocate new receive packet buffers. */
+            pSockCtx->recvBuffer.pUdpPktBuffers = slabAlloc(pSockCtx->pSlabAllocCtx, sizeof(WINC_SOCK_UDP_PKT_BUFFER) + (sizeof(WINC_SOCK_UDP_PKT) * pSockCtx->numRxPkts));
+
+            if (NULL == pSockCtx->recvBuffer.pUdpPktBuffers)
+            {
+                WINC_ERROR_PRINT("error: failed to allocate recv packet buffer\n");
+                return false;
+            }
+
+            (void)memset(pSockCtx->recvBuffer.pUdpPktBuffers, 0, sizeof(WINC_SOCK_UDP_PKT_BUFFER));
+
+            pSockCtx->recvBuffer.pUdpPktBuffers->numPkts = pSockCtx->numRxPkts;
+        }
+
+        if (pSockCtx->numTxPkts > 0U)
+        {
+            /* Allocate new send packet buffers. */
+            pSockCtx->sendBuffer.pUdpPktBuffers = slabAlloc(pSockCtx->pSlabAllocCtx, sizeof(WINC_SOCK_UDP_PKT_BUFFER) + (sizeof(WINC_SOCK_UDP_PKT) * pSockCtx->numTxPkts));
+
+            if (NULL == pSockCtx->sendBuffer.pUdpPktBuffers)
+            {
+                WINC_ERROR_PRINT("error: failed to allocate send buffer\n");
+                return false;
+            }
+
+            (void)memset(pSockCtx->sendBuffer.pUdpPktBuffers, 0, sizeof(WINC_SOCK_UDP_PKT_BUFFER));
+
+            pSockCtx->sendBuffer.pUdpPktBuffers->numPkts = pSockCtx->numTxPkts;
+        }
+
+        return true;
+    }
+
+    return true;
+}
+
+/*****************************************************************************
+  Description:
+    Find socket context by it's ID.
+
+  Parameters:
+    sockId - Socket ID to find
+
+  Returns:
+    Pointer to socket context or NULL for error/not found.
+
+  Remarks:
+
+ *****************************************************************************/
+
+static WINC_SOCK_CTX* sockFindByID(uint16_t sockId)
+{
+    unsigned int mapIdx = sockIdHash(sockId);
+
+    while (0U != sockIdMap[mapIdx])
+    {
+        WINC_SOCK_CTX *pSockCtx = &wincSockets[sockIdMap[mapIdx]-1U];
+
+        if ((true == pSockCtx->inUse) && (sockId == pSockCtx->sockId))
+        {
+            return pSockCtx;
+        }
+
+        mapIdx = (mapIdx + 1U) & (WINC_SOCK_ID_MAP_SZ - 1U);
+    }
+
+    return NULL;
+}
+
+/*****************************************************************************
+  Description:
+    Find the listening socket associated with the specified socket context.
+
+  Parameters:
+    pSockCtx - Pointer to socket context
+
+  Returns:
+    Pointer to socket context or NULL for error/not found
+
+  Remarks:
+
+ *****************************************************************************/
+
+static WINC_SOCK_CTX* sockFindListeningSocket(WINC_SOCK_CTX *pSockCtx)
+{
+    uint8_t listenIdx;
+
+    if (NULL == pSockCtx)
+    {
+        return NULL;
+    }
+
+    /* The socket must be in use and be either stream or TLS based. */
+    if ((false == pSockCtx->inUse) || ((SOCK_STREAM != pSockCtx->type) && (IPPROTO_TLS != pSockCtx->protocol)))
+    {
+        return NULL;
+    }
+
+    listenIdx = sockListenHead;
+
+    while (0U != listenIdx)
+    {
+        WINC_SOCK_CTX *pListenSockCtx = &wincSockets[listenIdx-1U];
+
+        /* Match on a stream/TLS socket which is in use, listening sharing the same source port. */
+        if ((pListenSockCtx != pSockCtx) && (true == pListenSockCtx->inUse) && (pSockCtx->type == pListenSockCtx->type) && (pSockCtx->localEndPt.sin_port == pListenSockCtx->localEndPt.sin_port))
+        {
+            return pListenSockCtx;
+        }
+
+        listenIdx = pListenSockCtx->listenNext;
+    }
+
+    return NULL;
+}
+
+/*****************************************************************************
+  Description:
+    Find a socket in the pending state.
+
+  Parameters:
+    pSockCtx - Pointer to socket context
+
+  Returns:
+    Pointer to socket context or NULL for error/not found.
+
+  Remarks:
+
+ *****************************************************************************/
+
+static WINC_SOCK_CTX* sockFindPendingSocket(WINC_SOCK_CTX *pSockCtx)
+{
+    if (NULL == pSockCtx)
+    {
+        return NULL;
+    }
+
+    /* Socket must be either stream or TLS based, in use and listening. */
+    if ((false == pSockCtx->inUse) || ((SOCK_STREAM != pSockCtx->type) && (IPPROTO_TLS != pSockCtx->protocol)) || (false == pSockCtx->listening))
+    {
+        return NULL;
+    }
+
+    /* Return the oldest connection waiting to be accepted. */
+    if (0U == pSockCtx->pendHead)
+    {
+        return NULL;
+    }
+
+    return &wincSockets[pSockCtx->pendHead-1U];
+}
+
+/*****************************************************************************
+  Description:
+    Check a socket for poll events.
+
+  Parameters:
+    pSockCtx - Pointer to socket context, must be locked
+    events   - Requested events
+
+  Returns:
+    Returned events, see poll().
+
+  Remarks:
+
+ *****************************************************************************/
+
+static short sockPollEvents(WINC_SOCK_CTX *pSockCtx, short events)
+{
+    short revents = 0;
+
+    /* If POLLIN is selected, check incoming buffer length. */
+    if (0 != (events & POLLIN))
+    {
+        if (true == pSockCtx->listening)
+        {
+            if (NULL != sockFindPendingSocket(pSockCtx))
+            {
+                revents |= POLLIN;
+            }
+        }
+        else
+        {
+            if (pSockCtx->recvBuffer.length > 0)
+            {
+                revents |= POLLIN;
+            }
+        }
+    }
+
+    /* If POLLOUT is selected, check there is some space in output buffer. */
+    if (0 != (events & POLLOUT))
+    {
+        if (true == pSockCtx->connected)
+        {
+            if (((pSockCtx->sendBuffer.totalSize - pSockCtx->sendBuffer.length) > 0) && (NULL == pSockCtx->pConstData))
+            {
+                revents |= POLLOUT;
+            }
+        }
+    }
+
+    revents |= pSockCtx->events;
+
+    /* If POLLERR signalled, also copy in caller POLLIN|POLLOUT to
+     trigger send/recv paths if not checking POLLERR. */
+    if (0 != (pSockCtx->events & POLLERR))
+    {
+        revents |= (events & (POLLIN|POLLOUT));
+    }
+
+    return revents;
+}
+
+/*****************************************************************************
+  Description:
+    Notify a socket's interest set of a socket state change.
+
+  Parameters:
+    pSockCtx - Pointer to socket context, must be locked
+
+  Returns:
+    None.
+
+  Remarks:
+    Marks the socket ready in its interest set if any requested event is
+    present. For edge-triggered sockets the events are latched until
+    returned by WINC_SockEpollWait.
+
+ *****************************************************************************/
+
+static void sockEpollNotify(WINC_SOCK_CTX *pSockCtx)
+{
+    WINC_SOCK_EPOLL_SET *pSet;
+    short revents;
+
+    if ((NULL == pSockCtx) || (0U == pSockCtx->epollSet) || (0U != (pSockCtx->epollEvents & WINC_SOCK_EPOLL_DISARMED)))
+    {
+        return;
+    }
+
+    revents = sockPollEvents(pSockCtx, (short)pSockCtx->epollEvents);
+
+    if (0 == revents)
+    {
+        return;
+    }
+
+    if (0U != (pSockCtx->epollEvents & WINC_SOCK_EPOLLET))
+    {
+        pSockCtx->epollPending |= revents;
+    }
+
+    pSet = &epollSets[pSockCtx->epollSet-1U];
+
+    if (false == WINC_CONF_LOCK_ENTER(&pSet->accessMutex))
+    {
+        return;
+    }
+
+    pSet->readyMap[WINC_SOCK_PTR_TO_IDX(pSockCtx) / 32U] |= ((uint32_t)1U << (WINC_SOCK_PTR_TO_IDX(pSockCtx) % 32U));
+
+    WINC_CONF_LOCK_LEAVE(&pSet->accessMutex);
+}
+
+/*****************************************************************************
+  Description:
+    Add async mode SOCKC commands to command request.
+
+  Parameters:
+    cmdReqHandle - Command request handle
+    pSockCtx     - Pointer to socket context
+
+  Returns:
+    true or false indicating success or failure.
+
+  Remarks:
+
+ *****************************************************************************/
+
+static bool sockAsyncModeConf(WINC_CMD_REQ_HANDLE cmdReqHandle, const WINC_SOCK_CTX *pSockCtx)
+{
+    uint16_t asyncWinSize  = 0;
+    uint16_t asyncMaxFrmSz = 0;
+
+    if ((WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle) || (NULL == pSockCtx))
+    {
+        return false;
+    }
+
+    if (WINC_SOCKET_ASYNC_MODE_OFF != (WINC_SOCKET_ASYNC_MODE_TYPE)pSockCtx->readMode)
+    {
+        if (WINC_SOCKET_ASYNC_MODE_ACKED == (WINC_SOCKET_ASYNC_MODE_TYPE)pSockCtx->readMode)
+        {
+            asyncWinSize = pSockCtx->recvBufSz;
+        }
+
+        if (SOCK_STREAM == pSockCtx->type)
+        {
+            asyncMaxFrmSz = (3*512)-38;
+        }
+        else
+        {
+            if (AF_INET == pSockCtx->domain)
+            {
+                asyncMaxFrmSz = (3*512)-46;
+            }
+            else if (AF_INET6 == pSockCtx->domain)
+            {
+                asyncMaxFrmSz = (3*512)-58;
+            }
+            else
+            {
+                /* Do nothing. */
+            }
+        }
+    }
+
+    (void)WINC_CmdSOCKC(cmdReqHandle, pSockCtx->sockId, WINC_CFG_PARAM_ID_SOCK_ASYNC_WIN_SZ, WINC_TYPE_INTEGER_UNSIGNED, asyncWinSize, 0);
+    (void)WINC_CmdSOCKC(cmdReqHandle, pSockCtx->sockId, WINC_CFG_PARAM_ID_SOCK_ASYNC_MAX_FRM_SZ, WINC_TYPE_INTEGER_UNSIGNED, asyncMaxFrmSz, 0);
+
+    return true;
+}
+
+/*****************************************************************************
+  Description:
+    Listen for connections on a socket.
+
+  Parameters:
+    fd      - Socket file descriptor.
+    type    - Socket type.
+    backlog - Maximum number of pending connections.
+
+  Returns:
+    0  - Success.
+    -1 - Error, errno set.
+
+  Remarks:
+    errno:
+        EADDRINUSE
+            The referred to by fd is not bound to a local port.
+        EBADF
+            The argument fd is not a valid file descriptor.
+        ENOTSOCK
+            The file descriptor fd does not refer to a socket.
+        EOPNOTSUPP
+            The socket is not of a type that supports the listen() operation.
+        EAGAIN
+            The socket is nonblocking, and the listening cannot be
+            completed immediately.
+
+ *****************************************************************************/
+
+static int sockListen(int fd, int type, int backlog)
+{
+    WINC_CMD_REQ_HANDLE cmdReqHandle;
+    void *pCmdReqBuffer;
+    WINC_SOCK_CTX *pSockCtx = WINC_SOCK_HANDLE_TO_PTR(fd);
+
+    if (NULL == pSockCtx)
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    if ((unsigned)backlog > SOMAXCONN)
+    {
+        backlog = SOMAXCONN;
+    }
+
+    if (false == sockLockSocket(pSockCtx))
+    {
+        errno = EFAULT;
+        return -1;
+    }
+
+    if ((type != pSockCtx->type) || ((SOCK_STREAM != pSockCtx->type) && (IPPROTO_TLS != pSockCtx->protocol)))
+    {
+        sockUnlockSocket(pSockCtx);
+        errno = EOPNOTSUPP;
+        return -1;
+    }
+
+    if (0U == pSockCtx->localEndPt.sin_port)
+    {
+        sockUnlockSocket(pSockCtx);
+        errno = EADDRINUSE;
+        return -1;
+    }
+
+    if (0U == pSockCtx->sockId)
+    {
+        if (true == pSockCtx->inUse)
+        {
+            errno = EAGAIN;
+        }
+        else
+        {
+            errno = ENOTSOCK;
+        }
+
+        sockUnlockSocket(pSockCtx);
+        return -1;
+    }
+
+    /* Perform bind of stream/TLS sockets to allow setting backlog. */
+
+    pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, WINC_SOCK_CMD_REQ_SZ(128, 1));
+
+    if (NULL == pCmdReqBuffer)
+    {
+        sockUnlockSocket(pSockCtx);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, WINC_SOCK_CMD_REQ_SZ(128, 1), 1, sockCmdRspCallbackHandler, (uintptr_t)pSockCtx);
+
+    if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
+    {
+        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+        sockUnlockSocket(pSockCtx);
+        errno = EBADMSG;
+        return -1;
+    }
+
+    (void)WINC_CmdSOCKBL(cmdReqHandle, pSockCtx->sockId, ntohs(pSockCtx->localEndPt.sin_port), (uint8_t)backlog);
+
+    if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
+    {
+        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+        sockUnlockSocket(pSockCtx);
+        errno = EBADMSG;
+        return -1;
+    }
+
+    sockListenAdd(pSockCtx);
+
+    sockUnlockSocket(pSockCtx);
+    return 0;
+}
+
+/*****************************************************************************
+  Description:
+    Accept a connection on a socket.
+
+  Parameters:
+    fd   - Socket file descriptor.
+    type - Socket type.
+    addr - Pointer to a structure to filled in with the address of the peer socket.
+    len  - Length of address structure.
+
+  Returns:
+    0  - Success.
+    -1 - Error, errno set.
+
+  Remarks:
+    errno:
+        EBADF
+            The argument fd is not a valid file descriptor.
+        ENOMEM
+            Insufficient memory is available.
+        EWOULDBLOCK
+            The socket is marked nonblocking and no connections are
+            present to be accepted.
+        EOPNOTSUPP
+            The socket is not of a type that supports the accept() operation.
+
+ *****************************************************************************/
+
+static int sockAccept(int fd, int type, struct sockaddr *addr, socklen_t *len)
+{
+    WINC_SOCK_CTX *pSockCtx = WINC_SOCK_HANDLE_TO_PTR(fd);
+    WINC_SOCK_CTX *pNewSockCtx;
+
+    if (NULL == pSockCtx)
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    if (type != pSockCtx->type)
+    {
+        errno = EOPNOTSUPP;
+        return -1;
+    }
+
+    pNewSockCtx = sockFindPendingSocket(pSockCtx);
+
+    if (NULL == pNewSockCtx)
+    {
+        errno = EWOULDBLOCK;
+        return -1;
+    }
+
+    if (false == sockLockSocket(pNewSockCtx))
+    {
+        errno = EFAULT;
+        return -1;
+    }
+
+    if ((NULL != addr) && (NULL != len))
+    {
+        socklen_t addrLen = (AF_INET == pNewSockCtx->remoteEndPt.sin_family) ? sizeof(struct sockaddr_in) : sizeof(struct sockaddr_in6);
+
+        if (*len > addrLen)
+        {
+            *len = addrLen;
+        }
+
+        (void)memcpy(addr, &pNewSockCtx->remoteEndPt, *len);
+
+        *len = addrLen;
+    }
+
+    if (SOCK_STREAM == pNewSockCtx->type)
+    {
+        if (false == sockAllocSocketBuffers(pNewSockCtx))
+        {
+            sockUnlockSocket(pNewSockCtx);
+            errno = ENOMEM;
+            return -1;
+        }
+    }
+
+    pNewSockCtx->accepted = true;
+
+    sockListenRemove(pNewSockCtx);
+
+    sockUnlockSocket(pNewSockCtx);
+    return WINC_SOCK_PTR_TO_HANDLE(pNewSockCtx);
+}
+
+/*****************************************************************************
+  Description:
+    Read data from the socket on the device.
+
+  Parameters:
+    pSockCtx - Pointer to socket context
+
+  Returns:
+    true or false indicating success or failure.
+
+  Remarks:
+
+ *****************************************************************************/
+
+static bool sockRead(WINC_SOCK_CTX *pSockCtx)
+{
+    if (NULL == pSockCtx)
+    {
+        return false;
+    }
+
+    /* Clear received data flag, ready for new possible data. */
+    pSockCtx->newRecvData = false;
+
+    /* If no outstanding data to read, stop now. */
+    if (0U == pSockCtx->pendingRecvDataLen)
+    {
+        return true;
+    }
+
+    WINC_TRACE_PRINT("SR %d %d %d\n", pSockCtx->pendingRecvDataLen, pSockCtx->recvBuffer.outstandingDataLen, pSockCtx->recvBuffer.length);
+
+    /* Issue reads until the read window is full or all pending data has been requested. */
+    while (true)
+    {
+        ssize_t dataLenToRead;
+        ssize_t bufferSpace;
+        uint8_t readWindow;
+        WINC_CMD_REQ_HANDLE cmdReqHandle;
+        void *pCmdReqBuffer;
+        ssize_t maxDataLenToRead;
+
+        /* Length of data to read, start based on pending minus outstanding, i.e. what we know is left. */
+        dataLenToRead = ((ssize_t)pSockCtx->pendingRecvDataLen - (ssize_t)pSockCtx->recvBuffer.outstandingDataLen);
+
+        /* Limit based on the space in the receive socket buffer. */
+        if (SOCK_DGRAM == pSockCtx->type)
+        {
+            /* Datagrams are stored contiguously so they can be borrowed, only contiguous space is usable. */
+            bufferSpace = ((ssize_t)sockBufferContiguousSpace(&pSockCtx->recvBuffer) - (ssize_t)pSockCtx->recvBuffer.outstandingDataLen);
+        }
+        else
+        {
+            bufferSpace = ((ssize_t)pSockCtx->recvBuffer.totalSize - (ssize_t)pSockCtx->recvBuffer.length - (ssize_t)pSockCtx->recvBuffer.outstandingDataLen);
+        }
+
+        if (dataLenToRead > bufferSpace)
+        {
+            dataLenToRead = bufferSpace;
+
+            /* Data is still waiting in the buffer, the application is not
+               draining it as fast as it is being filled. */
+            if ((SOCK_STREAM == pSockCtx->type) && (0U != pSockCtx->recvBuffer.length) && (pSockCtx->readWindow > 1U))
+            {
+                pSockCtx->readWindow--;
+            }
+
+#ifdef WINC_SOCK_BUF_AUTOTUNE_ENABLE
+            if (SOCK_STREAM == pSockCtx->type)
+            {
+                pSockCtx->recvBuffer.tuneLimited = true;
+            }
+#endif
+        }
+
+        if (dataLenToRead <= 0)
+        {
+            break;
+        }
+
+        if (SOCK_DGRAM == pSockCtx->type)
+        {
+            maxDataLenToRead = MAX_UDP_SOCK_PAYLOAD_SZ;
+            readWindow       = 1;
+        }
+        else
+        {
+            maxDataLenToRead = MAX_TCP_SOCK_PAYLOAD_SZ;
+            readWindow       = pSockCtx->readWindow;
+        }
+
+        if (pSockCtx->numReadsOutstanding >= readWindow)
+        {
+            break;
+        }
+
+        if (dataLenToRead > maxDataLenToRead)
+        {
+            dataLenToRead = maxDataLenToRead;
+        }
+
+        WINC_TRACE_PRINT("SRreq %d\n", dataLenToRead);
+
+        /* Allocate command request. */
+        pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, WINC_SOCK_CMD_REQ_SZ(128, 1));
+
+        if (NULL == pCmdReqBuffer)
+        {
+            return false;
+        }
+
+        /* Initialise command request for a single command. */
+        cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, WINC_SOCK_CMD_REQ_SZ(128, 1), 1, sockCmdRspCallbackHandler, (uintptr_t)pSockCtx);
+
+        if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
+        {
+            slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+            return false;
+        }
+
+        /* Perform a SOCKRD command, request extended output information to update pending counts. */
+        (void)WINC_CmdSOCKRD(cmdReqHandle, pSockCtx->sockId, WINC_CONST_SOCKET_OUTPUT_MODE_ASCII_EXT, dataLenToRead);
+
+        if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
+        {
+            slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+            return false;
+        }
+
+        WINC_TRACE_PRINT("SR+ %d + %d [%d/%d]\n", pSockCtx->recvBuffer.outstandingDataLen, dataLenToRead, pSockCtx->numReadsOutstanding, readWindow);
+
+        /* Update the outstanding length to reflect this request. */
+        pSockCtx->recvBuffer.outstandingDataLen += (uint16_t)dataLenToRead;
+        pSockCtx->numReadsOutstanding++;
+
+        if (SOCK_DGRAM == pSockCtx->type)
+        {
+            /* Discard the rest of the pending datagram */
+            pSockCtx->pendingRecvDataLen = (uint16_t)dataLenToRead;
+        }
+    }
+
+    return true;
+}
+
+/*****************************************************************************
+  Description:
+    Send the next expected sequence number to the device.
+
+  Parameters:
+    pSockCtx - Pointer to socket context
+
+  Returns:
+    true or false indicating success or failure.
+
+  Remarks:
+    Used by acknowledged asynchronous mode sockets. If an update is already
+    in flight the new sequence number is sent once it has been transmitted.
+    If the update cannot be sent the socket is marked in the sequence number
+    map and WINC_SockUpdate retries, otherwise the device would wait forever
+    for an acknowledgement of data the application has consumed.
+
+ *****************************************************************************/
+
+static bool sockSeqNumUpdate(WINC_SOCK_CTX *pSockCtx)
+{
+    WINC_CMD_REQ_HANDLE cmdReqHandle;
+    void *pCmdReqBuffer;
+
+    pSockCtx->seqNumUpdatePending = true;
+
+    if (true == pSockCtx->seqNumUpdateSent)
+    {
+        return true;
+    }
+
+    sockSeqNumMap[WINC_SOCK_PTR_TO_IDX(pSockCtx) / 32U] |= ((uint32_t)1U << (WINC_SOCK_PTR_TO_IDX(pSockCtx) % 32U));
+
+    pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, WINC_SOCK_CMD_REQ_SZ(128, 1));
+
+    if (NULL == pCmdReqBuffer)
+    {
+        return false;
+    }
+
+    cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, WINC_SOCK_CMD_REQ_SZ(128, 1), 1, sockCmdRspCallbackHandlerSeqUpdate, (uintptr_t)pSockCtx);
+
+    if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
+    {
+        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+        return false;
+    }
+
+    (void)WINC_CmdSOCKC(cmdReqHandle, pSockCtx->sockId, WINC_CFG_PARAM_ID_SOCK_ASYNC_NEXT_SN, WINC_TYPE_INTEGER_UNSIGNED, pSockCtx->nextSeqNum, 0);
+
+    if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
+    {
+        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+        return false;
+    }
+
+    sockSeqNumMap[WINC_SOCK_PTR_TO_IDX(pSockCtx) / 32U] &= ~((uint32_t)1U << (WINC_SOCK_PTR_TO_IDX(pSockCtx) % 32U));
+
+    pSockCtx->seqNumUpdateSent    = true;
+    pSockCtx->seqNumUpdatePending = false;
+
+    return true;
+}
+
+/*****************************************************************************
+  Description:
+    Update the device after data has been consumed from a receive buffer.
+
+  Parameters:
+    pSockCtx - Pointer to socket context
+    length   - Length of data consumed
+
+  Returns:
+    true or false indicating success or failure.
+
+  Remarks:
+    Requests more data from the device, or acknowledges the data consumed
+    if the socket uses acknowledged asynchronous mode.
+
+ *****************************************************************************/
+
+static bool sockRecvConsumed(WINC_SOCK_CTX *pSockCtx, size_t length)
+{
+    if (WINC_SOCKET_ASYNC_MODE_OFF == (WINC_SOCKET_ASYNC_MODE_TYPE)pSockCtx->readMode)
+    {
+#ifdef WINC_SOCK_BUF_AUTOTUNE_ENABLE
+        if (SOCK_STREAM == pSockCtx->type)
+        {
+            sockBufTuneDrained(pSockCtx, &pSockCtx->recvBuffer, length, WINC_SOCK_BUF_RX_MAX_SZ);
+        }
+#endif
+
+        (void)sockRead(pSockCtx);
+    }
+    else if (WINC_SOCKET_ASYNC_MODE_ACKED == (WINC_SOCKET_ASYNC_MODE_TYPE)pSockCtx->readMode)
+    {
+        pSockCtx->nextSeqNum += (uint16_t)length;
+
+        return sockSeqNumUpdate(pSockCtx);
+    }
+    else
+    {
+    }
+
+    return true;
+}
+
+/*****************************************************************************
+  Description:
+    Update socket in response to WR/WRTO status.
+
+  Parameters:
+    pSockCtx   - Pointer to socket context
+    seqNum     - Packet sequence number
+    dataLength - Length of data acknowledged
+    statusCode - Status result of write operation
+
+  Returns:
+    None
+
+  Remarks:
+
+ *****************************************************************************/
+
+static void sockProcessStatusWR(WINC_SOCK_CTX *pSockCtx, uint16_t seqNum, uint16_t dataLength, uint16_t statusCode)
+{
+    bool constData = false;
+
+    WINC_TRACE_PRINT("SW- [%d] %04x %d %d\n", seqNum, statusCode, dataLength, pSockCtx->sendBuffer.outstandingDataLen);
+
+    if ((SOCK_STREAM == pSockCtx->type) && (pSockCtx->constSent > pSockCtx->constAcked))
+    {
+        /* Constant payload data is written after all send buffer data, so its
+           sequence numbers follow those of the outstanding send buffer data. */
+        uint16_t constSeqNum = pSockCtx->unAckedSeqNum + pSockCtx->sendBuffer.outstandingDataLen;
+
+        if ((size_t)(uint16_t)(seqNum - constSeqNum) < (pSockCtx->constSent - pSockCtx->constAcked))
+        {
+            constData = true;
+        }
+    }
+
+    if ((WINC_STATUS_OK == statusCode) && (true == constData))
+    {
+        pSockCtx->constAcked += dataLength;
+
+        if (pSockCtx->constAcked > pSockCtx->constSent)
+        {
+            pSockCtx->constAcked = pSockCtx->constSent;
+        }
+
+        /* Send buffer data still outstanding holds the expected sequence number. */
+        if (0U == pSockCtx->sendBuffer.outstandingDataLen)
+        {
+            pSockCtx->unAckedSeqNum = seqNum + dataLength;
+        }
+
+        if (pSockCtx->constAcked == pSockCtx->constLen)
+        {
+            sockSendConstComplete(pSockCtx, WINC_SOCKET_STATUS_OK);
+        }
+    }
+    else if (WINC_STATUS_OK == statusCode)
+    {
+        uint8_t pktDepth = 0;
+
+        if ((SOCK_DGRAM == pSockCtx->type) && (NULL != pSockCtx->sendBuffer.pUdpPktBuffers))
+        {
+            pktDepth = pSockCtx->sendBuffer.pUdpPktBuffers->pktDepth;
+        }
+
+        /* Dummy socket buffer read to remove the data this write has completed. */
+        (void)sockBufferRead(&pSockCtx->sendBuffer, NULL, dataLength, NULL, 0, false, NULL);
+
+        /* Update outstanding data length to reflect completed write. */
+        pSockCtx->sendBuffer.outstandingDataLen -= dataLength;
+
+#ifdef WINC_SOCK_BUF_AUTOTUNE_ENABLE
+        if (SOCK_STREAM == pSockCtx->type)
+        {
+            sockBufTuneDrained(pSockCtx, &pSockCtx->sendBuffer, dataLength, WINC_SOCK_BUF_TX_MAX_SZ);
+        }
+#endif
+
+        if ((SOCK_DGRAM == pSockCtx->type) && (NULL != pSockCtx->sendBuffer.pUdpPktBuffers))
+        {
+            /* Update the outstanding packet buffer count with the number of buffers freed
+                by the dummy socket buffer read. */
+            pSockCtx->udpUnackedPktBufs -= (pktDepth - pSockCtx->sendBuffer.pUdpPktBuffers->pktDepth);
+        }
+
+        /* Update the expected sequence number for the next write operation. */
+        pSockCtx->unAckedSeqNum = seqNum + dataLength;
+    }
+    else if (pSockCtx->unAckedSeqNum == seqNum)
+    {
+        /* On write failure, reset the outstanding counts to cause resend. */
+        pSockCtx->sendBuffer.outstandingDataLen = 0;
+        pSockCtx->udpUnackedPktBufs             = 0;
+        pSockCtx->constSent                     = pSockCtx->constAcked;
+    }
+    else
+    {
+        /* Do nothing. */
+    }
+}
+
+/*****************************************************************************
+  Description:
+    Check if stream data should be held in the send buffer.
+
+  Parameters:
+    pSockCtx - Pointer to socket context
+    length   - Length of data not yet written to the device
+
+  Returns:
+    true if the data should be held, false if it should be written.
+
+  Remarks:
+    Data is held while the socket is corked, either by TCP_CORK or by
+    MSG_MORE on the last send, until WINC_SOCK_CORK_FLUSH_SZ bytes are
+    waiting, the send buffer is full or WINC_SOCK_CORK_TIMEOUT_MS has
+    elapsed since the oldest held data was written.
+
+ *****************************************************************************/
+
+static bool sockCorkHold(const WINC_SOCK_CTX *pSockCtx, uint16_t length)
+{
+    if ((false == pSockCtx->corked) && (false == pSockCtx->sendMore))
+    {
+        return false;
+    }
+
+    if ((length >= WINC_SOCK_CORK_FLUSH_SZ) || (pSockCtx->sendBuffer.length >= pSockCtx->sendBuffer.totalSize))
+    {
+        return false;
+    }
+
+#ifdef WINC_SOCK_CORK_TIMEOUT_ENABLE
+    if ((WINC_CONF_TIME_MS_GET() - pSockCtx->corkTime) >= WINC_SOCK_CORK_TIMEOUT_MS)
+    {
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+/*****************************************************************************
+  Description:
+    Write constant payload data to the device.
+
+  Parameters:
+    pSockCtx          - Pointer to socket context
+    maxDataLenToWrite - Maximum length of data per write
+
+  Returns:
+    true or false indicating success or failure.
+
+  Remarks:
+    The data is encoded into command requests directly from the payload,
+    writes are issued until WINC_SOCK_SEND_CONST_WINDOW_SZ is in flight.
+
+ *****************************************************************************/
+
+static bool sockWriteConst(WINC_SOCK_CTX *pSockCtx, uint16_t maxDataLenToWrite)
+{
+    while ((pSockCtx->constSent < pSockCtx->constLen) && ((pSockCtx->constSent - pSockCtx->constAcked) < WINC_SOCK_SEND_CONST_WINDOW_SZ))
+    {
+        WINC_CMD_REQ_HANDLE cmdReqHandle;
+        void *pCmdReqBuffer;
+        uint16_t dataLenToWrite = maxDataLenToWrite;
+        uint16_t seqNum;
+
+        if (dataLenToWrite > (pSockCtx->constLen - pSockCtx->constSent))
+        {
+            dataLenToWrite = (uint16_t)(pSockCtx->constLen - pSockCtx->constSent);
+        }
+
+        /* Allocate a command request structure. */
+        pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, WINC_SOCK_CMD_REQ_SZ(160U+dataLenToWrite, 1));
+
+        if (NULL == pCmdReqBuffer)
+        {
+            return false;
+        }
+
+        cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, WINC_SOCK_CMD_REQ_SZ(160U+dataLenToWrite, 1), 1, sockCmdRspCallbackHandler, (uintptr_t)pSockCtx);
+
+        if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
+        {
+            WINC_ERROR_PRINT("error: socket write command request initialisation failed\n");
+            slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+            return false;
+        }
+
+        /* Constant payload data follows any send buffer data still in flight. */
+        seqNum = pSockCtx->unAckedSeqNum + pSockCtx->sendBuffer.outstandingDataLen + (uint16_t)(pSockCtx->constSent - pSockCtx->constAcked);
+
+        WINC_TRACE_PRINT("SWC+ [%d] %d +%d\n", seqNum, pSockCtx->constSent, dataLenToWrite);
+
+        (void)WINC_CmdSOCKWR(cmdReqHandle, pSockCtx->sockId, dataLenToWrite, (int32_t)seqNum, &pSockCtx->pConstData[pSockCtx->constSent], dataLenToWrite);
+
+        if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
+        {
+            WINC_ERROR_PRINT("error: socket write command request tranmission failed\n");
+            slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+            return false;
+        }
+
+        pSockCtx->constSent += dataLenToWrite;
+    }
+
+    return true;
+}
+
+/*****************************************************************************
+  Description:
+    Write data to a socket on the device.
+
+  Parameters:
+    pSockCtx - Pointer to socket context
+
+  Returns:
+    true or false indicating success or failure.
+
+  Remarks:
+    For datagram sockets consecutive queued datagrams are packed into a
+    single command request, up to WINC_SOCK_WRTO_BATCH_MAX datagrams or
+    MAX_SOCK_PAYLOAD_SZ bytes of payload. While earlier writes are in
+    flight, a batch which could still grow is held back, the completion of
+    those writes sends it.
+
+ *****************************************************************************/
+
+static bool sockWrite(WINC_SOCK_CTX *pSockCtx)
+{
+    WINC_CMD_REQ_HANDLE cmdReqHandle;
+    void *pCmdReqBuffer;
+    uint16_t dataLenToWrite;
+    uint16_t outOffset;
+    uint16_t seqNum;
+    uint8_t pkkBufIdx = 0;
+    uint8_t numCmds = 1;
+    size_t batchLen = 0;
+
+    if (NULL == pSockCtx)
+    {
+        return false;
+    }
+
+    if (SOCK_DGRAM == pSockCtx->type)
+    {
+        int numRemainingPkts;
+
+        numRemainingPkts = (pSockCtx->sendBuffer.pUdpPktBuffers->pktDepth - pSockCtx->udpUnackedPktBufs);
+
+        /* For datagrams check the remaining number of packet buffers. */
+        if ((0U == pSockCtx->sendBuffer.pUdpPktBuffers->pktDepth) || (0 == numRemainingPkts))
+        {
+            return false;
+        }
+
+        dataLenToWrite = 0;
+
+        /* Search through the packet buffers looking for a valid one to use. */
+        do
+        {
+            pkkBufIdx = pSockCtx->sendBuffer.pUdpPktBuffers->outIdx + pSockCtx->udpUnackedPktBufs;
+
+            if (pkkBufIdx >= pSockCtx->sendBuffer.pUdpPktBuffers->numPkts)
+            {
+                pkkBufIdx -= pSockCtx->sendBuffer.pUdpPktBuffers->numPkts;
+            }
+
+            /* If the address is specified, use this packet buffer. */
+            if (AF_UNSPEC != pSockCtx->sendBuffer.pUdpPktBuffers->pkts[pkkBufIdx].endPt.sin_family)
+            {
+                dataLenToWrite = pSockCtx->sendBuffer.pUdpPktBuffers->pkts[pkkBufIdx].pktLength;
+                outOffset      = pSockCtx->sendBuffer.pUdpPktBuffers->pkts[pkkBufIdx].pktOffset;
+                break;
+            }
+
+            WINC_TRACE_PRINT("SW#\n");
+
+            pSockCtx->udpUnackedPktBufs++;
+        }
+        while (0U != (unsigned)(numRemainingPkts--));
+
+        if (0U != dataLenToWrite)
+        {
+            uint16_t totalLen = dataLenToWrite;
+            bool batchFull = false;
+
+            numRemainingPkts = (pSockCtx->sendBuffer.pUdpPktBuffers->pktDepth - pSockCtx->udpUnackedPktBufs);
+
+            /* Count the following datagrams which can be sent in the same command request. */
+            while ((numCmds < numRemainingPkts) && (numCmds < WINC_SOCK_WRTO_BATCH_MAX))
+            {
+                uint8_t nextIdx = pkkBufIdx + numCmds;
+
+                if (nextIdx >= pSockCtx->sendBuffer.pUdpPktBuffers->numPkts)
+                {
+                    nextIdx -= pSockCtx->sendBuffer.pUdpPktBuffers->numPkts;
+                }
+
+                if (AF_UNSPEC == pSockCtx->sendBuffer.pUdpPktBuffers->pkts[nextIdx].endPt.sin_family)
+                {
+                    batchFull = true;
+                    break;
+                }
+
+                if ((totalLen + pSockCtx->sendBuffer.pUdpPktBuffers->pkts[nextIdx].pktLength) > MAX_SOCK_PAYLOAD_SZ)
+                {
+                    batchFull = true;
+                    break;
+                }
+
+                totalLen += pSockCtx->sendBuffer.pUdpPktBuffers->pkts[nextIdx].pktLength;
+                numCmds++;
+            }
+
+            if (numCmds >= WINC_SOCK_WRTO_BATCH_MAX)
+            {
+                batchFull = true;
+            }
+
+            /* Hold back a batch which could still grow while writes are in flight,
+               the status of those writes calls back here. */
+            if ((false == batchFull) && (0U != pSockCtx->sendBuffer.outstandingDataLen))
+            {
+                return false;
+            }
+
+            batchLen = totalLen;
+        }
+    }
+    else
+    {
+        uint16_t length;
+
+        /* For TCP sockets, start with the largest write size depending on IP version. */
+        if (AF_INET == pSockCtx->remoteEndPt.sin_family)
+        {
+            dataLenToWrite = MAX_TCP_IPV4_SOCK_PAYLOAD_SZ;
+        }
+        else if (AF_INET6 == pSockCtx->remoteEndPt.sin_family)
+        {
+            dataLenToWrite = MAX_TCP_IPV6_SOCK_PAYLOAD_SZ;
+        }
+        else
+        {
+            return false;
+        }
+
+        /* Calculate offset and length of suitable data block which can be written. */
+        outOffset = pSockCtx->sendBuffer.outOffset + pSockCtx->sendBuffer.outstandingDataLen;
+        length    = pSockCtx->sendBuffer.length - pSockCtx->sendBuffer.outstandingDataLen;
+
+        if (outOffset >= pSockCtx->sendBuffer.totalSize)
+        {
+            outOffset -= pSockCtx->sendBuffer.totalSize;
+        }
+
+        /* Once all send buffer data is written, write any constant payload. */
+        if ((0U == length) && (NULL != pSockCtx->pConstData))
+        {
+            return sockWriteConst(pSockCtx, dataLenToWrite);
+        }
+
+        if ((length > 0U) && (true == sockCorkHold(pSockCtx, length)))
+        {
+#ifdef WINC_SOCK_CORK_TIMEOUT_ENABLE
+            /* Mark the socket so WINC_SockUpdate writes the data when the cork timeout expires. */
+            sockCorkMap[WINC_SOCK_PTR_TO_IDX(pSockCtx) / 32U] |= ((uint32_t)1U << (WINC_SOCK_PTR_TO_IDX(pSockCtx) % 32U));
+#endif
+            return true;
+        }
+
+        if (dataLenToWrite > length)
+        {
+            dataLenToWrite = length;
+        }
+
+        if (dataLenToWrite > (pSockCtx->sendBuffer.totalSize - outOffset))
+        {
+            dataLenToWrite = (pSockCtx->sendBuffer.totalSize - outOffset);
+        }
+
+        batchLen = dataLenToWrite;
+    }
+
+    if (0U == dataLenToWrite)
+    {
+        return true;
+    }
+
+    WINC_TRACE_PRINT("SW+ [%d] +%d %d %d\n", pSockCtx->unAckedSeqNum, pSockCtx->sendBuffer.outstandingDataLen, batchLen, numCmds);
+
+    /* Allocate a command request structure. */
+    pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, WINC_SOCK_CMD_REQ_SZ((160U*numCmds)+batchLen, numCmds));
+
+    if (NULL == pCmdReqBuffer)
+    {
+        //WINC_ERROR_PRINT("error: unable to allocate socket write command request\n");
+        return false;
+    }
+
+    /* Initialise the command request for the batch of commands. */
+    cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, WINC_SOCK_CMD_REQ_SZ((160U*numCmds)+batchLen, numCmds), (int)numCmds, sockCmdRspCallbackHandler, (uintptr_t)pSockCtx);
+
+    if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
+    {
+        WINC_ERROR_PRINT("error: socket write command request initialisation failed\n");
+        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+        return false;
+    }
+
+    /* Calculate the pseudo-sequence number of the data being written. */
+    seqNum = pSockCtx->unAckedSeqNum + pSockCtx->sendBuffer.outstandingDataLen;
+
+    if (SOCK_DGRAM == pSockCtx->type)
+    {
+        uint8_t i;
+
+        for (i=0; i<numCmds; i++)
+        {
+            const WINC_SOCK_UDP_PKT *pPkt = &pSockCtx->sendBuffer.pUdpPktBuffers->pkts[pkkBufIdx];
+            WINC_TYPE typeRmtAddr;
+            size_t lenRmtAddr;
+            uintptr_t rmtAddr;
+
+            /* For UDP datagrams locate the destination address from the packet buffer. */
+            if (AF_INET == pPkt->endPt.sin_family)
+            {
+                typeRmtAddr = WINC_TYPE_IPV4ADDR;
+                lenRmtAddr  = 4;
+                rmtAddr     = (uintptr_t)&pPkt->endPt.in4.sin_addr;
+            }
+            else
+            {
+                typeRmtAddr = WINC_TYPE_IPV6ADDR;
+                lenRmtAddr  = 16;
+                rmtAddr     = (uintptr_t)&pPkt->endPt.in6.sin6_addr;
+            }
+
+            /* Issue a SOCKWRTO command. */
+            (void)WINC_CmdSOCKWRTO(cmdReqHandle, pSockCtx->sockId, typeRmtAddr, rmtAddr, lenRmtAddr, ntohs(pPkt->endPt.sin_port), pPkt->pktLength, (int32_t)seqNum, &pSockCtx->sendBuffer.pData[pPkt->pktOffset], pPkt->pktLength);
+
+            seqNum += pPkt->pktLength;
+
+            pkkBufIdx++;
+
+            if (pkkBufIdx >= pSockCtx->sendBuffer.pUdpPktBuffers->numPkts)
+            {
+                pkkBufIdx -= pSockCtx->sendBuffer.pUdpPktBuffers->numPkts;
+            }
+        }
+    }
+    else
+    {
+        /* For TCP sockets issue a SOCKWR command. */
+        (void)WINC_CmdSOCKWR(cmdReqHandle, pSockCtx->sockId, dataLenToWrite, (int32_t)seqNum, &pSockCtx->sendBuffer.pData[outOffset], dataLenToWrite);
+    }
+
+    if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
+    {
+        WINC_ERROR_PRINT("error: socket write command request tranmission failed\n");
+        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+        return false;
+    }
+
+    pSockCtx->sendBuffer.outstandingDataLen += (uint16_t)batchLen;
+    pSockCtx->udpUnackedPktBufs             += numCmds;
+
+    return true;
+}
+
+/*****************************************************************************
+  Description:
+    Returns either the local or remote address.
+
+  Parameters:
+    fd          - Socket file descriptor.
+    addr        - Pointer to address structure.
+    addrlen     - Length of address structure.
+    localEndPtr - Flag indicating if local or remote address required.
+
+  Returns:
+    On success, zero is returned.  On error, -1 is returned, and errno is set
+    to indicate the error.
+
+  Remarks:
+        EFAULT
+            System fault.
+        EINVAL
+            addrlen is invalid (e.g., is negative).
+        ENOTSOCK
+            The file descriptor fd does not refer to a socket.
+        ENOTCONN
+            The socket is not connected, and no target has been given.
+
+ *****************************************************************************/
+
+static int sockGetEndPtName(int fd, struct sockaddr *addr, socklen_t *addrlen, bool localEndPtr)
+{
+    WINC_SOCK_CTX *pSockCtx = WINC_SOCK_HANDLE_TO_PTR(fd);
+    size_t endPtAddrLen;
+    SOCKADDR_UNION *pEndPt;
+
+    if ((NULL == pSockCtx) || (NULL == addr) || (NULL == addrlen))
+    {
+        errno = EFAULT;
+        return -1;
+    }
+
+    if (*addrlen < 0)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (false == sockLockSocket(pSockCtx))
+    {
+        errno = EFAULT;
+        return -1;
+    }
+
+    if (0U == pSockCtx->sockId)
+    {
+        sockUnlockSocket(pSockCtx);
+        errno = ENOTSOCK;
+        return -1;
+    }
+
+    if (true == localEndPtr)
+    {
+        pEndPt = &pSockCtx->localEndPt;
+    }
+    else
+    {
+        pEndPt = &pSockCtx->remoteEndPt;
+    }
+
+    if (AF_UNSPEC == pEndPt->sin_family)
+    {
+        sockUnlockSocket(pSockCtx);
+        errno = ENOTCONN;
+        return -1;
+    }
+
+    endPtAddrLen = sizeof_sockaddr(&pEndPt->sa);
+
+    if (*addrlen > endPtAddrLen)
+    {
+        *addrlen = endPtAddrLen;
+    }
+
+    memcpy(addr, pEndPt, *addrlen);
+
+    *addrlen = endPtAddrLen;
+
+    sockUnlockSocket(pSockCtx);
+    return 0;
+}
+
+/*****************************************************************************
+  Description:
+    Send a socket event via the callback.
+
+  Parameters:
+    pSockCtx - Pointer to socket context
+    event    - Socket event.
+    status   - Socket status.
+
+  Returns:
+    true or false indicating success or failure.
+
+  Remarks:
+
+ *****************************************************************************/
+
+static void sockEventCallback(WINC_SOCK_CTX *pSockCtx, WINC_SOCKET_EVENT event, WINC_SOCKET_STATUS status)
+{
+    if (NULL == pSockCtx)
+    {
+        return;
+    }
+
+    sockEpollNotify(pSockCtx);
+
+    if (NULL != pfSocketEventCallback)
+    {
+        sockUnlockSocket(pSockCtx);
+
+        pfSocketEventCallback(socketEventCallbackContext, WINC_SOCK_PTR_TO_HANDLE(pSockCtx), event, status);
+
+        if (false == sockLockSocket(pSockCtx))
+        {
+        }
+    }
+}
+
+//*******************************************************************************
+/*
+  Description:
+    Processes command status responses received via WINC_DEV_CMDREQ_EVENT_CMD_STATUS events.
+
+  Parameters:
+    pSockCtx     - Pointer to socket context.
+    cmdID        - Command ID.
+    cmdReqHandle - Command request handle.
+    pSrcCmd      - Pointer to source command.
+    statusCode   - Status code.
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+
+*/
+
+static void sockProcessStatus
+(
+    WINC_SOCK_CTX *pSockCtx,
+    uint16_t cmdID,
+    WINC_CMD_REQ_HANDLE cmdReqHandle,
+    const WINC_DEV_EVENT_SRC_CMD *const pSrcCmd,
+    uint16_t statusCode
+)
+{
+    WINC_SOCKET_STATUS status = WINC_SOCKET_STATUS_OK;
+
+    if ((NULL == pSockCtx) || (NULL == pSrcCmd))
+    {
+        return;
+    }
+
+    /* Set status based on success/failure of command. */
+    if (WINC_STATUS_OK != statusCode)
+    {
+//        WINC_ERROR_PRINT("error: command %04x error %04x\n", cmdID, statusCode);
+        status = WINC_SOCKET_STATUS_ERROR;
+    }
+
+    switch (cmdID)
+    {
+        case WINC_CMD_ID_SOCKO:
+        {
+            if (WINC_SOCKET_ASYNC_MODE_OFF != (WINC_SOCKET_ASYNC_MODE_TYPE)pSockCtx->readMode)
+            {
+                WINC_CMD_REQ_HANDLE sockCmdReqHandle;
+                void *pCmdReqBuffer;
+
+                pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, WINC_SOCK_CMD_REQ_SZ(256, 2));
+
+                if (NULL == pCmdReqBuffer)
+                {
+                    break;
+                }
+
+                sockCmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, WINC_SOCK_CMD_REQ_SZ(256, 2), 2, sockCmdRspCallbackHandler, (uintptr_t)pSockCtx);
+
+                if (WINC_CMD_REQ_INVALID_HANDLE == sockCmdReqHandle)
+                {
+                    slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+                    break;
+                }
+
+                (void)sockAsyncModeConf(sockCmdReqHandle, pSockCtx);
+
+                if (false == WINC_DevTransmitCmdReq(wincDevHandle, sockCmdReqHandle))
+                {
+                    slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+                    break;
+                }
+
+                pSockCtx->nextSeqNum = 0;
+            }
+
+            sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_OPEN, status);
+            break;
+        }
+
+        case WINC_CMD_ID_SOCKBL:
+        {
+            if ((SOCK_DGRAM == pSockCtx->type) && (IPPROTO_TLS != pSockCtx->protocol))
+            {
+                /* SOCKBL success indicates a connected socket. */
+                pSockCtx->connected = true;
+            }
+
+            sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_LISTEN, status);
+            break;
+        }
+
+        case WINC_CMD_ID_SOCKBR:
+        case WINC_CMD_ID_SOCKBM:
+        {
+            if ((SOCK_DGRAM == pSockCtx->type) && (IPPROTO_TLS != pSockCtx->protocol))
+            {
+                /* SOCKBR success indicates a connected socket. */
+                pSockCtx->connected = true;
+
+                sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_CONNECT, status);
+            }
+
+            break;
+        }
+
+        case WINC_CMD_ID_SOCKCL:
+        {
+            sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_CLOSE, status);
+
+            /* SOCKCL complete, close socket. */
+            sockDestroySocket(pSockCtx);
+            pSockCtx = NULL;
+            break;
+        }
+
+        case WINC_CMD_ID_SOCKWR:
+        case WINC_CMD_ID_SOCKWRTO:
+        {
+            WINC_DEV_PARAM_ELEM elems[10];
+            uint16_t seqNum;
+
+            if (pSrcCmd->numParams < 3U)
+            {
+                break;
+            }
+
+            /* Unpack the SOCKWR/SOCKWRTO command. */
+            if (true == WINC_DevUnpackElements(pSrcCmd->numParams, pSrcCmd->pParams, elems))
+            {
+                uint16_t dataLength;
+
+                /* Read the length and sequence number of the socket write command. */
+                (void)WINC_CmdReadParamElem(&elems[pSrcCmd->numParams-3U], WINC_TYPE_INTEGER, &dataLength, sizeof(dataLength));
+                (void)WINC_CmdReadParamElem(&elems[pSrcCmd->numParams-2U], WINC_TYPE_INTEGER, &seqNum, sizeof(seqNum));
+
+                sockProcessStatusWR(pSockCtx, seqNum, dataLength, statusCode);
+            }
+
+            if (WINC_STATUS_OK == statusCode)
+            {
+                sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_SEND, status);
+
+                /* Perform a new device write, on success. */
+                (void)sockWrite(pSockCtx);
+            }
+            else if ((WINC_STATUS_SOCKET_NOT_READY == statusCode) || (WINC_STATUS_SOCKET_SEQUENCE_ERROR == statusCode))
+            {
+                /* Perform a new device write, non-fatal error. */
+                (void)sockWrite(pSockCtx);
+            }
+            else
+            {
+                sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_SEND, status);
+            }
+
+            break;
+        }
+
+        case WINC_CMD_ID_SOCKRD:
+        {
+            if (pSockCtx->numReadsOutstanding > 0U)
+            {
+                pSockCtx->numReadsOutstanding--;
+            }
+
+            if (WINC_STATUS_OK != statusCode)
+            {
+                WINC_DEV_PARAM_ELEM elems[10];
+                uint16_t reqLength;
+
+                /* No response will follow, release the data claimed by this read. */
+                if ((true == WINC_DevUnpackElements(pSrcCmd->numParams, pSrcCmd->pParams, elems)) &&
+                    (0U != WINC_CmdReadParamElem(&elems[2], WINC_TYPE_INTEGER, &reqLength, sizeof(reqLength))))
+                {
+                    if (reqLength > pSockCtx->recvBuffer.outstandingDataLen)
+                    {
+                        reqLength = pSockCtx->recvBuffer.outstandingDataLen;
+                    }
+
+                    pSockCtx->recvBuffer.outstandingDataLen -= reqLength;
+                }
+            }
+
+            if (true == pSockCtx->newRecvData)
+            {
+                sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_RECV, status);
+            }
+
+            if (WINC_STATUS_OK == statusCode)
+            {
+                if ((true == pSockCtx->connected) || (true == pSockCtx->newRecvData))
+                {
+                    /* Perform another device read, only if connected or data waiting. */
+                    (void)sockRead(pSockCtx);
+                }
+            }
+
+            break;
+        }
+
+        default:
+        {
+            /* Do nothing. */
+            break;
+        }
+    }
+}
+
+//*******************************************************************************
+/*
+  Description:
+    Processes command responses received via WINC_DEV_CMDREQ_EVENT_RSP_RECEIVED events.
+
+  Parameters:
+    pSockCtx     - Pointer to socket context.
+    rspId        - Response command ID.
+    cmdReqHandle - Command request handle.
+    pSrcCmd      - Pointer to source command.
+    numElems     - Number of elements in response.
+    pElems       - Pointer to response elements.
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+
+*/
+
+static void sockProcessCmdRsp
+(
+    WINC_SOCK_CTX *pSockCtx,
+    uint16_t rspId,
+    WINC_CMD_REQ_HANDLE cmdReqHandle,
+    const WINC_DEV_EVENT_SRC_CMD *const pSrcCmd,
+    int numElems,
+    const WINC_DEV_PARAM_ELEM *const pElems
+)
+{
+    if ((NULL == pSockCtx) || (NULL == pElems) || (NULL == pSrcCmd))
+    {
+        return;
+    }
+
+    switch (rspId)
+    {
+        case WINC_CMD_ID_SOCKO:
+        {
+            if (1U != numElems)
+            {
+                break;
+            }
+
+            /* Read the socket ID from the SOCKO response. */
+            if (0U == pSockCtx->sockId)
+            {
+                uint16_t sockId = 0;
+
+                (void)WINC_CmdReadParamElem(&pElems[0], WINC_TYPE_INTEGER, &sockId, sizeof(sockId));
+
+                sockSetID(pSockCtx, sockId);
+
+                WINC_TRACE_PRINT("Socket ID is %d (%04x)\n", pSockCtx->sockId, pSockCtx->sockId);
+            }
+
+            break;
+        }
+
+        case WINC_CMD_ID_SOCKRD:
+        {
+            uint16_t sockId;
+            uint16_t length;
+            uint16_t reqLength;
+            WINC_DEV_PARAM_ELEM elems[10];
+
+            /* Read the socket ID and verify it matches this socket. */
+            (void)WINC_CmdReadParamElem(&pElems[0], WINC_TYPE_INTEGER, &sockId, sizeof(sockId));
+
+            /* Unpack original command parameters. */
+            if (false == WINC_DevUnpackElements(pSrcCmd->numParams, pSrcCmd->pParams, elems))
+            {
+                break;
+            }
+
+            (void)WINC_CmdReadParamElem(&elems[2], WINC_TYPE_INTEGER, &reqLength, sizeof(reqLength));
+
+            if (sockId == pSockCtx->sockId)
+            {
+                SOCKADDR_UNION *pSourceAddr = NULL;
+                SOCKADDR_UNION sourceAddr;
+
+                /* Read the data length of the SOCKRD response. */
+                (void)WINC_CmdReadParamElem(&pElems[1], WINC_TYPE_INTEGER, &length, sizeof(length));
+
+                if (length != reqLength)
+                {
+                    WINC_ERROR_PRINT("Error, length mismatch %d vs %d\n", length, reqLength);
+                }
+
+                /* The application has consumed all previous data, allow more reads in flight. */
+                if ((SOCK_STREAM == pSockCtx->type) && (0U == pSockCtx->recvBuffer.length) && (pSockCtx->readWindow < WINC_SOCK_RD_WINDOW_MAX))
+                {
+                    pSockCtx->readWindow++;
+                }
+
+#ifdef WINC_SOCK_BUF_AUTOTUNE_ENABLE
+                if ((SOCK_STREAM == pSockCtx->type) && (0U == pSockCtx->recvBuffer.length))
+                {
+                    pSockCtx->recvBuffer.tuneStarved = true;
+                }
+#endif
+
+                WINC_TRACE_PRINT("SR-: %d - %d\n", pSockCtx->recvBuffer.outstandingDataLen, reqLength);
+
+                /* Release the data claimed by this read. */
+                if (reqLength > pSockCtx->recvBuffer.outstandingDataLen)
+                {
+                    reqLength = pSockCtx->recvBuffer.outstandingDataLen;
+                }
+
+                pSockCtx->recvBuffer.outstandingDataLen -= reqLength;
+
+                if (numElems >= 4U)
+                {
+                    /* For extended SOCKRD response, read the pending data count and update the socket context. */
+                    (void)WINC_CmdReadParamElem(&pElems[2], WINC_TYPE_INTEGER, &pSockCtx->pendingRecvDataLen, sizeof(pSockCtx->pendingRecvDataLen));
+
+                    WINC_TRACE_PRINT("SP %d\n", pSockCtx->pendingRecvDataLen);
+
+                    if (7U == numElems)
+                    {
+                        /* For UDP datagram reads read out the address information received. */
+                        if (NULL == pSockCtx->recvBuffer.pUdpPktBuffers)
+                        {
+                            WINC_ERROR_PRINT("error: no allocated packet buffers\n");
+                            break;
+                        }
+
+                        /* Check we have packet buffers to store the datagram into. */
+                        if (pSockCtx->recvBuffer.pUdpPktBuffers->pktDepth == pSockCtx->recvBuffer.pUdpPktBuffers->numPkts)
+                        {
+                            WINC_ERROR_PRINT("error: packet buffers full\n");
+                            break;
+                        }
+
+                        pSourceAddr = &sourceAddr;
+
+                        /* Read the source address. */
+                        if (WINC_TYPE_IPV4ADDR == pElems[4].type)
+                        {
+                            pSourceAddr->in4.sin_family = AF_INET;
+
+                            (void)WINC_CmdReadParamElem(&pElems[4], WINC_TYPE_IPV4ADDR, &pSourceAddr->in4.sin_addr, sizeof(struct in_addr));
+                            (void)WINC_CmdReadParamElem(&pElems[5], WINC_TYPE_INTEGER, &pSourceAddr->in4.sin_port, sizeof(in_port_t));
+
+                            pSourceAddr->in4.sin_port = htons(pSourceAddr->in4.sin_port);
+                        }
+                        else if (WINC_TYPE_IPV6ADDR == pElems[4].type)
+                        {
+                            pSourceAddr->in6.sin6_family = AF_INET6;
+
+                            (void)WINC_CmdReadParamElem(&pElems[4], WINC_TYPE_IPV6ADDR, &pSourceAddr->in6.sin6_addr, sizeof(struct in6_addr));
+                            (void)WINC_CmdReadParamElem(&pElems[5], WINC_TYPE_INTEGER, &pSourceAddr->in6.sin6_port, sizeof(in_port_t));
+
+                            pSourceAddr->in6.sin6_port = htons(pSourceAddr->in6.sin6_port);
+                        }
+                        else
+                        {
+                            WINC_ERROR_PRINT("error: unknown address type (%d)\n", pElems[4].type);
+                            break;
+                        }
+                    }
+                }
+                else
+                {
+                    pSockCtx->pendingRecvDataLen -= length;
+                    WINC_TRACE_PRINT("SP %d (-%d)\n", pSockCtx->pendingRecvDataLen, length);
+                }
+
+                /* Write the received data into the socket buffer for the application to pull. */
+                if (true == sockBufferWrite(&pSockCtx->recvBuffer, pElems[numElems-1U].pData, length, pSourceAddr, false))
+                {
+                    pSockCtx->newRecvData = true;
+                }
+                else
+                {
+                    WINC_ERROR_PRINT("error: failed to write to receive buffer\n");
+                }
+            }
+
+            break;
+        }
+
+        case WINC_CMD_ID_SOCKC:
+        {
+            uint8_t id;
+            int32_t value;
+
+            if (2U != numElems)
+            {
+                break;
+            }
+
+            (void)WINC_CmdReadParamElem(&pElems[0], WINC_TYPE_INTEGER, &id, sizeof(id));
+            (void)WINC_CmdReadParamElem(&pElems[1], WINC_TYPE_INTEGER, &value, sizeof(value));
+
+            WINC_TRACE_PRINT("Sock ID %04x CFG: %2d = %d\n", pSockCtx->sockId, id, value);
+            break;
+        }
+
+        default:
+        {
+            /* Do nothing. */
+            break;
+        }
+    }
+}
+
+//*******************************************************************************
+/*
+  Description:
+    Processes AECs for sockets.
+
+  Parameters:
+    sockId   - Socket ID.
+    pSockCtx - Pointer to socket context.
+    aecId    - AEC ID.
+    numElems - Number of elements.
+    pElems   - Pointer to elements.
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+
+*/
+
+static void sockProcessAEC
+(
+    uint16_t sockId,
+    WINC_SOCK_CTX *pSockCtx,
+    uint16_t aecId,
+    int numElems,
+    const WINC_DEV_PARAM_ELEM *const pElems
+)
+{
+    if (NULL == pElems)
+    {
+        return;
+    }
+
+    switch (aecId)
+    {
+        case WINC_AEC_ID_SOCKIND:
+        {
+            WINC_SOCK_CTX *pListeningSockCtx;
+            bool newSocket = false;
+
+            if (5U != numElems)
+            {
+                break;
+            }
+
+            if (NULL == pSockCtx)
+            {
+                /* Socket ID not recognised, need to add for TCP server. */
+                pSockCtx = sockFindFreeSocket();
+
+                if (NULL == pSockCtx)
+                {
+                    WINC_ERROR_PRINT("error: no free sockets\n");
+                    break;
+                }
+
+                if (false == sockCreateSocket(pSockCtx, SOCK_STREAM, sockId))
+                {
+                    WINC_ERROR_PRINT("error: failed to create new receive socket\n");
+                    return;
+                }
+
+                if (false == sockLockSocket(pSockCtx))
+                {
+                    return;
+                }
+
+                newSocket = true;
+            }
+
+            /* Check socket address types match. */
+            if (pElems[1].type != pElems[3].type)
+            {
+                WINC_ERROR_PRINT("error: address type mismatch (%d != %d)\n", pElems[1].type, pElems[3].type);
+            }
+
+            if (WINC_TYPE_IPV4ADDR == pElems[1].type)
+            {
+                /* Extract and store local and remote IPv4 addresses. */
+                pSockCtx->localEndPt.in4.sin_family = AF_INET;
+
+                (void)WINC_CmdReadParamElem(&pElems[1], WINC_TYPE_IPV4ADDR, &pSockCtx->localEndPt.in4.sin_addr, sizeof(struct in_addr));
+                (void)WINC_CmdReadParamElem(&pElems[2], WINC_TYPE_INTEGER, &pSockCtx->localEndPt.in4.sin_port, sizeof(in_port_t));
+
+                pSockCtx->localEndPt.in4.sin_port = htons(pSockCtx->localEndPt.in4.sin_port);
+
+                pSockCtx->remoteEndPt.in4.sin_family = AF_INET;
+
+                (void)WINC_CmdReadParamElem(&pElems[3], WINC_TYPE_IPV4ADDR, &pSockCtx->remoteEndPt.in4.sin_addr, sizeof(struct in_addr));
+                (void)WINC_CmdReadParamElem(&pElems[4], WINC_TYPE_INTEGER, &pSockCtx->remoteEndPt.in4.sin_port, sizeof(in_port_t));
+
+                pSockCtx->remoteEndPt.in4.sin_port = htons(pSockCtx->remoteEndPt.in4.sin_port);
+            }
+            else if (WINC_TYPE_IPV6ADDR == pElems[1].type)
+            {
+                /* Extract and store local and remote IPv6 addresses. */
+                pSockCtx->localEndPt.in6.sin6_family = AF_INET6;
+
+                (void)WINC_CmdReadParamElem(&pElems[1], WINC_TYPE_IPV6ADDR, &pSockCtx->localEndPt.in6.sin6_addr, sizeof(struct in6_addr));
+                (void)WINC_CmdReadParamElem(&pElems[2], WINC_TYPE_INTEGER, &pSockCtx->localEndPt.in6.sin6_port, sizeof(in_port_t));
+
+                pSockCtx->localEndPt.in6.sin6_port = htons(pSockCtx->localEndPt.in6.sin6_port);
+
+                pSockCtx->remoteEndPt.in6.sin6_family = AF_INET6;
+
+                (void)WINC_CmdReadParamElem(&pElems[3], WINC_TYPE_IPV6ADDR, &pSockCtx->remoteEndPt.in6.sin6_addr, sizeof(struct in6_addr));
+                (void)WINC_CmdReadParamElem(&pElems[4], WINC_TYPE_INTEGER, &pSockCtx->remoteEndPt.in6.sin6_port, sizeof(in_port_t));
+
+                pSockCtx->remoteEndPt.in6.sin6_port = htons(pSockCtx->remoteEndPt.in6.sin6_port);
+            }
+            else
+            {
+                WINC_ERROR_PRINT("error: unknown address type (%d)\n", pElems[1].type);
+                break;
+            }
+
+            if (false == pSockCtx->tlsPending)
+            {
+                pSockCtx->connected = true;
+            }
+
+            if (true == newSocket)
+            {
+                /* A new socket was created, find the listening socket it goes with. */
+                pListeningSockCtx = sockFindListeningSocket(pSockCtx);
+
+                if (NULL == pListeningSockCtx)
+                {
+                    WINC_ERROR_PRINT("error: unable to find listening socket\n");
+                    sockDestroySocket(pSockCtx);
+                    pSockCtx = NULL;
+                    break;
+                }
+
+                if (false == sockLockSocket(pListeningSockCtx))
+                {
+                    sockDestroySocket(pSockCtx);
+                    pSockCtx = NULL;
+                    break;
+                }
+
+                /* Queue the new connection for accept(). */
+                sockPendingAdd(pListeningSockCtx, pSockCtx);
+
+                /* Send connect request event. */
+                sockEventCallback(pListeningSockCtx, WINC_SOCKET_EVENT_CONNECT_REQ, WINC_SOCKET_STATUS_OK);
+
+                /* Copy configuration from listening socket. */
+                pSockCtx->readMode  = pListeningSockCtx->readMode;
+                pSockCtx->domain    = pListeningSockCtx->domain;
+                pSockCtx->protocol  = pListeningSockCtx->protocol;
+                pSockCtx->recvBufSz = pListeningSockCtx->recvBufSz;
+                pSockCtx->sendBufSz = pListeningSockCtx->sendBufSz;
+                pSockCtx->numRxPkts = pListeningSockCtx->numRxPkts;
+                pSockCtx->numTxPkts = pListeningSockCtx->numTxPkts;
+
+                sockUnlockSocket(pListeningSockCtx);
+                sockUnlockSocket(pSockCtx);
+            }
+            else if (true == pSockCtx->connected)
+            {
+                /* Send connect event. */
+                sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_CONNECT, WINC_SOCKET_STATUS_OK);
+            }
+            else
+            {
+                /* Do nothing. */
+            }
+
+            WINC_TRACE_PRINT("Socket ID is %d (%04x)\n", pSockCtx->sockId, pSockCtx->sockId);
+
+            break;
+        }
+
+        case WINC_AEC_ID_SOCKRXT:
+        {
+            if (NULL == pSockCtx)
+            {
+                break;
+            }
+
+            if (WINC_SOCKET_ASYNC_MODE_OFF == (WINC_SOCKET_ASYNC_MODE_TYPE)pSockCtx->readMode)
+            {
+                if (2U != numElems)
+                {
+                    break;
+                }
+
+                /* Read the new pending data length values. */
+                (void)WINC_CmdReadParamElem(&pElems[1], WINC_TYPE_INTEGER, &pSockCtx->pendingRecvDataLen, sizeof(uint16_t));
+
+                WINC_TRACE_PRINT("RXT %d\n", pSockCtx->pendingRecvDataLen);
+
+                /* Trigger a socket read from device. */
+                (void)sockRead(pSockCtx);
+            }
+            else
+            {
+                if ((4U == numElems) || (3U == numElems))
+                {
+                    uint16_t length;
+                    uint16_t seqNum;
+
+                    (void)WINC_CmdReadParamElem(&pElems[1], WINC_TYPE_INTEGER_UNSIGNED, &length, sizeof(length));
+
+                    if (4U == numElems)
+                    {
+                        (void)WINC_CmdReadParamElem(&pElems[2], WINC_TYPE_INTEGER_UNSIGNED, &seqNum, sizeof(seqNum));
+
+                        WINC_TRACE_PRINT("RXT %d %d\n", seqNum, length);
+                    }
+                    else
+                    {
+                        WINC_TRACE_PRINT("RXT %d\n", length);
+                    }
+
+                    /* Write the received data into the socket buffer for the application to pull. */
+                    if (true == sockBufferWrite(&pSockCtx->recvBuffer, pElems[numElems-1U].pData, length, NULL, true))
+                    {
+                        pSockCtx->newRecvData = true;
+
+                        sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_RECV, WINC_SOCKET_STATUS_OK);
+                    }
+                    else
+                    {
+                        WINC_ERROR_PRINT("error: failed to write to receive buffer\n");
+                    }
+                }
+            }
+
+            break;
+        }
+
+        case WINC_AEC_ID_SOCKRXU:
+        {
+            if (NULL == pSockCtx)
+            {
+                break;
+            }
+
+            if (WINC_SOCKET_ASYNC_MODE_OFF == (WINC_SOCKET_ASYNC_MODE_TYPE)pSockCtx->readMode)
+            {
+                /* Read the new pending data length values. */
+                (void)WINC_CmdReadParamElem(&pElems[3], WINC_TYPE_INTEGER, &pSockCtx->pendingRecvDataLen, sizeof(uint16_t));
+
+                WINC_TRACE_PRINT("RXU %d\n", pSockCtx->pendingRecvDataLen);
+
+                /* Trigger a socket read from device. */
+                (void)sockRead(pSockCtx);
+            }
+            else
+            {
+                if ((6U == numElems) || (5U == numElems))
+                {
+                    SOCKADDR_UNION *pSourceAddr = NULL;
+                    SOCKADDR_UNION sourceAddr;
+                    uint16_t length;
+                    uint16_t seqNum;
+
+                    if (NULL == pSockCtx->recvBuffer.pUdpPktBuffers)
+                    {
+                        WINC_ERROR_PRINT("error: no allocated packet buffers\n");
+                        break;
+                    }
+
+                    /* Check we have packet buffers to store the datagram into. */
+                    if (pSockCtx->recvBuffer.pUdpPktBuffers->pktDepth == pSockCtx->recvBuffer.pUdpPktBuffers->numPkts)
+                    {
+                        WINC_ERROR_PRINT("error: packet buffers full\n");
+                        break;
+                    }
+
+                    pSourceAddr = &sourceAddr;
+
+                    /* Read the source address. */
+                    if (WINC_TYPE_IPV4ADDR == pElems[1].type)
+                    {
+                        pSourceAddr->in4.sin_family = AF_INET;
+
+                        (void)WINC_CmdReadParamElem(&pElems[1], WINC_TYPE_IPV4ADDR, &pSourceAddr->in4.sin_addr, sizeof(struct in_addr));
+                        (void)WINC_CmdReadParamElem(&pElems[2], WINC_TYPE_INTEGER, &pSourceAddr->in4.sin_port, sizeof(in_port_t));
+
+                        pSourceAddr->in4.sin_port = htons(pSourceAddr->in4.sin_port);
+                    }
+                    else if (WINC_TYPE_IPV6ADDR == pElems[1].type)
+                    {
+                        pSourceAddr->in6.sin6_family = AF_INET6;
+
+                        (void)WINC_CmdReadParamElem(&pElems[1], WINC_TYPE_IPV6ADDR, &pSourceAddr->in6.sin6_addr, sizeof(struct in6_addr));
+                        (void)WINC_CmdReadParamElem(&pElems[2], WINC_TYPE_INTEGER, &pSourceAddr->in6.sin6_port, sizeof(in_port_t));
+
+                        pSourceAddr->in6.sin6_port = htons(pSourceAddr->in6.sin6_port);
+                    }
+                    else
+                    {
+                        WINC_ERROR_PRINT("error: unknown address type (%d)\n", pElems[1].type);
+                        break;
+                    }
+
+                    (void)WINC_CmdReadParamElem(&pElems[3], WINC_TYPE_INTEGER_UNSIGNED, &length, sizeof(length));
+
+                    if (6U == numElems)
+                    {
+                        (void)WINC_CmdReadParamElem(&pElems[4], WINC_TYPE_INTEGER_UNSIGNED, &seqNum, sizeof(seqNum));
+
+                        WINC_TRACE_PRINT("RXU %d %d\n", seqNum, length);
+                    }
+                    else
+                    {
+                        WINC_TRACE_PRINT("RXU %d\n", length);
+                    }
+
+                    /* Write the received data into the socket buffer for the application to pull. */
+                    if (true == sockBufferWrite(&pSockCtx->recvBuffer, pElems[numElems-1U].pData, length, pSourceAddr, false))
+                    {
+                        pSockCtx->newRecvData = true;
+
+                        sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_RECV, WINC_SOCKET_STATUS_OK);
+                    }
+                    else
+                    {
+                        WINC_ERROR_PRINT("error: failed to write to receive buffer\n");
+                    }
+                }
+            }
+
+            break;
+        }
+
+        case WINC_AEC_ID_SOCKCL:
+        {
+            if (1U != numElems)
+            {
+                break;
+            }
+
+            if (NULL != pSockCtx)
+            {
+                /* Disconnect the socket. */
+                pSockCtx->connected = false;
+                pSockCtx->events   |= POLLHUP;
+            }
+            break;
+        }
+
+        case WINC_AEC_ID_SOCKTLS:
+        {
+            if (1U != numElems)
+            {
+                break;
+            }
+
+            if (NULL != pSockCtx)
+            {
+                pSockCtx->connected  = true;
+                pSockCtx->tlsPending = false;
+
+                sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_CONNECT, WINC_SOCKET_STATUS_OK);
+                sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_TLS_CONNECT, WINC_SOCKET_STATUS_OK);
+            }
+            break;
+        }
+
+        case WINC_AEC_ID_SOCKERR:
+        {
+            if (2U != numElems)
+            {
+                break;
+            }
+
+            if (NULL != pSockCtx)
+            {
+                pSockCtx->events |= POLLERR;
+                sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_ERROR, WINC_SOCKET_STATUS_ERROR);
+            }
+            break;
+        }
+
+        default:
+        {
+            /* Do nothing. */
+            break;
+        }
+    }
+}
+
+//*******************************************************************************
+/*
+  Description:
+    Processes AECs for DNS.
+
+  Parameters:
+    aecId    - AEC ID.
+    numElems - Number of elements.
+    pElems   - Pointer to elements.
+
+  Returns:
+    None.
+
+  Remarks:
+    None.
+
+*/
+
+static void dnsProcessAEC
+(
+    uint16_t aecId,
+    int numElems,
+    const WINC_DEV_PARAM_ELEM *const pElems
+)
+{
+    if (NULL == pElems)
+    {
+        return;
+    }
+
+    switch (aecId)
+    {
+        case WINC_AEC_ID_DNSRESOLV:
+        {
+            WINC_DNS_REQ *pDnsRequest;
+            int recordType;
+
+            if (3U != numElems)
+            {
+                break;
+            }
+
+            if (NULL == initData.pfMemAlloc)
+            {
+                break;
+            }
+
+            /* Read the record type from the AEC. */
+            (void)WINC_CmdReadParamElem(&pElems[0], WINC_TYPE_INTEGER, &recordType, sizeof(recordType));
+
+            WINC_TRACE_PRINT("DNS '%.*s':%d\n", pElems[1].length, pElems[1].pData, pElems[1].length);
+
+            /* Find the request matching the response, later addresses may
+               follow the first which completed the request. */
+            pDnsRequest = dnsFindRequest(pElems[1].pData, pElems[1].length, -1);
+
+            if ((NULL != pDnsRequest) && ((0xFFFFU == pDnsRequest->reqStatus) || (WINC_STATUS_OK == pDnsRequest->reqStatus)))
+            {
+                struct addrinfo **pRes;
+
+                /* Load the requests result pointer. */
+                pRes = &pDnsRequest->pRes;
+
+                /* Iterate to the end of the list. */
+                while (NULL != *pRes)
+                {
+                    pRes = &(*pRes)->ai_next;
+                }
+
+                /* Allocate space for the new results. */
+                *pRes = initData.pfMemAlloc(sizeof(struct addrinfo) + sizeof(SOCKADDR_UNION));
+
+                if (NULL != *pRes)
+                {
+                    /* Copy the response into the results structure. */
+                    (void)memset(*pRes, 0, sizeof(struct addrinfo) + sizeof(SOCKADDR_UNION));
+
+                    (*pRes)->ai_addr = (struct sockaddr*)&(*pRes)[1];
+                    (*pRes)->ai_next = NULL;
+
+                    if (WINC_TYPE_IPV4ADDR == pElems[2].type)
+                    {
+                        /* Read an IPv4 address. */
+                        (*pRes)->ai_family  = (int)AF_INET;
+                        (*pRes)->ai_addrlen = sizeof(struct sockaddr_in);
+
+                        ((struct sockaddr_in*)(*pRes)->ai_addr)->sin_family = AF_INET;
+                        (void)WINC_CmdReadParamElem(&pElems[2], WINC_TYPE_IPV4ADDR, &((struct sockaddr_in*)(*pRes)->ai_addr)->sin_addr, sizeof(struct in_addr));
+                    }
+                    else if (WINC_TYPE_IPV6ADDR == pElems[2].type)
+                    {
+                        /* Read an IPv6 address. */
+                        (*pRes)->ai_family  = (int)AF_INET6;
+                        (*pRes)->ai_addrlen = sizeof(struct sockaddr_in6);
+
+                        ((struct sockaddr_in6*)(*pRes)->ai_addr)->sin6_family = AF_INET6;
+                        (void)WINC_CmdReadParamElem(&pElems[2], WINC_TYPE_IPV6ADDR, &((struct sockaddr_in6*)(*pRes)->ai_addr)->sin6_addr, sizeof(struct in6_addr));
+                    }
+                    else
+                    {
+                        WINC_ERROR_PRINT("error: unknown address type (%d)\n", pElems[2].type);
+                    }
+                }
+
+                if (0xFFFFU == pDnsRequest->reqStatus)
+                {
+                    dnsRequestComplete(pDnsRequest, WINC_STATUS_OK);
+                }
+            }
+
+            break;
+        }
+
+        case WINC_AEC_ID_DNSERR:
+        {
+            WINC_DNS_REQ *pDnsRequest;
+            uint16_t reqStatus = 0xFFFFU;
+
+            if (3U != numElems)
+            {
+                break;
+            }
+
+            /* Find the request matching the response. */
+            pDnsRequest = dnsFindRequest(pElems[2].pData, pElems[2].length, -1);
+
+            if ((NULL != pDnsRequest) && (0xFFFFU == pDnsRequest->reqStatus))
+            {
+                /* Read the status from the AEC. */
+                (void)WINC_CmdReadParamElem(&pElems[0], WINC_TYPE_STATUS, &reqStatus, sizeof(reqStatus));
+
+                dnsRequestComplete(pDnsRequest, reqStatus);
+            }
+
+            break;
+        }
+
+        default:
+        {
+            /* Do nothing. */
+            break;
+        }
+    }
+}
+
+/*****************************************************************************
+  Description:
+    Socket command response callback.
+
+  Parameters:
+    context      - Context provided to WINC_CmdReqInit for callback
+    devHandle    - WINC device handle
+    cmdReqHandle - Command request handle
+    event        - Event being raised
+    eventArg     - Optional argument for event
+
+  Returns:
+    None.
+
+  Remarks:
+
+ *****************************************************************************/
+
+static void sockCmdRspCallbackHandlerSeqUpdate(uintptr_t context, WINC_DEVICE_HANDLE devHandle, WINC_CMD_REQ_HANDLE cmdReqHandle, WINC_DEV_CMDREQ_EVENT_TYPE event, uintptr_t eventArg)
+{
+    /* context provided was the socket address. */
+    WINC_SOCK_CTX *pSockCtx = (WINC_SOCK_CTX*)context;
+
+    WINC_TRACE_PRINT("SOCK CmdRspCBSeqUp %08x Event (Sock %08x) %d\n", cmdReqHandle, context, event);
+
+    /* Command request is complete, no further need for it. */
+    if (WINC_DEV_CMDREQ_EVENT_STATUS_COMPLETE == event)
+    {
+        slabFree(pGlobalSlabAllocCtx, (WINC_COMMAND_REQUEST*)cmdReqHandle);
+    }
+
+    /* Only take further action if socket is not actually in use. */
+    if ((NULL == pSockCtx) || (false == pSockCtx->inUse))
+    {
+        return;
+    }
+
+    if (false == sockLockSocket(pSockCtx))
+    {
+        return;
+    }
+
+    if (WINC_DEV_CMDREQ_EVENT_TX_COMPLETE == event)
+    {
+        pSockCtx->seqNumUpdateSent = false;
+
+        /* More data was consumed while the update was in flight. */
+        if (true == pSockCtx->seqNumUpdatePending)
+        {
+            (void)sockSeqNumUpdate(pSockCtx);
+        }
+    }
+
+    sockUnlockSocket(pSockCtx);
+}
+
+/*****************************************************************************
+  Description:
+    Socket command response callback.
+
+  Parameters:
+    context      - Context provided to WINC_CmdReqInit for callback
+    devHandle    - WINC device handle
+    cmdReqHandle - Command request handle
+    event        - Event being raised
+    eventArg     - Optional argument for event
+
+  Returns:
+    None.
+
+  Remarks:
+
+ *****************************************************************************/
+
+static void sockCmdRspCallbackHandler(uintptr_t context, WINC_DEVICE_HANDLE devHandle, WINC_CMD_REQ_HANDLE cmdReqHandle, WINC_DEV_CMDREQ_EVENT_TYPE event, uintptr_t eventArg)
+{
+    /* context provided was the socket address. */
+    WINC_SOCK_CTX *pSockCtx = (WINC_SOCK_CTX*)context;
+
+    WINC_TRACE_PRINT("SOCK CmdRspCB %08x Event (Sock %08x) %d\n", cmdReqHandle, context, event);
+
+    /* Command request is complete, no further need for it. */
+    if (WINC_DEV_CMDREQ_EVENT_STATUS_COMPLETE == event)
+    {
+        slabFree(pGlobalSlabAllocCtx, (WINC_COMMAND_REQUEST*)cmdReqHandle);
+    }
+
+    /* Only take further action if socket is not actually in use. */
+    if ((NULL == pSockCtx) || (false == pSockCtx->inUse))
+    {
+        return;
+    }
+
+    if (false == sockLockSocket(pSockCtx))
+    {
+        return;
+    }
+
+    switch (event)
+    {
+        case WINC_DEV_CMDREQ_EVENT_TX_COMPLETE:
+        {
+            /* Command request transmission complete to WINC device. */
+            break;
+        }
+
+        case WINC_DEV_CMDREQ_EVENT_CMD_STATUS:
+        {
+            /* Status response received for command. */
+
+            WINC_DEV_EVENT_STATUS_ARGS *pStatusInfo = (WINC_DEV_EVENT_STATUS_ARGS*)eventArg;
+
+            if (NULL != pStatusInfo)
+            {
+                sockProcessStatus(pSockCtx, pStatusInfo->rspCmdId, cmdReqHandle, &pStatusInfo->srcCmd, pStatusInfo->status);
+            }
+
+            break;
+        }
+
+        case WINC_DEV_CMDREQ_EVENT_RSP_RECEIVED:
+        {
+            const WINC_DEV_EVENT_RSP_ELEMS *const pRspElems = (const WINC_DEV_EVENT_RSP_ELEMS *const)eventArg;
+
+            if (NULL != pRspElems)
+            {
+                sockProcessCmdRsp(pSockCtx, pRspElems->rspId, cmdReqHandle, &pRspElems->srcCmd, pRspElems->numElems, pRspElems->elems);
+            }
+            break;
+        }
+
+        default:
+        {
+            WINC_TRACE_PRINT("Sock CmdRspCB %08x event %d not handled\r\n", cmdReqHandle, event);
+            break;
+        }
+    }
+
+    if (true == pSockCtx->inUse)
+    {
+        sockEpollNotify(pSockCtx);
+        sockUnlockSocket(pSockCtx);
+    }
+
+    sockPollSignal();
+}
+
+/*****************************************************************************
+  Description:
+    Process socket AEC messages.
+
+  Parameters:
+    context   - Context provided to WINC_DevAECCallbackRegister for callback
+    devHandle - WINC device handle
+    pElems    - Pointer to AEC elements
+
+  Returns:
+    None.
+
+  Remarks:
+
+ *****************************************************************************/
+
+static void sockDevProcessAEC(uintptr_t context, WINC_DEVICE_HANDLE devHandle, const WINC_DEV_EVENT_RSP_ELEMS *const pElems)
+{
+    WINC_SOCK_CTX *pSockCtx;
+    uint16_t sockId;
+
+    if (NULL == pElems)
+    {
+        return;
+    }
+
+    if (pElems->numElems < 1U)
+    {
+        return;
+    }
+
+    /* Read the socket ID from the AEC. */
+    (void)WINC_CmdReadParamElem(&pElems->elems[0], WINC_TYPE_INTEGER, &sockId, sizeof(sockId));
+
+    /* Find relevant socket. */
+    pSockCtx = sockFindByID(sockId);
+
+    if ((NULL != pSockCtx) && (false == sockLockSocket(pSockCtx)))
+    {
+        return;
+    }
+
+    sockProcessAEC(sockId, pSockCtx, pElems->rspId, pElems->numElems, pElems->elems);
+
+    if ((NULL != pSockCtx) && (true == pSockCtx->inUse))
+    {
+        sockEpollNotify(pSockCtx);
+    }
+
+    sockUnlockSocket(pSockCtx);
+
+    sockPollSignal();
+}
+
+/*****************************************************************************
+  Description:
+    DNS command response callback.
+
+  Parameters:
+    context      - Context provided to WINC_CmdReqInit for callback
+    devHandle    - WINC device handle
+    cmdReqHandle - Command request handle
+    event        - Event being raised
+    eventArg     - Optional argument for event
+
+  Returns:
+    None.
+
+  Remarks:
+
+ *****************************************************************************/
+
+static void dnsCmdRspCallbackHandler(uintptr_t context, WINC_DEVICE_HANDLE devHandle, WINC_CMD_REQ_HANDLE cmdReqHandle, WINC_DEV_CMDREQ_EVENT_TYPE event, uintptr_t eventArg)
+{
+    /* context provided was the DNS request address. */
+    WINC_DNS_REQ *pDnsRequest = (WINC_DNS_REQ*)context;
+
+    switch (event)
+    {
+        case WINC_DEV_CMDREQ_EVENT_TX_COMPLETE:
+        {
+            break;
+        }
+
+        case WINC_DEV_CMDREQ_EVENT_STATUS_COMPLETE:
+        {
+            /* Command request is complete, no further need for it. */
+            slabFree(pGlobalSlabAllocCtx, (WINC_COMMAND_REQUEST*)cmdReqHandle);
+            break;
+        }
+
+        case WINC_DEV_CMDREQ_EVENT_CMD_STATUS:
+        {
+            const WINC_DEV_EVENT_STATUS_ARGS *pStatusInfo = (const WINC_DEV_EVENT_STATUS_ARGS*)eventArg;
+
+            if (WINC_STATUS_OK != pStatusInfo->status)
+            {
+                unsigned int i;
+
+                /* DNS request failed, complete the request if it is still in the table. */
+                for (i=0; i<WINC_SOCK_DNS_NUM_REQS; i++)
+                {
+                    if ((pDnsRequest == dnsRequests[i]) && (0xFFFFU == pDnsRequest->reqStatus))
+                    {
+                        dnsRequestComplete(pDnsRequest, pStatusInfo->status);
+                    }
+                }
+            }
+            break;
+        }
+
+        case WINC_DEV_CMDREQ_EVENT_RSP_RECEIVED:
+        {
+            const WINC_DEV_EVENT_RSP_ELEMS *pRspElems = (const WINC_DEV_EVENT_RSP_ELEMS*)eventArg;
+
+            if (NULL != pRspElems)
+            {
+            }
+            break;
+        }
+
+        default:
+        {
+            WINC_TRACE_PRINT("DNS CmdRspCB %08x event %d not handled\r\n", cmdReqHandle, event);
+            break;
+        }
+    }
+}
+
+/*****************************************************************************
+  Description:
+    Process DNS AEC messages.
+
+  Parameters:
+    context   - Context provided to WINC_DevAECCallbackRegister for callback
+    devHandle - WINC device handle
+    pElems    - Pointer to AEC elements
+
+  Returns:
+    None.
+
+  Remarks:
+
+ *****************************************************************************/
+
+static void dnsDevProcessAEC(uintptr_t context, WINC_DEVICE_HANDLE devHandle, const WINC_DEV_EVENT_RSP_ELEMS *const pElems)
+{
+    if (NULL == pElems)
+    {
+        return;
+    }
+
+    dnsProcessAEC(pElems->rspId, pElems->numElems, pElems->elems);
+}
+
+/*****************************************************************************
+  Description:
+    Initialise the socket module.
+
+  Parameters:
+    devHandle - WINC device handle
+    pInitData - Pointer to initialisation data
+
+  Returns:
+    true or false indicating success or failure
+
+  Remarks:
+
+ *****************************************************************************/
+
+bool WINC_SockInit(WINC_DEVICE_HANDLE devHandle, WINC_SOCKET_INIT_TYPE *pInitData)
+{
+    if (WINC_DEVICE_INVALID_HANDLE == devHandle)
+    {
+        return false;
+    }
+
+    if (NULL != pInitData)
+    {
+        /* Copy the initialisation data if provided. */
+        (void)memcpy(&initData, pInitData, sizeof(WINC_SOCKET_INIT_TYPE));
+
+        /* Initialise the slab allocator. */
+        pGlobalSlabAllocCtx = slabInit(initData.slabSize, initData.numSlabs);
+
+        (void)memset(wincSockets, 0, sizeof(wincSockets));
+        (void)memset(sockInUseMap, 0, sizeof(sockInUseMap));
+        (void)memset(sockSeqNumMap, 0, sizeof(sockSeqNumMap));
+#ifdef WINC_SOCK_CORK_TIMEOUT_ENABLE
+        (void)memset(sockCorkMap, 0, sizeof(sockCorkMap));
+#endif
+        (void)memset(sockIdMap, 0, sizeof(sockIdMap));
+
+        sockListenHead = 0;
+
+#ifdef WINC_SOCK_POLL_SEM_ENABLE
+        WINC_CONF_SEM_CREATE(&pollSemaphore);
+#endif
+
+        /* Register AEC callbacks for sockets and DNS commands. */
+        (void)WINC_DevAECCallbackRegisterMask(devHandle, sockDevProcessAEC, 0, WINC_DEV_AEC_MOD_MASK(WINC_MOD_ID_SOCKET));
+        (void)WINC_DevAECCallbackRegisterMask(devHandle, dnsDevProcessAEC, 0, WINC_DEV_AEC_MOD_MASK(WINC_MOD_ID_DNS));
+    }
+    else
+    {
+        int i;
+
+        /* Re-initialise, close all sockets and free resources. */
+
+        for (i=0; i<WINC_SOCK_NUM_SOCKETS; i++)
+        {
+            if (true == wincSockets[i].inUse)
+            {
+                sockEventCallback(&wincSockets[i], WINC_SOCKET_EVENT_CLOSE, WINC_SOCKET_STATUS_ERROR);
+
+                sockDestroySocket(&wincSockets[i]);
+            }
+        }
+
+        dnsFreeAllRequests();
+    }
+
+    wincDevHandle           = devHandle;
+    pfSocketEventCallback   = NULL;
+    pfPollIdleCallback      = NULL;
+
+    (void)memset(dnsRequests, 0, sizeof(dnsRequests));
+
+    return true;
+}
+
+/*****************************************************************************
+  Description:
+    De-initialise the socket module.
+
+  Parameters:
+    devHandle - WINC device handle
+
+  Returns:
+    true or false indicating success or failure
+
+  Remarks:
+
+ *****************************************************************************/
+
+bool WINC_SockDeinit(WINC_DEVICE_HANDLE devHandle)
+{
+    unsigned int i;
+
+    if (false == WINC_SockInit(devHandle, NULL))
+    {
+        return false;
+    }
+
+    (void)WINC_DevAECCallbackDeregister(wincDevHandle, sockDevProcessAEC);
+    (void)WINC_DevAECCallbackDeregister(wincDevHandle, dnsDevProcessAEC);
+
+    dnsFreeAllRequests();
+
+    if (NULL != pGlobalSlabAllocCtx)
+    {
+        initData.pfMemFree(pGlobalSlabAllocCtx);
+    }
+
+#ifdef WINC_SOCK_POLL_SEM_ENABLE
+    WINC_CONF_SEM_DESTROY(&pollSemaphore);
+#endif
+
+    for (i=0; i<WINC_SOCK_EPOLL_NUM_SETS; i++)
+    {
+        if (true == epollSets[i].inUse)
+        {
+            WINC_CONF_LOCK_DESTROY(&epollSets[i].accessMutex);
+        }
+    }
+
+    (void)memset(epollSets, 0, sizeof(epollSets));
+
+    wincDevHandle = WINC_DEVICE_INVALID_HANDLE;
+
+    return true;
+}
+
+/*****************************************************************************
+  Description:
+    Register a socket event callback and context.
+
+  Parameters:
+    devHandle       - WINC device handle
+    pfSocketEventCB - Callback function pointer
+    context         - Callback function context
+
+  Returns:
+    true or false indicating success or failure.
+
+  Remarks:
+
+ *****************************************************************************/
+
+bool WINC_SockRegisterEventCallback(WINC_DEVICE_HANDLE devHandle, WINC_SOCKET_EVENT_CALLBACK pfSocketEventCB, uintptr_t context)
+{
+    if (WINC_DEVICE_INVALID_HANDLE == devHandle)
+    {
+        return false;
+    }
+
+    pfSocketEventCallback      = pfSocketEventCB;
+    socketEventCallbackContext = context;
+
+    return true;
+}
+
+/*****************************************************************************
+  Description:
+    Register a poll idle callback and context.
+
+  Parameters:
+    devHandle     - WINC device handle
+    pfPollIdleCB  - Callback function pointer
+    context       - Callback function context
+
+  Returns:
+    true or false indicating success or failure.
+
+  Remarks:
+    The callback is called repeatedly by poll() while waiting for sockets
+    to become ready when no semaphore is configured. It receives the
+    remaining timeout in milliseconds, or -1 for an infinite wait, and must
+    run the WINC driver tasks so that socket state can change; it may also
+    sleep until the next interrupt.
+
+ *****************************************************************************/
+
+bool WINC_SockRegisterPollIdleCallback(WINC_DEVICE_HANDLE devHandle, WINC_SOCKET_POLL_IDLE_CALLBACK pfPollIdleCB, uintptr_t context)
+{
+    if (WINC_DEVICE_INVALID_HANDLE == devHandle)
+    {
+        return false;
+    }
+
+    pfPollIdleCallback      = pfPollIdleCB;
+    pollIdleCallbackContext = context;
+
+    return true;
+}
+
+#ifdef WINC_SOCK_CORK_TIMEOUT_ENABLE
+/*****************************************************************************
+  Description:
+    Write stream data held by corked sockets once the cork timeout expires.
+
+  Parameters:
+    None.
+
+  Returns:
+    None.
+
+  Remarks:
+    Only sockets marked in the cork map are examined, a socket is marked
+    again by sockWrite if it continues to hold data.
+
+ *****************************************************************************/
+
+static void sockCorkFlushExpired(void)
+{
+    uint32_t timeNow = WINC_CONF_TIME_MS_GET();
+    int idx;
+
+    idx = sockMapNext(sockCorkMap, 0);
+
+    while (idx >= 0)
+    {
+        WINC_SOCK_CTX *pSockCtx = &wincSockets[idx];
+
+        if ((timeNow - pSockCtx->corkTime) >= WINC_SOCK_CORK_TIMEOUT_MS)
+        {
+            sockCorkMap[(unsigned int)idx / 32U] &= ~((uint32_t)1U << ((unsigned int)idx % 32U));
+
+            if (true == sockLockSocket(pSockCtx))
+            {
+                (void)sockWrite(pSockCtx);
+
+                sockUnlockSocket(pSockCtx);
+            }
+        }
+
+        idx = sockMapNext(sockCorkMap, (unsigned int)idx + 1U);
+    }
+}
+
+#endif
+
+/*****************************************************************************
+  Description:
+    Retry sequence number updates which could not be sent.
+
+  Parameters:
+    None.
+
+  Returns:
+    None.
+
+  Remarks:
+    Only sockets marked in the sequence number map are examined, a socket
+    is marked again by sockSeqNumUpdate if the update still cannot be sent.
+
+ *****************************************************************************/
+
+static void sockSeqNumFlush(void)
+{
+    int idx;
+
+    idx = sockMapNext(sockSeqNumMap, 0);
+
+    while (idx >= 0)
+    {
+        WINC_SOCK_CTX *pSockCtx = &wincSockets[idx];
+
+        if (true == sockLockSocket(pSockCtx))
+        {
+            (void)sockSeqNumUpdate(pSockCtx);
+
+            sockUnlockSocket(pSockCtx);
+        }
+
+        idx = sockMapNext(sockSeqNumMap, (unsigned int)idx + 1U);
+    }
+}
+
+/*****************************************************************************
+  Description:
+    Socket module periodic update.
+
+  Parameters:
+    devHandle - WINC device handle.
+
+  Returns:
+    true or false indicating success or failure.
+
+  Remarks:
+    Called from the driver tasks after the device events have been updated,
+    retries sequence number updates which could not be sent and writes
+    stream data held by corked sockets once WINC_SOCK_CORK_TIMEOUT_MS has
+    elapsed.
+
+ *****************************************************************************/
+
+bool WINC_SockUpdate(WINC_DEVICE_HANDLE devHandle)
+{
+    if (WINC_DEVICE_INVALID_HANDLE == devHandle)
+    {
+        return false;
+    }
+
+    sockSeqNumFlush();
+
+#ifdef WINC_SOCK_CORK_TIMEOUT_ENABLE
+    sockCorkFlushExpired();
+#endif
+
+    return true;
+}
+
+#ifdef WINC_SOCK_SLAB_STATS_ENABLE
+/*****************************************************************************
+  Description:
+    Return a list of slab statistics structures.
+
+  Parameters:
+    pStats   - Pointer to first structure in list.
+    numStats - Length of list.
+
+  Returns:
+    true or false indicating success or failure.
+
+  Remarks:
+
+ *****************************************************************************/
+
+int WINC_SockSlabStatsGet(WINC_SOCK_SLAB_STATS *pStats, int numStats)
+{
+    int i;
+    int numStatsRet;
+
+    if ((NULL == pStats) || (NULL == pGlobalSlabAllocCtx) || (numStats <= 0))
+    {
+        return -1;
+    }
+
+    slabUpdateFragStats(pGlobalSlabAllocCtx);
+
+    memcpy(pStats, &pGlobalSlabAllocCtx->stats, sizeof(WINC_SOCK_SLAB_STATS));
+
+    pStats++;
+    numStats--;
+    numStatsRet = 1;
+
+    for (i=0; (i<WINC_SOCK_NUM_SOCKETS) && (numStats > 0); i++)
+    {
+        if ((NULL != wincSockets[i].pSlabAllocCtx) && (wincSockets[i].pSlabAllocCtx != pGlobalSlabAllocCtx))
+        {
+            slabUpdateFragStats(wincSockets[i].pSlabAllocCtx);
+
+            memcpy(pStats, &wincSockets[i].pSlabAllocCtx->stats, sizeof(WINC_SOCK_SLAB_STATS));
+            pStats++;
+            numStats--;
+            numStatsRet++;
+
+            if (0 == numStats)
+            {
+                break;
+            }
+        }
+    }
+
+    return numStatsRet;
+}
+#endif /* WINC_SOCK_SLAB_STATS_ENABLE */
+
+/******************************************************************************
+
+    Berkeley Style Socket Interface
+
+ ******************************************************************************/
+#ifndef WINC_CONF_USE_EXT_SOCK_HDRS
+const struct in6_addr               in6addr_any = IN6ADDR_ANY_INIT;
+const struct in6_addr               in6addr_loopback = IN6ADDR_LOOPBACK_INIT;
+#endif
+
+#define bswap_16(x) int_bswap_16(x)
+#define bswap_32(x) int_bswap_32(x)
+#define bswap_64(x) int_bswap_64(x)
+
+/*****************************************************************************
+  Description:
+    Byte swap 16-bit value
+
+  Parameters:
+    __x - Value to be byte swapped
+
+  Returns:
+    Swapped value
+
+  Remarks:
+
+ *****************************************************************************/
+
+static __inline uint16_t int_bswap_16(uint16_t x)
+{
+    return (x<<8) | (x>>8);
+}
+
+/*****************************************************************************
+  Description:
+    Byte swap 32-bit value
+
+  Parameters:
+    __x - Value to be byte swapped
+
+  Returns:
+    Swapped value
+
+  Remarks:
+
+ *****************************************************************************/
+
+static __inline uint32_t int_bswap_32(uint32_t x)
+{
+    return (x>>24) | ((x>>8)&0xff00U) | ((x<<8)&0xff0000U) | (x<<24);
+}
+
+/*****************************************************************************
+  Description:
+    Byte swap 64-bit value
+
+  Parameters:
+    __x - Value to be byte swapped
+
+  Returns:
+    Swapped value
+
+  Remarks:
+
+ *****************************************************************************/
+
+static __inline uint64_t int_bswap_64(uint64_t x)
+{
+    return (int_bswap_32((uint32_t)x)+(0ULL<<32)) | (int_bswap_32((uint32_t)(x>>32)));
+}
+
+/*****************************************************************************
+  Description:
+    Convert hex character into integer.
+
+  Parameters:
+    c - Character to be converted
+
+  Returns:
+    Integer value of character or -1 for error
+
+  Remarks:
+
+ *****************************************************************************/
+
+static int hexval(unsigned char c)
+{
+    if (c < STR_LIT_U('0'))
+    {
+        return -1;
+    }
+
+    if (c <= STR_LIT_U('9'))
+    {
+        return (c - STR_LIT_U('0'));
+    }
+
+    c |= 32U;
+
+    if ((c < STR_LIT_U('a')) || (c > STR_LIT_U('f')))
+    {
+        return -1;
+    }
+
+    return (c - STR_LIT_U('a') + 10U);
+}
+
+/*****************************************************************************
+  Description:
+    Size of sockaddr structure depending on IP version.
 
-        case WINC_AEC_ID_SOCKTLS:
-        {
-            if (1U != numElems)
-            {
-                break;
-            }
+  Parameters:
+    addr - Pointer to sockaddr structure to size.
 
-            if (NULL != pSockCtx)
-            {
-                pSockCtx->connected  = true;
-                pSockCtx->tlsPending = false;
+  Returns:
+    Size of structure or 0 for error.
 
-                sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_CONNECT, WINC_SOCKET_STATUS_OK);
-                sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_TLS_CONNECT, WINC_SOCKET_STATUS_OK);
-            }
-            break;
-        }
+  Remarks:
 
-        case WINC_AEC_ID_SOCKERR:
-        {
-            if (2U != numElems)
-            {
-                break;
-            }
+ *****************************************************************************/
 
-            if (NULL != pSockCtx)
-            {
-                pSockCtx->events |= POLLERR;
-                sockEventCallback(pSockCtx, WINC_SOCKET_EVENT_ERROR, WINC_SOCKET_STATUS_ERROR);
-            }
-            break;
-        }
+static size_t sizeof_sockaddr(const struct sockaddr *addr)
+{
+    if (NULL == addr)
+    {
+        return 0;
+    }
 
-        default:
-        {
-            /* Do nothing. */
-            break;
-        }
+    if (AF_INET == addr->sa_family)
+    {
+        return sizeof(struct sockaddr_in);
+    }
+    else if (AF_INET6 == addr->sa_family)
+    {
+        return sizeof(struct sockaddr_in6);
+    }
+    else
+    {
+        /* Do nothing. */
     }
+
+    return 0;
 }
 
-//*******************************************************************************
-/*
+/*****************************************************************************
   Description:
-    Processes AECs for DNS.
+    Convert IPv4 and IPv6 addresses from binary to text form.
 
   Parameters:
-    aecId    - AEC ID.
-    numElems - Number of elements.
-    pElems   - Pointer to elements.
+    af - Address family, either AF_INET or AF_INET6.
+    a0 - Pointer to IP address in network byte order.
+    s  - Pointer to string buffer to output to.
+    l  - Size of buffer supplied.
 
   Returns:
-    None.
+    Pointer to converted string within supplied buffer or 0 for error (errno set).
 
   Remarks:
-    None.
+    errno:
+        EAFNOSUPPORT
+            af was not a valid address family.
+        ENOSPC
+            The converted address string would exceed the size given by size.
 
-*/
+ *****************************************************************************/
 
-static void dnsProcessAEC
-(
-    uint16_t aecId,
-    int numElems,
-    const WINC_DEV_PARAM_ELEM *const pElems
-)
+const char *WINC_SOCK_NS(inet_ntop)(int af, const void *a0, char *s, socklen_t l)
 {
-    if (NULL == pElems)
-    {
-        return;
-    }
+    const unsigned char *a = a0;
 
-    switch (aecId)
+    switch ((unsigned)af)
     {
-        case WINC_AEC_ID_DNSRESOLV:
+        case AF_INET:
         {
-            int recordType;
-
-            if ((3U != numElems) || (NULL == pCurrentDnsRequest))
+            if (snprintf(s, l, "%d.%d.%d.%d", a[0], a[1], a[2], a[3]) < (int)l)
             {
-                break;
+                return s;
             }
 
-            if (NULL == initData.pfMemAlloc)
-            {
-                break;
-            }
+            errno = ENOSPC;
+            break;
+        }
 
-            /* Read the record type from the AEC. */
-            (void)WINC_CmdReadParamElem(&pElems[0], WINC_TYPE_INTEGER, &recordType, sizeof(recordType));
+        case AF_INET6:
+        {
+            int i, j, max, best;
+            char buf[100];
 
-            WINC_TRACE_PRINT("DNS '%.*s':%d\n", pCurrentDnsRequest->hostNameLen, pElems[1].pData, pCurrentDnsRequest->hostNameLen);
+            static uint8_t transPrefix[12] = {0,0,0,0,0,0,0,0,0,0,0xffU,0xffU};
 
-            /* Verify the response matches the request. */
-            if ((pElems[1].length == pCurrentDnsRequest->hostNameLen) && (0 == memcmp(pElems[1].pData, pCurrentDnsRequest->hostName, pCurrentDnsRequest->hostNameLen)))
+            if (0 != memcmp(a, transPrefix, 12))
             {
-                struct addrinfo **pRes;
-
-                /* Load the current requests result pointer. */
-                pRes = &pCurrentDnsRequest->pRes;
+                (void)snprintf(buf, sizeof buf, "%x:%x:%x:%x:%x:%x:%x:%x",
+                               (256U*a[0])+a[1],(256U*a[2])+a[3],
+                               (256U*a[4])+a[5],(256U*a[6])+a[7],
+                               (256U*a[8])+a[9],(256U*a[10])+a[11],
+                               (256U*a[12])+a[13],(256U*a[14])+a[15]);
+            }
+            else
+            {
+                (void)snprintf(buf, sizeof buf, "%x:%x:%x:%x:%x:%x:%d.%d.%d.%d",
+                               (256U*a[0])+a[1],(256U*a[2])+a[3],
+                               (256U*a[4])+a[5],(256U*a[6])+a[7],
+                               (256U*a[8])+a[9],(256U*a[10])+a[11],
+                               a[12],a[13],a[14],a[15]);
+            }
 
-                /* Iterate to the end of the list. */
-                while (NULL != *pRes)
+            /* Replace longest /(^0|:)[:0]{2,}/ with "::" */
+            best = 0;
+            max  = 2;
+            for (i=0; '\0' != buf[i]; i++)
+            {
+                if ((0 != i) && (buf[i] != ':'))
                 {
-                    pRes = &(*pRes)->ai_next;
+                    continue;
                 }
 
-                /* Allocate space for the new results. */
-                *pRes = initData.pfMemAlloc(sizeof(struct addrinfo) + sizeof(struct sockaddr));
+                j = (int)strspn(buf+i, ":0");
 
-                if (NULL != *pRes)
+                if (j>max)
                 {
-                    /* Copy the response into the results structure. */
-                    (void)memset(*pRes, 0, sizeof(struct addrinfo) + sizeof(struct sockaddr));
-
-                    (*pRes)->ai_addr = (struct sockaddr*)&(*pRes)[1];
-                    (*pRes)->ai_next = NULL;
-
-                    if (WINC_TYPE_IPV4ADDR == pElems[2].type)
-                    {
-                        /* Read an IPv4 address. */
-                        (*pRes)->ai_family  = (int)AF_INET;
-                        (*pRes)->ai_addrlen = sizeof(struct sockaddr_in);
-
-                        ((struct sockaddr_in*)(*pRes)->ai_addr)->sin_family = AF_INET;
-                        (void)WINC_CmdReadParamElem(&pElems[2], WINC_TYPE_IPV4ADDR, &((struct sockaddr_in*)(*pRes)->ai_addr)->sin_addr, sizeof(struct in_addr));
-                    }
-                    else if (WINC_TYPE_IPV6ADDR == pElems[2].type)
-                    {
-                        /* Read an IPv6 address. */
-                        (*pRes)->ai_family  = (int)AF_INET6;
-                        (*pRes)->ai_addrlen = sizeof(struct sockaddr_in6);
-
-                        ((struct sockaddr_in6*)(*pRes)->ai_addr)->sin6_family = AF_INET6;
-                        (void)WINC_CmdReadParamElem(&pElems[2], WINC_TYPE_IPV6ADDR, &((struct sockaddr_in6*)(*pRes)->ai_addr)->sin6_addr, sizeof(struct in6_addr));
-                    }
-                    else
-                    {
-                        WINC_ERROR_PRINT("error: unknown address type (%d)\n", pElems[2].type);
-                    }
+                    best = i;
+                    max  = j;
                 }
-
-                pCurrentDnsRequest->reqStatus = WINC_STATUS_OK;
             }
 
-            break;
-        }
-
-        case WINC_AEC_ID_DNSERR:
-        {
-            if ((3U != numElems) || (NULL == pCurrentDnsRequest))
+            if (max > 3)
             {
-                break;
+                buf[best]   = ':';
+                buf[best+1] = ':';
+                (void)memmove(buf+best+2, buf+best+max, (i-best-max+1));
             }
 
-            /* Verify the response matches the request. */
-            if ((pElems[2].length == pCurrentDnsRequest->hostNameLen) && (0 == memcmp(pElems[2].pData, pCurrentDnsRequest->hostName, pCurrentDnsRequest->hostNameLen)))
+            if (strlen(buf) < l)
             {
-                /* Read the status from the AEC. */
-                (void)WINC_CmdReadParamElem(&pElems[0], WINC_TYPE_STATUS, &pCurrentDnsRequest->reqStatus, sizeof(pCurrentDnsRequest->reqStatus));
+                (void)strcpy(s, buf);
+                return s;
             }
 
+            errno = ENOSPC;
             break;
         }
 
         default:
         {
-            /* Do nothing. */
+            errno = EAFNOSUPPORT;
             break;
         }
     }
-}
-
-/*****************************************************************************
-  Description:
-    Socket command response callback.
-
-  Parameters:
-    context      - Context provided to WINC_CmdReqInit for callback
-    devHandle    - WINC device handle
-    cmdReqHandle - Command request handle
-    event        - Event being raised
-    eventArg     - Optional argument for event
-
-  Returns:
-    None.
-
-  Remarks:
-
- *****************************************************************************/
-
-static void sockCmdRspCallbackHandlerSeqUpdate(uintptr_t context, WINC_DEVICE_HANDLE devHandle, WINC_CMD_REQ_HANDLE cmdReqHandle, WINC_DEV_CMDREQ_EVENT_TYPE event, uintptr_t eventArg)
-{
-    /* context provided was the socket address. */
-    WINC_SOCK_CTX *pSockCtx = (WINC_SOCK_CTX*)context;
-
-    WINC_TRACE_PRINT("SOCK CmdRspCBSeqUp %08x Event (Sock %08x) %d\n", cmdReqHandle, context, event);
-
-    /* Command request is complete, no further need for it. */
-    if (WINC_DEV_CMDREQ_EVENT_STATUS_COMPLETE == event)
-    {
-        slabFree(pGlobalSlabAllocCtx, (WINC_COMMAND_REQUEST*)cmdReqHandle);
-    }
-
-    /* Only take further action if socket is not actually in use. */
-    if ((NULL == pSockCtx) || (false == pSockCtx->inUse))
-    {
-        return;
-    }
-
-    if (false == sockLockSocket(pSockCtx))
-    {
-        return;
-    }
-
-    if (WINC_DEV_CMDREQ_EVENT_TX_COMPLETE == event)
-    {
-        pSockCtx->seqNumUpdateSent = false;
-    }
 
-    sockUnlockSocket(pSockCtx);
+    return NULL;
 }
 
 /*****************************************************************************
   Description:
-    Socket command response callback.
+    Convert IPv4 and IPv6 addresses from text to binary form.
 
   Parameters:
-    context      - Context provided to WINC_CmdReqInit for callback
-    devHandle    - WINC device handle
-    cmdReqHandle - Command request handle
-    event        - Event being raised
-    eventArg     - Optional argument for event
+    af - Address family, either AF_INET or AF_INET6.
+    s  - Pointer to input IP address string.
+    a0 - Pointer to output binary form IP address.
 
   Returns:
-    None.
+    -1 - Error, errno is set.
+    0  - No valid IP address string found.
+    1  - Success.
 
   Remarks:
+    errno:
+        EAFNOSUPPORT
+            af was not a valid address family.
 
  *****************************************************************************/
 
-static void sockCmdRspCallbackHandler(uintptr_t context, WINC_DEVICE_HANDLE devHandle, WINC_CMD_REQ_HANDLE cmdReqHandle, WINC_DEV_CMDREQ_EVENT_TYPE event, uintptr_t eventArg)
+int WINC_SOCK_NS(inet_pton)(int af, const char *s, void *a0)
 {
-    /* context provided was the socket address. */
-    WINC_SOCK_CTX *pSockCtx = (WINC_SOCK_CTX*)context;
-
-    WINC_TRACE_PRINT("SOCK CmdRspCB %08x Event (Sock %08x) %d\n", cmdReqHandle, context, event);
+    uint16_t ip[8];
+    unsigned char *a = a0;
+    int i, j, v, brk = -1, need_v4 = 0;
 
-    /* Command request is complete, no further need for it. */
-    if (WINC_DEV_CMDREQ_EVENT_STATUS_COMPLETE == event)
+    if (AF_INET == (unsigned)af)
     {
-        slabFree(pGlobalSlabAllocCtx, (WINC_COMMAND_REQUEST*)cmdReqHandle);
-    }
+        for (i=0; i<4; i++)
+        {
+            v = 0;
+            for (j=0; (j<3) && (0 != isdigit((int)s[j])); j++)
+            {
+                v = (10*v) + (s[j] - (char)'0');
+            }
 
-    /* Only take further action if socket is not actually in use. */
-    if ((NULL == pSockCtx) || (false == pSockCtx->inUse))
+            if ((0 == j) || ((j > 1) && ('0' == s[0])) || (v > 255))
+            {
+                return 0;
+            }
+
+            a[i] = (unsigned char)v;
+
+            if (('\0' == s[j]) && (3 == i))
+            {
+                return 1;
+            }
+
+            if ('.' != s[j])
+            {
+                return 0;
+            }
+
+            s = &s[j+1];
+        }
+
+        return 0;
+    }
+    else if (AF_INET6 != (unsigned)af)
     {
-        return;
+        errno = EAFNOSUPPORT;
+        return -1;
     }
-
-    if (false == sockLockSocket(pSockCtx))
+    else
     {
-        return;
     }
 
-    switch (event)
+    if (':' == s[0])
     {
-        case WINC_DEV_CMDREQ_EVENT_TX_COMPLETE:
+        if (':' != s[1])
         {
-            /* Command request transmission complete to WINC device. */
-            break;
+            return 0;
         }
 
-        case WINC_DEV_CMDREQ_EVENT_CMD_STATUS:
+        s++;
+    }
+
+    for (i=0; ; i++)
+    {
+        if ((':' == s[0]) && (brk < 0))
         {
-            /* Status response received for command. */
+            brk = i;
+            ip[(unsigned)i & 7U] = 0;
 
-            WINC_DEV_EVENT_STATUS_ARGS *pStatusInfo = (WINC_DEV_EVENT_STATUS_ARGS*)eventArg;
+            if ('\0' == *++s)
+            {
+                break;
+            }
 
-            if (NULL != pStatusInfo)
+            if (7 == i)
             {
-                sockProcessStatus(pSockCtx, pStatusInfo->rspCmdId, cmdReqHandle, &pStatusInfo->srcCmd, pStatusInfo->status);
+                return 0;
             }
 
-            break;
+            continue;
         }
 
-        case WINC_DEV_CMDREQ_EVENT_RSP_RECEIVED:
+        v = 0;
+        for (j=0; (j < 4) && ((hexval((unsigned)s[j])) >= 0); j++)
         {
-            const WINC_DEV_EVENT_RSP_ELEMS *const pRspElems = (const WINC_DEV_EVENT_RSP_ELEMS *const)eventArg;
+            v = (16*v) + hexval((unsigned)s[j]);
+        }
 
-            if (NULL != pRspElems)
-            {
-                sockProcessCmdRsp(pSockCtx, pRspElems->rspId, cmdReqHandle, &pRspElems->srcCmd, pRspElems->numElems, pRspElems->elems);
-            }
-            break;
+        if (0 == j)
+        {
+            return 0;
         }
 
-        default:
+        ip[(unsigned)i & 7U] = (uint16_t)v;
+
+        if (('\0' == s[j]) && ((brk >= 0) || (7 == i)))
         {
-            WINC_TRACE_PRINT("Sock CmdRspCB %08x event %d not handled\r\n", cmdReqHandle, event);
             break;
         }
-    }
-
-    if (true == pSockCtx->inUse)
-    {
-        sockUnlockSocket(pSockCtx);
-    }
-}
 
-/*****************************************************************************
-  Description:
-    Process socket AEC messages.
+        if (7 == i)
+        {
+            return 0;
+        }
 
-  Parameters:
-    context   - Context provided to WINC_DevAECCallbackRegister for callback
-    devHandle - WINC device handle
-    pElems    - Pointer to AEC elements
+        if (':' != s[j])
+        {
+            if (('.' != s[j]) || ((i < 6) && (brk < 0)))
+            {
+                return 0;
+            }
 
-  Returns:
-    None.
+            need_v4 = 1;
 
-  Remarks:
+            i++;
+            ip[(unsigned)i & 7U] = 0;
 
- *****************************************************************************/
+            break;
+        }
 
-static void sockDevProcessAEC(uintptr_t context, WINC_DEVICE_HANDLE devHandle, const WINC_DEV_EVENT_RSP_ELEMS *const pElems)
-{
-    WINC_SOCK_CTX *pSockCtx;
-    uint16_t sockId;
+        s = &s[j+1];
+    }
 
-    if (NULL == pElems)
+    if (brk >= 0)
     {
-        return;
+        (void)memmove(ip+brk+7-i, ip+brk, (2*(i+1-brk)));
+
+        for (j=0; j<(7-i); j++)
+        {
+            ip[brk + j] = 0;
+        }
     }
 
-    if (pElems->numElems < 1U)
+    for (j=0; j<8; j++)
     {
-        return;
+        *a++ = (unsigned char)(ip[j] >> 8);
+        *a++ = (unsigned char)(ip[j]);
     }
 
-    /* Read the socket ID from the AEC. */
-    (void)WINC_CmdReadParamElem(&pElems->elems[0], WINC_TYPE_INTEGER, &sockId, sizeof(sockId));
-
-    /* Find relevant socket. */
-    pSockCtx = sockFindByID(sockId);
-
-    if ((NULL != pSockCtx) && (false == sockLockSocket(pSockCtx)))
+    if ((0 != need_v4) && (inet_pton((int)AF_INET, s, a-4) <= 0))
     {
-        return;
+        return 0;
     }
 
-    sockProcessAEC(sockId, pSockCtx, pElems->rspId, pElems->numElems, pElems->elems);
-
-    sockUnlockSocket(pSockCtx);
+    return 1;
 }
 
 /*****************************************************************************
   Description:
-    DNS command response callback.
+    Create an endpoint for communication.
 
   Parameters:
-    context      - Context provided to WINC_CmdReqInit for callback
-    devHandle    - WINC device handle
-    cmdReqHandle - Command request handle
-    event        - Event being raised
-    eventArg     - Optional argument for event
+    domain   - Communication domain, must be AF_INET or AF_INET6.
+    type     - Socket type, must be SOCK_STREAM or SOCK_DGRAM.
+    protocol - Specific socket protocol, should be zero or IPPROTO_TLS.
 
   Returns:
-    None.
+    Socket file descriptor or -1 for error (errno set).
 
   Remarks:
+    errno:
+        EAFNOSUPPORT
+            The implementation does not support the specified address
+            family.
+        EINVAL
+            Unknown protocol, or protocol family not available.
+        EPROTONOSUPPORT
+            The protocol type or the specified protocol is not
+            supported within this domain.
+        EFAULT
+            System fault
+        ENFILE The system-wide limit on the total number of open files
+            has been reached.
+        ENOMEM
+            Insufficient memory is available.  The socket cannot be
+            created until sufficient resources are freed.
+        EBADMSG
+            Bad message.
 
  *****************************************************************************/
 
-static void dnsCmdRspCallbackHandler(uintptr_t context, WINC_DEVICE_HANDLE devHandle, WINC_CMD_REQ_HANDLE cmdReqHandle, WINC_DEV_CMDREQ_EVENT_TYPE event, uintptr_t eventArg)
+int WINC_SOCK_NS(socket)(int domain, int type, int protocol)
 {
-    /* context provided was the DNS request address. */
-    WINC_DNS_REQ *pDnsRequest = (WINC_DNS_REQ*)context;
+    WINC_CMD_REQ_HANDLE cmdReqHandle;
+    void *pCmdReqBuffer;
+    WINC_SOCK_CTX *pSockCtx = NULL;
+    uint8_t cmdProtocol;
+    uint8_t cmdProtocolVersion;
 
-    switch (event)
+    if (AF_INET == (unsigned)domain)
     {
-        case WINC_DEV_CMDREQ_EVENT_TX_COMPLETE:
-        {
-            break;
-        }
-
-        case WINC_DEV_CMDREQ_EVENT_STATUS_COMPLETE:
-        {
-            break;
-        }
-
-        case WINC_DEV_CMDREQ_EVENT_CMD_STATUS:
-        {
-            const WINC_DEV_EVENT_STATUS_ARGS *pStatusInfo = (const WINC_DEV_EVENT_STATUS_ARGS*)eventArg;
-
-            if (WINC_STATUS_OK != pStatusInfo->status)
-            {
-                /* DNS request failed, remove the allocate request. */
-                dnsFreeRequest(pDnsRequest);
-            }
-            break;
-        }
+        cmdProtocolVersion = WINC_CONST_NETIF_PROTOCOL_VERSION_IPV4;
+    }
+    else if (AF_INET6 == (unsigned)domain)
+    {
+        cmdProtocolVersion = WINC_CONST_NETIF_PROTOCOL_VERSION_IPV6;
+    }
+    else
+    {
+        errno = EAFNOSUPPORT;
+        return -1;
+    }
 
-        case WINC_DEV_CMDREQ_EVENT_RSP_RECEIVED:
+    if (SOCK_STREAM == (unsigned)type)
+    {
+        if (0 == protocol)
         {
-            const WINC_DEV_EVENT_RSP_ELEMS *pRspElems = (const WINC_DEV_EVENT_RSP_ELEMS*)eventArg;
-
-            if (NULL != pRspElems)
-            {
-            }
-            break;
+            protocol = (int)IPPROTO_TCP;
         }
 
-        default:
+        if ((IPPROTO_TCP != (unsigned)protocol) && (IPPROTO_TLS != (unsigned)protocol))
         {
-            WINC_TRACE_PRINT("DNS CmdRspCB %08x event %d not handled\r\n", cmdReqHandle, event);
-            break;
+            errno = EPROTONOSUPPORT;
+            return -1;
         }
-    }
-}
-
-/*****************************************************************************
-  Description:
-    Process DNS AEC messages.
-
-  Parameters:
-    context   - Context provided to WINC_DevAECCallbackRegister for callback
-    devHandle - WINC device handle
-    pElems    - Pointer to AEC elements
-
-  Returns:
-    None.
 
-  Remarks:
+        cmdProtocol = WINC_CONST_SOCKET_PROTOCOL_TCP;
+    }
+    else if (SOCK_DGRAM == (unsigned)type)
+    {
+        if (0 == protocol)
+        {
+            protocol = (int)IPPROTO_UDP;
+        }
 
- *****************************************************************************/
+        if ((IPPROTO_UDP != (unsigned)protocol) && (IPPROTO_TLS != (unsigned)protocol))
+        {
+            errno = EPROTONOSUPPORT;
+            return -1;
+        }
 
-static void dnsDevProcessAEC(uintptr_t context, WINC_DEVICE_HANDLE devHandle, const WINC_DEV_EVENT_RSP_ELEMS *const pElems)
-{
-    if (NULL == pElems)
+        cmdProtocol = WINC_CONST_SOCKET_PROTOCOL_UDP;
+    }
+    else
     {
-        return;
+        errno = EINVAL;
+        return -1;
     }
 
-    dnsProcessAEC(pElems->rspId, pElems->numElems, pElems->elems);
-}
-
-/*****************************************************************************
-  Description:
-    Initialise the socket module.
-
-  Parameters:
-    devHandle - WINC device handle
-    pInitData - Pointer to initialisation data
-
-  Returns:
-    true or false indicating success or failure
-
-  Remarks:
+    if (WINC_DEVICE_INVALID_HANDLE == wincDevHandle)
+    {
+        errno = EFAULT;
+        return -1;
+    }
 
- *****************************************************************************/
+    pSockCtx = sockFindFreeSocket();
 
-bool WINC_SockInit(WINC_DEVICE_HANDLE devHandle, WINC_SOCKET_INIT_TYPE *pInitData)
-{
-    if (WINC_DEVICE_INVALID_HANDLE == devHandle)
+    if (NULL == pSockCtx)
     {
-        return false;
+        errno = ENFILE;
+        return -1;
     }
 
-    if (NULL != pInitData)
+    if (false == sockCreateSocket(pSockCtx, (uint8_t)type, 0))
     {
-        /* Copy the initialisation data if provided. */
-        (void)memcpy(&initData, pInitData, sizeof(WINC_SOCKET_INIT_TYPE));
+        errno = ENFILE;
+        return -1;
+    }
 
-        /* Initialise the slab allocator. */
-        pGlobalSlabAllocCtx = slabInit(initData.slabSize, initData.numSlabs);
+    if (false == sockLockSocket(pSockCtx))
+    {
+        errno = EFAULT;
+        return -1;
+    }
 
-        (void)memset(wincSockets, 0, sizeof(wincSockets));
+    pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, WINC_SOCK_CMD_REQ_SZ(128, 1));
 
-        /* Register AEC callbacks for sockets and DNS commands. */
-        (void)WINC_DevAECCallbackRegister(devHandle, sockDevProcessAEC, 0);
-        (void)WINC_DevAECCallbackRegister(devHandle, dnsDevProcessAEC, 0);
-    }
-    else
+    if (NULL == pCmdReqBuffer)
     {
-        int i;
+        sockUnlockSocket(pSockCtx);
+        sockDestroySocket(pSockCtx);
+        errno = ENOMEM;
+        return -1;
+    }
 
-        /* Re-initialise, close all sockets and free resources. */
+    cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, WINC_SOCK_CMD_REQ_SZ(128, 1), 1, sockCmdRspCallbackHandler, (uintptr_t)pSockCtx);
 
-        for (i=0; i<WINC_SOCK_NUM_SOCKETS; i++)
-        {
-            if (true == wincSockets[i].inUse)
-            {
-                sockEventCallback(&wincSockets[i], WINC_SOCKET_EVENT_CLOSE, WINC_SOCKET_STATUS_ERROR);
+    if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
+    {
+        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+        sockUnlockSocket(pSockCtx);
+        sockDestroySocket(pSockCtx);
+        errno = EBADMSG;
+        return -1;
+    }
 
-                sockDestroySocket(&wincSockets[i]);
-            }
-        }
+    (void)WINC_CmdSOCKO(cmdReqHandle, cmdProtocol, cmdProtocolVersion);
 
-        dnsFreeRequest(pCurrentDnsRequest);
+    if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
+    {
+        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+        sockUnlockSocket(pSockCtx);
+        sockDestroySocket(pSockCtx);
+        errno = EBADMSG;
+        return -1;
     }
 
-    wincDevHandle           = devHandle;
-    pfSocketEventCallback   = NULL;
-    pCurrentDnsRequest      = NULL;
+    pSockCtx->protocol = (uint16_t)protocol;
+    pSockCtx->domain   = (uint8_t)domain;
+    pSockCtx->readMode = (uint8_t)WINC_SOCKET_ASYNC_MODE_ACKED;
 
-    return true;
+    WINC_TRACE_PRINT("Socket %08x -> %d\n", pSockCtx, WINC_SOCK_PTR_TO_HANDLE(pSockCtx));
+
+    sockUnlockSocket(pSockCtx);
+    return WINC_SOCK_PTR_TO_HANDLE(pSockCtx);
 }
 
 /*****************************************************************************
   Description:
-    De-initialise the socket module.
+    Shut down part of a full-duplex connection.
 
   Parameters:
-    devHandle - WINC device handle
+    fd  - Socket file descriptor.
+    how - Shutdown flags, must be SHUT_RDWR.
 
   Returns:
-    true or false indicating success or failure
+    0  - Success.
+    -1 - Error, errno set.
 
   Remarks:
+    errno:
+        EBADF
+            fd is not a valid file descriptor.
+        ENOTSOCK
+            The file descriptor fd does not refer to a socket.
+        ENOMEM
+            Insufficient memory is available.  The socket cannot be
+            created until sufficient resources are freed.
+        EBADMSG
+            Bad message.
 
  *****************************************************************************/
 
-bool WINC_SockDeinit(WINC_DEVICE_HANDLE devHandle)
+int WINC_SOCK_NS(shutdown)(int fd, int how)
 {
-    if (false == WINC_SockInit(devHandle, NULL))
+    WINC_CMD_REQ_HANDLE cmdReqHandle;
+    void *pCmdReqBuffer;
+    WINC_SOCK_CTX *pSockCtx = WINC_SOCK_HANDLE_TO_PTR(fd);
+
+    if (NULL == pSockCtx)
     {
-        return false;
+        errno = EBADF;
+        return -1;
     }
 
-    (void)WINC_DevAECCallbackDeregister(wincDevHandle, sockDevProcessAEC);
-    (void)WINC_DevAECCallbackDeregister(wincDevHandle, dnsDevProcessAEC);
-
-    dnsFreeRequest(pCurrentDnsRequest);
-
-    if (NULL != pGlobalSlabAllocCtx)
+    if (false == sockLockSocket(pSockCtx))
     {
-        initData.pfMemFree(pGlobalSlabAllocCtx);
+        errno = EFAULT;
+        return -1;
     }
 
-    wincDevHandle = WINC_DEVICE_INVALID_HANDLE;
+    if (0U == pSockCtx->sockId)
+    {
+        sockUnlockSocket(pSockCtx);
+        errno = ENOTSOCK;
+        return -1;
+    }
 
-    return true;
-}
+    pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, WINC_SOCK_CMD_REQ_SZ(128, 1));
 
-/*****************************************************************************
-  Description:
-    Register a socket event callback and context.
+    if (NULL == pCmdReqBuffer)
+    {
+        sockUnlockSocket(pSockCtx);
+        errno = ENOMEM;
+        return -1;
+    }
 
-  Parameters:
-    devHandle       - WINC device handle
-    pfSocketEventCB - Callback function pointer
-    context         - Callback function context
+    cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, WINC_SOCK_CMD_REQ_SZ(128, 1), 1, sockCmdRspCallbackHandler, (uintptr_t)pSockCtx);
 
-  Returns:
-    true or false indicating success or failure.
+    if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
+    {
+        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+        sockUnlockSocket(pSockCtx);
+        errno = EBADMSG;
+        return -1;
+    }
 
-  Remarks:
+    /* Write any data held by cork ahead of the close. */
+    if ((true == pSockCtx->corked) || (true == pSockCtx->sendMore))
+    {
+        pSockCtx->corked   = false;
+        pSockCtx->sendMore = false;
+        (void)sockWrite(pSockCtx);
+    }
 
- *****************************************************************************/
+    (void)WINC_CmdSOCKCL(cmdReqHandle, pSockCtx->sockId);
 
-bool WINC_SockRegisterEventCallback(WINC_DEVICE_HANDLE devHandle, WINC_SOCKET_EVENT_CALLBACK pfSocketEventCB, uintptr_t context)
-{
-    if (WINC_DEVICE_INVALID_HANDLE == devHandle)
+    if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
     {
-        return false;
+        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+        sockUnlockSocket(pSockCtx);
+        errno = EBADMSG;
+        return -1;
     }
 
-    pfSocketEventCallback      = pfSocketEventCB;
-    socketEventCallbackContext = context;
-
-    return true;
+    sockUnlockSocket(pSockCtx);
+    return 0;
 }
 
-#ifdef WINC_SOCK_SLAB_STATS_ENABLE
 /*****************************************************************************
   Description:
-    Return a list of slab statistics structures.
+    Bind a name to a socket.
 
   Parameters:
-    pStats   - Pointer to first structure in list.
-    numStats - Length of list.
+    fd   - Socket file descriptor.
+    addr - Pointer to socket address.
+    len  - Length of socket address.
 
   Returns:
-    true or false indicating success or failure.
+    0  - Success.
+    -1 - Error, errno set.
 
   Remarks:
+    errno:
+        EFAULT
+            System fault.
+        EAFNOSUPPORT
+            The implementation does not support the specified address
+            family.
+        ENOMEM
+            Insufficient memory is available.
+        EBADMSG
+            Bad message.
+        EAGAIN
+            The socket is nonblocking, and the binding cannot be
+            completed immediately.
 
  *****************************************************************************/
 
-int WINC_SockSlabStatsGet(WINC_SOCK_SLAB_STATS *pStats, int numStats)
-{
-    int i;
-    int numStatsRet;
+int WINC_SOCK_NS(bind)(int fd, const struct sockaddr *addr, socklen_t len)
+{
+    WINC_SOCK_CTX *pSockCtx = WINC_SOCK_HANDLE_TO_PTR(fd);
+    const struct sockaddr_in *pSockBindAddr = (const struct sockaddr_in*)addr;
+
+    if ((NULL == pSockCtx) || (NULL == addr) || (len < sizeof(struct sockaddr_in)))
+    {
+        errno = EFAULT;
+        return -1;
+    }
+
+    if (false == sockLockSocket(pSockCtx))
+    {
+        errno = EFAULT;
+        return -1;
+    }
 
-    if ((NULL == pStats) || (NULL == pGlobalSlabAllocCtx) || (0 == numStats))
+    /* None TCP/TLS sockets must have an ID to proceed. */
+    if ((0U == pSockCtx->sockId) && (SOCK_DGRAM == pSockCtx->type) && (IPPROTO_TLS != pSockCtx->protocol))
     {
+        sockUnlockSocket(pSockCtx);
+        errno = EAGAIN;
         return -1;
     }
 
-    memcpy(pStats, &pGlobalSlabAllocCtx->stats, sizeof(WINC_SOCK_SLAB_STATS));
+    if ((AF_INET != pSockBindAddr->sin_family) && (AF_INET6 != pSockBindAddr->sin_family))
+    {
+        sockUnlockSocket(pSockCtx);
+        errno = EAFNOSUPPORT;
+        return -1;
+    }
 
-    pStats++;
-    numStats--;
-    numStatsRet = 1;
+    (void)memset(&pSockCtx->localEndPt, 0, sizeof(SOCKADDR_UNION));
+    (void)memcpy(&pSockCtx->localEndPt, pSockBindAddr, len);
 
-    for (i=0; i<WINC_SOCK_NUM_SOCKETS; i++)
+    /* Perform bind here for none TCP/TLS sockets. */
+    if ((SOCK_DGRAM == pSockCtx->type) && (IPPROTO_TLS != pSockCtx->protocol))
     {
-        if ((NULL != wincSockets[i].pSlabAllocCtx) && (wincSockets[i].pSlabAllocCtx != pGlobalSlabAllocCtx))
-        {
-            memcpy(pStats, &wincSockets[i].pSlabAllocCtx->stats, sizeof(WINC_SOCK_SLAB_STATS));
-            pStats++;
-            numStats--;
-            numStatsRet++;
+        WINC_CMD_REQ_HANDLE cmdReqHandle;
+        void *pCmdReqBuffer;
 
-            if (0 == numStats)
-            {
-                break;
-            }
+        pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, WINC_SOCK_CMD_REQ_SZ(128, 1));
+
+        if (NULL == pCmdReqBuffer)
+        {
+            sockUnlockSocket(pSockCtx);
+            errno = ENOMEM;
+            return -1;
         }
-    }
 
-    return numStatsRet;
-}
-#endif /* WINC_SOCK_SLAB_STATS_ENABLE */
+        cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, WINC_SOCK_CMD_REQ_SZ(128, 1), 1, sockCmdRspCallbackHandler, (uintptr_t)pSockCtx);
 
-/******************************************************************************
+        if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
+        {
+            slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+            sockUnlockSocket(pSockCtx);
+            errno = EBADMSG;
+            return -1;
+        }
 
-    Berkeley Style Socket Interface
+        (void)WINC_CmdSOCKBL(cmdReqHandle, pSockCtx->sockId, ntohs(pSockCtx->localEndPt.sin_port), 0);
 
- ******************************************************************************/
-#ifndef WINC_CONF_USE_EXT_SOCK_HDRS
-const struct in6_addr               in6addr_any = IN6ADDR_ANY_INIT;
-const struct in6_addr               in6addr_loopback = IN6ADDR_LOOPBACK_INIT;
-#endif
+        if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
+        {
+            slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+            sockUnlockSocket(pSockCtx);
+            errno = EBADMSG;
+            return -1;
+        }
 
-#define bswap_16(x) int_bswap_16(x)
-#define bswap_32(x) int_bswap_32(x)
-#define bswap_64(x) int_bswap_64(x)
+        if (false == sockAllocSocketBuffers(pSockCtx))
+        {
+            sockUnlockSocket(pSockCtx);
+            errno = ENOMEM;
+            return -1;
+        }
+    }
+
+    sockUnlockSocket(pSockCtx);
+    return 0;
+}
 
 /*****************************************************************************
   Description:
-    Byte swap 16-bit value
+    Listen for connections on a socket.
 
   Parameters:
-    __x - Value to be byte swapped
+    fd      - Socket file descriptor.
+    backlog - Maximum number of pending connections.
 
   Returns:
-    Swapped value
+    0  - Success.
+    -1 - Error, errno set.
 
   Remarks:
+    errno:
+        EADDRINUSE
+            The referred to by fd is not bound to a local port.
+        EBADF
+            The argument fd is not a valid file descriptor.
+        ENOTSOCK
+            The file descriptor fd does not refer to a socket.
+        EOPNOTSUPP
+            The socket is not of a type that supports the listen() operation.
+        EAGAIN
+            The socket is nonblocking, and the listening cannot be
+            completed immediately.
 
  *****************************************************************************/
 
-static __inline uint16_t int_bswap_16(uint16_t x)
+int WINC_SOCK_NS(listen)(int fd, int backlog)
 {
-    return (x<<8) | (x>>8);
+    return sockListen(fd, SOCK_STREAM, backlog);
 }
 
 /*****************************************************************************
   Description:
-    Byte swap 32-bit value
+    Accept a connection on a socket.
 
   Parameters:
-    __x - Value to be byte swapped
+    fd   - Socket file descriptor.
+    addr - Pointer to a structure to filled in with the address of the peer socket.
+    len  - Length of address structure.
 
   Returns:
-    Swapped value
+    0  - Success.
+    -1 - Error, errno set.
 
   Remarks:
+    errno:
+        EBADF
+            The argument fd is not a valid file descriptor.
+        ENOMEM
+            Insufficient memory is available.
+        EWOULDBLOCK
+            The socket is marked nonblocking and no connections are
+            present to be accepted.
 
  *****************************************************************************/
 
-static __inline uint32_t int_bswap_32(uint32_t x)
+int WINC_SOCK_NS(accept)(int fd, struct sockaddr *addr, socklen_t *len)
 {
-    return (x>>24) | ((x>>8)&0xff00U) | ((x<<8)&0xff0000U) | (x<<24);
+    return sockAccept(fd, SOCK_STREAM, addr, len);
 }
 
 /*****************************************************************************
   Description:
-    Byte swap 64-bit value
+    Initiate a connection on a socket.
 
   Parameters:
-    __x - Value to be byte swapped
+    fd   - Socket file descriptor.
+    addr - Pointer to socket address.
+    len  - Length of socket address.
 
   Returns:
-    Swapped value
+    0  - Success.
+    -1 - Error, errno set.
 
   Remarks:
+    errno:
+        EFAULT
+            System fault.
+        ENOTSOCK
+            The file descriptor fd does not refer to a socket.
+        EAFNOSUPPORT
+            The implementation does not support the specified address
+            family.
+        EAGAIN
+            The socket is nonblocking, and the connection cannot be
+            completed immediately.
+        ENOMEM
+            Insufficient memory is available.
+        EBADMSG
+            Bad message.
+        EINPROGRESS
+            The socket is nonblocking and the connection cannot be
+            completed immediately.  It is possible to poll for completion by
+            selecting the socket for writing. After poll indicates writability.
+        EISCONN
+            The socket is already connected.
 
  *****************************************************************************/
 
-static __inline uint64_t int_bswap_64(uint64_t x)
+int WINC_SOCK_NS(connect)(int fd, const struct sockaddr *addr, socklen_t len)
 {
-    return (int_bswap_32((uint32_t)x)+(0ULL<<32)) | (int_bswap_32((uint32_t)(x>>32)));
-}
+    WINC_CMD_REQ_HANDLE cmdReqHandle;
+    void *pCmdReqBuffer;
+    WINC_SOCK_CTX *pSockCtx = WINC_SOCK_HANDLE_TO_PTR(fd);
+    const struct sockaddr_in *pSockConnAddr = (const struct sockaddr_in*)addr;
+    WINC_TYPE typeRmtAddr;
+    size_t lenRmtAddr;
+    uintptr_t rmtAddr;
 
-/*****************************************************************************
-  Description:
-    Convert hex character into integer.
+    if ((NULL == pSockCtx) || (NULL == addr) || (len < sizeof_sockaddr(addr)))
+    {
+        errno = EFAULT;
+        return -1;
+    }
 
-  Parameters:
-    c - Character to be converted
+    if (false == sockLockSocket(pSockCtx))
+    {
+        errno = EFAULT;
+        return -1;
+    }
 
-  Returns:
-    Integer value of character or -1 for error
+    if (0U == pSockCtx->sockId)
+    {
+        if (true == pSockCtx->inUse)
+        {
+            errno = EAGAIN;
+        }
+        else
+        {
+            errno = ENOTSOCK;
+        }
 
-  Remarks:
+        sockUnlockSocket(pSockCtx);
+        return -1;
+    }
 
- *****************************************************************************/
+    if (true == pSockCtx->connected)
+    {
+        errno = EISCONN;
+        sockUnlockSocket(pSockCtx);
+        return -1;
+    }
 
-static int hexval(unsigned char c)
-{
-    if (c < STR_LIT_U('0'))
+    if ((AF_INET != pSockConnAddr->sin_family) && (AF_INET6 != pSockConnAddr->sin_family))
     {
+        sockUnlockSocket(pSockCtx);
+        errno = EAFNOSUPPORT;
         return -1;
     }
 
-    if (c <= STR_LIT_U('9'))
+    (void)memset(&pSockCtx->remoteEndPt, 0, sizeof(SOCKADDR_UNION));
+    (void)memcpy(&pSockCtx->remoteEndPt, pSockConnAddr, len);
+
+    if (false == sockAllocSocketBuffers(pSockCtx))
     {
-        return (c - STR_LIT_U('0'));
+        sockUnlockSocket(pSockCtx);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, WINC_SOCK_CMD_REQ_SZ(128, 1));
+
+    if (NULL == pCmdReqBuffer)
+    {
+        sockUnlockSocket(pSockCtx);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, WINC_SOCK_CMD_REQ_SZ(128, 1), 1, sockCmdRspCallbackHandler, (uintptr_t)pSockCtx);
+
+    if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
+    {
+        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+        sockUnlockSocket(pSockCtx);
+        errno = EBADMSG;
+        return -1;
+    }
+
+    if (AF_INET == pSockConnAddr->sin_family)
+    {
+        typeRmtAddr = WINC_TYPE_IPV4ADDR;
+        lenRmtAddr  = 4;
+        rmtAddr     = (uintptr_t)&pSockCtx->remoteEndPt.in4.sin_addr;
+    }
+    else
+    {
+        typeRmtAddr = WINC_TYPE_IPV6ADDR;
+        lenRmtAddr  = 16;
+        rmtAddr     = (uintptr_t)&pSockCtx->remoteEndPt.in6.sin6_addr;
     }
 
-    c |= 32U;
+    (void)WINC_CmdSOCKBR(cmdReqHandle, pSockCtx->sockId, typeRmtAddr, rmtAddr, lenRmtAddr, ntohs(pSockCtx->remoteEndPt.sin_port));
 
-    if ((c < STR_LIT_U('a')) || (c > STR_LIT_U('f')))
+    if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
     {
+        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+        sockUnlockSocket(pSockCtx);
+        errno = EBADMSG;
         return -1;
     }
 
-    return (c - STR_LIT_U('a') + 10U);
+    sockUnlockSocket(pSockCtx);
+    errno = EINPROGRESS;
+    return -1;
 }
 
 /*****************************************************************************
   Description:
-    Size of sockaddr structure depending on IP version.
+    Receive a message from a socket into an I/O vector list.
 
   Parameters:
-    addr - Pointer to sockaddr structure to size.
+    fd        - Socket file descriptor.
+    pIov      - Pointer to I/O vector list to receive the message.
+    iovCnt    - Number of I/O vectors.
+    flags     - Receive flags.
+    addr      - Pointer to a structure to receive the peer address.
+    alen      - Pointer to length of address structure.
+    pMsgFlags - Pointer to receive message flags, may be NULL.
 
   Returns:
-    Size of structure or 0 for error.
+    The number of bytes received or -1 for error, see errno.
 
   Remarks:
+    Common implementation of recvfrom, recvmsg and readv.
 
  *****************************************************************************/
 
-static size_t sizeof_sockaddr(const struct sockaddr *addr)
+static ssize_t sockRecvv(int fd, const struct iovec *pIov, int iovCnt, int flags, struct sockaddr *addr, socklen_t *alen, int *pMsgFlags)
 {
-    if (NULL == addr)
+    WINC_SOCK_CTX *pSockCtx = WINC_SOCK_HANDLE_TO_PTR(fd);
+    ssize_t recvLen;
+    size_t len;
+    size_t lenRemain = 0;
+    socklen_t addrLen = 0;
+
+    if (NULL == pSockCtx)
     {
-        return 0;
+        errno = EBADF;
+        return -1;
     }
 
-    if (AF_INET == addr->sa_family)
+    if (false == sockIovLength(pIov, iovCnt, &len))
     {
-        return sizeof(struct sockaddr_in);
+        errno = EINVAL;
+        return -1;
     }
-    else if (AF_INET6 == addr->sa_family)
+
+    if (false == sockLockSocket(pSockCtx))
     {
-        return sizeof(struct sockaddr_in6);
+        errno = EFAULT;
+        return -1;
     }
-    else
+
+    if (0U == pSockCtx->sockId)
     {
-        /* Do nothing. */
+        sockUnlockSocket(pSockCtx);
+        errno = ENOTSOCK;
+        return -1;
     }
 
-    return 0;
-}
-
-/*****************************************************************************
-  Description:
-    Convert IPv4 and IPv6 addresses from binary to text form.
-
-  Parameters:
-    af - Address family, either AF_INET or AF_INET6.
-    a0 - Pointer to IP address in network byte order.
-    s  - Pointer to string buffer to output to.
-    l  - Size of buffer supplied.
-
-  Returns:
-    Pointer to converted string within supplied buffer or 0 for error (errno set).
-
-  Remarks:
-    errno:
-        EAFNOSUPPORT
-            af was not a valid address family.
-        ENOSPC
-            The converted address string would exceed the size given by size.
-
- *****************************************************************************/
-
-const char *WINC_SOCK_NS(inet_ntop)(int af, const void *a0, char *s, socklen_t l)
-{
-    const unsigned char *a = a0;
-
-    switch ((unsigned)af)
+    if (0U == pSockCtx->recvBuffer.length)
     {
-        case AF_INET:
+        if ((SOCK_STREAM == pSockCtx->type) && (false == pSockCtx->connected))
         {
-            if (snprintf(s, l, "%d.%d.%d.%d", a[0], a[1], a[2], a[3]) < (int)l)
-            {
-                return s;
-            }
-
-            errno = ENOSPC;
-            break;
+            sockUnlockSocket(pSockCtx);
+            return 0;
         }
 
-        case AF_INET6:
+        if (WINC_SOCKET_ASYNC_MODE_OFF == (WINC_SOCKET_ASYNC_MODE_TYPE)pSockCtx->readMode)
         {
-            int i, j, max, best;
-            char buf[100];
-
-            static uint8_t transPrefix[12] = {0,0,0,0,0,0,0,0,0,0,0xffU,0xffU};
-
-            if (0 != memcmp(a, transPrefix, 12))
-            {
-                (void)snprintf(buf, sizeof buf, "%x:%x:%x:%x:%x:%x:%x:%x",
-                               (256U*a[0])+a[1],(256U*a[2])+a[3],
-                               (256U*a[4])+a[5],(256U*a[6])+a[7],
-                               (256U*a[8])+a[9],(256U*a[10])+a[11],
-                               (256U*a[12])+a[13],(256U*a[14])+a[15]);
-            }
-            else
-            {
-                (void)snprintf(buf, sizeof buf, "%x:%x:%x:%x:%x:%x:%d.%d.%d.%d",
-                               (256U*a[0])+a[1],(256U*a[2])+a[3],
-                               (256U*a[4])+a[5],(256U*a[6])+a[7],
-                               (256U*a[8])+a[9],(256U*a[10])+a[11],
-                               a[12],a[13],a[14],a[15]);
-            }
-
-            /* Replace longest /(^0|:)[:0]{2,}/ with "::" */
-            best = 0;
-            max  = 2;
-            for (i=0; '\0' != buf[i]; i++)
-            {
-                if ((0 != i) && (buf[i] != ':'))
-                {
-                    continue;
-                }
+            (void)sockRead(pSockCtx);
+        }
 
-                j = (int)strspn(buf+i, ":0");
+        sockUnlockSocket(pSockCtx);
+        errno = EWOULDBLOCK;
+        return -1;
+    }
 
-                if (j>max)
-                {
-                    best = i;
-                    max  = j;
-                }
-            }
+    if ((SOCK_DGRAM == pSockCtx->type) && (NULL != pSockCtx->recvBuffer.pUdpPktBuffers))
+    {
+        if (0U == pSockCtx->recvBuffer.pUdpPktBuffers->pktDepth)
+        {
+            sockUnlockSocket(pSockCtx);
+            errno = EWOULDBLOCK;
+            return -1;
+        }
 
-            if (max > 3)
-            {
-                buf[best]   = ':';
-                buf[best+1] = ':';
-                (void)memmove(buf+best+2, buf+best+max, (i-best-max+1));
-            }
+        if (NULL != alen)
+        {
+            addrLen = *alen;
 
-            if (strlen(buf) < l)
+            if (addrLen > sizeof(SOCKADDR_UNION))
             {
-                (void)strcpy(s, buf);
-                return s;
+                addrLen = sizeof(SOCKADDR_UNION);
             }
 
-            errno = ENOSPC;
-            break;
-        }
-
-        default:
-        {
-            errno = EAFNOSUPPORT;
-            break;
+            *alen = addrLen;
         }
     }
+    else if (NULL != alen)
+    {
+        *alen = 0;
+    }
+    else
+    {
+    }
 
-    return NULL;
-}
-
-/*****************************************************************************
-  Description:
-    Convert IPv4 and IPv6 addresses from text to binary form.
-
-  Parameters:
-    af - Address family, either AF_INET or AF_INET6.
-    s  - Pointer to input IP address string.
-    a0 - Pointer to output binary form IP address.
-
-  Returns:
-    -1 - Error, errno is set.
-    0  - No valid IP address string found.
-    1  - Success.
-
-  Remarks:
-    errno:
-        EAFNOSUPPORT
-            af was not a valid address family.
+    if ((0U != pSockCtx->recvBorrowLen) && (0U == ((unsigned)flags & MSG_PEEK)))
+    {
+        sockUnlockSocket(pSockCtx);
+        errno = EBUSY;
+        return -1;
+    }
 
- *****************************************************************************/
+    recvLen = sockBufferReadv(&pSockCtx->recvBuffer, (len > 0U) ? pIov : NULL, len, addr, addrLen, ((unsigned)flags & MSG_PEEK) ? true : false, &lenRemain);
 
-int WINC_SOCK_NS(inet_pton)(int af, const char *s, void *a0)
-{
-    uint16_t ip[8];
-    unsigned char *a = a0;
-    int i, j, v, brk = -1, need_v4 = 0;
+    if (-1 == recvLen)
+    {
+        errno = EFAULT;
+    }
 
-    if (AF_INET == (unsigned)af)
+    if ((len > 0U) && (0 == recvLen))
     {
-        for (i=0; i<4; i++)
+        if (false == pSockCtx->connected)
         {
-            v = 0;
-            for (j=0; (j<3) && (0 != isdigit((int)s[j])); j++)
-            {
-                v = (10*v) + (s[j] - (char)'0');
-            }
-
-            if ((0 == j) || ((j > 1) && ('0' == s[0])) || (v > 255))
-            {
-                return 0;
-            }
-
-            a[i] = (unsigned char)v;
-
-            if (('\0' == s[j]) && (3 == i))
-            {
-                return 1;
-            }
-
-            if ('.' != s[j])
-            {
-                return 0;
-            }
-
-            s = &s[j+1];
+            sockUnlockSocket(pSockCtx);
+            return 0;
         }
 
-        return 0;
+        sockUnlockSocket(pSockCtx);
+        errno = EWOULDBLOCK;
+        return -1;
     }
-    else if (AF_INET6 != (unsigned)af)
+
+    if ((NULL != pMsgFlags) && (SOCK_DGRAM == pSockCtx->type) && (lenRemain > 0U))
     {
-        errno = EAFNOSUPPORT;
-        return -1;
+        *pMsgFlags |= (int)MSG_TRUNC;
     }
-    else
+
+    if (0U != ((unsigned)flags & MSG_TRUNC))
     {
+        if (SOCK_DGRAM == pSockCtx->type)
+        {
+            recvLen = (len + lenRemain);
+        }
+        else
+        {
+            recvLen = lenRemain;
+        }
     }
 
-    if (':' == s[0])
+    WINC_TRACE_PRINT("RV %d\n", recvLen);
+
+    if ((0U == ((unsigned)flags & MSG_PEEK)) && (recvLen > 0))
     {
-        if (':' != s[1])
+        if (false == sockRecvConsumed(pSockCtx, (size_t)recvLen))
         {
-            return 0;
+            sockUnlockSocket(pSockCtx);
+            return -1;
         }
-
-        s++;
     }
 
-    for (i=0; ; i++)
-    {
-        if ((':' == s[0]) && (brk < 0))
-        {
-            brk = i;
-            ip[(unsigned)i & 7U] = 0;
+    sockUnlockSocket(pSockCtx);
+    return recvLen;
+}
 
-            if ('\0' == *++s)
-            {
-                break;
-            }
+/*****************************************************************************
+  Description:
+    Receive a message from a socket.
 
-            if (7 == i)
-            {
-                return 0;
-            }
+  Parameters:
+    fd    - Socket file descriptor.
+    buf   - Pointer to buffer to receive data.
+    len   - Length of data to receive.
+    flags - Option for reception, currently ignored.
+    addr  - Pointer to a structure to receive the peer address.
+    alen  - Pointer to length of address structure.
 
-            continue;
-        }
+  Returns:
+    The number of bytes received or -1 for error, see errno.
+    If the return value is 0, the socket has performed an orderly shutdown.
 
-        v = 0;
-        for (j=0; (j < 4) && ((hexval((unsigned)s[j])) >= 0); j++)
-        {
-            v = (16*v) + hexval((unsigned)s[j]);
-        }
+  Remarks:
+    errno:
+        EBADF
+            The argument fd is not a valid file descriptor.
+        EFAULT
+            System fault.
+        ENOTSOCK
+            The file descriptor fd does not refer to a socket.
+        EWOULDBLOCK
+            The socket is marked nonblocking and the receive operation
+            would block.
+        EINVAL
+            The buffer is invalid.
+        EBUSY
+            Data is borrowed by WINC_SockRecvBorrow and not yet released.
 
-        if (0 == j)
-        {
-            return 0;
-        }
+ *****************************************************************************/
 
-        ip[(unsigned)i & 7U] = (uint16_t)v;
+ssize_t WINC_SOCK_NS(recvfrom)(int fd, void *buf, size_t len, int flags, struct sockaddr *addr, socklen_t *alen)
+{
+    struct iovec iov;
 
-        if (('\0' == s[j]) && ((brk >= 0) || (7 == i)))
-        {
-            break;
-        }
+    iov.iov_base = buf;
+    iov.iov_len  = len;
 
-        if (7 == i)
-        {
-            return 0;
-        }
+    return sockRecvv(fd, &iov, 1, flags, addr, alen, NULL);
+}
 
-        if (':' != s[j])
-        {
-            if (('.' != s[j]) || ((i < 6) && (brk < 0)))
-            {
-                return 0;
-            }
+/*****************************************************************************
+  Description:
+    Receive a message from a socket.
 
-            need_v4 = 1;
+  Parameters:
+    fd    - Socket file descriptor.
+    msg   - Pointer to message header describing the receive buffers.
+    flags - Receive flags.
 
-            i++;
-            ip[(unsigned)i & 7U] = 0;
+  Returns:
+    The number of bytes received or -1 for error, see errno.
+    If the return value is 0, the socket has performed an orderly shutdown.
 
-            break;
-        }
+  Remarks:
+    The data is scattered across the I/O vectors in msg_iov in order. For
+    datagram sockets MSG_TRUNC is set in msg_flags if the datagram was
+    larger than the buffers provided. Ancillary data is not supported,
+    msg_controllen is always set to zero.
 
-        s = &s[j+1];
-    }
+    errno:
+        EBADF
+            The argument fd is not a valid file descriptor.
+        EFAULT
+            System fault.
+        EINVAL
+            The message header or I/O vector list is invalid.
+        ENOTSOCK
+            The file descriptor fd does not refer to a socket.
+        EWOULDBLOCK
+            The socket is marked nonblocking and the receive operation
+            would block.
+        EBUSY
+            Data is borrowed by WINC_SockRecvBorrow and not yet released.
 
-    if (brk >= 0)
-    {
-        (void)memmove(ip+brk+7-i, ip+brk, (2*(i+1-brk)));
+ *****************************************************************************/
 
-        for (j=0; j<(7-i); j++)
-        {
-            ip[brk + j] = 0;
-        }
-    }
+ssize_t WINC_SOCK_NS(recvmsg)(int fd, struct msghdr *msg, int flags)
+{
+    ssize_t recvLen;
+    socklen_t addrLen;
 
-    for (j=0; j<8; j++)
+    if (NULL == msg)
     {
-        *a++ = (unsigned char)(ip[j] >> 8);
-        *a++ = (unsigned char)(ip[j]);
+        errno = EINVAL;
+        return -1;
     }
 
-    if ((0 != need_v4) && (inet_pton((int)AF_INET, s, a-4) <= 0))
+    addrLen = msg->msg_namelen;
+
+    msg->msg_flags      = 0;
+    msg->msg_controllen = 0;
+
+    recvLen = sockRecvv(fd, msg->msg_iov, msg->msg_iovlen, flags, msg->msg_name, (NULL != msg->msg_name) ? &addrLen : NULL, &msg->msg_flags);
+
+    if (recvLen >= 0)
     {
-        return 0;
+        msg->msg_namelen = (NULL != msg->msg_name) ? addrLen : 0U;
     }
 
-    return 1;
+    return recvLen;
 }
 
 /*****************************************************************************
   Description:
-    Create an endpoint for communication.
+    Read data from a socket into multiple buffers.
 
   Parameters:
-    domain   - Communication domain, must be AF_INET or AF_INET6.
-    type     - Socket type, must be SOCK_STREAM or SOCK_DGRAM.
-    protocol - Specific socket protocol, should be zero or IPPROTO_TLS.
+    fd     - Socket file descriptor.
+    iov    - Pointer to I/O vector list to receive data.
+    iovcnt - Number of I/O vectors.
 
   Returns:
-    Socket file descriptor or -1 for error (errno set).
+    The number of bytes received or -1 for error, see errno.
+    If the return value is 0, the socket has performed an orderly shutdown.
 
   Remarks:
+    Equivalent to recvmsg with no address and no flags.
+
     errno:
-        EAFNOSUPPORT
-            The implementation does not support the specified address
-            family.
-        EINVAL
-            Unknown protocol, or protocol family not available.
-        EPROTONOSUPPORT
-            The protocol type or the specified protocol is not
-            supported within this domain.
-        EFAULT
-            System fault
-        ENFILE The system-wide limit on the total number of open files
-            has been reached.
-        ENOMEM
-            Insufficient memory is available.  The socket cannot be
-            created until sufficient resources are freed.
-        EBADMSG
-            Bad message.
+        See recvmsg.
 
  *****************************************************************************/
 
-int WINC_SOCK_NS(socket)(int domain, int type, int protocol)
+ssize_t WINC_SOCK_NS(readv)(int fd, const struct iovec *iov, int iovcnt)
 {
-    WINC_CMD_REQ_HANDLE cmdReqHandle;
-    void *pCmdReqBuffer;
-    WINC_SOCK_CTX *pSockCtx = NULL;
-    uint8_t cmdProtocol;
-    uint8_t cmdProtocolVersion;
+    return sockRecvv(fd, iov, iovcnt, 0, NULL, NULL, NULL);
+}
 
-    if (AF_INET == (unsigned)domain)
-    {
-        cmdProtocolVersion = WINC_CONST_NETIF_PROTOCOL_VERSION_IPV4;
-    }
-    else if (AF_INET6 == (unsigned)domain)
-    {
-        cmdProtocolVersion = WINC_CONST_NETIF_PROTOCOL_VERSION_IPV6;
-    }
-    else
-    {
-        errno = EAFNOSUPPORT;
-        return -1;
-    }
+/*****************************************************************************
+  Description:
+    Receive multiple messages from a socket.
 
-    if (SOCK_STREAM == (unsigned)type)
-    {
-        if (0 == protocol)
-        {
-            protocol = (int)IPPROTO_TCP;
-        }
+  Parameters:
+    fd      - Socket file descriptor.
+    msgvec  - Pointer to array of message headers.
+    vlen    - Number of messages in msgvec.
+    flags   - Receive flags.
+    timeout - Receive timeout, currently ignored.
 
-        if ((IPPROTO_TCP != (unsigned)protocol) && (IPPROTO_TLS != (unsigned)protocol))
-        {
-            errno = EPROTONOSUPPORT;
-            return -1;
-        }
+  Returns:
+    The number of messages received or -1 for error, see errno.
 
-        cmdProtocol = WINC_CONST_SOCKET_PROTOCOL_TCP;
-    }
-    else if (SOCK_DGRAM == (unsigned)type)
-    {
-        if (0 == protocol)
-        {
-            protocol = (int)IPPROTO_UDP;
-        }
+  Remarks:
+    Queued messages are received until msgvec is full or no more data is
+    available, the call never waits. For datagram sockets each message
+    receives one datagram. The number of bytes received for each message
+    is stored in msg_len.
 
-        if ((IPPROTO_UDP != (unsigned)protocol) && (IPPROTO_TLS != (unsigned)protocol))
-        {
-            errno = EPROTONOSUPPORT;
-            return -1;
-        }
+    If an error occurs after at least one message has been received the
+    number of messages received is returned, otherwise -1 is returned.
 
-        cmdProtocol = WINC_CONST_SOCKET_PROTOCOL_UDP;
-    }
-    else
-    {
-        errno = EINVAL;
-        return -1;
-    }
+    errno:
+        See recvmsg.
 
-    if (WINC_DEVICE_INVALID_HANDLE == wincDevHandle)
-    {
-        errno = EFAULT;
-        return -1;
-    }
+ *****************************************************************************/
 
-    pSockCtx = sockFindFreeSocket();
+int WINC_SOCK_NS(recvmmsg)(int fd, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timespec *timeout)
+{
+    unsigned int numRecv = 0;
 
-    if (NULL == pSockCtx)
+    (void)timeout;
+
+    if (0U == vlen)
     {
-        errno = ENFILE;
-        return -1;
+        return 0;
     }
 
-    if (false == sockCreateSocket(pSockCtx, (uint8_t)type, 0))
+    if (NULL == msgvec)
     {
-        errno = ENFILE;
+        errno = EINVAL;
         return -1;
     }
 
-    if (false == sockLockSocket(pSockCtx))
+    if (vlen > (unsigned int)INT_MAX)
     {
-        errno = EFAULT;
-        return -1;
+        vlen = (unsigned int)INT_MAX;
     }
 
-    pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, 128);
+    flags = (int)((unsigned)flags & ~MSG_WAITFORONE);
 
-    if (NULL == pCmdReqBuffer)
+    while (numRecv < vlen)
     {
-        sockUnlockSocket(pSockCtx);
-        sockDestroySocket(pSockCtx);
-        errno = ENOMEM;
-        return -1;
-    }
+        ssize_t recvLen;
 
-    cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, 128, 1, sockCmdRspCallbackHandler, (uintptr_t)pSockCtx);
+        recvLen = WINC_SOCK_NS(recvmsg)(fd, &msgvec[numRecv].msg_hdr, flags);
 
-    if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
-    {
-        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
-        sockUnlockSocket(pSockCtx);
-        sockDestroySocket(pSockCtx);
-        errno = EBADMSG;
-        return -1;
-    }
+        if (recvLen < 0)
+        {
+            break;
+        }
 
-    (void)WINC_CmdSOCKO(cmdReqHandle, cmdProtocol, cmdProtocolVersion);
+        msgvec[numRecv].msg_len = (unsigned int)recvLen;
+        numRecv++;
 
-    if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
+        if (0 == recvLen)
+        {
+            /* Orderly shutdown or empty datagram, return what has been received. */
+            break;
+        }
+    }
+
+    if (0U == numRecv)
     {
-        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
-        sockUnlockSocket(pSockCtx);
-        sockDestroySocket(pSockCtx);
-        errno = EBADMSG;
         return -1;
     }
 
-    pSockCtx->protocol = (uint16_t)protocol;
-    pSockCtx->domain   = (uint8_t)domain;
-    pSockCtx->readMode = (uint8_t)WINC_SOCKET_ASYNC_MODE_ACKED;
-
-    WINC_TRACE_PRINT("Socket %08x -> %d\n", pSockCtx, WINC_SOCK_PTR_TO_HANDLE(pSockCtx));
-
-    sockUnlockSocket(pSockCtx);
-    return WINC_SOCK_PTR_TO_HANDLE(pSockCtx);
+    return (int)numRecv;
 }
 
 /*****************************************************************************
   Description:
-    Shut down part of a full-duplex connection.
+    Borrow received data in place in the socket receive buffer.
 
   Parameters:
-    fd  - Socket file descriptor.
-    how - Shutdown flags, must be SHUT_RDWR.
+    fd    - Socket file descriptor.
+    ppBuf - Pointer to receive a pointer to the data.
+    addr  - Pointer to a structure to receive the peer address.
+    alen  - Pointer to length of address structure.
 
   Returns:
-    0  - Success.
-    -1 - Error, errno set.
+    The number of bytes available at *ppBuf or -1 for error, see errno.
+    For stream sockets, if the return value is 0, the socket has performed
+    an orderly shutdown. For datagram sockets a return value of 0 indicates
+    an empty datagram, which is discarded immediately and must not be
+    released.
 
   Remarks:
+    The data remains in the socket receive buffer until it is released by
+    WINC_SockRecvRelease, recv() cannot be used on the socket in between.
+    For stream sockets the data returned is the contiguous part of the
+    receive buffer, further data may be available after release. For
+    datagram sockets a whole datagram is returned, received datagrams are
+    always stored contiguously in the receive buffer.
+
+    This saves the copy recv() makes into the application's buffer. Data
+    is still copied once, from the device receive buffer into the socket
+    receive buffer, when it arrives.
+
     errno:
         EBADF
-            fd is not a valid file descriptor.
+            The argument fd is not a valid file descriptor.
+        EFAULT
+            System fault.
         ENOTSOCK
             The file descriptor fd does not refer to a socket.
-        ENOMEM
-            Insufficient memory is available.  The socket cannot be
-            created until sufficient resources are freed.
-        EBADMSG
-            Bad message.
+        EWOULDBLOCK
+            No data is available.
+        EBUSY
+            Data is already borrowed.
 
  *****************************************************************************/
 
-int WINC_SOCK_NS(shutdown)(int fd, int how)
+ssize_t WINC_SockRecvBorrow(int fd, const void **ppBuf, struct sockaddr *addr, socklen_t *alen)
 {
-    WINC_CMD_REQ_HANDLE cmdReqHandle;
-    void *pCmdReqBuffer;
     WINC_SOCK_CTX *pSockCtx = WINC_SOCK_HANDLE_TO_PTR(fd);
+    WINC_SOCK_BUFFER *pBuffer;
+    size_t recvLen;
+    socklen_t addrLen = 0;
 
     if (NULL == pSockCtx)
     {
@@ -3996,6 +7517,12 @@ int WINC_SOCK_NS(shutdown)(int fd, int how)
         return -1;
     }
 
+    if (NULL == ppBuf)
+    {
+        errno = EFAULT;
+        return -1;
+    }
+
     if (false == sockLockSocket(pSockCtx))
     {
         errno = EFAULT;
@@ -4009,77 +7536,133 @@ int WINC_SOCK_NS(shutdown)(int fd, int how)
         return -1;
     }
 
-    pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, 128);
-
-    if (NULL == pCmdReqBuffer)
+    if (0U != pSockCtx->recvBorrowLen)
     {
         sockUnlockSocket(pSockCtx);
-        errno = ENOMEM;
+        errno = EBUSY;
         return -1;
     }
 
-    cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, 128, 1, sockCmdRspCallbackHandler, (uintptr_t)pSockCtx);
+    pBuffer = &pSockCtx->recvBuffer;
 
-    if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
+    if (0U == pBuffer->length)
     {
-        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+        if ((SOCK_STREAM == pSockCtx->type) && (false == pSockCtx->connected))
+        {
+            sockUnlockSocket(pSockCtx);
+            return 0;
+        }
+
+        if (WINC_SOCKET_ASYNC_MODE_OFF == (WINC_SOCKET_ASYNC_MODE_TYPE)pSockCtx->readMode)
+        {
+            (void)sockRead(pSockCtx);
+        }
+
         sockUnlockSocket(pSockCtx);
-        errno = EBADMSG;
+        errno = EWOULDBLOCK;
         return -1;
     }
 
-    (void)WINC_CmdSOCKCL(cmdReqHandle, pSockCtx->sockId);
+    if ((SOCK_DGRAM == pSockCtx->type) && (NULL != pBuffer->pUdpPktBuffers))
+    {
+        if (NULL != alen)
+        {
+            addrLen = *alen;
 
-    if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
+            if (addrLen > sizeof(SOCKADDR_UNION))
+            {
+                addrLen = sizeof(SOCKADDR_UNION);
+            }
+
+            *alen = addrLen;
+        }
+
+        /* Peek the datagram length and address, this also skips any padding
+           so the datagram starts at the buffer out offset. */
+        recvLen = 0;
+
+        (void)sockBufferRead(pBuffer, NULL, 0, addr, addrLen, true, &recvLen);
+
+        if (0U == pBuffer->pUdpPktBuffers->pktDepth)
+        {
+            sockUnlockSocket(pSockCtx);
+            errno = EWOULDBLOCK;
+            return -1;
+        }
+
+        if (0U == recvLen)
+        {
+            /* Nothing to borrow from an empty datagram, discard it now. */
+            (void)sockBufferRead(pBuffer, NULL, 0, NULL, 0, false, NULL);
+
+            *ppBuf = NULL;
+
+            sockUnlockSocket(pSockCtx);
+            return 0;
+        }
+    }
+    else
     {
-        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
-        sockUnlockSocket(pSockCtx);
-        errno = EBADMSG;
-        return -1;
+        if (NULL != alen)
+        {
+            *alen = 0;
+        }
+
+        /* Only the data up to the end of the buffer is contiguous. */
+        recvLen = pBuffer->length;
+
+        if (recvLen > (size_t)(pBuffer->totalSize - pBuffer->outOffset))
+        {
+            recvLen = (size_t)(pBuffer->totalSize - pBuffer->outOffset);
+        }
     }
 
+    *ppBuf = &pBuffer->pData[pBuffer->outOffset];
+
+    pSockCtx->recvBorrowLen = (uint16_t)recvLen;
+
+    WINC_TRACE_PRINT("RB %d\n", recvLen);
+
     sockUnlockSocket(pSockCtx);
-    return 0;
+    return (ssize_t)recvLen;
 }
 
 /*****************************************************************************
   Description:
-    Bind a name to a socket.
+    Release data borrowed from a socket.
 
   Parameters:
-    fd   - Socket file descriptor.
-    addr - Pointer to socket address.
-    len  - Length of socket address.
+    fd  - Socket file descriptor.
+    len - Length of data consumed.
 
   Returns:
-    0  - Success.
-    -1 - Error, errno set.
+    0 for success or -1 for error, see errno.
 
   Remarks:
+    For stream sockets len may be less than the length borrowed, the
+    remaining data will be returned again. For datagram sockets the whole
+    datagram is always released.
+
     errno:
+        EBADF
+            The argument fd is not a valid file descriptor.
         EFAULT
             System fault.
-        EAFNOSUPPORT
-            The implementation does not support the specified address
-            family.
-        ENOMEM
-            Insufficient memory is available.
-        EBADMSG
-            Bad message.
-        EAGAIN
-            The socket is nonblocking, and the binding cannot be
-            completed immediately.
+        ENOTSOCK
+            The file descriptor fd does not refer to a socket.
+        EINVAL
+            No data is borrowed, or len exceeds the length borrowed.
 
  *****************************************************************************/
 
-int WINC_SOCK_NS(bind)(int fd, const struct sockaddr *addr, socklen_t len)
+int WINC_SockRecvRelease(int fd, size_t len)
 {
     WINC_SOCK_CTX *pSockCtx = WINC_SOCK_HANDLE_TO_PTR(fd);
-    const struct sockaddr_in *pSockBindAddr = (const struct sockaddr_in*)addr;
+    ssize_t recvLen;
 
-    if ((NULL == pSockCtx) || (NULL == addr) || (len < sizeof(struct sockaddr_in)))
+    if (NULL == pSockCtx)
     {
-        errno = EFAULT;
+        errno = EBADF;
         return -1;
     }
 
@@ -4089,60 +7672,39 @@ int WINC_SOCK_NS(bind)(int fd, const struct sockaddr *addr, socklen_t len)
         return -1;
     }
 
-    /* None TCP/TLS sockets must have an ID to proceed. */
-    if ((0U == pSockCtx->sockId) && (SOCK_DGRAM == pSockCtx->type) && (IPPROTO_TLS != pSockCtx->protocol))
+    if (0U == pSockCtx->sockId)
     {
         sockUnlockSocket(pSockCtx);
-        errno = EAGAIN;
+        errno = ENOTSOCK;
         return -1;
     }
 
-    if ((AF_INET != pSockBindAddr->sin_family) && (AF_INET6 != pSockBindAddr->sin_family))
+    if ((0U == pSockCtx->recvBorrowLen) || (len > pSockCtx->recvBorrowLen))
     {
         sockUnlockSocket(pSockCtx);
-        errno = EAFNOSUPPORT;
+        errno = EINVAL;
         return -1;
     }
 
-    (void)memset(&pSockCtx->localEndPt, 0, sizeof(SOCKADDR_UNION));
-    (void)memcpy(&pSockCtx->localEndPt, pSockBindAddr, len);
-
-    /* Perform bind here for none TCP/TLS sockets. */
-    if ((SOCK_DGRAM == pSockCtx->type) && (IPPROTO_TLS != pSockCtx->protocol))
+    if ((SOCK_DGRAM == pSockCtx->type) && (NULL != pSockCtx->recvBuffer.pUdpPktBuffers))
     {
-        WINC_CMD_REQ_HANDLE cmdReqHandle;
-        void *pCmdReqBuffer;
-
-        pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, 128);
-
-        if (NULL == pCmdReqBuffer)
-        {
-            sockUnlockSocket(pSockCtx);
-            errno = ENOMEM;
-            return -1;
-        }
-
-        cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, 128, 1, sockCmdRspCallbackHandler, (uintptr_t)pSockCtx);
+        /* Reading no data discards the whole datagram. */
+        (void)sockBufferRead(&pSockCtx->recvBuffer, NULL, 0, NULL, 0, false, NULL);
 
-        if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
-        {
-            slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
-            sockUnlockSocket(pSockCtx);
-            errno = EBADMSG;
-            return -1;
-        }
+        recvLen = (ssize_t)pSockCtx->recvBorrowLen;
+    }
+    else
+    {
+        recvLen = sockBufferRead(&pSockCtx->recvBuffer, NULL, len, NULL, 0, false, NULL);
+    }
 
-        (void)WINC_CmdSOCKBL(cmdReqHandle, pSockCtx->sockId, ntohs(pSockCtx->localEndPt.sin_port), 0);
+    WINC_TRACE_PRINT("RR %d\n", recvLen);
 
-        if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
-        {
-            slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
-            sockUnlockSocket(pSockCtx);
-            errno = EBADMSG;
-            return -1;
-        }
+    pSockCtx->recvBorrowLen = 0;
 
-        if (false == sockAllocSocketBuffers(pSockCtx))
+    if (recvLen > 0)
+    {
+        if (false == sockRecvConsumed(pSockCtx, (size_t)recvLen))
         {
             sockUnlockSocket(pSockCtx);
             errno = ENOMEM;
@@ -4156,211 +7718,119 @@ int WINC_SOCK_NS(bind)(int fd, const struct sockaddr *addr, socklen_t len)
 
 /*****************************************************************************
   Description:
-    Listen for connections on a socket.
+    Send a constant payload on a stream socket without copying it.
 
   Parameters:
-    fd      - Socket file descriptor.
-    backlog - Maximum number of pending connections.
+    fd         - Socket file descriptor.
+    pData      - Pointer to payload, which may be in flash.
+    len        - Length of payload.
+    pfComplete - Completion callback, may be NULL.
+    context    - Context passed to the completion callback.
 
   Returns:
-    0  - Success.
-    -1 - Error, errno set.
+    0 if the payload is queued, or -1 for error, see errno.
 
   Remarks:
-    errno:
-        EADDRINUSE
-            The referred to by fd is not bound to a local port.
-        EBADF
-            The argument fd is not a valid file descriptor.
-        ENOTSOCK
-            The file descriptor fd does not refer to a socket.
-        EOPNOTSUPP
-            The socket is not of a type that supports the listen() operation.
-        EAGAIN
-            The socket is nonblocking, and the listening cannot be
-            completed immediately.
-
- *****************************************************************************/
-
-int WINC_SOCK_NS(listen)(int fd, int backlog)
-{
-    return sockListen(fd, SOCK_STREAM, backlog);
-}
-
-/*****************************************************************************
-  Description:
-    Accept a connection on a socket.
-
-  Parameters:
-    fd   - Socket file descriptor.
-    addr - Pointer to a structure to filled in with the address of the peer socket.
-    len  - Length of address structure.
-
-  Returns:
-    0  - Success.
-    -1 - Error, errno set.
+    The payload is sent after any data already in the socket send buffer,
+    it is encoded into command requests directly without passing through
+    the send buffer. The payload must remain valid until the completion
+    callback is called, which happens when all of it has been accepted by
+    the device or, with WINC_SOCKET_STATUS_ERROR, when the socket is
+    destroyed. Until then send() returns EWOULDBLOCK and POLLOUT is not
+    signalled for the socket.
 
-  Remarks:
     errno:
         EBADF
             The argument fd is not a valid file descriptor.
-        ENOMEM
-            Insufficient memory is available.
-        EWOULDBLOCK
-            The socket is marked nonblocking and no connections are
-            present to be accepted.
-
- *****************************************************************************/
-
-int WINC_SOCK_NS(accept)(int fd, struct sockaddr *addr, socklen_t *len)
-{
-    return sockAccept(fd, SOCK_STREAM, addr, len);
-}
-
-/*****************************************************************************
-  Description:
-    Initiate a connection on a socket.
-
-  Parameters:
-    fd   - Socket file descriptor.
-    addr - Pointer to socket address.
-    len  - Length of socket address.
-
-  Returns:
-    0  - Success.
-    -1 - Error, errno set.
-
-  Remarks:
-    errno:
         EFAULT
             System fault.
+        EINVAL
+            The payload is empty.
         ENOTSOCK
             The file descriptor fd does not refer to a socket.
-        EAFNOSUPPORT
-            The implementation does not support the specified address
-            family.
-        EAGAIN
-            The socket is nonblocking, and the connection cannot be
-            completed immediately.
+        EOPNOTSUPP
+            The socket is not a stream socket.
+        ENOTCONN
+            The socket is not connected.
+        EBUSY
+            A constant payload is already being sent.
         ENOMEM
             Insufficient memory is available.
-        EBADMSG
-            Bad message.
-        EINPROGRESS
-            The socket is nonblocking and the connection cannot be
-            completed immediately.  It is possible to poll for completion by
-            selecting the socket for writing. After poll indicates writability.
-        EISCONN
-            The socket is already connected.
 
  *****************************************************************************/
 
-int WINC_SOCK_NS(connect)(int fd, const struct sockaddr *addr, socklen_t len)
+int WINC_SockSendConst(int fd, const void *pData, size_t len, WINC_SOCK_SEND_CONST_CALLBACK pfComplete, uintptr_t context)
 {
-    WINC_CMD_REQ_HANDLE cmdReqHandle;
-    void *pCmdReqBuffer;
     WINC_SOCK_CTX *pSockCtx = WINC_SOCK_HANDLE_TO_PTR(fd);
-    const struct sockaddr_in *pSockConnAddr = (const struct sockaddr_in*)addr;
-    WINC_TYPE typeRmtAddr;
-    size_t lenRmtAddr;
-    uintptr_t rmtAddr;
 
-    if ((NULL == pSockCtx) || (NULL == addr) || (len < sizeof_sockaddr(addr)))
+    if (NULL == pSockCtx)
     {
-        errno = EFAULT;
+        errno = EBADF;
         return -1;
     }
 
-    if (false == sockLockSocket(pSockCtx))
+    if ((NULL == pData) || (0U == len))
     {
-        errno = EFAULT;
+        errno = EINVAL;
         return -1;
     }
 
-    if (0U == pSockCtx->sockId)
+    if (false == sockLockSocket(pSockCtx))
     {
-        if (true == pSockCtx->inUse)
-        {
-            errno = EAGAIN;
-        }
-        else
-        {
-            errno = ENOTSOCK;
-        }
-
-        sockUnlockSocket(pSockCtx);
+        errno = EFAULT;
         return -1;
     }
 
-    if (true == pSockCtx->connected)
+    if (0U == pSockCtx->sockId)
     {
-        errno = EISCONN;
         sockUnlockSocket(pSockCtx);
+        errno = ENOTSOCK;
         return -1;
     }
 
-    if ((AF_INET != pSockConnAddr->sin_family) && (AF_INET6 != pSockConnAddr->sin_family))
+    if (SOCK_STREAM != pSockCtx->type)
     {
         sockUnlockSocket(pSockCtx);
-        errno = EAFNOSUPPORT;
+        errno = EOPNOTSUPP;
         return -1;
     }
 
-    (void)memset(&pSockCtx->remoteEndPt, 0, sizeof(SOCKADDR_UNION));
-    (void)memcpy(&pSockCtx->remoteEndPt, pSockConnAddr, len);
-
-    if (false == sockAllocSocketBuffers(pSockCtx))
+    if (false == pSockCtx->connected)
     {
         sockUnlockSocket(pSockCtx);
-        errno = ENOMEM;
+        errno = ENOTCONN;
         return -1;
     }
 
-    pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, 128);
-
-    if (NULL == pCmdReqBuffer)
+    if (NULL != pSockCtx->pConstData)
     {
         sockUnlockSocket(pSockCtx);
-        errno = ENOMEM;
+        errno = EBUSY;
         return -1;
     }
 
-    cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, 128, 1, sockCmdRspCallbackHandler, (uintptr_t)pSockCtx);
+    pSockCtx->pConstData       = pData;
+    pSockCtx->constLen         = len;
+    pSockCtx->constSent        = 0;
+    pSockCtx->constAcked       = 0;
+    pSockCtx->pfConstComplete  = pfComplete;
+    pSockCtx->constCompleteCtx = context;
 
-    if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
-    {
-        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
-        sockUnlockSocket(pSockCtx);
-        errno = EBADMSG;
-        return -1;
-    }
+    /* The payload is not held back by MSG_MORE on an earlier send. */
+    pSockCtx->sendMore = false;
 
-    if (AF_INET == pSockConnAddr->sin_family)
-    {
-        typeRmtAddr = WINC_TYPE_IPV4ADDR;
-        lenRmtAddr  = 4;
-        rmtAddr     = (uintptr_t)&pSockCtx->remoteEndPt.in4.sin_addr;
-    }
-    else
+    if ((false == sockWrite(pSockCtx)) && (0U == pSockCtx->constSent) && (pSockCtx->sendBuffer.length == pSockCtx->sendBuffer.outstandingDataLen))
     {
-        typeRmtAddr = WINC_TYPE_IPV6ADDR;
-        lenRmtAddr  = 16;
-        rmtAddr     = (uintptr_t)&pSockCtx->remoteEndPt.in6.sin6_addr;
-    }
-
-    (void)WINC_CmdSOCKBR(cmdReqHandle, pSockCtx->sockId, typeRmtAddr, rmtAddr, lenRmtAddr, ntohs(pSockCtx->remoteEndPt.sin_port));
+        /* Nothing could be written and nothing is in flight to retry it. */
+        pSockCtx->pConstData = NULL;
 
-    if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
-    {
-        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
         sockUnlockSocket(pSockCtx);
-        errno = EBADMSG;
+        errno = ENOMEM;
         return -1;
     }
 
     sockUnlockSocket(pSockCtx);
-    errno = EINPROGRESS;
-    return -1;
+    return 0;
 }
 
 /*****************************************************************************
@@ -4372,8 +7842,6 @@ int WINC_SOCK_NS(connect)(int fd, const struct sockaddr *addr, socklen_t len)
     buf   - Pointer to buffer to receive data.
     len   - Length of data to receive.
     flags - Option for reception, currently ignored.
-    addr  - Pointer to a structure to receive the peer address.
-    alen  - Pointer to length of address structure.
 
   Returns:
     The number of bytes received or -1 for error, see errno.
@@ -4393,12 +7861,39 @@ int WINC_SOCK_NS(connect)(int fd, const struct sockaddr *addr, socklen_t len)
 
  *****************************************************************************/
 
-ssize_t WINC_SOCK_NS(recvfrom)(int fd, void *buf, size_t len, int flags, struct sockaddr *addr, socklen_t *alen)
+ssize_t WINC_SOCK_NS(recv)(int fd, void *buf, size_t len, int flags)
+{
+    return WINC_SOCK_NS(recvfrom)(fd, buf, len, flags, NULL, NULL);
+}
+
+/*****************************************************************************
+  Description:
+    Send a message on a socket from an I/O vector list.
+
+  Parameters:
+    fd     - Socket file descriptor.
+    pIov   - Pointer to I/O vector list containing data to send.
+    iovCnt - Number of I/O vectors.
+    flags  - Option for transmission, MSG_MORE for stream sockets.
+    addr   - Pointer to address structure.
+    alen   - Length of address structure.
+    flush  - Flag indicating if the data should be written to the device now.
+
+  Returns:
+    The number of bytes sent or -1 for error, see errno.
+
+  Remarks:
+    Common implementation of sendto, sendmsg and writev. The data is gathered
+    directly into the socket send buffer. If flush is false the data is only
+    queued, allowing several messages to be written in one command request.
+
+ *****************************************************************************/
+
+static ssize_t sockSendv(int fd, const struct iovec *pIov, int iovCnt, int flags, const struct sockaddr *addr, socklen_t alen, bool flush)
 {
     WINC_SOCK_CTX *pSockCtx = WINC_SOCK_HANDLE_TO_PTR(fd);
-    ssize_t recvLen;
-    size_t lenRemain = 0;
-    socklen_t addrLen = 0;
+    const SOCKADDR_UNION *pDestAddr = NULL;
+    size_t len;
 
     if (NULL == pSockCtx)
     {
@@ -4406,6 +7901,12 @@ ssize_t WINC_SOCK_NS(recvfrom)(int fd, void *buf, size_t len, int flags, struct
         return -1;
     }
 
+    if (false == sockIovLength(pIov, iovCnt, &len))
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
     if (false == sockLockSocket(pSockCtx))
     {
         errno = EFAULT;
@@ -4419,153 +7920,159 @@ ssize_t WINC_SOCK_NS(recvfrom)(int fd, void *buf, size_t len, int flags, struct
         return -1;
     }
 
-    if (0U == pSockCtx->recvBuffer.length)
+    if (SOCK_DGRAM == pSockCtx->type)
     {
-        if ((SOCK_STREAM == pSockCtx->type) && (false == pSockCtx->connected))
+        if (NULL != addr)
         {
-            sockUnlockSocket(pSockCtx);
-            return 0;
-        }
+            if (AF_UNSPEC == pSockCtx->remoteEndPt.sin_family)
+            {
+                if (alen > sizeof(SOCKADDR_UNION))
+                {
+                    alen = sizeof(SOCKADDR_UNION);
+                }
 
-        if (WINC_SOCKET_ASYNC_MODE_OFF == (WINC_SOCKET_ASYNC_MODE_TYPE)pSockCtx->readMode)
-        {
-            (void)sockRead(pSockCtx);
-        }
+                (void)memset(&pSockCtx->remoteEndPt, 0, sizeof(SOCKADDR_UNION));
+                (void)memcpy(&pSockCtx->remoteEndPt, addr, alen);
 
-        sockUnlockSocket(pSockCtx);
-        errno = EWOULDBLOCK;
-        return -1;
-    }
+                if (false == sockAllocSocketBuffers(pSockCtx))
+                {
+                    sockUnlockSocket(pSockCtx);
+                    errno = ENOMEM;
+                    return -1;
+                }
+            }
 
-    if ((SOCK_DGRAM == pSockCtx->type) && (NULL != pSockCtx->recvBuffer.pUdpPktBuffers))
-    {
-        if (0U == pSockCtx->recvBuffer.pUdpPktBuffers->pktDepth)
-        {
-            sockUnlockSocket(pSockCtx);
-            errno = EWOULDBLOCK;
-            return -1;
-        }
+            if (alen < sizeof_sockaddr(addr))
+            {
+                sockUnlockSocket(pSockCtx);
+                errno = EDESTADDRREQ;
+                return -1;
+            }
 
-        if (NULL != alen)
+            pDestAddr = (const SOCKADDR_UNION*)(const void*)addr;
+        }
+        else
         {
-            addrLen = *alen;
-
-            if (addrLen > sizeof(SOCKADDR_UNION))
+            if (false == pSockCtx->connected)
             {
-                addrLen = sizeof(SOCKADDR_UNION);
+                sockUnlockSocket(pSockCtx);
+                errno = EDESTADDRREQ;
+                return -1;
             }
 
-            *alen = addrLen;
+            pDestAddr = &pSockCtx->remoteEndPt;
         }
     }
-    else if (NULL != alen)
-    {
-        *alen = 0;
-    }
     else
     {
-    }
+        if (false == pSockCtx->connected)
+        {
+            sockUnlockSocket(pSockCtx);
+            errno = ENOTCONN;
+            return -1;
+        }
 
-    recvLen = sockBufferRead(&pSockCtx->recvBuffer, buf, len, addr, addrLen, ((unsigned)flags & MSG_PEEK) ? true : false, &lenRemain);
+        /* Data sent now must follow the constant payload. */
+        if (NULL != pSockCtx->pConstData)
+        {
+            sockUnlockSocket(pSockCtx);
+            errno = EWOULDBLOCK;
+            return -1;
+        }
+    }
 
-    if (-1 == recvLen)
+#ifdef WINC_SOCK_BUF_AUTOTUNE_ENABLE
+    if ((SOCK_STREAM == pSockCtx->type) && (len > pSockCtx->sendBuffer.totalSize))
     {
-        errno = EFAULT;
+        /* The data could never fit in the send buffer, grow it. */
+        (void)sockBufTuneGrow(pSockCtx, &pSockCtx->sendBuffer, len, WINC_SOCK_BUF_TX_MAX_SZ);
     }
+#endif
 
-    if ((len > 0U) && (0 == recvLen))
+    if ((pSockCtx->sendBuffer.length + len) > pSockCtx->sendBuffer.totalSize)
     {
-        if (false == pSockCtx->connected)
+#ifdef WINC_SOCK_BUF_AUTOTUNE_ENABLE
+        /* The application is waiting for space while the buffer is filled with
+           data in flight to the device. */
+        if ((SOCK_STREAM == pSockCtx->type) && ((pSockCtx->sendBuffer.length - pSockCtx->sendBuffer.outstandingDataLen) < MAX_TCP_SOCK_PAYLOAD_SZ))
         {
-            sockUnlockSocket(pSockCtx);
-            return 0;
+            pSockCtx->sendBuffer.tuneLimited = true;
+            pSockCtx->sendBuffer.tuneStarved = true;
         }
+#endif
 
+        (void)sockWrite(pSockCtx);
         sockUnlockSocket(pSockCtx);
         errno = EWOULDBLOCK;
         return -1;
     }
 
-    if (0U != ((unsigned)flags & MSG_TRUNC))
+    if ((SOCK_DGRAM == pSockCtx->type) && (NULL != pSockCtx->sendBuffer.pUdpPktBuffers))
     {
-        if (SOCK_DGRAM == pSockCtx->type)
+        size_t maxLen;
+
+        if (AF_INET == pSockCtx->remoteEndPt.sin_family)
         {
-            recvLen = (len + lenRemain);
+            maxLen = MAX_UDP_IPV4_SOCK_PAYLOAD_SZ;
         }
         else
         {
-            recvLen = lenRemain;
+            maxLen = MAX_UDP_IPV6_SOCK_PAYLOAD_SZ;
         }
-    }
 
-    WINC_TRACE_PRINT("RV %d\n", recvLen);
+        if (len > maxLen)
+        {
+            sockUnlockSocket(pSockCtx);
+            errno = EMSGSIZE;
+            return -1;
+        }
+    }
 
-    if ((0U == ((unsigned)flags & MSG_PEEK)) && (recvLen > 0))
+    if (SOCK_STREAM == pSockCtx->type)
     {
-        if (WINC_SOCKET_ASYNC_MODE_OFF == (WINC_SOCKET_ASYNC_MODE_TYPE)pSockCtx->readMode)
+        /* Start the cork timer when the first held data is written. */
+        if (pSockCtx->sendBuffer.length == pSockCtx->sendBuffer.outstandingDataLen)
         {
-            (void)sockRead(pSockCtx);
+#ifdef WINC_SOCK_CORK_TIMEOUT_ENABLE
+            pSockCtx->corkTime = WINC_CONF_TIME_MS_GET();
+#endif
         }
-        else if (WINC_SOCKET_ASYNC_MODE_ACKED == (WINC_SOCKET_ASYNC_MODE_TYPE)pSockCtx->readMode)
-        {
-            pSockCtx->nextSeqNum += (uint16_t)recvLen;
-
-            if (false == pSockCtx->seqNumUpdateSent)
-            {
-                WINC_CMD_REQ_HANDLE cmdReqHandle;
-                void *pCmdReqBuffer;
-
-                pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, 128);
-
-                if (NULL == pCmdReqBuffer)
-                {
-                    sockUnlockSocket(pSockCtx);
-                    return -1;
-                }
-
-                cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, 128, 1, sockCmdRspCallbackHandlerSeqUpdate, (uintptr_t)pSockCtx);
 
-                if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
-                {
-                    sockUnlockSocket(pSockCtx);
-                    slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
-                    return -1;
-                }
+        pSockCtx->sendMore = (0U != ((unsigned)flags & MSG_MORE)) ? true : false;
+    }
 
-                (void)WINC_CmdSOCKC(cmdReqHandle, pSockCtx->sockId, WINC_CFG_PARAM_ID_SOCK_ASYNC_NEXT_SN, WINC_TYPE_INTEGER_UNSIGNED, pSockCtx->nextSeqNum, 0);
+    if (false == sockBufferWritev(&pSockCtx->sendBuffer, pIov, len, pDestAddr, false))
+    {
+        sockUnlockSocket(pSockCtx);
+        errno = EWOULDBLOCK;
+        return -1;
+    }
 
-                if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
-                {
-                    sockUnlockSocket(pSockCtx);
-                    slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
-                    return -1;
-                }
+    WINC_TRACE_PRINT("SND %d\n", len);
 
-                pSockCtx->seqNumUpdateSent = true;
-            }
-        }
-        else
-        {
-        }
+    if (true == flush)
+    {
+        (void)sockWrite(pSockCtx);
     }
 
     sockUnlockSocket(pSockCtx);
-    return recvLen;
+    return (ssize_t)len;
 }
 
 /*****************************************************************************
   Description:
-    Receive a message from a socket.
+    Send a message on a socket.
 
   Parameters:
     fd    - Socket file descriptor.
-    buf   - Pointer to buffer to receive data.
-    len   - Length of data to receive.
-    flags - Option for reception, currently ignored.
+    buf   - Pointer to buffer containing data to send.
+    len   - Length of data to send.
+    flags - Option for transmission, MSG_MORE for stream sockets.
+    addr  - Pointer to address structure.
+    alen  - Length of address structure.
 
   Returns:
-    The number of bytes received or -1 for error, see errno.
-    If the return value is 0, the socket has performed an orderly shutdown.
+    The number of bytes sent or -1 for error, see errno.
 
   Remarks:
     errno:
@@ -4576,14 +8083,27 @@ ssize_t WINC_SOCK_NS(recvfrom)(int fd, void *buf, size_t len, int flags, struct
         ENOTSOCK
             The file descriptor fd does not refer to a socket.
         EWOULDBLOCK
-            The socket is marked nonblocking and the receive operation
+            The socket is marked nonblocking and the send operation
             would block.
+        ENOMEM
+            Insufficient memory is available.
+        EMSGSIZE
+            The argument data is too long to pass atomically through the underlying protocol
+        EDESTADDRREQ
+            The socket is not connection-mode, and no peer address is set.
+        ENOTCONN
+            The socket is not connected, and no target has been given.
 
  *****************************************************************************/
 
-ssize_t WINC_SOCK_NS(recv)(int fd, void *buf, size_t len, int flags)
+ssize_t WINC_SOCK_NS(sendto)(int fd, const void *buf, size_t len, int flags, const struct sockaddr *addr, socklen_t alen)
 {
-    return WINC_SOCK_NS(recvfrom)(fd, buf, len, flags, NULL, NULL);
+    struct iovec iov;
+
+    iov.iov_base = (void*)buf;
+    iov.iov_len  = len;
+
+    return sockSendv(fd, &iov, 1, flags, addr, alen, true);
 }
 
 /*****************************************************************************
@@ -4592,21 +8112,23 @@ ssize_t WINC_SOCK_NS(recv)(int fd, void *buf, size_t len, int flags)
 
   Parameters:
     fd    - Socket file descriptor.
-    buf   - Pointer to buffer containing data to send.
-    len   - Length of data to send.
-    flags - Option for transmission, currently ignored.
-    addr  - Pointer to address structure.
-    alen  - Length of address structure.
+    msg   - Pointer to message header describing the data to send.
+    flags - Option for transmission, MSG_MORE for stream sockets.
 
   Returns:
     The number of bytes sent or -1 for error, see errno.
 
   Remarks:
+    The data in the I/O vectors of msg_iov is gathered in order into a single
+    stream write or datagram. Ancillary data is not supported.
+
     errno:
         EBADF
             The argument fd is not a valid file descriptor.
         EFAULT
             System fault.
+        EINVAL
+            The message header or I/O vector list is invalid.
         ENOTSOCK
             The file descriptor fd does not refer to a socket.
         EWOULDBLOCK
@@ -4623,125 +8145,136 @@ ssize_t WINC_SOCK_NS(recv)(int fd, void *buf, size_t len, int flags)
 
  *****************************************************************************/
 
-ssize_t WINC_SOCK_NS(sendto)(int fd, const void *buf, size_t len, int flags, const struct sockaddr *addr, socklen_t alen)
+ssize_t WINC_SOCK_NS(sendmsg)(int fd, const struct msghdr *msg, int flags)
 {
-    WINC_SOCK_CTX *pSockCtx = WINC_SOCK_HANDLE_TO_PTR(fd);
-    const SOCKADDR_UNION *pDestAddr = NULL;
-
-    if (NULL == pSockCtx)
+    if (NULL == msg)
     {
-        errno = EBADF;
+        errno = EINVAL;
         return -1;
     }
 
-    if (false == sockLockSocket(pSockCtx))
-    {
-        errno = EFAULT;
-        return -1;
-    }
+    return sockSendv(fd, msg->msg_iov, msg->msg_iovlen, flags, msg->msg_name, (NULL != msg->msg_name) ? msg->msg_namelen : 0U, true);
+}
 
-    if (0U == pSockCtx->sockId)
-    {
-        sockUnlockSocket(pSockCtx);
-        errno = ENOTSOCK;
-        return -1;
-    }
+/*****************************************************************************
+  Description:
+    Write data to a socket from multiple buffers.
 
-    if (SOCK_DGRAM == pSockCtx->type)
-    {
-        if (NULL != addr)
-        {
-            if (AF_UNSPEC == pSockCtx->remoteEndPt.sin_family)
-            {
-                if (alen > sizeof(SOCKADDR_UNION))
-                {
-                    alen = sizeof(SOCKADDR_UNION);
-                }
+  Parameters:
+    fd     - Socket file descriptor.
+    iov    - Pointer to I/O vector list containing data to send.
+    iovcnt - Number of I/O vectors.
 
-                (void)memset(&pSockCtx->remoteEndPt, 0, sizeof(SOCKADDR_UNION));
-                (void)memcpy(&pSockCtx->remoteEndPt, addr, alen);
+  Returns:
+    The number of bytes sent or -1 for error, see errno.
 
-                if (false == sockAllocSocketBuffers(pSockCtx))
-                {
-                    sockUnlockSocket(pSockCtx);
-                    errno = ENOMEM;
-                    return -1;
-                }
-            }
+  Remarks:
+    Equivalent to sendmsg with no address and no flags.
 
-            if (alen < sizeof_sockaddr(addr))
-            {
-                sockUnlockSocket(pSockCtx);
-                errno = EDESTADDRREQ;
-                return -1;
-            }
+    errno:
+        See sendmsg.
 
-            pDestAddr = (const SOCKADDR_UNION*)(const void*)addr;
-        }
-        else
-        {
-            if (false == pSockCtx->connected)
-            {
-                sockUnlockSocket(pSockCtx);
-                errno = EDESTADDRREQ;
-                return -1;
-            }
+ *****************************************************************************/
 
-            pDestAddr = &pSockCtx->remoteEndPt;
-        }
-    }
-    else
+ssize_t WINC_SOCK_NS(writev)(int fd, const struct iovec *iov, int iovcnt)
+{
+    return sockSendv(fd, iov, iovcnt, 0, NULL, 0, true);
+}
+
+/*****************************************************************************
+  Description:
+    Send multiple messages on a socket.
+
+  Parameters:
+    fd     - Socket file descriptor.
+    msgvec - Pointer to array of message headers.
+    vlen   - Number of messages in msgvec.
+    flags  - Option for transmission, MSG_MORE for stream sockets.
+
+  Returns:
+    The number of messages sent or -1 for error, see errno.
+
+  Remarks:
+    All messages are queued in the socket send buffer before the device
+    write is started, for datagram sockets this allows consecutive
+    datagrams to be carried in a single command request. The number of
+    bytes sent for each message is stored in msg_len.
+
+    If an error occurs after at least one message has been sent the number
+    of messages sent is returned, otherwise -1 is returned.
+
+    errno:
+        See sendmsg.
+
+ *****************************************************************************/
+
+int WINC_SOCK_NS(sendmmsg)(int fd, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+    WINC_SOCK_CTX *pSockCtx = WINC_SOCK_HANDLE_TO_PTR(fd);
+    unsigned int numSent = 0;
+
+    if (0U == vlen)
     {
-        if (false == pSockCtx->connected)
-        {
-            sockUnlockSocket(pSockCtx);
-            errno = ENOTCONN;
-            return -1;
-        }
+        return 0;
     }
 
-    if ((pSockCtx->sendBuffer.length + len) > pSockCtx->sendBuffer.totalSize)
+    if (NULL == msgvec)
     {
-        (void)sockWrite(pSockCtx);
-        sockUnlockSocket(pSockCtx);
-        errno = EWOULDBLOCK;
+        errno = EINVAL;
         return -1;
     }
 
-    if ((SOCK_DGRAM == pSockCtx->type) && (NULL != pSockCtx->sendBuffer.pUdpPktBuffers))
+    if (vlen > (unsigned int)INT_MAX)
     {
-        size_t maxLen;
+        vlen = (unsigned int)INT_MAX;
+    }
 
-        if (AF_INET == pSockCtx->remoteEndPt.sin_family)
-        {
-            maxLen = MAX_UDP_IPV4_SOCK_PAYLOAD_SZ;
-        }
-        else
+    while (numSent < vlen)
+    {
+        const struct msghdr *pMsg = &msgvec[numSent].msg_hdr;
+        ssize_t sendLen;
+
+        sendLen = sockSendv(fd, pMsg->msg_iov, pMsg->msg_iovlen, flags, pMsg->msg_name, (NULL != pMsg->msg_name) ? pMsg->msg_namelen : 0U, false);
+
+        if (sendLen < 0)
         {
-            maxLen = MAX_UDP_IPV6_SOCK_PAYLOAD_SZ;
+            break;
         }
 
-        if (len > maxLen)
+        msgvec[numSent].msg_len = (unsigned int)sendLen;
+        numSent++;
+    }
+
+    if ((numSent > 0U) && (NULL != pSockCtx) && (true == sockLockSocket(pSockCtx)))
+    {
+        if (0U != pSockCtx->sockId)
         {
-            sockUnlockSocket(pSockCtx);
-            errno = EMSGSIZE;
-            return -1;
+            if ((SOCK_DGRAM == pSockCtx->type) && (NULL != pSockCtx->sendBuffer.pUdpPktBuffers))
+            {
+                /* Write all queued datagrams, each write carries a batch of datagrams. */
+                while (pSockCtx->udpUnackedPktBufs < pSockCtx->sendBuffer.pUdpPktBuffers->pktDepth)
+                {
+                    if (false == sockWrite(pSockCtx))
+                    {
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                (void)sockWrite(pSockCtx);
+            }
         }
+
+        sockUnlockSocket(pSockCtx);
     }
 
-    if (false == sockBufferWrite(&pSockCtx->sendBuffer, buf, len, pDestAddr, false))
+    if (0U == numSent)
     {
-        sockUnlockSocket(pSockCtx);
-        errno = EWOULDBLOCK;
         return -1;
     }
 
-    WINC_TRACE_PRINT("SND %d\n", len);
-
-    (void)sockWrite(pSockCtx);
-
-    sockUnlockSocket(pSockCtx);
-    return (ssize_t)len;
+    return (int)numSent;
 }
 
 /*****************************************************************************
@@ -4752,7 +8285,7 @@ ssize_t WINC_SOCK_NS(sendto)(int fd, const void *buf, size_t len, int flags, con
     fd    - Socket file descriptor.
     buf   - Pointer to buffer containing data to send.
     len   - Length of data to send.
-    flags - Option for transmission, currently ignored.
+    flags - Option for transmission, MSG_MORE for stream sockets.
 
   Returns:
     The number of bytes sent or -1 for error, see errno.
@@ -4775,11 +8308,154 @@ ssize_t WINC_SOCK_NS(sendto)(int fd, const void *buf, size_t len, int flags, con
         ENOTCONN
             The socket is not connected, and no target has been given.
 
- *****************************************************************************/
+ *****************************************************************************/
+
+ssize_t WINC_SOCK_NS(send)(int fd, const void *buf, size_t len, int flags)
+{
+    return WINC_SOCK_NS(sendto)(fd, buf, len, flags, NULL, 0);
+}
+
+/*****************************************************************************
+  Description:
+    Find or start a DNS request.
+
+  Parameters:
+    host         - Pointer to host to translate.
+    hint         - Hint to affect the translation.
+    ppDnsRequest - Pointer to location to store the request pointer.
+
+  Returns:
+    0 if the request is complete, EAI_AGAIN if it is in progress, or
+    an EAI_* error code.
+
+  Remarks:
+    EAI_AGAIN with a NULL request pointer indicates no request could be
+    started because the request table is full, or a request for the same
+    host with a different record type is in progress.
+
+    Requests whose result can no longer be returned are restarted, see
+    dnsRequestValid.
+
+ *****************************************************************************/
+
+static int dnsLookup(const char *host, const struct addrinfo *hint, WINC_DNS_REQ **ppDnsRequest)
+{
+    WINC_DNS_REQ *pDnsRequest;
+    WINC_DNS_REQ **ppFreeRequest;
+    WINC_CMD_REQ_HANDLE cmdReqHandle;
+    void *pCmdReqBuffer;
+    size_t hostNameLen;
+    uint8_t recordType = WINC_CONST_DNS_TYPE_ANY;
+
+    *ppDnsRequest = NULL;
+
+    hostNameLen = strnlen(host, 256);
+
+    if (0U == hostNameLen)
+    {
+        return EAI_NONAME;
+    }
+
+    if (NULL != hint)
+    {
+        if (AF_INET == (unsigned)hint->ai_family)
+        {
+            recordType = WINC_CONST_DNS_TYPE_A;
+        }
+        else if (AF_INET6 == (unsigned)hint->ai_family)
+        {
+            recordType = WINC_CONST_DNS_TYPE_AAAA;
+        }
+        else
+        {
+            return EAI_FAMILY;
+        }
+    }
+
+    pDnsRequest = dnsFindRequest((const uint8_t*)host, hostNameLen, (int)recordType);
+
+    if (NULL != pDnsRequest)
+    {
+        *ppDnsRequest = pDnsRequest;
+
+        if (0xFFFFU == pDnsRequest->reqStatus)
+        {
+            return EAI_AGAIN;
+        }
+
+        if (true == dnsRequestValid(pDnsRequest))
+        {
+            return 0;
+        }
+
+        /* Expired entry, replace it with a new request. */
+        dnsFreeRequest(pDnsRequest);
+
+        *ppDnsRequest = NULL;
+    }
+
+    /* The device matches responses by host name, so only one request per
+       host may be in progress. */
+    pDnsRequest = dnsFindRequest((const uint8_t*)host, hostNameLen, -1);
+
+    if ((NULL != pDnsRequest) && (0xFFFFU == pDnsRequest->reqStatus))
+    {
+        return EAI_AGAIN;
+    }
+
+    ppFreeRequest = dnsFindFreeRequest();
+
+    if (NULL == ppFreeRequest)
+    {
+        return EAI_AGAIN;
+    }
+
+    pDnsRequest = dnsAllocRequest(hostNameLen);
+
+    if (NULL == pDnsRequest)
+    {
+        return EAI_MEMORY;
+    }
+
+    (void)memcpy(pDnsRequest->hostName, host, hostNameLen);
+    pDnsRequest->hostNameLen = hostNameLen;
+    pDnsRequest->recordType  = recordType;
+
+    pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, WINC_SOCK_CMD_REQ_SZ(128U+hostNameLen, 1));
+
+    if (NULL == pCmdReqBuffer)
+    {
+        dnsFreeRequest(pDnsRequest);
+        return EAI_MEMORY;
+    }
+
+    cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, WINC_SOCK_CMD_REQ_SZ(128U+hostNameLen, 1), 1, dnsCmdRspCallbackHandler, (uintptr_t)pDnsRequest);
+
+    if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
+    {
+        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+        dnsFreeRequest(pDnsRequest);
+        errno = EBADMSG;
+        return EAI_SYSTEM;
+    }
+
+    (void)WINC_CmdDNSRESOLV(cmdReqHandle, pDnsRequest->recordType, pDnsRequest->hostName, pDnsRequest->hostNameLen);
+
+    /* Add to the request table before transmission, the response callback
+       may be called before transmission returns. */
+    *ppFreeRequest = pDnsRequest;
+
+    if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
+    {
+        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+        dnsFreeRequest(pDnsRequest);
+        errno = EBADMSG;
+        return EAI_SYSTEM;
+    }
+
+    *ppDnsRequest = pDnsRequest;
 
-ssize_t WINC_SOCK_NS(send)(int fd, const void *buf, size_t len, int flags)
-{
-    return WINC_SOCK_NS(sendto)(fd, buf, len, flags, NULL, 0);
+    return EAI_AGAIN;
 }
 
 /*****************************************************************************
@@ -4807,11 +8483,19 @@ ssize_t WINC_SOCK_NS(send)(int fd, const void *buf, size_t len, int flags)
         The requested service is not available for the requested socket type.
 
   Remarks:
+    Up to WINC_SOCK_DNS_NUM_REQS requests for different hosts may be in
+    progress at once, EAI_AGAIN is returned until the request completes.
+    Completed requests are held as cache entries, a cached result is
+    returned without a new request until it expires. Names which did not
+    resolve are cached as failures for a shorter time.
+
     errno:
         EFAULT
             System fault.
         EBADMSG
             Bad message.
+        ETIMEDOUT
+            The DNS request timed out.
 
     The getaddrinfo() function allocates and initializes a linked
     list of addrinfo structures, one for each network address that
@@ -4827,124 +8511,65 @@ ssize_t WINC_SOCK_NS(send)(int fd, const void *buf, size_t len, int flags)
 int WINC_SOCK_NS(getaddrinfo)(const char *host, const char *serv, const struct addrinfo *hint, struct addrinfo **res)
 {
     WINC_DNS_REQ *pDnsRequest;
+    int result;
 
     if (NULL != host)
     {
-        WINC_CMD_REQ_HANDLE cmdReqHandle;
-        void *pCmdReqBuffer;
-        size_t hostNameLen;
-
-        hostNameLen = strnlen(host, 256);
+        result = dnsLookup(host, hint, &pDnsRequest);
 
-        if (0U == hostNameLen)
+        if (0 != result)
         {
-            return EAI_NONAME;
+            return result;
         }
 
-        if (NULL != pCurrentDnsRequest)
+        pDnsRequest->fetched = true;
+
+        if (WINC_STATUS_OK != pDnsRequest->reqStatus)
         {
-            if ((hostNameLen == pCurrentDnsRequest->hostNameLen) && (0 == memcmp(host, pCurrentDnsRequest->hostName, pCurrentDnsRequest->hostNameLen)))
+            if (WINC_STATUS_DNS_TIMEOUT == pDnsRequest->reqStatus)
             {
-                if (NULL == pCurrentDnsRequest->pRes)
-                {
-                    if (0xFFFFU != pCurrentDnsRequest->reqStatus)
-                    {
-                        if (WINC_STATUS_DNS_TIMEOUT == pCurrentDnsRequest->reqStatus)
-                        {
-                            errno = ETIMEDOUT;
-                        }
-                        else
-                        {
-                            errno = EFAULT;
-                        }
-
-                        dnsFreeRequest(pCurrentDnsRequest);
-                        pCurrentDnsRequest = NULL;
-
-                        return EAI_SYSTEM;
-                    }
-
-                    return EAI_AGAIN;
-                }
-                else if (NULL != res)
-                {
-                    *res = pCurrentDnsRequest->pRes;
-                    return 0;
-                }
-                else
-                {
-                    dnsFreeRequest(pCurrentDnsRequest);
-                    pCurrentDnsRequest = NULL;
-
-                    errno = EFAULT;
-                    return EAI_SYSTEM;
-                }
+                errno = ETIMEDOUT;
             }
             else
             {
-                return EAI_AGAIN;
+                errno = EFAULT;
             }
-        }
-
-        pDnsRequest = dnsAllocRequest(hostNameLen);
 
-        if (NULL == pDnsRequest)
-        {
-            return EAI_MEMORY;
-        }
-
-        pCurrentDnsRequest = pDnsRequest;
-
-        (void)memcpy(pDnsRequest->hostName, host, hostNameLen);
-        pDnsRequest->hostNameLen = hostNameLen;
-        pDnsRequest->recordType  = WINC_CONST_DNS_TYPE_ANY;
-
-        if (NULL != hint)
-        {
-            if (AF_INET == (unsigned)hint->ai_family)
-            {
-                pDnsRequest->recordType = WINC_CONST_DNS_TYPE_A;
-            }
-            else if (AF_INET6 == (unsigned)hint->ai_family)
-            {
-                pDnsRequest->recordType = WINC_CONST_DNS_TYPE_AAAA;
-            }
-            else
+            if (true == dnsRequestExpired(pDnsRequest))
             {
                 dnsFreeRequest(pDnsRequest);
-                return EAI_FAMILY;
             }
-        }
-
-        pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, 128U+hostNameLen);
 
-        if (NULL == pCmdReqBuffer)
-        {
-            dnsFreeRequest(pDnsRequest);
-            return EAI_MEMORY;
+            return EAI_SYSTEM;
         }
 
-        cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, 128U+hostNameLen, 1, dnsCmdRspCallbackHandler, (uintptr_t)pDnsRequest);
-
-        if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
+        if ((NULL == res) || (NULL == pDnsRequest->pRes))
         {
-            slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
             dnsFreeRequest(pDnsRequest);
-            errno = EBADMSG;
+
+            errno = EFAULT;
             return EAI_SYSTEM;
         }
 
-        (void)WINC_CmdDNSRESOLV(cmdReqHandle, pDnsRequest->recordType, pDnsRequest->hostName, pDnsRequest->hostNameLen);
-
-        if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
+        if (true == dnsRequestExpired(pDnsRequest))
         {
-            slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+            /* Not cached, pass the results to the caller. */
+            *res = pDnsRequest->pRes;
+
+            pDnsRequest->pRes = NULL;
             dnsFreeRequest(pDnsRequest);
-            errno = EBADMSG;
-            return EAI_SYSTEM;
         }
+        else
+        {
+            *res = dnsCopyResult(pDnsRequest->pRes);
 
-        return EAI_AGAIN;
+            if (NULL == *res)
+            {
+                return EAI_MEMORY;
+            }
+        }
+
+        return 0;
     }
 
     if (NULL != serv)
@@ -4972,17 +8597,80 @@ int WINC_SOCK_NS(getaddrinfo)(const char *host, const char *serv, const struct a
 
 void WINC_SOCK_NS(freeaddrinfo)(struct addrinfo *p)
 {
-    if (NULL == p)
+    struct addrinfo *pNext;
+
+    if (NULL == initData.pfMemFree)
     {
         return;
     }
 
-    if (p == pCurrentDnsRequest->pRes)
+    while (NULL != p)
+    {
+        pNext = p->ai_next;
+        initData.pfMemFree(p);
+        p = pNext;
+    }
+}
+
+/*****************************************************************************
+  Description:
+    Start an asynchronous network address translation.
+
+  Parameters:
+    host       - Pointer to host to translate.
+    hint       - Hint to affect the translation.
+    pfComplete - Completion callback.
+    context    - Context passed to the completion callback.
+
+  Returns:
+    0 if the result is already available, EAI_AGAIN if the request is in
+    progress, or an EAI_* error code as for getaddrinfo().
+
+  Remarks:
+    When EAI_AGAIN is returned the completion callback is called once the
+    request completes, the result is then collected with getaddrinfo().
+    The result is held until collected, but like any cache entry a
+    successful or unresolved result is discarded once it expires.
+    When 0 is returned the result, or a cached failure, can be collected
+    immediately and the callback is not called.
+
+    errno:
+        EBUSY
+            The request table is full, a request for the same host with a
+            different address family is in progress or a completion
+            callback is already registered for the request.
+        EBADMSG
+            Bad message.
+
+ *****************************************************************************/
+
+int WINC_SockGetAddrInfoAsync(const char *host, const struct addrinfo *hint, WINC_SOCK_DNS_CALLBACK pfComplete, uintptr_t context)
+{
+    WINC_DNS_REQ *pDnsRequest;
+    int result;
+
+    if (NULL == host)
+    {
+        return EAI_NONAME;
+    }
+
+    result = dnsLookup(host, hint, &pDnsRequest);
+
+    if (EAI_AGAIN != result)
     {
-        dnsFreeRequest(pCurrentDnsRequest);
+        return result;
+    }
 
-        pCurrentDnsRequest = NULL;
+    if ((NULL == pDnsRequest) || (NULL != pDnsRequest->pfComplete))
+    {
+        errno = EBUSY;
+        return EAI_SYSTEM;
     }
+
+    pDnsRequest->pfComplete  = pfComplete;
+    pDnsRequest->completeCtx = context;
+
+    return EAI_AGAIN;
 }
 
 /*****************************************************************************
@@ -5086,6 +8774,12 @@ void WINC_SOCK_NS(freeaddrinfo)(struct addrinfo *p)
             sending of small packets, which results in poor utilization of
             the network.
 
+        TCP_CORK
+            If set, hold written data in the socket send buffer instead of
+            passing each write to the device. Data is written once
+            WINC_SOCK_CORK_FLUSH_SZ bytes are held, the send buffer is full,
+            WINC_SOCK_CORK_TIMEOUT_MS elapses or the option is cleared.
+
 
         To set a TCP(TLS) socket option, call setsockopt to write the option with
         the option level argument set to IPPROTO_TLS.
@@ -5101,6 +8795,7 @@ int WINC_SOCK_NS(setsockopt)(int fd, int level, int optname, const void *optval,
     void *pCmdReqBuffer = NULL;
     WINC_SOCK_CTX *pSockCtx = WINC_SOCK_HANDLE_TO_PTR(fd);
     int locErrno = 0;
+    bool localOpt = false;
 
     if (NULL == pSockCtx)
     {
@@ -5114,7 +8809,7 @@ int WINC_SOCK_NS(setsockopt)(int fd, int level, int optname, const void *optval,
         return -1;
     }
 
-    pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, 256);
+    pCmdReqBuffer = slabAlloc(pGlobalSlabAllocCtx, WINC_SOCK_CMD_REQ_SZ(256, 2));
 
     if (NULL == pCmdReqBuffer)
     {
@@ -5123,7 +8818,7 @@ int WINC_SOCK_NS(setsockopt)(int fd, int level, int optname, const void *optval,
         return -1;
     }
 
-    cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, 256, 2, sockCmdRspCallbackHandler, (uintptr_t)pSockCtx);
+    cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, WINC_SOCK_CMD_REQ_SZ(256, 2), 2, sockCmdRspCallbackHandler, (uintptr_t)pSockCtx);
 
     if (WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle)
     {
@@ -5335,6 +9030,29 @@ int WINC_SOCK_NS(setsockopt)(int fd, int level, int optname, const void *optval,
                     break;
                 }
 
+                case TCP_CORK:
+                {
+                    if (sizeof(int) == optlen)
+                    {
+                        pSockCtx->corked = (0 != *((const int*)optval)) ? true : false;
+
+                        if (false == pSockCtx->corked)
+                        {
+                            /* Write any held data. */
+                            pSockCtx->sendMore = false;
+                            (void)sockWrite(pSockCtx);
+                        }
+
+                        localOpt = true;
+                        locErrno = 0;
+                    }
+                    else
+                    {
+                        locErrno = EINVAL;
+                    }
+                    break;
+                }
+
                 default:
                 {
                     WINC_TRACE_PRINT("Set socket, unknown TCP protocol option %d\n", optname);
@@ -5376,24 +9094,237 @@ int WINC_SOCK_NS(setsockopt)(int fd, int level, int optname, const void *optval,
     {
     }
 
-    if (0 != locErrno)
-    {
-        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
-        sockUnlockSocket(pSockCtx);
-        errno = locErrno;
-        return -1;
+    if ((0 != locErrno) || (true == localOpt))
+    {
+        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+        sockUnlockSocket(pSockCtx);
+
+        if (0 != locErrno)
+        {
+            errno = locErrno;
+            return -1;
+        }
+
+        return 0;
+    }
+
+    if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
+    {
+        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
+        sockUnlockSocket(pSockCtx);
+        errno = EBADMSG;
+        return -1;
+    }
+
+    sockUnlockSocket(pSockCtx);
+    return 0;
+}
+
+/*****************************************************************************
+  Description:
+    Check a set of file descriptors for events.
+
+  Parameters:
+    context - Pointer to WINC_SOCK_POLL_SCAN arguments
+
+  Returns:
+    Number of elements in fds with revents set, or -1 on error.
+
+  Remarks:
+    See poll().
+
+ *****************************************************************************/
+
+static int sockPollScan(uintptr_t context)
+{
+    const WINC_SOCK_POLL_SCAN *pScan = (const WINC_SOCK_POLL_SCAN*)context;
+    struct pollfd *fds = pScan->fds;
+    int nfdsSet = 0;
+    nfds_t i;
+
+    for (i=0; i<pScan->nfds; i++)
+    {
+        WINC_SOCK_CTX *pSockCtx;
+
+        fds[i].revents = 0;
+
+        if (fds[i].fd < 0)
+        {
+            continue;
+        }
+
+        pSockCtx = WINC_SOCK_HANDLE_TO_PTR(fds[i].fd);
+
+        if ((pSockCtx < &wincSockets[0]) || (pSockCtx >= &wincSockets[WINC_SOCK_NUM_SOCKETS]) || (false == pSockCtx->inUse))
+        {
+            fds[i].revents |= POLLNVAL;
+        }
+        else
+        {
+            if (false == sockLockSocket(pSockCtx))
+            {
+                errno = EFAULT;
+                return -1;
+            }
+
+            fds[i].revents |= sockPollEvents(pSockCtx, fds[i].events);
+
+            sockUnlockSocket(pSockCtx);
+        }
+
+        if (0 != fds[i].revents)
+        {
+            nfdsSet++;
+        }
+    }
+
+    return nfdsSet;
+}
+
+/*****************************************************************************
+  Description:
+    Wait for a socket state change.
+
+  Parameters:
+    eventCount - Socket state change count when the sockets were last checked
+    waitTime   - Maximum time to wait in milliseconds, or -1 to wait forever
+
+  Returns:
+    None.
+
+  Remarks:
+    May return early, the caller must re-check its sockets.
+
+ *****************************************************************************/
+
+static void sockPollWait(uint32_t eventCount, int waitTime)
+{
+#ifdef WINC_SOCK_POLL_SEM_ENABLE
+    /* Only block if no socket has changed state since the last check, a
+       state change after this point will post the semaphore. */
+    if (eventCount == pollEventCount)
+    {
+        WINC_CONF_SEM_WAIT(&pollSemaphore, (waitTime < 0) ? WINC_SOCK_POLL_WAIT_FOREVER : (uint32_t)waitTime);
+    }
+
+    /* A state change only posts the semaphore once, pass it on to any other
+       waiting thread. */
+    if ((eventCount != pollEventCount) && (numPollWaiters > 1U))
+    {
+        WINC_CONF_SEM_POST(&pollSemaphore);
+    }
+#else
+    if ((eventCount == pollEventCount) && (NULL != pfPollIdleCallback))
+    {
+        pfPollIdleCallback(pollIdleCallbackContext, waitTime);
+    }
+#endif
+}
+
+/*****************************************************************************
+  Description:
+    Wait for sockets to become ready.
+
+  Parameters:
+    timeout - Number of milliseconds to wait, a negative value waits
+                indefinitely
+    pfScan  - Function to check the sockets of interest
+    context - Arguments passed to pfScan
+
+  Returns:
+    Result of the last call to pfScan, zero if the timeout expired, or -1
+    on error, see errno.
+
+  Remarks:
+    Shared by poll() and WINC_SockEpollWait, pfScan is called until it finds
+    something or the timeout expires. Waiting uses the WINC_CONF_SEM_*
+    semaphore if configured, otherwise the poll idle callback.
+
+    errno:
+        EINVAL
+            A non-zero timeout was requested but there is no means to wait,
+            or a finite timeout was requested but WINC_CONF_TIME_MS_GET is
+            not configured.
+
+ *****************************************************************************/
+
+static int sockWaitReady(int timeout, WINC_SOCK_WAIT_SCAN_FP pfScan, uintptr_t context)
+{
+    int numReady;
+#ifdef WINC_SOCK_POLL_TIMEOUT_ENABLE
+    uint32_t startTime = 0;
+#endif
+
+    if (0 != timeout)
+    {
+#ifndef WINC_SOCK_POLL_SEM_ENABLE
+        if (NULL == pfPollIdleCallback)
+        {
+            errno = EINVAL;
+            return -1;
+        }
+#endif
+
+#ifdef WINC_SOCK_POLL_TIMEOUT_ENABLE
+        startTime = WINC_CONF_TIME_MS_GET();
+#else
+        if (timeout > 0)
+        {
+            errno = EINVAL;
+            return -1;
+        }
+#endif
+
+#ifdef WINC_SOCK_POLL_SEM_ENABLE
+        numPollWaiters++;
+#endif
+    }
+
+    while (true)
+    {
+        uint32_t eventCount = pollEventCount;
+        int waitTime = -1;
+
+        numReady = pfScan(context);
+
+        if ((0 != numReady) || (0 == timeout))
+        {
+            break;
+        }
+
+#ifdef WINC_SOCK_POLL_TIMEOUT_ENABLE
+        if (timeout > 0)
+        {
+            uint32_t elapsedTime = WINC_CONF_TIME_MS_GET() - startTime;
+
+            if (elapsedTime >= (uint32_t)timeout)
+            {
+                break;
+            }
+
+            waitTime = timeout - (int)elapsedTime;
+        }
+#endif
+
+#if defined(WINC_SOCK_CORK_TIMEOUT_ENABLE) && !defined(WINC_SOCK_POLL_SEM_ENABLE)
+        /* The idle callback runs the driver tasks, don't let it sleep past a cork timeout. */
+        if ((sockMapNext(sockCorkMap, 0) >= 0) && ((waitTime < 0) || (waitTime > (int)WINC_SOCK_CORK_TIMEOUT_MS)))
+        {
+            waitTime = (int)WINC_SOCK_CORK_TIMEOUT_MS;
+        }
+#endif
+
+        sockPollWait(eventCount, waitTime);
     }
 
-    if (false == WINC_DevTransmitCmdReq(wincDevHandle, cmdReqHandle))
+#ifdef WINC_SOCK_POLL_SEM_ENABLE
+    if (0 != timeout)
     {
-        slabFree(pGlobalSlabAllocCtx, pCmdReqBuffer);
-        sockUnlockSocket(pSockCtx);
-        errno = EBADMSG;
-        return -1;
+        numPollWaiters--;
     }
+#endif
 
-    sockUnlockSocket(pSockCtx);
-    return 0;
+    return numReady;
 }
 
 /*****************************************************************************
@@ -5403,8 +9334,9 @@ int WINC_SOCK_NS(setsockopt)(int fd, int level, int optname, const void *optval,
   Parameters:
     fds     - Set of file descriptors to be monitored
     nfds    - Number of items in the fds array
-    timeout - specifies the number of milliseconds to block block waiting for
-                a file descriptor to become ready. Must be 0.
+    timeout - specifies the number of milliseconds to block waiting for
+                a file descriptor to become ready. A negative value
+                specifies an infinite timeout.
 
   Returns:
     On success, poll() returns a nonnegative value which is the number
@@ -5416,11 +9348,18 @@ int WINC_SOCK_NS(setsockopt)(int fd, int level, int optname, const void *optval,
     On error, -1 is returned, and errno is set to indicate the error.
 
   Remarks:
+    Waiting uses the WINC_CONF_SEM_* semaphore if configured, otherwise
+    the poll idle callback registered with WINC_SockRegisterPollIdleCallback
+    is called. A non-zero timeout must not be used from a socket event
+    callback.
+
     errno:
         EFAULT
             System fault.
         EINVAL
-            The nfds value exceeds the WINC_SOCK_NUM_SOCKETS value.
+            A non-zero timeout was requested but there is no means to wait,
+            or a finite timeout was requested but WINC_CONF_TIME_MS_GET is
+            not configured.
 
     events/revents:
         POLLIN
@@ -5442,7 +9381,7 @@ int WINC_SOCK_NS(setsockopt)(int fd, int level, int optname, const void *optval,
 
 int WINC_SOCK_NS(poll)(struct pollfd *fds, nfds_t nfds, int timeout)
 {
-    int nfdsSet = 0;
+    WINC_SOCK_POLL_SCAN scan;
 
     if (NULL == fds)
     {
@@ -5450,87 +9389,413 @@ int WINC_SOCK_NS(poll)(struct pollfd *fds, nfds_t nfds, int timeout)
         return -1;
     }
 
-    if ((nfds > WINC_SOCK_NUM_SOCKETS) || (0 != timeout))
+    scan.fds  = fds;
+    scan.nfds = nfds;
+
+    return sockWaitReady(timeout, sockPollScan, (uintptr_t)&scan);
+}
+
+/*****************************************************************************
+  Description:
+    Collect ready sockets from an interest set.
+
+  Parameters:
+    context - Pointer to WINC_SOCK_EPOLL_SCAN arguments
+
+  Returns:
+    Number of events returned, or -1 on error.
+
+  Remarks:
+    Only sockets marked in the ready map are examined. Level-triggered
+    sockets which are still ready remain marked for the next call. The
+    scan resumes after the last socket reported so that all ready sockets
+    are serviced when maxEvents is smaller than the number ready.
+
+ *****************************************************************************/
+
+static int sockEpollScan(uintptr_t context)
+{
+    const WINC_SOCK_EPOLL_SCAN *pScan = (const WINC_SOCK_EPOLL_SCAN*)context;
+    WINC_SOCK_EPOLL_SET *pSet = &epollSets[pScan->setIdx];
+    WINC_SOCK_EPOLL_EVENT *pEvents = pScan->pEvents;
+    uint32_t readyMap[WINC_SOCK_MAP_WORDS];
+    uint32_t rearmMap[WINC_SOCK_MAP_WORDS];
+    unsigned int idx;
+    unsigned int wordIdx;
+    int numEvents = 0;
+
+    if (false == WINC_CONF_LOCK_ENTER(&pSet->accessMutex))
     {
-        errno = EINVAL;
+        errno = EFAULT;
         return -1;
     }
 
-    while (nfds--)
+    (void)memcpy(readyMap, pSet->readyMap, sizeof(readyMap));
+    (void)memset(pSet->readyMap, 0, sizeof(pSet->readyMap));
+    (void)memset(rearmMap, 0, sizeof(rearmMap));
+    idx = pSet->nextIdx;
+
+    WINC_CONF_LOCK_LEAVE(&pSet->accessMutex);
+
+    while (numEvents < pScan->maxEvents)
     {
-        WINC_SOCK_CTX *pSockCtx = WINC_SOCK_HANDLE_TO_PTR(fds->fd);
+        WINC_SOCK_CTX *pSockCtx;
+        int readyIdx;
+        short revents;
+
+        /* Find the next ready socket at or after idx, wrapping around. */
+        readyIdx = sockMapNext(readyMap, idx);
+
+        if (readyIdx < 0)
+        {
+            readyIdx = sockMapNext(readyMap, 0);
+
+            if (readyIdx < 0)
+            {
+                break;
+            }
+        }
+
+        idx = (unsigned int)readyIdx;
+
+        readyMap[idx / 32U] &= ~((uint32_t)1U << (idx % 32U));
 
-        fds->revents = 0;
+        pSockCtx = &wincSockets[idx];
 
-        if (fds->fd < 0)
+        idx++;
+
+        if (idx >= WINC_SOCK_NUM_SOCKETS)
+        {
+            idx = 0;
+        }
+
+        /* Sockets closed since being marked ready are dropped. */
+        if (false == sockLockSocket(pSockCtx))
+        {
+            continue;
+        }
+
+        if (((pScan->setIdx+1U) != pSockCtx->epollSet) || (0U != (pSockCtx->epollEvents & WINC_SOCK_EPOLL_DISARMED)))
         {
+            sockUnlockSocket(pSockCtx);
             continue;
         }
 
-        if ((pSockCtx < &wincSockets[0]) || (pSockCtx >= &wincSockets[WINC_SOCK_NUM_SOCKETS]))
+        if (0U != (pSockCtx->epollEvents & WINC_SOCK_EPOLLET))
         {
-            fds->revents |= POLLNVAL;
+            revents = pSockCtx->epollPending;
+            pSockCtx->epollPending = 0;
         }
         else
         {
-            if (false == sockLockSocket(pSockCtx))
+            revents = sockPollEvents(pSockCtx, (short)pSockCtx->epollEvents);
+        }
+
+        if (0 != revents)
+        {
+            pEvents[numEvents].events = (uint16_t)revents;
+            pEvents[numEvents].data   = pSockCtx->epollData;
+            numEvents++;
+
+            if (0U != (pSockCtx->epollEvents & WINC_SOCK_EPOLLONESHOT))
             {
-                errno = EFAULT;
-                return -1;
+                pSockCtx->epollEvents |= WINC_SOCK_EPOLL_DISARMED;
+            }
+            else if (0U == (pSockCtx->epollEvents & WINC_SOCK_EPOLLET))
+            {
+                rearmMap[WINC_SOCK_PTR_TO_IDX(pSockCtx) / 32U] |= ((uint32_t)1U << (WINC_SOCK_PTR_TO_IDX(pSockCtx) % 32U));
+            }
+            else
+            {
+            }
+        }
+
+        sockUnlockSocket(pSockCtx);
+    }
+
+    if (false == WINC_CONF_LOCK_ENTER(&pSet->accessMutex))
+    {
+        errno = EFAULT;
+        return -1;
+    }
+
+    /* Return unexamined and still ready sockets to the ready map. */
+    for (wordIdx=0; wordIdx<WINC_SOCK_MAP_WORDS; wordIdx++)
+    {
+        pSet->readyMap[wordIdx] |= (readyMap[wordIdx] | rearmMap[wordIdx]);
+    }
+
+    pSet->nextIdx   = (uint8_t)idx;
+
+    WINC_CONF_LOCK_LEAVE(&pSet->accessMutex);
+
+    return numEvents;
+}
+
+/*****************************************************************************
+  Description:
+    Create a readiness notification interest set.
+
+  Parameters:
+    None.
+
+  Returns:
+    Interest set descriptor or -1 on error, see errno.
+
+  Remarks:
+    The descriptor is only valid for the WINC_SockEpoll functions.
+
+    errno:
+        EMFILE
+            All WINC_SOCK_EPOLL_NUM_SETS interest sets are in use.
+
+ *****************************************************************************/
+
+int WINC_SockEpollCreate(void)
+{
+    unsigned int i;
+
+    for (i=0; i<WINC_SOCK_EPOLL_NUM_SETS; i++)
+    {
+        if (false == epollSets[i].inUse)
+        {
+            (void)memset(&epollSets[i], 0, sizeof(WINC_SOCK_EPOLL_SET));
+
+            WINC_CONF_LOCK_CREATE(&epollSets[i].accessMutex);
+
+            epollSets[i].inUse = true;
+
+            return (int)i;
+        }
+    }
+
+    errno = EMFILE;
+    return -1;
+}
+
+/*****************************************************************************
+  Description:
+    Destroy a readiness notification interest set.
+
+  Parameters:
+    epfd - Interest set descriptor.
+
+  Returns:
+    On success, zero is returned. On error, -1 is returned, and errno is set
+    to indicate the error.
+
+  Remarks:
+    Any sockets still registered are removed from the set.
+
+    errno:
+        EBADF
+            The argument epfd is not a valid interest set.
+
+ *****************************************************************************/
+
+int WINC_SockEpollDestroy(int epfd)
+{
+    unsigned int i;
+
+    if ((epfd < 0) || (epfd >= (int)WINC_SOCK_EPOLL_NUM_SETS) || (false == epollSets[epfd].inUse))
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    for (i=0; i<WINC_SOCK_NUM_SOCKETS; i++)
+    {
+        if (true == sockLockSocket(&wincSockets[i]))
+        {
+            if (((unsigned int)epfd+1U) == wincSockets[i].epollSet)
+            {
+                wincSockets[i].epollSet = 0;
             }
 
-            /* If POLLIN is selected, check incoming buffer length. */
-            if (0 != (fds->events & POLLIN))
+            sockUnlockSocket(&wincSockets[i]);
+        }
+    }
+
+    WINC_CONF_LOCK_DESTROY(&epollSets[epfd].accessMutex);
+
+    (void)memset(&epollSets[epfd], 0, sizeof(WINC_SOCK_EPOLL_SET));
+
+    return 0;
+}
+
+/*****************************************************************************
+  Description:
+    Add, modify or remove a socket in a readiness notification interest set.
+
+  Parameters:
+    epfd   - Interest set descriptor.
+    op     - Operation to perform.
+    fd     - Socket file descriptor.
+    pEvent - Pointer to requested events and user data, unused for
+                WINC_SOCK_EPOLL_CTL_DEL.
+
+  Returns:
+    On success, zero is returned. On error, -1 is returned, and errno is set
+    to indicate the error.
+
+  Remarks:
+    The requested events are the poll() events POLLIN and POLLOUT, POLLERR
+    and POLLHUP are always reported. WINC_SOCK_EPOLLET selects edge-triggered
+    delivery, WINC_SOCK_EPOLLONESHOT disables the socket after one event
+    until it is re-armed with WINC_SOCK_EPOLL_CTL_MOD.
+
+    A socket can be registered in only one interest set. Closed sockets are
+    removed automatically.
+
+    errno:
+        EBADF
+            The argument epfd or fd is not valid.
+        EEXIST
+            The socket is already registered in an interest set.
+        EINVAL
+            The operation or pEvent is invalid.
+        ENOENT
+            The socket is not registered in this interest set.
+
+ *****************************************************************************/
+
+int WINC_SockEpollCtl(int epfd, WINC_SOCK_EPOLL_CTL_OP op, int fd, const WINC_SOCK_EPOLL_EVENT *pEvent)
+{
+    WINC_SOCK_CTX *pSockCtx = WINC_SOCK_HANDLE_TO_PTR(fd);
+    uint8_t setNum;
+
+    if ((epfd < 0) || (epfd >= (int)WINC_SOCK_EPOLL_NUM_SETS) || (false == epollSets[epfd].inUse))
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    if ((fd < 0) || (pSockCtx < &wincSockets[0]) || (pSockCtx >= &wincSockets[WINC_SOCK_NUM_SOCKETS]))
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    if ((WINC_SOCK_EPOLL_CTL_DEL != op) && (NULL == pEvent))
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (false == sockLockSocket(pSockCtx))
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    setNum = (uint8_t)(epfd+1);
+
+    switch (op)
+    {
+        case WINC_SOCK_EPOLL_CTL_ADD:
+        case WINC_SOCK_EPOLL_CTL_MOD:
+        {
+            if ((WINC_SOCK_EPOLL_CTL_ADD == op) && (0U != pSockCtx->epollSet))
             {
-                if (true == pSockCtx->listening)
-                {
-                    if (NULL != sockFindPendingSocket(pSockCtx))
-                    {
-                        fds->revents |= POLLIN;
-                    }
-                }
-                else
-                {
-                    if (pSockCtx->recvBuffer.length > 0)
-                    {
-                        fds->revents |= POLLIN;
-                    }
-                }
+                sockUnlockSocket(pSockCtx);
+                errno = EEXIST;
+                return -1;
             }
 
-            /* If POLLOUT is selected, check there is some space in output buffer. */
-            if (0 != (fds->events & POLLOUT))
+            if ((WINC_SOCK_EPOLL_CTL_MOD == op) && (setNum != pSockCtx->epollSet))
             {
-                if (true == pSockCtx->connected)
-                {
-                    if ((pSockCtx->sendBuffer.totalSize - pSockCtx->sendBuffer.length) > 0)
-                    {
-                        fds->revents |= POLLOUT;
-                    }
-                }
+                sockUnlockSocket(pSockCtx);
+                errno = ENOENT;
+                return -1;
             }
 
-            fds->revents |= pSockCtx->events;
+            pSockCtx->epollSet     = setNum;
+            pSockCtx->epollEvents  = pEvent->events & ~WINC_SOCK_EPOLL_DISARMED;
+            pSockCtx->epollData    = pEvent->data;
+            pSockCtx->epollPending = 0;
+
+            /* Report any events already present. */
+            sockEpollNotify(pSockCtx);
+            break;
+        }
 
-            /* If POLLERR signalled, also copy in caller POLLIN|POLLOUT to
-             trigger send/recv paths if not checking POLLERR. */
-            if (0 != (pSockCtx->events & POLLERR))
+        case WINC_SOCK_EPOLL_CTL_DEL:
+        {
+            if (setNum != pSockCtx->epollSet)
             {
-                fds->revents |= (fds->events & (POLLIN|POLLOUT));
+                sockUnlockSocket(pSockCtx);
+                errno = ENOENT;
+                return -1;
             }
+
+            pSockCtx->epollSet = 0;
+            break;
         }
 
-        if (0 != fds->revents)
+        default:
         {
-            nfdsSet++;
+            sockUnlockSocket(pSockCtx);
+            errno = EINVAL;
+            return -1;
         }
+    }
 
-        sockUnlockSocket(pSockCtx);
+    sockUnlockSocket(pSockCtx);
+    return 0;
+}
+
+/*****************************************************************************
+  Description:
+    Wait for events on a readiness notification interest set.
+
+  Parameters:
+    epfd      - Interest set descriptor.
+    pEvents   - Pointer to array to receive events.
+    maxEvents - Maximum number of events to return.
+    timeout   - Number of milliseconds to wait, a negative value waits
+                  indefinitely.
+
+  Returns:
+    Number of events returned, zero if the timeout expired, or -1 on error,
+    see errno.
+
+  Remarks:
+    Only sockets which have signalled a state change are examined, the cost
+    does not depend on the number of sockets registered. Waiting behaves as
+    for poll().
+
+    errno:
+        EBADF
+            The argument epfd is not a valid interest set.
+        EFAULT
+            System fault.
+        EINVAL
+            pEvents or maxEvents is invalid, or the timeout cannot be
+            supported, see poll().
+
+ *****************************************************************************/
+
+int WINC_SockEpollWait(int epfd, WINC_SOCK_EPOLL_EVENT *pEvents, int maxEvents, int timeout)
+{
+    WINC_SOCK_EPOLL_SCAN scan;
+
+    if ((epfd < 0) || (epfd >= (int)WINC_SOCK_EPOLL_NUM_SETS) || (false == epollSets[epfd].inUse))
+    {
+        errno = EBADF;
+        return -1;
+    }
 
-        fds++;
+    if ((NULL == pEvents) || (maxEvents <= 0))
+    {
+        errno = EINVAL;
+        return -1;
     }
 
-    return nfdsSet;
+    scan.setIdx    = (unsigned int)epfd;
+    scan.pEvents   = pEvents;
+    scan.maxEvents = maxEvents;
+
+    return sockWaitReady(timeout, sockEpollScan, (uintptr_t)&scan);
 }
 
 /*****************************************************************************
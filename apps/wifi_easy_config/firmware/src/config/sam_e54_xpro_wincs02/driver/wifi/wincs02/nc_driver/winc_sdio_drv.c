@@ -29,6 +29,20 @@ TO MICROCHIP FOR THIS SOFTWARE.
 #define WINC_CONF_SPI_MOSI_IDLE_LEVEL   1
 #endif
 
+/* Software CRC16 processes four bytes per table lookup round, set to 0 to
+   use only the single byte reference table. */
+#ifndef WINC_CONF_SDIO_CRC16_SLICE_BY_4
+#define WINC_CONF_SDIO_CRC16_SLICE_BY_4 1
+#endif
+
+/* SDIO command and data CRCs are enabled by CMD59 during device
+   initialisation when set to 1. While they are disabled no CRC16 is
+   calculated, so a backend registered with WINC_SDIOSendCRC16Set is not
+   used. */
+#ifndef WINC_CONF_SDIO_USE_CRC
+#define WINC_CONF_SDIO_USE_CRC          0
+#endif
+
 typedef struct
 {
     uint32_t    regAddr;
@@ -78,6 +92,67 @@ static const uint16_t crc16[256] =
     0xef1f, 0xff3e, 0xcf5d, 0xdf7c, 0xaf9b, 0xbfba, 0x8fd9, 0x9ff8, 0x6e17, 0x7e36, 0x4e55, 0x5e74, 0x2e93, 0x3eb2, 0x0ed1, 0x1ef0
 };
 
+#if WINC_CONF_SDIO_CRC16_SLICE_BY_4 != 0
+/* crc16x4[n-1][b] is the CRC16 of byte b followed by n zero bytes. */
+static const uint16_t crc16x4[3][256] =
+{
+    {
+        0x0000, 0x3331, 0x6662, 0x5553, 0xccc4, 0xfff5, 0xaaa6, 0x9997, 0x89a9, 0xba98, 0xefcb, 0xdcfa, 0x456d, 0x765c, 0x230f, 0x103e,
+        0x0373, 0x3042, 0x6511, 0x5620, 0xcfb7, 0xfc86, 0xa9d5, 0x9ae4, 0x8ada, 0xb9eb, 0xecb8, 0xdf89, 0x461e, 0x752f, 0x207c, 0x134d,
+        0x06e6, 0x35d7, 0x6084, 0x53b5, 0xca22, 0xf913, 0xac40, 0x9f71, 0x8f4f, 0xbc7e, 0xe92d, 0xda1c, 0x438b, 0x70ba, 0x25e9, 0x16d8,
+        0x0595, 0x36a4, 0x63f7, 0x50c6, 0xc951, 0xfa60, 0xaf33, 0x9c02, 0x8c3c, 0xbf0d, 0xea5e, 0xd96f, 0x40f8, 0x73c9, 0x269a, 0x15ab,
+        0x0dcc, 0x3efd, 0x6bae, 0x589f, 0xc108, 0xf239, 0xa76a, 0x945b, 0x8465, 0xb754, 0xe207, 0xd136, 0x48a1, 0x7b90, 0x2ec3, 0x1df2,
+        0x0ebf, 0x3d8e, 0x68dd, 0x5bec, 0xc27b, 0xf14a, 0xa419, 0x9728, 0x8716, 0xb427, 0xe174, 0xd245, 0x4bd2, 0x78e3, 0x2db0, 0x1e81,
+        0x0b2a, 0x381b, 0x6d48, 0x5e79, 0xc7ee, 0xf4df, 0xa18c, 0x92bd, 0x8283, 0xb1b2, 0xe4e1, 0xd7d0, 0x4e47, 0x7d76, 0x2825, 0x1b14,
+        0x0859, 0x3b68, 0x6e3b, 0x5d0a, 0xc49d, 0xf7ac, 0xa2ff, 0x91ce, 0x81f0, 0xb2c1, 0xe792, 0xd4a3, 0x4d34, 0x7e05, 0x2b56, 0x1867,
+        0x1b98, 0x28a9, 0x7dfa, 0x4ecb, 0xd75c, 0xe46d, 0xb13e, 0x820f, 0x9231, 0xa100, 0xf453, 0xc762, 0x5ef5, 0x6dc4, 0x3897, 0x0ba6,
+        0x18eb, 0x2bda, 0x7e89, 0x4db8, 0xd42f, 0xe71e, 0xb24d, 0x817c, 0x9142, 0xa273, 0xf720, 0xc411, 0x5d86, 0x6eb7, 0x3be4, 0x08d5,
+        0x1d7e, 0x2e4f, 0x7b1c, 0x482d, 0xd1ba, 0xe28b, 0xb7d8, 0x84e9, 0x94d7, 0xa7e6, 0xf2b5, 0xc184, 0x5813, 0x6b22, 0x3e71, 0x0d40,
+        0x1e0d, 0x2d3c, 0x786f, 0x4b5e, 0xd2c9, 0xe1f8, 0xb4ab, 0x879a, 0x97a4, 0xa495, 0xf1c6, 0xc2f7, 0x5b60, 0x6851, 0x3d02, 0x0e33,
+        0x1654, 0x2565, 0x7036, 0x4307, 0xda90, 0xe9a1, 0xbcf2, 0x8fc3, 0x9ffd, 0xaccc, 0xf99f, 0xcaae, 0x5339, 0x6008, 0x355b, 0x066a,
+        0x1527, 0x2616, 0x7345, 0x4074, 0xd9e3, 0xead2, 0xbf81, 0x8cb0, 0x9c8e, 0xafbf, 0xfaec, 0xc9dd, 0x504a, 0x637b, 0x3628, 0x0519,
+        0x10b2, 0x2383, 0x76d0, 0x45e1, 0xdc76, 0xef47, 0xba14, 0x8925, 0x991b, 0xaa2a, 0xff79, 0xcc48, 0x55df, 0x66ee, 0x33bd, 0x008c,
+        0x13c1, 0x20f0, 0x75a3, 0x4692, 0xdf05, 0xec34, 0xb967, 0x8a56, 0x9a68, 0xa959, 0xfc0a, 0xcf3b, 0x56ac, 0x659d, 0x30ce, 0x03ff
+    },
+    {
+        0x0000, 0x3730, 0x6e60, 0x5950, 0xdcc0, 0xebf0, 0xb2a0, 0x8590, 0xa9a1, 0x9e91, 0xc7c1, 0xf0f1, 0x7561, 0x4251, 0x1b01, 0x2c31,
+        0x4363, 0x7453, 0x2d03, 0x1a33, 0x9fa3, 0xa893, 0xf1c3, 0xc6f3, 0xeac2, 0xddf2, 0x84a2, 0xb392, 0x3602, 0x0132, 0x5862, 0x6f52,
+        0x86c6, 0xb1f6, 0xe8a6, 0xdf96, 0x5a06, 0x6d36, 0x3466, 0x0356, 0x2f67, 0x1857, 0x4107, 0x7637, 0xf3a7, 0xc497, 0x9dc7, 0xaaf7,
+        0xc5a5, 0xf295, 0xabc5, 0x9cf5, 0x1965, 0x2e55, 0x7705, 0x4035, 0x6c04, 0x5b34, 0x0264, 0x3554, 0xb0c4, 0x87f4, 0xdea4, 0xe994,
+        0x1dad, 0x2a9d, 0x73cd, 0x44fd, 0xc16d, 0xf65d, 0xaf0d, 0x983d, 0xb40c, 0x833c, 0xda6c, 0xed5c, 0x68cc, 0x5ffc, 0x06ac, 0x319c,
+        0x5ece, 0x69fe, 0x30ae, 0x079e, 0x820e, 0xb53e, 0xec6e, 0xdb5e, 0xf76f, 0xc05f, 0x990f, 0xae3f, 0x2baf, 0x1c9f, 0x45cf, 0x72ff,
+        0x9b6b, 0xac5b, 0xf50b, 0xc23b, 0x47ab, 0x709b, 0x29cb, 0x1efb, 0x32ca, 0x05fa, 0x5caa, 0x6b9a, 0xee0a, 0xd93a, 0x806a, 0xb75a,
+        0xd808, 0xef38, 0xb668, 0x8158, 0x04c8, 0x33f8, 0x6aa8, 0x5d98, 0x71a9, 0x4699, 0x1fc9, 0x28f9, 0xad69, 0x9a59, 0xc309, 0xf439,
+        0x3b5a, 0x0c6a, 0x553a, 0x620a, 0xe79a, 0xd0aa, 0x89fa, 0xbeca, 0x92fb, 0xa5cb, 0xfc9b, 0xcbab, 0x4e3b, 0x790b, 0x205b, 0x176b,
+        0x7839, 0x4f09, 0x1659, 0x2169, 0xa4f9, 0x93c9, 0xca99, 0xfda9, 0xd198, 0xe6a8, 0xbff8, 0x88c8, 0x0d58, 0x3a68, 0x6338, 0x5408,
+        0xbd9c, 0x8aac, 0xd3fc, 0xe4cc, 0x615c, 0x566c, 0x0f3c, 0x380c, 0x143d, 0x230d, 0x7a5d, 0x4d6d, 0xc8fd, 0xffcd, 0xa69d, 0x91ad,
+        0xfeff, 0xc9cf, 0x909f, 0xa7af, 0x223f, 0x150f, 0x4c5f, 0x7b6f, 0x575e, 0x606e, 0x393e, 0x0e0e, 0x8b9e, 0xbcae, 0xe5fe, 0xd2ce,
+        0x26f7, 0x11c7, 0x4897, 0x7fa7, 0xfa37, 0xcd07, 0x9457, 0xa367, 0x8f56, 0xb866, 0xe136, 0xd606, 0x5396, 0x64a6, 0x3df6, 0x0ac6,
+        0x6594, 0x52a4, 0x0bf4, 0x3cc4, 0xb954, 0x8e64, 0xd734, 0xe004, 0xcc35, 0xfb05, 0xa255, 0x9565, 0x10f5, 0x27c5, 0x7e95, 0x49a5,
+        0xa031, 0x9701, 0xce51, 0xf961, 0x7cf1, 0x4bc1, 0x1291, 0x25a1, 0x0990, 0x3ea0, 0x67f0, 0x50c0, 0xd550, 0xe260, 0xbb30, 0x8c00,
+        0xe352, 0xd462, 0x8d32, 0xba02, 0x3f92, 0x08a2, 0x51f2, 0x66c2, 0x4af3, 0x7dc3, 0x2493, 0x13a3, 0x9633, 0xa103, 0xf853, 0xcf63
+    },
+    {
+        0x0000, 0x76b4, 0xed68, 0x9bdc, 0xcaf1, 0xbc45, 0x2799, 0x512d, 0x85c3, 0xf377, 0x68ab, 0x1e1f, 0x4f32, 0x3986, 0xa25a, 0xd4ee,
+        0x1ba7, 0x6d13, 0xf6cf, 0x807b, 0xd156, 0xa7e2, 0x3c3e, 0x4a8a, 0x9e64, 0xe8d0, 0x730c, 0x05b8, 0x5495, 0x2221, 0xb9fd, 0xcf49,
+        0x374e, 0x41fa, 0xda26, 0xac92, 0xfdbf, 0x8b0b, 0x10d7, 0x6663, 0xb28d, 0xc439, 0x5fe5, 0x2951, 0x787c, 0x0ec8, 0x9514, 0xe3a0,
+        0x2ce9, 0x5a5d, 0xc181, 0xb735, 0xe618, 0x90ac, 0x0b70, 0x7dc4, 0xa92a, 0xdf9e, 0x4442, 0x32f6, 0x63db, 0x156f, 0x8eb3, 0xf807,
+        0x6e9c, 0x1828, 0x83f4, 0xf540, 0xa46d, 0xd2d9, 0x4905, 0x3fb1, 0xeb5f, 0x9deb, 0x0637, 0x7083, 0x21ae, 0x571a, 0xccc6, 0xba72,
+        0x753b, 0x038f, 0x9853, 0xeee7, 0xbfca, 0xc97e, 0x52a2, 0x2416, 0xf0f8, 0x864c, 0x1d90, 0x6b24, 0x3a09, 0x4cbd, 0xd761, 0xa1d5,
+        0x59d2, 0x2f66, 0xb4ba, 0xc20e, 0x9323, 0xe597, 0x7e4b, 0x08ff, 0xdc11, 0xaaa5, 0x3179, 0x47cd, 0x16e0, 0x6054, 0xfb88, 0x8d3c,
+        0x4275, 0x34c1, 0xaf1d, 0xd9a9, 0x8884, 0xfe30, 0x65ec, 0x1358, 0xc7b6, 0xb102, 0x2ade, 0x5c6a, 0x0d47, 0x7bf3, 0xe02f, 0x969b,
+        0xdd38, 0xab8c, 0x3050, 0x46e4, 0x17c9, 0x617d, 0xfaa1, 0x8c15, 0x58fb, 0x2e4f, 0xb593, 0xc327, 0x920a, 0xe4be, 0x7f62, 0x09d6,
+        0xc69f, 0xb02b, 0x2bf7, 0x5d43, 0x0c6e, 0x7ada, 0xe106, 0x97b2, 0x435c, 0x35e8, 0xae34, 0xd880, 0x89ad, 0xff19, 0x64c5, 0x1271,
+        0xea76, 0x9cc2, 0x071e, 0x71aa, 0x2087, 0x5633, 0xcdef, 0xbb5b, 0x6fb5, 0x1901, 0x82dd, 0xf469, 0xa544, 0xd3f0, 0x482c, 0x3e98,
+        0xf1d1, 0x8765, 0x1cb9, 0x6a0d, 0x3b20, 0x4d94, 0xd648, 0xa0fc, 0x7412, 0x02a6, 0x997a, 0xefce, 0xbee3, 0xc857, 0x538b, 0x253f,
+        0xb3a4, 0xc510, 0x5ecc, 0x2878, 0x7955, 0x0fe1, 0x943d, 0xe289, 0x3667, 0x40d3, 0xdb0f, 0xadbb, 0xfc96, 0x8a22, 0x11fe, 0x674a,
+        0xa803, 0xdeb7, 0x456b, 0x33df, 0x62f2, 0x1446, 0x8f9a, 0xf92e, 0x2dc0, 0x5b74, 0xc0a8, 0xb61c, 0xe731, 0x9185, 0x0a59, 0x7ced,
+        0x84ea, 0xf25e, 0x6982, 0x1f36, 0x4e1b, 0x38af, 0xa373, 0xd5c7, 0x0129, 0x779d, 0xec41, 0x9af5, 0xcbd8, 0xbd6c, 0x26b0, 0x5004,
+        0x9f4d, 0xe9f9, 0x7225, 0x0491, 0x55bc, 0x2308, 0xb8d4, 0xce60, 0x1a8e, 0x6c3a, 0xf7e6, 0x8152, 0xd07f, 0xa6cb, 0x3d17, 0x4ba3
+    }
+};
+#endif
+
 static const WINC_SDIO_CMD52_REG_ENTRY cmd52InitSeq1[] =
 {
     {(uint32_t)WINC_SDIOREG_FN0_FBR_FN1_BLK_SZ_L,     (uint8_t)(SPI_SDIO_BLOCK_SZ & 0xffU)},
@@ -92,8 +167,18 @@ static const WINC_SDIO_CMD52_REG_ENTRY cmd52InitSeq1[] =
     {(uint32_t)WINC_SDIOREG_FN1_INT_EN,               (uint8_t)WINC_SDIO_REG_FN1_INT_MSG_FROM_ARM},
 };
 
-static bool useCRCs = false;
+static bool useCRCs = (0 != WINC_CONF_SDIO_USE_CRC);
 static WINC_SDIO_SEND_RECEIVE_FP pfSDIOSendReceive = NULL;
+static WINC_SDIO_SEND_RECEIVE_LIST_FP pfSDIOSendReceiveList = NULL;
+static WINC_SDIO_SEND_CRC16_FP pfSDIOSendCRC16 = NULL;
+static bool sendCRC16Verified = false;
+static WINC_SDIO_XFER_QUEUE_FP pfSDIOXferQueue = NULL;
+static WINC_SDIO_XFER_WAIT_FP pfSDIOXferWait = NULL;
+static WINC_SDIO_XFER asyncXferList[2];
+static WINC_DEV_CACHE_ATTRIB uint8_t asyncCRCRsp[WINC_DEV_CACHE_GET_SIZE(3)];
+static WINC_DEV_CACHE_ATTRIB uint8_t asyncCRCTx[WINC_DEV_CACHE_GET_SIZE(3)] = {0xff, 0xff, 0xff};
+static bool asyncReadPending = false;
+static volatile bool asyncReadFailed = false;
 #if WINC_CONF_SPI_MOSI_IDLE_LEVEL == 0
 static uint8_t forceTxBuffer[SPI_SDIO_BLOCK_SZ];
 #define SPI_TX_NULL_BUFFER  forceTxBuffer
@@ -133,6 +218,34 @@ static uint8_t sdioCRC7(const uint8_t *p, size_t l)
     return crc & 0xfeU;
 }
 
+/*****************************************************************************
+  Description:
+    Calculates CRC16 (CCITT) one byte at a time.
+
+  Parameters:
+    crc - Initial CRC value
+    p   - Pointer to data to checksum
+    l   - Length of data to checksum
+
+  Returns:
+    CRC16 of data
+
+  Remarks:
+    Reference implementation, other CRC16 backends must produce the same
+    result.
+
+ *****************************************************************************/
+
+static uint16_t sdioCRC16Ref(uint16_t crc, const uint8_t *p, size_t l)
+{
+    while (0U != (l--))
+    {
+        crc = (crc << 8) ^ crc16[((crc >> 8) ^ *p++)];
+    }
+
+    return crc;
+}
+
 /*****************************************************************************
   Description:
     Calculates SDIO CRC16.
@@ -157,14 +270,74 @@ static uint16_t sdioCRC16(const uint8_t *p, size_t l)
         return 0;
     }
 
-    while (0U != (l--))
+#if WINC_CONF_SDIO_CRC16_SLICE_BY_4 != 0
+    while (l >= 4U)
     {
-        crc = (crc << 8) ^ crc16[((crc >> 8) ^ *p++)];
+        crc = crc16x4[2][(crc >> 8) ^ p[0]] ^ crc16x4[1][(crc & 0xffU) ^ p[1]] ^ crc16x4[0][p[2]] ^ crc16[p[3]];
+
+        p += 4;
+        l -= 4U;
     }
+#endif
+
+    crc = sdioCRC16Ref(crc, p, l);
 
     return (crc << 8) | ((crc >> 8) & 0xffU);
 }
 
+/*****************************************************************************
+  Description:
+    Sends a data block and calculates its SDIO CRC16.
+
+  Parameters:
+    p    - Pointer to data to send
+    l    - Length of data to send
+    pCRC - Pointer to receive CRC16 of data, or zero if disabled
+
+  Returns:
+    true or false indicating success.
+
+  Remarks:
+    If a send with CRC16 function is registered the CRC is calculated while
+    the data is sent. Its result is checked against the reference once, the
+    function is no longer used if they differ.
+
+ *****************************************************************************/
+
+static bool sdioSendCRC16(uint8_t *p, size_t l, uint16_t *pCRC)
+{
+    uint16_t crc;
+
+    if ((false == useCRCs) || (NULL == pfSDIOSendCRC16))
+    {
+        *pCRC = sdioCRC16(p, l);
+
+        return pfSDIOSendReceive(p, NULL, l);
+    }
+
+    if (false == pfSDIOSendCRC16(p, l, &crc))
+    {
+        return false;
+    }
+
+    if (false == sendCRC16Verified)
+    {
+        if (crc != sdioCRC16Ref(0, p, l))
+        {
+            WINC_ERROR_PRINT("SDIO CRC16 backend mismatch, using software\n");
+
+            pfSDIOSendCRC16 = NULL;
+            crc = sdioCRC16Ref(0, p, l);
+        }
+
+        sendCRC16Verified = true;
+    }
+
+    *pCRC = (crc << 8) | ((crc >> 8) & 0xffU);
+
+    return true;
+}
+
 /*****************************************************************************
   Description:
     Writes a sequence of CMD52 messages.
@@ -553,12 +726,12 @@ uint16_t WINC_SDIOCmd53Write(uint32_t fnRegAddr, uint8_t *pWritePtr, size_t writ
 
         do
         {
-            crc = sdioCRC16(pWritePtr, transferSize);
-
             retry = SPI_SDIO_RETRY_CNT;
 
             if (transferSize <= 4U)
             {
+                crc = sdioCRC16(pWritePtr, transferSize);
+
                 /* Pack start block token, data block, CRC. */
                 sdioCmd[1] = 0xfe;
 
@@ -588,27 +761,57 @@ uint16_t WINC_SDIOCmd53Write(uint32_t fnRegAddr, uint8_t *pWritePtr, size_t writ
             }
             else
             {
-                /* Send start block token. */
                 sdioCmd[1] = (uint8_t)(blockMode ? 0xfcU : 0xfeU);
 
-                if (false == pfSDIOSendReceive(sdioCmd, NULL, 2))
+                if ((NULL != pfSDIOSendReceiveList) && ((false == useCRCs) || (NULL == pfSDIOSendCRC16)))
                 {
-                    return WINC_SDIO_R1RSP_FAILED;
-                }
+                    WINC_SDIO_XFER xferList[3];
 
-                /* Send data block. */
-                if (false == pfSDIOSendReceive(pWritePtr, NULL, transferSize))
-                {
-                    return WINC_SDIO_R1RSP_FAILED;
-                }
+                    crc = sdioCRC16(pWritePtr, transferSize);
 
-                sdioCmd[5] = (uint8_t)(crc >> 8);
-                sdioCmd[6] = (uint8_t)(crc & 0xffU);
+                    sdioCmd[5] = (uint8_t)(crc >> 8);
+                    sdioCmd[6] = (uint8_t)(crc & 0xffU);
 
-                /* Send CRC. */
-                if (false == pfSDIOSendReceive(&sdioCmd[5], sdioCmdRsp, 5))
+                    xferList[0].pTransmitData = sdioCmd;
+                    xferList[0].pReceiveData  = NULL;
+                    xferList[0].size          = 2;
+
+                    xferList[1].pTransmitData = pWritePtr;
+                    xferList[1].pReceiveData  = NULL;
+                    xferList[1].size          = transferSize;
+
+                    xferList[2].pTransmitData = &sdioCmd[5];
+                    xferList[2].pReceiveData  = sdioCmdRsp;
+                    xferList[2].size          = 5;
+
+                    /* Send start block token, data block and CRC as one transaction. */
+                    if (false == pfSDIOSendReceiveList(xferList, 3))
+                    {
+                        return WINC_SDIO_R1RSP_FAILED;
+                    }
+                }
+                else
                 {
-                    return WINC_SDIO_R1RSP_FAILED;
+                    /* Send start block token. */
+                    if (false == pfSDIOSendReceive(sdioCmd, NULL, 2))
+                    {
+                        return WINC_SDIO_R1RSP_FAILED;
+                    }
+
+                    /* Send data block. */
+                    if (false == sdioSendCRC16(pWritePtr, transferSize, &crc))
+                    {
+                        return WINC_SDIO_R1RSP_FAILED;
+                    }
+
+                    sdioCmd[5] = (uint8_t)(crc >> 8);
+                    sdioCmd[6] = (uint8_t)(crc & 0xffU);
+
+                    /* Send CRC. */
+                    if (false == pfSDIOSendReceive(&sdioCmd[5], sdioCmdRsp, 5))
+                    {
+                        return WINC_SDIO_R1RSP_FAILED;
+                    }
                 }
 
                 rspStatusData = (uint16_t)(sdioCmdRsp[2] & 0x1fU);
@@ -640,6 +843,30 @@ uint16_t WINC_SDIOCmd53Write(uint32_t fnRegAddr, uint8_t *pWritePtr, size_t writ
     return WINC_SDIO_R1RSP_OK;
 }
 
+/*****************************************************************************
+  Description:
+    Completion callback of an asynchronous CMD53 read data block.
+
+  Parameters:
+    success - Flag indicating if the transfer succeeded
+    context - Not used
+
+  Returns:
+    None.
+
+  Remarks:
+    Called from the SPI transfer completion interrupt.
+
+ *****************************************************************************/
+
+static void sdioCmd53ReadCallback(bool success, uintptr_t context)
+{
+    if (false == success)
+    {
+        asyncReadFailed = true;
+    }
+}
+
 /*****************************************************************************
   Description:
     Receive SDIO CMD53.
@@ -649,6 +876,8 @@ uint16_t WINC_SDIOCmd53Write(uint32_t fnRegAddr, uint8_t *pWritePtr, size_t writ
     pReadPtr    - Pointer to buffer to receive into
     writeLength - Length of data to receive
     incAddr     - Flag indicating if address should be incremented
+    async       - Flag indicating if the last data block may be received
+                  asynchronously
 
   Returns:
     R1 response or WINC_SDIO_R1RSP_FAILED on error.
@@ -657,7 +886,7 @@ uint16_t WINC_SDIOCmd53Write(uint32_t fnRegAddr, uint8_t *pWritePtr, size_t writ
 
  *****************************************************************************/
 
-uint16_t WINC_SDIOCmd53Read(uint32_t fnRegAddr, uint8_t *pReadPtr, size_t readLength, bool incAddr)
+static uint16_t sdioCmd53Read(uint32_t fnRegAddr, uint8_t *pReadPtr, size_t readLength, bool incAddr, bool async)
 {
     WINC_DEV_CACHE_ATTRIB uint8_t sdioCmd[WINC_DEV_CACHE_GET_SIZE(13)];
     WINC_DEV_CACHE_ATTRIB uint8_t sdioCmdRsp[WINC_DEV_CACHE_GET_SIZE(13)];
@@ -794,6 +1023,47 @@ uint16_t WINC_SDIOCmd53Read(uint32_t fnRegAddr, uint8_t *pReadPtr, size_t readLe
 
                 sdioCmdRsp[2] = sdioCmdRsp[2U+transferSize];
             }
+            else if ((true == async) && (NULL != pfSDIOXferQueue) && (transferSize == readLength))
+            {
+                asyncXferList[0].pTransmitData = SPI_TX_NULL_BUFFER;
+                asyncXferList[0].pReceiveData  = pReadPtr;
+                asyncXferList[0].size          = transferSize;
+
+                asyncXferList[1].pTransmitData = asyncCRCTx;
+                asyncXferList[1].pReceiveData  = asyncCRCRsp;
+                asyncXferList[1].size          = 3;
+
+                asyncReadFailed = false;
+
+                /* Queue the last data block and CRC, WINC_SDIOCmd53ReadComplete
+                   waits for them to be received. */
+                if (false == pfSDIOXferQueue(asyncXferList, 2, sdioCmd53ReadCallback, 0))
+                {
+                    return WINC_SDIO_R1RSP_FAILED;
+                }
+
+                asyncReadPending = true;
+
+                return WINC_SDIO_R1RSP_OK;
+            }
+            else if (NULL != pfSDIOSendReceiveList)
+            {
+                WINC_SDIO_XFER xferList[2];
+
+                xferList[0].pTransmitData = SPI_TX_NULL_BUFFER;
+                xferList[0].pReceiveData  = pReadPtr;
+                xferList[0].size          = transferSize;
+
+                xferList[1].pTransmitData = &sdioCmd[7];
+                xferList[1].pReceiveData  = sdioCmdRsp;
+                xferList[1].size          = 3;
+
+                /* Receive data block and CRC as one transaction. */
+                if (false == pfSDIOSendReceiveList(xferList, 2))
+                {
+                    return WINC_SDIO_R1RSP_FAILED;
+                }
+            }
             else
             {
                 /* Receive data block. */
@@ -823,6 +1093,90 @@ uint16_t WINC_SDIOCmd53Read(uint32_t fnRegAddr, uint8_t *pReadPtr, size_t readLe
     return WINC_SDIO_R1RSP_OK;
 }
 
+/*****************************************************************************
+  Description:
+    Receive SDIO CMD53.
+
+  Parameters:
+    fnRegAddr   - Function | register address
+    pReadPtr    - Pointer to buffer to receive into
+    writeLength - Length of data to receive
+    incAddr     - Flag indicating if address should be incremented
+
+  Returns:
+    R1 response or WINC_SDIO_R1RSP_FAILED on error.
+
+  Remarks:
+
+ *****************************************************************************/
+
+uint16_t WINC_SDIOCmd53Read(uint32_t fnRegAddr, uint8_t *pReadPtr, size_t readLength, bool incAddr)
+{
+    return sdioCmd53Read(fnRegAddr, pReadPtr, readLength, incAddr, false);
+}
+
+/*****************************************************************************
+  Description:
+    Start receiving SDIO CMD53.
+
+  Parameters:
+    fnRegAddr   - Function | register address
+    pReadPtr    - Pointer to buffer to receive into
+    writeLength - Length of data to receive
+    incAddr     - Flag indicating if address should be incremented
+
+  Returns:
+    R1 response or WINC_SDIO_R1RSP_FAILED on error.
+
+  Remarks:
+    The command is issued and all but the last data block are received. If a
+    transfer queue is registered the last data block is received in the
+    background, WINC_SDIOCmd53ReadComplete must be called before the buffer
+    is accessed. Other SDIO commands may be issued in between, they are
+    transferred once the data block has been received.
+
+ *****************************************************************************/
+
+uint16_t WINC_SDIOCmd53ReadStart(uint32_t fnRegAddr, uint8_t *pReadPtr, size_t readLength, bool incAddr)
+{
+    /* A previous read which was never completed is discarded. */
+    (void)WINC_SDIOCmd53ReadComplete();
+
+    return sdioCmd53Read(fnRegAddr, pReadPtr, readLength, incAddr, true);
+}
+
+/*****************************************************************************
+  Description:
+    Complete receiving SDIO CMD53.
+
+  Parameters:
+    None.
+
+  Returns:
+    R1 response or WINC_SDIO_R1RSP_FAILED on error.
+
+  Remarks:
+    Waits for the data block of a read started by WINC_SDIOCmd53ReadStart.
+
+ *****************************************************************************/
+
+uint16_t WINC_SDIOCmd53ReadComplete(void)
+{
+    if (false == asyncReadPending)
+    {
+        return WINC_SDIO_R1RSP_OK;
+    }
+
+    asyncReadPending = false;
+
+    if ((NULL == pfSDIOXferWait) || (false == pfSDIOXferWait()) || (true == asyncReadFailed))
+    {
+        return WINC_SDIO_R1RSP_FAILED;
+    }
+
+    return WINC_SDIO_R1RSP_OK;
+}
+
 /*****************************************************************************
   Description:
     Initialise the SDIO device.
@@ -1039,3 +1393,76 @@ WINC_SDIO_STATUS_TYPE WINC_SDIODeviceInit(WINC_SDIO_STATE_TYPE *pState, WINC_SDI
 
     return retStatus;
 }
+
+/*****************************************************************************
+  Description:
+    Registers a send function which calculates the CRC16 of the data sent.
+
+  Parameters:
+    pfSendCRC16 - Pointer to send with CRC16 function, or NULL to calculate
+                  CRC16 in software
+
+  Returns:
+    None.
+
+  Remarks:
+    Allows the CRC16 of CMD53 write data blocks to be calculated by hardware
+    during the SPI transfer. The first result is checked against the software
+    reference.
+
+ *****************************************************************************/
+
+void WINC_SDIOSendCRC16Set(WINC_SDIO_SEND_CRC16_FP pfSendCRC16)
+{
+    pfSDIOSendCRC16   = pfSendCRC16;
+    sendCRC16Verified = false;
+}
+
+/*****************************************************************************
+  Description:
+    Registers a function which sends/receives a list of transfers.
+
+  Parameters:
+    pfSendReceiveList - Pointer to send/receive list function, or NULL
+
+  Returns:
+    None.
+
+  Remarks:
+    When registered, the start token, data block and CRC of CMD53 transfers
+    are issued as a single SPI transaction rather than one per part.
+
+ *****************************************************************************/
+
+void WINC_SDIOSendReceiveListSet(WINC_SDIO_SEND_RECEIVE_LIST_FP pfSendReceiveList)
+{
+    pfSDIOSendReceiveList = pfSendReceiveList;
+}
+
+/*****************************************************************************
+  Description:
+    Registers functions which queue transfers and wait for their completion.
+
+  Parameters:
+    pfXferQueue - Pointer to transfer queue function, or NULL
+    pfXferWait  - Pointer to transfer wait function, or NULL
+
+  Returns:
+    None.
+
+  Remarks:
+    Required by WINC_SDIOCmd53ReadStart to receive data in the background.
+
+ *****************************************************************************/
+
+void WINC_SDIOTransferQueueSet(WINC_SDIO_XFER_QUEUE_FP pfXferQueue, WINC_SDIO_XFER_WAIT_FP pfXferWait)
+{
+    if ((NULL == pfXferQueue) || (NULL == pfXferWait))
+    {
+        pfXferQueue = NULL;
+        pfXferWait  = NULL;
+    }
+
+    pfSDIOXferQueue = pfXferQueue;
+    pfSDIOXferWait  = pfXferWait;
+}
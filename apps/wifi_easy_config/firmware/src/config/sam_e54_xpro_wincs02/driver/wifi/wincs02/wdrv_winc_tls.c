@@ -413,7 +413,7 @@ static void tlsCmdRspCallbackHandler
         {
             tlsProcessCmdReqStatus(pDcpt, cmdReqHandle);
 
-            OSAL_Free((WINC_COMMAND_REQUEST*)cmdReqHandle);
+            WDRV_WINC_DevDiscardCmdReq(cmdReqHandle);
             break;
         }
 
@@ -47,6 +47,16 @@
 // *****************************************************************************
 // *****************************************************************************
 
+#define WDRV_WINC_SPI_QUEUE_DEPTH   4U
+
+typedef struct
+{
+    const WINC_SDIO_XFER    *pXferList;
+    size_t                  numXfers;
+    WINC_SDIO_XFER_CALLBACK pfCallback;
+    uintptr_t               context;
+} WDRV_WINC_SPI_QUEUE_ENTRY;
+
 typedef struct
 {
     bool                                isInit;
@@ -55,6 +65,12 @@ typedef struct
     SYS_DMA_SOURCE_ADDRESSING_MODE      txDMAAddrMode;
     SYS_DMA_DESTINATION_ADDRESSING_MODE rxDMAAddrMode;
     OSAL_SEM_HANDLE_TYPE                syncSem;
+    WDRV_WINC_SPI_QUEUE_ENTRY           queue[WDRV_WINC_SPI_QUEUE_DEPTH];
+    volatile size_t                     queueHead;
+    volatile size_t                     queueCount;
+    size_t                              xferIdx;
+    volatile bool                       waiting;
+    volatile bool                       xferFailed;
 } WDRV_WINC_SPIDCPT;
 
 // *****************************************************************************
@@ -64,6 +80,7 @@ typedef struct
 // *****************************************************************************
 
 static WDRV_WINC_SPIDCPT spiDcpt = {.isInit = false};
+
 static CACHE_ALIGN uint8_t dummyDataTx[CACHE_ALIGNED_SIZE_GET(4)];
 static CACHE_ALIGN uint8_t dummyDataRx[CACHE_ALIGNED_SIZE_GET(4)];
 
@@ -73,46 +90,11 @@ static CACHE_ALIGN uint8_t dummyDataRx[CACHE_ALIGNED_SIZE_GET(4)];
 // *****************************************************************************
 // *****************************************************************************
 
-static void lDRV_SPI_PlibCallbackHandler(SYS_DMA_TRANSFER_EVENT status, uintptr_t contextHandle)
-{
-    (void)OSAL_SEM_PostISR((OSAL_SEM_HANDLE_TYPE*)contextHandle);
-}
-
-//*******************************************************************************
-/*
-  Function:
-    bool WDRV_WINC_SPISendReceive(void* pTransmitData, void* pReceiveData, size_t size)
-
-  Summary:
-    Sends and receives data from the module through the SPI bus.
-
-  Description:
-    This function sends and receives data from the module through the SPI bus.
-
-  Remarks:
-    See wdrv_winc_spi.h for usage information.
-
-    If the receive buffers are located in cached memory the following rules should
-    be applied.
-
-    The receive buffer should not share cache lines with other variables. Any cache
-    lines the receive buffer occupies must not be touched during the receive operation.
- */
-
-bool WDRV_WINC_SPISendReceive(void* pTransmitData, void* pReceiveData, size_t size)
+static void lDRV_SPI_TransferStart(void* pTransmitData, void* pReceiveData, size_t size)
 {
     SYS_DMA_SOURCE_ADDRESSING_MODE      txDMAAddrMode = SYS_DMA_SOURCE_ADDRESSING_MODE_FIXED;
     SYS_DMA_DESTINATION_ADDRESSING_MODE rxDMAAddrMode = SYS_DMA_DESTINATION_ADDRESSING_MODE_FIXED;
 
-    if ((false == spiDcpt.isInit) || (false == spiDcpt.isOpen))
-    {
-        return false;
-    }
-
-#ifdef WDRV_WINC_SSN_Clear
-    WDRV_WINC_SSN_Clear();
-#endif
-
     if (NULL == pReceiveData)
     {
         /* Configure the RX DMA channel - to receive dummy data */
@@ -155,23 +137,274 @@ bool WDRV_WINC_SPISendReceive(void* pTransmitData, void* pReceiveData, size_t si
         spiDcpt.txDMAAddrMode = txDMAAddrMode;
     }
     (void)SYS_DMA_ChannelTransfer(spiDcpt.cfg.txDMAChannel, pTransmitData, (const void*)spiDcpt.cfg.txAddress, size);
+}
+
+static void lDRV_SPI_QueueStart(void)
+{
+    const WDRV_WINC_SPI_QUEUE_ENTRY *pEntry = &spiDcpt.queue[spiDcpt.queueHead];
+
+#ifdef WDRV_WINC_SSN_Clear
+    WDRV_WINC_SSN_Clear();
+#endif
+
+    spiDcpt.xferIdx = 0;
+
+    lDRV_SPI_TransferStart(pEntry->pXferList[0].pTransmitData, pEntry->pXferList[0].pReceiveData, pEntry->pXferList[0].size);
+}
 
-    while (OSAL_RESULT_FALSE == OSAL_SEM_Pend(&spiDcpt.syncSem, OSAL_WAIT_FOREVER))
+static void lDRV_SPI_PlibCallbackHandler(SYS_DMA_TRANSFER_EVENT status, uintptr_t contextHandle)
+{
+    const WDRV_WINC_SPI_QUEUE_ENTRY *pEntry = &spiDcpt.queue[spiDcpt.queueHead];
+    bool success = (SYS_DMA_TRANSFER_COMPLETE == status) ? true : false;
+    size_t i;
+
+    spiDcpt.xferIdx++;
+
+    if ((true == success) && (spiDcpt.xferIdx < pEntry->numXfers))
     {
+        const WINC_SDIO_XFER *pXfer = &pEntry->pXferList[spiDcpt.xferIdx];
+
+        /* Chain the next transfer of the list. */
+        lDRV_SPI_TransferStart(pXfer->pTransmitData, pXfer->pReceiveData, pXfer->size);
+
+        return;
     }
 
-    if (SYS_DMA_DESTINATION_ADDRESSING_MODE_INCREMENTED == rxDMAAddrMode)
+    for (i = 0; i < pEntry->numXfers; i++)
     {
-        SYS_CACHE_InvalidateDCache_by_Addr(pReceiveData, size);
+        if (NULL != pEntry->pXferList[i].pReceiveData)
+        {
+            SYS_CACHE_InvalidateDCache_by_Addr(pEntry->pXferList[i].pReceiveData, pEntry->pXferList[i].size);
+        }
     }
 
 #ifdef WDRV_WINC_SSN_Set
     WDRV_WINC_SSN_Set();
 #endif
 
+    if ((false == success) && (NULL == pEntry->pfCallback))
+    {
+        spiDcpt.xferFailed = true;
+    }
+
+    if (NULL != pEntry->pfCallback)
+    {
+        pEntry->pfCallback(success, pEntry->context);
+    }
+
+    /* Remove the completed list and start the next one queued. */
+    spiDcpt.queueHead = (spiDcpt.queueHead + 1U) % WDRV_WINC_SPI_QUEUE_DEPTH;
+    spiDcpt.queueCount--;
+
+    if (spiDcpt.queueCount > 0U)
+    {
+        lDRV_SPI_QueueStart();
+    }
+    else if (true == spiDcpt.waiting)
+    {
+        spiDcpt.waiting = false;
+
+        (void)OSAL_SEM_PostISR((OSAL_SEM_HANDLE_TYPE*)contextHandle);
+    }
+    else
+    {
+        /* Do nothing. */
+    }
+}
+
+//*******************************************************************************
+/*
+  Function:
+    bool WDRV_WINC_SPITransferQueue
+    (
+        const WINC_SDIO_XFER *pXferList,
+        size_t numXfers,
+        WINC_SDIO_XFER_CALLBACK pfCallback,
+        uintptr_t context
+    )
+
+  Summary:
+    Queues a list of transfers on the SPI bus.
+
+  Description:
+    This function adds a list of transfers to the SPI transfer queue, the
+    list is started immediately if the bus is idle.
+
+  Remarks:
+    See wdrv_winc_spi.h for usage information.
+ */
+
+bool WDRV_WINC_SPITransferQueue
+(
+    const WINC_SDIO_XFER *pXferList,
+    size_t numXfers,
+    WINC_SDIO_XFER_CALLBACK pfCallback,
+    uintptr_t context
+)
+{
+    OSAL_CRITSECT_DATA_TYPE critSect;
+    WDRV_WINC_SPI_QUEUE_ENTRY *pEntry;
+
+    if ((false == spiDcpt.isInit) || (false == spiDcpt.isOpen))
+    {
+        return false;
+    }
+
+    if ((NULL == pXferList) || (0U == numXfers))
+    {
+        return false;
+    }
+
+    critSect = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_HIGH);
+
+    if (spiDcpt.queueCount >= WDRV_WINC_SPI_QUEUE_DEPTH)
+    {
+        OSAL_CRIT_Leave(OSAL_CRIT_TYPE_HIGH, critSect);
+
+        return false;
+    }
+
+    pEntry = &spiDcpt.queue[(spiDcpt.queueHead + spiDcpt.queueCount) % WDRV_WINC_SPI_QUEUE_DEPTH];
+
+    pEntry->pXferList  = pXferList;
+    pEntry->numXfers   = numXfers;
+    pEntry->pfCallback = pfCallback;
+    pEntry->context    = context;
+
+    spiDcpt.queueCount++;
+
+    if (1U == spiDcpt.queueCount)
+    {
+        lDRV_SPI_QueueStart();
+    }
+
+    OSAL_CRIT_Leave(OSAL_CRIT_TYPE_HIGH, critSect);
+
     return true;
 }
 
+//*******************************************************************************
+/*
+  Function:
+    bool WDRV_WINC_SPITransferWait(void)
+
+  Summary:
+    Waits for all queued SPI transfers to complete.
+
+  Description:
+    This function blocks until the SPI transfer queue is empty.
+
+  Remarks:
+    See wdrv_winc_spi.h for usage information.
+ */
+
+bool WDRV_WINC_SPITransferWait(void)
+{
+    OSAL_CRITSECT_DATA_TYPE critSect;
+    bool success;
+
+    if ((false == spiDcpt.isInit) || (false == spiDcpt.isOpen))
+    {
+        return false;
+    }
+
+    critSect = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_HIGH);
+
+    if (0U == spiDcpt.queueCount)
+    {
+        OSAL_CRIT_Leave(OSAL_CRIT_TYPE_HIGH, critSect);
+    }
+    else
+    {
+        spiDcpt.waiting = true;
+
+        OSAL_CRIT_Leave(OSAL_CRIT_TYPE_HIGH, critSect);
+
+        while (OSAL_RESULT_FALSE == OSAL_SEM_Pend(&spiDcpt.syncSem, OSAL_WAIT_FOREVER))
+        {
+        }
+    }
+
+    success = (false == spiDcpt.xferFailed) ? true : false;
+
+    spiDcpt.xferFailed = false;
+
+    return success;
+}
+
+//*******************************************************************************
+/*
+  Function:
+    bool WDRV_WINC_SPISendReceive(void* pTransmitData, void* pReceiveData, size_t size)
+
+  Summary:
+    Sends and receives data from the module through the SPI bus.
+
+  Description:
+    This function sends and receives data from the module through the SPI bus.
+
+  Remarks:
+    See wdrv_winc_spi.h for usage information.
+
+    If the receive buffers are located in cached memory the following rules should
+    be applied.
+
+    The receive buffer should not share cache lines with other variables. Any cache
+    lines the receive buffer occupies must not be touched during the receive operation.
+
+ */
+
+bool WDRV_WINC_SPISendReceive(void* pTransmitData, void* pReceiveData, size_t size)
+{
+    WINC_SDIO_XFER xfer;
+
+    xfer.pTransmitData = pTransmitData;
+    xfer.pReceiveData  = pReceiveData;
+    xfer.size          = size;
+
+    return WDRV_WINC_SPISendReceiveList(&xfer, 1);
+}
+
+//*******************************************************************************
+/*
+  Function:
+    bool WDRV_WINC_SPISendReceiveList(const WINC_SDIO_XFER *pXferList, size_t numXfers)
+
+  Summary:
+    Sends and receives a list of transfers through the SPI bus.
+
+  Description:
+    This function performs each transfer of the list in turn as a single
+    SPI transaction.
+
+  Remarks:
+    See wdrv_winc_spi.h for usage information.
+
+    The cache rules of WDRV_WINC_SPISendReceive apply to each receive buffer.
+
+ */
+
+bool WDRV_WINC_SPISendReceiveList(const WINC_SDIO_XFER *pXferList, size_t numXfers)
+{
+    if ((false == spiDcpt.isInit) || (false == spiDcpt.isOpen))
+    {
+        return false;
+    }
+
+    if ((NULL == pXferList) || (0U == numXfers))
+    {
+        return false;
+    }
+
+    /* Transfers already queued are completed first. */
+    while (false == WDRV_WINC_SPITransferQueue(pXferList, numXfers, NULL, 0))
+    {
+        (void)WDRV_WINC_SPITransferWait();
+    }
+
+    return WDRV_WINC_SPITransferWait();
+}
+
 //*******************************************************************************
 /*
   Function:
@@ -210,6 +443,12 @@ bool WDRV_WINC_SPIOpen(void)
     spiDcpt.txDMAAddrMode = SYS_DMA_SOURCE_ADDRESSING_MODE_NONE;
     spiDcpt.rxDMAAddrMode = SYS_DMA_DESTINATION_ADDRESSING_MODE_NONE;
 
+    spiDcpt.queueHead  = 0;
+    spiDcpt.queueCount = 0;
+    spiDcpt.xferIdx    = 0;
+    spiDcpt.waiting    = false;
+    spiDcpt.xferFailed = false;
+
     SYS_DMA_ChannelCallbackRegister(spiDcpt.cfg.rxDMAChannel, lDRV_SPI_PlibCallbackHandler, (uintptr_t)&spiDcpt.syncSem);
 
     spiDcpt.isOpen = true;
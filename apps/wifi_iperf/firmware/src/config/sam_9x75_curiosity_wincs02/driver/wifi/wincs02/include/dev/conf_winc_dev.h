@@ -29,5 +29,11 @@ Microchip or any third party.
 
 #define WINC_DEV_CACHE_LINE_SIZE            CACHE_LINE_SIZE
 #define WINC_CONF_ENABLE_NC_BERKELEY_SOCKETS
+#define WINC_CONF_TIME_MS_GET()             ((uint32_t)((SYS_TIME_Counter64Get() * 1000U) / SYS_TIME_FrequencyGet()))
+
+#ifdef WINC_DEV_CAPTURE_ENABLE
+#define WINC_CONF_CAPTURE_TIME_GET()        SYS_TIME_CounterGet()
+#define WINC_CONF_CAPTURE_TIME_FREQ_GET()   SYS_TIME_FrequencyGet()
+#endif
 
 #endif /* CONF_WINC_DEV_H */
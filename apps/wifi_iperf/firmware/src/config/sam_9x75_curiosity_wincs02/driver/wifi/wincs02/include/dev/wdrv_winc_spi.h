@@ -40,6 +40,12 @@
 #ifndef WDRV_WINC_SPI_H
 #define WDRV_WINC_SPI_H
 
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "device.h"
+#include "winc_sdio_drv.h"
+
 // *****************************************************************************
 /*  SPI Configuration Structure
 
@@ -100,6 +106,153 @@ typedef struct
 
 bool WDRV_WINC_SPISendReceive(void* pTransmitData, void* pReceiveData, size_t size);
 
+//*******************************************************************************
+/*
+  Function:
+    bool WDRV_WINC_SPISendReceiveList(const WINC_SDIO_XFER *pXferList, size_t numXfers)
+
+  Summary:
+    Sends and receives a list of transfers through the SPI bus.
+
+  Description:
+    This function performs each transfer of the list in turn as a single
+    SPI transaction. The next transfer is started from the DMA completion
+    interrupt of the previous one and the caller is only woken once the
+    last transfer has completed.
+
+  Precondition:
+    WDRV_WINC_SPIInitialize must have been called.
+
+  Parameters:
+    pXferList - Pointer to list of transfers.
+    numXfers  - Number of transfers in the list.
+
+  Returns:
+    true  - Indicates success.
+    false - Indicates failure.
+
+  Remarks:
+    The list and the buffers it refers to must remain valid until the
+    function returns. Each transfer follows the same rules as
+    WDRV_WINC_SPISendReceive.
+
+ */
+
+bool WDRV_WINC_SPISendReceiveList(const WINC_SDIO_XFER *pXferList, size_t numXfers);
+
+//*******************************************************************************
+/*
+  Function:
+    bool WDRV_WINC_SPITransferQueue
+    (
+        const WINC_SDIO_XFER *pXferList,
+        size_t numXfers,
+        WINC_SDIO_XFER_CALLBACK pfCallback,
+        uintptr_t context
+    )
+
+  Summary:
+    Queues a list of transfers on the SPI bus.
+
+  Description:
+    This function adds a list of transfers to the SPI transfer queue and
+    returns without waiting. Each list is performed as a single SPI
+    transaction once the lists queued before it have completed.
+
+  Precondition:
+    WDRV_WINC_SPIInitialize must have been called.
+
+  Parameters:
+    pXferList  - Pointer to list of transfers.
+    numXfers   - Number of transfers in the list.
+    pfCallback - Function called from interrupt context when the list
+                   completes, or NULL.
+    context    - Context value passed to pfCallback.
+
+  Returns:
+    true  - Indicates success.
+    false - Indicates failure, or the queue is full.
+
+  Remarks:
+    The list and the buffers it refers to must remain valid until the list
+    completes. Each transfer follows the same rules as
+    WDRV_WINC_SPISendReceive.
+
+ */
+
+bool WDRV_WINC_SPITransferQueue
+(
+    const WINC_SDIO_XFER *pXferList,
+    size_t numXfers,
+    WINC_SDIO_XFER_CALLBACK pfCallback,
+    uintptr_t context
+);
+
+//*******************************************************************************
+/*
+  Function:
+    bool WDRV_WINC_SPITransferWait(void)
+
+  Summary:
+    Waits for all queued SPI transfers to complete.
+
+  Description:
+    This function blocks until the SPI transfer queue is empty.
+
+  Precondition:
+    WDRV_WINC_SPIInitialize must have been called.
+
+  Parameters:
+    None.
+
+  Returns:
+    true  - Indicates success.
+    false - Indicates failure of a transfer queued without a callback.
+
+  Remarks:
+    Transfers queued with a callback report their result to the callback.
+
+ */
+
+bool WDRV_WINC_SPITransferWait(void);
+
+#ifdef DMAC_CRCCTRL_CRCSRC_Msk
+#define WDRV_WINC_SPI_SEND_CRC16
+
+//*******************************************************************************
+/*
+  Function:
+    bool WDRV_WINC_SPISendCRC16(void* pTransmitData, size_t size, uint16_t *pCRC16)
+
+  Summary:
+    Sends data to the module and calculates its CRC16.
+
+  Description:
+    This function sends data to the module through the SPI bus while the DMAC
+    CRC engine calculates the CRC16 (CCITT) of the data transferred by the
+    transmit DMA channel.
+
+  Precondition:
+    WDRV_WINC_SPIInitialize must have been called.
+
+  Parameters:
+    pTransmitData - Pointer to buffer containing data to send.
+    size          - The size of the data transfer.
+    pCRC16        - Pointer to receive the CRC16 of the data.
+
+  Returns:
+    true  - Indicates success.
+    false - Indicates failure.
+
+  Remarks:
+    Only available on devices with a DMAC CRC engine. Only called while SDIO
+    CRCs are enabled with WINC_CONF_SDIO_USE_CRC.
+
+ */
+
+bool WDRV_WINC_SPISendCRC16(void* pTransmitData, size_t size, uint16_t *pCRC16);
+#endif
+
 //*******************************************************************************
 /*
   Function:
@@ -0,0 +1,209 @@
+import sys
+import argparse
+
+# Decoder for WINCS02 driver capture dumps produced by WINC_DevCaptureDump.
+#
+# Usage: python winc_capture_decode.py [--interval MS] [--timeline] console.log
+#
+# The console log is scanned for the lines between "WCAP START" and "WCAP END",
+# each capture record is an 8 byte little endian header (type, captured length,
+# original length, timestamp) followed by the captured message bytes.
+
+REC_TYPE_TX_BURST = 1
+REC_TYPE_TX_DATA  = 2
+REC_TYPE_RX_MSG   = 3
+
+MSG_TYPE_NAMES = {0: "REQ", 1: "STATUS", 2: "RSP", 3: "AEC"}
+
+def parse_log(lines):
+    freq    = 0
+    dropped = 0
+    data    = bytearray()
+    active  = False
+
+    for line in lines:
+        pos = line.find("WCAP")
+
+        if pos < 0:
+            continue
+
+        fields = line[pos:].split()
+
+        if len(fields) < 2:
+            continue
+
+        if fields[1] == "START":
+            # Only the most recent dump in the log is decoded.
+            data   = bytearray()
+            active = True
+
+            for f in fields[2:]:
+                k, _, v = f.partition("=")
+
+                if k == "freq":
+                    freq = int(v)
+                elif k == "dropped":
+                    dropped = int(v)
+        elif fields[1] == "END":
+            active = False
+        elif active:
+            data += bytes.fromhex(fields[1])
+
+    return freq, dropped, data
+
+def parse_records(data, freq):
+    records = []
+    offset  = 0
+    base    = 0
+    last    = None
+
+    while offset + 8 <= len(data):
+        rec_type = data[offset]
+        cap_len  = data[offset+1]
+        orig_len = int.from_bytes(data[offset+2:offset+4], "little")
+        ts       = int.from_bytes(data[offset+4:offset+8], "little")
+        payload  = bytes(data[offset+8:offset+8+cap_len])
+        offset  += 8 + cap_len
+
+        # Unwrap the 32-bit timestamp.
+        if last is not None and ts < last:
+            base += 1 << 32
+
+        last = ts
+        ts  += base
+
+        if freq > 0:
+            ts_us = ts * 1000000.0 / freq
+        else:
+            ts_us = float(ts)
+
+        records.append((ts_us, rec_type, orig_len, payload))
+
+    return records
+
+def describe(rec_type, orig_len, payload):
+    if rec_type == REC_TYPE_TX_BURST:
+        msg = int.from_bytes(payload[0:4], "little") if len(payload) >= 4 else 0
+        return "TX burst   cmds=%d first=%d" % ((msg >> 16) & 0xff, msg & 0xffff)
+
+    if len(payload) < 5:
+        return "%s len=%d" % ("TX data" if rec_type == REC_TYPE_TX_DATA else "RX msg", orig_len)
+
+    msg_type = MSG_TYPE_NAMES.get(payload[0], "%d" % payload[0])
+    cmd_id   = (payload[1] << 8) | payload[2]
+    seq_num  = (payload[3] << 8) | payload[4]
+
+    if rec_type == REC_TYPE_TX_DATA:
+        return "TX %-7s id=%04x sn=%04x len=%d" % (msg_type, cmd_id, seq_num, orig_len)
+
+    text = "RX %-7s id=%04x sn=%04x len=%d" % (msg_type, cmd_id, seq_num, orig_len)
+
+    if payload[0] == 1 and len(payload) >= 7:
+        text += " status=%d" % ((payload[5] << 8) | payload[6])
+    elif payload[0] in (2, 3) and len(payload) >= 7:
+        text += " rsp=%04x" % ((payload[5] << 8) | payload[6])
+
+    return text
+
+def command_latency(records):
+    pending = {}
+    latency = {}
+
+    for ts, rec_type, orig_len, payload in records:
+        if len(payload) < 5 or rec_type == REC_TYPE_TX_BURST:
+            continue
+
+        cmd_id  = (payload[1] << 8) | payload[2]
+        seq_num = (payload[3] << 8) | payload[4]
+
+        if rec_type == REC_TYPE_TX_DATA and payload[0] == 0:
+            pending[(cmd_id, seq_num)] = ts
+        elif rec_type == REC_TYPE_RX_MSG and payload[0] == 1:
+            start = pending.pop((cmd_id, seq_num), None)
+
+            if start is not None:
+                latency.setdefault(cmd_id, []).append(ts - start)
+
+    return latency, len(pending)
+
+def bus_utilisation(records, interval_us):
+    buckets = {}
+
+    if not records:
+        return buckets
+
+    start = records[0][0]
+
+    for ts, rec_type, orig_len, payload in records:
+        if rec_type == REC_TYPE_TX_BURST:
+            continue
+
+        b = buckets.setdefault(int((ts - start) // interval_us), [0, 0, 0])
+
+        if rec_type == REC_TYPE_TX_DATA:
+            b[0] += orig_len
+        else:
+            b[1] += orig_len
+
+        b[2] += 1
+
+    return buckets
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode WINCS02 driver capture dumps")
+    parser.add_argument("log", help="console log containing WCAP lines")
+    parser.add_argument("--interval", type=float, default=100.0, help="utilisation interval in ms")
+    parser.add_argument("--timeline", action="store_true", help="print every record")
+    args = parser.parse_args()
+
+    with open(args.log, "r", errors="replace") as f:
+        freq, dropped, data = parse_log(f)
+
+    records = parse_records(data, freq)
+
+    if not records:
+        print("No capture records found")
+        return 1
+
+    unit = "us" if freq > 0 else "ticks"
+
+    print("Records: %d, dropped: %d, timestamp frequency: %d Hz" % (len(records), dropped, freq))
+
+    if args.timeline:
+        print("\nTimeline (%s):" % unit)
+
+        start = records[0][0]
+
+        for ts, rec_type, orig_len, payload in records:
+            print("%12.1f  %s" % (ts - start, describe(rec_type, orig_len, payload)))
+
+    latency, unmatched = command_latency(records)
+
+    print("\nCommand latency (%s):" % unit)
+    print("  %-6s %6s %10s %10s %10s" % ("ID", "count", "min", "avg", "max"))
+
+    for cmd_id in sorted(latency):
+        l = latency[cmd_id]
+        print("  %04x   %6d %10.1f %10.1f %10.1f" % (cmd_id, len(l), min(l), sum(l) / len(l), max(l)))
+
+    if unmatched:
+        print("  %d requests without a status response" % unmatched)
+
+    interval = args.interval * 1000.0
+
+    if freq == 0:
+        interval = args.interval
+
+    print("\nBus utilisation (interval %.1f %s):" % (interval, unit))
+    print("  %10s %10s %10s %8s" % ("start", "tx bytes", "rx bytes", "msgs"))
+
+    buckets = bus_utilisation(records, interval)
+
+    for i in sorted(buckets):
+        b = buckets[i]
+        print("  %10.1f %10d %10d %8d" % (i * interval, b[0], b[1], b[2]))
+
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
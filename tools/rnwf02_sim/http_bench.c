@@ -0,0 +1,616 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+/* HTTP object fetch benchmark against the simulated RNWF02 module.
+
+   The RNWF interface, system, Wi-Fi, NET socket and HTTP client services
+   are built for the host and fetch objects from the simulated HTTP server:
+   - close: a new connection for each object, closed after its response;
+   - keep-alive: one persistent connection, one request at a time;
+   - pipelined: one persistent connection, SYS_RNWF_HTTP_PIPELINE_DEPTH_MAX
+     requests in flight;
+   - range: one large object as pipelined Range requests.
+   Every body byte is checked against the server content. All figures are
+   in simulated time, which depends only on the UART rate, module latency
+   and network settings and is repeatable. */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "definitions.h"
+#include "system/inf/sys_rnwf_interface.h"
+#include "system/sys_rnwf_system_service.h"
+#include "system/wifi/sys_rnwf_wifi_service.h"
+#include "system/net/sys_rnwf_net_service.h"
+#include "system/http/sys_rnwf_http_client.h"
+#include "sim_rnwf_dev.h"
+
+#define BENCH_RX_BUF_SZ             1460U
+#define BENCH_MAX_EXPECT            8U
+
+#define BENCH_WIFI_TIMEOUT_MS       5000U
+#define BENCH_WAIT_TIMEOUT_MS       10000U
+
+#define BENCH_NUM_OBJECTS           64U
+#define BENCH_NUM_OBJECTS_QUICK     16U
+#define BENCH_RANGE_OBJECT_SZ       (256U*1024U)
+#define BENCH_RANGE_OBJECT_SZ_QUICK (64U*1024U)
+#define BENCH_RANGE_SZ              4096U
+
+typedef enum
+{
+    BENCH_MODE_CLOSE,
+    BENCH_MODE_KEEP_ALIVE,
+    BENCH_MODE_PIPELINED
+} BENCH_MODE;
+
+/* A response the server is expected to send, in request order. */
+typedef struct
+{
+    uint32_t    seed;
+    uint32_t    offset;
+    uint32_t    length;
+} BENCH_EXPECT;
+
+typedef struct
+{
+    uint32_t                socket;
+    bool                    connected;
+    bool                    closed;
+    uint32_t                rxPending;
+    bool                    useClient;
+    SYS_RNWF_HTTP_CLIENT_t  client;
+    SYS_RNWF_HTTP_PARSER_t  parser;
+    BENCH_EXPECT            expect[BENCH_MAX_EXPECT];
+    uint32_t                expectHead;
+    uint32_t                expectCount;
+    uint32_t                bodyRx;
+    uint32_t                numDone;
+} BENCH_CONN;
+
+static BENCH_CONN benchConn;
+static bool benchQuick;
+static bool benchDhcpDone;
+static int benchNumFailed;
+
+static uint8_t benchRxBuffer[BENCH_RX_BUF_SZ];
+
+/*****************************************************************************
+                              Utilities
+ *****************************************************************************/
+
+static void benchCheck(bool result, const char *pDesc)
+{
+    if (false == result)
+    {
+        printf("FAIL: %s\n", pDesc);
+        benchNumFailed++;
+    }
+}
+
+static double benchSimMs(uint64_t startNs)
+{
+    return (double)(RNWF_SimTimeNs() - startNs) / 1e6;
+}
+
+static uint32_t benchNumCmds(void)
+{
+    RNWF_SIM_STATS stats;
+
+    RNWF_SimStatsGet(&stats);
+
+    return stats.numCmds;
+}
+
+/*****************************************************************************
+                              Callbacks
+ *****************************************************************************/
+
+static void benchWifiCallback(SYS_RNWF_WIFI_EVENT_t event, SYS_RNWF_WIFI_HANDLE_t *p_str)
+{
+    if (SYS_RNWF_WIFI_DHCP_IPV4_COMPLETE == event)
+    {
+        benchDhcpDone = true;
+    }
+}
+
+static SYS_RNWF_RESULT_t benchSockCallback(uint32_t sock, SYS_RNWF_NET_SOCK_EVENT_t event, SYS_RNWF_NET_HANDLE_t netHandle)
+{
+    if (sock != benchConn.socket)
+    {
+        return SYS_RNWF_PASS;
+    }
+
+    switch (event)
+    {
+        case SYS_RNWF_NET_SOCK_EVENT_CONNECTED:
+        {
+            benchConn.connected = true;
+            break;
+        }
+
+        case SYS_RNWF_NET_SOCK_EVENT_DISCONNECTED:
+        {
+            benchConn.closed = true;
+            break;
+        }
+
+        case SYS_RNWF_NET_SOCK_EVENT_READ:
+        {
+            /* Read from the main loop, not from inside the event handler. */
+            benchConn.rxPending += *(uint16_t*)netHandle;
+            break;
+        }
+
+        default:
+        {
+            benchCheck(false, "socket event");
+            break;
+        }
+    }
+
+    return SYS_RNWF_PASS;
+}
+
+/* Checks each response body against the server content for its request. */
+static void benchHttpCallback(SYS_RNWF_HTTP_EVENT_t event, const SYS_RNWF_HTTP_RESPONSE_t *response, const uint8_t *data, uint32_t length, void *context)
+{
+    BENCH_CONN *pConn = context;
+    BENCH_EXPECT *pExpect = &pConn->expect[pConn->expectHead];
+    uint32_t i;
+
+    if (0U == pConn->expectCount)
+    {
+        benchCheck(false, "unexpected response");
+        return;
+    }
+
+    switch (event)
+    {
+        case SYS_RNWF_HTTP_EVENT_HEADERS_DONE:
+        {
+            pConn->bodyRx = 0;
+
+            if (206U == response->status)
+            {
+                benchCheck(pExpect->offset == response->rangeStart, "range start");
+            }
+            else
+            {
+                benchCheck((200U == response->status) && (0U == pExpect->offset), "response status");
+            }
+            break;
+        }
+
+        case SYS_RNWF_HTTP_EVENT_BODY:
+        {
+            for (i=0; i<length; i++)
+            {
+                if (data[i] != RNWF_SimContentByte(pExpect->seed, pExpect->offset + pConn->bodyRx + i))
+                {
+                    benchCheck(false, "body content");
+                    break;
+                }
+            }
+
+            pConn->bodyRx += length;
+            break;
+        }
+
+        case SYS_RNWF_HTTP_EVENT_RESPONSE_DONE:
+        {
+            benchCheck(pConn->bodyRx == pExpect->length, "body length");
+
+            pConn->expectHead = (pConn->expectHead + 1U) % BENCH_MAX_EXPECT;
+            pConn->expectCount--;
+            pConn->numDone++;
+            break;
+        }
+
+        default:
+        {
+            benchCheck(false, "HTTP response error");
+            break;
+        }
+    }
+}
+
+static void benchExpect(const char *path, uint32_t offset, uint32_t length)
+{
+    BENCH_EXPECT *pExpect = &benchConn.expect[(benchConn.expectHead + benchConn.expectCount) % BENCH_MAX_EXPECT];
+
+    pExpect->seed   = RNWF_SimContentSeed(path);
+    pExpect->offset = offset;
+    pExpect->length = length;
+
+    benchConn.expectCount++;
+}
+
+/*****************************************************************************
+                              Connections
+ *****************************************************************************/
+
+/* Reads announced socket data through the response parser. */
+static void benchReceive(void)
+{
+    uint16_t rxLen = (uint16_t)benchConn.rxPending;
+
+    benchConn.rxPending = 0;
+
+    if (true == benchConn.useClient)
+    {
+        benchCheck(SYS_RNWF_PASS == SYS_RNWF_HTTP_ClientReceive(&benchConn.client, rxLen, benchRxBuffer, sizeof(benchRxBuffer)), "client receive");
+        return;
+    }
+
+    while (rxLen > 0U)
+    {
+        uint16_t readLen = (rxLen > sizeof(benchRxBuffer)) ? (uint16_t)sizeof(benchRxBuffer) : rxLen;
+        int16_t readSize = SYS_RNWF_NET_TcpSockRead(benchConn.socket, readLen, benchRxBuffer);
+
+        if (readSize <= 0)
+        {
+            benchCheck(false, "socket read");
+            return;
+        }
+
+        rxLen -= (uint16_t)readSize;
+
+        benchCheck(SYS_RNWF_PASS == SYS_RNWF_HTTP_ParserFeed(&benchConn.parser, benchRxBuffer, (uint32_t)readSize), "response parse");
+    }
+}
+
+/* Runs the event handler until a condition is met. */
+static bool benchWait(const volatile bool *pFlag, const volatile uint32_t *pCount, uint32_t count)
+{
+    uint32_t deadline = RNWF_SimTimeMs() + BENCH_WAIT_TIMEOUT_MS;
+
+    while (((NULL != pFlag) && (false == *pFlag)) || ((NULL != pCount) && (*pCount < count)))
+    {
+        if (benchConn.rxPending > 0U)
+        {
+            benchReceive();
+        }
+        else if ((int32_t)(RNWF_SimTimeMs() - deadline) >= 0)
+        {
+            benchCheck(false, "wait timeout");
+            return false;
+        }
+        else
+        {
+            SYS_RNWF_IF_EventHandler();
+        }
+    }
+
+    return true;
+}
+
+static bool benchConnect(void)
+{
+    SYS_RNWF_NET_SOCKET_t sock;
+
+    (void)memset(&sock, 0, sizeof(sock));
+
+    sock.bind_type = SYS_RNWF_BIND_REMOTE;
+    sock.sock_type = SYS_RNWF_SOCK_TCP;
+    sock.sock_port = RNWF_SIM_SERVER_PORT;
+    sock.sock_addr = RNWF_SIM_SERVER_ADDR;
+    sock.ip_type   = SYS_RNWF_NET_IPV4;
+
+    benchConn.connected = false;
+    benchConn.closed    = false;
+    benchConn.rxPending = 0;
+
+    if (SYS_RNWF_PASS != SYS_RNWF_NET_SockSrvCtrl(SYS_RNWF_NET_SOCK_TCP_OPEN, &sock))
+    {
+        benchCheck(false, "socket open");
+        return false;
+    }
+
+    benchConn.socket = sock.sock_master;
+
+    return benchWait(&benchConn.connected, NULL, 0);
+}
+
+static void benchClose(void)
+{
+    benchCheck(SYS_RNWF_PASS == SYS_RNWF_NET_SockSrvCtrl(SYS_RNWF_NET_SOCK_CLOSE, &benchConn.socket), "socket close");
+
+    benchConn.socket = 0;
+}
+
+/*****************************************************************************
+                              Benchmarks
+ *****************************************************************************/
+
+static void benchReport(const char *pName, uint32_t count, uint32_t size, uint64_t startNs, uint32_t startCmds)
+{
+    double ms = benchSimMs(startNs);
+
+    printf("%s%u x %5u byte objects, %6.1f ms per object, %6.1f objects/s, %5.1f AT commands per object\n",
+            pName, count, size, ms / count, (count * 1000.0) / ms, (double)(benchNumCmds() - startCmds) / count);
+}
+
+/* Fetches objects one per connection, as a client which does not reuse
+   connections would. */
+static void benchFetchClose(uint32_t count, uint32_t size)
+{
+    uint64_t startNs = RNWF_SimTimeNs();
+    uint32_t startCmds = benchNumCmds();
+    char request[SYS_RNWF_HTTP_REQ_LEN_MAX];
+    char path[64];
+    uint32_t i;
+
+    benchConn.useClient = false;
+    benchConn.numDone   = 0;
+
+    for (i=0; i<count; i++)
+    {
+        size_t reqLen;
+
+        if (false == benchConnect())
+        {
+            return;
+        }
+
+        SYS_RNWF_HTTP_ParserInit(&benchConn.parser, benchHttpCallback, &benchConn);
+
+        (void)snprintf(path, sizeof(path), "/data/%u/close%u", (unsigned)size, (unsigned)i);
+        reqLen = SYS_RNWF_HTTP_RequestFormat(request, sizeof(request), RNWF_SIM_SERVER_ADDR, path, 0, 0, false);
+
+        benchExpect(path, 0, size);
+
+        benchCheck(SYS_RNWF_PASS == SYS_RNWF_NET_TcpSockWrite(benchConn.socket, (uint16_t)reqLen, (uint8_t*)request), "request write");
+
+        if (false == benchWait(NULL, &benchConn.numDone, i + 1U))
+        {
+            return;
+        }
+
+        benchClose();
+    }
+
+    benchReport("http close:      ", count, size, startNs, startCmds);
+}
+
+/* Fetches objects over one persistent connection, with up to depth requests
+   in flight. */
+static void benchFetchPersistent(const char *pName, uint32_t count, uint32_t size, uint8_t depth)
+{
+    uint64_t startNs = RNWF_SimTimeNs();
+    uint32_t startCmds = benchNumCmds();
+    char path[64];
+    uint32_t sent = 0;
+
+    benchConn.useClient = true;
+    benchConn.numDone   = 0;
+
+    if (false == benchConnect())
+    {
+        return;
+    }
+
+    SYS_RNWF_HTTP_ClientInit(&benchConn.client, benchConn.socket, RNWF_SIM_SERVER_ADDR, benchHttpCallback, &benchConn);
+
+    while (benchConn.numDone < count)
+    {
+        while ((sent < count) && (benchConn.client.outstanding < depth))
+        {
+            (void)snprintf(path, sizeof(path), "/data/%u/%s%u", (unsigned)size, pName, (unsigned)sent);
+
+            benchExpect(path, 0, size);
+
+            if (SYS_RNWF_PASS != SYS_RNWF_HTTP_ClientGet(&benchConn.client, path, 0, 0))
+            {
+                benchCheck(false, "client get");
+                return;
+            }
+
+            sent++;
+        }
+
+        if (false == benchWait(NULL, &benchConn.numDone, benchConn.numDone + 1U))
+        {
+            return;
+        }
+    }
+
+    benchClose();
+
+    benchReport((SYS_RNWF_HTTP_PIPELINE_DEPTH_MAX == depth) ? "http pipelined:  " : "http keep-alive: ",
+            count, size, startNs, startCmds);
+}
+
+/* Fetches one object as pipelined Range requests. */
+static void benchFetchRange(uint32_t size)
+{
+    uint64_t startNs = RNWF_SimTimeNs();
+    uint32_t count = size / BENCH_RANGE_SZ;
+    char path[64];
+    uint32_t sent = 0;
+    double ms;
+
+    benchConn.useClient = true;
+    benchConn.numDone   = 0;
+
+    (void)snprintf(path, sizeof(path), "/data/%u/range", (unsigned)size);
+
+    if (false == benchConnect())
+    {
+        return;
+    }
+
+    SYS_RNWF_HTTP_ClientInit(&benchConn.client, benchConn.socket, RNWF_SIM_SERVER_ADDR, benchHttpCallback, &benchConn);
+
+    while (benchConn.numDone < count)
+    {
+        while ((sent < count) && (benchConn.client.outstanding < SYS_RNWF_HTTP_PIPELINE_DEPTH_MAX))
+        {
+            uint32_t offset = sent * BENCH_RANGE_SZ;
+
+            benchExpect(path, offset, BENCH_RANGE_SZ);
+
+            if (SYS_RNWF_PASS != SYS_RNWF_HTTP_ClientGet(&benchConn.client, path, offset, offset + BENCH_RANGE_SZ - 1U))
+            {
+                benchCheck(false, "client range get");
+                return;
+            }
+
+            sent++;
+        }
+
+        if (false == benchWait(NULL, &benchConn.numDone, benchConn.numDone + 1U))
+        {
+            return;
+        }
+    }
+
+    benchClose();
+
+    ms = benchSimMs(startNs);
+
+    printf("http range:      %u KB in %u x %u byte ranges, %.1f KB/s\n",
+            (unsigned)(size / 1024U), (unsigned)count, BENCH_RANGE_SZ, (size / 1024.0) / (ms / 1000.0));
+}
+
+static bool benchInit(void)
+{
+    SYS_RNWF_WIFI_PARAM_t wifi;
+    uint32_t deadline;
+
+    if (SYS_RNWF_PASS != SYS_RNWF_IF_Init())
+    {
+        return false;
+    }
+
+    (void)memset(&wifi, 0, sizeof(wifi));
+
+    wifi.mode        = SYS_RNWF_WIFI_MODE_STA;
+    wifi.ssid        = "rnwf02_sim";
+    wifi.passphrase  = "password";
+    wifi.security    = SYS_RNWF_WIFI_SECURITY_WPA2;
+    wifi.autoconnect = 1;
+
+    SYS_RNWF_WIFI_SrvCtrl(SYS_RNWF_WIFI_SET_CALLBACK, (SYS_RNWF_WIFI_HANDLE_t)benchWifiCallback);
+    SYS_RNWF_NET_SockSrvCtrl(SYS_RNWF_NET_SOCK_SET_CALLBACK, (SYS_RNWF_NET_HANDLE_t)benchSockCallback);
+
+    if (SYS_RNWF_PASS != SYS_RNWF_WIFI_SrvCtrl(SYS_RNWF_SET_WIFI_PARAMS, &wifi))
+    {
+        return false;
+    }
+
+    deadline = RNWF_SimTimeMs() + BENCH_WIFI_TIMEOUT_MS;
+
+    while ((false == benchDhcpDone) && ((int32_t)(RNWF_SimTimeMs() - deadline) < 0))
+    {
+        SYS_RNWF_IF_EventHandler();
+    }
+
+    return benchDhcpDone;
+}
+
+int main(int argc, char *argv[])
+{
+    static const uint32_t sizes[] = {256U, 4096U};
+    RNWF_SIM_CONFIG config;
+    RNWF_SIM_STATS stats;
+    uint32_t count;
+    size_t j;
+    int i;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    (void)memset(&config, 0, sizeof(config));
+
+    config.baud      = 230400U;
+    config.latencyUs = 100U;
+    config.rttUs     = 10000U;
+
+    for (i=1; i<argc; i++)
+    {
+        if (0 == strcmp(argv[i], "--quick"))
+        {
+            benchQuick = true;
+        }
+        else if (0 == strcmp(argv[i], "--verbose"))
+        {
+            RNWF_SimConsoleVerbose(true);
+        }
+        else if ((0 == strcmp(argv[i], "--baud")) && ((i+1) < argc))
+        {
+            config.baud = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "--latency-us")) && ((i+1) < argc))
+        {
+            config.latencyUs = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "--rtt-ms")) && ((i+1) < argc))
+        {
+            config.rttUs = (uint32_t)strtoul(argv[++i], NULL, 0) * 1000U;
+        }
+
+        else
+        {
+            printf("usage: %s [--quick] [--verbose] [--baud N] [--latency-us N] [--rtt-ms N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    RNWF_SimInit(&config);
+
+    printf("UART %u baud, module latency %u us, network rtt %u ms\n", config.baud, config.latencyUs, config.rttUs / 1000U);
+
+    if (false == benchInit())
+    {
+        printf("FAIL: module init\n");
+        return 1;
+    }
+
+    printf("init:            %.1f ms\n", benchSimMs(0));
+
+    count = (true == benchQuick) ? BENCH_NUM_OBJECTS_QUICK : BENCH_NUM_OBJECTS;
+
+    for (j=0; j<(sizeof(sizes)/sizeof(sizes[0])); j++)
+    {
+        benchFetchClose(count, sizes[j]);
+        benchFetchPersistent("keep", count, sizes[j], 1);
+        benchFetchPersistent("pipe", count, sizes[j], SYS_RNWF_HTTP_PIPELINE_DEPTH_MAX);
+    }
+
+    benchFetchRange((true == benchQuick) ? BENCH_RANGE_OBJECT_SZ_QUICK : BENCH_RANGE_OBJECT_SZ);
+
+    RNWF_SimStatsGet(&stats);
+
+    printf("module:          %u commands, %u events, %u connections, %u requests, %llu UART bytes\n",
+            stats.numCmds, stats.numAsync, stats.numConnects, stats.numRequests,
+            (unsigned long long)(stats.uartTxBytes + stats.uartRxBytes));
+
+    benchCheck(0U == stats.numErrors, "module protocol errors");
+    benchCheck(0U == RNWF_SimConsoleErrors(), "service error prints");
+
+    if (0 != benchNumFailed)
+    {
+        printf("%d checks failed\n", benchNumFailed);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,419 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+/* OTA update benchmark against the simulated RNWF02 module.
+
+   The OTA service and the SST26 driver are built for the host and run one
+   update the way app_rnwf02.c does. The image server details are sent to
+   the configuration tunnel, the image is downloaded from the simulated
+   HTTP server and staged in the simulated SST26, then programmed into the
+   module through its programming executive and the module is reset.
+   The staged and programmed images are checked against the server
+   content. All figures are in simulated time and are repeatable. */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "definitions.h"
+#include "system/inf/sys_rnwf_interface.h"
+#include "system/sys_rnwf_system_service.h"
+#include "system/wifi/sys_rnwf_wifi_service.h"
+#include "system/net/sys_rnwf_net_service.h"
+#include "system/ota/sys_rnwf_ota_service.h"
+#include "sim_rnwf_dev.h"
+#include "sim_sst26.h"
+
+#define BENCH_WIFI_TIMEOUT_MS       5000U
+#define BENCH_DWLD_TIMEOUT_MS       600000U
+#define BENCH_DFU_TIMEOUT_MS        1200000U
+
+#define BENCH_IMAGE_SZ              (512U*1024U)
+#define BENCH_IMAGE_SZ_QUICK        (64U*1024U)
+
+/* Region erased by SYS_RNWF_OTA_ProgramDfu(). */
+#define BENCH_DFU_ERASE_SZ          0x84000U
+
+static bool benchQuick;
+static bool benchDhcpDone;
+static bool benchDwldFail;
+static uint32_t benchFlashAddr;
+static int benchNumFailed;
+
+/* The configuration line is read into the second half of the OTA buffer
+   without a terminator, so it must start out zeroed. */
+static uint8_t benchOtaBuf[SYS_RNWF_OTA_BUF_LEN_MAX];
+
+static const DRV_SST26_PLIB_INTERFACE benchSst26PlibAPI = {
+    .writeRead          = (DRV_SST26_PLIB_WRITE_READ)SERCOM6_SPI_WriteRead,
+    .write_t            = (DRV_SST26_PLIB_WRITE)SERCOM6_SPI_Write,
+    .read_t             = (DRV_SST26_PLIB_READ)SERCOM6_SPI_Read,
+    .isBusy             = (DRV_SST26_PLIB_IS_BUSY)SERCOM6_SPI_IsBusy,
+    .callbackRegister   = (DRV_SST26_PLIB_CALLBACK_REGISTER)SERCOM6_SPI_CallbackRegister,
+};
+
+static const DRV_SST26_INIT benchSst26InitData =
+{
+    .sst26Plib      = &benchSst26PlibAPI,
+    .chipSelectPin  = DRV_SST26_CHIP_SELECT_PIN,
+};
+
+/*****************************************************************************
+                              Utilities
+ *****************************************************************************/
+
+static void benchCheck(bool result, const char *pDesc)
+{
+    if (false == result)
+    {
+        printf("FAIL: %s\n", pDesc);
+        benchNumFailed++;
+    }
+}
+
+/* Checks an image copy against the server content, returns the offset of
+   the first byte which differs. */
+static uint32_t benchImageCompare(const uint8_t *pData, uint32_t seed, uint32_t size)
+{
+    uint32_t i;
+
+    for (i=0; i<size; i++)
+    {
+        if (pData[i] != RNWF_SimContentByte(seed, i))
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/*****************************************************************************
+                              Callbacks
+ *****************************************************************************/
+
+static void benchWifiCallback(SYS_RNWF_WIFI_EVENT_t event, SYS_RNWF_WIFI_HANDLE_t *p_str)
+{
+    if (SYS_RNWF_WIFI_DHCP_IPV4_COMPLETE == event)
+    {
+        benchDhcpDone = true;
+    }
+}
+
+/* Stages the image in the SST26 as the application does. */
+static void benchOtaCallback(SYS_RNWF_OTA_EVENT_t event, void *p_str)
+{
+    switch (event)
+    {
+        case SYS_RNWF_OTA_EVENT_DWLD_START:
+        {
+            benchFlashAddr = SYS_RNWF_OTA_FLASH_IMAGE_START;
+
+            benchCheck(SYS_RNWF_OTA_FlashErase(), "SST26 erase");
+            break;
+        }
+
+        case SYS_RNWF_OTA_EVENT_FILE_CHUNK:
+        {
+            SYS_RNWF_OTA_CHUNK_t *pChunk = (SYS_RNWF_OTA_CHUNK_t*)p_str;
+
+            benchCheck(SYS_RNWF_OTA_FlashWrite(benchFlashAddr, pChunk->chunk_size, pChunk->chunk_ptr), "SST26 write");
+
+            benchFlashAddr += pChunk->chunk_size;
+            break;
+        }
+
+        case SYS_RNWF_OTA_EVENT_DWLD_FAIL:
+        {
+            benchDwldFail = true;
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+}
+
+/*****************************************************************************
+                                Update
+ *****************************************************************************/
+
+static bool benchInit(void)
+{
+    SYS_RNWF_WIFI_PARAM_t wifi;
+    uint32_t deadline;
+
+    PORT_Initialize();
+    SERCOM6_SPI_Initialize();
+
+    sysObj.drvSST26 = DRV_SST26_Initialize((SYS_MODULE_INDEX)DRV_SST26_INDEX, (SYS_MODULE_INIT *)&benchSst26InitData);
+
+    if (SYS_RNWF_PASS != SYS_RNWF_IF_Init())
+    {
+        return false;
+    }
+
+    (void)memset(&wifi, 0, sizeof(wifi));
+
+    wifi.mode        = SYS_RNWF_WIFI_MODE_STA;
+    wifi.ssid        = "rnwf02_sim";
+    wifi.passphrase  = "password";
+    wifi.security    = SYS_RNWF_WIFI_SECURITY_WPA2;
+    wifi.autoconnect = 1;
+
+    SYS_RNWF_WIFI_SrvCtrl(SYS_RNWF_WIFI_SET_CALLBACK, (SYS_RNWF_WIFI_HANDLE_t)benchWifiCallback);
+
+    if (SYS_RNWF_PASS != SYS_RNWF_WIFI_SrvCtrl(SYS_RNWF_SET_WIFI_PARAMS, &wifi))
+    {
+        return false;
+    }
+
+    deadline = RNWF_SimTimeMs() + BENCH_WIFI_TIMEOUT_MS;
+
+    while ((false == benchDhcpDone) && ((int32_t)(RNWF_SimTimeMs() - deadline) < 0))
+    {
+        SYS_RNWF_IF_EventHandler();
+    }
+
+    if ((false == benchDhcpDone) || (false == SYS_RNWF_OTA_FlashInitialize()))
+    {
+        return false;
+    }
+
+    SYS_RNWF_OTA_SrvCtrl(SYS_RNWF_OTA_SET_CALLBACK, (void*)benchOtaCallback);
+
+    return (SYS_RNWF_PASS == SYS_RNWF_OTA_SrvCtrl(SYS_RNWF_OTA_ENABLE, benchOtaBuf));
+}
+
+/* Sends the image details to the configuration tunnel and waits for the
+   download to complete. */
+static bool benchDownload(const char *pPath)
+{
+    char conf[128];
+    bool done = false;
+    uint32_t deadline;
+
+    (void)snprintf(conf, sizeof(conf), SYS_RNWF_OTA_CONF_FW_HDR "%u %s %s 0", RNWF_SIM_SERVER_PORT, RNWF_SIM_SERVER_ADDR, pPath);
+
+    if (false == RNWF_SimConnectIn(SYS_RNWF_OTA_CONF_SOCK_PORT, conf, strlen(conf), true))
+    {
+        benchCheck(false, "configuration tunnel connect");
+        return false;
+    }
+
+    deadline = RNWF_SimTimeMs() + BENCH_DWLD_TIMEOUT_MS;
+
+    while ((false == done) && (false == benchDwldFail))
+    {
+        if ((int32_t)(RNWF_SimTimeMs() - deadline) >= 0)
+        {
+            benchCheck(false, "download timeout");
+            return false;
+        }
+
+        SYS_RNWF_IF_EventHandler();
+        SYS_RNWF_OTA_SrvCtrl(SYS_RNWF_OTA_CHECK_DWLD_DONE, &done);
+    }
+
+    benchCheck(false == benchDwldFail, "download");
+
+    return done;
+}
+
+/* Programs the staged image into the module, then resets it. */
+static bool benchProgram(void)
+{
+    bool done = false;
+    uint32_t deadline = RNWF_SimTimeMs() + BENCH_DFU_TIMEOUT_MS;
+
+    while (false == done)
+    {
+        if ((int32_t)(RNWF_SimTimeMs() - deadline) >= 0)
+        {
+            benchCheck(false, "programming timeout");
+            return false;
+        }
+
+        SYS_RNWF_OTA_ProgramDfu();
+        SYS_RNWF_OTA_SrvCtrl(SYS_RNWF_OTA_CHECK_DFU_DONE, &done);
+    }
+
+    SYS_RNWF_OTA_DfuReset();
+
+    return true;
+}
+
+static void benchUpdate(uint32_t size)
+{
+    SYS_RNWF_OTA_STATS_t otaStats;
+    RNWF_SIM_SST26_STATS sst26Stats;
+    RNWF_SIM_STATS stats;
+    const uint8_t *pImage;
+    char path[64];
+    uint32_t seed;
+    uint64_t startNs;
+    uint64_t dwldNs;
+    uint64_t totalNs;
+    uint32_t i;
+
+    (void)snprintf(path, sizeof(path), "/data/%u/image.bin", (unsigned)size);
+
+    seed    = RNWF_SimContentSeed(path);
+    startNs = RNWF_SimTimeNs();
+
+    if (false == benchDownload(path))
+    {
+        return;
+    }
+
+    dwldNs = RNWF_SimTimeNs() - startNs;
+
+    if (false == benchProgram())
+    {
+        return;
+    }
+
+    totalNs = RNWF_SimTimeNs() - startNs;
+
+    (void)memset(&otaStats, 0, sizeof(otaStats));
+    SYS_RNWF_OTA_SrvCtrl(SYS_RNWF_OTA_GET_STATS, &otaStats);
+
+    RNWF_SimSst26StatsGet(&sst26Stats);
+    RNWF_SimStatsGet(&stats);
+
+    benchCheck(size == otaStats.dwld_bytes, "downloaded size");
+    benchCheck(size == benchFlashAddr, "staged size");
+    benchCheck(size == benchImageCompare(&RNWF_SimSst26Data()[SYS_RNWF_OTA_FLASH_IMAGE_START], seed, size), "staged image");
+
+    pImage = RNWF_SimPeFlash(SYS_RNWF_OTA_FLASH_START_ADDRESS - 4U, BENCH_DFU_ERASE_SZ + 4U);
+
+    if (NULL == pImage)
+    {
+        benchCheck(false, "programmed range");
+        return;
+    }
+
+    /* Flash below the image is untouched, past it is left erased. */
+    benchCheck(0U == pImage[0], "flash before image");
+    benchCheck(size == benchImageCompare(&pImage[4], seed, size), "programmed image");
+
+    for (i=size; i<BENCH_DFU_ERASE_SZ; i++)
+    {
+        if (0xffU != pImage[4U + i])
+        {
+            break;
+        }
+    }
+
+    benchCheck(BENCH_DFU_ERASE_SZ == i, "flash after image");
+    benchCheck(stats.numResets > 0U, "module reset");
+
+    printf("ota download:    %u KB, %.1f ms, %.1f KB/s\n", (unsigned)(size / 1024U),
+            (double)dwldNs / 1e6, (size / 1024.0) / ((double)dwldNs / 1e9));
+    printf("ota phases:      download %u ms, staging %u ms, erase %u ms, programming %u ms\n",
+            (unsigned)otaStats.dwld_ms, (unsigned)otaStats.staging_ms, (unsigned)otaStats.erase_ms, (unsigned)otaStats.program_ms);
+    printf("ota total:       %.1f ms, configuration to module reset\n", (double)totalNs / 1e6);
+    printf("sst26:           %u page programs, %u chip erases, %u reads, %llu bytes read, %u busy polls\n",
+            sst26Stats.pagePrograms, sst26Stats.chipErases, sst26Stats.reads,
+            (unsigned long long)sst26Stats.readBytes, sst26Stats.busyPolls);
+    printf("module:          %u PE commands, %u resets, %u connections, %u requests\n",
+            stats.numPeCommands, stats.numResets, stats.numConnects, stats.numRequests);
+
+    benchCheck(0U == stats.numErrors, "module protocol errors");
+    benchCheck(0U == sst26Stats.numErrors, "SST26 command errors");
+}
+
+int main(int argc, char *argv[])
+{
+    RNWF_SIM_CONFIG config;
+    const char *pFlashFile = NULL;
+    int i;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    (void)memset(&config, 0, sizeof(config));
+
+    config.baud      = 230400U;
+    config.latencyUs = 100U;
+    config.rttUs     = 10000U;
+
+    for (i=1; i<argc; i++)
+    {
+        if (0 == strcmp(argv[i], "--quick"))
+        {
+            benchQuick = true;
+        }
+        else if (0 == strcmp(argv[i], "--verbose"))
+        {
+            RNWF_SimConsoleVerbose(true);
+        }
+        else if ((0 == strcmp(argv[i], "--baud")) && ((i+1) < argc))
+        {
+            config.baud = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "--latency-us")) && ((i+1) < argc))
+        {
+            config.latencyUs = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "--rtt-ms")) && ((i+1) < argc))
+        {
+            config.rttUs = (uint32_t)strtoul(argv[++i], NULL, 0) * 1000U;
+        }
+        else if ((0 == strcmp(argv[i], "--flash-file")) && ((i+1) < argc))
+        {
+            pFlashFile = argv[++i];
+        }
+        else
+        {
+            printf("usage: %s [--quick] [--verbose] [--baud N] [--latency-us N] [--rtt-ms N] [--flash-file PATH]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    RNWF_SimInit(&config);
+
+    if (false == RNWF_SimSst26Init(pFlashFile))
+    {
+        printf("FAIL: SST26 flash file %s\n", pFlashFile);
+        return 1;
+    }
+
+    printf("UART %u baud, module latency %u us, network rtt %u ms\n", config.baud, config.latencyUs, config.rttUs / 1000U);
+
+    if (false == benchInit())
+    {
+        printf("FAIL: init\n");
+        return 1;
+    }
+
+    benchUpdate((true == benchQuick) ? BENCH_IMAGE_SZ_QUICK : BENCH_IMAGE_SZ);
+
+    benchCheck(0U == RNWF_SimConsoleErrors(), "service error prints");
+
+    if (0 != benchNumFailed)
+    {
+        printf("%d checks failed\n", benchNumFailed);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+#ifndef CONFIGURATION_H
+#define CONFIGURATION_H
+
+/* Host build configuration for the RNWF02 system services, in place of the
+   Harmony generated configuration.h of sam_e54_xpro_rnwf02. */
+
+#include "device.h"
+
+#define SYS_TIME_INDEX_0                    (0)
+#define SYS_TIME_MAX_TIMERS                 (5)
+#define SYS_TIME_HW_COUNTER_WIDTH           (32)
+#define SYS_TIME_TICK_FREQ_IN_HZ            (1000)
+
+#define SYS_CONSOLE_DEVICE_MAX_INSTANCES    (1U)
+#define SYS_CONSOLE_UART_MAX_INSTANCES      (1U)
+#define SYS_CONSOLE_USB_CDC_MAX_INSTANCES   (0U)
+#define SYS_CONSOLE_PRINT_BUFFER_SIZE       (200U)
+#define SYS_CONSOLE_INDEX_0                 0
+
+/* OTA configuration tunnel on local port 6666 and image server on 8000. */
+#define SYS_RNWF_NET_BIND_TYPE0                 SYS_RNWF_BIND_LOCAL
+#define SYS_RNWF_NET_SOCK_TYPE0                 SYS_RNWF_SOCK_TCP
+#define SYS_RNWF_NET_SOCK_TYPE_IPv4_0           4
+#define SYS_RNWF_NET_SOCK_TYPE_IPv6_LOCAL0      0
+#define SYS_RNWF_NET_SOCK_TYPE_IPv6_GLOBAL0     0
+#define SYS_RNWF_NET_SOCK_PORT0                 6666
+#define SYS_RNWF_TLS_ENABLE0                    0
+
+#define SYS_RNWF_NET_BIND_TYPE1                 SYS_RNWF_BIND_REMOTE
+#define SYS_RNWF_NET_SOCK_TYPE1                 SYS_RNWF_SOCK_TCP
+#define SYS_RNWF_NET_SOCK_TYPE_IPv4_1           4
+#define SYS_RNWF_NET_SOCK_TYPE_IPv6_LOCAL1      0
+#define SYS_RNWF_NET_SOCK_TYPE_IPv6_GLOBAL1     0
+#define SYS_RNWF_NET_SOCK_SERVER_ADDR1          ""
+#define SYS_RNWF_NET_SOCK_PORT1                 8000
+#define SYS_RNWF_TLS_ENABLE1                    0
+
+#define SYS_RNWF_OTA_CONF_SOCK_BIND_TYPE        SYS_RNWF_NET_BIND_TYPE0
+#define SYS_RNWF_OTA_CONF_SOCK_TYPE             SYS_RNWF_NET_SOCK_TYPE0
+#define SYS_RNWF_OTA_CONF_SOCK_PORT             SYS_RNWF_NET_SOCK_PORT0
+#define SYS_RNWF_OTA_CONF_SOCK_TYPE_IPv4        SYS_RNWF_NET_SOCK_TYPE_IPv4_0
+#define SYS_RNWF_OTA_CONF_SOCK_TYPE_IPv6_LOCAL  SYS_RNWF_NET_SOCK_TYPE_IPv6_LOCAL0
+#define SYS_RNWF_OTA_CONF_SOCK_TYPE_IPv6_GLOBAL SYS_RNWF_NET_SOCK_TYPE_IPv6_GLOBAL0
+#define SYS_RNWF_OTA_CONF_SOCK_TLS_ENABLE       SYS_RNWF_TLS_ENABLE0
+
+#define SYS_RNWF_OTA_SERV_SOCK_BIND_TYPE        SYS_RNWF_NET_BIND_TYPE1
+#define SYS_RNWF_OTA_SERV_SOCK_TYPE             SYS_RNWF_NET_SOCK_TYPE1
+#define SYS_RNWF_OTA_SERV_SOCK_PORT             SYS_RNWF_NET_SOCK_PORT1
+#define SYS_RNWF_OTA_SERV_SOCK_TYPE_IPv4        SYS_RNWF_NET_SOCK_TYPE_IPv4_1
+#define SYS_RNWF_OTA_SERV_SOCK_TYPE_IPv6_LOCAL  SYS_RNWF_NET_SOCK_TYPE_IPv6_LOCAL1
+#define SYS_RNWF_OTA_SERV_SOCK_TYPE_IPv6_GLOBAL SYS_RNWF_NET_SOCK_TYPE_IPv6_GLOBAL1
+#define SYS_RNWF_OTA_SERV_SOCK_TLS_ENABLE       SYS_RNWF_TLS_ENABLE1
+
+#define SYS_RNWF_OTA_FLASH_START_ADDRESS        0x600F0000
+
+/* SST26 on SERCOM6, chip select on PC06. */
+#define DRV_SST26_INDEX                     (0U)
+#define DRV_SST26_CLIENTS_NUMBER            (1U)
+#define DRV_SST26_START_ADDRESS             (0x0U)
+#define DRV_SST26_PAGE_SIZE                 (256U)
+#define DRV_SST26_ERASE_BUFFER_SIZE         (4096U)
+#define DRV_SST26_CHIP_SELECT_PIN           SYS_PORT_PIN_PC06
+#define DRV_SST26_QUEUE_SIZE                (20U)
+
+#endif /* CONFIGURATION_H */
@@ -0,0 +1,48 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+#ifndef DEFINITIONS_H
+#define DEFINITIONS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "peripheral/sercom/usart/plib_sercom0_usart.h"
+#include "peripheral/dmac/plib_dmac.h"
+#include "peripheral/sercom/spi_master/plib_sercom6_spi_master.h"
+#include "peripheral/port/plib_port.h"
+#include "driver/sst26/drv_sst26.h"
+#include "system/time/sys_time.h"
+#include "system/console/sys_console.h"
+#include "system/int/sys_int.h"
+#include "system/ports/sys_ports.h"
+
+/* Host build of the RNWF02 system services, in place of the Harmony
+   generated definitions.h. The PLIB and system service functions are
+   provided by sim_rnwf_port.c, the SERCOM6 SPI PLIB by sim_sst26_drv.c. */
+
+typedef struct
+{
+    SYS_MODULE_OBJ  drvSST26;
+    SYS_MODULE_OBJ  sysTime;
+    SYS_MODULE_OBJ  sysConsole0;
+} SYSTEM_OBJECTS;
+
+extern SYSTEM_OBJECTS sysObj;
+
+#endif /* DEFINITIONS_H */
@@ -0,0 +1,105 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+#ifndef DEVICE_H
+#define DEVICE_H
+
+#include <stdint.h>
+
+/* Host build of the RNWF02 system services, in place of the CMSIS device
+   header. Only the registers the services touch directly are provided. */
+
+#define __STATIC_INLINE                     static inline
+#define __ALIGNED(x)                        __attribute__((aligned(x)))
+
+#include "toolchain_specifics.h"
+
+typedef int IRQn_Type;
+
+typedef struct
+{
+    uint32_t    SERCOM_DATA;
+} sercom_usart_int_registers_t;
+
+typedef union
+{
+    sercom_usart_int_registers_t    USART_INT;
+} sercom_registers_t;
+
+/* The interface DMAC channel writes to SERCOM0 DATA. */
+extern sercom_registers_t   RNWF_SimSercom0Regs;
+
+#define SERCOM0_REGS                        (&RNWF_SimSercom0Regs)
+
+/* The OTA service drives the module programming pins and the SST26 driver
+   its chip select through the PORT PLIB, see sim_rnwf_port.c. */
+typedef struct
+{
+    uint32_t    PORT_DIR;
+    uint32_t    PORT_DIRCLR;
+    uint32_t    PORT_DIRSET;
+    uint32_t    PORT_DIRTGL;
+    uint32_t    PORT_OUT;
+    uint32_t    PORT_OUTCLR;
+    uint32_t    PORT_OUTSET;
+    uint32_t    PORT_OUTTGL;
+    uint32_t    PORT_IN;
+    uint32_t    PORT_CTRL;
+    uint32_t    PORT_WRCONFIG;
+    uint32_t    PORT_EVCTRL;
+    uint8_t     PORT_PMUX[16];
+    uint8_t     PORT_PINCFG[32];
+    uint8_t     Reserved1[0x20];
+} port_group_registers_t;
+
+typedef struct
+{
+    port_group_registers_t  GROUP[4];
+} port_registers_t;
+
+extern port_registers_t     RNWF_SimPortRegs;
+
+#define PORT_REGS                           (&RNWF_SimPortRegs)
+#define PORT_BASE_ADDRESS                   (0x41008000U)
+#define PORT_PINCFG_PMUXEN_Msk              (0x1U)
+
+/* Field values used by the SERCOM USART PLIB types, not programmed here. */
+#define SERCOM_USART_INT_STATUS_PERR_Msk                        (0x1U)
+#define SERCOM_USART_INT_STATUS_FERR_Msk                        (0x2U)
+#define SERCOM_USART_INT_STATUS_BUFOVF_Msk                      (0x4U)
+#define SERCOM_USART_INT_CTRLB_CHSIZE_5_BIT                     (0x5U)
+#define SERCOM_USART_INT_CTRLB_CHSIZE_6_BIT                     (0x6U)
+#define SERCOM_USART_INT_CTRLB_CHSIZE_7_BIT                     (0x7U)
+#define SERCOM_USART_INT_CTRLB_CHSIZE_8_BIT                     (0x0U)
+#define SERCOM_USART_INT_CTRLB_CHSIZE_9_BIT                     (0x1U)
+#define SERCOM_USART_INT_CTRLB_PMODE_EVEN                       (0x0U)
+#define SERCOM_USART_INT_CTRLB_PMODE_ODD                        (0x2000U)
+#define SERCOM_USART_INT_CTRLB_SBMODE_1_BIT                     (0x0U)
+#define SERCOM_USART_INT_CTRLB_SBMODE_2_BIT                     (0x40U)
+#define SERCOM_USART_INT_CTRLB_LINCMD_NONE                      (0x0U)
+#define SERCOM_USART_INT_CTRLB_LINCMD_SOFTWARE_CONTROL_TRANSMIT_CMD (0x1000000U)
+#define SERCOM_USART_INT_CTRLB_LINCMD_AUTO_TRANSMIT_CMD         (0x2000000U)
+
+/* Field values used by the SERCOM SPI PLIB types. */
+#define SERCOM_SPIM_CTRLA_CPHA_LEADING_EDGE                     (0x0U)
+#define SERCOM_SPIM_CTRLA_CPHA_TRAILING_EDGE                    (0x10000000U)
+#define SERCOM_SPIM_CTRLA_CPOL_IDLE_LOW                         (0x0U)
+#define SERCOM_SPIM_CTRLA_CPOL_IDLE_HIGH                        (0x20000000U)
+#define SERCOM_SPIM_CTRLB_CHSIZE_8_BIT                          (0x0U)
+#define SERCOM_SPIM_CTRLB_CHSIZE_9_BIT                          (0x1U)
+
+#endif /* DEVICE_H */
@@ -0,0 +1,424 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+/* Platform services for the host build of the RNWF system services.
+
+   Interrupt masking, system time, the console and the SERCOM0 USART and
+   DMAC channel used by the RNWF interface are mapped onto the simulated
+   module. A DMAC transfer sends its bytes at the UART rate and completes
+   before returning. PORT pin levels reach the module programming pins and
+   the chip select of the simulated SST26. */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <strings.h>
+
+#include "definitions.h"
+#include "system/inf/sys_rnwf_interface.h"
+#include "system/sys_rnwf_system_service.h"
+#include "system/net/sys_rnwf_net_service.h"
+#include "system/ota/sys_rnwf_ota_service.h"
+#include "sim_rnwf_dev.h"
+#include "sim_sst26.h"
+
+SYSTEM_OBJECTS sysObj;
+
+sercom_registers_t RNWF_SimSercom0Regs;
+
+port_registers_t RNWF_SimPortRegs;
+
+static bool simPortIntEnabled = true;
+static bool simPortConsoleVerbose;
+static uint32_t simPortConsoleErrors;
+static DMAC_CHANNEL_CALLBACK simPortDmacCallback;
+static uintptr_t simPortDmacContext;
+
+/*****************************************************************************
+                              Interrupts
+ *****************************************************************************/
+
+bool SYS_INT_Disable(void)
+{
+    bool state = simPortIntEnabled;
+
+    simPortIntEnabled = false;
+
+    return state;
+}
+
+void SYS_INT_Restore(bool state)
+{
+    simPortIntEnabled = state;
+}
+
+/*****************************************************************************
+                                 Time
+ *****************************************************************************/
+
+uint32_t SYS_TIME_FrequencyGet(void)
+{
+    return 1000000U;
+}
+
+uint64_t SYS_TIME_Counter64Get(void)
+{
+    return RNWF_SimTimeNs() / 1000U;
+}
+
+uint32_t SYS_TIME_CounterGet(void)
+{
+    return RNWF_SimTimeUs();
+}
+
+uint32_t SYS_TIME_CountToMS(uint32_t count)
+{
+    return count / 1000U;
+}
+
+/* A delay handle holds the simulated time in us at which it expires. */
+SYS_TIME_RESULT SYS_TIME_DelayUS(uint32_t us, SYS_TIME_HANDLE *handle)
+{
+    if (NULL == handle)
+    {
+        return SYS_TIME_ERROR;
+    }
+
+    *handle = (SYS_TIME_HANDLE)((RNWF_SimTimeNs() / 1000U) + us);
+
+    return SYS_TIME_SUCCESS;
+}
+
+SYS_TIME_RESULT SYS_TIME_DelayMS(uint32_t ms, SYS_TIME_HANDLE *handle)
+{
+    return SYS_TIME_DelayUS(ms * 1000U, handle);
+}
+
+/* Delays are only waited for in busy loops, which cannot advance simulated
+   time themselves. An incomplete delay runs it to the expiry, so the next
+   check completes. */
+bool SYS_TIME_DelayIsComplete(SYS_TIME_HANDLE handle)
+{
+    uint64_t expiryNs = (uint64_t)handle * 1000U;
+
+    if (RNWF_SimTimeNs() >= expiryNs)
+    {
+        return true;
+    }
+
+    RNWF_SimAdvance(expiryNs - RNWF_SimTimeNs());
+
+    return false;
+}
+
+/*****************************************************************************
+                                Console
+ *****************************************************************************/
+
+/* Prints are formatted only when verbose. Those reporting a failure are
+   counted either way, so a run can fail on them. */
+void SYS_CONSOLE_Print(const SYS_CONSOLE_HANDLE handle, const char *format, ...)
+{
+    static const char *const failWords[] = {"error", "fail", "didn't match", "not found"};
+    size_t i;
+
+    for (i=0; i<(sizeof(failWords)/sizeof(failWords[0])); i++)
+    {
+        const char *pStr;
+
+        for (pStr=format; '\0' != *pStr; pStr++)
+        {
+            if (0 == strncasecmp(pStr, failWords[i], strlen(failWords[i])))
+            {
+                simPortConsoleErrors++;
+                break;
+            }
+        }
+
+        if ('\0' != *pStr)
+        {
+            break;
+        }
+    }
+
+    if (true == simPortConsoleVerbose)
+    {
+        va_list args;
+
+        va_start(args, format);
+        (void)vprintf(format, args);
+        va_end(args);
+    }
+}
+
+void SYS_CONSOLE_Tasks(SYS_MODULE_OBJ object)
+{
+}
+
+void RNWF_SimConsoleVerbose(bool verbose)
+{
+    simPortConsoleVerbose = verbose;
+}
+
+uint32_t RNWF_SimConsoleErrors(void)
+{
+    return simPortConsoleErrors;
+}
+
+/*****************************************************************************
+                                 USART
+ *****************************************************************************/
+
+void SERCOM0_USART_Initialize(void)
+{
+}
+
+void SERCOM0_USART_Enable(void)
+{
+    RNWF_SimUartEnable(true);
+}
+
+void SERCOM0_USART_Disable(void)
+{
+    RNWF_SimUartEnable(false);
+}
+
+bool SERCOM0_USART_TransmitComplete(void)
+{
+    return true;
+}
+
+size_t SERCOM0_USART_Read(uint8_t* pRdBuffer, const size_t size)
+{
+    return RNWF_SimUartRead(pRdBuffer, size);
+}
+
+size_t SERCOM0_USART_ReadCountGet(void)
+{
+    return RNWF_SimUartReadCount();
+}
+
+/*****************************************************************************
+                                 PORT
+ *****************************************************************************/
+
+/* Output pins are driven from the latch, other pins idle high through a
+   pull-up or their peripheral. */
+static uint32_t simPortLevels(uint32_t group)
+{
+    const port_group_registers_t *pGroup = &RNWF_SimPortRegs.GROUP[group];
+    uint32_t gpioOut = 0;
+    uint32_t pin;
+
+    for (pin=0; pin<32U; pin++)
+    {
+        if (0U == (pGroup->PORT_PINCFG[pin] & PORT_PINCFG_PMUXEN_Msk))
+        {
+            gpioOut |= (pGroup->PORT_DIR & (1UL << pin));
+        }
+    }
+
+    return (pGroup->PORT_OUT & gpioOut) | ~gpioOut;
+}
+
+static bool simPortLevel(uint32_t levels, SYS_PORT_PIN pin)
+{
+    return (0U != (levels & (1UL << ((uint32_t)pin & 0x1fU))));
+}
+
+/* Passes level changes to the pins wired to the simulated devices, the
+   module programming pins and the SST26 chip select. */
+static void simPortUpdate(uint32_t group, uint32_t oldLevels)
+{
+    uint32_t levels = simPortLevels(group);
+
+    RNWF_SimPortRegs.GROUP[group].PORT_IN = levels;
+
+    if (levels == oldLevels)
+    {
+        return;
+    }
+
+    if (((uint32_t)SYS_RNWF_OTA_MCLR_PIN >> 5) == group)
+    {
+        RNWF_SimPinsWrite(simPortLevel(levels, SYS_RNWF_OTA_MCLR_PIN),
+                simPortLevel(levels, SYS_RNWF_OTA_PGC_PIN), simPortLevel(levels, SYS_RNWF_OTA_PGD_PIN));
+    }
+
+    if (((uint32_t)DRV_SST26_CHIP_SELECT_PIN >> 5) == group)
+    {
+        RNWF_SimSst26Select(false == simPortLevel(levels, DRV_SST26_CHIP_SELECT_PIN));
+    }
+}
+
+static port_group_registers_t* simPortGroup(PORT_GROUP group, uint32_t *pIdx)
+{
+    *pIdx = (group - PORT_BASE_ADDRESS) / 0x80U;
+
+    return &RNWF_SimPortRegs.GROUP[*pIdx];
+}
+
+/* The SST26 chip select is an output driven high, as the generated
+   PORT_Initialize() leaves it. */
+void PORT_Initialize(void)
+{
+    uint32_t csGroup = (uint32_t)DRV_SST26_CHIP_SELECT_PIN >> 5;
+    uint32_t group;
+
+    (void)memset(&RNWF_SimPortRegs, 0, sizeof(RNWF_SimPortRegs));
+
+    RNWF_SimPortRegs.GROUP[csGroup].PORT_DIR = 1UL << ((uint32_t)DRV_SST26_CHIP_SELECT_PIN & 0x1fU);
+    RNWF_SimPortRegs.GROUP[csGroup].PORT_OUT = 1UL << ((uint32_t)DRV_SST26_CHIP_SELECT_PIN & 0x1fU);
+
+    for (group=0; group<4U; group++)
+    {
+        RNWF_SimPortRegs.GROUP[group].PORT_IN = simPortLevels(group);
+    }
+}
+
+uint32_t PORT_GroupRead(PORT_GROUP group)
+{
+    uint32_t idx;
+
+    return simPortGroup(group, &idx)->PORT_IN;
+}
+
+uint32_t PORT_GroupLatchRead(PORT_GROUP group)
+{
+    uint32_t idx;
+
+    return simPortGroup(group, &idx)->PORT_OUT;
+}
+
+void PORT_GroupWrite(PORT_GROUP group, uint32_t mask, uint32_t value)
+{
+    uint32_t idx;
+    port_group_registers_t *pGroup = simPortGroup(group, &idx);
+    uint32_t oldLevels = simPortLevels(idx);
+
+    pGroup->PORT_OUT = (pGroup->PORT_OUT & ~mask) | (value & mask);
+
+    simPortUpdate(idx, oldLevels);
+}
+
+void PORT_GroupSet(PORT_GROUP group, uint32_t mask)
+{
+    PORT_GroupWrite(group, mask, mask);
+}
+
+void PORT_GroupClear(PORT_GROUP group, uint32_t mask)
+{
+    PORT_GroupWrite(group, mask, 0);
+}
+
+void PORT_GroupToggle(PORT_GROUP group, uint32_t mask)
+{
+    PORT_GroupWrite(group, mask, ~PORT_GroupLatchRead(group));
+}
+
+void PORT_GroupInputEnable(PORT_GROUP group, uint32_t mask)
+{
+    uint32_t idx;
+    port_group_registers_t *pGroup = simPortGroup(group, &idx);
+    uint32_t oldLevels = simPortLevels(idx);
+
+    pGroup->PORT_DIR &= ~mask;
+
+    simPortUpdate(idx, oldLevels);
+}
+
+void PORT_GroupOutputEnable(PORT_GROUP group, uint32_t mask)
+{
+    uint32_t idx;
+    port_group_registers_t *pGroup = simPortGroup(group, &idx);
+    uint32_t oldLevels = simPortLevels(idx);
+
+    pGroup->PORT_DIR |= mask;
+
+    simPortUpdate(idx, oldLevels);
+}
+
+void PORT_PinPeripheralFunctionConfig(PORT_PIN pin, PERIPHERAL_FUNCTION function)
+{
+    uint32_t idx;
+    port_group_registers_t *pGroup = simPortGroup(GET_PORT_GROUP(pin), &idx);
+    uint32_t oldLevels = simPortLevels(idx);
+    uint32_t pinNum = (uint32_t)pin & 0x1fU;
+    uint8_t pmux = pGroup->PORT_PMUX[pinNum >> 1];
+
+    if (0U != (pinNum & 1U))
+    {
+        pmux = (uint8_t)((pmux & 0x0fU) | ((uint32_t)function << 4));
+    }
+    else
+    {
+        pmux = (uint8_t)((pmux & 0xf0U) | (uint32_t)function);
+    }
+
+    pGroup->PORT_PMUX[pinNum >> 1]  = pmux;
+    pGroup->PORT_PINCFG[pinNum]    |= PORT_PINCFG_PMUXEN_Msk;
+
+    simPortUpdate(idx, oldLevels);
+}
+
+void PORT_PinGPIOConfig(PORT_PIN pin)
+{
+    uint32_t idx;
+    port_group_registers_t *pGroup = simPortGroup(GET_PORT_GROUP(pin), &idx);
+    uint32_t oldLevels = simPortLevels(idx);
+
+    pGroup->PORT_PINCFG[(uint32_t)pin & 0x1fU] &= (uint8_t)~PORT_PINCFG_PMUXEN_Msk;
+
+    simPortUpdate(idx, oldLevels);
+}
+
+/*****************************************************************************
+                                 DMAC
+ *****************************************************************************/
+
+void DMAC_ChannelCallbackRegister(DMAC_CHANNEL channel, const DMAC_CHANNEL_CALLBACK callback, const uintptr_t context)
+{
+    simPortDmacCallback = callback;
+    simPortDmacContext  = context;
+}
+
+/* Only memory to SERCOM0 transfers are used. */
+bool DMAC_ChannelTransfer(DMAC_CHANNEL channel, const void *srcAddr, const void *destAddr, size_t blockSize)
+{
+    if (destAddr != &SERCOM0_REGS->USART_INT.SERCOM_DATA)
+    {
+        RNWF_SimError();
+        return false;
+    }
+
+    RNWF_SimUartWrite(srcAddr, blockSize);
+
+    if (NULL != simPortDmacCallback)
+    {
+        simPortDmacCallback(DMAC_TRANSFER_EVENT_COMPLETE, simPortDmacContext);
+    }
+
+    return true;
+}
+
+bool DMAC_ChannelIsBusy(DMAC_CHANNEL channel)
+{
+    return false;
+}
@@ -0,0 +1,209 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+/* SST26 driver and the SERCOM6 SPI PLIB beneath it, for the host build.
+
+   The driver is built from this file so the PLIB can see whether the
+   request queue is active. Queued requests complete from simulated time
+   events, as the SPI interrupt would, and each byte costs the main loop
+   the interrupt handling time, taken every few bytes. The direct API is
+   waited for in loops which do not advance simulated time, so its
+   transfers complete before the call returns. The handler starts the next transfer of a request
+   before setting its state, so transfers started from the callback are
+   run by the outermost call rather than nested in it.
+
+   DRV_SST26_RequestQueueCount() is polled until the queue drains and
+   costs one poll of the main loop. */
+
+#include "definitions.h"
+
+#define DRV_SST26_RequestQueueCount lDRV_SST26_RequestQueueCountRead
+#include "driver/sst26/src/drv_sst26.c"
+#undef DRV_SST26_RequestQueueCount
+
+#include "sim_rnwf_dev.h"
+#include "sim_sst26.h"
+
+/* Cost of one poll of the queue by the main loop, a short loop at 120 MHz. */
+#define SIM_SST26_POLL_NS               500U
+
+/* SERCOM SPI interrupt handling per byte. */
+#define SIM_SST26_ISR_NS_PER_BYTE       500U
+
+/* Bytes clocked between the interrupt time being taken from the main loop,
+   so a long transfer holds the loop off in short slices. */
+#define SIM_SST26_ISR_SLICE_BYTES       16U
+
+static SERCOM_SPI_CALLBACK simSpiCallback;
+static uintptr_t simSpiContext;
+static bool simSpiBusy;
+static bool simSpiRunning;
+static bool simSpiPending;
+static uint64_t simSpiPendingNs;
+static bool simSpiInIsr;
+static uint64_t simSpiIsrNs;
+static size_t simSpiRemaining;
+
+uint32_t DRV_SST26_RequestQueueCount( const DRV_HANDLE handle )
+{
+    RNWF_SimAdvance(SIM_SST26_POLL_NS);
+
+    return lDRV_SST26_RequestQueueCountRead(handle);
+}
+
+/* Takes the interrupt time owed from the main loop. Transfers ending
+   meanwhile add to it. */
+static void simSpiIsrRun(void)
+{
+    if (true == simSpiInIsr)
+    {
+        return;
+    }
+
+    simSpiInIsr = true;
+
+    while (0U != simSpiIsrNs)
+    {
+        uint64_t isrNs = simSpiIsrNs;
+
+        simSpiIsrNs = 0;
+
+        RNWF_SimAdvance(isrNs);
+    }
+
+    simSpiInIsr = false;
+}
+
+static void simSpiSlice(void *pArg, uint32_t arg);
+
+static bool simSpiSliceSchedule(void)
+{
+    uint32_t length = (simSpiRemaining > SIM_SST26_ISR_SLICE_BYTES) ? SIM_SST26_ISR_SLICE_BYTES : (uint32_t)simSpiRemaining;
+
+    return RNWF_SimSchedule(RNWF_SimSst26TransferNs(length), simSpiSlice, NULL, length);
+}
+
+/* A slice of a queued transfer has been clocked. The interrupt feeds the
+   next bytes, so the bus waits for it. */
+static void simSpiSlice(void *pArg, uint32_t arg)
+{
+    simSpiIsrNs     += (uint64_t)arg * SIM_SST26_ISR_NS_PER_BYTE;
+    simSpiRemaining -= arg;
+
+    if (0U != simSpiRemaining)
+    {
+        simSpiIsrRun();
+        (void)simSpiSliceSchedule();
+        return;
+    }
+
+    simSpiBusy = false;
+
+    if (NULL != simSpiCallback)
+    {
+        simSpiCallback(simSpiContext);
+    }
+
+    simSpiIsrRun();
+}
+
+void SERCOM6_SPI_Initialize(void)
+{
+    simSpiCallback = NULL;
+    simSpiBusy     = false;
+}
+
+bool SERCOM6_SPI_TransferSetup(SPI_TRANSFER_SETUP *setup, uint32_t spiSourceClock)
+{
+    return true;
+}
+
+void SERCOM6_SPI_CallbackRegister(SERCOM_SPI_CALLBACK callBack, uintptr_t context)
+{
+    simSpiCallback = callBack;
+    simSpiContext  = context;
+}
+
+bool SERCOM6_SPI_WriteRead(void* pTransmitData, size_t txSize, void* pReceiveData, size_t rxSize)
+{
+    size_t length = (txSize > rxSize) ? txSize : rxSize;
+
+    if ((true == simSpiBusy) || (0U == length))
+    {
+        return false;
+    }
+
+    RNWF_SimSst26Transfer(pTransmitData, txSize, pReceiveData, rxSize);
+
+    simSpiBusy = true;
+
+    if (true == dObj->queueActive)
+    {
+        simSpiRemaining = length;
+
+        return simSpiSliceSchedule();
+    }
+
+    simSpiPendingNs = RNWF_SimSst26TransferNs(length);
+
+    if (true == simSpiRunning)
+    {
+        simSpiPending = true;
+        return true;
+    }
+
+    simSpiRunning = true;
+
+    do
+    {
+        simSpiPending = false;
+
+        RNWF_SimAdvance(simSpiPendingNs);
+
+        simSpiBusy = false;
+
+        if (NULL != simSpiCallback)
+        {
+            simSpiCallback(simSpiContext);
+        }
+    }
+    while (true == simSpiPending);
+
+    simSpiRunning = false;
+
+    return true;
+}
+
+bool SERCOM6_SPI_Write(void* pTransmitData, size_t txSize)
+{
+    return SERCOM6_SPI_WriteRead(pTransmitData, txSize, NULL, 0);
+}
+
+bool SERCOM6_SPI_Read(void* pReceiveData, size_t rxSize)
+{
+    return SERCOM6_SPI_WriteRead(NULL, 0, pReceiveData, rxSize);
+}
+
+bool SERCOM6_SPI_IsBusy(void)
+{
+    return simSpiBusy;
+}
+
+bool SERCOM6_SPI_IsTransmitterBusy(void)
+{
+    return simSpiBusy;
+}
@@ -0,0 +1,2026 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+/* Simulated RNWF02 module.
+
+   The module sits behind the SERCOM0 USART and DMAC seams of the RNWF
+   interface service and is driven one UART byte at a time. It parses AT
+   command lines, answers them with the framing the interface expects (OK,
+   ERROR, and '#' ahead of binary socket data), and sends asynchronous event
+   lines between commands. Its TCP sockets connect to an HTTP/1.1 server
+   with keep-alive, pipelining and Range requests, and listening sockets
+   accept connections which send given data and discard what they receive.
+
+   The MCLR, PGC and PGD pins follow the host GPIOs. MCLR low resets the
+   module, and the 'MCHP' test pattern clocked in on PGD while it is low
+   starts the programming executive when it is released. The executive
+   answers the page erase, program and identification commands over the
+   same UART, against a flash array which starts out holding 0x00.
+
+   Time is virtual: each UART byte costs ten bit times, each command is
+   answered a fixed module latency after its line ends and each TCP segment
+   pays the link rate and half the round trip. Nothing advances time except
+   UART traffic, host polls of the USART and RNWF_SimAdvance, so results are
+   reproducible across machines. */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdarg.h>
+
+#include "sim_rnwf_dev.h"
+
+#define SIM_DEFAULT_BAUD            230400U
+#define SIM_DEFAULT_LATENCY_US      100U
+#define SIM_DEFAULT_RTT_US          10000U
+#define SIM_DEFAULT_LINK_KBPS       20000U
+#define SIM_DEFAULT_SOCK_BUF_SZ     16384U
+
+/* Cost of one poll of the USART by the host, a short loop at 120 MHz. */
+#define SIM_POLL_NS                 500U
+
+/* SERCOM0_USART_READ_BUFFER_SIZE of the USART PLIB. */
+#define SIM_HOST_RING_SZ            128U
+
+#define SIM_OUT_SZ                  65536U
+#define SIM_LINE_SZ                 512U
+#define SIM_NUM_EVENTS              1024U
+#define SIM_NUM_SOCKETS             16U
+#define SIM_NUM_PEERS               16U
+#define SIM_NUM_ASYNC               64U
+#define SIM_ASYNC_LINE_SZ           128U
+#define SIM_NUM_SEGS                512U
+#define SIM_MAX_ARGS                8U
+#define SIM_HTTP_REQ_SZ             4096U
+
+#define SIM_MSS                     1460U
+#define SIM_SEG_OVERHEAD            40U
+#define SIM_HTTP_BLOCK_SZ           1024U
+
+#define SIM_LOCAL_ADDR              "192.168.1.50"
+#define SIM_EPHEMERAL_PORT          50000U
+
+/* Wi-Fi link up and DHCP completion after AT+WSTA=1. */
+#define SIM_WIFI_LINK_UP_MS         50U
+#define SIM_WIFI_DHCP_MS            100U
+
+/* Programming executive, entered with the 'MCHP' test pattern. */
+#define SIM_PE_KEY                  0x4d434850U
+#define SIM_PE_VERSION              1U
+#define SIM_PE_DEVICE_ID            0x29c70053U
+#define SIM_PE_CMD_PAGE_ERASE       0x05U
+#define SIM_PE_CMD_EXEC_VERSION     0x07U
+#define SIM_PE_CMD_GET_DEVICE_ID    0x0aU
+#define SIM_PE_CMD_PGM_CLUSTER      0x11U
+#define SIM_PE_HDR_SZ               16U
+#define SIM_PE_MAX_WRITE_SZ         4096U
+#define SIM_PE_PAGE_SZ              4096U
+#define SIM_PE_RSP_SZ               8U
+
+/* Executive response time, page erase time and program time per 16 byte
+   quad word. */
+#define SIM_PE_RSP_US               10U
+#define SIM_PE_PAGE_ERASE_US        20000U
+#define SIM_PE_QUAD_WORD_US         30U
+
+typedef enum
+{
+    SIM_SOCK_STATE_FREE,
+    SIM_SOCK_STATE_OPEN,
+    SIM_SOCK_STATE_LISTEN,
+    SIM_SOCK_STATE_CONNECTING,
+    SIM_SOCK_STATE_CONNECTED
+} SIM_SOCK_STATE;
+
+typedef enum
+{
+    SIM_RX_STATE_CMD,
+    SIM_RX_STATE_RAW
+} SIM_RX_STATE;
+
+typedef enum
+{
+    SIM_ASYNC_LINE,
+    SIM_ASYNC_RXT,
+    SIM_ASYNC_CL
+} SIM_ASYNC_TYPE;
+
+typedef struct
+{
+    bool                inUse;
+    uint64_t            dueNs;
+    uint64_t            seq;
+    RNWF_SIM_EVENT_FN   pfFn;
+    void                *pArg;
+    uint32_t            arg;
+} SIM_EVENT;
+
+typedef struct
+{
+    SIM_ASYNC_TYPE  type;
+    uint32_t        connId;
+    char            line[SIM_ASYNC_LINE_SZ];
+} SIM_ASYNC;
+
+/* Growable byte queue. */
+typedef struct
+{
+    uint8_t     *pData;
+    uint32_t    rdIdx;
+    uint32_t    wrIdx;
+    uint32_t    size;
+} SIM_BUF;
+
+typedef struct
+{
+    SIM_SOCK_STATE  state;
+    uint32_t        id;
+    uint32_t        connId;
+    uint16_t        lclPort;
+    uint16_t        rmtPort;
+    char            rmtAddr[40];
+    bool            finRx;
+    bool            clQueued;
+    bool            rxtQueued;
+    uint32_t        rxPending;
+    uint32_t        rxAnnounced;
+    SIM_BUF         rx;
+} SIM_SOCKET;
+
+typedef struct
+{
+    bool        inUse;
+    uint32_t    connId;
+    uint32_t    credit;
+    bool        closeAfter;
+    bool        finSent;
+    bool        discard;
+    uint32_t    reqLen;
+    char        req[SIM_HTTP_REQ_SZ];
+    SIM_BUF     tx;
+} SIM_PEER;
+
+/* A TCP segment, or with no data a FIN or a window update, in flight. */
+typedef struct
+{
+    bool        inUse;
+    uint32_t    connId;
+    uint16_t    length;
+    uint8_t     data[SIM_MSS];
+} SIM_SEG;
+
+typedef struct
+{
+    RNWF_SIM_CONFIG     config;
+    RNWF_SIM_STATS      stats;
+
+    uint64_t            nowNs;
+    uint64_t            byteNs;
+    uint64_t            nextDueNs;
+    uint64_t            eventSeq;
+    uint32_t            numEvents;
+
+    /* Bytes sent to the host, each with its arrival time. */
+    uint32_t            outRdIdx;
+    uint32_t            outWrIdx;
+    uint64_t            outLastNs;
+
+    /* USART receive ring of the host. */
+    bool                uartEnabled;
+    uint32_t            hostRdIdx;
+    uint32_t            hostWrIdx;
+    uint8_t             hostRing[SIM_HOST_RING_SZ];
+
+    /* Command line and binary write from the host. */
+    SIM_RX_STATE        rxState;
+    uint32_t            lineLen;
+    char                line[SIM_LINE_SZ];
+    bool                busy;
+    SIM_SOCKET          *pRawSock;
+    uint32_t            rawRemaining;
+    SIM_BUF             rawData;
+
+    /* Asynchronous events held while a command is in progress. */
+    uint32_t            asyncHead;
+    uint32_t            asyncCount;
+
+    /* Network. */
+    uint64_t            linkUpFreeNs;
+    uint64_t            linkDownFreeNs;
+    uint32_t            nextSockId;
+    uint32_t            nextConnId;
+    uint16_t            nextPort;
+
+    /* Programming pins and executive. */
+    bool                mclr;
+    bool                pgc;
+    uint32_t            pinKey;
+    uint32_t            pinBits;
+    bool                peMode;
+    uint32_t            peHdrLen;
+    uint8_t             peHdr[SIM_PE_HDR_SZ];
+    uint32_t            peDataLen;
+    uint32_t            peRspLen;
+    uint8_t             peRsp[SIM_PE_RSP_SZ];
+} SIM_CTX;
+
+static SIM_CTX      simCtx;
+static SIM_EVENT    simEvents[SIM_NUM_EVENTS];
+static uint8_t      simOut[SIM_OUT_SZ];
+static uint64_t     simOutNs[SIM_OUT_SZ];
+static SIM_ASYNC    simAsync[SIM_NUM_ASYNC];
+static SIM_SOCKET   simSockets[SIM_NUM_SOCKETS];
+static SIM_PEER     simPeers[SIM_NUM_PEERS];
+static SIM_SEG      simSegs[SIM_NUM_SEGS];
+static uint8_t      simPeData[SIM_PE_MAX_WRITE_SZ];
+static uint8_t      simPeFlash[RNWF_SIM_PE_FLASH_SIZE];
+
+static void simAsyncFlush(void);
+static void simSockRxtCheck(SIM_SOCKET *pSock);
+static void simPeerPump(SIM_PEER *pPeer);
+
+/*****************************************************************************
+                                Buffers
+ *****************************************************************************/
+
+static uint32_t simBufLength(const SIM_BUF *pBuf)
+{
+    return pBuf->wrIdx - pBuf->rdIdx;
+}
+
+static void simBufWrite(SIM_BUF *pBuf, const void *pData, uint32_t length)
+{
+    if ((pBuf->wrIdx + length) > pBuf->size)
+    {
+        uint32_t used = simBufLength(pBuf);
+
+        /* Compact first, grow when still short of space. */
+        if (NULL != pBuf->pData)
+        {
+            (void)memmove(pBuf->pData, &pBuf->pData[pBuf->rdIdx], used);
+        }
+
+        pBuf->rdIdx = 0;
+        pBuf->wrIdx = used;
+
+        if ((used + length) > pBuf->size)
+        {
+            uint32_t size = (0U == pBuf->size) ? 4096U : pBuf->size;
+
+            while (size < (used + length))
+            {
+                size *= 2U;
+            }
+
+            pBuf->pData = realloc(pBuf->pData, size);
+            pBuf->size  = size;
+
+            if (NULL == pBuf->pData)
+            {
+                abort();
+            }
+        }
+    }
+
+    (void)memcpy(&pBuf->pData[pBuf->wrIdx], pData, length);
+    pBuf->wrIdx += length;
+}
+
+static uint32_t simBufRead(SIM_BUF *pBuf, void *pData, uint32_t length)
+{
+    uint32_t avail = simBufLength(pBuf);
+
+    if (length > avail)
+    {
+        length = avail;
+    }
+
+    if (NULL != pData)
+    {
+        (void)memcpy(pData, &pBuf->pData[pBuf->rdIdx], length);
+    }
+
+    pBuf->rdIdx += length;
+
+    return length;
+}
+
+static void simBufReset(SIM_BUF *pBuf)
+{
+    pBuf->rdIdx = 0;
+    pBuf->wrIdx = 0;
+}
+
+/*****************************************************************************
+                                Events
+ *****************************************************************************/
+
+static void simEventNextDue(void)
+{
+    uint32_t i;
+
+    simCtx.nextDueNs = UINT64_MAX;
+
+    for (i=0; i<simCtx.numEvents; i++)
+    {
+        if ((true == simEvents[i].inUse) && (simEvents[i].dueNs < simCtx.nextDueNs))
+        {
+            simCtx.nextDueNs = simEvents[i].dueNs;
+        }
+    }
+}
+
+/* Run events in time order up to the given time, which becomes the new
+   simulated time. */
+static void simRunUntil(uint64_t untilNs)
+{
+    while (simCtx.nextDueNs <= untilNs)
+    {
+        SIM_EVENT *pNext = NULL;
+        SIM_EVENT event;
+        uint32_t i;
+
+        for (i=0; i<simCtx.numEvents; i++)
+        {
+            if ((true == simEvents[i].inUse) && (simEvents[i].dueNs == simCtx.nextDueNs))
+            {
+                if ((NULL == pNext) || (simEvents[i].seq < pNext->seq))
+                {
+                    pNext = &simEvents[i];
+                }
+            }
+        }
+
+        event = *pNext;
+        pNext->inUse = false;
+
+        if (event.dueNs > simCtx.nowNs)
+        {
+            simCtx.nowNs = event.dueNs;
+        }
+
+        simEventNextDue();
+
+        event.pfFn(event.pArg, event.arg);
+    }
+
+    if (untilNs > simCtx.nowNs)
+    {
+        simCtx.nowNs = untilNs;
+    }
+}
+
+/*****************************************************************************
+                               UART Link
+ *****************************************************************************/
+
+/* Queue bytes to the host, they arrive one byte time apart. */
+static void simOutWrite(const void *pData, uint32_t length)
+{
+    const uint8_t *pBytes = pData;
+    uint32_t i;
+
+    for (i=0; i<length; i++)
+    {
+        uint64_t arrivalNs;
+
+        if ((simCtx.outWrIdx - simCtx.outRdIdx) >= SIM_OUT_SZ)
+        {
+            simCtx.stats.numErrors++;
+            return;
+        }
+
+        arrivalNs = (simCtx.outLastNs > simCtx.nowNs) ? simCtx.outLastNs : simCtx.nowNs;
+        arrivalNs += simCtx.byteNs;
+
+        simOut[simCtx.outWrIdx % SIM_OUT_SZ]   = pBytes[i];
+        simOutNs[simCtx.outWrIdx % SIM_OUT_SZ] = arrivalNs;
+
+        simCtx.outWrIdx++;
+        simCtx.outLastNs = arrivalNs;
+    }
+}
+
+static void simOutString(const char *pStr)
+{
+    simOutWrite(pStr, (uint32_t)strlen(pStr));
+}
+
+/* Move bytes which have arrived into the host receive ring, as its receive
+   interrupt would have done. */
+static void simOutDeliver(void)
+{
+    while ((simCtx.outRdIdx != simCtx.outWrIdx) && (simOutNs[simCtx.outRdIdx % SIM_OUT_SZ] <= simCtx.nowNs))
+    {
+        if (true == simCtx.uartEnabled)
+        {
+            if ((simCtx.hostWrIdx - simCtx.hostRdIdx) >= SIM_HOST_RING_SZ)
+            {
+                /* Receive ring overflow, the byte is lost. */
+                simCtx.stats.numErrors++;
+            }
+            else
+            {
+                simCtx.hostRing[simCtx.hostWrIdx % SIM_HOST_RING_SZ] = simOut[simCtx.outRdIdx % SIM_OUT_SZ];
+                simCtx.hostWrIdx++;
+            }
+        }
+
+        simCtx.outRdIdx++;
+        simCtx.stats.uartRxBytes++;
+    }
+}
+
+/*****************************************************************************
+                           Asynchronous Events
+ *****************************************************************************/
+
+static SIM_ASYNC* simAsyncAdd(SIM_ASYNC_TYPE type, uint32_t connId)
+{
+    SIM_ASYNC *pAsync;
+
+    if (simCtx.asyncCount >= SIM_NUM_ASYNC)
+    {
+        simCtx.stats.numErrors++;
+        return NULL;
+    }
+
+    pAsync = &simAsync[(simCtx.asyncHead + simCtx.asyncCount) % SIM_NUM_ASYNC];
+    simCtx.asyncCount++;
+
+    pAsync->type    = type;
+    pAsync->connId  = connId;
+    pAsync->line[0] = '\0';
+
+    return pAsync;
+}
+
+static void simAsyncLine(const char *pLine)
+{
+    SIM_ASYNC *pAsync = simAsyncAdd(SIM_ASYNC_LINE, 0);
+
+    if (NULL != pAsync)
+    {
+        (void)snprintf(pAsync->line, sizeof(pAsync->line), "%s", pLine);
+    }
+
+    simAsyncFlush();
+}
+
+static SIM_SOCKET* simSockFindConn(uint32_t connId)
+{
+    uint32_t i;
+
+    for (i=0; i<SIM_NUM_SOCKETS; i++)
+    {
+        if ((SIM_SOCK_STATE_FREE != simSockets[i].state) && (connId == simSockets[i].connId))
+        {
+            return &simSockets[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* Send held event lines, unless a command or binary transfer is in
+   progress. The interface only recognises event lines between responses.
+   A socket receive event carries every byte received since the last one. */
+static void simAsyncFlush(void)
+{
+    while ((false == simCtx.busy) && (simCtx.asyncCount > 0U))
+    {
+        SIM_ASYNC *pAsync = &simAsync[simCtx.asyncHead];
+        SIM_SOCKET *pSock = NULL;
+        char line[SIM_ASYNC_LINE_SZ + 8U];
+
+        simCtx.asyncHead = (simCtx.asyncHead + 1U) % SIM_NUM_ASYNC;
+        simCtx.asyncCount--;
+
+        line[0] = '\0';
+
+        if (SIM_ASYNC_LINE != pAsync->type)
+        {
+            pSock = simSockFindConn(pAsync->connId);
+
+            if (NULL == pSock)
+            {
+                continue;
+            }
+        }
+
+        switch (pAsync->type)
+        {
+            case SIM_ASYNC_LINE:
+            {
+                (void)snprintf(line, sizeof(line), "\r+%s\r\n", pAsync->line);
+                break;
+            }
+
+            case SIM_ASYNC_RXT:
+            {
+                pSock->rxtQueued    = false;
+                pSock->rxAnnounced += pSock->rxPending;
+
+                (void)snprintf(line, sizeof(line), "\r+SOCKRXT:%u,%u\r\n", (unsigned)pSock->id, (unsigned)pSock->rxPending);
+
+                pSock->rxPending = 0;
+                break;
+            }
+
+            case SIM_ASYNC_CL:
+            {
+                (void)snprintf(line, sizeof(line), "\r+SOCKCL:%u\r\n", (unsigned)pSock->id);
+                break;
+            }
+        }
+
+        simOutString(line);
+        simCtx.stats.numAsync++;
+    }
+}
+
+/*****************************************************************************
+                                Sockets
+ *****************************************************************************/
+
+static SIM_SOCKET* simSockFind(uint32_t id)
+{
+    uint32_t i;
+
+    for (i=0; i<SIM_NUM_SOCKETS; i++)
+    {
+        if ((SIM_SOCK_STATE_FREE != simSockets[i].state) && (id == simSockets[i].id))
+        {
+            return &simSockets[i];
+        }
+    }
+
+    return NULL;
+}
+
+static SIM_SOCKET* simSockAlloc(void)
+{
+    uint32_t i;
+
+    for (i=0; i<SIM_NUM_SOCKETS; i++)
+    {
+        SIM_SOCKET *pSock = &simSockets[i];
+
+        if (SIM_SOCK_STATE_FREE == pSock->state)
+        {
+            SIM_BUF rx = pSock->rx;
+
+            (void)memset(pSock, 0, sizeof(SIM_SOCKET));
+
+            simBufReset(&rx);
+
+            pSock->state = SIM_SOCK_STATE_OPEN;
+            pSock->id    = simCtx.nextSockId++;
+            pSock->rx    = rx;
+
+            return pSock;
+        }
+    }
+
+    simCtx.stats.numErrors++;
+
+    return NULL;
+}
+
+static SIM_PEER* simPeerFind(uint32_t connId)
+{
+    uint32_t i;
+
+    for (i=0; i<SIM_NUM_PEERS; i++)
+    {
+        if ((true == simPeers[i].inUse) && (connId == simPeers[i].connId))
+        {
+            return &simPeers[i];
+        }
+    }
+
+    return NULL;
+}
+
+static SIM_SEG* simSegAlloc(uint32_t connId)
+{
+    uint32_t i;
+
+    for (i=0; i<SIM_NUM_SEGS; i++)
+    {
+        if (false == simSegs[i].inUse)
+        {
+            simSegs[i].inUse  = true;
+            simSegs[i].connId = connId;
+            simSegs[i].length = 0;
+
+            return &simSegs[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* Time for a segment to cross the link, from the time the link is free. */
+static uint64_t simSegSendNs(uint64_t *pFreeNs, uint32_t length)
+{
+    uint64_t startNs = (*pFreeNs > simCtx.nowNs) ? *pFreeNs : simCtx.nowNs;
+
+    *pFreeNs = startNs + ((uint64_t)(length + SIM_SEG_OVERHEAD) * 8000000U / simCtx.config.linkKbps);
+
+    return *pFreeNs + (simCtx.config.rttUs * 500ULL) - simCtx.nowNs;
+}
+
+/* Announce received data, one receive event at a time per socket. The next
+   is sent once the host has read the bytes of the last. A peer close is
+   reported when everything before it has been read. */
+static void simSockRxtCheck(SIM_SOCKET *pSock)
+{
+    if ((0U != pSock->rxAnnounced) || (true == pSock->rxtQueued) || (true == pSock->clQueued))
+    {
+        return;
+    }
+
+    if (0U != pSock->rxPending)
+    {
+        if (NULL != simAsyncAdd(SIM_ASYNC_RXT, pSock->connId))
+        {
+            pSock->rxtQueued = true;
+        }
+    }
+    else if (true == pSock->finRx)
+    {
+        if (NULL != simAsyncAdd(SIM_ASYNC_CL, pSock->connId))
+        {
+            pSock->clQueued = true;
+        }
+    }
+    else
+    {
+        return;
+    }
+
+    simAsyncFlush();
+}
+
+/* A segment from the server reaches the module. */
+static void simSockSegArrive(void *pArg, uint32_t arg)
+{
+    SIM_SEG *pSeg = pArg;
+    SIM_SOCKET *pSock = simSockFindConn(pSeg->connId);
+
+    pSeg->inUse = false;
+
+    if (NULL != pSock)
+    {
+        if (0U == pSeg->length)
+        {
+            pSock->finRx = true;
+        }
+        else
+        {
+            if ((simBufLength(&pSock->rx) + pSeg->length) > simCtx.config.sockBufSz)
+            {
+                /* The server overran the advertised window. */
+                simCtx.stats.numErrors++;
+            }
+
+            simBufWrite(&pSock->rx, pSeg->data, pSeg->length);
+            pSock->rxPending += pSeg->length;
+            simCtx.stats.sockRxBytes += pSeg->length;
+        }
+
+        simSockRxtCheck(pSock);
+    }
+
+    /* A freed segment may let a stalled server continue. */
+    for (arg=0; arg<SIM_NUM_PEERS; arg++)
+    {
+        if (true == simPeers[arg].inUse)
+        {
+            simPeerPump(&simPeers[arg]);
+        }
+    }
+}
+
+static void simSockConnected(void *pArg, uint32_t arg)
+{
+    SIM_SOCKET *pSock = simSockFindConn(arg);
+    SIM_PEER *pPeer;
+    char line[SIM_ASYNC_LINE_SZ];
+
+    if ((NULL == pSock) || (SIM_SOCK_STATE_CONNECTING != pSock->state))
+    {
+        return;
+    }
+
+    pSock->state = SIM_SOCK_STATE_CONNECTED;
+
+    (void)snprintf(line, sizeof(line), "SOCKIND:%u,\"%s\",%u,\"%s\",%u", (unsigned)pSock->id,
+            SIM_LOCAL_ADDR, pSock->lclPort, pSock->rmtAddr, pSock->rmtPort);
+
+    simAsyncLine(line);
+
+    /* An accepted connection sends its data once it is reported. */
+    pPeer = simPeerFind(pSock->connId);
+
+    if (NULL != pPeer)
+    {
+        simPeerPump(pPeer);
+    }
+}
+
+static void simSockClose(SIM_SOCKET *pSock)
+{
+    SIM_PEER *pPeer = simPeerFind(pSock->connId);
+
+    if (NULL != pPeer)
+    {
+        pPeer->inUse = false;
+    }
+
+    pSock->state = SIM_SOCK_STATE_FREE;
+}
+
+/*****************************************************************************
+                              HTTP Server
+ *****************************************************************************/
+
+static SIM_PEER* simPeerAlloc(uint32_t connId)
+{
+    uint32_t i;
+
+    for (i=0; i<SIM_NUM_PEERS; i++)
+    {
+        SIM_PEER *pPeer = &simPeers[i];
+
+        if (false == pPeer->inUse)
+        {
+            SIM_BUF tx = pPeer->tx;
+
+            (void)memset(pPeer, 0, sizeof(SIM_PEER));
+
+            simBufReset(&tx);
+
+            pPeer->inUse  = true;
+            pPeer->connId = connId;
+            pPeer->credit = simCtx.config.sockBufSz;
+            pPeer->tx     = tx;
+
+            return pPeer;
+        }
+    }
+
+    simCtx.stats.numErrors++;
+
+    return NULL;
+}
+
+/* Send queued response bytes while the receive window allows, then the FIN
+   of a response which closes the connection. */
+static void simPeerPump(SIM_PEER *pPeer)
+{
+    while ((pPeer->credit > 0U) && (simBufLength(&pPeer->tx) > 0U))
+    {
+        uint32_t length = simBufLength(&pPeer->tx);
+        SIM_SEG *pSeg;
+
+        length = (length > SIM_MSS) ? SIM_MSS : length;
+        length = (length > pPeer->credit) ? pPeer->credit : length;
+
+        pSeg = simSegAlloc(pPeer->connId);
+
+        if (NULL == pSeg)
+        {
+            return;
+        }
+
+        pSeg->length = (uint16_t)simBufRead(&pPeer->tx, pSeg->data, length);
+        pPeer->credit -= length;
+
+        (void)RNWF_SimSchedule(simSegSendNs(&simCtx.linkDownFreeNs, length), simSockSegArrive, pSeg, 0);
+    }
+
+    if ((true == pPeer->closeAfter) && (false == pPeer->finSent) && (0U == simBufLength(&pPeer->tx)))
+    {
+        SIM_SEG *pSeg = simSegAlloc(pPeer->connId);
+
+        if (NULL != pSeg)
+        {
+            pPeer->finSent = true;
+
+            (void)RNWF_SimSchedule(simSegSendNs(&simCtx.linkDownFreeNs, 0), simSockSegArrive, pSeg, 0);
+        }
+    }
+}
+
+/* A window update from the module reaches the server. */
+static void simPeerWindow(void *pArg, uint32_t arg)
+{
+    SIM_SEG *pSeg = pArg;
+    SIM_PEER *pPeer = simPeerFind(pSeg->connId);
+
+    pSeg->inUse = false;
+
+    if (NULL != pPeer)
+    {
+        pPeer->credit += arg;
+
+        simPeerPump(pPeer);
+    }
+}
+
+static void simPeerPrintf(SIM_PEER *pPeer, const char *pFormat, ...) __attribute__((format(printf, 2, 3)));
+
+static void simPeerPrintf(SIM_PEER *pPeer, const char *pFormat, ...)
+{
+    char text[256];
+    va_list args;
+    int length;
+
+    va_start(args, pFormat);
+    length = vsnprintf(text, sizeof(text), pFormat, args);
+    va_end(args);
+
+    simBufWrite(&pPeer->tx, text, (uint32_t)length);
+}
+
+static void simPeerContent(SIM_PEER *pPeer, uint32_t seed, uint32_t offset, uint32_t length)
+{
+    uint8_t block[SIM_HTTP_BLOCK_SZ];
+
+    while (length > 0U)
+    {
+        uint32_t blockLen = (length > SIM_HTTP_BLOCK_SZ) ? SIM_HTTP_BLOCK_SZ : length;
+        uint32_t i;
+
+        for (i=0; i<blockLen; i++)
+        {
+            block[i] = RNWF_SimContentByte(seed, offset + i);
+        }
+
+        simBufWrite(&pPeer->tx, block, blockLen);
+
+        offset += blockLen;
+        length -= blockLen;
+    }
+}
+
+/* Case insensitive search for a header, returns its value. */
+static const char* simHttpHeader(const char *pReq, const char *pName)
+{
+    size_t nameLen = strlen(pName);
+    const char *pLine = strstr(pReq, "\r\n");
+
+    while ((NULL != pLine) && ('\0' != pLine[2]))
+    {
+        pLine += 2;
+
+        if ((0 == strncasecmp(pLine, pName, nameLen)) && (':' == pLine[nameLen]))
+        {
+            pLine += nameLen + 1U;
+
+            while (' ' == *pLine)
+            {
+                pLine++;
+            }
+
+            return pLine;
+        }
+
+        pLine = strstr(pLine, "\r\n");
+    }
+
+    return NULL;
+}
+
+/* Objects are served as /data/<size>/<name>, with body bytes derived from
+   the path. */
+static void simHttpRequest(SIM_PEER *pPeer, const char *pReq)
+{
+    const char *pValue;
+    char path[200];
+    unsigned long size = 0;
+    unsigned long first;
+    unsigned long last;
+    uint32_t seed;
+
+    simCtx.stats.numRequests++;
+
+    if (1 != sscanf(pReq, "GET %199s HTTP/1.1", path))
+    {
+        simCtx.stats.numErrors++;
+        pPeer->closeAfter = true;
+        return;
+    }
+
+    pValue = simHttpHeader(pReq, "Connection");
+
+    if ((NULL != pValue) && (0 == strncasecmp(pValue, "close", 5)))
+    {
+        pPeer->closeAfter = true;
+    }
+
+    if (1 != sscanf(path, "/data/%lu/", &size))
+    {
+        simCtx.stats.numErrors++;
+        simPeerPrintf(pPeer, "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n");
+        return;
+    }
+
+    seed  = RNWF_SimContentSeed(path);
+    first = 0;
+    last  = (size > 0U) ? (size - 1U) : 0U;
+
+    pValue = simHttpHeader(pReq, "Range");
+
+    if (NULL != pValue)
+    {
+        if ((2 != sscanf(pValue, "bytes=%lu-%lu", &first, &last)) || (first > last) || (last >= size))
+        {
+            simCtx.stats.numErrors++;
+            simPeerPrintf(pPeer, "HTTP/1.1 416 Range Not Satisfiable\r\nContent-Length: 0\r\n\r\n");
+            return;
+        }
+
+        simPeerPrintf(pPeer, "HTTP/1.1 206 Partial Content\r\nContent-Range: bytes %lu-%lu/%lu\r\nContent-Length: %lu\r\n",
+                first, last, size, last - first + 1U);
+    }
+    else
+    {
+        simPeerPrintf(pPeer, "HTTP/1.1 200 OK\r\nContent-Length: %lu\r\n", size);
+    }
+
+    simPeerPrintf(pPeer, "Connection: %s\r\n\r\n", (true == pPeer->closeAfter) ? "close" : "keep-alive");
+
+    if (size > 0U)
+    {
+        simPeerContent(pPeer, seed, (uint32_t)first, (uint32_t)(last - first + 1U));
+    }
+}
+
+/* Request bytes reach the server, complete requests are answered in
+   order. */
+static void simPeerReceive(void *pArg, uint32_t arg)
+{
+    SIM_SEG *pSeg = pArg;
+    SIM_PEER *pPeer = simPeerFind(pSeg->connId);
+    char *pEnd;
+
+    pSeg->inUse = false;
+
+    if ((NULL == pPeer) || (true == pPeer->discard))
+    {
+        return;
+    }
+
+    if ((pPeer->reqLen + pSeg->length) >= SIM_HTTP_REQ_SZ)
+    {
+        simCtx.stats.numErrors++;
+        return;
+    }
+
+    (void)memcpy(&pPeer->req[pPeer->reqLen], pSeg->data, pSeg->length);
+    pPeer->reqLen += pSeg->length;
+    pPeer->req[pPeer->reqLen] = '\0';
+
+    while ((false == pPeer->closeAfter) && (NULL != (pEnd = strstr(pPeer->req, "\r\n\r\n"))))
+    {
+        uint32_t reqLen = (uint32_t)(pEnd - pPeer->req) + 4U;
+
+        pEnd[2] = '\0';
+
+        simHttpRequest(pPeer, pPeer->req);
+
+        (void)memmove(pPeer->req, &pPeer->req[reqLen], pPeer->reqLen - reqLen + 1U);
+        pPeer->reqLen -= reqLen;
+    }
+
+    simPeerPump(pPeer);
+}
+
+/*****************************************************************************
+                              AT Commands
+ *****************************************************************************/
+
+typedef struct
+{
+    uint8_t     numArgs;
+    char        *pArgs[SIM_MAX_ARGS];
+} SIM_ARGS;
+
+static unsigned long simArgUInt(const SIM_ARGS *pArgs, uint8_t idx)
+{
+    if (idx >= pArgs->numArgs)
+    {
+        simCtx.stats.numErrors++;
+        return 0;
+    }
+
+    return strtoul(pArgs->pArgs[idx], NULL, 10);
+}
+
+static void simCmdOK(void)
+{
+    simOutString("OK\r\n");
+}
+
+static void simCmdError(void)
+{
+    simCtx.stats.numErrors++;
+
+    simOutString("ERROR:0.2,\"Invalid Parameter\"\r\n");
+}
+
+static void simCmdWSTA(const SIM_ARGS *pArgs);
+static void simCmdSOCKO(const SIM_ARGS *pArgs);
+static void simCmdSOCKBL(const SIM_ARGS *pArgs);
+static void simCmdSOCKBR(const SIM_ARGS *pArgs);
+static void simCmdSOCKWR(const SIM_ARGS *pArgs);
+static void simCmdSOCKRD(const SIM_ARGS *pArgs);
+static void simCmdSOCKCL(const SIM_ARGS *pArgs);
+
+static void simWifiEvent(void *pArg, uint32_t arg)
+{
+    if (0U == arg)
+    {
+        simAsyncLine("WSTALU:1,\"02:00:00:00:00:01\",6");
+    }
+    else
+    {
+        simAsyncLine("WSTAAIP:1,\"" SIM_LOCAL_ADDR "\"");
+    }
+}
+
+static void simCmdWSTA(const SIM_ARGS *pArgs)
+{
+    simCmdOK();
+
+    if (1U == simArgUInt(pArgs, 0))
+    {
+        (void)RNWF_SimSchedule(SIM_WIFI_LINK_UP_MS * 1000000ULL, simWifiEvent, NULL, 0);
+        (void)RNWF_SimSchedule(SIM_WIFI_DHCP_MS * 1000000ULL, simWifiEvent, NULL, 1);
+    }
+}
+
+static void simCmdSOCKO(const SIM_ARGS *pArgs)
+{
+    SIM_SOCKET *pSock = simSockAlloc();
+    char rsp[32];
+
+    if (NULL == pSock)
+    {
+        simCmdError();
+        return;
+    }
+
+    (void)snprintf(rsp, sizeof(rsp), "+SOCKO:%u\r\n", (unsigned)pSock->id);
+    simOutString(rsp);
+    simCmdOK();
+}
+
+static void simCmdSOCKBL(const SIM_ARGS *pArgs)
+{
+    SIM_SOCKET *pSock = simSockFind((uint32_t)simArgUInt(pArgs, 0));
+
+    if (NULL == pSock)
+    {
+        simCmdError();
+        return;
+    }
+
+    pSock->state   = SIM_SOCK_STATE_LISTEN;
+    pSock->lclPort = (uint16_t)simArgUInt(pArgs, 1);
+
+    simCmdOK();
+}
+
+static void simCmdSOCKBR(const SIM_ARGS *pArgs)
+{
+    SIM_SOCKET *pSock = simSockFind((uint32_t)simArgUInt(pArgs, 0));
+
+    if ((NULL == pSock) || (pArgs->numArgs < 3U))
+    {
+        simCmdError();
+        return;
+    }
+
+    (void)snprintf(pSock->rmtAddr, sizeof(pSock->rmtAddr), "%s", pArgs->pArgs[1]);
+    pSock->rmtPort = (uint16_t)simArgUInt(pArgs, 2);
+    pSock->lclPort = simCtx.nextPort++;
+    pSock->connId  = simCtx.nextConnId++;
+    pSock->state   = SIM_SOCK_STATE_CONNECTING;
+
+    simCmdOK();
+
+    if ((0 != strcmp(pSock->rmtAddr, RNWF_SIM_SERVER_ADDR)) || (RNWF_SIM_SERVER_PORT != pSock->rmtPort))
+    {
+        simCtx.stats.numErrors++;
+        return;
+    }
+
+    if (NULL != simPeerAlloc(pSock->connId))
+    {
+        simCtx.stats.numConnects++;
+
+        /* SYN and SYN-ACK, the module reports the connection on the ACK. */
+        (void)RNWF_SimSchedule(simCtx.config.rttUs * 1000ULL, simSockConnected, NULL, pSock->connId);
+    }
+}
+
+static void simCmdSOCKWR(const SIM_ARGS *pArgs)
+{
+    SIM_SOCKET *pSock = simSockFind((uint32_t)simArgUInt(pArgs, 0));
+    uint32_t length = (uint32_t)simArgUInt(pArgs, 1);
+
+    if ((NULL == pSock) || (SIM_SOCK_STATE_CONNECTED != pSock->state) || (0U == length))
+    {
+        simCmdError();
+        return;
+    }
+
+    /* The binary data follows the prompt, OK once it is all received. */
+    simOutString("#");
+
+    simCtx.busy         = true;
+    simCtx.rxState      = SIM_RX_STATE_RAW;
+    simCtx.pRawSock     = pSock;
+    simCtx.rawRemaining = length;
+
+    simBufReset(&simCtx.rawData);
+}
+
+static void simCmdSOCKRD(const SIM_ARGS *pArgs)
+{
+    SIM_SOCKET *pSock = simSockFind((uint32_t)simArgUInt(pArgs, 0));
+    uint32_t length = (uint32_t)simArgUInt(pArgs, 2);
+    uint8_t data[SIM_LINE_SZ];
+    uint32_t total;
+    SIM_SEG *pSeg;
+
+    if ((NULL == pSock) || (2U != simArgUInt(pArgs, 1)) || (0U == length))
+    {
+        simCmdError();
+        return;
+    }
+
+    if (length > simBufLength(&pSock->rx))
+    {
+        /* More than was announced, the host would wait for the rest. */
+        simCtx.stats.numErrors++;
+        length = simBufLength(&pSock->rx);
+    }
+
+    simOutString("#");
+
+    total = length;
+
+    while (length > 0U)
+    {
+        uint32_t readLen = simBufRead(&pSock->rx, data, (length > sizeof(data)) ? (uint32_t)sizeof(data) : length);
+
+        simOutWrite(data, readLen);
+        length -= readLen;
+    }
+
+    simCmdOK();
+
+    pSock->rxAnnounced = (total > pSock->rxAnnounced) ? 0U : (pSock->rxAnnounced - total);
+
+    /* The freed receive space reaches the server as a window update. */
+    pSeg = simSegAlloc(pSock->connId);
+
+    if (NULL != pSeg)
+    {
+        (void)RNWF_SimSchedule(simSegSendNs(&simCtx.linkUpFreeNs, 0), simPeerWindow, pSeg, total);
+    }
+    else
+    {
+        simCtx.stats.numErrors++;
+    }
+
+    simSockRxtCheck(pSock);
+}
+
+static void simCmdSOCKCL(const SIM_ARGS *pArgs)
+{
+    SIM_SOCKET *pSock = simSockFind((uint32_t)simArgUInt(pArgs, 0));
+
+    if (NULL == pSock)
+    {
+        simCmdError();
+        return;
+    }
+
+    simSockClose(pSock);
+
+    simCmdOK();
+}
+
+/* Splits the arguments in place, removing the quotes of string arguments. */
+static void simCmdArgs(char *pStr, SIM_ARGS *pArgs)
+{
+    pArgs->numArgs = 0;
+
+    while (('\0' != *pStr) && (pArgs->numArgs < SIM_MAX_ARGS))
+    {
+        if ('"' == *pStr)
+        {
+            pArgs->pArgs[pArgs->numArgs++] = ++pStr;
+
+            while (('\0' != *pStr) && ('"' != *pStr))
+            {
+                pStr++;
+            }
+
+            if ('"' == *pStr)
+            {
+                *pStr++ = '\0';
+            }
+        }
+        else
+        {
+            pArgs->pArgs[pArgs->numArgs++] = pStr;
+
+            while (('\0' != *pStr) && (',' != *pStr))
+            {
+                pStr++;
+            }
+        }
+
+        if (',' == *pStr)
+        {
+            *pStr++ = '\0';
+        }
+    }
+}
+
+static void simCmdExecute(void *pArg, uint32_t arg)
+{
+    char line[SIM_LINE_SZ];
+    char *pName;
+    char *pArgStr;
+    SIM_ARGS args;
+
+    (void)snprintf(line, sizeof(line), "%s", simCtx.line);
+    simCtx.lineLen = 0;
+
+    pName   = &line[2];
+    pArgStr = strchr(pName, '=');
+
+    if (NULL != pArgStr)
+    {
+        *pArgStr++ = '\0';
+    }
+    else
+    {
+        pArgStr = &line[strlen(line)];
+    }
+
+    simCmdArgs(pArgStr, &args);
+
+    if (0 != strncmp(line, "AT", 2))
+    {
+        simCmdError();
+    }
+    else if ((0 == strcmp(pName, "E0")) || (0 == strcmp(pName, "+RST")) || (0 == strcmp(pName, "+WAP"))
+            || (0 == strcmp(pName, "+WSTAC")) || (0 == strcmp(pName, "+WIFIC")) || (0 == strcmp(pName, "+SOCKC")))
+    {
+        simCmdOK();
+    }
+    else if (0 == strcmp(pName, "+GMI"))
+    {
+        simOutString("+GMI:\"Microchip Technology Inc.\"\r\n");
+        simCmdOK();
+    }
+    else if (0 == strcmp(pName, "+GMR"))
+    {
+        simOutString("+GMR:\"2.0.0 0 rnwf02_sim\"\r\n");
+        simCmdOK();
+    }
+    else if (0 == strcmp(pName, "+DI"))
+    {
+        simOutString("+DI:1,\"RNWF02PC\",\"rnwf02_sim\",1\r\n");
+        simCmdOK();
+    }
+    else if (0 == strcmp(pName, "+NETIFC"))
+    {
+        simOutString("+NETIFC:0,1,\"wlan0\"\r\n+NETIFC:0,10,\"" SIM_LOCAL_ADDR "\"\r\n");
+        simCmdOK();
+    }
+    else if (0 == strcmp(pName, "+WSTA"))
+    {
+        simCmdWSTA(&args);
+    }
+    else if (0 == strcmp(pName, "+SOCKO"))
+    {
+        simCmdSOCKO(&args);
+    }
+    else if (0 == strcmp(pName, "+SOCKBL"))
+    {
+        simCmdSOCKBL(&args);
+    }
+    else if (0 == strcmp(pName, "+SOCKBR"))
+    {
+        simCmdSOCKBR(&args);
+    }
+    else if (0 == strcmp(pName, "+SOCKWR"))
+    {
+        simCmdSOCKWR(&args);
+    }
+    else if (0 == strcmp(pName, "+SOCKRD"))
+    {
+        simCmdSOCKRD(&args);
+    }
+    else if (0 == strcmp(pName, "+SOCKCL"))
+    {
+        simCmdSOCKCL(&args);
+    }
+    else
+    {
+        simCmdError();
+    }
+
+    if (SIM_RX_STATE_CMD == simCtx.rxState)
+    {
+        simCtx.busy = false;
+
+        simAsyncFlush();
+    }
+}
+
+/*****************************************************************************
+                          Programming Executive
+ *****************************************************************************/
+
+static uint32_t simLe32(const uint8_t *pData)
+{
+    return (uint32_t)pData[0] | ((uint32_t)pData[1] << 8) | ((uint32_t)pData[2] << 16) | ((uint32_t)pData[3] << 24);
+}
+
+static uint8_t* simPeFlashRange(uint32_t address, uint32_t length)
+{
+    if ((address < RNWF_SIM_PE_FLASH_BASE) || (length > RNWF_SIM_PE_FLASH_SIZE)
+            || ((address - RNWF_SIM_PE_FLASH_BASE) > (RNWF_SIM_PE_FLASH_SIZE - length)))
+    {
+        return NULL;
+    }
+
+    return &simPeFlash[address - RNWF_SIM_PE_FLASH_BASE];
+}
+
+/* Command word and argument words of each command, 0 if unknown. */
+static uint32_t simPeHdrLen(uint32_t cmd)
+{
+    switch (cmd)
+    {
+        case SIM_PE_CMD_EXEC_VERSION:
+        case SIM_PE_CMD_GET_DEVICE_ID:
+        {
+            return 4U;
+        }
+
+        case SIM_PE_CMD_PAGE_ERASE:
+        {
+            return 8U;
+        }
+
+        case SIM_PE_CMD_PGM_CLUSTER:
+        {
+            return 16U;
+        }
+
+        default:
+        {
+            return 0U;
+        }
+    }
+}
+
+static void simPeRespond(void *pArg, uint32_t arg)
+{
+    simOutWrite(simCtx.peRsp, simCtx.peRspLen);
+}
+
+/* Responses carry the command in the third byte and a status, or for the
+   version the version, in the first. Errors are reported with a non-zero
+   status. */
+static void simPeExecute(uint32_t cmd)
+{
+    uint64_t delayNs = SIM_PE_RSP_US * 1000ULL;
+    uint8_t *pFlash;
+    uint32_t address;
+    uint32_t length;
+    uint32_t sum = 0;
+    uint32_t i;
+
+    simCtx.stats.numPeCommands++;
+
+    (void)memset(simCtx.peRsp, 0, sizeof(simCtx.peRsp));
+
+    simCtx.peRsp[2]  = (uint8_t)cmd;
+    simCtx.peRspLen  = 4;
+
+    switch (cmd)
+    {
+        case SIM_PE_CMD_EXEC_VERSION:
+        {
+            simCtx.peRsp[0] = SIM_PE_VERSION;
+            break;
+        }
+
+        case SIM_PE_CMD_GET_DEVICE_ID:
+        {
+            simCtx.peRsp[4] = (uint8_t)SIM_PE_DEVICE_ID;
+            simCtx.peRsp[5] = (uint8_t)(SIM_PE_DEVICE_ID >> 8);
+            simCtx.peRsp[6] = (uint8_t)(SIM_PE_DEVICE_ID >> 16);
+            simCtx.peRsp[7] = (uint8_t)(SIM_PE_DEVICE_ID >> 24);
+            simCtx.peRspLen = 8;
+            break;
+        }
+
+        case SIM_PE_CMD_PAGE_ERASE:
+        {
+            address = simLe32(&simCtx.peHdr[4]);
+            length  = (simLe32(simCtx.peHdr) & 0xffffU) * SIM_PE_PAGE_SZ;
+            pFlash  = simPeFlashRange(address, length);
+
+            if ((NULL == pFlash) || (0U != (address % SIM_PE_PAGE_SZ)))
+            {
+                simCtx.stats.numErrors++;
+                simCtx.peRsp[0] = 1;
+                break;
+            }
+
+            (void)memset(pFlash, 0xff, length);
+
+            delayNs += (length / SIM_PE_PAGE_SZ) * SIM_PE_PAGE_ERASE_US * 1000ULL;
+            break;
+        }
+
+        case SIM_PE_CMD_PGM_CLUSTER:
+        {
+            address = simLe32(&simCtx.peHdr[4]);
+            length  = simCtx.peDataLen;
+            pFlash  = simPeFlashRange(address, length);
+
+            for (i=0; i<length; i++)
+            {
+                sum += simPeData[i];
+            }
+
+            if ((NULL == pFlash) || (0U != (address % 4U)) || (sum != simLe32(&simCtx.peHdr[12])))
+            {
+                simCtx.stats.numErrors++;
+                simCtx.peRsp[0] = 1;
+                break;
+            }
+
+            /* Programming can only clear bits of erased flash. */
+            for (i=0; i<length; i++)
+            {
+                if (0xffU != pFlash[i])
+                {
+                    simCtx.stats.numErrors++;
+                    simCtx.peRsp[0] = 2;
+                    break;
+                }
+            }
+
+            if (0U == simCtx.peRsp[0])
+            {
+                (void)memcpy(pFlash, simPeData, length);
+            }
+
+            delayNs += ((length + 15U) / 16U) * SIM_PE_QUAD_WORD_US * 1000ULL;
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+    (void)RNWF_SimSchedule(delayNs, simPeRespond, NULL, 0);
+}
+
+/* Words arrive least significant byte first. A program command is followed
+   by its data, the length given by its third word. */
+static void simPeRx(uint8_t data)
+{
+    uint32_t cmd;
+    uint32_t hdrLen;
+    uint32_t length;
+
+    if ((simCtx.peHdrLen < 4U) || (simCtx.peHdrLen < simPeHdrLen(simLe32(simCtx.peHdr) >> 16)))
+    {
+        simCtx.peHdr[simCtx.peHdrLen++] = data;
+    }
+    else
+    {
+        simPeData[simCtx.peDataLen++] = data;
+    }
+
+    if (simCtx.peHdrLen < 4U)
+    {
+        return;
+    }
+
+    cmd    = simLe32(simCtx.peHdr) >> 16;
+    hdrLen = simPeHdrLen(cmd);
+
+    if (0U == hdrLen)
+    {
+        simCtx.stats.numErrors++;
+        simCtx.peHdrLen = 0;
+        return;
+    }
+
+    if (simCtx.peHdrLen < hdrLen)
+    {
+        return;
+    }
+
+    if (SIM_PE_CMD_PGM_CLUSTER == cmd)
+    {
+        length = simLe32(&simCtx.peHdr[8]);
+
+        if ((0U == length) || (length > SIM_PE_MAX_WRITE_SZ))
+        {
+            simCtx.stats.numErrors++;
+            simCtx.peHdrLen = 0;
+            return;
+        }
+
+        if (simCtx.peDataLen < length)
+        {
+            return;
+        }
+    }
+
+    simPeExecute(cmd);
+
+    simCtx.peHdrLen  = 0;
+    simCtx.peDataLen = 0;
+}
+
+/*****************************************************************************
+                              Host Input
+ *****************************************************************************/
+
+static void simRawComplete(void *pArg, uint32_t arg)
+{
+    SIM_SOCKET *pSock = simCtx.pRawSock;
+    uint32_t length = simBufLength(&simCtx.rawData);
+
+    simCmdOK();
+
+    simCtx.rxState = SIM_RX_STATE_CMD;
+    simCtx.busy    = false;
+
+    simCtx.stats.sockTxBytes += length;
+
+    if (SIM_SOCK_STATE_FREE != pSock->state)
+    {
+        while (length > 0U)
+        {
+            SIM_SEG *pSeg = simSegAlloc(pSock->connId);
+
+            if (NULL == pSeg)
+            {
+                simCtx.stats.numErrors++;
+                break;
+            }
+
+            pSeg->length = (uint16_t)simBufRead(&simCtx.rawData, pSeg->data, SIM_MSS);
+            length -= pSeg->length;
+
+            (void)RNWF_SimSchedule(simSegSendNs(&simCtx.linkUpFreeNs, pSeg->length), simPeerReceive, pSeg, 0);
+        }
+    }
+
+    simAsyncFlush();
+}
+
+static void simRx(uint8_t data)
+{
+    /* Held in reset. */
+    if (false == simCtx.mclr)
+    {
+        return;
+    }
+
+    if (true == simCtx.peMode)
+    {
+        simPeRx(data);
+        return;
+    }
+
+    if (SIM_RX_STATE_RAW == simCtx.rxState)
+    {
+        simBufWrite(&simCtx.rawData, &data, 1);
+
+        if (0U == --simCtx.rawRemaining)
+        {
+            /* The module takes its command latency to accept the data. */
+            (void)RNWF_SimSchedule(simCtx.config.latencyUs * 1000ULL, simRawComplete, NULL, 0);
+        }
+
+        return;
+    }
+
+    if (simCtx.lineLen >= (SIM_LINE_SZ - 1U))
+    {
+        simCtx.stats.numErrors++;
+        simCtx.lineLen = 0;
+    }
+
+    simCtx.line[simCtx.lineLen++] = (char)data;
+    simCtx.line[simCtx.lineLen]   = '\0';
+
+    if (0 == strcmp(simCtx.line, "+++"))
+    {
+        /* Escape from a failed binary transfer. */
+        simCtx.stats.numErrors++;
+        simCtx.lineLen = 0;
+        simCmdOK();
+        return;
+    }
+
+    if ((simCtx.lineLen >= 2U) && ('\r' == simCtx.line[simCtx.lineLen-2U]) && ('\n' == data))
+    {
+        simCtx.line[simCtx.lineLen-2U] = '\0';
+
+        if (true == simCtx.busy)
+        {
+            simCtx.stats.numErrors++;
+        }
+
+        simCtx.busy = true;
+        simCtx.stats.numCmds++;
+
+        (void)RNWF_SimSchedule(simCtx.config.latencyUs * 1000ULL, simCmdExecute, NULL, 0);
+    }
+}
+
+/* Events of the module and its peers, dropped by a reset. */
+static bool simEventIsModule(RNWF_SIM_EVENT_FN pfFn)
+{
+    return ((simCmdExecute == pfFn) || (simRawComplete == pfFn) || (simPeRespond == pfFn) || (simWifiEvent == pfFn)
+            || (simSockConnected == pfFn) || (simSockSegArrive == pfFn) || (simPeerWindow == pfFn) || (simPeerReceive == pfFn));
+}
+
+/* MCLR low, connections are lost and the module restarts when released. */
+static void simReset(void)
+{
+    uint32_t i;
+
+    for (i=0; i<simCtx.numEvents; i++)
+    {
+        if ((true == simEvents[i].inUse) && (true == simEventIsModule(simEvents[i].pfFn)))
+        {
+            simEvents[i].inUse = false;
+        }
+    }
+
+    simEventNextDue();
+
+    for (i=0; i<SIM_NUM_SOCKETS; i++)
+    {
+        simSockets[i].state = SIM_SOCK_STATE_FREE;
+    }
+
+    for (i=0; i<SIM_NUM_PEERS; i++)
+    {
+        simPeers[i].inUse = false;
+    }
+
+    for (i=0; i<SIM_NUM_SEGS; i++)
+    {
+        simSegs[i].inUse = false;
+    }
+
+    simCtx.outRdIdx     = simCtx.outWrIdx;
+    simCtx.asyncHead    = 0;
+    simCtx.asyncCount   = 0;
+    simCtx.rxState      = SIM_RX_STATE_CMD;
+    simCtx.lineLen      = 0;
+    simCtx.busy         = false;
+    simCtx.pRawSock     = NULL;
+    simCtx.rawRemaining = 0;
+    simCtx.peMode       = false;
+    simCtx.peHdrLen     = 0;
+    simCtx.peDataLen    = 0;
+    simCtx.pinKey       = 0;
+    simCtx.pinBits      = 0;
+
+    simBufReset(&simCtx.rawData);
+
+    simCtx.stats.numResets++;
+}
+
+/*****************************************************************************
+                          Simulated Module API
+ *****************************************************************************/
+
+void RNWF_SimInit(const RNWF_SIM_CONFIG *pConfig)
+{
+    uint32_t i;
+
+    for (i=0; i<SIM_NUM_SOCKETS; i++)
+    {
+        simSockets[i].state = SIM_SOCK_STATE_FREE;
+    }
+
+    for (i=0; i<SIM_NUM_PEERS; i++)
+    {
+        simPeers[i].inUse = false;
+    }
+
+    (void)memset(simEvents, 0, sizeof(simEvents));
+    (void)memset(simSegs, 0, sizeof(simSegs));
+
+    free(simCtx.rawData.pData);
+    (void)memset(&simCtx, 0, sizeof(simCtx));
+
+    simCtx.config.baud      = SIM_DEFAULT_BAUD;
+    simCtx.config.latencyUs = SIM_DEFAULT_LATENCY_US;
+    simCtx.config.rttUs     = SIM_DEFAULT_RTT_US;
+    simCtx.config.linkKbps  = SIM_DEFAULT_LINK_KBPS;
+    simCtx.config.sockBufSz = SIM_DEFAULT_SOCK_BUF_SZ;
+
+    if (NULL != pConfig)
+    {
+        if (0U != pConfig->baud)
+        {
+            simCtx.config.baud = pConfig->baud;
+        }
+
+        if (0U != pConfig->linkKbps)
+        {
+            simCtx.config.linkKbps = pConfig->linkKbps;
+        }
+
+        if (0U != pConfig->sockBufSz)
+        {
+            simCtx.config.sockBufSz = pConfig->sockBufSz;
+        }
+
+        simCtx.config.latencyUs = pConfig->latencyUs;
+        simCtx.config.rttUs     = pConfig->rttUs;
+    }
+
+    /* Start, eight data and stop bit. */
+    simCtx.byteNs      = 10000000000ULL / simCtx.config.baud;
+    simCtx.nextDueNs   = UINT64_MAX;
+    simCtx.uartEnabled = true;
+    simCtx.nextSockId  = 1;
+    simCtx.nextConnId  = 1;
+    simCtx.nextPort    = SIM_EPHEMERAL_PORT;
+    simCtx.mclr        = true;
+    simCtx.pgc         = true;
+
+    (void)memset(simPeFlash, 0, sizeof(simPeFlash));
+}
+
+/* Host to module bytes, from the interface DMAC channel. Returns once the
+   last byte has been sent. */
+void RNWF_SimUartWrite(const uint8_t *pData, size_t length)
+{
+    size_t i;
+
+    for (i=0; i<length; i++)
+    {
+        simRunUntil(simCtx.nowNs + simCtx.byteNs);
+
+        simCtx.stats.uartTxBytes++;
+
+        simRx(pData[i]);
+    }
+}
+
+/* Host poll of the USART receive ring. */
+size_t RNWF_SimUartRead(uint8_t *pData, size_t size)
+{
+    size_t length = 0;
+
+    simRunUntil(simCtx.nowNs + SIM_POLL_NS);
+    simOutDeliver();
+
+    while ((length < size) && (simCtx.hostRdIdx != simCtx.hostWrIdx))
+    {
+        pData[length++] = simCtx.hostRing[simCtx.hostRdIdx % SIM_HOST_RING_SZ];
+        simCtx.hostRdIdx++;
+    }
+
+    return length;
+}
+
+size_t RNWF_SimUartReadCount(void)
+{
+    simRunUntil(simCtx.nowNs + SIM_POLL_NS);
+    simOutDeliver();
+
+    return simCtx.hostWrIdx - simCtx.hostRdIdx;
+}
+
+/* A disabled USART drops received bytes, enabling it empties the ring. */
+void RNWF_SimUartEnable(bool enable)
+{
+    simOutDeliver();
+
+    simCtx.uartEnabled = enable;
+
+    if (true == enable)
+    {
+        simCtx.hostRdIdx = simCtx.hostWrIdx;
+    }
+}
+
+bool RNWF_SimSchedule(uint64_t delayNs, RNWF_SIM_EVENT_FN pfFn, void *pArg, uint32_t arg)
+{
+    uint32_t i;
+
+    for (i=0; i<SIM_NUM_EVENTS; i++)
+    {
+        if (false == simEvents[i].inUse)
+        {
+            simEvents[i].inUse = true;
+            simEvents[i].dueNs = simCtx.nowNs + delayNs;
+            simEvents[i].seq   = simCtx.eventSeq++;
+            simEvents[i].pfFn  = pfFn;
+            simEvents[i].pArg  = pArg;
+            simEvents[i].arg   = arg;
+
+            if (i >= simCtx.numEvents)
+            {
+                simCtx.numEvents = i + 1U;
+            }
+
+            if (simEvents[i].dueNs < simCtx.nextDueNs)
+            {
+                simCtx.nextDueNs = simEvents[i].dueNs;
+            }
+
+            return true;
+        }
+    }
+
+    simCtx.stats.numErrors++;
+
+    return false;
+}
+
+void RNWF_SimAdvance(uint64_t ns)
+{
+    simRunUntil(simCtx.nowNs + ns);
+}
+
+uint64_t RNWF_SimTimeNs(void)
+{
+    return simCtx.nowNs;
+}
+
+uint32_t RNWF_SimTimeMs(void)
+{
+    return (uint32_t)(simCtx.nowNs / 1000000U);
+}
+
+uint32_t RNWF_SimTimeUs(void)
+{
+    return (uint32_t)(simCtx.nowNs / 1000U);
+}
+
+void RNWF_SimStatsGet(RNWF_SIM_STATS *pStats)
+{
+    if (NULL != pStats)
+    {
+        *pStats = simCtx.stats;
+    }
+}
+
+void RNWF_SimError(void)
+{
+    simCtx.stats.numErrors++;
+}
+
+/* FNV-1a of the path, without any query. */
+uint32_t RNWF_SimContentSeed(const char *pPath)
+{
+    uint32_t hash = 2166136261U;
+
+    while (('\0' != *pPath) && ('?' != *pPath))
+    {
+        hash ^= (uint8_t)*pPath++;
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+uint8_t RNWF_SimContentByte(uint32_t seed, uint32_t offset)
+{
+    uint32_t x = seed ^ (offset * 0x9e3779b1U);
+
+    x ^= x >> 15;
+    x *= 0x2c1b3c6dU;
+    x ^= x >> 12;
+
+    return (uint8_t)x;
+}
+
+/* A connection to a listening socket, from a peer which sends the data
+   given, optionally followed by a FIN, and discards what it receives. */
+bool RNWF_SimConnectIn(uint16_t port, const void *pData, size_t length, bool close)
+{
+    SIM_SOCKET *pSock = NULL;
+    SIM_PEER *pPeer;
+    uint32_t i;
+
+    for (i=0; i<SIM_NUM_SOCKETS; i++)
+    {
+        if ((SIM_SOCK_STATE_LISTEN == simSockets[i].state) && (port == simSockets[i].lclPort))
+        {
+            pSock = simSockAlloc();
+            break;
+        }
+    }
+
+    if (NULL == pSock)
+    {
+        return false;
+    }
+
+    pSock->lclPort = port;
+    pSock->rmtPort = simCtx.nextPort++;
+    pSock->connId  = simCtx.nextConnId++;
+    pSock->state   = SIM_SOCK_STATE_CONNECTING;
+
+    (void)snprintf(pSock->rmtAddr, sizeof(pSock->rmtAddr), "%s", RNWF_SIM_SERVER_ADDR);
+
+    pPeer = simPeerAlloc(pSock->connId);
+
+    if (NULL == pPeer)
+    {
+        pSock->state = SIM_SOCK_STATE_FREE;
+        return false;
+    }
+
+    pPeer->discard    = true;
+    pPeer->closeAfter = close;
+
+    simBufWrite(&pPeer->tx, pData, (uint32_t)length);
+
+    simCtx.stats.numConnects++;
+
+    (void)RNWF_SimSchedule(simCtx.config.rttUs * 1000ULL, simSockConnected, NULL, pSock->connId);
+
+    return true;
+}
+
+/* Programming pin levels from the host. PGD is sampled on the rising edge
+   of PGC while MCLR is low, most significant bit first. */
+void RNWF_SimPinsWrite(bool mclr, bool pgc, bool pgd)
+{
+    if ((true == simCtx.mclr) && (false == mclr))
+    {
+        simReset();
+    }
+    else if ((false == simCtx.mclr) && (true == mclr))
+    {
+        simCtx.peMode = ((32U == simCtx.pinBits) && (SIM_PE_KEY == simCtx.pinKey));
+    }
+    else if ((false == mclr) && (false == simCtx.pgc) && (true == pgc))
+    {
+        simCtx.pinKey = (simCtx.pinKey << 1) | ((true == pgd) ? 1U : 0U);
+        simCtx.pinBits++;
+    }
+
+    simCtx.mclr = mclr;
+    simCtx.pgc  = pgc;
+}
+
+/* Programmed flash contents, NULL outside the array. */
+const uint8_t* RNWF_SimPeFlash(uint32_t address, uint32_t length)
+{
+    return simPeFlashRange(address, length);
+}
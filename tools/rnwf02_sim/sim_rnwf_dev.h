@@ -0,0 +1,117 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+#ifndef SIM_RNWF_DEV_H
+#define SIM_RNWF_DEV_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*****************************************************************************
+  Description:
+    Simulated module configuration.
+
+  Remarks:
+    baud is the UART rate, each byte costs ten bit times in either
+    direction. latencyUs is the module processing time of each AT command,
+    measured from the end of the command line to its first response byte.
+    rttUs is the network round trip to the server and linkKbps the rate of
+    the link to it. sockBufSz is the receive buffer of each module socket,
+    the server never has more than this in flight.
+
+ *****************************************************************************/
+
+typedef struct
+{
+    uint32_t    baud;
+    uint32_t    latencyUs;
+    uint32_t    rttUs;
+    uint32_t    linkKbps;
+    uint32_t    sockBufSz;
+} RNWF_SIM_CONFIG;
+
+/*****************************************************************************
+  Description:
+    Simulated module statistics.
+
+  Remarks:
+    uartTxBytes counts bytes sent by the host and uartRxBytes bytes sent to
+    it. numCmds counts AT command lines and numAsync the asynchronous event
+    lines sent. numResets counts resets through MCLR and numPeCommands the
+    commands run by the programming executive. numErrors counts protocol
+    violations seen by the module or the server, any non-zero value
+    indicates a host or simulator fault.
+
+ *****************************************************************************/
+
+typedef struct
+{
+    uint64_t    uartTxBytes;
+    uint64_t    uartRxBytes;
+    uint64_t    sockTxBytes;
+    uint64_t    sockRxBytes;
+    uint32_t    numCmds;
+    uint32_t    numAsync;
+    uint32_t    numConnects;
+    uint32_t    numRequests;
+    uint32_t    numResets;
+    uint32_t    numPeCommands;
+    uint32_t    numErrors;
+} RNWF_SIM_STATS;
+
+/* Simulated time event callback. */
+typedef void (*RNWF_SIM_EVENT_FN)(void *pArg, uint32_t arg);
+
+/* Address and HTTP port of the simulated server. */
+#define RNWF_SIM_SERVER_ADDR            "192.168.1.100"
+#define RNWF_SIM_SERVER_PORT            8000U
+
+/* Flash programmed through the programming executive. */
+#define RNWF_SIM_PE_FLASH_BASE          0x60000000U
+#define RNWF_SIM_PE_FLASH_SIZE          (2U*1024U*1024U)
+
+/*****************************************************************************
+                          Simulated Module API
+ *****************************************************************************/
+
+void RNWF_SimInit(const RNWF_SIM_CONFIG *pConfig);
+void RNWF_SimUartWrite(const uint8_t *pData, size_t length);
+size_t RNWF_SimUartRead(uint8_t *pData, size_t size);
+size_t RNWF_SimUartReadCount(void);
+void RNWF_SimUartEnable(bool enable);
+bool RNWF_SimSchedule(uint64_t delayNs, RNWF_SIM_EVENT_FN pfFn, void *pArg, uint32_t arg);
+void RNWF_SimAdvance(uint64_t ns);
+uint64_t RNWF_SimTimeNs(void);
+uint32_t RNWF_SimTimeMs(void);
+uint32_t RNWF_SimTimeUs(void);
+void RNWF_SimStatsGet(RNWF_SIM_STATS *pStats);
+void RNWF_SimError(void);
+uint32_t RNWF_SimContentSeed(const char *pPath);
+uint8_t RNWF_SimContentByte(uint32_t seed, uint32_t offset);
+bool RNWF_SimConnectIn(uint16_t port, const void *pData, size_t length, bool close);
+void RNWF_SimPinsWrite(bool mclr, bool pgc, bool pgd);
+const uint8_t* RNWF_SimPeFlash(uint32_t address, uint32_t length);
+
+/*****************************************************************************
+                             Platform Port
+ *****************************************************************************/
+
+void RNWF_SimConsoleVerbose(bool verbose);
+uint32_t RNWF_SimConsoleErrors(void);
+
+#endif /* SIM_RNWF_DEV_H */
@@ -0,0 +1,495 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+/* Simulated SST26VF064B serial flash.
+
+   The array is a file mapped into memory, so a staged image survives the
+   process and can be inspected. Bytes are decoded per chip select frame
+   for the commands the SST26 driver issues. Program and erase times are
+   the datasheet maximums, counted in simulated time, and the device
+   reports busy in its status register until they pass. */
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "sim_sst26.h"
+#include "sim_rnwf_dev.h"
+
+#define SIM_SST26_SPI_HZ                7500000U
+#define SIM_SST26_PAGE_SZ               256U
+#define SIM_SST26_SECTOR_SZ             4096U
+
+/* The device has 8 KB and 32 KB blocks at either end of the array, which
+   the driver does not distinguish, so every block is modelled as 64 KB. */
+#define SIM_SST26_BLOCK_SZ              65536U
+
+#define SIM_SST26_PP_NS                 1500000U
+#define SIM_SST26_SE_NS                 25000000U
+#define SIM_SST26_BE_NS                 25000000U
+#define SIM_SST26_CE_NS                 50000000U
+
+#define SIM_SST26_CMD_WRSR              0x01U
+#define SIM_SST26_CMD_PP                0x02U
+#define SIM_SST26_CMD_RDSR              0x05U
+#define SIM_SST26_CMD_WREN              0x06U
+#define SIM_SST26_CMD_HS_READ           0x0BU
+#define SIM_SST26_CMD_SE                0x20U
+#define SIM_SST26_CMD_RSTEN             0x66U
+#define SIM_SST26_CMD_ULBPR             0x98U
+#define SIM_SST26_CMD_RST               0x99U
+#define SIM_SST26_CMD_JEDEC             0x9FU
+#define SIM_SST26_CMD_CE                0xC7U
+#define SIM_SST26_CMD_BE                0xD8U
+
+#define SIM_SST26_STATUS_BUSY           0x01U
+#define SIM_SST26_STATUS_WEL            0x02U
+
+typedef struct
+{
+    uint8_t                 *pMem;
+    bool                    selected;
+    uint32_t                pos;
+    uint8_t                 cmd;
+    uint32_t                addr;
+    bool                    wel;
+    bool                    locked;
+    bool                    rstEnabled;
+    uint64_t                busyUntilNs;
+    uint32_t                pageLen;
+    uint8_t                 page[SIM_SST26_PAGE_SZ];
+    RNWF_SIM_SST26_STATS    stats;
+} SIM_SST26;
+
+static SIM_SST26 simSst26;
+
+static void simSst26Error(const char *pMsg)
+{
+    printf("sst26: %s\n", pMsg);
+    simSst26.stats.numErrors++;
+}
+
+static bool simSst26Busy(void)
+{
+    return (RNWF_SimTimeNs() < simSst26.busyUntilNs);
+}
+
+/* Returns true if the program or erase may start, and clears WEL. */
+static bool simSst26WriteStart(uint32_t busyNs)
+{
+    bool wel = simSst26.wel;
+
+    simSst26.wel = false;
+
+    if (true == simSst26Busy())
+    {
+        simSst26Error("write while busy");
+        return false;
+    }
+
+    if (false == wel)
+    {
+        simSst26Error("write without WREN");
+        return false;
+    }
+
+    if (true == simSst26.locked)
+    {
+        simSst26Error("write to protected array");
+        return false;
+    }
+
+    simSst26.busyUntilNs = RNWF_SimTimeNs() + busyNs;
+
+    return true;
+}
+
+static void simSst26Erase(uint32_t size, uint32_t busyNs)
+{
+    uint32_t addr = simSst26.addr & ~(size - 1U);
+
+    if (simSst26.pos < 4U)
+    {
+        simSst26Error("erase address incomplete");
+        simSst26.wel = false;
+        return;
+    }
+
+    if (true == simSst26WriteStart(busyNs))
+    {
+        memset(&simSst26.pMem[addr], 0xff, size);
+    }
+}
+
+static void simSst26PageProgram(void)
+{
+    uint32_t base = simSst26.addr & ~(SIM_SST26_PAGE_SZ - 1U);
+    uint32_t i;
+
+    if ((simSst26.pos < 4U) || (0U == simSst26.pageLen))
+    {
+        simSst26Error("page program incomplete");
+        simSst26.wel = false;
+        return;
+    }
+
+    if (false == simSst26WriteStart(SIM_SST26_PP_NS))
+    {
+        return;
+    }
+
+    simSst26.stats.pagePrograms++;
+
+    /* Data beyond the end of the page wraps to its start, programming can
+       only clear bits. */
+    for (i=0; i<simSst26.pageLen; i++)
+    {
+        uint32_t offset = (simSst26.addr + i) & (SIM_SST26_PAGE_SZ - 1U);
+        uint8_t *pByte = &simSst26.pMem[base + offset];
+
+        if (0xffU != *pByte)
+        {
+            simSst26Error("program over unerased byte");
+        }
+
+        *pByte &= simSst26.page[offset];
+    }
+}
+
+/* Completes the command of a frame when chip select is deasserted. */
+static void simSst26FrameEnd(void)
+{
+    uint8_t cmd = simSst26.cmd;
+
+    if (0U == simSst26.pos)
+    {
+        return;
+    }
+
+    if (SIM_SST26_CMD_RST != cmd)
+    {
+        simSst26.rstEnabled = (SIM_SST26_CMD_RSTEN == cmd);
+    }
+
+    /* Commands other than RDSR are ignored while busy, the error was
+       counted when the command byte arrived. */
+    if ((true == simSst26Busy()) && (SIM_SST26_CMD_RDSR != cmd))
+    {
+        return;
+    }
+
+    switch (cmd)
+    {
+        case SIM_SST26_CMD_WREN:
+        {
+            simSst26.wel = true;
+            break;
+        }
+
+        case SIM_SST26_CMD_ULBPR:
+        {
+            if (false == simSst26.wel)
+            {
+                simSst26Error("ULBPR without WREN");
+            }
+
+            simSst26.locked = false;
+            simSst26.wel    = false;
+            break;
+        }
+
+        case SIM_SST26_CMD_RST:
+        {
+            if (true == simSst26.rstEnabled)
+            {
+                simSst26.wel = false;
+            }
+
+            simSst26.rstEnabled = false;
+            break;
+        }
+
+        case SIM_SST26_CMD_PP:
+        {
+            simSst26PageProgram();
+            break;
+        }
+
+        case SIM_SST26_CMD_SE:
+        {
+            simSst26.stats.sectorErases++;
+            simSst26Erase(SIM_SST26_SECTOR_SZ, SIM_SST26_SE_NS);
+            break;
+        }
+
+        case SIM_SST26_CMD_BE:
+        {
+            simSst26.stats.blockErases++;
+            simSst26Erase(SIM_SST26_BLOCK_SZ, SIM_SST26_BE_NS);
+            break;
+        }
+
+        case SIM_SST26_CMD_CE:
+        {
+            simSst26.stats.chipErases++;
+
+            if (true == simSst26WriteStart(SIM_SST26_CE_NS))
+            {
+                memset(simSst26.pMem, 0xff, RNWF_SIM_SST26_SIZE);
+            }
+            break;
+        }
+
+        case SIM_SST26_CMD_WRSR:
+        {
+            simSst26.wel = false;
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+}
+
+static uint8_t simSst26Byte(uint8_t tx)
+{
+    uint32_t pos = simSst26.pos++;
+    uint8_t rx = 0xffU;
+
+    if (0U == pos)
+    {
+        simSst26.cmd     = tx;
+        simSst26.addr    = 0;
+        simSst26.pageLen = 0;
+
+        if ((true == simSst26Busy()) && (SIM_SST26_CMD_RDSR != tx))
+        {
+            simSst26Error("command while busy");
+        }
+
+        if (SIM_SST26_CMD_HS_READ == tx)
+        {
+            simSst26.stats.reads++;
+        }
+
+        return rx;
+    }
+
+    switch (simSst26.cmd)
+    {
+        case SIM_SST26_CMD_JEDEC:
+        {
+            static const uint8_t jedecId[3] = {0xbfU, 0x26U, 0x43U};
+
+            if (pos <= 3U)
+            {
+                rx = jedecId[pos - 1U];
+            }
+            break;
+        }
+
+        case SIM_SST26_CMD_RDSR:
+        {
+            rx = (true == simSst26.wel) ? SIM_SST26_STATUS_WEL : 0U;
+
+            if (true == simSst26Busy())
+            {
+                rx |= SIM_SST26_STATUS_BUSY;
+
+                if (1U == pos)
+                {
+                    simSst26.stats.busyPolls++;
+                }
+            }
+            break;
+        }
+
+        case SIM_SST26_CMD_HS_READ:
+        case SIM_SST26_CMD_PP:
+        case SIM_SST26_CMD_SE:
+        case SIM_SST26_CMD_BE:
+        {
+            if (pos <= 3U)
+            {
+                simSst26.addr = ((simSst26.addr << 8) | tx) & (RNWF_SIM_SST26_SIZE - 1U);
+            }
+            else if (SIM_SST26_CMD_PP == simSst26.cmd)
+            {
+                uint32_t offset = (simSst26.addr + pos - 4U) & (SIM_SST26_PAGE_SZ - 1U);
+
+                simSst26.page[offset] = tx;
+
+                if (simSst26.pageLen < SIM_SST26_PAGE_SZ)
+                {
+                    simSst26.pageLen++;
+                }
+            }
+            else if ((SIM_SST26_CMD_HS_READ == simSst26.cmd) && (pos >= 5U))
+            {
+                /* Reads continue across the whole array and wrap at its end. */
+                rx = simSst26.pMem[(simSst26.addr + pos - 5U) & (RNWF_SIM_SST26_SIZE - 1U)];
+                simSst26.stats.readBytes++;
+            }
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+    return rx;
+}
+
+/*****************************************************************************
+                          Simulated SST26 API
+ *****************************************************************************/
+
+/* Maps pPath as the flash array, a new file starts erased. A NULL path maps
+   anonymous memory instead. The array powers up write protected. */
+bool RNWF_SimSst26Init(const char *pPath)
+{
+    void *pMem;
+
+    if (NULL != simSst26.pMem)
+    {
+        munmap(simSst26.pMem, RNWF_SIM_SST26_SIZE);
+    }
+
+    memset(&simSst26, 0, sizeof(simSst26));
+
+    if (NULL == pPath)
+    {
+        pMem = mmap(NULL, RNWF_SIM_SST26_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (MAP_FAILED == pMem)
+        {
+            return false;
+        }
+
+        memset(pMem, 0xff, RNWF_SIM_SST26_SIZE);
+    }
+    else
+    {
+        struct stat st;
+        bool isNew;
+        int fd;
+
+        fd = open(pPath, O_RDWR | O_CREAT, 0644);
+
+        if (fd < 0)
+        {
+            perror(pPath);
+            return false;
+        }
+
+        isNew = ((0 != fstat(fd, &st)) || (RNWF_SIM_SST26_SIZE != st.st_size));
+
+        if ((true == isNew) && (0 != ftruncate(fd, RNWF_SIM_SST26_SIZE)))
+        {
+            perror(pPath);
+            close(fd);
+            return false;
+        }
+
+        pMem = mmap(NULL, RNWF_SIM_SST26_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+
+        if (MAP_FAILED == pMem)
+        {
+            perror(pPath);
+            return false;
+        }
+
+        if (true == isNew)
+        {
+            memset(pMem, 0xff, RNWF_SIM_SST26_SIZE);
+        }
+    }
+
+    simSst26.pMem   = pMem;
+    simSst26.locked = true;
+
+    return true;
+}
+
+/* Chip select, a deselect completes the command of the frame. */
+void RNWF_SimSst26Select(bool select)
+{
+    if (select == simSst26.selected)
+    {
+        return;
+    }
+
+    simSst26.selected = select;
+
+    if (false == select)
+    {
+        simSst26FrameEnd();
+    }
+
+    simSst26.pos = 0;
+}
+
+/* Clocks max(txSize, rxSize) bytes through the device. The host sends 0xFF
+   once its transmit data ends, received bytes beyond rxSize are dropped. */
+void RNWF_SimSst26Transfer(const uint8_t *pTxData, size_t txSize, uint8_t *pRxData, size_t rxSize)
+{
+    size_t length = (txSize > rxSize) ? txSize : rxSize;
+    size_t i;
+
+    for (i=0; i<length; i++)
+    {
+        uint8_t tx = ((NULL != pTxData) && (i < txSize)) ? pTxData[i] : 0xffU;
+        uint8_t rx = 0xffU;
+
+        if (true == simSst26.selected)
+        {
+            rx = simSst26Byte(tx);
+        }
+
+        if ((NULL != pRxData) && (i < rxSize))
+        {
+            pRxData[i] = rx;
+        }
+    }
+}
+
+/* Bus time of a transfer of length bytes. */
+uint64_t RNWF_SimSst26TransferNs(size_t length)
+{
+    return ((uint64_t)length * 8U * 1000000000U) / SIM_SST26_SPI_HZ;
+}
+
+const uint8_t* RNWF_SimSst26Data(void)
+{
+    return simSst26.pMem;
+}
+
+void RNWF_SimSst26StatsGet(RNWF_SIM_SST26_STATS *pStats)
+{
+    if (NULL != pStats)
+    {
+        memcpy(pStats, &simSst26.stats, sizeof(RNWF_SIM_SST26_STATS));
+    }
+}
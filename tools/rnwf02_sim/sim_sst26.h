@@ -0,0 +1,64 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+#ifndef SIM_SST26_H
+#define SIM_SST26_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Size of the simulated SST26VF064B. */
+#define RNWF_SIM_SST26_SIZE             (8U*1024U*1024U)
+
+/*****************************************************************************
+  Description:
+    Simulated SST26 flash statistics.
+
+  Remarks:
+    reads counts read commands, each of which may transfer any number of
+    bytes. busyPolls counts status register reads which found a program or
+    erase in progress. numErrors counts commands the device would ignore or
+    misapply, such as a program without write enable, while busy or over
+    bytes which are not erased. Any non-zero value indicates a driver fault.
+
+ *****************************************************************************/
+
+typedef struct
+{
+    uint32_t    pagePrograms;
+    uint32_t    sectorErases;
+    uint32_t    blockErases;
+    uint32_t    chipErases;
+    uint32_t    reads;
+    uint64_t    readBytes;
+    uint32_t    busyPolls;
+    uint32_t    numErrors;
+} RNWF_SIM_SST26_STATS;
+
+/*****************************************************************************
+                          Simulated SST26 API
+ *****************************************************************************/
+
+bool RNWF_SimSst26Init(const char *pPath);
+void RNWF_SimSst26Select(bool select);
+void RNWF_SimSst26Transfer(const uint8_t *pTxData, size_t txSize, uint8_t *pRxData, size_t rxSize);
+uint64_t RNWF_SimSst26TransferNs(size_t length);
+const uint8_t* RNWF_SimSst26Data(void);
+void RNWF_SimSst26StatsGet(RNWF_SIM_SST26_STATS *pStats);
+
+#endif /* SIM_SST26_H */
@@ -0,0 +1,358 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+/* SST26 request queue benchmark against the simulated flash.
+
+   A superloop programs an image into the simulated SST26, erasing each
+   sector before its pages. It first waits for each erase and page write
+   through the direct driver API, as the OTA service did before the
+   request queue, then keeps the request queue topped up and returns to
+   the loop. The gaps between loop passes show how long the rest of the
+   application would be held off. The image is then read back with
+   adjacent queued reads, which the driver merges into fewer read
+   commands. All figures are in simulated time and are repeatable. */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "definitions.h"
+#include "sim_rnwf_dev.h"
+#include "sim_sst26.h"
+
+#define BENCH_IMAGE_SZ              (1024U*1024U)
+#define BENCH_IMAGE_SZ_QUICK        (128U*1024U)
+
+#define BENCH_SECTOR_SZ             4096U
+#define BENCH_READ_SZ               256U
+
+/* The queued image is programmed after the blocking one. */
+#define BENCH_QUEUED_ADDR           (2U*1024U*1024U)
+
+static bool benchQuick;
+static int benchNumFailed;
+static DRV_HANDLE benchHandle;
+
+static uint8_t benchImage[BENCH_IMAGE_SZ];
+static uint8_t benchReadBuf[BENCH_IMAGE_SZ];
+
+static uint32_t benchNumCallbacks;
+static uint32_t benchNumCallbackErrors;
+
+/* Gaps between superloop passes. */
+static uint64_t benchLoopLastNs;
+static uint64_t benchLoopMaxNs;
+static uint64_t benchLoopSumNs;
+static uint32_t benchLoopCount;
+
+static const DRV_SST26_PLIB_INTERFACE benchSst26PlibAPI = {
+    .writeRead          = (DRV_SST26_PLIB_WRITE_READ)SERCOM6_SPI_WriteRead,
+    .write_t            = (DRV_SST26_PLIB_WRITE)SERCOM6_SPI_Write,
+    .read_t             = (DRV_SST26_PLIB_READ)SERCOM6_SPI_Read,
+    .isBusy             = (DRV_SST26_PLIB_IS_BUSY)SERCOM6_SPI_IsBusy,
+    .callbackRegister   = (DRV_SST26_PLIB_CALLBACK_REGISTER)SERCOM6_SPI_CallbackRegister,
+};
+
+static const DRV_SST26_INIT benchSst26InitData =
+{
+    .sst26Plib      = &benchSst26PlibAPI,
+    .chipSelectPin  = DRV_SST26_CHIP_SELECT_PIN,
+};
+
+/*****************************************************************************
+                              Utilities
+ *****************************************************************************/
+
+static void benchCheck(bool result, const char *pDesc)
+{
+    if (false == result)
+    {
+        printf("FAIL: %s\n", pDesc);
+        benchNumFailed++;
+    }
+}
+
+static void benchLoopReset(void)
+{
+    benchLoopLastNs = RNWF_SimTimeNs();
+    benchLoopMaxNs  = 0;
+    benchLoopSumNs  = 0;
+    benchLoopCount  = 0;
+}
+
+/* One pass of the rest of the superloop. */
+static void benchLoopTask(void)
+{
+    uint64_t nowNs = RNWF_SimTimeNs();
+    uint64_t gapNs = nowNs - benchLoopLastNs;
+
+    if (gapNs > benchLoopMaxNs)
+    {
+        benchLoopMaxNs = gapNs;
+    }
+
+    benchLoopSumNs += gapNs;
+    benchLoopCount++;
+    benchLoopLastNs = nowNs;
+}
+
+static void benchLoopPrint(const char *pName, uint32_t size, uint64_t startNs)
+{
+    uint64_t totalNs = RNWF_SimTimeNs() - startNs;
+
+    printf("%-16s %u KB, %.1f ms, %u loop passes, loop gap max %.1f us, mean %.2f us\n",
+            pName, (unsigned)(size / 1024U), (double)totalNs / 1e6, benchLoopCount,
+            (double)benchLoopMaxNs / 1e3, (double)benchLoopSumNs / 1e3 / ((0U != benchLoopCount) ? benchLoopCount : 1U));
+}
+
+static bool benchWait(void)
+{
+    DRV_SST26_TRANSFER_STATUS status;
+
+    do
+    {
+        status = DRV_SST26_TransferStatusGet(benchHandle);
+    }
+    while (DRV_SST26_TRANSFER_BUSY == status);
+
+    return (DRV_SST26_TRANSFER_COMPLETED == status);
+}
+
+static void benchCallback(DRV_SST26_TRANSFER_STATUS event, uintptr_t context)
+{
+    benchNumCallbacks++;
+
+    if (DRV_SST26_TRANSFER_COMPLETED != event)
+    {
+        benchNumCallbackErrors++;
+    }
+}
+
+/*****************************************************************************
+                               Programming
+ *****************************************************************************/
+
+/* Each erase and page write is waited for before the loop runs again. */
+static void benchProgramBlocking(uint32_t address, uint32_t size)
+{
+    uint64_t startNs = RNWF_SimTimeNs();
+    uint32_t offset;
+    bool result = true;
+
+    benchLoopReset();
+
+    for (offset=0; (offset<size) && (true == result); offset+=DRV_SST26_PAGE_SIZE)
+    {
+        benchLoopTask();
+
+        if (0U == (offset % BENCH_SECTOR_SZ))
+        {
+            result = (DRV_SST26_SectorErase(benchHandle, address + offset) && benchWait());
+
+            benchLoopTask();
+        }
+
+        if (true == result)
+        {
+            result = (DRV_SST26_PageWrite(benchHandle, &benchImage[offset], address + offset) && benchWait());
+        }
+    }
+
+    benchLoopTask();
+    benchCheck(true == result, "blocking program");
+    benchLoopPrint("sst26 blocking", size, startNs);
+}
+
+/* Requests are queued while there is room, the loop runs between. */
+static void benchProgramQueued(uint32_t address, uint32_t size)
+{
+    uint64_t startNs = RNWF_SimTimeNs();
+    uint32_t numRequests = 0;
+    uint32_t offset = 0;
+    bool erased = false;
+
+    benchNumCallbacks      = 0;
+    benchNumCallbackErrors = 0;
+
+    benchLoopReset();
+
+    /* Each pass polls the queue, as the OTA service does. */
+    while ((0U != DRV_SST26_RequestQueueCount(benchHandle)) || (offset < size))
+    {
+        benchLoopTask();
+
+        while (offset < size)
+        {
+            if ((0U == (offset % BENCH_SECTOR_SZ)) && (false == erased))
+            {
+                if (false == DRV_SST26_RequestQueue(benchHandle, DRV_SST26_REQUEST_SECTOR_ERASE, NULL,
+                        0, address + offset, benchCallback, 0))
+                {
+                    break;
+                }
+
+                erased = true;
+            }
+            else
+            {
+                if (false == DRV_SST26_RequestQueue(benchHandle, DRV_SST26_REQUEST_PAGE_WRITE, &benchImage[offset],
+                        DRV_SST26_PAGE_SIZE, address + offset, benchCallback, 0))
+                {
+                    break;
+                }
+
+                offset += DRV_SST26_PAGE_SIZE;
+                erased  = false;
+            }
+
+            numRequests++;
+        }
+    }
+
+    benchLoopTask();
+    benchCheck(numRequests == benchNumCallbacks, "queued program callbacks");
+    benchCheck(0U == benchNumCallbackErrors, "queued program");
+    benchLoopPrint("sst26 queued", size, startNs);
+}
+
+/* Adjacent reads queued behind the one in progress are merged. */
+static void benchReadQueued(uint32_t address, uint32_t size)
+{
+    RNWF_SIM_SST26_STATS before;
+    RNWF_SIM_SST26_STATS after;
+    uint64_t startNs = RNWF_SimTimeNs();
+    uint32_t numRequests = 0;
+    uint32_t offset = 0;
+
+    benchNumCallbacks      = 0;
+    benchNumCallbackErrors = 0;
+
+    (void)memset(benchReadBuf, 0, size);
+
+    RNWF_SimSst26StatsGet(&before);
+    benchLoopReset();
+
+    while ((0U != DRV_SST26_RequestQueueCount(benchHandle)) || (offset < size))
+    {
+        benchLoopTask();
+
+        while ((offset < size) && (true == DRV_SST26_RequestQueue(benchHandle, DRV_SST26_REQUEST_READ,
+                &benchReadBuf[offset], BENCH_READ_SZ, address + offset, benchCallback, 0)))
+        {
+            offset += BENCH_READ_SZ;
+            numRequests++;
+        }
+    }
+
+    benchLoopTask();
+    RNWF_SimSst26StatsGet(&after);
+
+    benchCheck(numRequests == benchNumCallbacks, "queued read callbacks");
+    benchCheck(0U == benchNumCallbackErrors, "queued read");
+    benchCheck(0 == memcmp(benchReadBuf, benchImage, size), "queued read data");
+    benchCheck((after.reads - before.reads) < numRequests, "queued reads merged");
+
+    benchLoopPrint("sst26 read", size, startNs);
+    printf("sst26 read merge  %u requests of %u bytes, %u read commands\n",
+            numRequests, BENCH_READ_SZ, after.reads - before.reads);
+}
+
+int main(int argc, char *argv[])
+{
+    RNWF_SIM_CONFIG config;
+    RNWF_SIM_SST26_STATS stats;
+    const char *pFlashFile = NULL;
+    uint32_t size;
+    uint32_t i;
+    int arg;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    for (arg=1; arg<argc; arg++)
+    {
+        if (0 == strcmp(argv[arg], "--quick"))
+        {
+            benchQuick = true;
+        }
+        else if ((0 == strcmp(argv[arg], "--flash-file")) && ((arg+1) < argc))
+        {
+            pFlashFile = argv[++arg];
+        }
+        else
+        {
+            printf("usage: %s [--quick] [--flash-file PATH]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    (void)memset(&config, 0, sizeof(config));
+
+    config.baud = 230400U;
+
+    RNWF_SimInit(&config);
+
+    if (false == RNWF_SimSst26Init(pFlashFile))
+    {
+        printf("FAIL: SST26 flash file %s\n", pFlashFile);
+        return 1;
+    }
+
+    PORT_Initialize();
+    SERCOM6_SPI_Initialize();
+
+    sysObj.drvSST26 = DRV_SST26_Initialize((SYS_MODULE_INDEX)DRV_SST26_INDEX, (SYS_MODULE_INIT *)&benchSst26InitData);
+    benchHandle     = DRV_SST26_Open(DRV_SST26_INDEX, DRV_IO_INTENT_READWRITE);
+
+    if (DRV_HANDLE_INVALID == benchHandle)
+    {
+        printf("FAIL: SST26 open\n");
+        return 1;
+    }
+
+    size = (true == benchQuick) ? BENCH_IMAGE_SZ_QUICK : BENCH_IMAGE_SZ;
+
+    for (i=0; i<size; i++)
+    {
+        benchImage[i] = RNWF_SimContentByte(0x55aa55aaU, i);
+    }
+
+    benchProgramBlocking(0, size);
+    benchCheck(0 == memcmp(RNWF_SimSst26Data(), benchImage, size), "blocking image");
+
+    benchProgramQueued(BENCH_QUEUED_ADDR, size);
+    benchCheck(0 == memcmp(&RNWF_SimSst26Data()[BENCH_QUEUED_ADDR], benchImage, size), "queued image");
+
+    benchReadQueued(BENCH_QUEUED_ADDR, size);
+
+    RNWF_SimSst26StatsGet(&stats);
+
+    printf("sst26             %u page programs, %u sector erases, %u busy polls\n",
+            stats.pagePrograms, stats.sectorErases, stats.busyPolls);
+
+    benchCheck(0U == stats.numErrors, "SST26 command errors");
+
+    if (0 != benchNumFailed)
+    {
+        printf("%d checks failed\n", benchNumFailed);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+#ifndef CONF_WINC_DEV_H
+#define CONF_WINC_DEV_H
+
+#include <stdint.h>
+
+/* Host build configuration for the WINCS02 driver running against the
+   simulated device in sim_winc_dev.c. */
+
+#define WINC_CONF_ENABLE_NC_BERKELEY_SOCKETS
+
+/* Keep the driver socket API clear of the C library socket functions. */
+#define WINC_SOCK_NS(FUNC)                  winc_##FUNC
+
+/* Per class command request statistics, queueing delays are in simulated
+   microseconds. */
+#define WINC_DEV_CMD_CLASS_STATS_ENABLE
+
+#ifndef WINC_SIM_NO_TIME_SOURCE
+uint32_t WINC_SimTimeMs(void);
+uint32_t WINC_SimTimeUs(void);
+
+#define WINC_CONF_TIME_MS_GET()             WINC_SimTimeMs()
+#define WINC_CONF_TICK_GET()                WINC_SimTimeUs()
+#endif
+
+#ifdef WINC_SIM_THREADS
+/* Socket locks and the poll() semaphore for an application thread using
+   the sockets while another thread runs the driver. */
+#include <pthread.h>
+#include <semaphore.h>
+
+void WINC_SimLockCreate(pthread_mutex_t *pMutex);
+void WINC_SimSemWait(sem_t *pSem, uint32_t ms);
+
+#define WINC_CONF_LOCK_STORAGE(NAME)        pthread_mutex_t NAME
+#define WINC_CONF_LOCK_CREATE(NAME)         WINC_SimLockCreate(NAME)
+#define WINC_CONF_LOCK_DESTROY(NAME)        (void)pthread_mutex_destroy(NAME)
+#define WINC_CONF_LOCK_ENTER(NAME)          (0 == pthread_mutex_lock(NAME))
+#define WINC_CONF_LOCK_TRY_ENTER(NAME)      (0 == pthread_mutex_trylock(NAME))
+#define WINC_CONF_LOCK_LEAVE(NAME)          (void)pthread_mutex_unlock(NAME)
+
+#define WINC_CONF_SEM_STORAGE(NAME)         sem_t NAME
+#define WINC_CONF_SEM_CREATE(NAME)          (void)sem_init(NAME, 0, 0)
+#define WINC_CONF_SEM_DESTROY(NAME)         (void)sem_destroy(NAME)
+#define WINC_CONF_SEM_WAIT(NAME, MS)        WINC_SimSemWait(NAME, MS)
+#define WINC_CONF_SEM_POST(NAME)            (void)sem_post(NAME)
+#endif
+
+#endif /* CONF_WINC_DEV_H */
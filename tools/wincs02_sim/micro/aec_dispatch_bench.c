@@ -0,0 +1,264 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+/* AEC dispatch benchmark.
+
+   Delivers bursts of SOCKRXT AECs from the simulated device to the device
+   and socket layers, with the WDRV layer's module handlers registered as an
+   AEC callback. Before the dispatch table the WDRV layer subscribed to all
+   modules and passed every AEC to each of its module handlers in turn,
+   that callback is reproduced here against the real handlers. Now it
+   subscribes only to the modules it handles, so socket AECs never reach
+   it. The host time handling device events is reported per AEC for both,
+   excluding time spent inside the simulated device. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "micro_time.h"
+#include "micro_dev.h"
+#include "wdrv_winc.h"
+
+#define AEC_NUM_EVENTS              10000U
+#define AEC_NUM_BURSTS              10U
+#define AEC_SOCK_ID                 0x7fffU
+#define AEC_DEV_RX_BUF_SZ           2048U
+#define AEC_SOCK_SLAB_NUM           8
+
+/* The WDRV layer's AEC handlers as they were dispatched before the table
+   was indexed by module ID. */
+static const struct
+{
+    uint8_t             modId;
+    WINC_DEV_AEC_RSP_CB pfAecRspCallback;
+} aecWdrvHandlers[] =
+{
+    {WINC_MOD_ID_WSCN,      WDRV_WINC_WSCNProcessAEC},
+    {WINC_MOD_ID_WSTA,      WDRV_WINC_WSTAProcessAEC},
+#ifndef WDRV_WINC_MOD_DISABLE_ICMP
+    {WINC_MOD_ID_PING,      WDRV_WINC_ICMPProcessAEC},
+#endif
+    {WINC_MOD_ID_TIME,      WDRV_WINC_TIMEProcessAEC},
+    {WINC_MOD_ID_WAP,       WDRV_WINC_WAPProcessAEC},
+#ifndef WDRV_WINC_MOD_DISABLE_MQTT
+    {WINC_MOD_ID_MQTT,      WDRV_WINC_MQTTProcessAEC},
+#endif
+    {WINC_MOD_ID_EXTCRYPTO, WDRV_WINC_EXTCRYPTOProcessAEC},
+#ifndef WDRV_WINC_MOD_DISABLE_DNS
+    {WINC_MOD_ID_DNS,       WDRV_WINC_DNSProcessAEC},
+#endif
+    {WINC_MOD_ID_NETIF,     WDRV_WINC_NETIFProcessAEC},
+#ifndef WDRV_WINC_MOD_DISABLE_PROV
+    {WINC_MOD_ID_WPROV,     WDRV_WINC_ProvProcessAEC},
+#endif
+    {WINC_MOD_ID_ASSOC,     WDRV_WINC_AssocProcessAEC},
+#ifndef WDRV_WINC_MOD_DISABLE_OTA
+    {WINC_MOD_ID_OTA,       WDRV_WINC_OTAProcessAEC},
+#endif
+#ifndef WDRV_WINC_MOD_DISABLE_NVM
+    {WINC_MOD_ID_NVM,       WDRV_WINC_NVMProcessAEC},
+#endif
+#ifndef WDRV_WINC_MOD_DISABLE_PPS
+    {WINC_MOD_ID_PPS,       WDRV_WINC_PPSProcessAEC},
+#endif
+#ifndef WDRV_WINC_MOD_DISABLE_SYSLOG
+    {WINC_MOD_ID_SYSLOG,    WDRV_WINC_SYSLOGProcessAEC},
+#endif
+};
+
+#define AEC_NUM_WDRV_HANDLERS       (sizeof(aecWdrvHandlers)/sizeof(aecWdrvHandlers[0]))
+
+static WINC_DEVICE_HANDLE aecDevHandle = WINC_DEVICE_INVALID_HANDLE;
+static uint8_t aecDevRxBuffer[AEC_DEV_RX_BUF_SZ];
+static WDRV_WINC_CTRLDCPT aecCtrl;
+static WDRV_WINC_DCPT aecDcpt = {.pCtrl = &aecCtrl};
+static int aecNumFailed;
+
+/* Host time spent inside the simulated device. */
+static uint64_t aecSimHostNs;
+
+static uint32_t aecNumWdrvCalls;
+
+static void aecCheck(bool result, const char *pDesc)
+{
+    if (false == result)
+    {
+        printf("FAIL: %s\n", pDesc);
+        aecNumFailed++;
+    }
+}
+
+static bool aecSendReceive(void *pTransmitData, void *pReceiveData, size_t size)
+{
+    uint64_t startNs = microHostNs();
+    bool result;
+
+    result = WINC_SimSendReceive(pTransmitData, pReceiveData, size);
+
+    aecSimHostNs += microHostNs() - startNs;
+
+    return result;
+}
+
+static bool aecSendReceiveList(const WINC_SDIO_XFER *pXferList, size_t numXfers)
+{
+    uint64_t startNs = microHostNs();
+    bool result;
+
+    result = WINC_SimSendReceiveList(pXferList, numXfers);
+
+    aecSimHostNs += microHostNs() - startNs;
+
+    return result;
+}
+
+static bool aecXferQueue(const WINC_SDIO_XFER *pXferList, size_t numXfers, WINC_SDIO_XFER_CALLBACK pfCallback, uintptr_t context)
+{
+    uint64_t startNs = microHostNs();
+    bool result;
+
+    result = WINC_SimXferQueue(pXferList, numXfers, pfCallback, context);
+
+    aecSimHostNs += microHostNs() - startNs;
+
+    return result;
+}
+
+/* The WDRV layer's AEC callback before the dispatch table, every AEC is
+   passed to each module handler which filters by AEC ID. */
+static void aecWdrvProcessAEC(uintptr_t context, WINC_DEVICE_HANDLE devHandle, const WINC_DEV_EVENT_RSP_ELEMS *const pElems)
+{
+    unsigned int i;
+
+    aecNumWdrvCalls++;
+
+    for (i=0; i<AEC_NUM_WDRV_HANDLERS; i++)
+    {
+        aecWdrvHandlers[i].pfAecRspCallback(context, devHandle, pElems);
+    }
+}
+
+/* Deliver AEC_NUM_EVENTS SOCKRXT AECs for a socket which is not open,
+   returns the host time spent handling device events. */
+static uint64_t aecBurst(void)
+{
+    uint64_t eventHostNs = 0;
+    uint32_t numQueued = 0;
+
+    while ((numQueued < AEC_NUM_EVENTS) || (0U != WINC_SimMsgPending()))
+    {
+        uint64_t startNs;
+        uint64_t simHostNs;
+
+        if (numQueued < AEC_NUM_EVENTS)
+        {
+            numQueued += WINC_SimSockRxtInject(AEC_SOCK_ID, 1024, AEC_NUM_EVENTS - numQueued);
+        }
+
+        startNs   = microHostNs();
+        simHostNs = aecSimHostNs;
+
+        if (true == WINC_SimIntAsserted())
+        {
+            (void)WINC_DevHandleEvent(aecDevHandle, NULL);
+        }
+
+        (void)WINC_DevUpdateEvent(aecDevHandle);
+
+        eventHostNs += (microHostNs() - startNs) - (aecSimHostNs - simHostNs);
+    }
+
+    return eventHostNs;
+}
+
+/* Time AEC_NUM_BURSTS bursts with the WDRV callback subscribed to modMask,
+   returns the host time per AEC. */
+static double aecRun(uint64_t modMask, unsigned int numBursts)
+{
+    uint64_t eventHostNs = 0;
+    unsigned int i;
+
+    aecCheck(WINC_DevAECCallbackRegisterMask(aecDevHandle, aecWdrvProcessAEC, (uintptr_t)&aecDcpt, modMask), "WDRV AEC callback register");
+
+    /* Warm up the caches. */
+    (void)aecBurst();
+
+    aecNumWdrvCalls = 0;
+
+    for (i=0; i<numBursts; i++)
+    {
+        eventHostNs += aecBurst();
+    }
+
+    aecCheck(WINC_DevAECCallbackDeregister(aecDevHandle, aecWdrvProcessAEC), "WDRV AEC callback deregister");
+
+    return (double)eventHostNs / ((double)numBursts * AEC_NUM_EVENTS);
+}
+
+int main(int argc, char *argv[])
+{
+    static const MICRO_DEV_XFER xfer = {aecSendReceive, aecSendReceiveList, aecXferQueue};
+    unsigned int numBursts = AEC_NUM_BURSTS;
+    WINC_SIM_STATS stats;
+    uint64_t wdrvModMask = 0;
+    double subscribedNs;
+    double allNs;
+    unsigned int i;
+
+    if ((argc > 1) && (0 == strcmp(argv[1], "--quick")))
+    {
+        numBursts = 1;
+    }
+
+    /* The socket layer subscribes to SOCKET and DNS AECs. */
+    aecDevHandle = microDevInit(aecDevRxBuffer, sizeof(aecDevRxBuffer), AEC_SOCK_SLAB_NUM, &xfer);
+
+    if (WINC_DEVICE_INVALID_HANDLE == aecDevHandle)
+    {
+        printf("FAIL: device init\n");
+        return 1;
+    }
+
+    for (i=0; i<AEC_NUM_WDRV_HANDLERS; i++)
+    {
+        wdrvModMask |= WINC_DEV_AEC_MOD_MASK(aecWdrvHandlers[i].modId);
+    }
+
+    subscribedNs = aecRun(wdrvModMask, numBursts);
+
+    aecCheck(0U == aecNumWdrvCalls, "WDRV callback subscribed only to its modules");
+
+    allNs = aecRun(WINC_DEV_AEC_MOD_MASK_ALL, numBursts);
+
+    aecCheck((numBursts * AEC_NUM_EVENTS) == aecNumWdrvCalls, "WDRV callback subscribed to all modules");
+
+    WINC_SimStatsGet(&stats);
+
+    aecCheck(0U == stats.numErrors, "device protocol errors");
+
+    printf("aec dispatch:  %u x %u SOCKRXT, host ns per AEC %.0f with the WDRV layer subscribed to its modules, %.0f to all modules (%u handlers)\n",
+            numBursts, AEC_NUM_EVENTS, subscribedNs, allNs, (unsigned int)AEC_NUM_WDRV_HANDLERS);
+
+    if (0 != aecNumFailed)
+    {
+        printf("%d checks failed\n", aecNumFailed);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,202 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+/* Command request pool check and benchmark.
+
+   Times building a one command request with WDRV_WINC_CmdReqInit() and
+   releasing it with WDRV_WINC_DevDiscardCmdReq(), against the heap
+   allocation every request used before the pool. Requests are held eight
+   at a time, as they would be while in flight. The pool statistics are
+   checked for leaks, and exhaustion is checked to fall through to the
+   large class and then the heap. */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "micro_time.h"
+#include "wdrv_winc.h"
+#include "winc_cmds.h"
+
+#define POOL_IN_FLIGHT              8U
+#define POOL_LOOPS                  200000U
+
+typedef WINC_CMD_REQ_HANDLE (*POOL_ALLOC_FP)(void);
+typedef void (*POOL_FREE_FP)(WINC_CMD_REQ_HANDLE cmdReqHandle);
+
+static int poolNumFailed;
+
+static void poolCheck(bool result, const char *pDesc)
+{
+    if (false == result)
+    {
+        printf("FAIL: %s\n", pDesc);
+        poolNumFailed++;
+    }
+}
+
+static void poolCmdRspCallback(uintptr_t context, WINC_DEVICE_HANDLE devHandle, WINC_CMD_REQ_HANDLE cmdReqHandle, WINC_DEV_CMDREQ_EVENT_TYPE event, uintptr_t eventArg)
+{
+}
+
+static WINC_CMD_REQ_HANDLE poolAlloc(void)
+{
+    return WDRV_WINC_CmdReqInit(1, 0, poolCmdRspCallback, 0);
+}
+
+/* The allocation WDRV_WINC_CmdReqInit() made before the pool. */
+static WINC_CMD_REQ_HANDLE heapAlloc(void)
+{
+    void *pCmdReqBuffer = OSAL_Malloc(WDRV_WINC_CMD_REQ_CMD_SZ);
+
+    if (NULL == pCmdReqBuffer)
+    {
+        return WINC_CMD_REQ_INVALID_HANDLE;
+    }
+
+    return WINC_CmdReqInit(pCmdReqBuffer, WDRV_WINC_CMD_REQ_CMD_SZ, 1, poolCmdRspCallback, 0);
+}
+
+static void heapFree(WINC_CMD_REQ_HANDLE cmdReqHandle)
+{
+    OSAL_Free((void*)cmdReqHandle);
+}
+
+/* Build and release requests, returns false if any could not be built. */
+static bool poolRun(POOL_ALLOC_FP pfAlloc, POOL_FREE_FP pfFree, unsigned int loops, uint64_t *pNs, uint64_t *pCycles)
+{
+    WINC_CMD_REQ_HANDLE cmdReqHandles[POOL_IN_FLIGHT];
+    uint64_t startNs = microHostNs();
+    uint64_t startCycles = microCycles();
+    bool result = true;
+    unsigned int i;
+    unsigned int j;
+
+    for (i=0; i<loops; i++)
+    {
+        for (j=0; j<POOL_IN_FLIGHT; j++)
+        {
+            cmdReqHandles[j] = pfAlloc();
+
+            if ((WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandles[j]) ||
+                    (false == WINC_CmdSOCKLST(cmdReqHandles[j], WINC_CMDSOCKLST_SOCK_ID_IGNORE_VAL)))
+            {
+                result = false;
+            }
+        }
+
+        for (j=0; j<POOL_IN_FLIGHT; j++)
+        {
+            pfFree(cmdReqHandles[j]);
+        }
+    }
+
+    *pCycles = microCycles() - startCycles;
+    *pNs     = microHostNs() - startNs;
+
+    return result;
+}
+
+static void poolExhaust(void)
+{
+    WDRV_WINC_CMD_REQ_POOL_STATS before[2];
+    WDRV_WINC_CMD_REQ_POOL_STATS after[2];
+    WINC_CMD_REQ_HANDLE cmdReqHandles[16];
+    unsigned int numHeld;
+    unsigned int i;
+
+    poolCheck(2 == WDRV_WINC_CmdReqPoolStatsGet(before, 2), "pool stats");
+
+    numHeld = (unsigned int)before[0].numBlocks + before[1].numBlocks + 1U;
+
+    if (numHeld > (sizeof(cmdReqHandles) / sizeof(WINC_CMD_REQ_HANDLE)))
+    {
+        poolCheck(false, "pool size");
+        return;
+    }
+
+    /* Fill the small class, then the large, then one from the heap. */
+    for (i=0; i<numHeld; i++)
+    {
+        cmdReqHandles[i] = poolAlloc();
+
+        poolCheck(WINC_CMD_REQ_INVALID_HANDLE != cmdReqHandles[i], "exhausted pool heap fallback");
+    }
+
+    (void)WDRV_WINC_CmdReqPoolStatsGet(after, 2);
+
+    poolCheck((0U == after[0].numFree) && (0U == after[1].numFree), "pool fully used");
+    poolCheck((after[0].numExhausted - before[0].numExhausted) == ((uint32_t)before[1].numBlocks + 1U), "small class exhaustion count");
+    poolCheck(after[1].numExhausted == before[1].numExhausted, "large class exhaustion count");
+
+    for (i=0; i<numHeld; i++)
+    {
+        WDRV_WINC_DevDiscardCmdReq(cmdReqHandles[i]);
+    }
+
+    (void)WDRV_WINC_CmdReqPoolStatsGet(after, 2);
+
+    poolCheck((after[0].numFree == after[0].numBlocks) && (after[1].numFree == after[1].numBlocks), "pool returned after exhaustion");
+}
+
+int main(int argc, char *argv[])
+{
+    WDRV_WINC_CMD_REQ_POOL_STATS stats[2];
+    unsigned int loops = POOL_LOOPS;
+    uint64_t poolNs;
+    uint64_t poolCycles;
+    uint64_t heapNs;
+    uint64_t heapCycles;
+    double numCmds;
+
+    if ((argc > 1) && (0 == strcmp(argv[1], "--quick")))
+    {
+        loops = POOL_LOOPS / 20U;
+    }
+
+    poolCheck(true == poolRun(heapAlloc, heapFree, loops, &heapNs, &heapCycles), "heap requests");
+    poolCheck(true == poolRun(poolAlloc, WDRV_WINC_DevDiscardCmdReq, loops, &poolNs, &poolCycles), "pool requests");
+
+    poolCheck(2 == WDRV_WINC_CmdReqPoolStatsGet(stats, 2), "pool stats");
+    poolCheck(stats[0].numFree == stats[0].numBlocks, "small class returned");
+    poolCheck(stats[0].peakUsage == POOL_IN_FLIGHT, "small class peak usage");
+    poolCheck(stats[0].numAllocs == (loops * POOL_IN_FLIGHT), "small class allocations");
+    poolCheck((0U == stats[0].numExhausted) && (0U == stats[1].numAllocs), "requests served by the small class");
+
+    poolExhaust();
+
+    numCmds = (double)loops * POOL_IN_FLIGHT;
+
+    printf("cmd req pool:  %u x %zu and %u x %zu byte buffers, %u held\n",
+            stats[0].numBlocks, stats[0].blockSize, stats[1].numBlocks, stats[1].blockSize, POOL_IN_FLIGHT);
+
+#ifdef MICRO_HAVE_CYCLES
+    printf("cmd req cost:  pool %.1f ns %.0f cycles, heap %.1f ns %.0f cycles per request\n",
+            (double)poolNs / numCmds, (double)poolCycles / numCmds,
+            (double)heapNs / numCmds, (double)heapCycles / numCmds);
+#else
+    printf("cmd req cost:  pool %.1f ns, heap %.1f ns per request\n",
+            (double)poolNs / numCmds, (double)heapNs / numCmds);
+#endif
+
+    if (0 != poolNumFailed)
+    {
+        printf("%d checks failed\n", poolNumFailed);
+        return 1;
+    }
+
+    return 0;
+}
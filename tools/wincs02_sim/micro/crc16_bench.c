@@ -0,0 +1,173 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+/* SDIO CRC16 check and benchmark.
+
+   Builds the SDIO transport directly so the static CRC16 functions can be
+   called. The slicing-by-4 sdioCRC16() is checked against the single byte
+   reference table over random lengths, alignments and data, then both are
+   timed over 512 byte data blocks. */
+
+#include <stdio.h>
+
+#include "micro_time.h"
+#include "winc_sdio_drv.c"
+
+/* Normally provided by winc_dev.c, which is not built here. */
+WINC_DEBUG_PRINTF_FP pfWINCDevDebugPrintf = NULL;
+
+#define CRC_CHECK_BUFFERS           100000U
+#define CRC_CHECK_MAX_LEN           1027U
+#define CRC_BLOCK_SZ                512U
+#define CRC_NUM_BLOCKS              64U
+#define CRC_LOOPS                   2000U
+
+static uint32_t crcRandState = 0x2468ace1U;
+
+static uint32_t crcRand(void)
+{
+    crcRandState ^= crcRandState << 13;
+    crcRandState ^= crcRandState >> 17;
+    crcRandState ^= crcRandState << 5;
+
+    return crcRandState;
+}
+
+/* sdioCRC16() returns the CRC in transmit byte order. */
+static uint16_t crcRefSwapped(const uint8_t *p, size_t l)
+{
+    uint16_t crc = sdioCRC16Ref(0, p, l);
+
+    return (uint16_t)((crc << 8) | ((crc >> 8) & 0xffU));
+}
+
+static bool crcCheck(void)
+{
+    static uint8_t buffer[CRC_CHECK_MAX_LEN + 3U];
+    unsigned int n;
+    size_t i;
+
+    for (n=0; n<CRC_CHECK_BUFFERS; n++)
+    {
+        size_t offset = crcRand() % 4U;
+        size_t length = crcRand() % (CRC_CHECK_MAX_LEN + 1U);
+
+        for (i=0; i<length; i++)
+        {
+            buffer[offset + i] = (uint8_t)crcRand();
+        }
+
+        if (sdioCRC16(&buffer[offset], length) != crcRefSwapped(&buffer[offset], length))
+        {
+            printf("FAIL: CRC16 mismatch, buffer %u length %zu offset %zu\n", n, length, offset);
+            return false;
+        }
+    }
+
+    /* CRC-16/XMODEM check value. */
+    if (0x31c3U != sdioCRC16Ref(0, (const uint8_t*)"123456789", 9))
+    {
+        printf("FAIL: CRC16 reference check value\n");
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    static uint8_t blocks[CRC_NUM_BLOCKS][CRC_BLOCK_SZ];
+    unsigned int loops = CRC_LOOPS;
+    uint32_t sink = 0;
+    uint64_t sliceNs;
+    uint64_t sliceCycles;
+    uint64_t refNs;
+    uint64_t refCycles;
+    double numBlocks;
+    unsigned int i;
+    unsigned int j;
+
+    if ((argc > 1) && (0 == strcmp(argv[1], "--quick")))
+    {
+        loops = CRC_LOOPS / 20U;
+    }
+
+    /* CRCs are disabled by default, enable them as CMD59 would. */
+    useCRCs = true;
+
+    if (false == crcCheck())
+    {
+        return 1;
+    }
+
+    for (i=0; i<CRC_NUM_BLOCKS; i++)
+    {
+        for (j=0; j<CRC_BLOCK_SZ; j++)
+        {
+            blocks[i][j] = (uint8_t)crcRand();
+        }
+    }
+
+    sliceNs     = microHostNs();
+    sliceCycles = microCycles();
+
+    for (j=0; j<loops; j++)
+    {
+        for (i=0; i<CRC_NUM_BLOCKS; i++)
+        {
+            sink += sdioCRC16(blocks[i], CRC_BLOCK_SZ);
+        }
+    }
+
+    sliceCycles = microCycles() - sliceCycles;
+    sliceNs     = microHostNs() - sliceNs;
+
+    refNs     = microHostNs();
+    refCycles = microCycles();
+
+    for (j=0; j<loops; j++)
+    {
+        for (i=0; i<CRC_NUM_BLOCKS; i++)
+        {
+            sink -= crcRefSwapped(blocks[i], CRC_BLOCK_SZ);
+        }
+    }
+
+    refCycles = microCycles() - refCycles;
+    refNs     = microHostNs() - refNs;
+
+    if (0U != sink)
+    {
+        printf("FAIL: CRC16 results differ\n");
+        return 1;
+    }
+
+    numBlocks = (double)loops * CRC_NUM_BLOCKS;
+
+    printf("crc16 check:   %u random buffers match the reference\n", CRC_CHECK_BUFFERS);
+
+#ifdef MICRO_HAVE_CYCLES
+    printf("crc16 block:   slice-by-4 %.0f ns %.0f cycles, byte table %.0f ns %.0f cycles per %u bytes\n",
+            (double)sliceNs / numBlocks, (double)sliceCycles / numBlocks,
+            (double)refNs / numBlocks, (double)refCycles / numBlocks, CRC_BLOCK_SZ);
+#else
+    printf("crc16 block:   slice-by-4 %.0f ns, byte table %.0f ns per %u bytes\n",
+            (double)sliceNs / numBlocks, (double)refNs / numBlocks, CRC_BLOCK_SZ);
+#endif
+
+    return 0;
+}
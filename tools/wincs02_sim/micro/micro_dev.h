@@ -0,0 +1,107 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+#ifndef MICRO_DEV_H
+#define MICRO_DEV_H
+
+/* Simulated device bring up for the micro benchmarks which run the device
+   and socket layers. The transport functions default to the simulated
+   device, a benchmark passes its own to time or wrap the bus. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "winc_sdio_drv.h"
+#include "winc_dev.h"
+#include "winc_socket.h"
+#include "sim_winc_dev.h"
+
+#define MICRO_DEV_SOCK_SLAB_SZ      1472U
+
+typedef struct
+{
+    WINC_SDIO_SEND_RECEIVE_FP           pfSendReceive;
+    WINC_SDIO_SEND_RECEIVE_LIST_FP      pfSendReceiveList;
+    WINC_SDIO_XFER_QUEUE_FP             pfXferQueue;
+} MICRO_DEV_XFER;
+
+/* Bring up the simulated device and the device layer, and the socket layer
+   with numSlabs receive slabs. pXfer may be NULL. */
+static inline WINC_DEVICE_HANDLE microDevInit(uint8_t *pReceiveBuffer, size_t receiveBufferSize, int numSlabs, const MICRO_DEV_XFER *pXfer)
+{
+    WINC_SIM_CONFIG config = {.busHz = 20000000U, .latencyUs = 100U, .dnsMs = 40U};
+    MICRO_DEV_XFER xfer = {WINC_SimSendReceive, WINC_SimSendReceiveList, WINC_SimXferQueue};
+    WINC_DEV_INIT devInitData;
+    WINC_SOCKET_INIT_TYPE sockInitData;
+    WINC_SDIO_STATE_TYPE sdioState = WINC_SDIO_STATE_UNKNOWN;
+    WINC_SDIO_STATUS_TYPE sdioStatus = WINC_SDIO_STATUS_RESET_FAILED;
+    WINC_DEVICE_HANDLE devHandle;
+    int i;
+
+    if (NULL != pXfer)
+    {
+        xfer = *pXfer;
+    }
+
+    WINC_SimInit(&config);
+
+    devInitData.pReceiveBuffer    = pReceiveBuffer;
+    devInitData.receiveBufferSize = receiveBufferSize;
+
+    devHandle = WINC_DevInit(&devInitData);
+
+    if (WINC_DEVICE_INVALID_HANDLE == devHandle)
+    {
+        return WINC_DEVICE_INVALID_HANDLE;
+    }
+
+    sockInitData.pfMemAlloc = malloc;
+    sockInitData.pfMemFree  = free;
+    sockInitData.slabSize   = MICRO_DEV_SOCK_SLAB_SZ;
+    sockInitData.numSlabs   = numSlabs;
+
+    if (false == WINC_SockInit(devHandle, &sockInitData))
+    {
+        return WINC_DEVICE_INVALID_HANDLE;
+    }
+
+    for (i=0; i<100; i++)
+    {
+        sdioStatus = WINC_SDIODeviceInit(&sdioState, xfer.pfSendReceive);
+
+        if ((WINC_SDIO_STATUS_OK == sdioStatus) || (sdioStatus < 0))
+        {
+            break;
+        }
+    }
+
+    if (WINC_SDIO_STATUS_OK != sdioStatus)
+    {
+        return WINC_DEVICE_INVALID_HANDLE;
+    }
+
+    WINC_SDIOSendReceiveListSet(xfer.pfSendReceiveList);
+    WINC_SDIOTransferQueueSet(xfer.pfXferQueue, WINC_SimXferWait);
+
+    (void)WINC_DevBusStateSet(devHandle, WINC_DEV_BUS_STATE_ACTIVE);
+
+    return devHandle;
+}
+
+#endif /* MICRO_DEV_H */
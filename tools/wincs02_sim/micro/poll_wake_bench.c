@@ -0,0 +1,389 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+/* Blocking poll() wake latency.
+
+   Built with WINC_SIM_THREADS, which maps the socket locks onto mutexes
+   and the poll() semaphore onto a POSIX semaphore. A driver thread runs
+   the device tasks, keeping simulated time in step with the host clock
+   while idle, and the main thread blocks in poll() with an infinite
+   timeout. Each round the driver thread waits 2 ms, sends to the echo
+   service and drains the echo once the main thread has woken. The wake
+   latency runs from the start of the driver event pass which received the
+   echo to poll() returning. The main thread's CPU time while blocked is
+   reported against the time it was blocked, as is a 20 ms timeout with
+   nothing to receive. */
+
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "micro_time.h"
+#include "micro_dev.h"
+
+#define POLL_ROUNDS                 200U
+#define POLL_ECHO_PORT              7U
+#define POLL_SEND_DELAY_NS          2000000U
+#define POLL_IDLE_NS                50000U
+#define POLL_TIMEOUT_MS             20
+#define POLL_DATA_SZ                16U
+#define POLL_DEV_RX_BUF_SZ          2048U
+#define POLL_SOCK_SLAB_NUM          50
+
+static WINC_DEVICE_HANDLE pollDevHandle = WINC_DEVICE_INVALID_HANDLE;
+static uint8_t pollDevRxBuffer[POLL_DEV_RX_BUF_SZ];
+static int pollFd = -1;
+static unsigned int pollNumRounds = POLL_ROUNDS;
+static int pollNumFailed;
+
+/* Host time the simulated device was last advanced to. */
+static uint64_t pollSimSyncNs;
+
+/* Round handshake between the application and driver threads. */
+static atomic_uint pollRoundWaiting;
+static atomic_uint pollRoundWoken;
+static atomic_uint pollRoundDrained;
+static atomic_uint pollRoundRxStart;
+static atomic_bool pollStop;
+static uint64_t pollRxStartNs;
+
+void WINC_SimLockCreate(pthread_mutex_t *pMutex)
+{
+    pthread_mutexattr_t attr;
+
+    (void)pthread_mutexattr_init(&attr);
+    (void)pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    (void)pthread_mutex_init(pMutex, &attr);
+    (void)pthread_mutexattr_destroy(&attr);
+}
+
+void WINC_SimSemWait(sem_t *pSem, uint32_t ms)
+{
+    struct timespec ts;
+
+    if (UINT32_MAX == ms)
+    {
+        while ((0 != sem_wait(pSem)) && (EINTR == errno))
+        {
+        }
+
+        return;
+    }
+
+    (void)clock_gettime(CLOCK_REALTIME, &ts);
+
+    ts.tv_sec  += ms / 1000U;
+    ts.tv_nsec += (long)(ms % 1000U) * 1000000L;
+
+    if (ts.tv_nsec >= 1000000000L)
+    {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+
+    (void)sem_timedwait(pSem, &ts);
+}
+
+static void pollCheck(bool result, const char *pDesc)
+{
+    if (false == result)
+    {
+        printf("FAIL: %s\n", pDesc);
+        pollNumFailed++;
+    }
+}
+
+static uint64_t pollThreadCpuNs(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+/* Run the driver tasks once. While the bus is idle sleep briefly and let
+   simulated time follow the host clock. */
+static void pollDriverStep(void)
+{
+    WINC_SIM_STATS before;
+    WINC_SIM_STATS after;
+    uint64_t nowNs;
+
+    WINC_SimStatsGet(&before);
+
+    if (true == WINC_SimIntAsserted())
+    {
+        (void)WINC_DevHandleEvent(pollDevHandle, NULL);
+    }
+
+    (void)WINC_DevUpdateEvent(pollDevHandle);
+
+    WINC_SimStatsGet(&after);
+
+    if (before.numTransactions == after.numTransactions)
+    {
+        struct timespec ts = {0, POLL_IDLE_NS};
+
+        (void)nanosleep(&ts, NULL);
+    }
+
+    nowNs = microHostNs();
+
+    if (nowNs > pollSimSyncNs)
+    {
+        WINC_SimAdvance(nowNs - pollSimSyncNs);
+    }
+
+    pollSimSyncNs = nowNs;
+}
+
+static bool pollReadable(void)
+{
+    struct pollfd pfd = {.fd = pollFd, .events = POLLIN, .revents = 0};
+
+    return (1 == winc_poll(&pfd, 1, 0));
+}
+
+static void pollDriverWait(atomic_uint *pRound, unsigned int round)
+{
+    while ((atomic_load(pRound) != round) && (false == atomic_load(&pollStop)))
+    {
+        pollDriverStep();
+    }
+}
+
+static void* pollDriverThread(void *pArg)
+{
+    static uint8_t data[POLL_DATA_SZ];
+    unsigned int round;
+
+    for (round=1; round<=pollNumRounds; round++)
+    {
+        uint64_t startNs;
+        ssize_t result;
+
+        pollDriverWait(&pollRoundWaiting, round);
+
+        /* Give the application time to block. */
+        startNs = microHostNs();
+
+        while ((microHostNs() - startNs) < POLL_SEND_DELAY_NS)
+        {
+            pollDriverStep();
+        }
+
+        if (POLL_DATA_SZ != winc_send(pollFd, data, POLL_DATA_SZ, 0))
+        {
+            pollCheck(false, "echo send");
+            break;
+        }
+
+        do
+        {
+            startNs = microHostNs();
+
+            pollDriverStep();
+        }
+        while (false == pollReadable());
+
+        pollRxStartNs = startNs;
+        atomic_store(&pollRoundRxStart, round);
+
+        pollDriverWait(&pollRoundWoken, round);
+
+        do
+        {
+            result = winc_recv(pollFd, data, sizeof(data), 0);
+        }
+        while (result > 0);
+
+        atomic_store(&pollRoundDrained, round);
+    }
+
+    while (false == atomic_load(&pollStop))
+    {
+        pollDriverStep();
+    }
+
+    return NULL;
+}
+
+/* Connect to the echo service, running the driver from this thread. */
+static bool pollConnect(void)
+{
+    struct sockaddr_in addr;
+
+    pollFd = winc_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+    if (pollFd < 0)
+    {
+        return false;
+    }
+
+    (void)memset(&addr, 0, sizeof(addr));
+
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(POLL_ECHO_PORT);
+    addr.sin_addr.s_addr = htonl(0xc0a80164U);
+
+    while (winc_connect(pollFd, (struct sockaddr*)&addr, sizeof(addr)) < 0)
+    {
+        if (EINPROGRESS == errno)
+        {
+            break;
+        }
+
+        if (EAGAIN != errno)
+        {
+            return false;
+        }
+
+        pollDriverStep();
+    }
+
+    while (true)
+    {
+        struct pollfd pfd = {.fd = pollFd, .events = POLLOUT, .revents = 0};
+
+        if (1 == winc_poll(&pfd, 1, 0))
+        {
+            return (0 != (pfd.revents & POLLOUT));
+        }
+
+        pollDriverStep();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    pthread_t driverThread;
+    uint64_t totalWakeNs = 0;
+    uint64_t maxWakeNs = 0;
+    uint64_t blockedNs = 0;
+    uint64_t blockedCpuNs = 0;
+    uint64_t timeoutNs;
+    uint64_t timeoutCpuNs;
+    uint32_t timeoutSimMs;
+    unsigned int round;
+    int result;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    if ((argc > 1) && (0 == strcmp(argv[1], "--quick")))
+    {
+        pollNumRounds = POLL_ROUNDS / 10U;
+    }
+
+    pollDevHandle = microDevInit(pollDevRxBuffer, sizeof(pollDevRxBuffer), POLL_SOCK_SLAB_NUM, NULL);
+
+    pollSimSyncNs = microHostNs();
+
+    if ((WINC_DEVICE_INVALID_HANDLE == pollDevHandle) || (false == pollConnect()))
+    {
+        printf("FAIL: device init\n");
+        return 1;
+    }
+
+    if (0 != pthread_create(&driverThread, NULL, pollDriverThread, NULL))
+    {
+        printf("FAIL: driver thread\n");
+        return 1;
+    }
+
+    for (round=1; round<=pollNumRounds; round++)
+    {
+        struct pollfd pfd = {.fd = pollFd, .events = POLLIN, .revents = 0};
+        uint64_t startNs;
+        uint64_t startCpuNs;
+        uint64_t endNs;
+        uint64_t wakeNs;
+
+        atomic_store(&pollRoundWaiting, round);
+
+        startCpuNs = pollThreadCpuNs();
+        startNs    = microHostNs();
+
+        result = winc_poll(&pfd, 1, -1);
+
+        endNs         = microHostNs();
+        blockedCpuNs += pollThreadCpuNs() - startCpuNs;
+        blockedNs    += endNs - startNs;
+
+        pollCheck((1 == result) && (0 != (pfd.revents & POLLIN)), "poll wake");
+
+        /* The driver thread publishes the pass start after it returns. */
+        while (atomic_load(&pollRoundRxStart) != round)
+        {
+        }
+
+        wakeNs = endNs - pollRxStartNs;
+
+        totalWakeNs += wakeNs;
+
+        if (wakeNs > maxWakeNs)
+        {
+            maxWakeNs = wakeNs;
+        }
+
+        atomic_store(&pollRoundWoken, round);
+
+        while (atomic_load(&pollRoundDrained) != round)
+        {
+            struct timespec ts = {0, POLL_IDLE_NS};
+
+            (void)nanosleep(&ts, NULL);
+        }
+    }
+
+    {
+        struct pollfd pfd = {.fd = pollFd, .events = POLLIN, .revents = 0};
+        uint64_t startCpuNs = pollThreadCpuNs();
+        uint64_t startNs = microHostNs();
+        uint32_t startSimMs = WINC_SimTimeMs();
+
+        result = winc_poll(&pfd, 1, POLL_TIMEOUT_MS);
+
+        timeoutSimMs = WINC_SimTimeMs() - startSimMs;
+        timeoutNs    = microHostNs() - startNs;
+        timeoutCpuNs = pollThreadCpuNs() - startCpuNs;
+
+        pollCheck(0 == result, "poll timeout result");
+        pollCheck(timeoutSimMs >= (uint32_t)POLL_TIMEOUT_MS, "poll timeout length");
+    }
+
+    atomic_store(&pollStop, true);
+
+    (void)pthread_join(driverThread, NULL);
+
+    printf("poll wake:     %u wakes, latency avg %.1f us max %.1f us, CPU %.2f%% of %.0f ms blocked\n",
+            pollNumRounds, (double)totalWakeNs / (1000.0 * pollNumRounds), (double)maxWakeNs / 1000.0,
+            (100.0 * (double)blockedCpuNs) / (double)blockedNs, (double)blockedNs / 1000000.0);
+
+    printf("poll timeout:  %d ms timeout returned after %.1f ms, CPU %.2f%%\n",
+            POLL_TIMEOUT_MS, (double)timeoutNs / 1000000.0, (100.0 * (double)timeoutCpuNs) / (double)timeoutNs);
+
+    if (0 != pollNumFailed)
+    {
+        printf("%d checks failed\n", pollNumFailed);
+        return 1;
+    }
+
+    return 0;
+}
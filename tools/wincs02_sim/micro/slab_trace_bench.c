@@ -0,0 +1,717 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+/* Slab allocator trace replay.
+
+   Builds the socket layer directly at trace debug level so the slab
+   allocator's trace prints can be captured and its static functions
+   called. The slab allocations and frees made by an iperf style TCP
+   workload, a stream to the discard service alongside a stream from the
+   character generator, and a UDP workload of 512 and 1472 byte datagrams
+   to the echo service are recorded against a 50 slab pool. Each trace is
+   then replayed against the bitmap allocator and against the first fit
+   allocator it replaced, with smaller pools as well. An allocation which
+   fails in the replay is skipped along with its free, the driver's
+   recovery from the failure is not modelled. */
+
+#define WINC_DEBUG_LEVEL            WINC_DEBUG_TYPE_TRACE
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "micro_time.h"
+#include "winc_socket.c"
+#include "micro_dev.h"
+
+#define SLAB_TRACE_MAX_OPS          400000U
+#define SLAB_TRACE_MAX_LIVE         128U
+#define SLAB_TRACE_REPS             2000U
+#define SLAB_TRACE_ECHO_PORT        7U
+#define SLAB_TRACE_DISCARD_PORT     9U
+#define SLAB_TRACE_CHARGEN_PORT     19U
+#define SLAB_TRACE_ROUND_MS         10000U
+#define SLAB_TRACE_SETTLE_MS        50U
+#define SLAB_TRACE_DEV_RX_BUF_SZ    2048U
+#define SLAB_TRACE_SOCK_SLAB_NUM    50
+
+/* One allocator operation, size is zero for a free. */
+typedef struct
+{
+    uint32_t    id;
+    uint32_t    size;
+} SLAB_TRACE_OP;
+
+typedef struct
+{
+    const char      *pName;
+    SLAB_TRACE_OP   *pOps;
+    uint32_t        numOps;
+    uint32_t        numIds;
+    uint32_t        numFailed;
+} SLAB_TRACE;
+
+/* The first fit allocator replaced by the free bitmap. Free slabs are
+   marked with -1, an allocation holds a count down to 1 at each slab. */
+typedef struct
+{
+    uint8_t     *pRootAddr;
+    size_t      slabSize;
+    int8_t      numSlabs;
+    int8_t      slabIdxs[SLAB_TRACE_MAX_LIVE];
+} SLAB_TRACE_REF_CTX;
+
+static WINC_DEVICE_HANDLE slabDevHandle = WINC_DEVICE_INVALID_HANDLE;
+static uint8_t slabDevRxBuffer[SLAB_TRACE_DEV_RX_BUF_SZ];
+static uint8_t slabBuffer[MAX_UDP_SOCK_PAYLOAD_SZ];
+static int slabNumFailed;
+
+static SLAB_TRACE *pSlabRecTrace;
+static struct
+{
+    void        *p;
+    uint32_t    id;
+} slabRecLive[SLAB_TRACE_MAX_LIVE];
+static unsigned int slabRecNumLive;
+
+static void slabCheck(bool result, const char *pDesc)
+{
+    if (false == result)
+    {
+        printf("FAIL: %s\n", pDesc);
+        slabNumFailed++;
+    }
+}
+
+/*****************************************************************************
+                                Recording
+ *****************************************************************************/
+
+static void slabRecOp(uint32_t id, uint32_t size)
+{
+    if (pSlabRecTrace->numOps < SLAB_TRACE_MAX_OPS)
+    {
+        pSlabRecTrace->pOps[pSlabRecTrace->numOps].id   = id;
+        pSlabRecTrace->pOps[pSlabRecTrace->numOps].size = size;
+    }
+
+    pSlabRecTrace->numOps++;
+}
+
+/* Debug print handler, picks out the slab allocator's trace and error
+   prints and ignores everything else. */
+static void slabRecPrintf(const char *format, ...)
+{
+    va_list args;
+    unsigned int i;
+
+    if (NULL == pSlabRecTrace)
+    {
+        return;
+    }
+
+    va_start(args, format);
+
+    if (NULL != strstr(format, "SLAB[+"))
+    {
+        void *p = va_arg(args, void*);
+        (void)va_arg(args, int);
+        size_t size = va_arg(args, size_t);
+
+        if (slabRecNumLive < SLAB_TRACE_MAX_LIVE)
+        {
+            slabRecLive[slabRecNumLive].p  = p;
+            slabRecLive[slabRecNumLive].id = pSlabRecTrace->numIds;
+            slabRecNumLive++;
+        }
+
+        slabRecOp(pSlabRecTrace->numIds++, (uint32_t)size);
+    }
+    else if (NULL != strstr(format, "SLAB[-"))
+    {
+        void *p = va_arg(args, void*);
+        (void)va_arg(args, int);
+        int numSlabs = va_arg(args, int);
+
+        for (i=0; (numSlabs > 0) && (i<slabRecNumLive); i++)
+        {
+            if (p == slabRecLive[i].p)
+            {
+                slabRecOp(slabRecLive[i].id, 0);
+
+                slabRecLive[i] = slabRecLive[--slabRecNumLive];
+                break;
+            }
+        }
+    }
+    else if (NULL != strstr(format, "failed to allocate slab of"))
+    {
+        unsigned int size = va_arg(args, unsigned int);
+
+        /* Recorded so the replay sees the request, it is never freed. */
+        slabRecOp(pSlabRecTrace->numIds++, (uint32_t)size);
+
+        pSlabRecTrace->numFailed++;
+    }
+
+    va_end(args);
+}
+
+/* Run the driver tasks, letting simulated time pass if nothing is moving. */
+static void slabStep(void)
+{
+    WINC_SIM_STATS before;
+    WINC_SIM_STATS after;
+
+    WINC_SimStatsGet(&before);
+
+    if (true == WINC_SimIntAsserted())
+    {
+        (void)WINC_DevHandleEvent(slabDevHandle, NULL);
+    }
+
+    (void)WINC_DevUpdateEvent(slabDevHandle);
+
+    WINC_SimStatsGet(&after);
+
+    if ((before.numTransactions == after.numTransactions) && (false == WINC_SimIdle()))
+    {
+        WINC_SimAdvance(1000000U);
+    }
+}
+
+static void slabSettle(void)
+{
+    uint64_t endNs = WINC_SimTimeNs() + ((uint64_t)SLAB_TRACE_SETTLE_MS * 1000000U);
+
+    while (WINC_SimTimeNs() < endNs)
+    {
+        slabStep();
+    }
+}
+
+static bool slabRoundExpired(uint64_t startNs)
+{
+    return ((WINC_SimTimeNs() - startNs) > ((uint64_t)SLAB_TRACE_ROUND_MS * 1000000U));
+}
+
+static void slabSockAddr(struct sockaddr_in *pAddr, uint16_t port)
+{
+    (void)memset(pAddr, 0, sizeof(struct sockaddr_in));
+
+    pAddr->sin_family      = AF_INET;
+    pAddr->sin_port        = htons(port);
+    pAddr->sin_addr.s_addr = htonl(0xc0a80164U);
+}
+
+static int slabConnect(uint16_t port)
+{
+    struct sockaddr_in addr;
+    struct pollfd pfd;
+    int fd;
+
+    fd = winc_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    slabSockAddr(&addr, port);
+
+    /* EAGAIN until the device has opened the socket. */
+    while (winc_connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0)
+    {
+        if (EINPROGRESS == errno)
+        {
+            break;
+        }
+
+        if (EAGAIN != errno)
+        {
+            (void)winc_shutdown(fd, SHUT_RDWR);
+            return -1;
+        }
+
+        slabStep();
+    }
+
+    pfd.fd     = fd;
+    pfd.events = POLLOUT;
+
+    do
+    {
+        pfd.revents = 0;
+
+        slabStep();
+    }
+    while (0 == winc_poll(&pfd, 1, 0));
+
+    if (0 == (pfd.revents & POLLOUT))
+    {
+        (void)winc_shutdown(fd, SHUT_RDWR);
+        return -1;
+    }
+
+    return fd;
+}
+
+/* Stream to the discard service and from the character generator at the
+   same time, as an iperf client and server would, then close both. */
+static bool slabTcpRound(size_t total, bool closeTxFirst)
+{
+    uint64_t startNs;
+    size_t sent = 0;
+    size_t recvd = 0;
+    int fdTx;
+    int fdRx;
+
+    fdTx = slabConnect(SLAB_TRACE_DISCARD_PORT);
+    fdRx = slabConnect(SLAB_TRACE_CHARGEN_PORT);
+
+    if ((fdTx < 0) || (fdRx < 0))
+    {
+        return false;
+    }
+
+    startNs = WINC_SimTimeNs();
+
+    while ((sent < total) || (recvd < total))
+    {
+        ssize_t result;
+
+        if (true == slabRoundExpired(startNs))
+        {
+            return false;
+        }
+
+        if (sent < total)
+        {
+            size_t length = ((total - sent) > MAX_TCP_SOCK_PAYLOAD_SZ) ? MAX_TCP_SOCK_PAYLOAD_SZ : (total - sent);
+
+            result = winc_send(fdTx, slabBuffer, length, 0);
+
+            if (result > 0)
+            {
+                sent += (size_t)result;
+            }
+            else if (EWOULDBLOCK != errno)
+            {
+                return false;
+            }
+        }
+
+        if (recvd < total)
+        {
+            result = winc_recv(fdRx, slabBuffer, sizeof(slabBuffer), 0);
+
+            if (result > 0)
+            {
+                recvd += (size_t)result;
+            }
+            else if ((0 == result) || (EWOULDBLOCK != errno))
+            {
+                return false;
+            }
+        }
+
+        slabStep();
+    }
+
+    /* Let the writes drain before closing. */
+    slabSettle();
+
+    (void)winc_shutdown(closeTxFirst ? fdTx : fdRx, SHUT_RDWR);
+    slabStep();
+    (void)winc_shutdown(closeTxFirst ? fdRx : fdTx, SHUT_RDWR);
+
+    slabSettle();
+
+    return true;
+}
+
+/* Datagrams of 512 and 1472 bytes, alternately, to the echo service. */
+static bool slabUdpRound(unsigned int count)
+{
+    SOCKADDR_UNION addr;
+    uint64_t startNs;
+    unsigned int i;
+    int fd;
+
+    fd = winc_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    /* sendto() copies a whole SOCKADDR_UNION into the packet buffer. */
+    slabSockAddr(&addr.in4, SLAB_TRACE_ECHO_PORT);
+
+    startNs = WINC_SimTimeNs();
+
+    for (i=0; i<count; i++)
+    {
+        size_t length = (0U == (i & 1U)) ? 512U : MAX_UDP_SOCK_PAYLOAD_SZ;
+        ssize_t result;
+
+        /* ENOTSOCK until the device has opened the socket. */
+        while (winc_sendto(fd, slabBuffer, length, 0, &addr.sa, sizeof(addr.in4)) < 0)
+        {
+            if (((EWOULDBLOCK != errno) && (EAGAIN != errno) && (ENOTSOCK != errno)) || (true == slabRoundExpired(startNs)))
+            {
+                return false;
+            }
+
+            slabStep();
+        }
+
+        while ((result = winc_recvfrom(fd, slabBuffer, sizeof(slabBuffer), 0, NULL, NULL)) < 0)
+        {
+            if ((EWOULDBLOCK != errno) || (true == slabRoundExpired(startNs)))
+            {
+                return false;
+            }
+
+            slabStep();
+        }
+
+        if ((size_t)result != length)
+        {
+            return false;
+        }
+    }
+
+    (void)winc_shutdown(fd, SHUT_RDWR);
+
+    slabSettle();
+
+    return true;
+}
+
+/*****************************************************************************
+                                 Replay
+ *****************************************************************************/
+
+static bool slabRefInit(SLAB_TRACE_REF_CTX *pCtx, size_t slabSize, int8_t numSlabs)
+{
+    pCtx->pRootAddr = malloc(slabSize * (size_t)numSlabs);
+    pCtx->slabSize  = slabSize;
+    pCtx->numSlabs  = numSlabs;
+
+    (void)memset(pCtx->slabIdxs, 0xff, sizeof(pCtx->slabIdxs));
+
+    return (NULL != pCtx->pRootAddr);
+}
+
+static void* slabRefAlloc(SLAB_TRACE_REF_CTX *pCtx, size_t size)
+{
+    int8_t i;
+    int8_t consecFree;
+    int8_t slabIdx;
+    int8_t reqSlabs;
+
+    reqSlabs = slabCalcNumSlabs(pCtx->slabSize, size);
+
+    for (i=0; i<pCtx->numSlabs; i++)
+    {
+        if (-1 == pCtx->slabIdxs[i])
+        {
+            consecFree = 0;
+            slabIdx    = i;
+
+            for (; i<pCtx->numSlabs; i++)
+            {
+                if (-1 == pCtx->slabIdxs[i])
+                {
+                    consecFree++;
+
+                    if (consecFree == reqSlabs)
+                    {
+                        int8_t j;
+
+                        for (j=0; j<consecFree; j++)
+                        {
+                            pCtx->slabIdxs[slabIdx+j] = consecFree-j;
+                        }
+
+                        return &pCtx->pRootAddr[(size_t)slabIdx * pCtx->slabSize];
+                    }
+                }
+                else
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static void slabRefFree(SLAB_TRACE_REF_CTX *pCtx, void *p)
+{
+    int slabIdx;
+
+    if (NULL == p)
+    {
+        return;
+    }
+
+    slabIdx = (((uint8_t*)p - pCtx->pRootAddr) / pCtx->slabSize);
+
+    (void)memset(&pCtx->slabIdxs[slabIdx], 0xff, (size_t)pCtx->slabIdxs[slabIdx]);
+}
+
+static int8_t slabRefNumFree(const SLAB_TRACE_REF_CTX *pCtx)
+{
+    int8_t numFree = 0;
+    int8_t i;
+
+    for (i=0; i<pCtx->numSlabs; i++)
+    {
+        if (-1 == pCtx->slabIdxs[i])
+        {
+            numFree++;
+        }
+    }
+
+    return numFree;
+}
+
+/* Replay a trace reps times, returning the host time and cycles spent and
+   the number of allocations which failed in the first pass. pNumFragFailed
+   counts the failures where enough slabs were free, but not together. */
+static void slabReplay(const SLAB_TRACE *pTrace, int8_t numSlabs, bool useRef, unsigned int reps, uint64_t *pNs, uint64_t *pCycles, uint32_t *pNumFailed, uint32_t *pNumFragFailed)
+{
+    void **pLive = calloc(pTrace->numIds, sizeof(void*));
+    WINC_SOCK_SLAB_CTX *pCtx = NULL;
+    SLAB_TRACE_REF_CTX refCtx;
+    uint32_t numFailed = 0;
+    uint32_t numFragFailed = 0;
+    uint64_t ns;
+    uint64_t cycles;
+    unsigned int rep;
+    uint32_t i;
+
+    if (true == useRef)
+    {
+        slabCheck(slabRefInit(&refCtx, MICRO_DEV_SOCK_SLAB_SZ, numSlabs), "reference init");
+    }
+    else
+    {
+        pCtx = slabInit(MICRO_DEV_SOCK_SLAB_SZ, numSlabs);
+
+        slabCheck(NULL != pCtx, "slabInit");
+    }
+
+    if ((NULL == pLive) || ((false == useRef) && (NULL == pCtx)) || ((true == useRef) && (NULL == refCtx.pRootAddr)))
+    {
+        *pNs        = 0;
+        *pCycles    = 0;
+        *pNumFailed = 0;
+        *pNumFragFailed = 0;
+        return;
+    }
+
+    ns     = microHostNs();
+    cycles = microCycles();
+
+    for (rep=0; rep<reps; rep++)
+    {
+        for (i=0; i<pTrace->numOps; i++)
+        {
+            const SLAB_TRACE_OP *pOp = &pTrace->pOps[i];
+
+            if (0U != pOp->size)
+            {
+                pLive[pOp->id] = (true == useRef) ? slabRefAlloc(&refCtx, pOp->size) : slabAlloc(pCtx, pOp->size);
+
+                if ((0U == rep) && (NULL == pLive[pOp->id]))
+                {
+                    int8_t numFree = (true == useRef) ? slabRefNumFree(&refCtx) : pCtx->numFree;
+
+                    numFailed++;
+
+                    if (slabCalcNumSlabs(MICRO_DEV_SOCK_SLAB_SZ, pOp->size) <= numFree)
+                    {
+                        numFragFailed++;
+                    }
+                }
+            }
+            else
+            {
+                if (true == useRef)
+                {
+                    slabRefFree(&refCtx, pLive[pOp->id]);
+                }
+                else
+                {
+                    slabFree(pCtx, pLive[pOp->id]);
+                }
+
+                pLive[pOp->id] = NULL;
+            }
+        }
+
+        /* Release anything the workload left allocated. */
+        for (i=0; i<pTrace->numIds; i++)
+        {
+            if (true == useRef)
+            {
+                slabRefFree(&refCtx, pLive[i]);
+            }
+            else
+            {
+                slabFree(pCtx, pLive[i]);
+            }
+
+            pLive[i] = NULL;
+        }
+    }
+
+    *pCycles    = microCycles() - cycles;
+    *pNs        = microHostNs() - ns;
+    *pNumFailed = numFailed;
+    *pNumFragFailed = numFragFailed;
+
+    if (true == useRef)
+    {
+        free(refCtx.pRootAddr);
+    }
+    else
+    {
+        initData.pfMemFree(pCtx);
+    }
+
+    free(pLive);
+}
+
+static void slabReport(const SLAB_TRACE *pTrace, unsigned int reps)
+{
+    static const int8_t poolSizes[] = {SLAB_TRACE_SOCK_SLAB_NUM, 24, 16};
+    uint32_t numAllocs = pTrace->numIds;
+    size_t i;
+
+    printf("slab trace:    %s, %u ops, %u allocations, %u failed while recording\n",
+            pTrace->pName, pTrace->numOps, numAllocs, pTrace->numFailed);
+
+    for (i=0; i<(sizeof(poolSizes)/sizeof(poolSizes[0])); i++)
+    {
+        uint64_t newNs;
+        uint64_t newCycles;
+        uint32_t newFailed;
+        uint32_t newFragFailed;
+        uint64_t refNs;
+        uint64_t refCycles;
+        uint32_t refFailed;
+        uint32_t refFragFailed;
+        double numOps = (double)pTrace->numOps * reps;
+
+        slabReplay(pTrace, poolSizes[i], false, reps, &newNs, &newCycles, &newFailed, &newFragFailed);
+        slabReplay(pTrace, poolSizes[i], true, reps, &refNs, &refCycles, &refFailed, &refFragFailed);
+
+#ifdef MICRO_HAVE_CYCLES
+        printf("slab replay:   %s %2d slabs, bitmap %.1f ns %.0f cycles, first fit %.1f ns %.0f cycles per op\n",
+                pTrace->pName, poolSizes[i],
+                (double)newNs / numOps, (double)newCycles / numOps,
+                (double)refNs / numOps, (double)refCycles / numOps);
+#else
+        printf("slab replay:   %s %2d slabs, bitmap %.1f ns, first fit %.1f ns per op\n",
+                pTrace->pName, poolSizes[i], (double)newNs / numOps, (double)refNs / numOps);
+#endif
+        printf("slab failed:   %s %2d slabs, bitmap %.2f%% (%.2f%% fragmented), first fit %.2f%% (%.2f%% fragmented)\n",
+                pTrace->pName, poolSizes[i],
+                (100.0 * newFailed) / numAllocs, (100.0 * newFragFailed) / numAllocs,
+                (100.0 * refFailed) / numAllocs, (100.0 * refFragFailed) / numAllocs);
+
+        /* With the pool it was recorded against, the bitmap allocator must
+           satisfy every request the driver made. */
+        if (SLAB_TRACE_SOCK_SLAB_NUM == poolSizes[i])
+        {
+            slabCheck(newFailed == pTrace->numFailed, "replay against the recording pool");
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    static SLAB_TRACE_OP tcpOps[SLAB_TRACE_MAX_OPS];
+    static SLAB_TRACE_OP udpOps[SLAB_TRACE_MAX_OPS];
+    SLAB_TRACE tcpTrace = {"tcp", tcpOps, 0, 0, 0};
+    SLAB_TRACE udpTrace = {"udp", udpOps, 0, 0, 0};
+    unsigned int numRounds = 8U;
+    unsigned int reps = SLAB_TRACE_REPS;
+    size_t tcpTotal = 64U*1024U;
+    unsigned int udpCount = 64U;
+    unsigned int round;
+
+    if ((argc > 1) && (0 == strcmp(argv[1], "--quick")))
+    {
+        numRounds = 2U;
+        reps      = SLAB_TRACE_REPS / 100U;
+        tcpTotal  = 16U*1024U;
+        udpCount  = 16U;
+    }
+
+    slabDevHandle = microDevInit(slabDevRxBuffer, sizeof(slabDevRxBuffer), SLAB_TRACE_SOCK_SLAB_NUM, NULL);
+
+    if (WINC_DEVICE_INVALID_HANDLE == slabDevHandle)
+    {
+        printf("FAIL: device init\n");
+        return 1;
+    }
+
+    WINC_DevSetDebugPrintf(slabRecPrintf);
+
+    pSlabRecTrace = &tcpTrace;
+
+    for (round=0; round<numRounds; round++)
+    {
+        slabCheck(slabTcpRound(tcpTotal, (0U == (round & 1U))), "tcp round");
+    }
+
+    pSlabRecTrace = &udpTrace;
+
+    for (round=0; round<numRounds; round++)
+    {
+        slabCheck(slabUdpRound(udpCount), "udp round");
+    }
+
+    pSlabRecTrace = NULL;
+
+    WINC_DevSetDebugPrintf(NULL);
+
+    slabCheck((tcpTrace.numOps <= SLAB_TRACE_MAX_OPS) && (udpTrace.numOps <= SLAB_TRACE_MAX_OPS), "trace length");
+    slabCheck((tcpTrace.numIds > 0U) && (udpTrace.numIds > 0U), "trace recorded");
+
+    if (0 != slabNumFailed)
+    {
+        printf("%d checks failed\n", slabNumFailed);
+        return 1;
+    }
+
+    slabReport(&tcpTrace, reps);
+    slabReport(&udpTrace, reps);
+
+    if (0 != slabNumFailed)
+    {
+        printf("%d checks failed\n", slabNumFailed);
+        return 1;
+    }
+
+    return 0;
+}
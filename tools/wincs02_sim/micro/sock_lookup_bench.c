@@ -0,0 +1,208 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+/* Socket ID lookup benchmark.
+
+   Builds the socket module directly so the static ID map can be exercised.
+   A randomised churn test checks sockFindByID() against a linear scan of
+   the socket contexts after every ID assignment and removal, then the
+   average host time per lookup of both methods is reported with every
+   socket context in use. */
+
+#include <stdio.h>
+
+#include "micro_time.h"
+#include "winc_socket.c"
+
+#define LOOKUP_CHURN_OPS            200000U
+#define LOOKUP_NUM_IDS              4096U
+#define LOOKUP_LOOPS                2000U
+
+static uint32_t lookupRandState = 0x12345678U;
+
+static uint32_t lookupRand(void)
+{
+    lookupRandState ^= lookupRandState << 13;
+    lookupRandState ^= lookupRandState >> 17;
+    lookupRandState ^= lookupRandState << 5;
+
+    return lookupRandState;
+}
+
+/* The lookup used before the ID map was added. */
+static WINC_SOCK_CTX* lookupLinear(uint16_t sockId)
+{
+    unsigned int i;
+
+    for (i=0; i<WINC_SOCK_NUM_SOCKETS; i++)
+    {
+        if ((true == wincSockets[i].inUse) && (sockId == wincSockets[i].sockId))
+        {
+            return &wincSockets[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* Pick a device socket ID not currently assigned. */
+static uint16_t lookupNewID(void)
+{
+    uint16_t sockId;
+
+    do
+    {
+        sockId = (uint16_t)lookupRand();
+    }
+    while ((0U == sockId) || (NULL != lookupLinear(sockId)));
+
+    return sockId;
+}
+
+static bool lookupChurn(void)
+{
+    unsigned int op;
+    unsigned int i;
+
+    for (op=0; op<LOOKUP_CHURN_OPS; op++)
+    {
+        WINC_SOCK_CTX *pSockCtx = &wincSockets[lookupRand() % WINC_SOCK_NUM_SOCKETS];
+        uint16_t probeId;
+
+        if (true == pSockCtx->inUse)
+        {
+            sockSetID(pSockCtx, 0);
+            pSockCtx->inUse = false;
+        }
+        else
+        {
+            pSockCtx->inUse = true;
+            sockSetID(pSockCtx, lookupNewID());
+        }
+
+        for (i=0; i<WINC_SOCK_NUM_SOCKETS; i++)
+        {
+            if ((true == wincSockets[i].inUse) && (&wincSockets[i] != sockFindByID(wincSockets[i].sockId)))
+            {
+                printf("FAIL: socket %u ID %u not found after %u operations\n", i, wincSockets[i].sockId, op);
+                return false;
+            }
+        }
+
+        probeId = (uint16_t)lookupRand();
+
+        if (sockFindByID(probeId) != lookupLinear(probeId))
+        {
+            printf("FAIL: ID %u lookup mismatch after %u operations\n", probeId, op);
+            return false;
+        }
+    }
+
+    for (i=0; i<WINC_SOCK_NUM_SOCKETS; i++)
+    {
+        if (true == wincSockets[i].inUse)
+        {
+            sockSetID(&wincSockets[i], 0);
+            wincSockets[i].inUse = false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    static uint16_t ids[LOOKUP_NUM_IDS];
+    unsigned int loops = LOOKUP_LOOPS;
+    uintptr_t sink = 0;
+    uint64_t hashNs;
+    uint64_t hashCycles;
+    uint64_t linearNs;
+    uint64_t linearCycles;
+    double numLookups;
+    unsigned int i;
+    unsigned int j;
+
+    if ((argc > 1) && (0 == strcmp(argv[1], "--quick")))
+    {
+        loops = LOOKUP_LOOPS / 20U;
+    }
+
+    if (false == lookupChurn())
+    {
+        return 1;
+    }
+
+    /* Every context in use, look up IDs in a random order. */
+    for (i=0; i<WINC_SOCK_NUM_SOCKETS; i++)
+    {
+        wincSockets[i].inUse = true;
+        sockSetID(&wincSockets[i], lookupNewID());
+    }
+
+    for (i=0; i<LOOKUP_NUM_IDS; i++)
+    {
+        ids[i] = wincSockets[lookupRand() % WINC_SOCK_NUM_SOCKETS].sockId;
+    }
+
+    hashNs     = microHostNs();
+    hashCycles = microCycles();
+
+    for (j=0; j<loops; j++)
+    {
+        for (i=0; i<LOOKUP_NUM_IDS; i++)
+        {
+            sink += (uintptr_t)sockFindByID(ids[i]);
+        }
+    }
+
+    hashCycles = microCycles() - hashCycles;
+    hashNs     = microHostNs() - hashNs;
+
+    linearNs     = microHostNs();
+    linearCycles = microCycles();
+
+    for (j=0; j<loops; j++)
+    {
+        for (i=0; i<LOOKUP_NUM_IDS; i++)
+        {
+            sink -= (uintptr_t)lookupLinear(ids[i]);
+        }
+    }
+
+    linearCycles = microCycles() - linearCycles;
+    linearNs     = microHostNs() - linearNs;
+
+    if (0U != sink)
+    {
+        printf("FAIL: lookup results differ\n");
+        return 1;
+    }
+
+    numLookups = (double)loops * LOOKUP_NUM_IDS;
+
+#ifdef MICRO_HAVE_CYCLES
+    printf("sockets %3u: hash %.1f ns %.1f cycles, linear %.1f ns %.1f cycles per lookup\n", (unsigned int)WINC_SOCK_NUM_SOCKETS,
+            (double)hashNs / numLookups, (double)hashCycles / numLookups,
+            (double)linearNs / numLookups, (double)linearCycles / numLookups);
+#else
+    printf("sockets %3u: hash %.1f ns, linear %.1f ns per lookup\n", (unsigned int)WINC_SOCK_NUM_SOCKETS,
+            (double)hashNs / numLookups, (double)linearNs / numLookups);
+#endif
+
+    return 0;
+}
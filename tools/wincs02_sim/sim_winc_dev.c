@@ -0,0 +1,2568 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+/* Simulated WINCS02 device.
+
+   The device sits behind the SPI transfer seams of winc_sdio_drv.c and is
+   driven one byte at a time. It decodes SDIO-over-SPI commands (CMD0, CMD5,
+   CMD52, CMD53, CMD59), implements the function 0/1 registers, the CSA
+   window and the data FIFO, and runs the binary TLV command protocol against
+   a loopback socket stack and a scripted name resolver.
+
+   Time is virtual: each byte moved on the bus costs eight SPI clocks and
+   each command is answered a fixed module latency after it was received.
+   Nothing advances time except bus traffic, WINC_SimAdvance and
+   WINC_SimIdle, so results are reproducible across machines. */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "sim_winc_dev.h"
+#include "microchip_wincs02_intf.h"
+
+#define SIM_DEFAULT_BUS_HZ          20000000U
+#define SIM_DEFAULT_LATENCY_US      100U
+#define SIM_DEFAULT_DNS_MS          40U
+
+#define SIM_BLOCK_SZ                512U
+#define SIM_CSA_SZ                  1024U
+#define SIM_MAX_BURST_CMDS          255U
+#define SIM_CMD_PARAMS_SZ           2048U
+#define SIM_NUM_CMDS                256U
+#define SIM_NUM_MSGS                256U
+#define SIM_MSG_SZ                  1600U
+#define SIM_MSG_RESERVE             32U
+#define SIM_RX_BURST_MAX            16U
+#define SIM_HOST_RX_BUF_SZ          2048U
+#define SIM_RX_FIFO_SZ              ((SIM_RX_BURST_MAX*SIM_MSG_SZ)+(SIM_RX_BURST_MAX*4U))
+#define SIM_MAX_PARAMS              16U
+#define SIM_NUM_CMD_STATS           64U
+
+#define SIM_NUM_SOCKETS             32U
+#define SIM_SOCK_BUF_SZ             32768U
+#define SIM_SOCK_UDP_HDR_SZ         8U
+#define SIM_SOCK_EPHEMERAL_PORT     49152U
+#define SIM_NUM_DNS_REQS            16U
+#define SIM_DNS_NAME_SZ             128U
+
+#define SIM_PORT_DISCARD            9U
+#define SIM_PORT_CHARGEN            19U
+
+/* Messages posted through ARM_GP, type in the top byte. */
+#define SIM_ARM_MSG_TX_REQ          0x01U
+#define SIM_ARM_MSG_RX_REQ          0x02U
+
+/* Command header: msgType, id, seqNum, numParams, length. */
+#define SIM_CMD_HDR_SZ              8U
+
+/* Response header: msgType, id, seqNum, rspId, length, numTlvs. */
+#define SIM_RSP_HDR_SZ              10U
+
+#define SIM_OCR_READY               0x80000000U
+#define SIM_OCR_VOLTAGE             0x00ff8000U
+
+#define SIM_DATA_RSP_ACCEPTED       0xe5U
+#define SIM_DATA_RSP_CRC_ERROR      0xebU
+
+#define SIM_IPV4_ADDR_LOCAL         { 192, 168, 1, 100 }
+
+typedef enum
+{
+    SIM_SPI_STATE_CMD,
+    SIM_SPI_STATE_WR_TOKEN,
+    SIM_SPI_STATE_WR_DATA,
+    SIM_SPI_STATE_WR_CRC,
+    SIM_SPI_STATE_RD_WAIT,
+    SIM_SPI_STATE_RD_TOKEN,
+    SIM_SPI_STATE_RD_DATA
+} SIM_SPI_STATE;
+
+typedef enum
+{
+    SIM_SOCK_STATE_FREE,
+    SIM_SOCK_STATE_OPEN,
+    SIM_SOCK_STATE_LISTEN,
+    SIM_SOCK_STATE_CONNECTED
+} SIM_SOCK_STATE;
+
+typedef enum
+{
+    SIM_SOCK_SERVICE_NONE,
+    SIM_SOCK_SERVICE_PEER,
+    SIM_SOCK_SERVICE_ECHO,
+    SIM_SOCK_SERVICE_DISCARD,
+    SIM_SOCK_SERVICE_CHARGEN
+} SIM_SOCK_SERVICE;
+
+typedef struct
+{
+    uint8_t     type;
+    uint16_t    length;
+    const uint8_t *pData;
+} SIM_PARAM;
+
+typedef struct
+{
+    uint64_t    dueNs;
+    uint16_t    id;
+    uint16_t    seqNum;
+    uint8_t     numParams;
+    uint16_t    length;
+    uint8_t     params[SIM_CMD_PARAMS_SZ];
+} SIM_CMD;
+
+typedef struct
+{
+    uint16_t    length;
+    uint8_t     data[SIM_MSG_SZ];
+} SIM_MSG;
+
+typedef struct
+{
+    uint8_t     data[SIM_SOCK_BUF_SZ];
+    uint32_t    rdIdx;
+    uint32_t    wrIdx;
+} SIM_RING;
+
+typedef struct
+{
+    SIM_SOCK_STATE      state;
+    SIM_SOCK_SERVICE    service;
+    uint8_t             proto;
+    bool                hostKnown;
+    bool                announced;
+    uint16_t            id;
+    uint16_t            lclPort;
+    uint16_t            rmtPort;
+    uint8_t             rmtAddr[4];
+    int                 peerIdx;
+    uint16_t            winSz;
+    uint16_t            maxFrmSz;
+    uint16_t            ackSeqNum;
+    uint16_t            pushSeqNum;
+    uint16_t            wrSeqNum;
+    uint32_t            pendingAnnounced;
+    uint32_t            chargenCount;
+    SIM_RING            ring;
+} SIM_SOCKET;
+
+typedef struct
+{
+    bool        inUse;
+    uint64_t    dueNs;
+    uint8_t     type;
+    char        name[SIM_DNS_NAME_SZ];
+} SIM_DNS_REQ;
+
+typedef struct
+{
+    uint16_t    id;
+    uint32_t    count;
+} SIM_CMD_STAT;
+
+typedef struct
+{
+    WINC_SIM_CONFIG     config;
+    WINC_SIM_STATS      stats;
+
+    /* Virtual time in picoseconds and the cost of one bus byte. */
+    uint64_t            nowPs;
+    uint64_t            psPerByte;
+
+    /* SPI command decoder. */
+    SIM_SPI_STATE       spiState;
+    uint8_t             cmdBuf[6];
+    uint8_t             cmdLen;
+    uint8_t             outQueue[8];
+    uint8_t             outHead;
+    uint8_t             outLen;
+    bool                idle;
+    bool                crcEnabled;
+
+    /* Current CMD53 transfer. */
+    uint32_t            xferAddr;
+    bool                xferIncAddr;
+    uint16_t            xferBlockLen;
+    uint16_t            xferNumBlocks;
+    uint16_t            xferIdx;
+    uint16_t            xferCrc;
+    uint8_t             xferCrcIdx;
+    uint8_t             xferBlock[SIM_BLOCK_SZ];
+
+    /* Function 0 registers. */
+    uint8_t             ioEn;
+    uint8_t             intEn;
+    uint8_t             busIfCtrl;
+    uint16_t            fn0BlkSz;
+    uint16_t            fn1BlkSz;
+    uint8_t             csaCfg;
+    uint32_t            csaPtr;
+    uint8_t             csa[SIM_CSA_SZ];
+    uint8_t             wakeUp;
+
+    /* Function 1 registers. */
+    uint8_t             fn1IntId;
+    uint8_t             fn1IntEn;
+    uint32_t            hostGp;
+    uint32_t            armGp;
+
+    /* Command burst being received from the host. */
+    bool                txActive;
+    bool                txReqPending;
+    uint8_t             txNumCmds;
+    uint8_t             txCmdIdx;
+    uint16_t            txWords;
+    uint32_t            txSizes[SIM_MAX_BURST_CMDS];
+    uint16_t            txLen;
+    uint8_t             txBuf[SIM_CMD_PARAMS_SZ+SIM_CMD_HDR_SZ];
+
+    /* Receive FIFO holding the current RX_REQ batch. */
+    uint32_t            fifoRdIdx;
+    uint32_t            fifoLen;
+    uint8_t             fifo[SIM_RX_FIFO_SZ];
+
+    /* Pending command and outgoing message queues. */
+    uint16_t            cmdHead;
+    uint16_t            cmdCount;
+    uint16_t            msgHead;
+    uint16_t            msgCount;
+
+    uint16_t            nextSockId;
+    uint16_t            nextPort;
+
+    SIM_CMD_STAT        cmdStats[SIM_NUM_CMD_STATS];
+} SIM_CTX;
+
+static SIM_CTX      simCtx;
+static SIM_CMD      simCmdQueue[SIM_NUM_CMDS];
+static SIM_MSG      simMsgQueue[SIM_NUM_MSGS];
+static SIM_SOCKET   simSockets[SIM_NUM_SOCKETS];
+static SIM_DNS_REQ  simDnsReqs[SIM_NUM_DNS_REQS];
+
+static const uint8_t simLocalAddr[4] = SIM_IPV4_ADDR_LOCAL;
+
+static void simService(void);
+
+/*****************************************************************************
+                              Utilities
+ *****************************************************************************/
+
+static uint16_t simCRC16(uint16_t crc, const uint8_t *pData, size_t length)
+{
+    while (length > 0U)
+    {
+        uint8_t i;
+
+        crc ^= (uint16_t)*pData++ << 8;
+
+        for (i=0; i<8U; i++)
+        {
+            if (0U != (crc & 0x8000U))
+            {
+                crc = (uint16_t)((crc << 1) ^ 0x1021U);
+            }
+            else
+            {
+                crc = (uint16_t)(crc << 1);
+            }
+        }
+
+        length--;
+    }
+
+    return crc;
+}
+
+static uint64_t simNowNs(void)
+{
+    return simCtx.nowPs / 1000U;
+}
+
+static void simCmdStatCount(uint16_t id)
+{
+    uint8_t i;
+
+    for (i=0; i<SIM_NUM_CMD_STATS; i++)
+    {
+        if ((0U == simCtx.cmdStats[i].count) || (id == simCtx.cmdStats[i].id))
+        {
+            simCtx.cmdStats[i].id = id;
+            simCtx.cmdStats[i].count++;
+            return;
+        }
+    }
+}
+
+static uint32_t simParamUInt(const SIM_PARAM *pParam)
+{
+    uint32_t value = 0;
+    uint16_t i;
+
+    if ((NULL == pParam) || (NULL == pParam->pData))
+    {
+        return 0;
+    }
+
+    for (i=0; (i<pParam->length) && (i<4U); i++)
+    {
+        value = (value << 8) | pParam->pData[i];
+    }
+
+    return value;
+}
+
+static uint8_t simParamsUnpack(const SIM_CMD *pCmd, SIM_PARAM *pParams)
+{
+    const uint8_t *pPtr = pCmd->params;
+    const uint8_t *pEnd = &pCmd->params[pCmd->length];
+    uint8_t i;
+
+    for (i=0; (i<pCmd->numParams) && (i<SIM_MAX_PARAMS); i++)
+    {
+        uint16_t length;
+
+        if ((pPtr + 4) > pEnd)
+        {
+            break;
+        }
+
+        length = ((uint16_t)pPtr[2] << 8) | pPtr[3];
+
+        if ((pPtr + 4 + length) > pEnd)
+        {
+            break;
+        }
+
+        pParams[i].type   = pPtr[0];
+        pParams[i].length = length;
+        pParams[i].pData  = &pPtr[4];
+
+        pPtr += 4U + length + (pPtr[1] & 0x03U);
+    }
+
+    if (i != pCmd->numParams)
+    {
+        simCtx.stats.numErrors++;
+    }
+
+    return i;
+}
+
+/*****************************************************************************
+                         Outgoing Message Queue
+ *****************************************************************************/
+
+static SIM_MSG* simMsgBegin(uint8_t msgType, uint16_t id, uint16_t seqNum, uint16_t rspId)
+{
+    SIM_MSG *pMsg;
+
+    if (simCtx.msgCount >= SIM_NUM_MSGS)
+    {
+        simCtx.stats.numErrors++;
+        return NULL;
+    }
+
+    pMsg = &simMsgQueue[(simCtx.msgHead + simCtx.msgCount) % SIM_NUM_MSGS];
+
+    pMsg->data[0] = msgType;
+    pMsg->data[1] = (uint8_t)(id >> 8);
+    pMsg->data[2] = (uint8_t)id;
+    pMsg->data[3] = (uint8_t)(seqNum >> 8);
+    pMsg->data[4] = (uint8_t)seqNum;
+    pMsg->data[5] = (uint8_t)(rspId >> 8);
+    pMsg->data[6] = (uint8_t)rspId;
+    pMsg->data[7] = 0;
+    pMsg->data[8] = 0;
+    pMsg->data[9] = 0;
+
+    pMsg->length = SIM_RSP_HDR_SZ;
+
+    return pMsg;
+}
+
+static void simMsgAddTLV(SIM_MSG *pMsg, uint8_t type, const void *pData, uint16_t length)
+{
+    uint8_t pad = (uint8_t)((4U - (length & 3U)) & 3U);
+
+    if (NULL == pMsg)
+    {
+        return;
+    }
+
+    /* Leave a spare byte, the host terminates each element in place. */
+    if (((size_t)pMsg->length + 4U + length + pad + 1U) > SIM_MSG_SZ)
+    {
+        simCtx.stats.numErrors++;
+        return;
+    }
+
+    pMsg->data[pMsg->length++] = type;
+    pMsg->data[pMsg->length++] = pad;
+    pMsg->data[pMsg->length++] = (uint8_t)(length >> 8);
+    pMsg->data[pMsg->length++] = (uint8_t)length;
+
+    if (NULL != pData)
+    {
+        (void)memcpy(&pMsg->data[pMsg->length], pData, length);
+    }
+
+    (void)memset(&pMsg->data[pMsg->length + length], 0, pad);
+
+    pMsg->length += length + pad;
+    pMsg->data[9]++;
+}
+
+static void simMsgAddInt(SIM_MSG *pMsg, uint8_t type, uint32_t value, uint8_t size)
+{
+    uint8_t buf[4];
+    uint8_t i;
+
+    for (i=0; i<size; i++)
+    {
+        buf[i] = (uint8_t)(value >> (8U * (size - 1U - i)));
+    }
+
+    simMsgAddTLV(pMsg, type, buf, size);
+}
+
+static void simMsgEnd(SIM_MSG *pMsg)
+{
+    uint16_t length;
+
+    if (NULL == pMsg)
+    {
+        return;
+    }
+
+    if (WINC_COMMAND_MSG_TYPE_STATUS != (WINC_COMMAND_MSG_TYPE)pMsg->data[0])
+    {
+        length = pMsg->length - (SIM_RSP_HDR_SZ - 1U);
+
+        pMsg->data[7] = (uint8_t)(length >> 8);
+        pMsg->data[8] = (uint8_t)length;
+    }
+
+    /* Pad to whole words keeping at least one spare byte at the end. */
+    length = (uint16_t)((pMsg->length + 4U) & ~3U);
+
+    (void)memset(&pMsg->data[pMsg->length], 0, length - pMsg->length);
+
+    pMsg->length = length;
+
+    simCtx.msgCount++;
+    simCtx.stats.numMsgs++;
+}
+
+static void simStatusSend(const SIM_CMD *pCmd, uint16_t status)
+{
+    SIM_MSG *pMsg;
+
+    pMsg = simMsgBegin((uint8_t)WINC_COMMAND_MSG_TYPE_STATUS, pCmd->id, pCmd->seqNum, status);
+
+    if (NULL == pMsg)
+    {
+        return;
+    }
+
+    /* The status payload is only the 16-bit status code. */
+    pMsg->length = 7;
+
+    simMsgEnd(pMsg);
+}
+
+static uint16_t simMsgFree(void)
+{
+    return (uint16_t)(SIM_NUM_MSGS - simCtx.msgCount);
+}
+
+/*****************************************************************************
+                              Socket Rings
+ *****************************************************************************/
+
+static uint32_t simRingLength(const SIM_RING *pRing)
+{
+    return pRing->wrIdx - pRing->rdIdx;
+}
+
+static uint32_t simRingSpace(const SIM_RING *pRing)
+{
+    return SIM_SOCK_BUF_SZ - simRingLength(pRing);
+}
+
+static void simRingWrite(SIM_RING *pRing, const uint8_t *pData, uint32_t length)
+{
+    while (length > 0U)
+    {
+        pRing->data[pRing->wrIdx % SIM_SOCK_BUF_SZ] = *pData++;
+        pRing->wrIdx++;
+        length--;
+    }
+}
+
+static void simRingRead(SIM_RING *pRing, uint8_t *pData, uint32_t length)
+{
+    while (length > 0U)
+    {
+        if (NULL != pData)
+        {
+            *pData++ = pRing->data[pRing->rdIdx % SIM_SOCK_BUF_SZ];
+        }
+
+        pRing->rdIdx++;
+        length--;
+    }
+}
+
+static void simRingPeek(const SIM_RING *pRing, uint32_t offset, uint8_t *pData, uint32_t length)
+{
+    while (length > 0U)
+    {
+        *pData++ = pRing->data[(pRing->rdIdx + offset) % SIM_SOCK_BUF_SZ];
+        offset++;
+        length--;
+    }
+}
+
+/*****************************************************************************
+                               Sockets
+ *****************************************************************************/
+
+static SIM_SOCKET* simSockFind(uint16_t id)
+{
+    uint8_t i;
+
+    if (0U == id)
+    {
+        return NULL;
+    }
+
+    for (i=0; i<SIM_NUM_SOCKETS; i++)
+    {
+        if ((SIM_SOCK_STATE_FREE != simSockets[i].state) && (id == simSockets[i].id))
+        {
+            return &simSockets[i];
+        }
+    }
+
+    return NULL;
+}
+
+static SIM_SOCKET* simSockFindBound(uint8_t proto, SIM_SOCK_STATE state, uint16_t port)
+{
+    uint8_t i;
+
+    for (i=0; i<SIM_NUM_SOCKETS; i++)
+    {
+        if ((state == simSockets[i].state) && (proto == simSockets[i].proto) && (port == simSockets[i].lclPort))
+        {
+            return &simSockets[i];
+        }
+    }
+
+    return NULL;
+}
+
+static SIM_SOCKET* simSockAlloc(uint8_t proto)
+{
+    uint8_t i;
+
+    for (i=0; i<SIM_NUM_SOCKETS; i++)
+    {
+        SIM_SOCKET *pSock = &simSockets[i];
+
+        if (SIM_SOCK_STATE_FREE == pSock->state)
+        {
+            (void)memset(pSock, 0, offsetof(SIM_SOCKET, ring));
+
+            pSock->ring.rdIdx = 0;
+            pSock->ring.wrIdx = 0;
+
+            do
+            {
+                simCtx.nextSockId++;
+            }
+            while ((0U == simCtx.nextSockId) || (NULL != simSockFind(simCtx.nextSockId)));
+
+            pSock->state   = SIM_SOCK_STATE_OPEN;
+            pSock->proto   = proto;
+            pSock->id      = simCtx.nextSockId;
+            pSock->peerIdx = -1;
+            pSock->lclPort = simCtx.nextPort++;
+
+            if (0U == simCtx.nextPort)
+            {
+                simCtx.nextPort = SIM_SOCK_EPHEMERAL_PORT;
+            }
+
+            return pSock;
+        }
+    }
+
+    return NULL;
+}
+
+static void simSockSendIND(SIM_SOCKET *pSock)
+{
+    SIM_MSG *pMsg;
+
+    pMsg = simMsgBegin((uint8_t)WINC_COMMAND_MSG_TYPE_AEC, WINC_AEC_ID_SOCKIND, 0, WINC_AEC_ID_SOCKIND);
+
+    simMsgAddInt(pMsg, WINC_TYPE_INTEGER, pSock->id, 2);
+    simMsgAddTLV(pMsg, WINC_TYPE_IPV4ADDR, simLocalAddr, 4);
+    simMsgAddInt(pMsg, WINC_TYPE_INTEGER, pSock->lclPort, 2);
+    simMsgAddTLV(pMsg, WINC_TYPE_IPV4ADDR, pSock->rmtAddr, 4);
+    simMsgAddInt(pMsg, WINC_TYPE_INTEGER, pSock->rmtPort, 2);
+    simMsgEnd(pMsg);
+}
+
+static SIM_RING* simSockDestRing(SIM_SOCKET *pSock)
+{
+    switch (pSock->service)
+    {
+        case SIM_SOCK_SERVICE_PEER:
+        {
+            if (pSock->peerIdx >= 0)
+            {
+                return &simSockets[pSock->peerIdx].ring;
+            }
+
+            return NULL;
+        }
+
+        case SIM_SOCK_SERVICE_ECHO:
+        {
+            return &pSock->ring;
+        }
+
+        default:
+        {
+            return NULL;
+        }
+    }
+}
+
+static SIM_SOCK_SERVICE simSockServiceByPort(uint16_t port)
+{
+    if (SIM_PORT_DISCARD == port)
+    {
+        return SIM_SOCK_SERVICE_DISCARD;
+    }
+    else if (SIM_PORT_CHARGEN == port)
+    {
+        return SIM_SOCK_SERVICE_CHARGEN;
+    }
+    else
+    {
+        return SIM_SOCK_SERVICE_ECHO;
+    }
+}
+
+static void simSockClose(SIM_SOCKET *pSock)
+{
+    if (pSock->peerIdx >= 0)
+    {
+        SIM_SOCKET *pPeer = &simSockets[pSock->peerIdx];
+
+        pPeer->peerIdx = -1;
+        pPeer->service = SIM_SOCK_SERVICE_NONE;
+
+        if (true == pPeer->hostKnown)
+        {
+            SIM_MSG *pMsg;
+
+            pMsg = simMsgBegin((uint8_t)WINC_COMMAND_MSG_TYPE_AEC, WINC_AEC_ID_SOCKCL, 0, WINC_AEC_ID_SOCKCL);
+
+            simMsgAddInt(pMsg, WINC_TYPE_INTEGER, pPeer->id, 2);
+            simMsgEnd(pMsg);
+        }
+    }
+
+    pSock->state = SIM_SOCK_STATE_FREE;
+}
+
+/* Deliver one datagram to a UDP socket, dropped if the ring is full. */
+static void simSockDeliverDatagram(SIM_SOCKET *pSock, const uint8_t *pAddr, uint16_t port, const uint8_t *pData, uint16_t length)
+{
+    uint8_t hdr[SIM_SOCK_UDP_HDR_SZ];
+
+    if (simRingSpace(&pSock->ring) < (SIM_SOCK_UDP_HDR_SZ + (uint32_t)length))
+    {
+        return;
+    }
+
+    hdr[0] = (uint8_t)(length >> 8);
+    hdr[1] = (uint8_t)length;
+    hdr[2] = (uint8_t)(port >> 8);
+    hdr[3] = (uint8_t)port;
+    (void)memcpy(&hdr[4], pAddr, 4);
+
+    simRingWrite(&pSock->ring, hdr, SIM_SOCK_UDP_HDR_SZ);
+    simRingWrite(&pSock->ring, pData, length);
+}
+
+static bool simSockDatagramHdr(const SIM_SOCKET *pSock, uint16_t *pLength, uint16_t *pPort, uint8_t *pAddr)
+{
+    uint8_t hdr[SIM_SOCK_UDP_HDR_SZ];
+
+    if (simRingLength(&pSock->ring) < SIM_SOCK_UDP_HDR_SZ)
+    {
+        return false;
+    }
+
+    simRingPeek(&pSock->ring, 0, hdr, SIM_SOCK_UDP_HDR_SZ);
+
+    *pLength = ((uint16_t)hdr[0] << 8) | hdr[1];
+    *pPort   = ((uint16_t)hdr[2] << 8) | hdr[3];
+    (void)memcpy(pAddr, &hdr[4], 4);
+
+    return true;
+}
+
+/* Push received data to the host according to the socket's async mode. */
+static void simSockPush(SIM_SOCKET *pSock)
+{
+    if ((false == pSock->hostKnown) || (SIM_SOCK_STATE_CONNECTED != pSock->state))
+    {
+        return;
+    }
+
+    if (0U == pSock->maxFrmSz)
+    {
+        /* Async mode off, announce pending data and wait for SOCKRD. */
+
+        if (WINC_CONST_SOCKET_PROTOCOL_TCP == pSock->proto)
+        {
+            uint32_t length = simRingLength(&pSock->ring);
+
+            if ((length > pSock->pendingAnnounced) && (simMsgFree() > SIM_MSG_RESERVE))
+            {
+                SIM_MSG *pMsg;
+
+                pMsg = simMsgBegin((uint8_t)WINC_COMMAND_MSG_TYPE_AEC, WINC_AEC_ID_SOCKRXT, 0, WINC_AEC_ID_SOCKRXT);
+
+                simMsgAddInt(pMsg, WINC_TYPE_INTEGER, pSock->id, 2);
+                simMsgAddInt(pMsg, WINC_TYPE_INTEGER, length, 4);
+                simMsgEnd(pMsg);
+
+                pSock->pendingAnnounced = length;
+            }
+        }
+        else
+        {
+            uint16_t length;
+            uint16_t port;
+            uint8_t addr[4];
+
+            if ((false == pSock->announced) && (true == simSockDatagramHdr(pSock, &length, &port, addr)) && (simMsgFree() > SIM_MSG_RESERVE))
+            {
+                SIM_MSG *pMsg;
+
+                pMsg = simMsgBegin((uint8_t)WINC_COMMAND_MSG_TYPE_AEC, WINC_AEC_ID_SOCKRXU, 0, WINC_AEC_ID_SOCKRXU);
+
+                simMsgAddInt(pMsg, WINC_TYPE_INTEGER, pSock->id, 2);
+                simMsgAddTLV(pMsg, WINC_TYPE_IPV4ADDR, addr, 4);
+                simMsgAddInt(pMsg, WINC_TYPE_INTEGER, port, 2);
+                simMsgAddInt(pMsg, WINC_TYPE_INTEGER, length, 2);
+                simMsgEnd(pMsg);
+
+                pSock->announced = true;
+            }
+        }
+
+        return;
+    }
+
+    while (simMsgFree() > SIM_MSG_RESERVE)
+    {
+        SIM_MSG *pMsg;
+        uint16_t inFlight = (uint16_t)(pSock->pushSeqNum - pSock->ackSeqNum);
+        uint32_t length;
+
+        if (WINC_CONST_SOCKET_PROTOCOL_TCP == pSock->proto)
+        {
+            uint8_t data[SIM_MSG_SZ];
+
+            length = simRingLength(&pSock->ring);
+
+            if (length > pSock->maxFrmSz)
+            {
+                length = pSock->maxFrmSz;
+            }
+
+            if (0U != pSock->winSz)
+            {
+                if (inFlight >= pSock->winSz)
+                {
+                    break;
+                }
+
+                if (length > (uint32_t)(pSock->winSz - inFlight))
+                {
+                    length = (uint32_t)(pSock->winSz - inFlight);
+                }
+            }
+
+            if (0U == length)
+            {
+                break;
+            }
+
+            simRingRead(&pSock->ring, data, length);
+
+            pMsg = simMsgBegin((uint8_t)WINC_COMMAND_MSG_TYPE_AEC, WINC_AEC_ID_SOCKRXT, 0, WINC_AEC_ID_SOCKRXT);
+
+            simMsgAddInt(pMsg, WINC_TYPE_INTEGER, pSock->id, 2);
+            simMsgAddInt(pMsg, WINC_TYPE_INTEGER_UNSIGNED, length, 2);
+
+            if (0U != pSock->winSz)
+            {
+                simMsgAddInt(pMsg, WINC_TYPE_INTEGER_UNSIGNED, pSock->pushSeqNum, 2);
+            }
+
+            simMsgAddTLV(pMsg, WINC_TYPE_BYTE_ARRAY, data, (uint16_t)length);
+            simMsgEnd(pMsg);
+        }
+        else
+        {
+            uint8_t data[SIM_MSG_SZ];
+            uint16_t dgramLength;
+            uint16_t port;
+            uint8_t addr[4];
+
+            if (false == simSockDatagramHdr(pSock, &dgramLength, &port, addr))
+            {
+                break;
+            }
+
+            if ((0U != pSock->winSz) && (((uint32_t)inFlight + dgramLength) > pSock->winSz))
+            {
+                break;
+            }
+
+            simRingRead(&pSock->ring, NULL, SIM_SOCK_UDP_HDR_SZ);
+            simRingRead(&pSock->ring, data, dgramLength);
+
+            length = dgramLength;
+
+            if (length > pSock->maxFrmSz)
+            {
+                length = pSock->maxFrmSz;
+            }
+
+            pMsg = simMsgBegin((uint8_t)WINC_COMMAND_MSG_TYPE_AEC, WINC_AEC_ID_SOCKRXU, 0, WINC_AEC_ID_SOCKRXU);
+
+            simMsgAddInt(pMsg, WINC_TYPE_INTEGER, pSock->id, 2);
+            simMsgAddTLV(pMsg, WINC_TYPE_IPV4ADDR, addr, 4);
+            simMsgAddInt(pMsg, WINC_TYPE_INTEGER, port, 2);
+            simMsgAddInt(pMsg, WINC_TYPE_INTEGER_UNSIGNED, length, 2);
+
+            if (0U != pSock->winSz)
+            {
+                simMsgAddInt(pMsg, WINC_TYPE_INTEGER_UNSIGNED, pSock->pushSeqNum, 2);
+            }
+
+            simMsgAddTLV(pMsg, WINC_TYPE_BYTE_ARRAY, data, (uint16_t)length);
+            simMsgEnd(pMsg);
+        }
+
+        pSock->pushSeqNum += (uint16_t)length;
+
+        simCtx.stats.sockRxBytes += length;
+    }
+}
+
+static void simSockService(void)
+{
+    uint8_t i;
+
+    for (i=0; i<SIM_NUM_SOCKETS; i++)
+    {
+        SIM_SOCKET *pSock = &simSockets[i];
+
+        if (SIM_SOCK_STATE_CONNECTED != pSock->state)
+        {
+            continue;
+        }
+
+        if (SIM_SOCK_SERVICE_CHARGEN == pSock->service)
+        {
+            /* Keep the receive ring topped up with a counting pattern. */
+            while (simRingSpace(&pSock->ring) > 0U)
+            {
+                uint8_t data = (uint8_t)pSock->chargenCount++;
+
+                simRingWrite(&pSock->ring, &data, 1);
+            }
+        }
+
+        simSockPush(pSock);
+    }
+}
+
+/*****************************************************************************
+                            Command Handlers
+ *****************************************************************************/
+
+static void simCmdSOCKO(const SIM_CMD *pCmd, const SIM_PARAM *pParams, uint8_t numParams)
+{
+    SIM_SOCKET *pSock;
+    SIM_MSG *pMsg;
+    uint8_t proto;
+
+    if (numParams < 1U)
+    {
+        simStatusSend(pCmd, WINC_STATUS_INVALID_PARAMETER);
+        return;
+    }
+
+    proto = (uint8_t)simParamUInt(&pParams[0]);
+
+    if ((WINC_CONST_SOCKET_PROTOCOL_UDP != proto) && (WINC_CONST_SOCKET_PROTOCOL_TCP != proto))
+    {
+        simStatusSend(pCmd, WINC_STATUS_SOCKET_INVALID_PROTOCOL);
+        return;
+    }
+
+    pSock = simSockAlloc(proto);
+
+    if (NULL == pSock)
+    {
+        simStatusSend(pCmd, WINC_STATUS_NO_FREE_SOCKETS);
+        return;
+    }
+
+    pSock->hostKnown = true;
+
+    pMsg = simMsgBegin((uint8_t)WINC_COMMAND_MSG_TYPE_RSP, pCmd->id, pCmd->seqNum, WINC_CMD_ID_SOCKO);
+
+    simMsgAddInt(pMsg, WINC_TYPE_INTEGER, pSock->id, 2);
+    simMsgEnd(pMsg);
+
+    simStatusSend(pCmd, WINC_STATUS_OK);
+}
+
+static void simCmdSOCKBL(const SIM_CMD *pCmd, const SIM_PARAM *pParams, uint8_t numParams)
+{
+    SIM_SOCKET *pSock;
+    uint16_t port;
+
+    if (numParams < 2U)
+    {
+        simStatusSend(pCmd, WINC_STATUS_INVALID_PARAMETER);
+        return;
+    }
+
+    pSock = simSockFind((uint16_t)simParamUInt(&pParams[0]));
+    port  = (uint16_t)simParamUInt(&pParams[1]);
+
+    if (NULL == pSock)
+    {
+        simStatusSend(pCmd, WINC_STATUS_SOCKET_ID_NOT_FOUND);
+        return;
+    }
+
+    if (0U != port)
+    {
+        pSock->lclPort = port;
+    }
+
+    if (WINC_CONST_SOCKET_PROTOCOL_UDP == pSock->proto)
+    {
+        pSock->state = SIM_SOCK_STATE_CONNECTED;
+    }
+    else
+    {
+        pSock->state = SIM_SOCK_STATE_LISTEN;
+    }
+
+    simStatusSend(pCmd, WINC_STATUS_OK);
+}
+
+static void simCmdSOCKBR(const SIM_CMD *pCmd, const SIM_PARAM *pParams, uint8_t numParams)
+{
+    SIM_SOCKET *pSock;
+    SIM_SOCKET *pListenSock;
+
+    if (numParams < 3U)
+    {
+        simStatusSend(pCmd, WINC_STATUS_INVALID_PARAMETER);
+        return;
+    }
+
+    pSock = simSockFind((uint16_t)simParamUInt(&pParams[0]));
+
+    if ((NULL == pSock) || (4U != pParams[1].length))
+    {
+        simStatusSend(pCmd, WINC_STATUS_SOCKET_CONNECT_FAILED);
+        return;
+    }
+
+    (void)memcpy(pSock->rmtAddr, pParams[1].pData, 4);
+    pSock->rmtPort = (uint16_t)simParamUInt(&pParams[2]);
+    pSock->state   = SIM_SOCK_STATE_CONNECTED;
+
+    simStatusSend(pCmd, WINC_STATUS_OK);
+
+    if (WINC_CONST_SOCKET_PROTOCOL_UDP == pSock->proto)
+    {
+        return;
+    }
+
+    pListenSock = simSockFindBound(WINC_CONST_SOCKET_PROTOCOL_TCP, SIM_SOCK_STATE_LISTEN, pSock->rmtPort);
+
+    if (NULL != pListenSock)
+    {
+        SIM_SOCKET *pAccSock = simSockAlloc(WINC_CONST_SOCKET_PROTOCOL_TCP);
+
+        if (NULL == pAccSock)
+        {
+            simStatusSend(pCmd, WINC_STATUS_NO_FREE_SOCKETS);
+            return;
+        }
+
+        /* Accepted sockets inherit the listener's async configuration. */
+        pAccSock->state     = SIM_SOCK_STATE_CONNECTED;
+        pAccSock->service   = SIM_SOCK_SERVICE_PEER;
+        pAccSock->hostKnown = true;
+        pAccSock->lclPort   = pListenSock->lclPort;
+        pAccSock->rmtPort   = pSock->lclPort;
+        pAccSock->winSz     = pListenSock->winSz;
+        pAccSock->maxFrmSz  = pListenSock->maxFrmSz;
+        pAccSock->peerIdx   = (int)(pSock - simSockets);
+        (void)memcpy(pAccSock->rmtAddr, simLocalAddr, 4);
+
+        pSock->service = SIM_SOCK_SERVICE_PEER;
+        pSock->peerIdx = (int)(pAccSock - simSockets);
+
+        simSockSendIND(pAccSock);
+    }
+    else
+    {
+        pSock->service = simSockServiceByPort(pSock->rmtPort);
+    }
+
+    simSockSendIND(pSock);
+}
+
+static void simCmdSOCKWR(const SIM_CMD *pCmd, const SIM_PARAM *pParams, uint8_t numParams)
+{
+    SIM_SOCKET *pSock;
+    const SIM_PARAM *pData;
+    uint16_t seqNum;
+    uint16_t length;
+    uint8_t addr[4];
+    uint16_t port;
+    uint8_t dataIdx;
+
+    /* SOCKWR: id, length, [seq,] data. SOCKWRTO: id, addr, port, length, [seq,] data. */
+    dataIdx = (WINC_CMD_ID_SOCKWRTO == pCmd->id) ? 5U : 3U;
+
+    if (numParams < dataIdx)
+    {
+        simStatusSend(pCmd, WINC_STATUS_INVALID_PARAMETER);
+        return;
+    }
+
+    pSock  = simSockFind((uint16_t)simParamUInt(&pParams[0]));
+    pData  = &pParams[numParams-1U];
+    length = (uint16_t)simParamUInt(&pParams[dataIdx-2U]);
+    seqNum = (numParams > dataIdx) ? (uint16_t)simParamUInt(&pParams[dataIdx-1U]) : 0U;
+
+    if ((NULL == pSock) || (pData->length != length))
+    {
+        simStatusSend(pCmd, WINC_STATUS_SOCKET_SEND_FAILED);
+        return;
+    }
+
+    if ((numParams > dataIdx) && (seqNum != pSock->wrSeqNum))
+    {
+        simStatusSend(pCmd, WINC_STATUS_SOCKET_SEQUENCE_ERROR);
+        return;
+    }
+
+    if (WINC_CONST_SOCKET_PROTOCOL_TCP == pSock->proto)
+    {
+        SIM_RING *pDestRing;
+
+        if (SIM_SOCK_STATE_CONNECTED != pSock->state)
+        {
+            simStatusSend(pCmd, WINC_STATUS_SOCKET_SEND_FAILED);
+            return;
+        }
+
+        pDestRing = simSockDestRing(pSock);
+
+        if (NULL != pDestRing)
+        {
+            if (simRingSpace(pDestRing) < length)
+            {
+                simStatusSend(pCmd, WINC_STATUS_SOCKET_NOT_READY);
+                return;
+            }
+
+            simRingWrite(pDestRing, pData->pData, length);
+        }
+    }
+    else
+    {
+        SIM_SOCKET *pDestSock;
+
+        /* Sending implicitly binds a UDP socket. */
+        pSock->state = SIM_SOCK_STATE_CONNECTED;
+
+        if (WINC_CMD_ID_SOCKWRTO == pCmd->id)
+        {
+            if (4U != pParams[1].length)
+            {
+                simStatusSend(pCmd, WINC_STATUS_SOCKET_SEND_FAILED);
+                return;
+            }
+
+            (void)memcpy(addr, pParams[1].pData, 4);
+            port = (uint16_t)simParamUInt(&pParams[2]);
+        }
+        else
+        {
+            (void)memcpy(addr, pSock->rmtAddr, 4);
+            port = pSock->rmtPort;
+        }
+
+        pDestSock = simSockFindBound(WINC_CONST_SOCKET_PROTOCOL_UDP, SIM_SOCK_STATE_CONNECTED, port);
+
+        if ((NULL != pDestSock) && (pDestSock != pSock))
+        {
+            simSockDeliverDatagram(pDestSock, simLocalAddr, pSock->lclPort, pData->pData, length);
+        }
+        else if (SIM_SOCK_SERVICE_DISCARD != simSockServiceByPort(port))
+        {
+            simSockDeliverDatagram(pSock, addr, port, pData->pData, length);
+        }
+        else
+        {
+        }
+    }
+
+    pSock->wrSeqNum += length;
+
+    simCtx.stats.sockTxBytes += length;
+
+    simStatusSend(pCmd, WINC_STATUS_OK);
+}
+
+static void simCmdSOCKRD(const SIM_CMD *pCmd, const SIM_PARAM *pParams, uint8_t numParams)
+{
+    SIM_SOCKET *pSock;
+    SIM_MSG *pMsg;
+    uint8_t data[SIM_MSG_SZ];
+    uint32_t reqLength;
+
+    if (numParams < 3U)
+    {
+        simStatusSend(pCmd, WINC_STATUS_INVALID_PARAMETER);
+        return;
+    }
+
+    pSock     = simSockFind((uint16_t)simParamUInt(&pParams[0]));
+    reqLength = simParamUInt(&pParams[2]);
+
+    if (NULL == pSock)
+    {
+        simStatusSend(pCmd, WINC_STATUS_SOCKET_ID_NOT_FOUND);
+        return;
+    }
+
+    if (reqLength > (SIM_MSG_SZ - 96U))
+    {
+        reqLength = SIM_MSG_SZ - 96U;
+    }
+
+    if (WINC_CONST_SOCKET_PROTOCOL_TCP == pSock->proto)
+    {
+        uint32_t length = simRingLength(&pSock->ring);
+
+        if (0U == length)
+        {
+            simStatusSend(pCmd, WINC_STATUS_SOCKET_NOT_READY);
+            return;
+        }
+
+        if (length > reqLength)
+        {
+            length = reqLength;
+        }
+
+        simRingRead(&pSock->ring, data, length);
+
+        pSock->pendingAnnounced = simRingLength(&pSock->ring);
+
+        simCtx.stats.sockRxBytes += length;
+
+        pMsg = simMsgBegin((uint8_t)WINC_COMMAND_MSG_TYPE_RSP, pCmd->id, pCmd->seqNum, WINC_CMD_ID_SOCKRD);
+
+        simMsgAddInt(pMsg, WINC_TYPE_INTEGER, pSock->id, 2);
+        simMsgAddInt(pMsg, WINC_TYPE_INTEGER, length, 2);
+        simMsgAddInt(pMsg, WINC_TYPE_INTEGER, pSock->pendingAnnounced, 4);
+        simMsgAddTLV(pMsg, WINC_TYPE_BYTE_ARRAY, data, (uint16_t)length);
+        simMsgEnd(pMsg);
+    }
+    else
+    {
+        uint16_t dgramLength;
+        uint16_t nextLength = 0;
+        uint16_t port;
+        uint8_t addr[4];
+        uint8_t nextAddr[4];
+        uint16_t nextPort;
+        uint32_t length;
+
+        if (false == simSockDatagramHdr(pSock, &dgramLength, &port, addr))
+        {
+            simStatusSend(pCmd, WINC_STATUS_SOCKET_NOT_READY);
+            return;
+        }
+
+        simRingRead(&pSock->ring, NULL, SIM_SOCK_UDP_HDR_SZ);
+        simRingRead(&pSock->ring, data, dgramLength);
+
+        length = dgramLength;
+
+        if (length > reqLength)
+        {
+            length = reqLength;
+        }
+
+        simCtx.stats.sockRxBytes += length;
+
+        /* The response announces the next datagram, if any. */
+        pSock->announced = simSockDatagramHdr(pSock, &nextLength, &nextPort, nextAddr);
+
+        pMsg = simMsgBegin((uint8_t)WINC_COMMAND_MSG_TYPE_RSP, pCmd->id, pCmd->seqNum, WINC_CMD_ID_SOCKRD);
+
+        simMsgAddInt(pMsg, WINC_TYPE_INTEGER, pSock->id, 2);
+        simMsgAddInt(pMsg, WINC_TYPE_INTEGER, length, 2);
+        simMsgAddInt(pMsg, WINC_TYPE_INTEGER, nextLength, 2);
+        simMsgAddInt(pMsg, WINC_TYPE_INTEGER, 0, 1);
+        simMsgAddTLV(pMsg, WINC_TYPE_IPV4ADDR, addr, 4);
+        simMsgAddInt(pMsg, WINC_TYPE_INTEGER, port, 2);
+        simMsgAddTLV(pMsg, WINC_TYPE_BYTE_ARRAY, data, (uint16_t)length);
+        simMsgEnd(pMsg);
+    }
+
+    simStatusSend(pCmd, WINC_STATUS_OK);
+}
+
+static void simCmdSOCKCL(const SIM_CMD *pCmd, const SIM_PARAM *pParams, uint8_t numParams)
+{
+    SIM_SOCKET *pSock = NULL;
+
+    if (numParams >= 1U)
+    {
+        pSock = simSockFind((uint16_t)simParamUInt(&pParams[0]));
+    }
+
+    if (NULL == pSock)
+    {
+        simStatusSend(pCmd, WINC_STATUS_SOCKET_CLOSE_FAILED);
+        return;
+    }
+
+    simSockClose(pSock);
+
+    simStatusSend(pCmd, WINC_STATUS_OK);
+}
+
+static void simCmdSOCKC(const SIM_CMD *pCmd, const SIM_PARAM *pParams, uint8_t numParams)
+{
+    SIM_SOCKET *pSock = NULL;
+
+    if (numParams >= 1U)
+    {
+        pSock = simSockFind((uint16_t)simParamUInt(&pParams[0]));
+    }
+
+    if ((NULL != pSock) && (numParams >= 3U))
+    {
+        uint32_t value = simParamUInt(&pParams[2]);
+
+        switch (simParamUInt(&pParams[1]))
+        {
+            case WINC_CFG_PARAM_ID_SOCK_ASYNC_NEXT_SN:
+            {
+                pSock->ackSeqNum = (uint16_t)value;
+                break;
+            }
+
+            case WINC_CFG_PARAM_ID_SOCK_ASYNC_WIN_SZ:
+            {
+                pSock->winSz = (uint16_t)value;
+                break;
+            }
+
+            case WINC_CFG_PARAM_ID_SOCK_ASYNC_MAX_FRM_SZ:
+            {
+                pSock->maxFrmSz = (uint16_t)value;
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
+        }
+    }
+
+    simStatusSend(pCmd, WINC_STATUS_OK);
+}
+
+static void simCmdDNSRESOLV(const SIM_CMD *pCmd, const SIM_PARAM *pParams, uint8_t numParams)
+{
+    uint8_t i;
+
+    if ((numParams < 2U) || (pParams[1].length >= SIM_DNS_NAME_SZ))
+    {
+        simStatusSend(pCmd, WINC_STATUS_INVALID_PARAMETER);
+        return;
+    }
+
+    for (i=0; i<SIM_NUM_DNS_REQS; i++)
+    {
+        SIM_DNS_REQ *pReq = &simDnsReqs[i];
+
+        if (false == pReq->inUse)
+        {
+            pReq->inUse = true;
+            pReq->dueNs = simNowNs() + ((uint64_t)simCtx.config.dnsMs * 1000000U);
+            pReq->type  = (uint8_t)simParamUInt(&pParams[0]);
+
+            (void)memcpy(pReq->name, pParams[1].pData, pParams[1].length);
+            pReq->name[pParams[1].length] = '\0';
+
+            simStatusSend(pCmd, WINC_STATUS_OK);
+            return;
+        }
+    }
+
+    simStatusSend(pCmd, WINC_STATUS_ERROR);
+}
+
+/* Scripted resolver: names starting "bad" fail, names starting "slow" time
+   out, "hostN..." resolves to 10.0.0.N plus 10.0.1.N when N is even, and
+   any other name resolves to one address derived from its characters. */
+static void simDnsRespond(SIM_DNS_REQ *pReq)
+{
+    SIM_MSG *pMsg;
+    uint16_t nameLength = (uint16_t)strlen(pReq->name);
+    uint8_t numAddrs = 1;
+    uint8_t n = 0;
+    uint8_t k;
+
+    if ((0 == strncmp(pReq->name, "bad", 3)) || (0 == strncmp(pReq->name, "slow", 4)))
+    {
+        pMsg = simMsgBegin((uint8_t)WINC_COMMAND_MSG_TYPE_AEC, WINC_AEC_ID_DNSERR, 0, WINC_AEC_ID_DNSERR);
+
+        simMsgAddInt(pMsg, WINC_TYPE_STATUS, ('b' == pReq->name[0]) ? WINC_STATUS_DNS_ERROR : WINC_STATUS_DNS_TIMEOUT, 2);
+        simMsgAddInt(pMsg, WINC_TYPE_INTEGER_UNSIGNED, pReq->type, 1);
+        simMsgAddTLV(pMsg, WINC_TYPE_STRING, pReq->name, nameLength);
+        simMsgEnd(pMsg);
+        return;
+    }
+
+    if (0 == strncmp(pReq->name, "host", 4))
+    {
+        const char *pNum = &pReq->name[4];
+
+        while ((*pNum >= '0') && (*pNum <= '9'))
+        {
+            n = (uint8_t)((n * 10U) + (uint8_t)(*pNum - '0'));
+            pNum++;
+        }
+
+        if (0U == (n & 1U))
+        {
+            numAddrs = 2;
+        }
+    }
+    else
+    {
+        for (k=0; k<nameLength; k++)
+        {
+            n = (uint8_t)((n * 31U) + (uint8_t)pReq->name[k]);
+        }
+    }
+
+    for (k=0; k<numAddrs; k++)
+    {
+        uint8_t addr[16];
+
+        pMsg = simMsgBegin((uint8_t)WINC_COMMAND_MSG_TYPE_AEC, WINC_AEC_ID_DNSRESOLV, 0, WINC_AEC_ID_DNSRESOLV);
+
+        simMsgAddInt(pMsg, WINC_TYPE_INTEGER_UNSIGNED, pReq->type, 1);
+        simMsgAddTLV(pMsg, WINC_TYPE_STRING, pReq->name, nameLength);
+
+        if (1U == pReq->type)
+        {
+            addr[0] = 10;
+            addr[1] = 0;
+            addr[2] = k;
+            addr[3] = n;
+
+            simMsgAddTLV(pMsg, WINC_TYPE_IPV4ADDR, addr, 4);
+        }
+        else
+        {
+            (void)memset(addr, 0, sizeof(addr));
+            addr[0]  = 0xfd;
+            addr[14] = k;
+            addr[15] = n;
+
+            simMsgAddTLV(pMsg, WINC_TYPE_IPV6ADDR, addr, 16);
+        }
+
+        simMsgEnd(pMsg);
+    }
+}
+
+static void simCmdExecute(const SIM_CMD *pCmd)
+{
+    SIM_PARAM params[SIM_MAX_PARAMS];
+    uint8_t numParams;
+
+    numParams = simParamsUnpack(pCmd, params);
+
+    simCmdStatCount(pCmd->id);
+
+    switch (pCmd->id)
+    {
+        case WINC_CMD_ID_SOCKO:
+        {
+            simCmdSOCKO(pCmd, params, numParams);
+            break;
+        }
+
+        case WINC_CMD_ID_SOCKBL:
+        {
+            simCmdSOCKBL(pCmd, params, numParams);
+            break;
+        }
+
+        case WINC_CMD_ID_SOCKBR:
+        {
+            simCmdSOCKBR(pCmd, params, numParams);
+            break;
+        }
+
+        case WINC_CMD_ID_SOCKWR:
+        case WINC_CMD_ID_SOCKWRTO:
+        {
+            simCmdSOCKWR(pCmd, params, numParams);
+            break;
+        }
+
+        case WINC_CMD_ID_SOCKRD:
+        {
+            simCmdSOCKRD(pCmd, params, numParams);
+            break;
+        }
+
+        case WINC_CMD_ID_SOCKCL:
+        {
+            simCmdSOCKCL(pCmd, params, numParams);
+            break;
+        }
+
+        case WINC_CMD_ID_SOCKC:
+        {
+            simCmdSOCKC(pCmd, params, numParams);
+            break;
+        }
+
+        case WINC_CMD_ID_DNSRESOLV:
+        {
+            simCmdDNSRESOLV(pCmd, params, numParams);
+            break;
+        }
+
+        default:
+        {
+            /* Accept anything else, e.g. SOCKLST or configuration queries. */
+            simStatusSend(pCmd, WINC_STATUS_OK);
+            break;
+        }
+    }
+}
+
+/*****************************************************************************
+                         Command Burst Reception
+ *****************************************************************************/
+
+static void simCmdReceived(const uint8_t *pData, uint16_t size)
+{
+    SIM_CMD *pCmd;
+    uint16_t length;
+
+    length = ((uint16_t)pData[6] << 8) | pData[7];
+
+    if ((size < SIM_CMD_HDR_SZ) || ((uint8_t)WINC_COMMAND_MSG_TYPE_REQ != pData[0]) || (length > (size - SIM_CMD_HDR_SZ)))
+    {
+        simCtx.stats.numErrors++;
+        return;
+    }
+
+    if (simCtx.cmdCount >= SIM_NUM_CMDS)
+    {
+        simCtx.stats.numErrors++;
+        return;
+    }
+
+    pCmd = &simCmdQueue[(simCtx.cmdHead + simCtx.cmdCount) % SIM_NUM_CMDS];
+
+    pCmd->dueNs     = simNowNs() + ((uint64_t)simCtx.config.latencyUs * 1000U);
+    pCmd->id        = ((uint16_t)pData[1] << 8) | pData[2];
+    pCmd->seqNum    = ((uint16_t)pData[3] << 8) | pData[4];
+    pCmd->numParams = pData[5];
+    pCmd->length    = length;
+
+    (void)memcpy(pCmd->params, &pData[SIM_CMD_HDR_SZ], length);
+
+    simCtx.cmdCount++;
+    simCtx.stats.numCmds++;
+}
+
+static void simTxData(uint8_t data)
+{
+    if ((false == simCtx.txActive) || (simCtx.txLen >= sizeof(simCtx.txBuf)))
+    {
+        simCtx.stats.numErrors++;
+        return;
+    }
+
+    simCtx.txBuf[simCtx.txLen++] = data;
+
+    if (simCtx.txLen == (simCtx.txSizes[simCtx.txCmdIdx] << 2))
+    {
+        simCmdReceived(simCtx.txBuf, simCtx.txLen);
+
+        simCtx.txLen = 0;
+        simCtx.txCmdIdx++;
+
+        if (simCtx.txCmdIdx == simCtx.txNumCmds)
+        {
+            simCtx.txActive = false;
+        }
+    }
+}
+
+static void simArmPost(void);
+
+static void simHostMessage(uint32_t message)
+{
+    uint8_t number = (uint8_t)(message >> 16);
+    uint16_t length = (uint16_t)message;
+    uint8_t i;
+
+    if ((SIM_ARM_MSG_TX_REQ != (message >> 24)) || (0U == number) || (true == simCtx.txActive) || (true == simCtx.txReqPending))
+    {
+        simCtx.stats.numErrors++;
+        return;
+    }
+
+    simCtx.txWords = 0;
+
+    if (number > 1U)
+    {
+        /* Command sizes in words were written to the CSA. */
+        for (i=0; i<number; i++)
+        {
+            const uint8_t *pSize = &simCtx.csa[i * 4U];
+
+            simCtx.txSizes[i] = (uint32_t)pSize[0] | ((uint32_t)pSize[1] << 8) | ((uint32_t)pSize[2] << 16) | ((uint32_t)pSize[3] << 24);
+            simCtx.txWords   += (uint16_t)simCtx.txSizes[i];
+        }
+    }
+    else
+    {
+        simCtx.txSizes[0] = length;
+        simCtx.txWords    = length;
+    }
+
+    simCtx.txNumCmds    = number;
+    simCtx.txCmdIdx     = 0;
+    simCtx.txLen        = 0;
+    simCtx.txActive     = true;
+    simCtx.txReqPending = true;
+
+    simCtx.stats.numTxBursts++;
+
+    simArmPost();
+}
+
+/*****************************************************************************
+                        Device To Host Messages
+ *****************************************************************************/
+
+static void simArmPost(void)
+{
+    uint8_t count;
+    uint8_t i;
+
+    if (0U != (simCtx.fn1IntId & WINC_SDIO_REG_FN1_INT_MSG_FROM_ARM))
+    {
+        return;
+    }
+
+    if (true == simCtx.txReqPending)
+    {
+        simCtx.txReqPending = false;
+
+        simCtx.armGp     = ((uint32_t)SIM_ARM_MSG_TX_REQ << 24) | ((uint32_t)simCtx.txNumCmds << 16) | simCtx.txWords;
+        simCtx.fn1IntId |= WINC_SDIO_REG_FN1_INT_MSG_FROM_ARM | WINC_SDIO_REG_FN1_INT_ACK_TO_HOST;
+        return;
+    }
+
+    if ((simCtx.fifoRdIdx < simCtx.fifoLen) || (0U == simCtx.msgCount))
+    {
+        return;
+    }
+
+    /* Batch queued messages, each must fit the host receive buffer behind
+       the list of message lengths. */
+    count = (simCtx.msgCount > SIM_RX_BURST_MAX) ? (uint8_t)SIM_RX_BURST_MAX : (uint8_t)simCtx.msgCount;
+
+    simCtx.fifoRdIdx = 0;
+    simCtx.fifoLen   = 0;
+
+    if (count > 1U)
+    {
+        for (i=0; i<count; i++)
+        {
+            uint32_t words = simMsgQueue[(simCtx.msgHead + i) % SIM_NUM_MSGS].length >> 2;
+
+            simCtx.fifo[simCtx.fifoLen++] = (uint8_t)words;
+            simCtx.fifo[simCtx.fifoLen++] = (uint8_t)(words >> 8);
+            simCtx.fifo[simCtx.fifoLen++] = 0;
+            simCtx.fifo[simCtx.fifoLen++] = 0;
+        }
+
+        simCtx.armGp = ((uint32_t)SIM_ARM_MSG_RX_REQ << 24) | ((uint32_t)count << 16) | count;
+    }
+    else
+    {
+        simCtx.armGp = ((uint32_t)SIM_ARM_MSG_RX_REQ << 24) | (1UL << 16) | (simMsgQueue[simCtx.msgHead].length >> 2);
+    }
+
+    for (i=0; i<count; i++)
+    {
+        const SIM_MSG *pMsg = &simMsgQueue[simCtx.msgHead];
+
+        if (pMsg->length > (SIM_HOST_RX_BUF_SZ - (4U * count)))
+        {
+            simCtx.stats.numErrors++;
+        }
+
+        (void)memcpy(&simCtx.fifo[simCtx.fifoLen], pMsg->data, pMsg->length);
+        simCtx.fifoLen += pMsg->length;
+
+        simCtx.msgHead = (uint16_t)((simCtx.msgHead + 1U) % SIM_NUM_MSGS);
+        simCtx.msgCount--;
+    }
+
+    simCtx.fn1IntId |= WINC_SDIO_REG_FN1_INT_MSG_FROM_ARM;
+
+    simCtx.stats.numRxBursts++;
+}
+
+/*****************************************************************************
+                               Registers
+ *****************************************************************************/
+
+static void simReset(void)
+{
+    WINC_SIM_CONFIG config = simCtx.config;
+    WINC_SIM_STATS stats = simCtx.stats;
+    uint64_t nowPs = simCtx.nowPs;
+    uint64_t psPerByte = simCtx.psPerByte;
+    uint8_t i;
+
+    (void)memset(&simCtx, 0, sizeof(simCtx));
+
+    simCtx.config    = config;
+    simCtx.stats     = stats;
+    simCtx.nowPs     = nowPs;
+    simCtx.psPerByte = psPerByte;
+    simCtx.idle      = true;
+    simCtx.fn0BlkSz  = SIM_BLOCK_SZ;
+    simCtx.fn1BlkSz  = SIM_BLOCK_SZ;
+    simCtx.nextPort  = SIM_SOCK_EPHEMERAL_PORT;
+
+    for (i=0; i<SIM_NUM_SOCKETS; i++)
+    {
+        simSockets[i].state = SIM_SOCK_STATE_FREE;
+    }
+
+    (void)memset(simDnsReqs, 0, sizeof(simDnsReqs));
+}
+
+static uint8_t simRegRead(uint32_t addr)
+{
+    if (addr >= WINC_SDIOREG_FN1_DATA)
+    {
+        switch (addr)
+        {
+            case WINC_SDIOREG_FN1_DATA:
+            {
+                if (simCtx.fifoRdIdx >= simCtx.fifoLen)
+                {
+                    simCtx.stats.numErrors++;
+                    return 0;
+                }
+
+                return simCtx.fifo[simCtx.fifoRdIdx++];
+            }
+
+            case WINC_SDIOREG_FN1_INT_ID_CLR:
+            {
+                return simCtx.fn1IntId | ((simCtx.fifoRdIdx < simCtx.fifoLen) ? WINC_SDIO_REG_FN1_INT_DATA_RDY : 0U);
+            }
+
+            case WINC_SDIOREG_FN1_INT_EN:
+            {
+                return simCtx.fn1IntEn;
+            }
+
+            case WINC_SDIOREG_FN1_RDDATRDY:
+            {
+                return (simCtx.fifoRdIdx < simCtx.fifoLen) ? 1U : 0U;
+            }
+
+            default:
+            {
+                if ((addr >= WINC_SDIOREG_FN1_SD_HOST_GP) && (addr < (WINC_SDIOREG_FN1_SD_HOST_GP + 4U)))
+                {
+                    return (uint8_t)(simCtx.hostGp >> (8U * (addr - WINC_SDIOREG_FN1_SD_HOST_GP)));
+                }
+
+                if ((addr >= WINC_SDIOREG_FN1_ARM_GP) && (addr < (WINC_SDIOREG_FN1_ARM_GP + 4U)))
+                {
+                    return (uint8_t)(simCtx.armGp >> (8U * (addr - WINC_SDIOREG_FN1_ARM_GP)));
+                }
+
+                return 0;
+            }
+        }
+    }
+
+    switch (addr)
+    {
+        case WINC_SDIOREG_FN0_CCCR_IO_EN:
+        case WINC_SDIOREG_FN0_CCCR_IO_RDY:
+        {
+            return simCtx.ioEn;
+        }
+
+        case WINC_SDIOREG_FN0_CCCR_INT_EN:
+        {
+            return simCtx.intEn;
+        }
+
+        case WINC_SDIOREG_FN0_CCCR_INT_PEND:
+        {
+            return (true == WINC_SimIntAsserted()) ? WINC_SDIO_REG_CCCR_FN_INT_1 : 0U;
+        }
+
+        case WINC_SDIOREG_FN0_CCCR_BUS_IF_CTRL:
+        {
+            return simCtx.busIfCtrl;
+        }
+
+        case WINC_SDIOREG_FN0_CCCR_FN0_BLK_SZ_L:
+        {
+            return (uint8_t)simCtx.fn0BlkSz;
+        }
+
+        case WINC_SDIOREG_FN0_CCCR_FN0_BLK_SZ_H:
+        {
+            return (uint8_t)(simCtx.fn0BlkSz >> 8);
+        }
+
+        case WINC_SDIOREG_FN0_FBR_FN1_CSA_CFG:
+        {
+            return simCtx.csaCfg;
+        }
+
+        case WINC_SDIOREG_FN0_FBR_FN1_CSA_DATA:
+        {
+            return simCtx.csa[simCtx.csaPtr++ % SIM_CSA_SZ];
+        }
+
+        case WINC_SDIOREG_FN0_FBR_FN1_BLK_SZ_L:
+        {
+            return (uint8_t)simCtx.fn1BlkSz;
+        }
+
+        case WINC_SDIOREG_FN0_FBR_FN1_BLK_SZ_H:
+        {
+            return (uint8_t)(simCtx.fn1BlkSz >> 8);
+        }
+
+        case WINC_SDIOREG_FN0_CIS_CLOCK_WAKE_UP:
+        {
+            return simCtx.wakeUp;
+        }
+
+        default:
+        {
+            if ((addr >= WINC_SDIOREG_FN0_FBR_FN1_CSA_PTR) && (addr < WINC_SDIOREG_FN0_FBR_FN1_CSA_DATA))
+            {
+                return (uint8_t)(simCtx.csaPtr >> (8U * (addr - WINC_SDIOREG_FN0_FBR_FN1_CSA_PTR)));
+            }
+
+            return 0;
+        }
+    }
+}
+
+static void simRegWrite(uint32_t addr, uint8_t value)
+{
+    if (addr >= WINC_SDIOREG_FN1_DATA)
+    {
+        switch (addr)
+        {
+            case WINC_SDIOREG_FN1_DATA:
+            {
+                simTxData(value);
+                break;
+            }
+
+            case WINC_SDIOREG_FN1_INT_ID_CLR:
+            {
+                simCtx.fn1IntId &= (uint8_t)~value;
+                break;
+            }
+
+            case WINC_SDIOREG_FN1_INT_EN:
+            {
+                simCtx.fn1IntEn = value;
+                break;
+            }
+
+            default:
+            {
+                if ((addr >= WINC_SDIOREG_FN1_SD_HOST_GP) && (addr < (WINC_SDIOREG_FN1_SD_HOST_GP + 4U)))
+                {
+                    uint8_t shift = (uint8_t)(8U * (addr - WINC_SDIOREG_FN1_SD_HOST_GP));
+
+                    simCtx.hostGp = (simCtx.hostGp & ~(0xffUL << shift)) | ((uint32_t)value << shift);
+
+                    /* Writing the top byte delivers the message. */
+                    if ((WINC_SDIOREG_FN1_SD_HOST_GP + 3U) == addr)
+                    {
+                        simHostMessage(simCtx.hostGp);
+                    }
+                }
+
+                break;
+            }
+        }
+
+        return;
+    }
+
+    switch (addr)
+    {
+        case WINC_SDIOREG_FN0_CCCR_IO_EN:
+        {
+            simCtx.ioEn = value;
+            break;
+        }
+
+        case WINC_SDIOREG_FN0_CCCR_INT_EN:
+        {
+            simCtx.intEn = value;
+            break;
+        }
+
+        case WINC_SDIOREG_FN0_CCCR_IO_ABORT:
+        {
+            if (0U != (value & 0x08U))
+            {
+                simReset();
+            }
+
+            break;
+        }
+
+        case WINC_SDIOREG_FN0_CCCR_BUS_IF_CTRL:
+        {
+            simCtx.busIfCtrl = value;
+            break;
+        }
+
+        case WINC_SDIOREG_FN0_CCCR_FN0_BLK_SZ_L:
+        {
+            simCtx.fn0BlkSz = (simCtx.fn0BlkSz & 0xff00U) | value;
+            break;
+        }
+
+        case WINC_SDIOREG_FN0_CCCR_FN0_BLK_SZ_H:
+        {
+            simCtx.fn0BlkSz = (uint16_t)((simCtx.fn0BlkSz & 0x00ffU) | ((uint16_t)value << 8));
+            break;
+        }
+
+        case WINC_SDIOREG_FN0_FBR_FN1_CSA_CFG:
+        {
+            simCtx.csaCfg = value & WINC_SDIO_REG_CSA_CFG_EN;
+            break;
+        }
+
+        case WINC_SDIOREG_FN0_FBR_FN1_CSA_DATA:
+        {
+            simCtx.csa[simCtx.csaPtr++ % SIM_CSA_SZ] = value;
+            break;
+        }
+
+        case WINC_SDIOREG_FN0_FBR_FN1_BLK_SZ_L:
+        {
+            simCtx.fn1BlkSz = (simCtx.fn1BlkSz & 0xff00U) | value;
+            break;
+        }
+
+        case WINC_SDIOREG_FN0_FBR_FN1_BLK_SZ_H:
+        {
+            simCtx.fn1BlkSz = (uint16_t)((simCtx.fn1BlkSz & 0x00ffU) | ((uint16_t)value << 8));
+            break;
+        }
+
+        case WINC_SDIOREG_FN0_CIS_CLOCK_WAKE_UP:
+        {
+            simCtx.wakeUp = value;
+            break;
+        }
+
+        default:
+        {
+            if ((addr >= WINC_SDIOREG_FN0_FBR_FN1_CSA_PTR) && (addr < WINC_SDIOREG_FN0_FBR_FN1_CSA_DATA))
+            {
+                uint8_t shift = (uint8_t)(8U * (addr - WINC_SDIOREG_FN0_FBR_FN1_CSA_PTR));
+
+                simCtx.csaPtr = (simCtx.csaPtr & ~(0xffUL << shift)) | ((uint32_t)value << shift);
+            }
+
+            break;
+        }
+    }
+}
+
+/*****************************************************************************
+                           SPI Command Decoder
+ *****************************************************************************/
+
+static void simOutPush(uint8_t data)
+{
+    if (simCtx.outLen < sizeof(simCtx.outQueue))
+    {
+        simCtx.outQueue[(simCtx.outHead + simCtx.outLen) % sizeof(simCtx.outQueue)] = data;
+        simCtx.outLen++;
+    }
+}
+
+static uint8_t simR1(void)
+{
+    return (true == simCtx.idle) ? WINC_SDIO_R1RSP_IDLE : WINC_SDIO_R1RSP_OK;
+}
+
+static uint32_t simCmdAddr(void)
+{
+    uint8_t fn = (simCtx.cmdBuf[1] >> 4) & 0x07U;
+
+    return ((uint32_t)fn << 28) | ((uint32_t)(simCtx.cmdBuf[1] & 0x03U) << 15) | ((uint32_t)simCtx.cmdBuf[2] << 7) | ((uint32_t)simCtx.cmdBuf[3] >> 1);
+}
+
+static void simSpiCommand(void)
+{
+    uint8_t index = simCtx.cmdBuf[0] & 0x3fU;
+    uint32_t arg = ((uint32_t)simCtx.cmdBuf[1] << 24) | ((uint32_t)simCtx.cmdBuf[2] << 16) | ((uint32_t)simCtx.cmdBuf[3] << 8) | simCtx.cmdBuf[4];
+
+    switch (index)
+    {
+        case 0:
+        {
+            simCtx.idle = true;
+
+            simOutPush(0xff);
+            simOutPush(simR1());
+            break;
+        }
+
+        case 5:
+        {
+            uint32_t ocr = SIM_OCR_VOLTAGE;
+
+            if (0U != (arg & 0x00ffffffU))
+            {
+                simCtx.idle = false;
+            }
+
+            if (false == simCtx.idle)
+            {
+                ocr |= SIM_OCR_READY;
+            }
+
+            simOutPush(0xff);
+            simOutPush(simR1());
+            simOutPush((uint8_t)(ocr >> 24));
+            simOutPush((uint8_t)(ocr >> 16));
+            simOutPush((uint8_t)(ocr >> 8));
+            simOutPush((uint8_t)ocr);
+            break;
+        }
+
+        case 52:
+        {
+            uint32_t addr = simCmdAddr();
+            uint8_t data;
+
+            simCtx.stats.numCmd52++;
+
+            if (0U != (simCtx.cmdBuf[1] & 0x80U))
+            {
+                simRegWrite(addr, simCtx.cmdBuf[4]);
+
+                /* Read after write returns the new value. */
+                data = (0U != (simCtx.cmdBuf[1] & 0x08U)) ? simRegRead(addr) : 0U;
+            }
+            else
+            {
+                data = simRegRead(addr);
+            }
+
+            simOutPush(0xff);
+            simOutPush(simR1());
+            simOutPush(data);
+            break;
+        }
+
+        case 53:
+        {
+            uint16_t count = (uint16_t)(((uint16_t)(simCtx.cmdBuf[3] & 0x01U) << 8) | simCtx.cmdBuf[4]);
+            uint8_t fn = (simCtx.cmdBuf[1] >> 4) & 0x07U;
+
+            simCtx.stats.numCmd53++;
+
+            simCtx.xferAddr    = simCmdAddr();
+            simCtx.xferIncAddr = (0U != (simCtx.cmdBuf[1] & 0x04U));
+
+            if (0U != (simCtx.cmdBuf[1] & 0x08U))
+            {
+                simCtx.xferBlockLen  = (0U == fn) ? simCtx.fn0BlkSz : simCtx.fn1BlkSz;
+                simCtx.xferNumBlocks = count;
+            }
+            else
+            {
+                simCtx.xferBlockLen  = (0U == count) ? (uint16_t)SIM_BLOCK_SZ : count;
+                simCtx.xferNumBlocks = 1;
+            }
+
+            if ((0U == simCtx.xferNumBlocks) || (0U == simCtx.xferBlockLen) || (simCtx.xferBlockLen > SIM_BLOCK_SZ))
+            {
+                simCtx.stats.numErrors++;
+
+                simOutPush(0xff);
+                simOutPush(WINC_SDIO_R1RSP_PARAM_ERR);
+                simOutPush(0x00);
+                break;
+            }
+
+            simOutPush(0xff);
+            simOutPush(simR1());
+            simOutPush(0x00);
+
+            simCtx.spiState = (0U != (simCtx.cmdBuf[1] & 0x80U)) ? SIM_SPI_STATE_WR_TOKEN : SIM_SPI_STATE_RD_WAIT;
+            break;
+        }
+
+        case 59:
+        {
+            simCtx.crcEnabled = (0U != (arg & 0x01U));
+
+            simOutPush(0xff);
+            simOutPush(simR1());
+            break;
+        }
+
+        default:
+        {
+            simOutPush(0xff);
+            simOutPush(simR1() | WINC_SDIO_R1RSP_ILLEGAL_CMD);
+            break;
+        }
+    }
+}
+
+static void simSpiWriteBlockDone(void)
+{
+    uint16_t i;
+
+    if ((true == simCtx.crcEnabled) && (simCtx.xferCrc != simCRC16(0, simCtx.xferBlock, simCtx.xferBlockLen)))
+    {
+        simCtx.stats.numErrors++;
+        simOutPush(SIM_DATA_RSP_CRC_ERROR);
+    }
+    else
+    {
+        for (i=0; i<simCtx.xferBlockLen; i++)
+        {
+            simRegWrite(simCtx.xferAddr, simCtx.xferBlock[i]);
+
+            if (true == simCtx.xferIncAddr)
+            {
+                simCtx.xferAddr++;
+            }
+        }
+
+        simOutPush(SIM_DATA_RSP_ACCEPTED);
+    }
+
+    simCtx.xferNumBlocks--;
+
+    simCtx.spiState = (simCtx.xferNumBlocks > 0U) ? SIM_SPI_STATE_WR_TOKEN : SIM_SPI_STATE_CMD;
+}
+
+/* Byte driven onto MISO, taken from queued responses before the current state. */
+static uint8_t simSpiOutput(void)
+{
+    uint8_t data = 0xff;
+
+    if (simCtx.outLen > 0U)
+    {
+        data = simCtx.outQueue[simCtx.outHead];
+
+        simCtx.outHead = (uint8_t)((simCtx.outHead + 1U) % sizeof(simCtx.outQueue));
+        simCtx.outLen--;
+
+        return data;
+    }
+
+    switch (simCtx.spiState)
+    {
+        case SIM_SPI_STATE_RD_TOKEN:
+        {
+            simCtx.xferIdx  = 0;
+            simCtx.xferCrc  = 0;
+            simCtx.spiState = SIM_SPI_STATE_RD_DATA;
+
+            return 0xfe;
+        }
+
+        case SIM_SPI_STATE_RD_DATA:
+        {
+            data = simRegRead(simCtx.xferAddr);
+
+            if (true == simCtx.xferIncAddr)
+            {
+                simCtx.xferAddr++;
+            }
+
+            simCtx.xferCrc = simCRC16(simCtx.xferCrc, &data, 1);
+            simCtx.xferIdx++;
+
+            if (simCtx.xferIdx == simCtx.xferBlockLen)
+            {
+                /* The driver sends data CRCs low byte first. */
+                simOutPush((uint8_t)simCtx.xferCrc);
+                simOutPush((uint8_t)(simCtx.xferCrc >> 8));
+                simOutPush(0xff);
+
+                simCtx.xferNumBlocks--;
+
+                simCtx.spiState = (simCtx.xferNumBlocks > 0U) ? SIM_SPI_STATE_RD_TOKEN : SIM_SPI_STATE_CMD;
+            }
+
+            return data;
+        }
+
+        default:
+        {
+            return 0xff;
+        }
+    }
+}
+
+/* Byte sampled from MOSI. */
+static void simSpiInput(uint8_t data)
+{
+    switch (simCtx.spiState)
+    {
+        case SIM_SPI_STATE_CMD:
+        {
+            if (0U == simCtx.cmdLen)
+            {
+                if (0x40U != (data & 0xc0U))
+                {
+                    break;
+                }
+            }
+
+            simCtx.cmdBuf[simCtx.cmdLen++] = data;
+
+            if (simCtx.cmdLen == sizeof(simCtx.cmdBuf))
+            {
+                simCtx.cmdLen = 0;
+                simSpiCommand();
+            }
+
+            break;
+        }
+
+        case SIM_SPI_STATE_WR_TOKEN:
+        {
+            if ((0xfeU == data) || (0xfcU == data))
+            {
+                simCtx.xferIdx  = 0;
+                simCtx.spiState = SIM_SPI_STATE_WR_DATA;
+            }
+
+            break;
+        }
+
+        case SIM_SPI_STATE_WR_DATA:
+        {
+            simCtx.xferBlock[simCtx.xferIdx++] = data;
+
+            if (simCtx.xferIdx == simCtx.xferBlockLen)
+            {
+                simCtx.xferCrc    = 0;
+                simCtx.xferCrcIdx = 0;
+                simCtx.spiState   = SIM_SPI_STATE_WR_CRC;
+            }
+
+            break;
+        }
+
+        case SIM_SPI_STATE_WR_CRC:
+        {
+            simCtx.xferCrc = (uint16_t)((simCtx.xferCrc >> 8) | ((uint16_t)data << 8));
+
+            if (2U == ++simCtx.xferCrcIdx)
+            {
+                simSpiWriteBlockDone();
+            }
+
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+}
+
+static void simSpiTransactionEnd(void)
+{
+    /* A read's start token is only sent once the host starts polling for it. */
+    if (SIM_SPI_STATE_RD_WAIT == simCtx.spiState)
+    {
+        simCtx.spiState = SIM_SPI_STATE_RD_TOKEN;
+    }
+
+    simCtx.stats.numTransactions++;
+
+    simService();
+}
+
+/*****************************************************************************
+                              Scheduling
+ *****************************************************************************/
+
+static void simService(void)
+{
+    uint64_t nowNs = simNowNs();
+    uint8_t i;
+
+    /* Commands complete in order, each after the module latency. */
+    while ((simCtx.cmdCount > 0U) && (simCmdQueue[simCtx.cmdHead].dueNs <= nowNs))
+    {
+        if (simMsgFree() < 4U)
+        {
+            break;
+        }
+
+        simCmdExecute(&simCmdQueue[simCtx.cmdHead]);
+
+        simCtx.cmdHead = (uint16_t)((simCtx.cmdHead + 1U) % SIM_NUM_CMDS);
+        simCtx.cmdCount--;
+    }
+
+    for (i=0; i<SIM_NUM_DNS_REQS; i++)
+    {
+        if ((true == simDnsReqs[i].inUse) && (simDnsReqs[i].dueNs <= nowNs) && (simMsgFree() > 2U))
+        {
+            simDnsRespond(&simDnsReqs[i]);
+            simDnsReqs[i].inUse = false;
+        }
+    }
+
+    simSockService();
+
+    simArmPost();
+}
+
+/*****************************************************************************
+                          Simulated Device API
+ *****************************************************************************/
+
+void WINC_SimInit(const WINC_SIM_CONFIG *pConfig)
+{
+    (void)memset(&simCtx, 0, sizeof(simCtx));
+
+    simCtx.config.busHz     = SIM_DEFAULT_BUS_HZ;
+    simCtx.config.latencyUs = SIM_DEFAULT_LATENCY_US;
+    simCtx.config.dnsMs     = SIM_DEFAULT_DNS_MS;
+
+    if (NULL != pConfig)
+    {
+        if (0U != pConfig->busHz)
+        {
+            simCtx.config.busHz = pConfig->busHz;
+        }
+
+        simCtx.config.latencyUs = pConfig->latencyUs;
+        simCtx.config.dnsMs     = pConfig->dnsMs;
+    }
+
+    simCtx.psPerByte = 8000000000000ULL / simCtx.config.busHz;
+
+    simReset();
+}
+
+bool WINC_SimSendReceiveList(const WINC_SDIO_XFER *pXferList, size_t numXfers)
+{
+    size_t i;
+
+    if (NULL == pXferList)
+    {
+        return false;
+    }
+
+    for (i=0; i<numXfers; i++)
+    {
+        const uint8_t *pTx = pXferList[i].pTransmitData;
+        uint8_t *pRx = pXferList[i].pReceiveData;
+        size_t j;
+
+        for (j=0; j<pXferList[i].size; j++)
+        {
+            uint8_t txData = (NULL != pTx) ? pTx[j] : 0xffU;
+            uint8_t rxData = simSpiOutput();
+
+            simSpiInput(txData);
+
+            if (NULL != pRx)
+            {
+                pRx[j] = rxData;
+            }
+        }
+
+        simCtx.stats.busBytes += pXferList[i].size;
+        simCtx.nowPs          += simCtx.psPerByte * pXferList[i].size;
+    }
+
+    simSpiTransactionEnd();
+
+    return true;
+}
+
+bool WINC_SimSendReceive(void *pTransmitData, void *pReceiveData, size_t size)
+{
+    WINC_SDIO_XFER xfer;
+
+    xfer.pTransmitData = pTransmitData;
+    xfer.pReceiveData  = pReceiveData;
+    xfer.size          = size;
+
+    return WINC_SimSendReceiveList(&xfer, 1);
+}
+
+bool WINC_SimXferQueue(const WINC_SDIO_XFER *pXferList, size_t numXfers, WINC_SDIO_XFER_CALLBACK pfCallback, uintptr_t context)
+{
+    bool result;
+
+    /* Transfers complete immediately, the bus time is still accounted. */
+    result = WINC_SimSendReceiveList(pXferList, numXfers);
+
+    if (NULL != pfCallback)
+    {
+        pfCallback(result, context);
+    }
+
+    return result;
+}
+
+bool WINC_SimXferWait(void)
+{
+    return true;
+}
+
+bool WINC_SimSendCRC16(void *pTransmitData, size_t size, uint16_t *pCRC16)
+{
+    if ((NULL == pTransmitData) || (NULL == pCRC16))
+    {
+        return false;
+    }
+
+    *pCRC16 = simCRC16(0, pTransmitData, size);
+
+    return WINC_SimSendReceive(pTransmitData, NULL, size);
+}
+
+bool WINC_SimIntAsserted(void)
+{
+    if ((0U == (simCtx.ioEn & WINC_SDIO_REG_CCCR_FN_IO_1)) || (0U == (simCtx.fn1IntEn & WINC_SDIO_REG_FN1_INT_MSG_FROM_ARM)))
+    {
+        return false;
+    }
+
+    return (0U != (simCtx.fn1IntId & WINC_SDIO_REG_FN1_INT_MSG_FROM_ARM));
+}
+
+bool WINC_SimIdle(void)
+{
+    uint64_t nextNs = UINT64_MAX;
+    uint8_t i;
+
+    if (simCtx.cmdCount > 0U)
+    {
+        nextNs = simCmdQueue[simCtx.cmdHead].dueNs;
+    }
+
+    for (i=0; i<SIM_NUM_DNS_REQS; i++)
+    {
+        if ((true == simDnsReqs[i].inUse) && (simDnsReqs[i].dueNs < nextNs))
+        {
+            nextNs = simDnsReqs[i].dueNs;
+        }
+    }
+
+    if (UINT64_MAX == nextNs)
+    {
+        return false;
+    }
+
+    if ((nextNs * 1000U) > simCtx.nowPs)
+    {
+        simCtx.nowPs = nextNs * 1000U;
+    }
+
+    simService();
+
+    return true;
+}
+
+void WINC_SimAdvance(uint64_t ns)
+{
+    simCtx.nowPs += ns * 1000U;
+
+    simService();
+}
+
+uint64_t WINC_SimTimeNs(void)
+{
+    return simNowNs();
+}
+
+uint32_t WINC_SimTimeMs(void)
+{
+    return (uint32_t)(simNowNs() / 1000000U);
+}
+
+uint32_t WINC_SimTimeUs(void)
+{
+    return (uint32_t)(simNowNs() / 1000U);
+}
+
+void WINC_SimStatsGet(WINC_SIM_STATS *pStats)
+{
+    if (NULL != pStats)
+    {
+        *pStats = simCtx.stats;
+    }
+}
+
+/* Change the module latency for commands received from now on, returns
+   the previous latency. */
+uint32_t WINC_SimLatencySet(uint32_t latencyUs)
+{
+    uint32_t prevLatencyUs = simCtx.config.latencyUs;
+
+    simCtx.config.latencyUs = latencyUs;
+
+    return prevLatencyUs;
+}
+
+uint32_t WINC_SimCmdCount(uint16_t cmdId)
+{
+    uint8_t i;
+
+    for (i=0; i<SIM_NUM_CMD_STATS; i++)
+    {
+        if ((0U != simCtx.cmdStats[i].count) && (cmdId == simCtx.cmdStats[i].id))
+        {
+            return simCtx.cmdStats[i].count;
+        }
+    }
+
+    return 0;
+}
+
+uint32_t WINC_SimSockRxtInject(uint16_t sockId, uint32_t length, uint32_t count)
+{
+    uint32_t numQueued = 0;
+
+    /* Announce pending data as async mode off does, without touching any
+       socket state. */
+    while ((numQueued < count) && (simMsgFree() > SIM_MSG_RESERVE))
+    {
+        SIM_MSG *pMsg;
+
+        pMsg = simMsgBegin((uint8_t)WINC_COMMAND_MSG_TYPE_AEC, WINC_AEC_ID_SOCKRXT, 0, WINC_AEC_ID_SOCKRXT);
+
+        simMsgAddInt(pMsg, WINC_TYPE_INTEGER, sockId, 2);
+        simMsgAddInt(pMsg, WINC_TYPE_INTEGER, length, 4);
+        simMsgEnd(pMsg);
+
+        numQueued++;
+    }
+
+    simArmPost();
+
+    return numQueued;
+}
+
+uint32_t WINC_SimMsgPending(void)
+{
+    uint32_t numMsgs = simCtx.msgCount;
+
+    if ((simCtx.fifoRdIdx < simCtx.fifoLen) || (0U != (simCtx.fn1IntId & WINC_SDIO_REG_FN1_INT_MSG_FROM_ARM)))
+    {
+        numMsgs++;
+    }
+
+    return numMsgs;
+}
@@ -0,0 +1,95 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+#ifndef SIM_WINC_DEV_H
+#define SIM_WINC_DEV_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "winc_sdio_drv.h"
+
+/*****************************************************************************
+  Description:
+    Simulated device configuration.
+
+  Remarks:
+    busHz is the SPI clock, each byte transferred advances simulated time by
+    eight clocks. latencyUs is the module processing time of each command,
+    measured from the end of its transfer to its first response. dnsMs is the
+    name resolution round trip.
+
+ *****************************************************************************/
+
+typedef struct
+{
+    uint32_t    busHz;
+    uint32_t    latencyUs;
+    uint32_t    dnsMs;
+} WINC_SIM_CONFIG;
+
+/*****************************************************************************
+  Description:
+    Simulated device statistics.
+
+  Remarks:
+    sockTxBytes counts socket payload accepted from the host and sockRxBytes
+    socket payload delivered to the host. numErrors counts protocol
+    violations seen by the device, any non-zero value indicates a driver or
+    simulator fault.
+
+ *****************************************************************************/
+
+typedef struct
+{
+    uint64_t    busBytes;
+    uint64_t    sockTxBytes;
+    uint64_t    sockRxBytes;
+    uint32_t    numTransactions;
+    uint32_t    numCmd52;
+    uint32_t    numCmd53;
+    uint32_t    numTxBursts;
+    uint32_t    numRxBursts;
+    uint32_t    numCmds;
+    uint32_t    numMsgs;
+    uint32_t    numErrors;
+} WINC_SIM_STATS;
+
+/*****************************************************************************
+                          Simulated Device API
+ *****************************************************************************/
+
+void WINC_SimInit(const WINC_SIM_CONFIG *pConfig);
+bool WINC_SimSendReceive(void *pTransmitData, void *pReceiveData, size_t size);
+bool WINC_SimSendReceiveList(const WINC_SDIO_XFER *pXferList, size_t numXfers);
+bool WINC_SimXferQueue(const WINC_SDIO_XFER *pXferList, size_t numXfers, WINC_SDIO_XFER_CALLBACK pfCallback, uintptr_t context);
+bool WINC_SimXferWait(void);
+bool WINC_SimSendCRC16(void *pTransmitData, size_t size, uint16_t *pCRC16);
+bool WINC_SimIntAsserted(void);
+bool WINC_SimIdle(void);
+void WINC_SimAdvance(uint64_t ns);
+uint64_t WINC_SimTimeNs(void);
+uint32_t WINC_SimTimeMs(void);
+uint32_t WINC_SimTimeUs(void);
+void WINC_SimStatsGet(WINC_SIM_STATS *pStats);
+uint32_t WINC_SimCmdCount(uint16_t cmdId);
+uint32_t WINC_SimSockRxtInject(uint16_t sockId, uint32_t length, uint32_t count);
+uint32_t WINC_SimMsgPending(void);
+uint32_t WINC_SimLatencySet(uint32_t latencyUs);
+
+#endif /* SIM_WINC_DEV_H */
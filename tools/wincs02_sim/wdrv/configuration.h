@@ -0,0 +1,38 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+#ifndef CONFIGURATION_H
+#define CONFIGURATION_H
+
+/* Host build configuration for the WINCS02 WDRV layer, in place of the
+   Harmony generated configuration.h. */
+
+#define SYS_TIME_INDEX_0                    (0)
+#define SYS_TIME_MAX_TIMERS                 (5)
+#define SYS_TIME_HW_COUNTER_WIDTH           (32)
+#define SYS_TIME_TICK_FREQ_IN_HZ            (1000)
+
+/*** WiFi WINC Driver Configuration ***/
+#define WDRV_WINC_DEV_RX_BUFF_SZ            2048
+#define WDRV_WINC_DEV_SOCK_SLAB_NUM         50
+#define WDRV_WINC_DEV_SOCK_SLAB_SZ          1472
+#define WDRV_WINC_MOD_DISABLE_SYSLOG
+
+/* Request state and headers hold pointers, double the 32-bit allowance. */
+#define WDRV_WINC_CMD_REQ_CMD_SZ            256U
+
+#endif /* CONFIGURATION_H */
@@ -0,0 +1,137 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+/* Platform services for the host build of the WDRV layer.
+
+   Interrupt masking, system time, the WINCS02 interrupt line and the SPI
+   bus are mapped onto the simulated device. The SPI transfer queue completes
+   each list before returning. */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "definitions.h"
+#include "wdrv_winc_spi.h"
+#include "wdrv_winc_eint.h"
+#include "sim_winc_dev.h"
+
+static bool simPortIntEnabled = true;
+
+/*****************************************************************************
+                              Interrupts
+ *****************************************************************************/
+
+bool SYS_INT_Disable(void)
+{
+    bool state = simPortIntEnabled;
+
+    simPortIntEnabled = false;
+
+    return state;
+}
+
+void SYS_INT_Restore(bool state)
+{
+    simPortIntEnabled = state;
+}
+
+void WDRV_WINC_INTInitialize(SYS_MODULE_OBJ object, int intSrc)
+{
+}
+
+void WDRV_WINC_INTDeinitialize(int intSrc)
+{
+}
+
+/*****************************************************************************
+                                 Time
+ *****************************************************************************/
+
+uint32_t SYS_TIME_FrequencyGet(void)
+{
+    return 1000000U;
+}
+
+uint64_t SYS_TIME_Counter64Get(void)
+{
+    return WINC_SimTimeNs() / 1000U;
+}
+
+/* A delay handle holds the simulated time in ms at which it expires. */
+SYS_TIME_RESULT SYS_TIME_DelayMS(uint32_t ms, SYS_TIME_HANDLE *handle)
+{
+    if (NULL == handle)
+    {
+        return SYS_TIME_ERROR;
+    }
+
+    *handle = (SYS_TIME_HANDLE)(WINC_SimTimeMs() + ms);
+
+    return SYS_TIME_SUCCESS;
+}
+
+bool SYS_TIME_DelayIsComplete(SYS_TIME_HANDLE handle)
+{
+    return ((int32_t)(WINC_SimTimeMs() - (uint32_t)handle) >= 0);
+}
+
+/*****************************************************************************
+                                SPI Bus
+ *****************************************************************************/
+
+void WDRV_WINC_SPIInitialize(const WDRV_WINC_SPI_CFG *const pInitData)
+{
+}
+
+void WDRV_WINC_SPIDeinitialize(void)
+{
+}
+
+bool WDRV_WINC_SPIOpen(void)
+{
+    return true;
+}
+
+bool WDRV_WINC_SPISendReceive(void* pTransmitData, void* pReceiveData, size_t size)
+{
+    return WINC_SimSendReceive(pTransmitData, pReceiveData, size);
+}
+
+bool WDRV_WINC_SPISendReceiveList(const WINC_SDIO_XFER *pXferList, size_t numXfers)
+{
+    return WINC_SimSendReceiveList(pXferList, numXfers);
+}
+
+bool WDRV_WINC_SPITransferQueue(const WINC_SDIO_XFER *pXferList, size_t numXfers, WINC_SDIO_XFER_CALLBACK pfCallback, uintptr_t context)
+{
+    bool result;
+
+    result = WINC_SimSendReceiveList(pXferList, numXfers);
+
+    if (NULL != pfCallback)
+    {
+        pfCallback(result, context);
+    }
+
+    return result;
+}
+
+bool WDRV_WINC_SPITransferWait(void)
+{
+    return WINC_SimXferWait();
+}
@@ -0,0 +1,2206 @@
+/*
+Copyright (C) 2023-25 Microchip Technology Inc. and its subsidiaries. All rights reserved.
+
+Subject to your compliance with these terms, you may use this Microchip software and any derivatives
+exclusively with Microchip products. You are responsible for complying with third party license terms
+applicable to your use of third party software (including open source software) that may accompany this
+Microchip software. SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR
+STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-
+INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL
+MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS,
+DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER
+CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+CLAIMS RELATED TO THE SOFTWARE WILL NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY
+TO MICROCHIP FOR THIS SOFTWARE.
+*/
+
+/* WINCS02 driver benchmark against the simulated device.
+
+   Throughput and latency figures are in simulated time, which depends only
+   on the configured bus speed and module latency and is repeatable. Figures
+   marked "host" are measured with the host's monotonic clock, exclude time
+   spent inside the simulated device and vary with the machine. */
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "winc_sdio_drv.h"
+#include "winc_dev.h"
+#include "winc_cmd_req.h"
+#include "winc_cmds.h"
+#include "winc_socket.h"
+#include "sim_winc_dev.h"
+
+#define BENCH_DEV_RX_BUF_SZ         2048U
+#define BENCH_SOCK_SLAB_SZ          1472U
+#define BENCH_SOCK_SLAB_NUM         50
+
+#define BENCH_ECHO_PORT             7U
+#define BENCH_DISCARD_PORT          9U
+#define BENCH_CHARGEN_PORT          19U
+#define BENCH_LISTEN_PORT           5000U
+
+#define BENCH_WAIT_TIMEOUT_MS       600000U
+
+#define BENCH_CMD_REQ_SZ            256U
+#define BENCH_CMD_MAX_IN_FLIGHT     8U
+
+#define BENCH_BUFFER_SZ             (256U*1024U)
+
+#define BENCH_CORK_LINE_SZ          40U
+#define BENCH_CORK_LINE_INTERVAL_NS 1000000U
+
+
+typedef bool (*BENCH_DONE_FP)(uintptr_t context);
+
+static WINC_DEVICE_HANDLE benchDevHandle = WINC_DEVICE_INVALID_HANDLE;
+static uint8_t benchDevRxBuffer[BENCH_DEV_RX_BUF_SZ];
+static bool benchQuick;
+static int benchNumFailed;
+
+/* Driver error prints, any of which fails the benchmark. */
+static unsigned int benchNumErrorPrints;
+
+/* Host time spent inside the simulated device. */
+static uint64_t benchSimHostNs;
+
+/* Host time spent handling device events, excluding the simulated device. */
+static uint64_t benchEventHostNs;
+
+static unsigned int benchCmdsInFlight;
+static unsigned int benchCmdsDone;
+
+static uint8_t benchBuffer[BENCH_BUFFER_SZ];
+static uint8_t benchRxBuffer[BENCH_BUFFER_SZ];
+
+/*****************************************************************************
+                              Utilities
+ *****************************************************************************/
+
+static void benchCheck(bool result, const char *pDesc)
+{
+    if (false == result)
+    {
+        printf("FAIL: %s\n", pDesc);
+        benchNumFailed++;
+    }
+}
+
+static uint64_t benchHostNs(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+static double benchSimSec(uint64_t startNs)
+{
+    return (double)(WINC_SimTimeNs() - startNs) / 1000000000.0;
+}
+
+static double benchKBps(uint64_t bytes, uint64_t startNs)
+{
+    return ((double)bytes / 1024.0) / benchSimSec(startNs);
+}
+
+static void benchFill(uint8_t *pData, size_t length, uint32_t seed)
+{
+    size_t i;
+
+    for (i=0; i<length; i++)
+    {
+        pData[i] = (uint8_t)((i * 7U) + seed);
+    }
+}
+
+/*****************************************************************************
+                          Timed Transport Seams
+ *****************************************************************************/
+
+static bool benchSendReceive(void *pTransmitData, void *pReceiveData, size_t size)
+{
+    uint64_t startNs = benchHostNs();
+    bool result;
+
+    result = WINC_SimSendReceive(pTransmitData, pReceiveData, size);
+
+    benchSimHostNs += benchHostNs() - startNs;
+
+    return result;
+}
+
+static bool benchSendReceiveList(const WINC_SDIO_XFER *pXferList, size_t numXfers)
+{
+    uint64_t startNs = benchHostNs();
+    bool result;
+
+    result = WINC_SimSendReceiveList(pXferList, numXfers);
+
+    benchSimHostNs += benchHostNs() - startNs;
+
+    return result;
+}
+
+static bool benchXferQueue(const WINC_SDIO_XFER *pXferList, size_t numXfers, WINC_SDIO_XFER_CALLBACK pfCallback, uintptr_t context)
+{
+    bool result;
+
+    result = benchSendReceiveList(pXferList, numXfers);
+
+    if (NULL != pfCallback)
+    {
+        pfCallback(result, context);
+    }
+
+    return result;
+}
+
+static bool benchSendCRC16(void *pTransmitData, size_t size, uint16_t *pCRC16)
+{
+    uint64_t startNs = benchHostNs();
+    bool result;
+
+    result = WINC_SimSendCRC16(pTransmitData, size, pCRC16);
+
+    benchSimHostNs += benchHostNs() - startNs;
+
+    return result;
+}
+
+/*****************************************************************************
+                              Driver Tasks
+ *****************************************************************************/
+
+/* Run the driver tasks once, returns true if the bus was used. */
+static bool benchDriverTask(void)
+{
+    WINC_SIM_STATS before;
+    WINC_SIM_STATS after;
+
+    WINC_SimStatsGet(&before);
+
+    if (true == WINC_SimIntAsserted())
+    {
+        uint64_t startNs = benchHostNs();
+        uint64_t simHostNs = benchSimHostNs;
+
+        (void)WINC_DevHandleEvent(benchDevHandle, NULL);
+
+        benchEventHostNs += (benchHostNs() - startNs) - (benchSimHostNs - simHostNs);
+    }
+
+    if (false == WINC_DevUpdateEvent(benchDevHandle))
+    {
+        benchCheck(false, "WINC_DevUpdateEvent");
+    }
+
+    /* As the WDRV task does once the device is running. */
+    (void)WINC_SockUpdate(benchDevHandle);
+
+    WINC_SimStatsGet(&after);
+
+    return (before.numTransactions != after.numTransactions);
+}
+
+/* Run the driver tasks, letting simulated time pass if nothing is moving. */
+static void benchStep(void)
+{
+    uint64_t startNs;
+
+    if ((true == benchDriverTask()) || (true == benchDriverTask()))
+    {
+        return;
+    }
+
+    startNs = benchHostNs();
+
+    if (false == WINC_SimIdle())
+    {
+        WINC_SimAdvance(1000000U);
+    }
+
+    benchSimHostNs += benchHostNs() - startNs;
+}
+
+static bool benchWait(BENCH_DONE_FP pfDone, uintptr_t context)
+{
+    uint64_t endNs = WINC_SimTimeNs() + ((uint64_t)BENCH_WAIT_TIMEOUT_MS * 1000000U);
+
+    while (false == pfDone(context))
+    {
+        if (WINC_SimTimeNs() > endNs)
+        {
+            return false;
+        }
+
+        benchStep();
+    }
+
+    return true;
+}
+
+static void benchDebugPrintf(const char *format, ...)
+{
+    va_list args;
+
+    if (0 == strncmp(format, WINC_DEBUG_ANSI_SEQ_ERROR, sizeof(WINC_DEBUG_ANSI_SEQ_ERROR)-1U))
+    {
+        benchNumErrorPrints++;
+    }
+
+    va_start(args, format);
+    (void)vfprintf(stderr, format, args);
+    va_end(args);
+}
+
+static bool benchInit(const WINC_SIM_CONFIG *pConfig)
+{
+    WINC_DEV_INIT devInitData;
+    WINC_SOCKET_INIT_TYPE sockInitData;
+    WINC_SDIO_STATE_TYPE sdioState = WINC_SDIO_STATE_UNKNOWN;
+    WINC_SDIO_STATUS_TYPE sdioStatus = WINC_SDIO_STATUS_RESET_FAILED;
+    int i;
+
+    WINC_SimInit(pConfig);
+
+    WINC_DevSetDebugPrintf(benchDebugPrintf);
+
+    devInitData.pReceiveBuffer    = benchDevRxBuffer;
+    devInitData.receiveBufferSize = sizeof(benchDevRxBuffer);
+
+    benchDevHandle = WINC_DevInit(&devInitData);
+
+    if (WINC_DEVICE_INVALID_HANDLE == benchDevHandle)
+    {
+        return false;
+    }
+
+    sockInitData.pfMemAlloc = malloc;
+    sockInitData.pfMemFree  = free;
+    sockInitData.slabSize   = BENCH_SOCK_SLAB_SZ;
+    sockInitData.numSlabs   = BENCH_SOCK_SLAB_NUM;
+
+    if (false == WINC_SockInit(benchDevHandle, &sockInitData))
+    {
+        return false;
+    }
+
+    for (i=0; i<100; i++)
+    {
+        sdioStatus = WINC_SDIODeviceInit(&sdioState, benchSendReceive);
+
+        if ((WINC_SDIO_STATUS_OK == sdioStatus) || (sdioStatus < 0))
+        {
+            break;
+        }
+    }
+
+    if (WINC_SDIO_STATUS_OK != sdioStatus)
+    {
+        printf("SDIO init failed %d\n", (int)sdioStatus);
+        return false;
+    }
+
+    WINC_SDIOSendReceiveListSet(benchSendReceiveList);
+    WINC_SDIOTransferQueueSet(benchXferQueue, WINC_SimXferWait);
+    WINC_SDIOSendCRC16Set(benchSendCRC16);
+
+    (void)WINC_DevBusStateSet(benchDevHandle, WINC_DEV_BUS_STATE_ACTIVE);
+
+    return true;
+}
+
+/*****************************************************************************
+                              Socket Helpers
+ *****************************************************************************/
+
+static void benchSockAddr(struct sockaddr_in *pAddr, uint16_t port)
+{
+    (void)memset(pAddr, 0, sizeof(struct sockaddr_in));
+
+    pAddr->sin_family = AF_INET;
+    pAddr->sin_port   = htons(port);
+    pAddr->sin_addr.s_addr = htonl(0xc0a80164U);
+}
+
+static int benchWaitFd(int fd, short events)
+{
+    struct pollfd pfd;
+
+    pfd.fd      = fd;
+    pfd.events  = events;
+    pfd.revents = 0;
+
+    /* poll() does not wait, so run the driver until an event arrives. */
+    while (0 == winc_poll(&pfd, 1, 0))
+    {
+        benchStep();
+    }
+
+    return pfd.revents;
+}
+
+static int benchSocket(int type)
+{
+    return winc_socket(AF_INET, type, (SOCK_STREAM == type) ? IPPROTO_TCP : IPPROTO_UDP);
+}
+
+static void benchClose(int fd)
+{
+    if (fd >= 0)
+    {
+        (void)winc_shutdown(fd, SHUT_RDWR);
+    }
+}
+
+static int benchConnect(uint16_t port)
+{
+    struct sockaddr_in addr;
+    int fd;
+
+    fd = benchSocket(SOCK_STREAM);
+
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    benchSockAddr(&addr, port);
+
+    /* EAGAIN until the device has opened the socket. */
+    while (winc_connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0)
+    {
+        if (EINPROGRESS == errno)
+        {
+            break;
+        }
+
+        if (EAGAIN != errno)
+        {
+            benchClose(fd);
+            return -1;
+        }
+
+        benchStep();
+    }
+
+    if (0 == (benchWaitFd(fd, POLLOUT) & POLLOUT))
+    {
+        benchClose(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+static int benchListen(uint16_t port)
+{
+    struct sockaddr_in addr;
+    int fd;
+
+    fd = benchSocket(SOCK_STREAM);
+
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    benchSockAddr(&addr, port);
+    addr.sin_addr.s_addr = INADDR_ANY;
+
+    while (winc_bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0)
+    {
+        if (EAGAIN != errno)
+        {
+            benchClose(fd);
+            return -1;
+        }
+
+        benchStep();
+    }
+
+    while (winc_listen(fd, 2) < 0)
+    {
+        if (EAGAIN != errno)
+        {
+            benchClose(fd);
+            return -1;
+        }
+
+        benchStep();
+    }
+
+    return fd;
+}
+
+static int benchAccept(int listenFd)
+{
+    int fd;
+
+    while ((fd = winc_accept(listenFd, NULL, NULL)) < 0)
+    {
+        if ((EAGAIN != errno) && (EWOULDBLOCK != errno))
+        {
+            return -1;
+        }
+
+        if (0 == (benchWaitFd(listenFd, POLLIN) & POLLIN))
+        {
+            return -1;
+        }
+    }
+
+    return fd;
+}
+
+static bool benchSendAll(int fd, const uint8_t *pData, size_t length, int flags)
+{
+    while (length > 0U)
+    {
+        ssize_t sent = winc_send(fd, pData, length, flags);
+
+        if (sent < 0)
+        {
+            if (EWOULDBLOCK != errno)
+            {
+                return false;
+            }
+
+            /* POLLOUT is reported for any free space, a send is only
+               accepted if it fits entirely, so run the driver instead. */
+            benchStep();
+
+            continue;
+        }
+
+        pData  += sent;
+        length -= (size_t)sent;
+    }
+
+    return true;
+}
+
+static bool benchRecvAll(int fd, uint8_t *pData, size_t length)
+{
+    while (length > 0U)
+    {
+        ssize_t recvd = winc_recv(fd, pData, length, 0);
+
+        if (recvd < 0)
+        {
+            if (EWOULDBLOCK != errno)
+            {
+                return false;
+            }
+
+            if (0 == (benchWaitFd(fd, POLLIN) & POLLIN))
+            {
+                return false;
+            }
+
+            continue;
+        }
+
+        if (0 == recvd)
+        {
+            return false;
+        }
+
+        pData  += recvd;
+        length -= (size_t)recvd;
+    }
+
+    return true;
+}
+
+static bool benchSockTxDone(uintptr_t context)
+{
+    WINC_SIM_STATS stats;
+
+    WINC_SimStatsGet(&stats);
+
+    return (stats.sockTxBytes >= (uint64_t)context);
+}
+
+/* Wait for the device to accept length more bytes than txBytes. */
+static bool benchWaitSockTx(uint64_t txBytes, size_t length)
+{
+    return benchWait(benchSockTxDone, (uintptr_t)(txBytes + length));
+}
+
+static uint64_t benchSockTxBytes(void)
+{
+    WINC_SIM_STATS stats;
+
+    WINC_SimStatsGet(&stats);
+
+    return stats.sockTxBytes;
+}
+
+/*****************************************************************************
+                          Command Throughput
+ *****************************************************************************/
+
+static void benchCmdRspCallback(uintptr_t context, WINC_DEVICE_HANDLE devHandle, WINC_CMD_REQ_HANDLE cmdReqHandle, WINC_DEV_CMDREQ_EVENT_TYPE event, uintptr_t eventArg)
+{
+    if (WINC_DEV_CMDREQ_EVENT_STATUS_COMPLETE == event)
+    {
+        free((void*)cmdReqHandle);
+
+        benchCmdsInFlight--;
+        benchCmdsDone++;
+    }
+}
+
+static bool benchCmdsComplete(uintptr_t context)
+{
+    return (benchCmdsDone >= (unsigned int)context);
+}
+
+static void benchCmdRate(void)
+{
+    unsigned int total = (true == benchQuick) ? 500U : 5000U;
+    unsigned int issued = 0;
+    WINC_SIM_STATS before;
+    WINC_SIM_STATS after;
+    uint64_t startNs;
+
+    benchCmdsDone     = 0;
+    benchCmdsInFlight = 0;
+
+    WINC_SimStatsGet(&before);
+    startNs = WINC_SimTimeNs();
+
+    while (issued < total)
+    {
+        while ((issued < total) && (benchCmdsInFlight < BENCH_CMD_MAX_IN_FLIGHT))
+        {
+            uint8_t *pCmdReqBuffer = malloc(BENCH_CMD_REQ_SZ);
+            WINC_CMD_REQ_HANDLE cmdReqHandle;
+
+            cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, BENCH_CMD_REQ_SZ, 1, benchCmdRspCallback, 0);
+
+            if ((WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle) ||
+                    (false == WINC_CmdSOCKLST(cmdReqHandle, WINC_CMDSOCKLST_SOCK_ID_IGNORE_VAL)))
+            {
+                free(pCmdReqBuffer);
+                benchCheck(false, "command request");
+                return;
+            }
+
+            /* A request which fails once queued is completed through the
+               callback, which frees it. */
+            if (false == WINC_DevTransmitCmdReq(benchDevHandle, cmdReqHandle))
+            {
+                benchCheck(false, "command transmit");
+                return;
+            }
+
+            issued++;
+            benchCmdsInFlight++;
+        }
+
+        benchStep();
+    }
+
+    benchCheck(benchWait(benchCmdsComplete, total), "command completion");
+
+    WINC_SimStatsGet(&after);
+
+    printf("command rate:  %u SOCKLST, %.0f commands/s, %.2f commands per burst, %.0f bus transactions/s, %.2f per command\n",
+            total, (double)total / benchSimSec(startNs),
+            (double)(after.numCmds - before.numCmds) / (double)(after.numTxBursts - before.numTxBursts),
+            (double)(after.numTransactions - before.numTransactions) / benchSimSec(startNs),
+            (double)(after.numTransactions - before.numTransactions) / (double)total);
+}
+
+/* Send one request of numCmds SOCKLST commands and wait for its
+   responses, returns the host time spent handling device events. */
+static uint64_t benchCmdBurst(unsigned int numCmds)
+{
+    size_t bufferSize = (size_t)numCmds * BENCH_CMD_REQ_SZ;
+    uint8_t *pCmdReqBuffer = malloc(bufferSize);
+    WINC_CMD_REQ_HANDLE cmdReqHandle;
+    uint64_t eventHostNs = benchEventHostNs;
+    unsigned int i;
+
+    cmdReqHandle = WINC_CmdReqInit(pCmdReqBuffer, bufferSize, (int)numCmds, benchCmdRspCallback, 0);
+
+    for (i=0; i<numCmds; i++)
+    {
+        if ((WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle) ||
+                (false == WINC_CmdSOCKLST(cmdReqHandle, WINC_CMDSOCKLST_SOCK_ID_IGNORE_VAL)))
+        {
+            free(pCmdReqBuffer);
+            benchCheck(false, "burst command request");
+            return 0;
+        }
+    }
+
+    benchCmdsDone     = 0;
+    benchCmdsInFlight = 1;
+
+    if (false == WINC_DevTransmitCmdReq(benchDevHandle, cmdReqHandle))
+    {
+        benchCheck(false, "burst command transmit");
+        return 0;
+    }
+
+    benchCheck(benchWait(benchCmdsComplete, 1), "burst command completion");
+
+    return benchEventHostNs - eventHostNs;
+}
+
+/* Host cost of matching each response to its command, with up to 64
+   commands outstanding in one request. */
+static void benchRspMatch(void)
+{
+    static const unsigned int numCmds[] = {1, 4, 16, 32, 64};
+    unsigned int reps = (true == benchQuick) ? 20U : 200U;
+    uint32_t numErrors;
+    WINC_SIM_STATS stats;
+    unsigned int i;
+    unsigned int j;
+
+    WINC_SimStatsGet(&stats);
+    numErrors = stats.numErrors;
+
+    printf("rsp match:     host ns per response at");
+
+    for (i=0; i<(sizeof(numCmds)/sizeof(numCmds[0])); i++)
+    {
+        uint64_t eventHostNs = 0;
+
+        /* Warm up the caches and heap. */
+        (void)benchCmdBurst(numCmds[i]);
+
+        for (j=0; j<reps; j++)
+        {
+            eventHostNs += benchCmdBurst(numCmds[i]);
+        }
+
+        printf(" %u:%.0f", numCmds[i], (double)eventHostNs / ((double)reps * numCmds[i]));
+    }
+
+    printf(" outstanding\n");
+
+    WINC_SimStatsGet(&stats);
+
+    benchCheck(numErrors == stats.numErrors, "burst command protocol");
+}
+
+/*****************************************************************************
+                            Socket Throughput
+ *****************************************************************************/
+
+/* Stream to the discard service. */
+static void benchTcpTx(void)
+{
+    size_t total = (true == benchQuick) ? (64U*1024U) : (1024U*1024U);
+    uint64_t txBytes;
+    uint64_t startNs;
+    size_t sent;
+    int fd;
+
+    fd = benchConnect(BENCH_DISCARD_PORT);
+
+    benchCheck(fd >= 0, "tcp tx connect");
+
+    if (fd < 0)
+    {
+        return;
+    }
+
+    benchFill(benchBuffer, MAX_TCP_SOCK_PAYLOAD_SZ, 0);
+
+    txBytes = benchSockTxBytes();
+    startNs = WINC_SimTimeNs();
+
+    for (sent=0; sent<total; sent+=MAX_TCP_SOCK_PAYLOAD_SZ)
+    {
+        size_t length = ((total - sent) > MAX_TCP_SOCK_PAYLOAD_SZ) ? MAX_TCP_SOCK_PAYLOAD_SZ : (total - sent);
+
+        if (false == benchSendAll(fd, benchBuffer, length, 0))
+        {
+            benchCheck(false, "tcp tx send");
+            break;
+        }
+    }
+
+    benchCheck(benchWaitSockTx(txBytes, total), "tcp tx complete");
+
+    printf("tcp tx:        %zu KB to discard, %.1f KB/s\n", total/1024U, benchKBps(total, startNs));
+
+    benchClose(fd);
+}
+
+/* Stream from the character generator, which sends a counting pattern. */
+static void benchTcpRx(void)
+{
+    size_t total = (true == benchQuick) ? (64U*1024U) : (1024U*1024U);
+    uint64_t startNs;
+    size_t recvd;
+    size_t i;
+    int fd;
+
+    fd = benchConnect(BENCH_CHARGEN_PORT);
+
+    benchCheck(fd >= 0, "tcp rx connect");
+
+    if (fd < 0)
+    {
+        return;
+    }
+
+    startNs = WINC_SimTimeNs();
+
+    for (recvd=0; recvd<total; recvd+=sizeof(benchRxBuffer))
+    {
+        size_t length = ((total - recvd) > sizeof(benchRxBuffer)) ? sizeof(benchRxBuffer) : (total - recvd);
+
+        if (false == benchRecvAll(fd, benchRxBuffer, length))
+        {
+            benchCheck(false, "tcp rx recv");
+            break;
+        }
+
+        for (i=0; i<length; i++)
+        {
+            if ((uint8_t)(recvd + i) != benchRxBuffer[i])
+            {
+                benchCheck(false, "tcp rx data");
+                break;
+            }
+        }
+    }
+
+    printf("tcp rx:        %zu KB from chargen, %.1f KB/s\n", total/1024U, benchKBps(total, startNs));
+
+    benchClose(fd);
+}
+
+/* Stream from the character generator, reading with recv() or borrowing
+   the data in place. Reports the host time spent in the read calls. */
+static void benchTcpRxBorrowRun(bool borrow)
+{
+    size_t total = (true == benchQuick) ? (64U*1024U) : (1024U*1024U);
+    uint64_t readNs = 0;
+    uint64_t startNs;
+    unsigned int numReads = 0;
+    size_t recvd = 0;
+    size_t i;
+    int fd;
+
+    fd = benchConnect(BENCH_CHARGEN_PORT);
+
+    benchCheck(fd >= 0, "tcp rx borrow connect");
+
+    if (fd < 0)
+    {
+        return;
+    }
+
+    startNs = WINC_SimTimeNs();
+
+    while (recvd < total)
+    {
+        const uint8_t *pData = benchRxBuffer;
+        uint64_t callNs = benchHostNs();
+        ssize_t length;
+
+        if (true == borrow)
+        {
+            length = WINC_SockRecvBorrow(fd, (const void**)&pData, NULL, NULL);
+        }
+        else
+        {
+            length = winc_recv(fd, benchRxBuffer, sizeof(benchRxBuffer), 0);
+        }
+
+        readNs += benchHostNs() - callNs;
+
+        if (length < 0)
+        {
+            if ((EWOULDBLOCK != errno) || (0 == (benchWaitFd(fd, POLLIN) & POLLIN)))
+            {
+                benchCheck(false, "tcp rx borrow recv");
+                break;
+            }
+
+            continue;
+        }
+
+        if (0 == length)
+        {
+            benchCheck(false, "tcp rx borrow closed");
+            break;
+        }
+
+        for (i=0; i<(size_t)length; i++)
+        {
+            if ((uint8_t)(recvd + i) != pData[i])
+            {
+                benchCheck(false, "tcp rx borrow data");
+                break;
+            }
+        }
+
+        if (true == borrow)
+        {
+            callNs = benchHostNs();
+
+            benchCheck(0 == WINC_SockRecvRelease(fd, (size_t)length), "tcp rx borrow release");
+
+            readNs += benchHostNs() - callNs;
+        }
+
+        recvd += (size_t)length;
+        numReads++;
+    }
+
+    printf("tcp rx %s %zu KB from chargen, %.1f KB/s, %u reads of %.0f bytes, host %.0f ns per KB read\n",
+            (true == borrow) ? "borrow:" : "recv:  ", total/1024U, benchKBps(total, startNs), numReads,
+            (double)recvd / numReads, (double)readNs * 1024.0 / (double)total);
+
+    benchClose(fd);
+}
+
+static void benchTcpRxBorrow(void)
+{
+    benchTcpRxBorrowRun(false);
+    benchTcpRxBorrowRun(true);
+}
+
+/* Request/response over the echo service. */
+static void benchTcpEcho(void)
+{
+    size_t total = (true == benchQuick) ? (16U*1024U) : (256U*1024U);
+    uint64_t startNs;
+    size_t i;
+    int fd;
+
+    fd = benchConnect(BENCH_ECHO_PORT);
+
+    benchCheck(fd >= 0, "tcp echo connect");
+
+    if (fd < 0)
+    {
+        return;
+    }
+
+    benchFill(benchBuffer, total, 1);
+
+    startNs = WINC_SimTimeNs();
+
+    for (i=0; i<total; i+=1024U)
+    {
+        if ((false == benchSendAll(fd, &benchBuffer[i], 1024U, 0)) || (false == benchRecvAll(fd, &benchRxBuffer[i], 1024U)))
+        {
+            benchCheck(false, "tcp echo transfer");
+            break;
+        }
+    }
+
+    benchCheck(0 == memcmp(benchBuffer, benchRxBuffer, total), "tcp echo data");
+
+    printf("tcp echo:      %zu KB in 1 KB round trips, %.1f KB/s\n", total/1024U, benchKBps(total, startNs));
+
+    benchClose(fd);
+}
+
+/* Stream between two driver sockets, connected through a local listener. */
+static void benchTcpLoopback(void)
+{
+    size_t total = (true == benchQuick) ? (64U*1024U) : (1024U*1024U);
+    size_t sent = 0;
+    size_t recvd = 0;
+    uint64_t startNs;
+    int listenFd;
+    int txFd;
+    int rxFd;
+
+    listenFd = benchListen(BENCH_LISTEN_PORT);
+    txFd     = benchConnect(BENCH_LISTEN_PORT);
+    rxFd     = benchAccept(listenFd);
+
+    benchCheck((listenFd >= 0) && (txFd >= 0) && (rxFd >= 0), "tcp loopback connect");
+
+    if ((listenFd >= 0) && (txFd >= 0) && (rxFd >= 0))
+    {
+        benchFill(benchBuffer, sizeof(benchBuffer), 2);
+
+        startNs = WINC_SimTimeNs();
+
+        while (recvd < total)
+        {
+            bool progress = false;
+            ssize_t result;
+
+            if (sent < total)
+            {
+                size_t length = ((total - sent) > MAX_TCP_SOCK_PAYLOAD_SZ) ? MAX_TCP_SOCK_PAYLOAD_SZ : (total - sent);
+
+                result = winc_send(txFd, &benchBuffer[sent % sizeof(benchBuffer)], (length < (sizeof(benchBuffer) - (sent % sizeof(benchBuffer)))) ? length : (sizeof(benchBuffer) - (sent % sizeof(benchBuffer))), 0);
+
+                if (result > 0)
+                {
+                    sent += (size_t)result;
+                    progress = true;
+                }
+                else if (EWOULDBLOCK != errno)
+                {
+                    benchCheck(false, "tcp loopback send");
+                    break;
+                }
+                else
+                {
+                }
+            }
+
+            result = winc_recv(rxFd, benchRxBuffer, sizeof(benchRxBuffer), 0);
+
+            if (result > 0)
+            {
+                size_t offset = recvd % sizeof(benchBuffer);
+                size_t first = ((size_t)result < (sizeof(benchBuffer) - offset)) ? (size_t)result : (sizeof(benchBuffer) - offset);
+
+                if ((0 != memcmp(benchRxBuffer, &benchBuffer[offset], first)) ||
+                        (0 != memcmp(&benchRxBuffer[first], benchBuffer, (size_t)result - first)))
+                {
+                    benchCheck(false, "tcp loopback data");
+                    break;
+                }
+
+                recvd += (size_t)result;
+                progress = true;
+            }
+            else if ((0 == result) || (EWOULDBLOCK != errno))
+            {
+                benchCheck(false, "tcp loopback recv");
+                break;
+            }
+            else
+            {
+            }
+
+            if (false == progress)
+            {
+                benchStep();
+            }
+        }
+
+        printf("tcp loopback:  %zu KB between two sockets, %.1f KB/s\n", total/1024U, benchKBps(recvd, startNs));
+    }
+
+    benchClose(rxFd);
+    benchClose(txFd);
+    benchClose(listenFd);
+}
+
+/* Datagram request/response over the echo service. */
+static void benchUdpEcho(void)
+{
+    unsigned int count = (true == benchQuick) ? 64U : 1024U;
+    struct sockaddr_in addr;
+    uint64_t startNs;
+    unsigned int i;
+    int fd;
+
+    fd = benchSocket(SOCK_DGRAM);
+
+    benchCheck(fd >= 0, "udp socket");
+
+    if (fd < 0)
+    {
+        return;
+    }
+
+    benchSockAddr(&addr, BENCH_ECHO_PORT);
+
+    startNs = WINC_SimTimeNs();
+
+    for (i=0; i<count; i++)
+    {
+        struct sockaddr_in fromAddr;
+        socklen_t fromLen = sizeof(fromAddr);
+        ssize_t result;
+
+        benchFill(benchBuffer, 512U, i);
+
+        /* ENOTSOCK until the device has opened the socket. */
+        while (winc_sendto(fd, benchBuffer, 512U, 0, (struct sockaddr*)&addr, sizeof(addr)) < 0)
+        {
+            if ((EWOULDBLOCK != errno) && (EAGAIN != errno) && ((0U != i) || (ENOTSOCK != errno)))
+            {
+                benchCheck(false, "udp sendto");
+                benchClose(fd);
+                return;
+            }
+
+            benchStep();
+        }
+
+        while ((result = winc_recvfrom(fd, benchRxBuffer, sizeof(benchRxBuffer), 0, (struct sockaddr*)&fromAddr, &fromLen)) < 0)
+        {
+            if ((EWOULDBLOCK != errno) || (0 == (benchWaitFd(fd, POLLIN) & POLLIN)))
+            {
+                benchCheck(false, "udp recvfrom");
+                benchClose(fd);
+                return;
+            }
+        }
+
+        if ((512 != result) || (0 != memcmp(benchBuffer, benchRxBuffer, 512U)) || (htons(BENCH_ECHO_PORT) != fromAddr.sin_port))
+        {
+            benchCheck(false, "udp echo data");
+            break;
+        }
+    }
+
+    printf("udp echo:      %u x 512 byte datagrams, %.0f round trips/s\n", count, (double)count / benchSimSec(startNs));
+
+    benchClose(fd);
+}
+
+/*****************************************************************************
+                              Mixed Traffic
+ *****************************************************************************/
+
+#define BENCH_PROBE_INTERVAL_NS     2000000U
+
+/* A control command sent periodically alongside bulk traffic. */
+static bool benchProbeInFlight;
+static uint64_t benchProbeNextNs;
+static uint64_t benchProbeSentNs;
+static uint64_t benchProbeTotalNs;
+static uint64_t benchProbeMaxNs;
+static unsigned int benchProbeNumDone;
+
+static void benchProbeRspCallback(uintptr_t context, WINC_DEVICE_HANDLE devHandle, WINC_CMD_REQ_HANDLE cmdReqHandle, WINC_DEV_CMDREQ_EVENT_TYPE event, uintptr_t eventArg)
+{
+    uint64_t rttNs;
+
+    if (WINC_DEV_CMDREQ_EVENT_STATUS_COMPLETE != event)
+    {
+        return;
+    }
+
+    rttNs = WINC_SimTimeNs() - benchProbeSentNs;
+
+    benchProbeTotalNs += rttNs;
+
+    if (rttNs > benchProbeMaxNs)
+    {
+        benchProbeMaxNs = rttNs;
+    }
+
+    benchProbeInFlight = false;
+    benchProbeNumDone++;
+
+    free((void*)cmdReqHandle);
+}
+
+/* Send a GMR control command if one is due. */
+static void benchProbeSend(bool asBulk)
+{
+    uint8_t *pCmdReqBuffer;
+    WINC_CMD_REQ_HANDLE cmdReqHandle;
+    bool result;
+
+    if ((true == benchProbeInFlight) || (WINC_SimTimeNs() < benchProbeNextNs))
+    {
+        return;
+    }
+
+    pCmdReqBuffer = malloc(BENCH_CMD_REQ_SZ);
+    cmdReqHandle  = WINC_CmdReqInit(pCmdReqBuffer, BENCH_CMD_REQ_SZ, 1, benchProbeRspCallback, 0);
+    result        = WINC_CmdGMR(cmdReqHandle);
+
+    /* Queue with the bulk traffic, as the single request queue did. */
+    if ((true == result) && (true == asBulk))
+    {
+        result = WINC_CmdReqClassSet(cmdReqHandle, WINC_DEV_CMD_CLASS_BULK);
+    }
+
+    if ((WINC_CMD_REQ_INVALID_HANDLE == cmdReqHandle) || (false == result))
+    {
+        free(pCmdReqBuffer);
+        benchCheck(false, "probe command request");
+        return;
+    }
+
+    benchProbeInFlight = true;
+    benchProbeSentNs   = WINC_SimTimeNs();
+    benchProbeNextNs   = benchProbeSentNs + BENCH_PROBE_INTERVAL_NS;
+
+    if (false == WINC_DevTransmitCmdReq(benchDevHandle, cmdReqHandle))
+    {
+        benchCheck(false, "probe command transmit");
+    }
+}
+
+static bool benchProbeIdle(uintptr_t context)
+{
+    return (false == benchProbeInFlight);
+}
+
+/* Stream to the discard service while sending a control command every
+   2 ms, reports its round trip time and the queueing delay of each class.
+   With asBulk the control command shares the bulk class, as when all
+   requests waited in one queue. */
+static void benchMixedRun(bool asBulk)
+{
+    size_t total = (true == benchQuick) ? (256U*1024U) : (2048U*1024U);
+    WINC_DEV_CMD_CLASS_STATS before[WINC_DEV_NUM_CMD_CLASSES];
+    WINC_DEV_CMD_CLASS_STATS after[WINC_DEV_NUM_CMD_CLASSES];
+    uint32_t numSent[WINC_DEV_NUM_CMD_CLASSES];
+    uint64_t txBytes;
+    size_t sent = 0;
+    unsigned int i;
+    int fd;
+
+    fd = benchConnect(BENCH_DISCARD_PORT);
+
+    benchCheck(fd >= 0, "mixed connect");
+
+    if (fd < 0)
+    {
+        return;
+    }
+
+    benchProbeNextNs  = 0;
+    benchProbeTotalNs = 0;
+    benchProbeMaxNs   = 0;
+    benchProbeNumDone = 0;
+
+    benchFill(benchBuffer, MAX_TCP_SOCK_PAYLOAD_SZ, 0);
+
+    benchCheck((int)WINC_DEV_NUM_CMD_CLASSES == WINC_DevCmdClassStatsGet(benchDevHandle, before, WINC_DEV_NUM_CMD_CLASSES), "class statistics");
+
+    txBytes = benchSockTxBytes();
+
+    while (sent < total)
+    {
+        ssize_t result;
+
+        benchProbeSend(asBulk);
+
+        result = winc_send(fd, benchBuffer, MAX_TCP_SOCK_PAYLOAD_SZ, 0);
+
+        if (result >= 0)
+        {
+            sent += (size_t)result;
+        }
+        else if (EWOULDBLOCK == errno)
+        {
+            benchStep();
+        }
+        else
+        {
+            benchCheck(false, "mixed send");
+            break;
+        }
+    }
+
+    benchCheck(benchWaitSockTx(txBytes, sent), "mixed tx complete");
+    benchCheck(benchWait(benchProbeIdle, 0), "probe completion");
+
+    (void)WINC_DevCmdClassStatsGet(benchDevHandle, after, WINC_DEV_NUM_CMD_CLASSES);
+
+    for (i=0; i<WINC_DEV_NUM_CMD_CLASSES; i++)
+    {
+        numSent[i] = after[i].numSent - before[i].numSent;
+
+        if (0U == numSent[i])
+        {
+            numSent[i] = 1;
+        }
+    }
+
+    printf("mixed %s:   %zu KB bulk, %u GMR rtt avg %.0f max %.0f us, queueing avg control %.0f bulk %.0f us\n",
+            (true == asBulk) ? "queue" : "class", sent/1024U, benchProbeNumDone,
+            (double)benchProbeTotalNs / (1000.0 * benchProbeNumDone), (double)benchProbeMaxNs / 1000.0,
+            (double)(after[WINC_DEV_CMD_CLASS_CONTROL].totalDelay - before[WINC_DEV_CMD_CLASS_CONTROL].totalDelay) / numSent[WINC_DEV_CMD_CLASS_CONTROL],
+            (double)(after[WINC_DEV_CMD_CLASS_BULK].totalDelay - before[WINC_DEV_CMD_CLASS_BULK].totalDelay) / numSent[WINC_DEV_CMD_CLASS_BULK]);
+
+    benchClose(fd);
+}
+
+static void benchMixed(void)
+{
+    benchMixedRun(false);
+    benchMixedRun(true);
+}
+
+/*****************************************************************************
+                               Read Window
+ *****************************************************************************/
+
+/* Stream from the character generator with asynchronous receive off, so
+   the driver fetches the data with SOCKRD requests, at a raised module
+   latency. */
+static void benchRxWindowRun(uint32_t latencyUs)
+{
+    size_t total = (true == benchQuick) ? (64U*1024U) : (512U*1024U);
+    int readMode = (int)WINC_SOCKET_ASYNC_MODE_OFF;
+    uint32_t prevLatencyUs;
+    uint32_t numReads;
+    uint64_t startNs;
+    size_t recvd;
+    size_t i;
+    int fd;
+
+    prevLatencyUs = WINC_SimLatencySet(latencyUs);
+
+    fd = benchConnect(BENCH_CHARGEN_PORT);
+
+    benchCheck(fd >= 0, "rx window connect");
+
+    if (fd < 0)
+    {
+        (void)WINC_SimLatencySet(prevLatencyUs);
+        return;
+    }
+
+    benchCheck(0 == winc_setsockopt(fd, SOL_SOCKET, SO_ASYNC_MODE, &readMode, sizeof(readMode)), "rx window async mode");
+
+    numReads = WINC_SimCmdCount(WINC_CMD_ID_SOCKRD);
+    startNs  = WINC_SimTimeNs();
+
+    for (recvd=0; recvd<total; recvd+=sizeof(benchRxBuffer))
+    {
+        size_t length = ((total - recvd) > sizeof(benchRxBuffer)) ? sizeof(benchRxBuffer) : (total - recvd);
+
+        if (false == benchRecvAll(fd, benchRxBuffer, length))
+        {
+            benchCheck(false, "rx window recv");
+            break;
+        }
+
+        /* Data already pushed before the mode change continues the pattern. */
+        for (i=1; i<length; i++)
+        {
+            if ((uint8_t)(benchRxBuffer[i-1] + 1U) != benchRxBuffer[i])
+            {
+                benchCheck(false, "rx window data");
+                break;
+            }
+        }
+    }
+
+    numReads = WINC_SimCmdCount(WINC_CMD_ID_SOCKRD) - numReads;
+
+    printf("tcp rx window: %zu KB from chargen with SOCKRD at %u us latency, %.1f KB/s, %u reads\n",
+            total/1024U, latencyUs, benchKBps(total, startNs), numReads);
+
+    benchClose(fd);
+
+    (void)WINC_SimLatencySet(prevLatencyUs);
+}
+
+static void benchRxWindow(void)
+{
+    benchRxWindowRun(1000U);
+    benchRxWindowRun(10000U);
+}
+
+/*****************************************************************************
+                             Gathered Writes
+ *****************************************************************************/
+
+#define BENCH_HTTP_BODY_SZ          1024U
+
+static const char benchHttpHdr[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: application/octet-stream\r\n"
+    "Transfer-Encoding: chunked\r\n"
+    "Connection: keep-alive\r\n"
+    "\r\n"
+    "400\r\n";
+
+static const char benchHttpTrailer[] = "\r\n0\r\n\r\n";
+
+/* HTTP responses of three fragments, the headers, the body and the chunk
+   trailer, to the discard service. Each response is either gathered by
+   writev() or assembled into one buffer for send(). Reports the host time
+   per response spent assembling and sending. */
+static void benchHttpRun(bool useWritev)
+{
+    unsigned int count = (true == benchQuick) ? 64U : 1024U;
+    size_t respLen = (sizeof(benchHttpHdr) - 1U) + BENCH_HTTP_BODY_SZ + (sizeof(benchHttpTrailer) - 1U);
+    uint64_t sendNs = 0;
+    uint64_t txBytes;
+    uint64_t startNs;
+    unsigned int i;
+    int fd;
+
+    fd = benchConnect(BENCH_DISCARD_PORT);
+
+    benchCheck(fd >= 0, "http connect");
+
+    if (fd < 0)
+    {
+        return;
+    }
+
+    benchFill(benchBuffer, BENCH_HTTP_BODY_SZ, 0);
+
+    txBytes = benchSockTxBytes();
+    startNs = WINC_SimTimeNs();
+
+    for (i=0; i<count; i++)
+    {
+        struct iovec iov[3];
+        ssize_t result;
+        uint64_t callNs = benchHostNs();
+
+        if (true == useWritev)
+        {
+            iov[0].iov_base = (void*)benchHttpHdr;
+            iov[0].iov_len  = sizeof(benchHttpHdr) - 1U;
+            iov[1].iov_base = benchBuffer;
+            iov[1].iov_len  = BENCH_HTTP_BODY_SZ;
+            iov[2].iov_base = (void*)benchHttpTrailer;
+            iov[2].iov_len  = sizeof(benchHttpTrailer) - 1U;
+        }
+        else
+        {
+            uint8_t *pResp = benchRxBuffer;
+
+            (void)memcpy(pResp, benchHttpHdr, sizeof(benchHttpHdr) - 1U);
+            pResp += sizeof(benchHttpHdr) - 1U;
+            (void)memcpy(pResp, benchBuffer, BENCH_HTTP_BODY_SZ);
+            pResp += BENCH_HTTP_BODY_SZ;
+            (void)memcpy(pResp, benchHttpTrailer, sizeof(benchHttpTrailer) - 1U);
+        }
+
+        sendNs += benchHostNs() - callNs;
+
+        /* Sends are accepted whole, run the driver until there is space. */
+        while (true)
+        {
+            callNs = benchHostNs();
+
+            if (true == useWritev)
+            {
+                result = winc_writev(fd, iov, 3);
+            }
+            else
+            {
+                result = winc_send(fd, benchRxBuffer, respLen, 0);
+            }
+
+            sendNs += benchHostNs() - callNs;
+
+            if (result >= 0)
+            {
+                break;
+            }
+
+            if (EWOULDBLOCK != errno)
+            {
+                benchCheck(false, "http send");
+                benchClose(fd);
+                return;
+            }
+
+            benchStep();
+        }
+
+        benchCheck((size_t)result == respLen, "http send length");
+    }
+
+    benchCheck(benchWaitSockTx(txBytes, (size_t)count * respLen), "http complete");
+
+    printf("http %s %u x %zu byte responses in 3 fragments, %.0f responses/s, host %.0f ns per response\n",
+            (true == useWritev) ? "writev:" : "send:  ", count, respLen,
+            (double)count / benchSimSec(startNs), (double)sendNs / count);
+
+    benchClose(fd);
+}
+
+static void benchHttp(void)
+{
+    benchHttpRun(false);
+    benchHttpRun(true);
+}
+
+/*****************************************************************************
+                             Batched Datagrams
+ *****************************************************************************/
+
+#define BENCH_UDP_BATCH_SZ          16U
+
+/* Datagrams to the discard service, sent with one sendto() each or in
+   batches with sendmmsg(). The rate is measured until the device has
+   accepted every datagram. */
+static void benchUdpBatchRun(size_t length, bool useMmsg)
+{
+    unsigned int count = (true == benchQuick) ? 256U : 4096U;
+    struct mmsghdr msgs[BENCH_UDP_BATCH_SZ];
+    struct iovec iov;
+    SOCKADDR_UNION addr;
+    WINC_SIM_STATS before;
+    WINC_SIM_STATS after;
+    uint64_t startNs;
+    uint64_t sendNs = 0;
+    unsigned int numSent = 0;
+    unsigned int i;
+    int fd;
+
+    fd = benchSocket(SOCK_DGRAM);
+
+    benchCheck(fd >= 0, "udp batch socket");
+
+    if (fd < 0)
+    {
+        return;
+    }
+
+    /* sendto() copies a whole SOCKADDR_UNION with each datagram. */
+    (void)memset(&addr, 0, sizeof(addr));
+    benchSockAddr(&addr.in4, BENCH_DISCARD_PORT);
+
+    benchFill(benchBuffer, length, 0);
+
+    iov.iov_base = benchBuffer;
+    iov.iov_len  = length;
+
+    (void)memset(msgs, 0, sizeof(msgs));
+
+    for (i=0; i<BENCH_UDP_BATCH_SZ; i++)
+    {
+        msgs[i].msg_hdr.msg_name    = &addr;
+        msgs[i].msg_hdr.msg_namelen = sizeof(addr.in4);
+        msgs[i].msg_hdr.msg_iov     = &iov;
+        msgs[i].msg_hdr.msg_iovlen  = 1;
+    }
+
+    /* ENOTSOCK until the device has opened the socket. */
+    while (winc_sendto(fd, benchBuffer, length, 0, &addr.sa, sizeof(addr.in4)) < 0)
+    {
+        if ((EWOULDBLOCK != errno) && (EAGAIN != errno) && (ENOTSOCK != errno))
+        {
+            benchCheck(false, "udp batch open");
+            benchClose(fd);
+            return;
+        }
+
+        benchStep();
+    }
+
+    benchCheck(benchWaitSockTx(benchSockTxBytes(), 0), "udp batch open");
+
+    WINC_SimStatsGet(&before);
+
+    startNs = WINC_SimTimeNs();
+
+    while (numSent < count)
+    {
+        uint64_t callNs = benchHostNs();
+        int result;
+
+        if (true == useMmsg)
+        {
+            unsigned int vlen = ((count - numSent) > BENCH_UDP_BATCH_SZ) ? BENCH_UDP_BATCH_SZ : (count - numSent);
+
+            result = winc_sendmmsg(fd, msgs, vlen, 0);
+        }
+        else
+        {
+            result = (winc_sendto(fd, benchBuffer, length, 0, &addr.sa, sizeof(addr.in4)) < 0) ? -1 : 1;
+        }
+
+        sendNs += benchHostNs() - callNs;
+
+        if (result > 0)
+        {
+            numSent += (unsigned int)result;
+        }
+        else if ((0 == result) || (EWOULDBLOCK == errno))
+        {
+            benchStep();
+        }
+        else
+        {
+            benchCheck(false, "udp batch send");
+            break;
+        }
+    }
+
+    benchCheck(benchWaitSockTx(before.sockTxBytes, (size_t)count * length), "udp batch complete");
+
+    WINC_SimStatsGet(&after);
+
+    printf("udp %s %u x %zu byte datagrams to discard, %.0f datagrams/s, %.1f per bus burst, host %.0f ns per datagram\n",
+            (true == useMmsg) ? "sendmmsg:" : "sendto:  ", count, length, (double)count / benchSimSec(startNs),
+            (double)count / (after.numTxBursts - before.numTxBursts),
+            (double)sendNs / count);
+
+    benchClose(fd);
+}
+
+static void benchUdpBatch(void)
+{
+    benchUdpBatchRun(64U, false);
+    benchUdpBatchRun(64U, true);
+    benchUdpBatchRun(512U, false);
+    benchUdpBatchRun(512U, true);
+}
+
+/*****************************************************************************
+                              Write Coalescing
+ *****************************************************************************/
+
+/* Line oriented writer, one 40 byte line per millisecond. */
+static void benchCorkRun(bool cork)
+{
+    unsigned int numLines = (true == benchQuick) ? 256U : 2048U;
+    size_t total = (size_t)numLines * BENCH_CORK_LINE_SZ;
+    uint32_t numWrites;
+    uint64_t txBytes;
+    unsigned int i;
+    int value;
+    int fd;
+
+    fd = benchConnect(BENCH_DISCARD_PORT);
+
+    benchCheck(fd >= 0, "cork connect");
+
+    if (fd < 0)
+    {
+        return;
+    }
+
+    value = 1;
+
+    if (true == cork)
+    {
+        benchCheck(0 == winc_setsockopt(fd, IPPROTO_TCP, TCP_CORK, &value, sizeof(value)), "cork setsockopt");
+    }
+
+    benchFill(benchBuffer, BENCH_CORK_LINE_SZ, 3);
+    benchBuffer[BENCH_CORK_LINE_SZ-1U] = '\n';
+
+    numWrites = WINC_SimCmdCount(WINC_CMD_ID_SOCKWR);
+    txBytes   = benchSockTxBytes();
+
+    for (i=0; i<numLines; i++)
+    {
+        benchCheck(benchSendAll(fd, benchBuffer, BENCH_CORK_LINE_SZ, 0), "cork send");
+
+        WINC_SimAdvance(BENCH_CORK_LINE_INTERVAL_NS);
+
+        while (true == benchDriverTask())
+        {
+        }
+    }
+
+    /* The socket is left corked, WINC_SockUpdate() writes the remainder
+       once the cork timeout expires. */
+    benchCheck(benchWaitSockTx(txBytes, total), "cork complete");
+
+    numWrites = WINC_SimCmdCount(WINC_CMD_ID_SOCKWR) - numWrites;
+
+    printf("%s%u x %u byte lines, %u SOCKWR, %.1f SOCKWR per KB\n", (true == cork) ? "tcp corked:    " : "tcp uncorked:  ",
+            numLines, BENCH_CORK_LINE_SZ, numWrites, (double)numWrites / ((double)total / 1024.0));
+
+    benchClose(fd);
+}
+
+static void benchCork(void)
+{
+    benchCorkRun(false);
+    benchCorkRun(true);
+}
+
+/*****************************************************************************
+                              Readiness Dispatch
+ *****************************************************************************/
+
+#define BENCH_EPOLL_MAX_SOCKETS     10U
+#define BENCH_EPOLL_MAX_SAMPLES     16384U
+
+/* Host time per dispatch, the median is reported as preemption of the
+   benchmark skews the mean of such short calls. */
+static uint32_t benchEpollSamples[2][BENCH_EPOLL_MAX_SAMPLES];
+
+static int benchEpollSampleCmp(const void *pA, const void *pB)
+{
+    uint32_t a = *(const uint32_t*)pA;
+    uint32_t b = *(const uint32_t*)pB;
+
+    return (a > b) - (a < b);
+}
+
+static uint32_t benchEpollMedian(uint32_t *pSamples, unsigned int numSamples)
+{
+    qsort(pSamples, numSamples, sizeof(uint32_t), benchEpollSampleCmp);
+
+    return pSamples[numSamples / 2U];
+}
+
+/* Exchange datagrams with the echo service on the first socket while the
+   rest stay idle, dispatching readiness each step with poll() over every
+   socket or with the epoll interest set. */
+static void benchEpollRun(unsigned int numSockets)
+{
+    unsigned int count = (true == benchQuick) ? 64U : 1024U;
+    int fds[BENCH_EPOLL_MAX_SOCKETS];
+    struct pollfd pfds[BENCH_EPOLL_MAX_SOCKETS];
+    WINC_SOCK_EPOLL_EVENT events[BENCH_EPOLL_MAX_SOCKETS];
+    SOCKADDR_UNION addr;
+    unsigned int numDispatches[2] = {0, 0};
+    unsigned int mode;
+    unsigned int i;
+    int epfd;
+
+    for (i=0; i<numSockets; i++)
+    {
+        fds[i] = benchSocket(SOCK_DGRAM);
+
+        benchCheck(fds[i] >= 0, "epoll socket");
+
+        if (fds[i] < 0)
+        {
+            numSockets = i;
+            break;
+        }
+    }
+
+    epfd = WINC_SockEpollCreate();
+
+    benchCheck(epfd >= 0, "epoll create");
+
+    (void)memset(&addr, 0, sizeof(addr));
+    benchSockAddr(&addr.in4, BENCH_ECHO_PORT);
+
+    for (i=0; (epfd >= 0) && (i<numSockets); i++)
+    {
+        WINC_SOCK_EPOLL_EVENT event;
+
+        pfds[i].fd      = fds[i];
+        pfds[i].events  = POLLIN;
+        pfds[i].revents = 0;
+
+        event.events = POLLIN;
+        event.data   = i;
+
+        benchCheck(0 == WINC_SockEpollCtl(epfd, WINC_SOCK_EPOLL_CTL_ADD, fds[i], &event), "epoll add");
+    }
+
+    /* Let the device open the sockets. */
+    for (i=0; i<100U; i++)
+    {
+        benchStep();
+    }
+
+    for (mode=0; (epfd >= 0) && (0U != numSockets) && (mode<2U); mode++)
+    {
+        unsigned int n;
+
+        for (n=0; n<count; n++)
+        {
+            bool ready = false;
+            ssize_t result;
+
+            benchFill(benchBuffer, 64U, n);
+
+            if (winc_sendto(fds[0], benchBuffer, 64U, 0, &addr.sa, sizeof(addr.in4)) < 0)
+            {
+                benchCheck(false, "epoll sendto");
+                break;
+            }
+
+            while (false == ready)
+            {
+                uint64_t callNs = benchHostNs();
+                int numReady;
+
+                if (0U == mode)
+                {
+                    numReady = winc_poll(pfds, numSockets, 0);
+                    ready = ((numReady > 0) && (0 != (pfds[0].revents & POLLIN)));
+                }
+                else
+                {
+                    numReady = WINC_SockEpollWait(epfd, events, (int)numSockets, 0);
+                    ready = ((numReady > 0) && (0U == events[0].data) && (0U != (events[0].events & POLLIN)));
+                }
+
+                if (numDispatches[mode] < BENCH_EPOLL_MAX_SAMPLES)
+                {
+                    benchEpollSamples[mode][numDispatches[mode]++] = (uint32_t)(benchHostNs() - callNs);
+                }
+
+                if (numReady > 1)
+                {
+                    benchCheck(false, "epoll idle socket ready");
+                    break;
+                }
+
+                if (false == ready)
+                {
+                    benchStep();
+                }
+            }
+
+            result = winc_recvfrom(fds[0], benchRxBuffer, sizeof(benchRxBuffer), 0, NULL, NULL);
+
+            if ((64 != result) || (0 != memcmp(benchBuffer, benchRxBuffer, 64U)))
+            {
+                benchCheck(false, "epoll echo data");
+                break;
+            }
+        }
+    }
+
+    if ((0U != numDispatches[0]) && (0U != numDispatches[1]))
+    {
+        printf("epoll dispatch: %2u sockets, 1 active, host poll() %u ns, epoll %u ns per dispatch\n",
+                numSockets, benchEpollMedian(benchEpollSamples[0], numDispatches[0]), benchEpollMedian(benchEpollSamples[1], numDispatches[1]));
+    }
+
+    if (epfd >= 0)
+    {
+        (void)WINC_SockEpollDestroy(epfd);
+    }
+
+    for (i=0; i<numSockets; i++)
+    {
+        benchClose(fds[i]);
+    }
+
+    /* Let the device close the sockets before the next run opens more. */
+    for (i=0; i<100U; i++)
+    {
+        benchStep();
+    }
+}
+
+static void benchEpoll(void)
+{
+    benchEpollRun(1U);
+    benchEpollRun(4U);
+    benchEpollRun(BENCH_EPOLL_MAX_SOCKETS);
+}
+
+/*****************************************************************************
+                         Constant Payload Sends
+ *****************************************************************************/
+
+static bool benchConstDone;
+static WINC_SOCKET_STATUS benchConstStatus;
+
+static void benchSendConstCallback(uintptr_t context, int fd, const void *pData, size_t len, WINC_SOCKET_STATUS status)
+{
+    benchConstDone   = true;
+    benchConstStatus = status;
+}
+
+static bool benchSendConstDone(uintptr_t context)
+{
+    return benchConstDone;
+}
+
+/* Serve a static asset to the discard service, reporting the host time
+   spent in the driver per byte. */
+static void benchSendConstRun(bool useConst)
+{
+    size_t total = (true == benchQuick) ? (64U*1024U) : BENCH_BUFFER_SZ;
+    uint64_t txBytes;
+    uint64_t hostNs;
+    uint64_t simHostNs;
+    uint64_t startNs;
+    int fd;
+
+    fd = benchConnect(BENCH_DISCARD_PORT);
+
+    benchCheck(fd >= 0, "asset connect");
+
+    if (fd < 0)
+    {
+        return;
+    }
+
+    benchFill(benchBuffer, total, 4);
+
+    txBytes   = benchSockTxBytes();
+    startNs   = WINC_SimTimeNs();
+    simHostNs = benchSimHostNs;
+    hostNs    = benchHostNs();
+
+    if (true == useConst)
+    {
+        benchConstDone = false;
+
+        benchCheck(0 == WINC_SockSendConst(fd, benchBuffer, total, benchSendConstCallback, 0), "WINC_SockSendConst");
+        benchCheck(benchWait(benchSendConstDone, 0), "WINC_SockSendConst complete");
+        benchCheck(WINC_SOCKET_STATUS_OK == benchConstStatus, "WINC_SockSendConst status");
+    }
+    else
+    {
+        size_t sent;
+
+        for (sent=0; sent<total; sent+=MAX_TCP_SOCK_PAYLOAD_SZ)
+        {
+            size_t length = ((total - sent) > MAX_TCP_SOCK_PAYLOAD_SZ) ? MAX_TCP_SOCK_PAYLOAD_SZ : (total - sent);
+
+            if (false == benchSendAll(fd, &benchBuffer[sent], length, 0))
+            {
+                benchCheck(false, "asset send");
+                break;
+            }
+        }
+    }
+
+    benchCheck(benchWaitSockTx(txBytes, total), "asset complete");
+
+    hostNs = (benchHostNs() - hostNs) - (benchSimHostNs - simHostNs);
+
+    printf("%s%zu KB, %.1f KB/s, %.2f ns host per byte\n", (true == useConst) ? "send const:    " : "send 1460:     ",
+            total/1024U, benchKBps(total, startNs), (double)hostNs / (double)total);
+
+    benchClose(fd);
+}
+
+static void benchSendConst(void)
+{
+    benchSendConstRun(false);
+    benchSendConstRun(true);
+}
+
+/*****************************************************************************
+                            Name Resolution
+ *****************************************************************************/
+
+#define BENCH_DNS_NUM_NAMES         32U
+#define BENCH_DNS_HIT_LOOPS         10000U
+
+static bool benchDnsDone[BENCH_DNS_NUM_NAMES];
+
+static const struct addrinfo benchDnsHint = {0, AF_INET, SOCK_STREAM, 0, 0, NULL, NULL, NULL};
+
+static int benchGetAddrInfo(const char *pHost, struct addrinfo **ppResult)
+{
+    uint64_t endNs = WINC_SimTimeNs() + ((uint64_t)BENCH_WAIT_TIMEOUT_MS * 1000000U);
+    int result;
+
+    while (EAI_AGAIN == (result = winc_getaddrinfo(pHost, NULL, &benchDnsHint, ppResult)))
+    {
+        if (WINC_SimTimeNs() > endNs)
+        {
+            break;
+        }
+
+        benchStep();
+    }
+
+    return result;
+}
+
+static void benchDnsCallback(uintptr_t context, const char *host, WINC_SOCKET_STATUS status)
+{
+    benchDnsDone[context] = true;
+}
+
+static void benchDns(void)
+{
+    struct addrinfo *pResult = NULL;
+    uint32_t numQueries;
+    uint64_t startNs;
+    uint64_t hostNs;
+    unsigned int numCollected = 0;
+    unsigned int numStarted = 0;
+    char name[32];
+    unsigned int i;
+    int result;
+
+    /* Miss, resolved by the device. */
+    startNs = WINC_SimTimeNs();
+
+    benchCheck(0 == benchGetAddrInfo("host1", &pResult), "dns miss");
+
+    printf("dns miss:      %.1f ms\n", benchSimSec(startNs) * 1000.0);
+
+    benchCheck((NULL != pResult) && (htonl(0x0a000001U) == ((struct sockaddr_in*)pResult->ai_addr)->sin_addr.s_addr), "dns address");
+
+    winc_freeaddrinfo(pResult);
+
+    /* Hits, served from the cache. */
+    numQueries = WINC_SimCmdCount(WINC_CMD_ID_DNSRESOLV);
+    hostNs     = benchHostNs();
+
+    for (i=0; i<BENCH_DNS_HIT_LOOPS; i++)
+    {
+        if (0 != winc_getaddrinfo("host1", NULL, &benchDnsHint, &pResult))
+        {
+            benchCheck(false, "dns hit");
+            break;
+        }
+
+        winc_freeaddrinfo(pResult);
+    }
+
+    hostNs = benchHostNs() - hostNs;
+
+    benchCheck(numQueries == WINC_SimCmdCount(WINC_CMD_ID_DNSRESOLV), "dns hit without query");
+
+    printf("dns hit:       %.0f ns host per getaddrinfo+freeaddrinfo\n", (double)hostNs / (double)BENCH_DNS_HIT_LOOPS);
+
+    /* Failures are reported, not retried forever. */
+    result = benchGetAddrInfo("bad1", &pResult);
+
+    benchCheck((0 != result) && (EAI_AGAIN != result), "dns failure");
+
+    /* Distinct names one at a time. */
+    startNs = WINC_SimTimeNs();
+
+    for (i=0; i<BENCH_DNS_NUM_NAMES; i++)
+    {
+        (void)snprintf(name, sizeof(name), "seq%u", i);
+
+        if (0 != benchGetAddrInfo(name, &pResult))
+        {
+            benchCheck(false, "dns sequential");
+            break;
+        }
+
+        winc_freeaddrinfo(pResult);
+    }
+
+    printf("dns serial:    %u names, %.0f ms\n", BENCH_DNS_NUM_NAMES, benchSimSec(startNs) * 1000.0);
+
+    /* Distinct names with the request table kept full. */
+    (void)memset(benchDnsDone, 0, sizeof(benchDnsDone));
+
+    startNs = WINC_SimTimeNs();
+
+    while (numCollected < BENCH_DNS_NUM_NAMES)
+    {
+        while (numStarted < BENCH_DNS_NUM_NAMES)
+        {
+            (void)snprintf(name, sizeof(name), "par%u", numStarted);
+
+            result = WINC_SockGetAddrInfoAsync(name, &benchDnsHint, benchDnsCallback, numStarted);
+
+            if (0 == result)
+            {
+                benchDnsDone[numStarted] = true;
+            }
+            else if (EAI_AGAIN != result)
+            {
+                benchCheck((EAI_SYSTEM == result) && (EBUSY == errno), "dns async start");
+                break;
+            }
+            else
+            {
+            }
+
+            numStarted++;
+        }
+
+        for (i=0; i<numStarted; i++)
+        {
+            if (true == benchDnsDone[i])
+            {
+                (void)snprintf(name, sizeof(name), "par%u", i);
+
+                benchCheck(0 == winc_getaddrinfo(name, NULL, &benchDnsHint, &pResult), "dns async result");
+
+                winc_freeaddrinfo(pResult);
+
+                benchDnsDone[i] = false;
+                numCollected++;
+            }
+        }
+
+        if ((benchSimSec(startNs) * 1000.0) > (double)BENCH_WAIT_TIMEOUT_MS)
+        {
+            benchCheck(false, "dns async timeout");
+            break;
+        }
+
+        benchStep();
+    }
+
+    printf("dns parallel:  %u names, %.0f ms\n", BENCH_DNS_NUM_NAMES, benchSimSec(startNs) * 1000.0);
+}
+
+/*****************************************************************************
+                              Buffer Sizing
+ *****************************************************************************/
+
+#define BENCH_NUM_IDLE_SOCKETS      2U
+
+/* One bulk sender to the discard service sharing the slab pool with idle
+   connected sockets, compare the default and autotune builds. The idle
+   sockets are read with SOCKRD, so their receive buffers can be shrunk. */
+static void benchBulkIdleRun(uint32_t latencyUs)
+{
+    size_t total = (true == benchQuick) ? (64U*1024U) : (512U*1024U);
+    int readMode = (int)WINC_SOCKET_ASYNC_MODE_OFF;
+    int idleFd[BENCH_NUM_IDLE_SOCKETS];
+    uint32_t prevLatencyUs;
+    uint64_t txBytes;
+    uint64_t startNs;
+    size_t sent;
+    unsigned int i;
+    int fd;
+
+    prevLatencyUs = WINC_SimLatencySet(latencyUs);
+
+    for (i=0; i<BENCH_NUM_IDLE_SOCKETS; i++)
+    {
+        idleFd[i] = benchConnect(BENCH_DISCARD_PORT);
+
+        benchCheck(idleFd[i] >= 0, "idle connect");
+
+        if (idleFd[i] >= 0)
+        {
+            benchCheck(0 == winc_setsockopt(idleFd[i], SOL_SOCKET, SO_ASYNC_MODE, &readMode, sizeof(readMode)), "idle async mode");
+        }
+    }
+
+    fd = benchConnect(BENCH_DISCARD_PORT);
+
+    benchCheck(fd >= 0, "bulk connect");
+
+    if (fd >= 0)
+    {
+        benchFill(benchBuffer, MAX_TCP_SOCK_PAYLOAD_SZ, 5);
+
+        txBytes = benchSockTxBytes();
+        startNs = WINC_SimTimeNs();
+
+        for (sent=0; sent<total; sent+=MAX_TCP_SOCK_PAYLOAD_SZ)
+        {
+            if (false == benchSendAll(fd, benchBuffer, MAX_TCP_SOCK_PAYLOAD_SZ, 0))
+            {
+                benchCheck(false, "bulk send");
+                break;
+            }
+        }
+
+        benchCheck(benchWaitSockTx(txBytes, total), "bulk complete");
+
+        printf("bulk + idle:   %zu KB with %u idle sockets at %5u us latency, %.1f KB/s\n",
+                total/1024U, BENCH_NUM_IDLE_SOCKETS, latencyUs, benchKBps(total, startNs));
+    }
+
+    benchClose(fd);
+
+    for (i=0; i<BENCH_NUM_IDLE_SOCKETS; i++)
+    {
+        benchClose(idleFd[i]);
+    }
+
+    /* Let the device close the sockets at this latency. */
+    for (i=0; i<100U; i++)
+    {
+        benchStep();
+    }
+
+    (void)WINC_SimLatencySet(prevLatencyUs);
+}
+
+static void benchBulkIdle(void)
+{
+    benchBulkIdleRun(1000U);
+    benchBulkIdleRun(10000U);
+}
+
+/*****************************************************************************
+                                 Main
+ *****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    WINC_SIM_CONFIG config;
+    WINC_SIM_STATS stats;
+    int i;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    config.busHz     = 20000000U;
+    config.latencyUs = 100U;
+    config.dnsMs     = 40U;
+
+    for (i=1; i<argc; i++)
+    {
+        if (0 == strcmp(argv[i], "--quick"))
+        {
+            benchQuick = true;
+        }
+        else if ((0 == strcmp(argv[i], "--bus-hz")) && ((i+1) < argc))
+        {
+            config.busHz = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "--latency-us")) && ((i+1) < argc))
+        {
+            config.latencyUs = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "--dns-ms")) && ((i+1) < argc))
+        {
+            config.dnsMs = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else
+        {
+            printf("usage: %s [--quick] [--bus-hz N] [--latency-us N] [--dns-ms N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    printf("bus %u Hz, module latency %u us, DNS %u ms\n", config.busHz, config.latencyUs, config.dnsMs);
+
+    if (false == benchInit(&config))
+    {
+        printf("FAIL: device init\n");
+        return 1;
+    }
+
+    printf("init:          %.3f ms\n", benchSimSec(0) * 1000.0);
+
+    benchCmdRate();
+    benchRspMatch();
+    benchTcpTx();
+    benchTcpRx();
+    benchTcpRxBorrow();
+    benchTcpEcho();
+    benchTcpLoopback();
+    benchUdpEcho();
+    benchMixed();
+    benchRxWindow();
+    benchHttp();
+    benchUdpBatch();
+    benchEpoll();
+    benchCork();
+    benchSendConst();
+    benchDns();
+    benchBulkIdle();
+
+    WINC_SimStatsGet(&stats);
+
+    printf("device:        %u commands, %u messages, %u transactions, %llu bus bytes\n",
+            stats.numCmds, stats.numMsgs, stats.numTransactions, (unsigned long long)stats.busBytes);
+
+    benchCheck(0U == stats.numErrors, "device protocol errors");
+    benchCheck(0U == benchNumErrorPrints, "driver error prints");
+
+    if (0 != benchNumFailed)
+    {
+        printf("%d checks failed\n", benchNumFailed);
+        return 1;
+    }
+
+    return 0;
+}